@@ -0,0 +1,237 @@
+// ****************************************************************************
+/*
+    alsaCtl:
+
+    ALSA control volume backend for alsaPi, found from a snapshot.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+// ****************************************************************************
+
+//  Compilation:
+//
+//  Compile with gcc -c -fpic alsaCtl.c alsaPi.c ../infoPi/snapshotPi.c
+//                   -lasound -lm -lpthread
+//  Also use the following flags for Raspberry Pi optimisation:
+//         -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
+//         -ffast-math -pipe -O3
+
+//  Authors:        D.Faulke    23/01/2016
+//
+//  Contributors:
+//
+//  Changelog:
+//
+//  v0.1 Original version.
+//
+
+//  Installed libraries -------------------------------------------------------
+
+#include <alsa/asoundlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+//  Local libraries -----------------------------------------------------------
+
+#include "alsaPi.h"
+#include "../infoPi/snapshotPi.h"
+#include "alsaCtl.h"
+
+
+//  Local variables. ----------------------------------------------------------
+
+static struct
+{
+    snd_ctl_t            *ctl;      // Control handle.
+    snd_ctl_elem_value_t *value;    // Playback volume control value.
+    uint32_t              numid;    // Playback volume control.
+    uint8_t               channels; // Values in the control.
+    long                  min;      // Minimum raw volume.
+    long                  max;      // Maximum raw volume.
+} control = { .ctl = NULL };
+
+// Large, so not on the stack.
+static struct snapshotStruct snapshot;
+
+
+//  Backend functions. --------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  Returns control limits and subscribes to events.
+// ----------------------------------------------------------------------------
+static int ctlOpen( long *min, long *max )
+{
+    *min = control.min;
+    *max = control.max;
+
+    return snd_ctl_subscribe_events( control.ctl, 1 );
+};
+
+// ----------------------------------------------------------------------------
+//  Writes volume to every channel of the control.
+// ----------------------------------------------------------------------------
+static int ctlWrite( long volume )
+{
+    uint8_t i;
+
+    for ( i = 0; i < control.channels; i++ )
+        snd_ctl_elem_value_set_integer( control.value, i, volume );
+
+    return snd_ctl_elem_write( control.ctl, control.value );
+};
+
+// ----------------------------------------------------------------------------
+//  Reads volume of the first channel.
+// ----------------------------------------------------------------------------
+static int ctlRead( long *volume )
+{
+    int err;
+
+    err = snd_ctl_elem_read( control.ctl, control.value );
+    if ( err < 0 ) return err;
+    *volume = snd_ctl_elem_value_get_integer( control.value, 0 );
+
+    return 0;
+};
+
+// ----------------------------------------------------------------------------
+//  Returns number of control poll descriptors.
+// ----------------------------------------------------------------------------
+static int ctlPollCount( void )
+{
+    return snd_ctl_poll_descriptors_count( control.ctl );
+};
+
+// ----------------------------------------------------------------------------
+//  Fills in control poll descriptors.
+// ----------------------------------------------------------------------------
+static int ctlPollDescriptors( struct pollfd *fds, unsigned int space )
+{
+    return snd_ctl_poll_descriptors( control.ctl, fds, space );
+};
+
+// ----------------------------------------------------------------------------
+//  Reads pending events. Returns 1 if the volume control changed.
+// ----------------------------------------------------------------------------
+static int ctlHandleEvents( void )
+{
+    snd_ctl_event_t *event;
+    unsigned int mask;
+    int changed = 0;
+
+    snd_ctl_event_alloca( &event );
+
+    // Opened non-blocking, so this stops when there are no more.
+    while ( snd_ctl_read( control.ctl, event ) > 0 )
+    {
+        if ( snd_ctl_event_get_type( event ) != SND_CTL_EVENT_ELEM ) continue;
+        if ( snd_ctl_event_elem_get_numid( event ) != control.numid ) continue;
+
+        mask = snd_ctl_event_elem_get_mask( event );
+        if (( mask != SND_CTL_EVENT_MASK_REMOVE ) &&
+            ( mask & SND_CTL_EVENT_MASK_VALUE )) changed = 1;
+    }
+
+    return changed;
+};
+
+// ----------------------------------------------------------------------------
+//  Closes control.
+// ----------------------------------------------------------------------------
+static void ctlClose( void )
+{
+    if ( control.ctl == NULL ) return;
+
+    snd_ctl_elem_value_free( control.value );
+    snd_ctl_close( control.ctl );
+    control.ctl = NULL;
+};
+
+static struct volBackendStruct ctlBackend =
+{
+    .open            = ctlOpen,
+    .write           = ctlWrite,
+    .close           = ctlClose,
+    .read            = ctlRead,
+    .pollCount       = ctlPollCount,
+    .pollDescriptors = ctlPollDescriptors,
+    .handleEvents    = ctlHandleEvents
+};
+
+// ----------------------------------------------------------------------------
+//  Sets the control of sound.mixer as the volume backend. Returns -1 if not.
+// ----------------------------------------------------------------------------
+/*
+    The card ID and the control's type, size and range are checked
+    against the snapshot, so a card that has been swapped since it was
+    written isn't used.
+*/
+int8_t ctlInit( const char *path )
+{
+    const struct snapshotCard *card;
+    const struct snapshotElem *elem;
+    snd_ctl_card_info_t *cardInfo;
+    snd_ctl_elem_info_t *info;
+    snd_ctl_elem_id_t   *id;
+    bool ok;
+
+    if ( snapshotLoad( &snapshot, path ) < 0 ) return -1;
+    card = snapshotFindCard( &snapshot, sound.card );
+    if ( card == NULL ) return -1;
+    elem = snapshotFindElem( card, sound.mixer );
+    if (( elem == NULL ) || ( elem->numid == 0 ) ||
+        ( elem->channels == 0 )) return -1;
+
+    if ( snd_ctl_open( &control.ctl, sound.card, SND_CTL_NONBLOCK ) < 0 )
+    {
+        control.ctl = NULL;
+        return -1;
+    }
+
+    snd_ctl_card_info_alloca( &cardInfo );
+    snd_ctl_elem_info_alloca( &info );
+    snd_ctl_elem_id_alloca( &id );
+
+    snd_ctl_elem_id_set_numid( id, elem->numid );
+    snd_ctl_elem_info_set_id( info, id );
+
+    ok = ( snd_ctl_card_info( control.ctl, cardInfo ) == 0 ) &&
+         ( strncmp( snd_ctl_card_info_get_id( cardInfo ), card->id,
+                    SNAPSHOT_ID - 1 ) == 0 ) &&
+         ( snd_ctl_elem_info( control.ctl, info ) == 0 ) &&
+         ( snd_ctl_elem_info_get_type( info ) == SND_CTL_ELEM_TYPE_INTEGER ) &&
+         ( snd_ctl_elem_info_get_count( info ) == elem->channels ) &&
+         ( snd_ctl_elem_info_get_min( info ) == elem->volMin ) &&
+         ( snd_ctl_elem_info_get_max( info ) == elem->volMax ) &&
+         ( snd_ctl_elem_value_malloc( &control.value ) == 0 );
+    if ( !ok )
+    {
+        snd_ctl_close( control.ctl );
+        control.ctl = NULL;
+        return -1;
+    }
+
+    snd_ctl_elem_value_set_numid( control.value, elem->numid );
+    control.numid    = elem->numid;
+    control.channels = elem->channels;
+    control.min      = elem->volMin;
+    control.max      = elem->volMax;
+
+    soundSetBackend( &ctlBackend );
+
+    return 0;
+};
@@ -0,0 +1,64 @@
+// ****************************************************************************
+/*
+    alsaCtl:
+
+    ALSA control volume backend for alsaPi, found from a snapshot.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+// ****************************************************************************
+
+//  Authors:        D.Faulke    23/01/2016
+//
+//  Contributors:
+//
+//  Changelog:
+//
+//  v0.1 Original version.
+//
+
+//  Information. --------------------------------------------------------------
+/*
+    soundOpen loads the card's whole mixer tree and searches it for the
+    mixer by name, which can take seconds on slow USB DACs. If piInfo -s
+    has written a snapshot (see infoPi/snapshotPi.h), the numid of the
+    mixer's playback volume control is already known, so this backend
+    opens the card's control interface and uses that one control, with
+    no mixer tree.
+
+    Control events are subscribed to, so volume changes by other clients
+    are followed as they are with the mixer.
+
+    Raw volumes only, so don't use it in dB mode.
+*/
+
+#ifndef ALSACTL_H
+#define ALSACTL_H
+
+//  Backend functions. --------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  Sets the control of sound.mixer as the volume backend. Returns -1 if not.
+// ----------------------------------------------------------------------------
+/*
+    Call after setting sound.card and sound.mixer and before soundOpen.
+    path is the snapshot file, usually SNAPSHOT_PATH. Returns -1 if the
+    snapshot is missing, stale or doesn't match the card, in which case
+    soundOpen uses the mixer as usual.
+*/
+int8_t ctlInit( const char *path );
+
+#endif
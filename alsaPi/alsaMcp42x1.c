@@ -0,0 +1,150 @@
+// ****************************************************************************
+/*
+    alsaMcp42x1:
+
+    MCP42x1 digital potentiometer volume backend for alsaPi.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+// ****************************************************************************
+
+//  Compilation:
+//
+//  Compile with gcc -c -fpic alsaMcp42x1.c alsaPi.c
+//                   ../chipsPi/mcp42x1/mcp42x1.c -lasound -lm -lpthread -lpigpio
+//  and for potInitBus ../chipsPi/bcm2835/spi/bcm2835spi.c ../boardPi/boardPi.c
+//  Also use the following flags for Raspberry Pi optimisation:
+//         -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
+//         -ffast-math -pipe -O3
+
+//  Authors:        D.Faulke    21/01/2016
+//
+//  Contributors:
+//
+//  Changelog:
+//
+//  v0.1 Original version.
+//  v0.2 Uses shadowed MCP42x1 with both wipers in one transfer.
+//
+
+//  Installed libraries -------------------------------------------------------
+
+#include <alsa/asoundlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+//  Local libraries -----------------------------------------------------------
+
+#include "alsaPi.h"
+#include "../chipsPi/mcp42x1/mcp42x1.h"
+#include "alsaMcp42x1.h"
+
+
+//  Backend functions. --------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  Returns wiper limits.
+// ----------------------------------------------------------------------------
+static int potOpen( long *min, long *max )
+{
+    *min = MCP42X1_RMIN;
+    *max = pot.chip.max;
+
+    return 0;
+};
+
+// ----------------------------------------------------------------------------
+//  Moves wipers to volume, by one step if that is all that is needed.
+//  Returns -1 if the write fails.
+// ----------------------------------------------------------------------------
+static int potWrite( long volume )
+{
+    uint16_t value[MCP42X1_WIPERS];
+    int8_t   step = 0;
+    uint8_t  i;
+
+    if (( volume < MCP42X1_RMIN ) || ( volume > pot.chip.max )) return -1;
+
+    // Step if every wiper used is one step away in the same direction.
+    for ( i = 0; i < MCP42X1_WIPERS; i++ )
+    {
+        value[i] = pot.chip.wiper[i];
+        if ( !( pot.wipers & ( 1 << i ))) continue;
+
+        value[i] = volume;
+        if ( step == 2 ) continue;
+        if (( volume == pot.chip.wiper[i] + 1 ) && ( step >= 0 )) step = 1;
+        else if (( volume == pot.chip.wiper[i] - 1 ) && ( step <= 0 ))
+            step = -1;
+        else step = 2;
+    }
+
+    // The shadow wipers are only moved if the write succeeds.
+    if ( step == 2 )
+        return mcp42x1SetWipers( &pot.chip, value[0], value[1] ) < 0 ? -1 : 0;
+    if ( step != 0 )
+        return mcp42x1StepWipers( &pot.chip, pot.wipers, step > 0 ) < 0 ?
+               -1 : 0;
+
+    return 0;
+};
+
+// ----------------------------------------------------------------------------
+//  Nothing to release, the SPI handle or bus belongs to the caller.
+// ----------------------------------------------------------------------------
+static void potClose( void )
+{
+    return;
+};
+
+static struct volBackendStruct potBackend =
+{
+    .open  = potOpen,
+    .write = potWrite,
+    .close = potClose
+};
+
+// ----------------------------------------------------------------------------
+//  Sets the MCP42x1 as the alsaPi volume backend. Returns -1 if not.
+// ----------------------------------------------------------------------------
+int8_t potInit( uint8_t spi, uint8_t wipers, uint16_t max )
+{
+    if (( wipers == 0 ) || ( wipers >> MCP42X1_WIPERS )) return -1;
+    if ( mcp42x1ChipInit( &pot.chip, spi, max ) < 0 ) return -1;
+
+    pot.wipers = wipers;
+
+    soundSetBackend( &potBackend );
+
+    return 0;
+};
+
+// ----------------------------------------------------------------------------
+//  As potInit, for an MCP42x1 on a bcm2835spi bus scheduler.
+// ----------------------------------------------------------------------------
+int8_t potInitBus( struct bcm2835_spi_bus *bus,
+                   struct bcm2835_spi_device *device,
+                   uint8_t wipers, uint16_t max )
+{
+    if (( wipers == 0 ) || ( wipers >> MCP42X1_WIPERS )) return -1;
+    if ( mcp42x1ChipInitBus( &pot.chip, bus, device, max ) < 0 ) return -1;
+
+    pot.wipers = wipers;
+
+    soundSetBackend( &potBackend );
+
+    return 0;
+};
@@ -0,0 +1,97 @@
+// ****************************************************************************
+/*
+    alsaMcp42x1:
+
+    MCP42x1 digital potentiometer volume backend for alsaPi.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+// ****************************************************************************
+
+//  Authors:        D.Faulke    21/01/2016
+//
+//  Contributors:
+//
+//  Changelog:
+//
+//  v0.1 Original version.
+//  v0.2 Uses shadowed MCP42x1 with both wipers in one transfer.
+//  v0.3 Added potInitBus to share SPI0 through the bcm2835spi scheduler.
+//
+
+//  Information. --------------------------------------------------------------
+/*
+    Some preamps use an MCP42x1 as an analogue volume control in place of
+    the DAC mixer, with one wiper for each channel. The wipers are moved
+    by the alsaPi volume functions, so indices, factor, soft limits and
+    the applier work as they do for ALSA, with volume in wiper steps.
+
+    A change of one wiper step is sent as the 8-bit increment or decrement
+    command, so one byte per wiper. Anything larger, such as an
+    accelerated jump, is sent as the 16-bit write command to each wiper.
+    Both wipers go in one SPI transfer. The wiper positions are read once
+    by potInit and shadowed after that, so nothing else should move the
+    wipers.
+
+    0 is the B terminal, so wire the signal into A, B to ground and take
+    the output from the wiper. This needs the x1 potentiometers, e.g.
+    MCP4231, as the x2 rheostats, e.g. MCP4232, have no A terminals.
+*/
+
+#ifndef ALSAMCP42X1_H
+#define ALSAMCP42X1_H
+
+//  Macros. -------------------------------------------------------------------
+
+#define POT_MAX_7BIT 0x080 // Full scale for 7-bit MCP4x3x parts, e.g. MCP4231.
+#define POT_MAX_8BIT 0x100 // Full scale for 8-bit MCP4x5x parts, e.g. MCP4251.
+
+//  Data structures. ----------------------------------------------------------
+
+struct potStruct
+{
+    struct mcp42x1Chip chip;   // Shadowed MCP42x1.
+    uint8_t            wipers; // Wipers used, bit 0 for wiper 0, bit 1 for 1.
+}   pot;
+
+//  Backend functions. --------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  Sets the MCP42x1 as the alsaPi volume backend. Returns -1 if not.
+// ----------------------------------------------------------------------------
+/*
+    spi is a handle from pigpio spiOpen, e.g. spiOpen( 0, MCP42X1_SPI_BAUD,
+    0 ). wipers is a mask of the wipers to move together, 0x3 for stereo.
+    max is POT_MAX_7BIT or POT_MAX_8BIT. The chip is read once to get the
+    wiper positions. Call before soundOpen, which maps sound.min and
+    sound.max (%) onto 0 to max.
+*/
+int8_t potInit( uint8_t spi, uint8_t wipers, uint16_t max );
+
+// ----------------------------------------------------------------------------
+//  As potInit, for an MCP42x1 on a bcm2835spi bus scheduler.
+// ----------------------------------------------------------------------------
+/*
+    Use this when the MCP42x1 shares SPI0 with a display, so that volume
+    changes aren't held up behind a frame. bus must already be started and
+    device must give the MCP42x1's chip select, e.g. a divider of 25 for
+    10MHz and BCM2835_SPI_CS_MODE0.
+*/
+int8_t potInitBus( struct bcm2835_spi_bus *bus,
+                   struct bcm2835_spi_device *device,
+                   uint8_t wipers, uint16_t max );
+
+#endif
@@ -0,0 +1,692 @@
+// ****************************************************************************
+// ****************************************************************************
+/*
+    benchPi:
+
+    Benchmarks the display, potentiometer and meter drivers without any
+    hardware, using the recording transports in mockPi.c.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+// ****************************************************************************
+// ****************************************************************************
+
+#define Version "Version 0.3"
+
+//  Compilation:
+//
+//  Compile with
+//
+//      gcc -O2 -Wall -fcommon -I. -Imock -I../streamPi benchPi.c mockPi.c
+//          ../meterPi/mcp23017.c ../meterPi/hd44780i2c.c
+//          ../displayPi/ssd1322-spi/old/ssd1322-spi.c
+//          ../chipsPi/mcp42x1/mcp42x1.c
+//          ../chipsPi/bcm2835/spi/bcm2835spi.c ../boardPi/boardPi.c
+//          ../meterPi/meterPi.c ../streamPi/capturePi.c
+//          -Wl,--wrap=open,--wrap=open64,--wrap=close,--wrap=ioctl
+//          -Wl,--wrap=usleep
+//          -o benchPi -lm -lpthread -lrt -lasound
+//
+//  Add -DSTATSPI ../statsPi/statsPi.c to include the statsPi counters in
+//  the timings, as they would be on the Pi.
+//
+//  This runs on any Linux machine, so compile it with the same flags as
+//  the build being checked and compare runs before and after a change.
+
+//    Authors:     	D.Faulke	25/02/2016
+//    Contributors:
+//
+//    Changelog:
+//
+//    v0.1 Initial version.
+//    v0.2 Added pyramid to meter test.
+//    v0.3 Added FFT vector check to meter test.
+
+//  Info:
+//
+//  Each test drives a driver through its normal calls for a number of
+//  frames and reports two sets of figures:
+//
+//      cpu     Time spent in the driver on this machine (thread CPU time),
+//              as frames/s, characters/s or ns per sample.
+//      bus     Modelled time on the bus and in the driver's sleeps on the
+//              Pi, per frame, and the frame rate that allows.
+//
+//  The CPU figures depend on the machine, so they are for comparing runs
+//  on the same machine. The bus figures only depend on what the driver
+//  sends, so they can be compared anywhere.
+//
+//  Tests:
+//
+//      lcd     HD44780 via MCP23017, a 2 row bar meter through Print/Flush.
+//      oled    SSD1322, full frame streams of a moving bar.
+//      pot     MCP42x1, stereo wiper ramps through the shadowed writes.
+//      meter   meterPi reading a fake Squeezelite buffer fed with PCM, with
+//              float, fixed point and loudness meters, and a float meter
+//              feeding a pyramid read as a 256 column waveform view.
+//              Also checks the NEON FFT against the scalar FFT on full
+//              scale input.
+//
+//  The meter test replays a raw file of 16-bit little endian stereo frames
+//  given by --file, or a generated tone if there isn't one. The frames are
+//  written into a shared memory object laid out as a stream_vis_t published
+//  as 16-bit, which reads as a Squeezelite vis_t, one frame interval at a
+//  time, and get_dBfs is timed after each block.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <argp.h>
+#include <pigpio.h>
+
+#include "mockPi.h"
+#include "../meterPi/mcp23017.h"
+#include "../meterPi/hd44780i2c.h"
+#include "../displayPi/ssd1322-spi/old/ssd1322-spi.h"
+#include "../chipsPi/mcp42x1/mcp42x1.h"
+#include "../meterPi/meterPi.h"
+#include "../streamPi/streamPi.h"
+
+// ****************************************************************************
+//  argp documentation.
+// ****************************************************************************
+
+const char *argp_program_version = Version;
+const char *argp_program_bug_address = "darren@alidaf.co.uk";
+static char doc[] = "Benchmarks the drivers against mock I2C, SPI and GPIO "
+                    "transports";
+static char args_doc[] = "[lcd] [oled] [pot] [meter]";
+
+// ****************************************************************************
+//  Data definitions.
+// ****************************************************************************
+
+#define BENCH_SHM_NAME "/benchPi" // Fake Squeezelite buffer.
+#define BENCH_TONE     1000       // Generated tone (Hz).
+#define BENCH_SECONDS  10         // Longest PCM file replayed (s).
+#define BENCH_ATTACH   2000       // Longest wait for meterPi to attach (ms).
+#define BENCH_COLUMNS  256        // Waveform view width (pixels).
+#define BENCH_LEVEL    4          // Waveform view pyramid level.
+
+// Data structure to hold command line arguments.
+struct structArgs
+{
+    unsigned int i2cClock;
+    unsigned int spiClock;
+    unsigned int spiGap;
+    unsigned int frames;
+    unsigned int rate;
+    unsigned int fps;
+    char *file;
+    bool sleep;
+    bool lcd;
+    bool oled;
+    bool pot;
+    bool meter;
+};
+
+// ****************************************************************************
+//  Command line argument definitions.
+// ****************************************************************************
+
+static struct argp_option options[] =
+{
+    { 0, 0, 0, 0, "Bus model:" },
+    { "i2c", 'i', "<kHz>", 0, "I2C clock, 100 (default) or 400." },
+    { "spi", 's', "<Hz>", 0, "SPI clock, default the driver's baud rate." },
+    { "gap", 'g', "<ns>", 0, "Time added to each SPI transfer." },
+    { "sleep", 'S', 0, 0, "Really sleep in driver delays." },
+    { 0, 0, 0, 0, "Run:" },
+    { "frames", 'n', "<n>", 0, "Frames for each test (default 1000)." },
+    { "file", 'f', "<file>", 0, "Raw S16_LE stereo PCM for the meter." },
+    { "rate", 'r', "<Hz>", 0, "Sample rate of the PCM (default 44100)." },
+    { "fps", 'F', "<n>", 0, "Meter frame rate (default 60)." },
+    { 0 }
+};
+
+// ****************************************************************************
+//  Command line argument parser.
+// ****************************************************************************
+
+static int parse_opt( int param, char *arg, struct argp_state *state )
+{
+    struct structArgs *cmdArgs = state->input;
+
+    switch( param )
+    {
+        case 'i' :
+            cmdArgs->i2cClock = atoi( arg ) * 1000;
+            if ( cmdArgs->i2cClock == 0 )
+                argp_error( state, "I2C clock must be above 0." );
+            break;
+        case 's' :
+            cmdArgs->spiClock = atoi( arg );
+            break;
+        case 'g' :
+            cmdArgs->spiGap = atoi( arg );
+            break;
+        case 'S' :
+            cmdArgs->sleep = true;
+            break;
+        case 'n' :
+            cmdArgs->frames = atoi( arg );
+            if ( cmdArgs->frames == 0 )
+                argp_error( state, "Frames must be above 0." );
+            break;
+        case 'f' :
+            cmdArgs->file = arg;
+            break;
+        case 'r' :
+            cmdArgs->rate = atoi( arg );
+            break;
+        case 'F' :
+            cmdArgs->fps = atoi( arg );
+            if ( cmdArgs->fps == 0 )
+                argp_error( state, "Frame rate must be above 0." );
+            break;
+        case ARGP_KEY_ARG :
+            if ( strcmp( arg, "lcd" ) == 0 ) cmdArgs->lcd = true;
+            else if ( strcmp( arg, "oled" ) == 0 ) cmdArgs->oled = true;
+            else if ( strcmp( arg, "pot" ) == 0 ) cmdArgs->pot = true;
+            else if ( strcmp( arg, "meter" ) == 0 ) cmdArgs->meter = true;
+            else argp_error( state, "Unknown test %s.", arg );
+            break;
+    }
+    return 0;
+};
+
+// ****************************************************************************
+//  argp parser parameter structure.
+// ****************************************************************************
+
+static struct argp argp = { options, parse_opt, args_doc, doc };
+
+// ****************************************************************************
+//  Functions.
+// ****************************************************************************
+
+// ----------------------------------------------------------------------------
+//  Returns thread CPU time in nS.
+// ----------------------------------------------------------------------------
+static uint64_t cpuTime( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_THREAD_CPUTIME_ID, &now );
+    return ( uint64_t ) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+// ----------------------------------------------------------------------------
+//  Returns a rate per second from a count and a time (nS).
+// ----------------------------------------------------------------------------
+static double perSecond( uint64_t count, uint64_t ns )
+{
+    return ( ns > 0 ) ? ( double ) count * 1000000000.0 / ns : 0;
+}
+
+// ----------------------------------------------------------------------------
+//  Prints the mock bus counts for a test.
+// ----------------------------------------------------------------------------
+static void printBus( const char *bus, const struct mockBus *counts,
+                      uint64_t waitNs, uint32_t frames, const char *unit )
+{
+    uint64_t onBus = counts->busNs + waitNs;
+
+    printf( "    bus   %.1f %s transfers, %.1f bytes, %.1f us/%s "
+            "(%.1f us waits), %.1f %ss/s\n",
+            ( double ) counts->transfers / frames, bus,
+            ( double ) counts->bytes / frames,
+            ( double ) onBus / frames / 1000, unit,
+            ( double ) waitNs / frames / 1000,
+            perSecond( frames, onBus ), unit );
+}
+
+// ----------------------------------------------------------------------------
+//  Fills a meter style row of bar characters.
+// ----------------------------------------------------------------------------
+static void barRow( char *row, uint8_t width, uint8_t length )
+{
+    uint8_t i;
+
+    for ( i = 0; i < width; i++ ) row[i] = ( i < length ) ? 0xff : ' ';
+}
+
+// ----------------------------------------------------------------------------
+//  Returns a bar length that moves like a meter, from a frame number.
+// ----------------------------------------------------------------------------
+static uint8_t barLength( uint32_t frame, uint8_t channel, uint8_t width )
+{
+    double level = 0.5 + 0.5 * sin( frame * 0.07 + channel * 1.3 ) *
+                   cos( frame * 0.011 );
+
+    return ( uint8_t )( level * width );
+}
+
+// ----------------------------------------------------------------------------
+//  HD44780 via MCP23017.
+// ----------------------------------------------------------------------------
+/*
+    Set up as in testmeterPi-lcd, with R/W grounded so the command timings
+    are used. hd44780Flush only sends changed characters, so the bus time
+    per frame depends on how much the bars move.
+*/
+static void benchLcd( uint32_t frames )
+{
+    struct hd44780 display =
+    {
+        .rs = 0x80, .rw = 0x40, .en = 0x20, .busyFlag = false
+    };
+    struct mockStats stats;
+    char     row[DISPLAY_COLUMNS];
+    uint64_t start, cpu;
+    uint32_t frame;
+    uint8_t  channel;
+
+    if ( mcp23017Init( 0x20 ) < 0 )
+    {
+        printf( "lcd: couldn't open mock MCP23017.\n" );
+        return;
+    }
+    mcp23017WriteByte( mcp23017[0], IODIRA, 0x00 );
+    mcp23017WriteByte( mcp23017[0], IODIRB, 0x00 );
+    mcp23017WriteByte( mcp23017[0], OLATA, 0x00 );
+    mcp23017WriteByte( mcp23017[0], OLATB, 0x00 );
+    mcp23017WriteIOCON( mcp23017[0], IOCON_SEQOP );
+    hd44780Init( mcp23017[0], &display, 1, 1, 1, 1, 0, 0, 1, 0, 0, 0 );
+
+    mockReset();
+    start = cpuTime();
+    for ( frame = 0; frame < frames; frame++ )
+    {
+        for ( channel = 0; channel < DISPLAY_ROWS; channel++ )
+        {
+            barRow( row, DISPLAY_COLUMNS,
+                    barLength( frame, channel, DISPLAY_COLUMNS ));
+            hd44780Print( &display, channel, 0, row, DISPLAY_COLUMNS );
+        }
+        hd44780Flush( mcp23017[0], &display );
+    }
+    cpu = cpuTime() - start;
+    mockGet( &stats );
+
+    printf( "lcd: %u frames of %ux%u\n", frames, DISPLAY_COLUMNS,
+            DISPLAY_ROWS );
+    printf( "    cpu   %.0f frames/s, %.0f chars/s, %.0f ns/frame\n",
+            perSecond( frames, cpu ),
+            perSecond(( uint64_t ) frames * DISPLAY_COLUMNS * DISPLAY_ROWS,
+                      cpu ),
+            ( double ) cpu / frames );
+    printBus( "I2C", &stats.i2c, stats.waitNs, frames, "frame" );
+}
+
+// ----------------------------------------------------------------------------
+//  SSD1322.
+// ----------------------------------------------------------------------------
+static void benchOled( uint32_t frames )
+{
+    static uint8_t buffer[SSD1322_FRAME_BYTES];
+    struct mockStats stats;
+    uint64_t start, cpu;
+    uint32_t frame;
+    uint8_t  row, length;
+    int8_t   id;
+
+    id = ssd1322_init( GPIO_DC, GPIO_RESET, SPI_CHANNEL, SPI_BAUD, SPI_FLAGS );
+    if ( id < 0 )
+    {
+        printf( "oled: couldn't initialise mock SSD1322.\n" );
+        return;
+    }
+
+    mockReset();
+    start = cpuTime();
+    for ( frame = 0; frame < frames; frame++ )
+    {
+        for ( row = 0; row < SSD1322_ROWS; row++ )
+        {
+            length = barLength( frame, row / ( SSD1322_ROWS / 2 ),
+                                SSD1322_COLS / 2 );
+            memset( &buffer[row * SSD1322_COLS / 2], 0xff, length );
+            memset( &buffer[row * SSD1322_COLS / 2 + length], 0x00,
+                    SSD1322_COLS / 2 - length );
+        }
+        ssd1322_write_stream( id, buffer, SSD1322_FRAME_BYTES );
+    }
+    cpu = cpuTime() - start;
+    mockGet( &stats );
+
+    printf( "oled: %u frames of %ux%u\n", frames, SSD1322_COLS,
+            SSD1322_ROWS );
+    printf( "    cpu   %.0f frames/s, %.0f ns/frame\n",
+            perSecond( frames, cpu ), ( double ) cpu / frames );
+    printBus( "SPI", &stats.spi, stats.waitNs, frames, "frame" );
+    printf( "    gpio  %.1f writes/frame\n",
+            ( double ) stats.gpioWrites / frames );
+}
+
+// ----------------------------------------------------------------------------
+//  MCP42x1.
+// ----------------------------------------------------------------------------
+/*
+    Both wipers follow a ramp with a small offset, so most updates change
+    both, and some only one.
+*/
+static void benchPot( uint32_t frames )
+{
+    struct mcp42x1Chip chip;
+    struct mockStats stats;
+    uint64_t start, cpu;
+    uint32_t frame;
+    uint16_t value;
+    int      spi;
+
+    spi = spiOpen( 0, MCP42X1_SPI_BAUD, 0 );
+    if (( spi < 0 ) || ( mcp42x1ChipInit( &chip, spi, 0x100 ) < 0 ))
+    {
+        printf( "pot: couldn't initialise mock MCP42x1.\n" );
+        return;
+    }
+
+    mockReset();
+    start = cpuTime();
+    for ( frame = 0; frame < frames; frame++ )
+    {
+        value = ( frame / 2 ) % ( chip.max + 1 );
+        mcp42x1SetWipers( &chip, value, ( value + frame % 2 ) % chip.max );
+    }
+    cpu = cpuTime() - start;
+    mockGet( &stats );
+
+    printf( "pot: %u updates\n", frames );
+    printf( "    cpu   %.0f updates/s, %.0f ns/update\n",
+            perSecond( frames, cpu ), ( double ) cpu / frames );
+    printBus( "SPI", &stats.spi, stats.waitNs, frames, "update" );
+}
+
+// ----------------------------------------------------------------------------
+//  Loads PCM to replay, or generates a tone. Returns frames.
+// ----------------------------------------------------------------------------
+/*
+    The generated tone is swept in level so the meters move through their
+    whole range, with the right channel 6dB below the left.
+*/
+static uint32_t loadPcm( const char *file, uint32_t rate, int16_t **pcm )
+{
+    uint32_t frames = rate * BENCH_SECONDS;
+    uint32_t i;
+    double   level;
+    FILE     *in;
+
+    *pcm = malloc( frames * METER_CHANNELS * sizeof( int16_t ));
+    if ( *pcm == NULL ) return 0;
+
+    if ( file != NULL )
+    {
+        in = fopen( file, "rb" );
+        if ( in == NULL ) return 0;
+        frames = fread( *pcm, METER_CHANNELS * sizeof( int16_t ), frames, in );
+        fclose( in );
+        return frames;
+    }
+
+    for ( i = 0; i < frames; i++ )
+    {
+        level = 0.5 + 0.5 * sin( 2 * M_PI * i / rate );
+        ( *pcm )[i * 2] = 32767 * level *
+                          sin( 2 * M_PI * BENCH_TONE * i / rate );
+        ( *pcm )[i * 2 + 1] = ( *pcm )[i * 2] / 2;
+    }
+    return frames;
+}
+
+// ----------------------------------------------------------------------------
+//  Creates the fake Squeezelite buffer. Returns NULL on failure.
+// ----------------------------------------------------------------------------
+static struct stream_vis_t *visOpen( uint32_t rate, uint32_t period )
+{
+    struct stream_vis_t *vis;
+    pthread_rwlockattr_t attr;
+    int fd;
+
+    fd = shm_open( BENCH_SHM_NAME, O_CREAT | O_RDWR, 0666 );
+    if ( fd < 0 ) return NULL;
+
+    if ( ftruncate( fd, sizeof( struct stream_vis_t )) < 0 )
+    {
+        close( fd );
+        return NULL;
+    }
+
+    vis = mmap( NULL, sizeof( struct stream_vis_t ),
+                PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close( fd );
+    if ( vis == MAP_FAILED ) return NULL;
+
+    memset( vis, 0, sizeof( struct stream_vis_t ));
+
+    pthread_rwlockattr_init( &attr );
+    pthread_rwlockattr_setpshared( &attr, PTHREAD_PROCESS_SHARED );
+    pthread_rwlock_init( &vis->rwlock, &attr );
+    pthread_rwlockattr_destroy( &attr );
+
+    vis->magic    = STREAM_MAGIC;
+    vis->version  = STREAM_VERSION;
+    vis->format   = STREAM_S16;
+    vis->bytes    = sizeof( int16_t );
+    vis->channels = METER_CHANNELS;
+    vis->period   = period;
+    vis->rate     = rate;
+    vis->buf_size = sizeof( vis->buffer ) / vis->bytes;
+    vis->running  = true;
+    vis->updated  = time( NULL );
+
+    return vis;
+}
+
+// ----------------------------------------------------------------------------
+//  Writes a block of frames into the fake Squeezelite buffer.
+// ----------------------------------------------------------------------------
+static void visWrite( struct stream_vis_t *vis, const int16_t *pcm,
+                      uint32_t frames )
+{
+    int16_t  *buffer = ( int16_t * ) vis->buffer;
+    uint32_t samples = frames * METER_CHANNELS;
+    uint32_t span;
+
+    pthread_rwlock_wrlock( &vis->rwlock );
+    while ( samples > 0 )
+    {
+        span = vis->buf_size - vis->buf_index;
+        if ( span > samples ) span = samples;
+        memcpy( &buffer[vis->buf_index], pcm, span * sizeof( int16_t ));
+        vis->buf_index = ( vis->buf_index + span ) % vis->buf_size;
+        pcm     += span;
+        samples -= span;
+    }
+    vis->updated = time( NULL );
+    pthread_rwlock_unlock( &vis->rwlock );
+}
+
+// ----------------------------------------------------------------------------
+//  Times a meter over the replayed PCM. Returns CPU nS.
+// ----------------------------------------------------------------------------
+static uint64_t meterRun( struct stream_vis_t *vis, struct peak_meter_t *meter,
+                          const int16_t *pcm, uint32_t pcmFrames,
+                          uint32_t block, uint32_t frames )
+{
+    static struct meter_column_t column[BENCH_COLUMNS];
+    uint64_t cpu = 0, start;
+    uint32_t frame, offset = 0;
+
+    for ( frame = 0; frame < frames; frame++ )
+    {
+        if ( offset + block > pcmFrames ) offset = 0;
+        visWrite( vis, &pcm[offset * METER_CHANNELS], block );
+        offset += block;
+
+        start = cpuTime();
+        get_dBfs( meter );
+        get_dB_indices( meter );
+        if ( meter->pyramid != NULL )
+            get_pyramid( meter->pyramid, BENCH_LEVEL, BENCH_COLUMNS, column );
+        cpu += cpuTime() - start;
+    }
+    return cpu;
+}
+
+// ----------------------------------------------------------------------------
+//  meterPi.
+// ----------------------------------------------------------------------------
+static void benchMeter( uint32_t frames, const char *file, uint32_t rate,
+                        uint32_t fps )
+{
+    static const char *modes[] = { "float", "fixed", "lufs", "pyr" };
+    static struct meter_pyramid_t pyramid;
+    static struct spectrum_meter_t spectrum =
+    {
+        .size       = 2048,
+        .overlap    = 576,
+        .num_bands  = 16,
+        .min_freq   = 50,
+        .max_freq   = 16000,
+        .floor      = -70,
+        .num_levels = 16,
+    };
+    struct peak_meter_t meter =
+    {
+        .int_time   = 5,
+        .hold_time  = 1000,
+        .fall_time  = 50,
+        .over_peaks = 10,
+        .over_time  = 3000,
+        .num_levels = 41,
+        .floor      = -96,
+        .reference  = 32768,
+    };
+    struct stream_vis_t *vis;
+    struct timespec pause = { 0, 1000000 };
+    int16_t  *pcm;
+    uint32_t pcmFrames, block, wait;
+    uint64_t cpu;
+    uint8_t  mode, i;
+
+    pcmFrames = loadPcm( file, rate, &pcm );
+    block = rate / fps;
+    if (( pcmFrames < block ) || ( block == 0 ))
+    {
+        printf( "meter: no PCM to replay.\n" );
+        free( pcm );
+        return;
+    }
+
+    vis = visOpen( rate, block );
+    if ( vis == NULL )
+    {
+        printf( "meter: couldn't create %s.\n", BENCH_SHM_NAME );
+        free( pcm );
+        return;
+    }
+
+    meter_use_stream( BENCH_SHM_NAME );
+    vis_check();
+    for ( wait = 0; ( meter_get_rate() == 0 ) && ( wait < BENCH_ATTACH );
+          wait++ )
+        nanosleep( &pause, NULL );
+
+    printf( "meter: %u frames of %u samples at %u Hz\n", frames,
+            block * METER_CHANNELS, rate );
+
+    for ( i = 0; i < 41; i++ ) meter.scale[i] = i - 40;
+    meter.samples = rate * meter.int_time / 1000;
+
+    for ( mode = 0; mode < 4; mode++ )
+    {
+        memset( &meter.integrator, 0, sizeof( meter.integrator ));
+        memset( &meter.ballistics, 0, sizeof( meter.ballistics ));
+        meter.fixed_point = ( mode == 1 );
+        meter.lufs        = ( mode == 2 );
+        meter.pyramid     = ( mode == 3 ) ? &pyramid : NULL;
+        meter.configured  = false;
+        init_peak_meter( &meter );
+        reset_loudness( &meter );
+
+        cpu = meterRun( vis, &meter, pcm, pcmFrames, block, frames );
+        printf( "    cpu   %-5s %.1f ns/sample, %.0f ns/frame, "
+                "L %d R %d dBfs\n",
+                modes[mode],
+                ( double ) cpu / (( uint64_t ) frames * block *
+                                  METER_CHANNELS ),
+                ( double ) cpu / frames, meter.dBfs[0], meter.dBfs[1] );
+    }
+
+    printf( "    check fft   vector and scalar %s\n",
+            check_spectrum_fft( &spectrum ) ? "match" : "DIFFER" );
+
+    meter_close();
+    munmap( vis, sizeof( struct stream_vis_t ));
+    shm_unlink( BENCH_SHM_NAME );
+    free( pcm );
+}
+
+// ****************************************************************************
+//  Main section.
+// ****************************************************************************
+
+int main( int argc, char *argv[] )
+{
+    struct structArgs cmdArgs;
+
+    memset( &cmdArgs, 0, sizeof( cmdArgs ));
+    cmdArgs.i2cClock = MOCK_I2C_CLOCK;
+    cmdArgs.frames = 1000;
+    cmdArgs.rate = 44100;
+    cmdArgs.fps = 60;
+
+    // ************************************************************************
+    //  Get command line parameters.
+    // ************************************************************************
+    argp_parse( &argp, argc, argv, 0, 0, &cmdArgs );
+
+    // Run everything if no tests are given.
+    if ( !( cmdArgs.lcd || cmdArgs.oled || cmdArgs.pot || cmdArgs.meter ))
+        cmdArgs.lcd = cmdArgs.oled = cmdArgs.pot = cmdArgs.meter = true;
+
+    mockI2cClock( cmdArgs.i2cClock );
+    mockSpiClock( cmdArgs.spiClock );
+    mockSpiGap( cmdArgs.spiGap );
+    mockSleep( !cmdArgs.sleep );
+
+    printf( "I2C %u kHz, ", cmdArgs.i2cClock / 1000 );
+    if ( cmdArgs.spiClock ) printf( "SPI %u Hz, ", cmdArgs.spiClock );
+    else printf( "SPI driver baud, " );
+    printf( "SPI gap %u ns\n", cmdArgs.spiGap );
+
+    if ( cmdArgs.lcd ) benchLcd( cmdArgs.frames );
+    if ( cmdArgs.oled ) benchOled( cmdArgs.frames );
+    if ( cmdArgs.pot ) benchPot( cmdArgs.frames );
+    if ( cmdArgs.meter )
+        benchMeter( cmdArgs.frames, cmdArgs.file, cmdArgs.rate, cmdArgs.fps );
+
+    return 0;
+}
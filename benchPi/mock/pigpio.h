@@ -0,0 +1,55 @@
+/*
+//  ===========================================================================
+
+    pigpio:
+
+    Declarations of the pigpio functions used by the SPI drivers, for
+    building them against the mock transports in mockPi.c where pigpio
+    isn't installed. Only for benchPi; drivers on the Pi use the real
+    header.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+*/
+
+#ifndef PIGPIO_H
+#define PIGPIO_H
+
+#include <stdint.h>
+
+#define PI_INPUT    0
+#define PI_OUTPUT   1
+
+#define PI_PUD_OFF  0
+#define PI_PUD_DOWN 1
+#define PI_PUD_UP   2
+
+int      gpioInitialise( void );
+void     gpioTerminate( void );
+int      gpioSetMode( unsigned gpio, unsigned mode );
+int      gpioSetPullUpDown( unsigned gpio, unsigned pud );
+int      gpioRead( unsigned gpio );
+int      gpioWrite( unsigned gpio, unsigned level );
+uint32_t gpioDelay( uint32_t micros );
+
+int spiOpen( unsigned spiChan, unsigned baud, unsigned spiFlags );
+int spiClose( unsigned handle );
+int spiRead( unsigned handle, char *buf, unsigned count );
+int spiWrite( unsigned handle, char *buf, unsigned count );
+int spiXfer( unsigned handle, char *txBuf, char *rxBuf, unsigned count );
+
+#endif
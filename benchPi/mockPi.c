@@ -0,0 +1,466 @@
+/*
+//  ===========================================================================
+
+    mockPi:
+
+    Recording I2C, SPI and GPIO transports for running the drivers off the
+    Pi, with a model of the time each transfer takes on the bus.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+
+    Compile with the drivers, see benchPi.c.
+
+//  ---------------------------------------------------------------------------
+
+    Authors:        D.Faulke    25/02/2016
+
+    Contributors:
+
+    Changelog:
+
+        v0.1    Original version.
+
+//  ---------------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <pigpio.h>
+
+#include "mockPi.h"
+
+
+//  Local variables. ----------------------------------------------------------
+
+#define MOCK_I2C_PATH  "/dev/i2c-"
+#define MOCK_SPI_MAX   4  // SPI handles.
+
+static struct mockStats mock;
+
+static uint32_t i2cClock = MOCK_I2C_CLOCK;
+static uint32_t spiClock = 0;
+static uint32_t spiGap   = 0;
+static bool     modelSleep = true;
+
+// Open I2C devices, -1 if free.
+static int i2cFds[MOCK_I2C_FDS] = { -1, -1, -1, -1 };
+
+// Baud rate of each SPI handle.
+static uint32_t spiBaud[MOCK_SPI_MAX];
+static uint8_t  spiHandles = 0;
+
+
+//  Wrapped system calls. -----------------------------------------------------
+
+int __real_open( const char *path, int flags, ... );
+int __real_open64( const char *path, int flags, ... );
+int __real_close( int fd );
+int __real_ioctl( int fd, unsigned long request, ... );
+int __real_usleep( useconds_t usec );
+
+
+//  Settings. -----------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Sets the I2C clock (Hz) used for the bus time.
+//  ---------------------------------------------------------------------------
+void mockI2cClock( uint32_t hz )
+{
+    if ( hz > 0 ) i2cClock = hz;
+}
+
+//  ---------------------------------------------------------------------------
+//  Sets the SPI clock (Hz) used for the bus time.
+//  ---------------------------------------------------------------------------
+void mockSpiClock( uint32_t hz )
+{
+    spiClock = hz;
+}
+
+//  ---------------------------------------------------------------------------
+//  Sets the time (nS) added to each SPI transfer.
+//  ---------------------------------------------------------------------------
+void mockSpiGap( uint32_t ns )
+{
+    spiGap = ns;
+}
+
+//  ---------------------------------------------------------------------------
+//  Selects modelled (default) or real sleeps and delays.
+//  ---------------------------------------------------------------------------
+void mockSleep( bool model )
+{
+    modelSleep = model;
+}
+
+//  ---------------------------------------------------------------------------
+//  Copies the counts since the last reset.
+//  ---------------------------------------------------------------------------
+void mockGet( struct mockStats *stats )
+{
+    *stats = mock;
+}
+
+//  ---------------------------------------------------------------------------
+//  Clears the counts.
+//  ---------------------------------------------------------------------------
+void mockReset( void )
+{
+    memset( &mock, 0, sizeof( mock ));
+}
+
+
+//  I2C. ----------------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Returns true if fd is a mock I2C device.
+//  ---------------------------------------------------------------------------
+static bool i2cIsMock( int fd )
+{
+    uint8_t i;
+
+    if ( fd < 0 ) return false;
+    for ( i = 0; i < MOCK_I2C_FDS; i++ )
+        if ( i2cFds[i] == fd ) return true;
+    return false;
+}
+
+//  ---------------------------------------------------------------------------
+//  Records an I2C transaction.
+//  ---------------------------------------------------------------------------
+/*
+    addresses is the number of address bytes sent, i.e. 1 + repeated
+    starts, and bytes the data bytes in either direction.
+*/
+static void i2cCount( uint32_t addresses, uint32_t bytes )
+{
+    uint64_t bits = 2 + ( addresses - 1 ) + 9 * ( addresses + bytes );
+
+    mock.i2c.transfers++;
+    mock.i2c.bytes += bytes;
+    mock.i2c.busNs += bits * 1000000000ULL / i2cClock;
+}
+
+//  ---------------------------------------------------------------------------
+//  Handles an SMBus transaction.
+//  ---------------------------------------------------------------------------
+static int i2cSmbus( struct i2c_smbus_ioctl_data *args )
+{
+    bool     read = ( args->read_write == I2C_SMBUS_READ );
+    uint32_t bytes;
+
+    switch ( args->size )
+    {
+        case I2C_SMBUS_QUICK:
+            i2cCount( 1, 0 );
+            return 0;
+        case I2C_SMBUS_BYTE:
+            i2cCount( 1, 1 );
+            if ( read ) args->data->byte = 0;
+            return 0;
+        case I2C_SMBUS_BYTE_DATA:
+            i2cCount( read ? 2 : 1, 2 );
+            if ( read ) args->data->byte = 0;
+            return 0;
+        case I2C_SMBUS_WORD_DATA:
+            i2cCount( read ? 2 : 1, 3 );
+            if ( read ) args->data->word = 0;
+            return 0;
+        case I2C_SMBUS_BLOCK_DATA:
+        case I2C_SMBUS_I2C_BLOCK_DATA:
+            bytes = args->data->block[0];
+            if ( bytes > I2C_SMBUS_BLOCK_MAX ) bytes = I2C_SMBUS_BLOCK_MAX;
+            // SMBus blocks also send the count.
+            i2cCount( read ? 2 : 1, 1 + bytes +
+                      ( args->size == I2C_SMBUS_BLOCK_DATA ));
+            if ( read ) memset( &args->data->block[1], 0, bytes );
+            return 0;
+    }
+    return -1;
+}
+
+//  ---------------------------------------------------------------------------
+//  Handles a combined transaction.
+//  ---------------------------------------------------------------------------
+static int i2cRdwr( struct i2c_rdwr_ioctl_data *args )
+{
+    uint32_t bytes = 0;
+    uint32_t i;
+
+    if ( args->nmsgs == 0 ) return -1;
+
+    for ( i = 0; i < args->nmsgs; i++ )
+    {
+        bytes += args->msgs[i].len;
+        if ( args->msgs[i].flags & I2C_M_RD )
+            memset( args->msgs[i].buf, 0, args->msgs[i].len );
+    }
+    i2cCount( args->nmsgs, bytes );
+
+    return args->nmsgs;
+}
+
+//  ---------------------------------------------------------------------------
+//  Opens a mock I2C device or passes the call on.
+//  ---------------------------------------------------------------------------
+/*
+    The descriptor is a real one for /dev/null so that it can't clash with
+    anything else the program opens.
+*/
+static int i2cOpen( const char *path, int flags, mode_t mode,
+                    int (*real)( const char *, int, ... ))
+{
+    uint8_t i;
+    int fd;
+
+    if ( strncmp( path, MOCK_I2C_PATH, strlen( MOCK_I2C_PATH )) != 0 )
+        return real( path, flags, mode );
+
+    for ( i = 0; i < MOCK_I2C_FDS; i++ )
+    {
+        if ( i2cFds[i] >= 0 ) continue;
+        fd = real( "/dev/null", O_RDWR );
+        i2cFds[i] = fd;
+        return fd;
+    }
+    return -1;
+}
+
+int __wrap_open( const char *path, int flags, ... )
+{
+    mode_t  mode = 0;
+    va_list args;
+
+    if ( flags & O_CREAT )
+    {
+        va_start( args, flags );
+        mode = va_arg( args, mode_t );
+        va_end( args );
+    }
+    return i2cOpen( path, flags, mode, __real_open );
+}
+
+int __wrap_open64( const char *path, int flags, ... )
+{
+    mode_t  mode = 0;
+    va_list args;
+
+    if ( flags & O_CREAT )
+    {
+        va_start( args, flags );
+        mode = va_arg( args, mode_t );
+        va_end( args );
+    }
+    return i2cOpen( path, flags, mode, __real_open64 );
+}
+
+int __wrap_close( int fd )
+{
+    uint8_t i;
+
+    for ( i = 0; i < MOCK_I2C_FDS; i++ )
+        if ( i2cFds[i] == fd ) i2cFds[i] = -1;
+
+    return __real_close( fd );
+}
+
+int __wrap_ioctl( int fd, unsigned long request, ... )
+{
+    va_list args;
+    void    *arg;
+
+    va_start( args, request );
+    arg = va_arg( args, void * );
+    va_end( args );
+
+    if ( !i2cIsMock( fd )) return __real_ioctl( fd, request, arg );
+
+    switch ( request )
+    {
+        case I2C_SLAVE:
+        case I2C_SLAVE_FORCE:
+            return 0;
+        case I2C_SMBUS:
+            return i2cSmbus( arg );
+        case I2C_RDWR:
+            return i2cRdwr( arg );
+    }
+    return -1;
+}
+
+//  ---------------------------------------------------------------------------
+//  SMBus functions, as in libi2c.
+//  ---------------------------------------------------------------------------
+static int32_t i2cSmbusCall( int fd, uint8_t rw, uint8_t command,
+                             uint32_t size, union i2c_smbus_data *data )
+{
+    struct i2c_smbus_ioctl_data args = { rw, command, size, data };
+
+    if ( !i2cIsMock( fd )) return __real_ioctl( fd, I2C_SMBUS, &args );
+    return i2cSmbus( &args );
+}
+
+int32_t i2c_smbus_write_byte_data( int fd, uint8_t command, uint8_t value )
+{
+    union i2c_smbus_data data = { .byte = value };
+
+    return i2cSmbusCall( fd, I2C_SMBUS_WRITE, command, I2C_SMBUS_BYTE_DATA,
+                         &data );
+}
+
+int32_t i2c_smbus_write_word_data( int fd, uint8_t command, uint16_t value )
+{
+    union i2c_smbus_data data = { .word = value };
+
+    return i2cSmbusCall( fd, I2C_SMBUS_WRITE, command, I2C_SMBUS_WORD_DATA,
+                         &data );
+}
+
+int32_t i2c_smbus_read_byte_data( int fd, uint8_t command )
+{
+    union i2c_smbus_data data;
+
+    if ( i2cSmbusCall( fd, I2C_SMBUS_READ, command, I2C_SMBUS_BYTE_DATA,
+                       &data ) < 0 ) return -1;
+    return data.byte;
+}
+
+int32_t i2c_smbus_read_word_data( int fd, uint8_t command )
+{
+    union i2c_smbus_data data;
+
+    if ( i2cSmbusCall( fd, I2C_SMBUS_READ, command, I2C_SMBUS_WORD_DATA,
+                       &data ) < 0 ) return -1;
+    return data.word;
+}
+
+
+//  Sleeps. -------------------------------------------------------------------
+
+int __wrap_usleep( useconds_t usec )
+{
+    if ( !modelSleep ) return __real_usleep( usec );
+    mock.waitNs += ( uint64_t ) usec * 1000;
+    return 0;
+}
+
+
+//  pigpio. -------------------------------------------------------------------
+
+int gpioInitialise( void )
+{
+    return 0;
+}
+
+void gpioTerminate( void )
+{
+}
+
+int gpioSetMode( unsigned gpio, unsigned mode )
+{
+    (void) gpio; (void) mode;
+    return 0;
+}
+
+int gpioSetPullUpDown( unsigned gpio, unsigned pud )
+{
+    (void) gpio; (void) pud;
+    return 0;
+}
+
+int gpioRead( unsigned gpio )
+{
+    (void) gpio;
+    return 0;
+}
+
+int gpioWrite( unsigned gpio, unsigned level )
+{
+    (void) gpio; (void) level;
+    mock.gpioWrites++;
+    return 0;
+}
+
+uint32_t gpioDelay( uint32_t micros )
+{
+    if ( modelSleep ) mock.waitNs += ( uint64_t ) micros * 1000;
+    else __real_usleep( micros );
+    return micros;
+}
+
+//  ---------------------------------------------------------------------------
+//  Records an SPI transfer.
+//  ---------------------------------------------------------------------------
+static int spiCount( unsigned handle, unsigned count )
+{
+    uint32_t clock;
+
+    if ( handle >= spiHandles ) return -1;
+    clock = ( spiClock > 0 ) ? spiClock : spiBaud[handle];
+    if ( clock == 0 ) clock = 1;
+
+    mock.spi.transfers++;
+    mock.spi.bytes += count;
+    mock.spi.busNs += ( uint64_t ) count * 8 * 1000000000ULL / clock + spiGap;
+
+    return count;
+}
+
+int spiOpen( unsigned spiChan, unsigned baud, unsigned spiFlags )
+{
+    (void) spiChan; (void) spiFlags;
+
+    if ( spiHandles >= MOCK_SPI_MAX ) return -1;
+    spiBaud[spiHandles] = baud;
+    return spiHandles++;
+}
+
+int spiClose( unsigned handle )
+{
+    return ( handle < spiHandles ) ? 0 : -1;
+}
+
+int spiWrite( unsigned handle, char *buf, unsigned count )
+{
+    (void) buf;
+    return spiCount( handle, count );
+}
+
+int spiRead( unsigned handle, char *buf, unsigned count )
+{
+    if ( count > 0 )
+    {
+        memset( buf, 0, count );
+        buf[0] = ( char ) 0xfe;
+    }
+    return spiCount( handle, count );
+}
+
+int spiXfer( unsigned handle, char *txBuf, char *rxBuf, unsigned count )
+{
+    (void) txBuf;
+    return spiRead( handle, rxBuf, count );
+}
@@ -0,0 +1,129 @@
+/*
+//  ===========================================================================
+
+    mockPi:
+
+    Recording I2C, SPI and GPIO transports for running the drivers off the
+    Pi, with a model of the time each transfer takes on the bus.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+
+    Authors:        D.Faulke    25/02/2016
+
+    Contributors:
+
+    Changelog:
+
+        v0.1    Original version.
+
+//  Information. --------------------------------------------------------------
+
+    The drivers are linked unchanged. The I2C drivers talk to /dev/i2c-n
+    with open, ioctl and the i2c_smbus functions, so the program is linked
+    with
+
+        -Wl,--wrap=open,--wrap=open64,--wrap=close,--wrap=ioctl
+        -Wl,--wrap=usleep
+
+    and opening an I2C device returns a descriptor that is recorded here
+    instead of reaching the kernel. Every other path goes to the real call.
+    The SPI drivers use pigpio, whose functions are defined here, with the
+    declarations in mock/pigpio.h for machines without pigpio.
+
+    Reads return zeros, so an MCP23017 reads back with all inputs low and
+    the HD44780 busy flag clear. SPI reads return 0xfe and then zeros,
+    which is an MCP42x1 answering a valid read with a zero register.
+
+    Bus time is modelled from the clock and the bits on the wire:
+
+        I2C     Start, stop and each repeated start are 1 bit time and
+                each address or data byte is 9 (8 bits and ACK).
+        SPI     8 bit times per byte plus a configurable gap per transfer
+                for chip select and driver set up.
+
+    Sleeps and pigpio delays are, by default, added to the modelled wait
+    time and return at once, so a run isn't slowed by display timings.
+*/
+
+#ifndef MOCKPI_H
+#define MOCKPI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//  Macros. -------------------------------------------------------------------
+
+#define MOCKPI_VERSION 0001
+
+#define MOCK_I2C_CLOCK  100000  // Default I2C clock (Hz), standard mode.
+#define MOCK_I2C_FAST   400000  // I2C fast mode (Hz).
+#define MOCK_I2C_FDS         4  // I2C devices that can be open.
+
+//  Data structures. ----------------------------------------------------------
+
+struct mockBus
+{
+    uint64_t transfers;  // Bus transactions.
+    uint64_t bytes;      // Data bytes, excluding addresses.
+    uint64_t busNs;      // Modelled time on the bus (nS).
+};
+
+struct mockStats
+{
+    struct mockBus i2c;
+    struct mockBus spi;
+    uint64_t gpioWrites; // GPIO level changes, e.g. SSD1322 D/C#.
+    uint64_t waitNs;     // Modelled sleeps and delays (nS).
+};
+
+//  Functions. ----------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Sets the I2C clock (Hz) used for the bus time.
+//  ---------------------------------------------------------------------------
+void mockI2cClock( uint32_t hz );
+
+//  ---------------------------------------------------------------------------
+//  Sets the SPI clock (Hz) used for the bus time.
+//  ---------------------------------------------------------------------------
+/*
+    0 uses the baud rate given to spiOpen.
+*/
+void mockSpiClock( uint32_t hz );
+
+//  ---------------------------------------------------------------------------
+//  Sets the time (nS) added to each SPI transfer.
+//  ---------------------------------------------------------------------------
+void mockSpiGap( uint32_t ns );
+
+//  ---------------------------------------------------------------------------
+//  Selects modelled (default) or real sleeps and delays.
+//  ---------------------------------------------------------------------------
+void mockSleep( bool model );
+
+//  ---------------------------------------------------------------------------
+//  Copies the counts since the last reset.
+//  ---------------------------------------------------------------------------
+void mockGet( struct mockStats *stats );
+
+//  ---------------------------------------------------------------------------
+//  Clears the counts.
+//  ---------------------------------------------------------------------------
+void mockReset( void );
+
+#endif
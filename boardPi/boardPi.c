@@ -0,0 +1,277 @@
+/*
+//  ===========================================================================
+
+    boardPi:
+
+    Board information for the Raspberry Pi, read once and cached.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    Based on the revision codes documented by the Raspberry Pi Foundation.
+        - see https://www.raspberrypi.org/documentation/hardware/
+              raspberrypi/revision-codes/README.md
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+
+    Compile with:
+
+        gcc -c -fpic -Wall boardPi.c
+
+    Also use the following flags for Raspberry Pi optimisation:
+
+        -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
+        -ffast-math -pipe -O3
+
+//  ---------------------------------------------------------------------------
+
+    Authors:        D.Faulke    22/01/2016
+
+    Contributors:
+
+    Changelog:
+
+        v0.1    Original version.
+
+//  ---------------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "boardPi.h"
+
+
+//  Local variables. ----------------------------------------------------------
+
+// Model names, indexed by type.
+static const char *boardModels[] =
+{
+    "A",    "B",     "A+",     "B+",    "2B",    "Alpha", "CM1",    "",
+    "3B",   "Zero",  "CM3",    "",      "Zero W", "3B+",  "3A+",    "",
+    "CM3+", "4B",    "Zero 2 W", "400", "CM4",   "CM4S",  "",       "5",
+    "CM5",  "500",   "CM5 Lite"
+};
+#define BOARD_MODELS ( sizeof( boardModels ) / sizeof( boardModels[0] ))
+
+// Manufacturer names, indexed by new style code. Qisda is old style only.
+static const char *boardMakers[] =
+{
+    "Sony UK", "Egoman", "Embest", "Sony Japan", "Embest", "Stadium", "Qisda"
+};
+#define BOARD_MAKERS ( sizeof( boardMakers ) / sizeof( boardMakers[0] ))
+
+// Peripheral base and size for each processor.
+static const uint32_t boardPeri[][2] =
+{
+    { 0x20000000, 0x01000000 }, // BCM2835.
+    { 0x3f000000, 0x01000000 }, // BCM2836.
+    { 0x3f000000, 0x01000000 }, // BCM2837.
+    { 0xfe000000, 0x01800000 }, // BCM2711.
+    { 0x00000000, 0x00000000 }  // BCM2712, GPIOs are on RP1.
+};
+#define BOARD_PROCESSORS ( sizeof( boardPeri ) / sizeof( boardPeri[0] ))
+
+// Old style codes, indexed by code: type, PCB, memory and manufacturer.
+static const struct
+{
+    uint8_t  type;
+    uint8_t  pcb;
+    uint16_t memory;
+    uint8_t  maker;
+} boardOld[] =
+{
+    [0x02] = { 1, 10, 256, 1 }, [0x03] = { 1, 10, 256, 1 },
+    [0x04] = { 1, 20, 256, 0 }, [0x05] = { 1, 20, 256, 6 },
+    [0x06] = { 1, 20, 256, 1 }, [0x07] = { 0, 20, 256, 1 },
+    [0x08] = { 0, 20, 256, 0 }, [0x09] = { 0, 20, 256, 6 },
+    [0x0d] = { 1, 20, 512, 1 }, [0x0e] = { 1, 20, 512, 0 },
+    [0x0f] = { 1, 20, 512, 1 }, [0x10] = { 3, 12, 512, 0 },
+    [0x11] = { 6, 10, 512, 0 }, [0x12] = { 2, 11, 256, 0 },
+    [0x13] = { 3, 12, 512, 2 }, [0x14] = { 6, 10, 512, 2 },
+    [0x15] = { 2, 11, 256, 2 }
+};
+#define BOARD_OLD ( sizeof( boardOld ) / sizeof( boardOld[0] ))
+
+static struct boardStruct board; // Cached information.
+static bool boardRead = false;   // Set once board has been filled in.
+
+
+//  Functions. ----------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Returns a big endian 32-bit cell.
+//  ---------------------------------------------------------------------------
+static uint32_t cell( const uint8_t *bytes )
+{
+    return ( bytes[0] << 24 ) | ( bytes[1] << 16 ) | ( bytes[2] << 8 ) |
+             bytes[3];
+};
+
+//  ---------------------------------------------------------------------------
+//  Reads up to size bytes of a file. Returns number read.
+//  ---------------------------------------------------------------------------
+static size_t readFile( const char *path, uint8_t *bytes, size_t size )
+{
+    FILE  *fp;
+    size_t count;
+
+    fp = fopen( path, "rb" );
+    if ( fp == NULL ) return 0;
+    count = fread( bytes, 1, size, fp );
+    fclose( fp );
+
+    return count;
+};
+
+//  ---------------------------------------------------------------------------
+//  Returns the revision code, or 0 if not found.
+//  ---------------------------------------------------------------------------
+static uint32_t readRevision( void )
+{
+    FILE        *fp;
+    char         line[128];
+    uint8_t      bytes[4];
+    unsigned int revision = 0;
+
+    // Newer kernels give the code as a cell, so no text to parse.
+    if ( readFile( BOARD_REVISION, bytes, 4 ) == 4 ) return cell( bytes );
+
+    fp = fopen( BOARD_CPUINFO, "r" );
+    if ( fp == NULL ) return 0;
+
+    while ( fgets( line, sizeof( line ), fp ) != NULL )
+        if (( strncmp( line, "Revision", 8 ) == 0 ) &&
+            ( sscanf( line, "Revision : %x", &revision ) == 1 ))
+            break;
+    fclose( fp );
+
+    return revision;
+};
+
+//  ---------------------------------------------------------------------------
+//  Reads peripheral base and size from the device tree.
+//  ---------------------------------------------------------------------------
+/*
+    The first range maps the peripherals' bus address (0x7e000000) to the
+    ARM address. The parent address is 1 cell, or 2 on the BCM2711, where
+    the first cell is 0. Ranges above 4GB aren't used.
+*/
+static void readRanges( struct boardStruct *board )
+{
+    uint8_t  bytes[16];
+    size_t   count;
+    uint32_t base, size;
+
+    count = readFile( BOARD_RANGES, bytes, sizeof( bytes ));
+    if ( count < 12 ) return;
+
+    base = cell( &bytes[4] );
+    size = cell( &bytes[8] );
+    if (( base == 0 ) && ( count >= 16 ))
+    {
+        base = cell( &bytes[8] );
+        size = cell( &bytes[12] );
+    }
+    if ( base == 0 ) return;
+
+    board->periBase = base;
+    board->periSize = size;
+};
+
+//  ---------------------------------------------------------------------------
+//  Decodes a revision code into board, without reading any files.
+//  ---------------------------------------------------------------------------
+int8_t boardDecode( uint32_t revision, struct boardStruct *board )
+{
+    uint32_t code;
+    uint8_t  maker;
+
+    memset( board, 0, sizeof( *board ));
+    board->revision = revision;
+    board->newStyle = revision & BOARD_NEW_STYLE;
+
+    if ( board->newStyle )
+    {
+        board->type      = BOARD_TYPE( revision );
+        board->processor = BOARD_PROCESSOR( revision );
+        board->pcb       = 10 + BOARD_PCB( revision );
+        board->memory    = 256 << BOARD_MEMORY( revision );
+        maker            = BOARD_MAKER( revision );
+    }
+    else
+    {
+        code = revision & 0xffffff; // Warranty bit.
+        if (( code >= BOARD_OLD ) || ( boardOld[code].pcb == 0 ))
+        {
+            // Unknown, so assume the first board.
+            code = 0x02;
+            board->revision = 0;
+        }
+        board->type      = boardOld[code].type;
+        board->processor = BOARD_BCM2835;
+        board->pcb       = boardOld[code].pcb;
+        board->memory    = boardOld[code].memory;
+        maker            = boardOld[code].maker;
+    }
+
+    board->model = (( board->type < BOARD_MODELS ) &&
+                    ( boardModels[ board->type ][0] != '\0' )) ?
+                   boardModels[ board->type ] : "Unknown";
+    board->manufacturer = ( maker < BOARD_MAKERS ) ? boardMakers[maker] :
+                                                     "Unknown";
+
+    if ( board->processor < BOARD_PROCESSORS )
+    {
+        board->periBase = boardPeri[ board->processor ][0];
+        board->periSize = boardPeri[ board->processor ][1];
+    }
+
+    // Compute modules and the alpha have no header.
+    switch ( board->type )
+    {
+        case 0x00 :
+        case 0x01 : board->layout = ( board->pcb == 10 ) ? BOARD_LAYOUT_1 :
+                                                           BOARD_LAYOUT_2;
+                    break;
+        case 0x05 :
+        case 0x06 :
+        case 0x0a :
+        case 0x10 :
+        case 0x14 :
+        case 0x15 :
+        case 0x18 :
+        case 0x1a : board->layout = BOARD_LAYOUT_NONE; break;
+        default   : board->layout = BOARD_LAYOUT_3; break;
+    }
+
+    return ( board->revision == 0 ) ? -1 : 0;
+};
+
+//  ---------------------------------------------------------------------------
+//  Returns board information, reading it on the first call.
+//  ---------------------------------------------------------------------------
+const struct boardStruct *boardInfo( void )
+{
+    if ( boardRead ) return &board;
+
+    boardDecode( readRevision(), &board );
+    readRanges( &board );
+    boardRead = true;
+
+    return &board;
+};
@@ -0,0 +1,134 @@
+/*
+//  ===========================================================================
+
+    boardPi:
+
+    Board information for the Raspberry Pi, read once and cached.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+
+    Authors:        D.Faulke    22/01/2016
+
+    Contributors:
+
+    Changelog:
+
+        v0.1    Original version.
+
+//  Information. --------------------------------------------------------------
+
+    The revision code is read from the device tree if the kernel provides
+    it, otherwise from /proc/cpuinfo, and the peripheral base and size
+    from /proc/device-tree/soc/ranges. This is done on the first call to
+    boardInfo() and the result kept, so drivers can call it as often as
+    they like.
+
+    New style revision codes have bit 23 set and are bit fields:
+
+        +----------------------------------------------------------------+
+        | 31-24 | 23 | 22-20  | 19-16        | 15-12     | 11-4 | 3-0    |
+        |-------+----+--------+--------------+-----------+------+--------|
+        | flags | 1  | memory | manufacturer | processor | type | PCB    |
+        +----------------------------------------------------------------+
+
+        memory is 256MB << n, PCB is the minor revision, 1.n.
+
+    Old style codes are 0x02 to 0x15 and are looked up directly. Bit 24 is
+    the warranty bit on old style codes and is masked off.
+
+    If soc/ranges can't be read, e.g. on older kernels, the peripheral
+    base is that of the processor.
+*/
+
+#ifndef BOARDPI_H
+#define BOARDPI_H
+
+//  Macros. -------------------------------------------------------------------
+
+#define BOARDPI_VERSION 0001
+
+// Files.
+#define BOARD_CPUINFO  "/proc/cpuinfo"
+#define BOARD_REVISION "/proc/device-tree/system/linux,revision"
+#define BOARD_RANGES   "/proc/device-tree/soc/ranges"
+
+// New style revision code fields.
+#define BOARD_NEW_STYLE    ( 1 << 23 )
+#define BOARD_PCB( r )               (( r ) & 0xf )
+#define BOARD_TYPE( r )       ((( r ) >> 4 ) & 0xff )
+#define BOARD_PROCESSOR( r ) ((( r ) >> 12 ) & 0xf )
+#define BOARD_MAKER( r )     ((( r ) >> 16 ) & 0xf )
+#define BOARD_MEMORY( r )    ((( r ) >> 20 ) & 0x7 )
+
+// Processors.
+enum boardProcessor
+{
+    BOARD_BCM2835 = 0, // Pi 1, Zero and CM1.
+    BOARD_BCM2836 = 1, // Pi 2.
+    BOARD_BCM2837 = 2, // Pi 3, Zero 2 and CM3.
+    BOARD_BCM2711 = 3, // Pi 4, 400 and CM4.
+    BOARD_BCM2712 = 4  // Pi 5 and CM5.
+};
+
+// Header layouts, as in infoPi.
+enum boardLayout
+{
+    BOARD_LAYOUT_NONE = 0, // No header, e.g. compute modules.
+    BOARD_LAYOUT_1    = 1, // 26 pins, rev 1.0 boards.
+    BOARD_LAYOUT_2    = 2, // 26 pins, rev 2.0 boards.
+    BOARD_LAYOUT_3    = 3  // 40 pins.
+};
+
+//  Data structures. ----------------------------------------------------------
+
+struct boardStruct
+{
+    uint32_t    revision;     // Revision code.
+    bool        newStyle;     // Revision code is bit fields.
+    uint8_t     type;         // Model type, as in new style codes.
+    uint8_t     processor;    // One of boardProcessor.
+    uint8_t     pcb;          // PCB revision in tenths, e.g. 12 for 1.2.
+    uint16_t    memory;       // Memory (MB).
+    uint32_t    periBase;     // Peripheral base address.
+    uint32_t    periSize;     // Peripheral block size (bytes).
+    uint8_t     layout;       // One of boardLayout.
+    const char *model;        // Model name.
+    const char *manufacturer; // Manufacturer name.
+};
+/*
+    revision is 0 and the rest are for a Pi 1 B if the board couldn't be
+    identified.
+*/
+
+//  Functions. ----------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Returns board information, reading it on the first call.
+//  ---------------------------------------------------------------------------
+const struct boardStruct *boardInfo( void );
+
+//  ---------------------------------------------------------------------------
+//  Decodes a revision code into board, without reading any files.
+//  ---------------------------------------------------------------------------
+/*
+    Leaves periBase and periSize as those of the processor. Returns -1 if
+    the code isn't known.
+*/
+int8_t boardDecode( uint32_t revision, struct boardStruct *board );
+
+#endif
@@ -33,8 +33,8 @@
 /*
     For a shared library, compile with:
 
-        gcc -c -Wall -fpic bcm2835spi.c
-        gcc -shared -o libbcm2835spi.so bcm2835spi.o
+        gcc -c -Wall -fpic bcm2835spi.c ../../../boardPi/boardPi.c
+        gcc -shared -o libbcm2835spi.so bcm2835spi.o boardPi.o
 
     For Raspberry Pi optimisation use the following flags:
 
@@ -59,21 +59,22 @@
 #include <stdbool.h>
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <sys/eventfd.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+//  Board information.
+#include "../../../boardPi/boardPi.h"
 
 //  Companion header.
-#include bcm2835spi.h"
+#include "bcm2835spi.h"
 
 
 //  Macros. -------------------------------------------------------------------
 
-//  Number of known Pi revisions.
-#define PI_REVISIONS 17
-
-//  Pi revisions and corresponding ARM processor versions.
-#define PI_REVISION { "0002", "0003", "0004", "0005", "0006", "0007",\
-                      "0008", "0009", "0010", "0012", "0013", "000d",\
-                      "000e", "000f", "a01041", "a21041", "900092" }
-#define PI_ARM_VERS { 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 7, 7, 6 }
 /*
 
     Recommended way of addressing registers
@@ -91,7 +92,7 @@
     //  Return register address.
     inline volatile uint8_t *regAddress (registers reg )
     {
-        return reinterpret_case<volatile uint32_t *> (baseAddress + reg );
+        return reinterpret_cast<volatile uint32_t *> (baseAddress + reg );
     }
 
     //  Read from register.
@@ -107,31 +108,16 @@
     }
 */
 
-//  Inline functions. ---------------------------------------------------------
-
-//  ---------------------------------------------------------------------------
-//  Returns register adddress.
-//  ---------------------------------------------------------------------------
-inline volatile uint32_t *bcm2835_register_address( registers reg )
-{
-    return reinterpret_case<volatile uint32_t *>( bcm2835_peri_base + reg );
-}
+//  Peripheral addresses. ----------------------------------------------------
 
-//  ---------------------------------------------------------------------------
-//  Returns 32-bit register data.
-//  ---------------------------------------------------------------------------
-inline uint32_t bcm2835_register_read( registers reg )
-{
-    return *bcm2835_register_address( reg );
-}
+uint32_t bcm2835_peri_base = BCM2835_PERI_BASE_PI1;
+uint32_t bcm2835_gpio_base = BCM2835_PERI_BASE_PI1 + BCM2835_GPIO_OFFSET;
+uint32_t bcm2835_spi_base  = BCM2835_PERI_BASE_PI1 + BCM2835_SPI_OFFSET;
+uint32_t bcm2835_aux_base  = BCM2835_PERI_BASE_PI1 + BCM2835_AUX_OFFSET;
+uint32_t bcm2835_dma_base  = BCM2835_PERI_BASE_PI1 + BCM2835_DMA_OFFSET;
 
-//  ---------------------------------------------------------------------------
-//  Writes 32-bit data to register.
-//  ---------------------------------------------------------------------------
-inline void bcm2835_register_write( registers reg, uint32_t data )
-{
-    *bcm2835_register_address( reg ) = data;
-}
+volatile uint32_t *bcm2835_gpio = MAP_FAILED;
+volatile uint32_t *bcm2835_spi0 = MAP_FAILED;
 
 /*
     According to section 1.3 of the BCM2835 ARM peripherals manual, access to
@@ -155,74 +141,59 @@ inline void bcm2835_register_write( registers reg, uint32_t data )
 //  ---------------------------------------------------------------------------
 //  Returns 32-bit register data with a memory barrier.
 //  ---------------------------------------------------------------------------
-inline uint32_t bcm2835_register_read_barrier( registers reg )
+static inline uint32_t bcm2835_peri_read( volatile uint32_t *paddr )
 {
     __sync_synchronize(); // Memory barrier.
-    uint32_t data = *bcm2835_register_address( reg );
+    uint32_t data = *paddr;
     __sync_synchronize(); // Memory barrier.
     return data;
 }
 
+//  ---------------------------------------------------------------------------
+//  Returns 32-bit register data without a memory barrier.
+//  ---------------------------------------------------------------------------
+static inline uint32_t bcm2835_peri_read_nb( volatile uint32_t *paddr )
+{
+    return *paddr;
+}
+
 //  ---------------------------------------------------------------------------
 //  Writes 32-bit data to register with a memory barrier.
 //  ---------------------------------------------------------------------------
-inline void bcm2835_register_write_barrier( registers reg, uint32_t data )
+static inline void bcm2835_peri_write( volatile uint32_t *paddr,
+                                       uint32_t data )
 {
     __sync_synchronize(); // Memory barrier.
-    *bcm2835_register_address( reg ) = data;
+    *paddr = data;
     __sync_synchronize(); // Memory barrier.
 }
 
-
-//  Local functions. ----------------------------------------------------------
-
 //  ---------------------------------------------------------------------------
-//  Returns Pi revision and sets some global variables.
+//  Writes 32-bit data to register without a memory barrier.
 //  ---------------------------------------------------------------------------
-uint8_t getPiRevision( void )
+static inline void bcm2835_peri_write_nb( volatile uint32_t *paddr,
+                                          uint32_t data )
 {
+    *paddr = data;
+}
 
-// Array of Pi revision numbers and ARM processor versions.
-static char *arm_versions[2][PI_REVISIONS] = { PI_REVISION, PI_ARM_VERS };
-
-    FILE *filePtr;                  // File to read in and search.
-    static char line[ 512 ];        // Storage for each line read in.
-    static char token;              // Storage for character token.
-    static unsigned int revision;   // Revision in hex format.
-
-    // Open file for reading.
-    filePtr = fopen( "/proc/cpuinfo", "r" );
-    if ( filePtr == NULL ) return( -1 );
-
-    // Get Revision.
-    while ( fgets( line, sizeof( line ), filePtr ) != NULL )
-        if ( strncmp ( line, "Revision", 8 ) == 0 )
-            if ( !strncasecmp( "revision\t", line, 9 ))
-            {
-                // line should be "string" "colon" "hex string" "line break"
-                sscanf( line, "%s%s%x%c", &line, &token, &revision, &token );
-                    if ( token == '\n' ) break;
-            }
-    fclose ( filePtr ) ;
 
-    // Now compare against arrays to find ARM version.
-    static uint8_t arm = 0;
-    static uint8_t i;
-    for ( i = 0; i < PI_REVISIONS; i++ )
-        if ( revision == strtol( armVersions[0][i], NULL, 16 ))
-            arm = armVersions[1][i];
+//  Local functions. ----------------------------------------------------------
 
-    // Set peripheral base address according to ARM version.
-    switch( arm )
-    {
-        case 6  : bcm2835_peri_base = 0x20000000; break;
-        case 7  : bcm2835_peri_base = 0x3f000000; break;
-        default : bcm2835_peri_base = 0x20000000; break;
-    }
+//  ---------------------------------------------------------------------------
+//  Sets peripheral base addresses for the board.
+//  ---------------------------------------------------------------------------
+static void bcm2835_spi_board_init( void )
+{
+    const struct boardStruct *board = boardInfo();
 
-    if ( arm < 0 ) return 0; // If not found.
+    if ( board->periBase != 0 ) bcm2835_peri_base = board->periBase;
 
-    return revision;
+    //  Peripheral blocks are at fixed offsets from the base.
+    bcm2835_gpio_base = bcm2835_peri_base + BCM2835_GPIO_OFFSET;
+    bcm2835_spi_base  = bcm2835_peri_base + BCM2835_SPI_OFFSET;
+    bcm2835_aux_base  = bcm2835_peri_base + BCM2835_AUX_OFFSET;
+    bcm2835_dma_base  = bcm2835_peri_base + BCM2835_DMA_OFFSET;
 }
 
 
@@ -231,22 +202,21 @@ static char *arm_versions[2][PI_REVISIONS] = { PI_REVISION, PI_ARM_VERS };
 //  ---------------------------------------------------------------------------
 //  Sets specific (masked) bits in a peripheral register.
 //  ---------------------------------------------------------------------------
-void bcm2835_set_register_bits( volatile uint32_t reg,
-                                         uint32_t data,
-                                         uint32_t mask )
+static void bcm2835_peri_set_bits( volatile uint32_t *paddr,
+                                   uint32_t data, uint32_t mask )
 {
     //  Read register bits.
-    uint32_t temp = bcm2835_register_read_barrier( reg );
+    uint32_t temp = bcm2835_peri_read( paddr );
     //  Create new bit field using mask to preserve other settings.
     temp = ( temp & ~mask ) | ( data & mask );
     //  Write new bit field to register.
-    bcm2835_register_write_barrier( reg, temp )
+    bcm2835_peri_write( paddr, temp );
 }
 
 //  ---------------------------------------------------------------------------
 //  Sets BCM2835 GPIO function.
 //  ---------------------------------------------------------------------------
-void bcm2835_gpio_fsel( uint8_t gpio, uint8_t mode )
+static void bcm2835_gpio_fsel( uint8_t gpio, uint8_t mode )
 /*
     There are 6 GPFSEL (GPIO Function Select) registers that control blocks of
     10 GPIOs by setting 3 bits for each, i.e. 30 bits in total. The remaining 2
@@ -341,26 +311,50 @@ void bcm2835_gpio_fsel( uint8_t gpio, uint8_t mode )
 */
 {
     // Caclulate FSEL address
-    volatile uint32_t paddr = bcm2835_gpio + BCM2835_GPFSEL0/4 + ( pin/10 );
+    volatile uint32_t *paddr = bcm2835_gpio + GPFSEL0 / 4 + ( gpio / 10 );
     uint8_t     shift = ( gpio % 10 ) * 3;
-    uint32_t    mask  = BCM2835_GPIO_FSEL_MASK << shift;
+    uint32_t    mask  = BCM2835_GPFSEL_MASK << shift;
     uint32_t    data  = mode << shift;
-    bcm2835_register_set_bits( paddr, data, mask );
+    bcm2835_peri_set_bits( paddr, data, mask );
 }
 
 //  SPI functions. ------------------------------------------------------------
 
 //  ---------------------------------------------------------------------------
-//  Enables SPI function on default GPIOs.
+//  Maps GPIO and SPI0 registers and enables SPI function on default GPIOs.
 //  ---------------------------------------------------------------------------
-void bcm2835_spi_open( void )
+int8_t bcm2835_spi_open( void )
 {
+    int fd;
+
+    // Peripheral base depends on the board.
+    bcm2835_spi_board_init();
+
+    if (( fd = open( "/dev/mem", O_RDWR | O_SYNC )) < 0 )
+    {
+        printf( "Couldn't open /dev/mem.\n" );
+        printf( "Error code = %d.\n", errno );
+        return -1;
+    }
+
+    bcm2835_gpio = mmap( NULL, bcm2835_block_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, fd, bcm2835_gpio_base );
+    bcm2835_spi0 = mmap( NULL, bcm2835_block_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, fd, bcm2835_spi_base );
+    close( fd );
+    if ( bcm2835_gpio == MAP_FAILED || bcm2835_spi0 == MAP_FAILED )
+    {
+        printf( "Couldn't map GPIO and SPI registers.\n" );
+        bcm2835_spi_close();
+        return -1;
+    }
+
     // This driver uses the default pins with GPFSEL alternative function ALT0.
-    bcm2835_gpio_fsel( SPI_GPIO_CE0,  BCM2835_GPFSEL_ALT0 );
-    bcm2835_gpio_fsel( SPI_GPIO_CE1,  BCM2835_GPFSEL_ALT0 );
-    bcm2835_gpio_fsel( SPI_GPIO_MISO, BCM2835_GPFSEL_ALT0 );
-    bcm2835_gpio_fsel( SPI_GPIO_MOSI, BCM2835_GPFSEL_ALT0 );
-    bcm2835_gpio_fsel( SPI_GPIO_CLK,  BCM2835_GPFSEL_ALT0 );
+    bcm2835_gpio_fsel( RPI_SPI_ALT0_GPIO_CE0,  BCM2835_GPFSEL_ALTFN0 );
+    bcm2835_gpio_fsel( RPI_SPI_ALT0_GPIO_CE1,  BCM2835_GPFSEL_ALTFN0 );
+    bcm2835_gpio_fsel( RPI_SPI_ALT0_GPIO_MISO, BCM2835_GPFSEL_ALTFN0 );
+    bcm2835_gpio_fsel( RPI_SPI_ALT0_GPIO_MOSI, BCM2835_GPFSEL_ALTFN0 );
+    bcm2835_gpio_fsel( RPI_SPI_ALT0_GPIO_SCLK, BCM2835_GPFSEL_ALTFN0 );
 
     // Set SPI CS register to default values (0).
     volatile uint32_t *paddr;
@@ -368,26 +362,38 @@ void bcm2835_spi_open( void )
     bcm2835_peri_write( paddr, 0 );
 
     // Clear FIFOs.
-    bcm2835_peri_write_nb( paddr, BCM2835_SPIO_CS_CLEAR );
+    bcm2835_peri_write_nb( paddr, BCM2835_SPI_CS_CLEAR_ALL );
+
+    return 0;
 }
 
 //  ---------------------------------------------------------------------------
-//  Returns default SPI GPIOs back to inputs.
+//  Returns default SPI GPIOs back to inputs and unmaps the registers.
 //  ---------------------------------------------------------------------------
 void bcm2835_spi_close( void )
 {
-    // Set all SPI GPIO pins to input mode.
-    bcm2835_gpio_fsel( SPI_GPIO_CE0,  BCM2835_GPFSEL_INPUT );
-    bcm2835_gpio_fsel( SPI_GPIO_CE1,  BCM2835_GPFSEL_INPUT );
-    bcm2835_gpio_fsel( SPI_GPIO_MISO, BCM2835_GPFSEL_INPUT );
-    bcm2835_gpio_fsel( SPI_GPIO_MOSI, BCM2835_GPFSEL_INPUT );
-    bcm2835_gpio_fsel( SPI_GPIO_CLK,  BCM2835_GPFSEL_INPUT );
+    if ( bcm2835_gpio != MAP_FAILED )
+    {
+        // Set all SPI GPIO pins to input mode.
+        bcm2835_gpio_fsel( RPI_SPI_ALT0_GPIO_CE0,  BCM2835_GPFSEL_INPUT );
+        bcm2835_gpio_fsel( RPI_SPI_ALT0_GPIO_CE1,  BCM2835_GPFSEL_INPUT );
+        bcm2835_gpio_fsel( RPI_SPI_ALT0_GPIO_MISO, BCM2835_GPFSEL_INPUT );
+        bcm2835_gpio_fsel( RPI_SPI_ALT0_GPIO_MOSI, BCM2835_GPFSEL_INPUT );
+        bcm2835_gpio_fsel( RPI_SPI_ALT0_GPIO_SCLK, BCM2835_GPFSEL_INPUT );
+        munmap(( void * )bcm2835_gpio, bcm2835_block_size );
+        bcm2835_gpio = MAP_FAILED;
+    }
+    if ( bcm2835_spi0 != MAP_FAILED )
+    {
+        munmap(( void * )bcm2835_spi0, bcm2835_block_size );
+        bcm2835_spi0 = MAP_FAILED;
+    }
 }
 
 //  ---------------------------------------------------------------------------
 //  Sets clock divider to determine SPI bus speed.
 //  ---------------------------------------------------------------------------
-void bcm2835_spi_setDivider( uint16_t divider );
+void bcm2835_spi_setDivider( uint16_t divider )
 /*
     SPI0_CLK register:
 
@@ -443,7 +449,7 @@ void bcm2835_spi_setDivider( uint16_t divider );
 void bcm2835_spi_setDataMode( uint8_t mode )
 {
     volatile uint32_t *paddr = bcm2835_spi0 + BCM2835_SPI0_CS / 4;
-    uint32_t mask = ( BCM2835_SPI0_CS_CPOL | BCM2835_SPI0_CS_CPHA );
+    uint32_t mask = ( BCM2835_SPI_CS_CPOL | BCM2835_SPI_CS_CPHA );
     uint32_t data = mode << 2; // CPHA and CPOL are bits 2 and 3 of CS reg.
     bcm2835_peri_set_bits( paddr, data, mask );
 }
@@ -468,25 +474,25 @@ uint8_t bcm2835_spi_transferBytePolled( uint8_t data )
     volatile uint32_t mask;
 
     // Clear FIFOs
-    bits = BCM2835_SPI0_CS_CLEAR;
-    mask = BCM2835_SPI0_CS_CLEAR;
+    bits = BCM2835_SPI_CS_CLEAR_ALL;
+    mask = BCM2835_SPI_CS_CLEAR_ALL;
     bcm2835_peri_set_bits( paddr, bits, mask );
 
     // (a) Mode should already be set before calling this function.
 
     // (a) Set TA (transfer active flag).
-    bits = BCM2835_SPI0_CS_TA;
-    mask = BCM2835_SPI0_CS_TA;
+    bits = BCM2835_SPI_CS_TA;
+    mask = BCM2835_SPI_CS_TA;
     bcm2835_peri_set_bits( paddr, bits, mask );
 
     // (b) Wait for TX FIFO to have space for at least 1 byte (TXD flag = 1).
-    while ( !( bcm2835_peri_read( paddr ) & BCM2835_SPI0_CS_TXD ));
+    while ( !( bcm2835_peri_read( paddr ) & BCM2835_SPI_CS_TXD ));
 
     // Write to FIFO.
     bcm2835_peri_write_nb( fifo, data );
 
     // (c) Wait until DONE flag is set.
-    while ( !( bcm2835_peri_read_nb( paddr ) & BCM2835_SPI0_CS_DONE ));
+    while ( !( bcm2835_peri_read_nb( paddr ) & BCM2835_SPI_CS_DONE ));
 
     // Read byte from slave.
     uint32_t ret;
@@ -494,7 +500,7 @@ uint8_t bcm2835_spi_transferBytePolled( uint8_t data )
 
     // (d) Clear TA (transfer active flag).
     bits = 0;
-    mask = BCM2835_SPI0_CS_TA;
+    mask = BCM2835_SPI_CS_TA;
     bcm2835_peri_set_bits( paddr, bits, mask );
 
     return ret;
@@ -507,7 +513,7 @@ void bcm2835_spi_cs( uint8_t cs )
 {
     volatile uint32_t *paddr = bcm2835_spi0 + BCM2835_SPI0_CS / 4;
     uint32_t data = cs;
-    uint32_t mask = BCM2835_SPI0_CS_CS;
+    uint32_t mask = BCM2835_SPI_CS_CS_MASK;
     bcm2835_peri_set_bits( paddr, data, mask );
 }
 
@@ -527,125 +533,705 @@ void bcm2835_spi_setPolarity( uint8_t cs, uint8_t polarity )
     bcm2835_peri_set_bits( paddr, data, mask );
 }
 
-//  MCP42x1 functions. --------------------------------------------------------
+//  ---------------------------------------------------------------------------
+//  Transfers len bytes on SPI bus in polled mode (simultaneous read and write).
+//  ---------------------------------------------------------------------------
+void bcm2835_spi_transfern( const uint8_t *tx, uint8_t *rx, uint32_t len )
+/*
+    Same sequence as bcm2835_spi_transferBytePolled but TA is only asserted
+    once for the whole message. The Tx FIFO is topped up while TXD is set and
+    the Rx FIFO is drained while RXD is set, so the bus clock never stops
+    waiting for the CPU. The number of bytes in flight is capped at the FIFO
+    depth so that the Rx FIFO cannot overflow.
+
+    Either tx or rx may be NULL, in which case zeros are sent or received
+    data are discarded.
+*/
+{
+    volatile uint32_t *paddr = bcm2835_spi0 + BCM2835_SPI0_CS / 4;
+    volatile uint32_t *fifo  = bcm2835_spi0 + BCM2835_SPI0_FIFO / 4;
+    uint32_t txCount = 0;
+    uint32_t rxCount = 0;
+    uint32_t status;
+    uint8_t  data;
+
+    // Clear FIFOs and set TA (transfer active flag).
+    bcm2835_peri_set_bits( paddr, BCM2835_SPI_CS_CLEAR_ALL | BCM2835_SPI_CS_TA,
+                                  BCM2835_SPI_CS_CLEAR_ALL | BCM2835_SPI_CS_TA );
+
+    while ( rxCount < len )
+    {
+        status = bcm2835_peri_read_nb( paddr );
+
+        // Fill Tx FIFO while there is space and the Rx FIFO can keep up.
+        while (( txCount < len ) && ( status & BCM2835_SPI_CS_TXD ) &&
+               ( txCount - rxCount < BCM2835_SPI_FIFO_SIZE ))
+        {
+            bcm2835_peri_write_nb( fifo, tx ? tx[txCount] : 0 );
+            txCount++;
+            status = bcm2835_peri_read_nb( paddr );
+        }
+
+        // Drain Rx FIFO.
+        while (( rxCount < txCount ) && ( status & BCM2835_SPI_CS_RXD ))
+        {
+            data = bcm2835_peri_read_nb( fifo );
+            if ( rx ) rx[rxCount] = data;
+            rxCount++;
+            status = bcm2835_peri_read_nb( paddr );
+        }
+    }
+
+    // Wait until DONE flag is set.
+    while ( !( bcm2835_peri_read_nb( paddr ) & BCM2835_SPI_CS_DONE ));
+
+    // Clear TA (transfer active flag).
+    bcm2835_peri_set_bits( paddr, 0, BCM2835_SPI_CS_TA );
+}
+
+//  DMA functions. ------------------------------------------------------------
 
 //  ---------------------------------------------------------------------------
-//  Returns code version.
+//  Sends a mailbox property request.
 //  ---------------------------------------------------------------------------
-uint8_t mcp42x1_version( void )
+static uint32_t bcm2835_mbox_call( int mbox, uint32_t tag,
+                                   uint32_t count, uint32_t *args )
+/*
+    Property buffer:
+
+        [ size | code | tag | buffer size | request | args... | end tag ]
+
+    The first value returned by the firmware is written back into args[0].
+*/
 {
-    return MCP42X1_VERSION;
+    uint32_t buf[16] __attribute__(( aligned( 16 )));
+    uint32_t i;
+
+    buf[0] = ( count + 6 ) * sizeof( uint32_t );
+    buf[1] = 0;                             // Request.
+    buf[2] = tag;
+    buf[3] = count * sizeof( uint32_t );    // Buffer size.
+    buf[4] = count * sizeof( uint32_t );    // Request size.
+    for ( i = 0; i < count; i++ ) buf[5 + i] = args[i];
+    buf[5 + count] = 0;                     // End tag.
+
+    if ( ioctl( mbox, _IOWR( 100, 0, char * ), buf ) < 0 ) return 0;
+
+    return buf[5];
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns the SPI clock period in ns, used to estimate transfer times.
+//  ---------------------------------------------------------------------------
+static uint32_t bcm2835_spi_period( void )
+{
+    uint32_t divider = bcm2835_peri_read( bcm2835_spi0 + BCM2835_SPI0_CLK / 4 )
+                       & 0xffff;
+    if ( divider == 0 ) divider = 65536;
+
+    return ( uint32_t )(( uint64_t )divider * 1000000000 / BCM2835_CORE_FREQ );
+}
+
+//  ---------------------------------------------------------------------------
+//  Completion thread for asynchronous DMA transfers.
+//  ---------------------------------------------------------------------------
+static void *bcm2835_spi_dma_thread( void *arg )
+{
+    struct bcm2835_spi_dma *dma = arg;
+    volatile uint32_t *paddr = bcm2835_spi0 + BCM2835_SPI0_CS / 4;
+    struct timespec wait, now;
+    uint64_t expected, start, limit;
+    uint64_t one = 1;
+    int8_t   status;
+    void   (*callback)( struct bcm2835_spi_dma *, void * );
+    void    *cb_arg;
+
+    pthread_mutex_lock( &dma->lock );
+    while ( dma->run )
+    {
+        if ( !dma->busy )
+        {
+            pthread_cond_wait( &dma->cond, &dma->lock );
+            continue;
+        }
+        pthread_mutex_unlock( &dma->lock );
+
+        // Sleep for most of the expected transfer time.
+        expected = ( uint64_t )dma->len * 8 * bcm2835_spi_period();
+        clock_gettime( CLOCK_MONOTONIC, &now );
+        start = ( uint64_t )now.tv_sec * 1000000000 + now.tv_nsec;
+        limit = expected * 4 + BCM2835_DMA_TIMEOUT;
+        wait.tv_sec  = expected / 1000000000;
+        wait.tv_nsec = expected % 1000000000;
+        nanosleep( &wait, NULL );
+
+        // Then poll for the Rx channel to finish, giving up if DREQ stalls.
+        wait.tv_sec  = 0;
+        wait.tv_nsec = 10000;
+        status = 0;
+        while ( !( dma->rx_reg[BCM2835_DMA_CS / 4] & BCM2835_DMA_CS_END ))
+        {
+            clock_gettime( CLOCK_MONOTONIC, &now );
+            if (( uint64_t )now.tv_sec * 1000000000 + now.tv_nsec - start >
+                limit )
+            {
+                status = -1;
+                break;
+            }
+            nanosleep( &wait, NULL );
+        }
+
+        if ( status < 0 )
+        {
+            // Abort both channels and leave them reset for the next transfer.
+            printf( "DMA transfer of %u bytes timed out.\n", dma->len );
+            dma->rx_reg[BCM2835_DMA_CS / 4] = BCM2835_DMA_CS_ABORT;
+            dma->tx_reg[BCM2835_DMA_CS / 4] = BCM2835_DMA_CS_ABORT;
+            dma->rx_reg[BCM2835_DMA_CS / 4] = BCM2835_DMA_CS_RESET;
+            dma->tx_reg[BCM2835_DMA_CS / 4] = BCM2835_DMA_CS_RESET;
+        }
+        else
+        {
+            // Clear END and INT.
+            dma->rx_reg[BCM2835_DMA_CS / 4] = BCM2835_DMA_CS_END |
+                                              BCM2835_DMA_CS_INT;
+            dma->tx_reg[BCM2835_DMA_CS / 4] = BCM2835_DMA_CS_END |
+                                              BCM2835_DMA_CS_INT;
+        }
+
+        // End the SPI transfer.
+        bcm2835_peri_set_bits( paddr, 0, BCM2835_SPI_CS_TA |
+                                         BCM2835_SPI_CS_DMAEN |
+                                         BCM2835_SPI_CS_ADCS );
+
+        if ( dma->rx && status == 0 ) memcpy( dma->rx, dma->rx_dma, dma->len );
+
+        // Free before signalling, so the next transfer can be started from
+        // the callback or by whoever is woken by the event.
+        pthread_mutex_lock( &dma->lock );
+        dma->status = status;
+        dma->busy   = false;
+        callback    = dma->callback;
+        cb_arg      = dma->arg;
+        pthread_cond_broadcast( &dma->cond );
+        pthread_mutex_unlock( &dma->lock );
+
+        if ( write( dma->event, &one, sizeof( one )) < 0 )
+            printf( "Couldn't signal DMA completion.\n" );
+        if ( callback ) callback( dma, cb_arg );
+
+        pthread_mutex_lock( &dma->lock );
+    }
+    pthread_mutex_unlock( &dma->lock );
+
+    return NULL;
 }
 
 //  ---------------------------------------------------------------------------
-//  Writes byte to register of MCP42x1.
+//  Sets up DMA channels and coherent buffer for SPI transfers.
 //  ---------------------------------------------------------------------------
-int8_t mcp42x1WriteByte( struct mcp42x1 *mcp42x1,
-                         uint8_t reg, uint8_t data )
+int8_t bcm2835_spi_dma_open( struct bcm2835_spi_dma *dma,
+                             uint8_t tx_chan, uint8_t rx_chan, uint32_t max )
+/*
+    tx_chan and rx_chan should be channels not used by the firmware, e.g. 4
+    and 5 (see /sys/module/dma/parameters/dmachans on older kernels).
+    max is the largest transfer that will be requested, in bytes, up to
+    BCM2835_SPI_DMA_MAX, which is the most the header's 16-bit length can
+    hold.
+*/
 {
-    // Should work with IOCON.BANK = 0 or IOCON.BANK = 1 for PORT A and B.
-    uint8_t handle = mcp42x1->id;
+    uint32_t args[3];
+    uint32_t span;
+    int fd;
+
+    memset( dma, 0, sizeof( struct bcm2835_spi_dma ));
+    dma->base    = MAP_FAILED;
+    dma->virt    = MAP_FAILED;
+    dma->mbox    = -1;
+    dma->event   = -1;
+    dma->tx_chan = tx_chan;
+    dma->rx_chan = rx_chan;
+    dma->max     = max;
+
+    // The length in the header word is only 16 bits.
+    if ( max == 0 || max > BCM2835_SPI_DMA_MAX )
+    {
+        printf( "DMA transfers must be 1 to %u bytes.\n", BCM2835_SPI_DMA_MAX );
+        return -1;
+    }
+
+    // Control blocks, header word, Tx and Rx data, rounded up to a page.
+    span = ( max + 3 ) & ~3;
+    dma->size = 2 * sizeof( struct bcm2835_dma_cb ) + 4 + 2 * span;
+    dma->size = ( dma->size + bcm2835_page_size - 1 ) &
+                ~( bcm2835_page_size - 1 );
+
+    if (( fd = open( "/dev/mem", O_RDWR | O_SYNC )) < 0 )
+    {
+        printf( "Couldn't open /dev/mem.\n" );
+        printf( "Error code = %d.\n", errno );
+        return -1;
+    }
+
+    // Map DMA controller registers.
+    dma->base = mmap( NULL, bcm2835_page_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, bcm2835_dma_base );
+    if ( dma->base == MAP_FAILED )
+    {
+        printf( "Couldn't map DMA registers.\n" );
+        close( fd );
+        bcm2835_spi_dma_close( dma );
+        return -1;
+    }
+
+    // Allocate, lock and map coherent memory from the firmware.
+    if (( dma->mbox = open( BCM2835_MBOX_DEVICE, 0 )) < 0 )
+    {
+        printf( "Couldn't open mailbox %s.\n", BCM2835_MBOX_DEVICE );
+        close( fd );
+        bcm2835_spi_dma_close( dma );
+        return -1;
+    }
+    args[0] = dma->size;
+    args[1] = bcm2835_page_size;
+    args[2] = ( bcm2835_peri_base == BCM2835_PERI_BASE_PI1 ) ?
+              BCM2835_MBOX_MEM_FLAGS_PI1 : BCM2835_MBOX_MEM_FLAGS_PI2;
+    dma->handle = bcm2835_mbox_call( dma->mbox, BCM2835_MBOX_MEM_ALLOC, 3, args );
+    args[0] = dma->handle;
+    if ( dma->handle )
+        dma->bus = bcm2835_mbox_call( dma->mbox, BCM2835_MBOX_MEM_LOCK,
+                                      1, args );
+    if ( dma->handle == 0 || dma->bus == 0 )
+    {
+        printf( "Couldn't allocate %u bytes of DMA memory.\n", dma->size );
+        close( fd );
+        bcm2835_spi_dma_close( dma );
+        return -1;
+    }
+    dma->virt = mmap( NULL, dma->size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fd, dma->bus & ~0xc0000000 );
+    close( fd );
+    if ( dma->virt == MAP_FAILED )
+    {
+        printf( "Couldn't map DMA memory.\n" );
+        bcm2835_spi_dma_close( dma );
+        return -1;
+    }
+    dma->tx     = dma->virt + 2 * sizeof( struct bcm2835_dma_cb ) + 4;
+    dma->rx_dma = dma->tx + span;
+
+    if (( dma->event = eventfd( 0, EFD_NONBLOCK )) < 0 )
+    {
+        printf( "Couldn't create DMA completion event.\n" );
+        bcm2835_spi_dma_close( dma );
+        return -1;
+    }
+
+    // Enable and reset both channels.
+    dma->tx_reg = dma->base + BCM2835_DMA_CHANNEL( tx_chan ) / 4;
+    dma->rx_reg = dma->base + BCM2835_DMA_CHANNEL( rx_chan ) / 4;
+    dma->base[BCM2835_DMA_ENABLE / 4] |= ( 1 << tx_chan ) | ( 1 << rx_chan );
+    dma->tx_reg[BCM2835_DMA_CS / 4] = BCM2835_DMA_CS_RESET;
+    dma->rx_reg[BCM2835_DMA_CS / 4] = BCM2835_DMA_CS_RESET;
 
-    // Get register address for BANK mode.
-    uint8_t addr = mcp42x1Register[reg][bank];
+    // Set SPI DREQ thresholds.
+    bcm2835_peri_write( bcm2835_spi0 + BCM2835_SPI0_DC / 4, BCM2835_SPI_DC_DMA );
 
-    // Write byte into register.
-    return i2c_smbus_write_byte_data( handle, addr, data );
+    pthread_mutex_init( &dma->lock, NULL );
+    pthread_cond_init( &dma->cond, NULL );
+    dma->run = true;
+    if ( pthread_create( &dma->thread, NULL, bcm2835_spi_dma_thread, dma ) != 0 )
+    {
+        printf( "Couldn't start DMA completion thread.\n" );
+        dma->run = false;
+        pthread_mutex_destroy( &dma->lock );
+        pthread_cond_destroy( &dma->cond );
+        bcm2835_spi_dma_close( dma );
+        return -1;
+    }
+
+    return 0;
 }
 
 //  ---------------------------------------------------------------------------
-//  Reads byte from register of MCP42x1.
+//  Starts an asynchronous SPI transfer using DMA.
 //  ---------------------------------------------------------------------------
-int8_t mcp42x1ReadByte( struct mcp42x1 *mcp42x1, uint8_t reg )
+int8_t bcm2835_spi_transfer_async( struct bcm2835_spi_dma *dma,
+                                   const uint8_t *tx, uint8_t *rx,
+                                   uint32_t len,
+                                   void (*callback)( struct bcm2835_spi_dma *,
+                                                     void * ),
+                                   void *arg )
+/*
+    Returns immediately. Completion is signalled on dma->event (read it with
+    poll/select) and by calling callback( dma, arg ) from the completion
+    thread. rx, if not NULL, is filled before either is signalled. If tx is
+    dma->tx the data are sent in place without copying.
+    If the Rx channel hasn't finished well after the expected transfer time
+    the channels are reset, completion is still signalled and dma->status
+    (also returned by bcm2835_spi_dma_wait) is -1.
+*/
 {
-    // Should work with IOCON.BANK = 0 or IOCON.BANK = 1 for PORT A and B.
-    uint8_t handle = mcp42x1->id;
+    volatile uint32_t *paddr = bcm2835_spi0 + BCM2835_SPI0_CS / 4;
+    struct bcm2835_dma_cb *cb = ( struct bcm2835_dma_cb * )dma->virt;
+    uint32_t *header = ( uint32_t * )( dma->tx - 4 );
+    uint32_t cs;
+
+    if ( len == 0 || len > dma->max ) return -1;
+
+    pthread_mutex_lock( &dma->lock );
+    if ( dma->busy )
+    {
+        pthread_mutex_unlock( &dma->lock );
+        return -1;
+    }
+    dma->busy     = true;
+    dma->len      = len;
+    dma->rx       = rx;
+    dma->callback = callback;
+    dma->arg      = arg;
+
+    if ( tx == NULL ) memset( dma->tx, 0, len );
+    else if ( tx != dma->tx ) memcpy( dma->tx, tx, len );
+
+    // Header word: length in top 16 bits, CS[7:0] in the bottom 8 bits.
+    cs = bcm2835_peri_read( paddr ) & 0xff;
+    *header = ( len << 16 ) | ( cs & ~BCM2835_SPI_CS_CLEAR_ALL ) |
+              BCM2835_SPI_CS_TA;
+
+    // Tx: memory -> SPI_FIFO, header word first.
+    cb[0].ti     = BCM2835_DMA_TI_PERMAP( BCM2835_DMA_DREQ_SPI_TX ) |
+                   BCM2835_DMA_TI_DEST_DREQ | BCM2835_DMA_TI_SRC_INC |
+                   BCM2835_DMA_TI_WAIT_RESP | BCM2835_DMA_TI_NO_WIDE;
+    cb[0].source = dma->bus + 2 * sizeof( struct bcm2835_dma_cb );
+    cb[0].dest   = BCM2835_BUS_SPI_FIFO;
+    cb[0].length = 4 + (( len + 3 ) & ~3 );
+    cb[0].stride = 0;
+    cb[0].next   = 0;
+
+    // Rx: SPI_FIFO -> memory.
+    cb[1].ti     = BCM2835_DMA_TI_PERMAP( BCM2835_DMA_DREQ_SPI_RX ) |
+                   BCM2835_DMA_TI_SRC_DREQ | BCM2835_DMA_TI_DEST_INC |
+                   BCM2835_DMA_TI_WAIT_RESP | BCM2835_DMA_TI_NO_WIDE |
+                   BCM2835_DMA_TI_INTEN;
+    cb[1].source = BCM2835_BUS_SPI_FIFO;
+    cb[1].dest   = dma->bus + ( dma->rx_dma - dma->virt );
+    cb[1].length = len;
+    cb[1].stride = 0;
+    cb[1].next   = 0;
+
+    // Clear FIFOs and enable DMA with automatic chip select de-assertion.
+    bcm2835_peri_set_bits( paddr, BCM2835_SPI_CS_CLEAR_ALL |
+                                  BCM2835_SPI_CS_DMAEN |
+                                  BCM2835_SPI_CS_ADCS,
+                                  BCM2835_SPI_CS_CLEAR_ALL |
+                                  BCM2835_SPI_CS_DMAEN |
+                                  BCM2835_SPI_CS_ADCS );
+
+    // Start Rx channel first so no data are missed.
+    __sync_synchronize(); // Memory barrier.
+    dma->rx_reg[BCM2835_DMA_CONBLK_AD / 4] = dma->bus +
+                                             sizeof( struct bcm2835_dma_cb );
+    dma->tx_reg[BCM2835_DMA_CONBLK_AD / 4] = dma->bus;
+    dma->rx_reg[BCM2835_DMA_CS / 4] = BCM2835_DMA_CS_ACTIVE |
+                                      BCM2835_DMA_CS_WAIT_WRITES;
+    dma->tx_reg[BCM2835_DMA_CS / 4] = BCM2835_DMA_CS_ACTIVE |
+                                      BCM2835_DMA_CS_WAIT_WRITES;
+    __sync_synchronize(); // Memory barrier.
 
-    // Get register address for BANK mode.
-    uint8_t addr = mcp42x1Register[reg][bank];
+    pthread_cond_broadcast( &dma->cond );
+    pthread_mutex_unlock( &dma->lock );
 
-    // Return register value.
-    return i2c_smbus_read_byte_data( handle, addr );
+    return 0;
 }
 
 //  ---------------------------------------------------------------------------
-//  Initialises MCP42x1. Call for each MCP42x1.
+//  Waits for current asynchronous SPI transfer to complete.
 //  ---------------------------------------------------------------------------
-int8_t mcp42x1Init( uint8_t device, uint8_t mode, uint8_t bits, uint16_t divider );
+int8_t bcm2835_spi_dma_wait( struct bcm2835_spi_dma *dma )
 {
-    struct mcp42x1 *mcp42x1this; // MCP42x1 instance.
-    static bool init = false;    // 1st call.
-    static uint8_t index = 0;
+    int8_t status;
 
-    int8_t  id = -1;
-    uint8_t i;
+    pthread_mutex_lock( &dma->lock );
+    while ( dma->busy )
+        pthread_cond_wait( &dma->cond, &dma->lock );
+    status = dma->status;
+    pthread_mutex_unlock( &dma->lock );
+
+    return status;
+}
 
-    // Set all intances of mcp23017 to NULL on first call.
-    if ( !init )
-        for ( i = 0; i < MCP42X1_MAX; i++ )
-            mcp42x1[i] = NULL;
+//  ---------------------------------------------------------------------------
+//  Releases DMA channels and coherent buffer.
+//  ---------------------------------------------------------------------------
+void bcm2835_spi_dma_close( struct bcm2835_spi_dma *dma )
+{
+    uint32_t args[1];
 
-    // Chip Select must be 0 or 1.
+    if ( dma->run )
+    {
+        bcm2835_spi_dma_wait( dma );
+        pthread_mutex_lock( &dma->lock );
+        dma->run = false;
+        pthread_cond_broadcast( &dma->cond );
+        pthread_mutex_unlock( &dma->lock );
+        pthread_join( dma->thread, NULL );
+        pthread_mutex_destroy( &dma->lock );
+        pthread_cond_destroy( &dma->cond );
+    }
+    if ( dma->event >= 0 ) close( dma->event );
 
-    static const char *spiDevice; // Path to SPI file system.
-    switch ( device )
+    if ( dma->tx_reg )
     {
-        case 1:
-            spiDevice = "/dev/spidev0.1";
-            break;
-        default:
-            spiDevice = "/dev/spidev0.0";
-            break;
+        dma->tx_reg[BCM2835_DMA_CS / 4] = BCM2835_DMA_CS_RESET;
+        dma->rx_reg[BCM2835_DMA_CS / 4] = BCM2835_DMA_CS_RESET;
     }
+    if ( dma->base != MAP_FAILED ) munmap(( void * )dma->base,
+                                          bcm2835_page_size );
 
+    if ( dma->virt != MAP_FAILED ) munmap( dma->virt, dma->size );
 
-    // Get next available ID.
-    for ( i = 0; i < MCP42X1_MAX; i++ )
-	{
-        if ( mcp42x1[i] == NULL )  // If not already init.
-        {
-            id = i;                // Next available id.
-            i = MCP42X1_MAX;       // Break.
-        }
+    if ( dma->handle )
+    {
+        args[0] = dma->handle;
+        if ( dma->bus )
+            bcm2835_mbox_call( dma->mbox, BCM2835_MBOX_MEM_UNLOCK, 1, args );
+        args[0] = dma->handle;
+        bcm2835_mbox_call( dma->mbox, BCM2835_MBOX_MEM_FREE, 1, args );
     }
+    if ( dma->mbox >= 0 ) close( dma->mbox );
+
+    dma->base   = MAP_FAILED;
+    dma->virt   = MAP_FAILED;
+    dma->mbox   = -1;
+    dma->event  = -1;
+    dma->handle = 0;
+    dma->bus    = 0;
+    dma->tx_reg = NULL;
+    dma->rx_reg = NULL;
+}
 
-    if ( id < 0 ) return -1;        // Return if not init.
+//  Bus scheduler functions. --------------------------------------------------
 
-    // Allocate memory for MCP23017 data structure.
-    mcp42x1this = malloc( sizeof ( struct mcp42x1 ));
+//  ---------------------------------------------------------------------------
+//  Programs bus settings for a device if they differ from the last device.
+//  ---------------------------------------------------------------------------
+static void bcm2835_spi_bus_select( struct bcm2835_spi_bus *bus,
+                                    struct bcm2835_spi_device *device )
+{
+    struct bcm2835_spi_device *current = &bus->current;
+
+    if ( bus->programmed && current->cs       == device->cs &&
+                            current->divider  == device->divider &&
+                            current->mode     == device->mode &&
+                            current->polarity == device->polarity ) return;
+
+    if ( !bus->programmed || current->divider != device->divider )
+        bcm2835_spi_setDivider( device->divider );
+    if ( !bus->programmed || current->mode != device->mode )
+        bcm2835_spi_setDataMode( device->mode );
+    if ( !bus->programmed || current->cs != device->cs ||
+                             current->polarity != device->polarity )
+        bcm2835_spi_setPolarity( device->cs, device->polarity );
+    if ( !bus->programmed || current->cs != device->cs )
+        bcm2835_spi_cs( device->cs );
+
+    *current = *device;
+    bus->programmed = true;
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns next transaction to service, or NULL if none. Call with lock held.
+//  ---------------------------------------------------------------------------
+static struct bcm2835_spi_xfer *bcm2835_spi_bus_next(
+                                            struct bcm2835_spi_bus *bus )
+/*
+    Highest priority first. Chip selects at the same priority are taken in
+    turn so that two displays get an equal share of the bus.
+*/
+{
+    uint8_t priority;
+    uint8_t i, cs;
+
+    for ( priority = 0; priority < BCM2835_SPI_BUS_PRIORITIES; priority++ )
+        for ( i = 0; i < BCM2835_SPI_BUS_CS; i++ )
+        {
+            cs = ( bus->turn + i ) % BCM2835_SPI_BUS_CS;
+            if ( bus->head[cs][priority] )
+            {
+                bus->turn = ( cs + 1 ) % BCM2835_SPI_BUS_CS;
+                return bus->head[cs][priority];
+            }
+        }
 
-    // Return if unable to allocate memory.
-    if ( mcp42x1this == NULL ) return -1;
+    return NULL;
+}
 
-    if (!init)
+//  ---------------------------------------------------------------------------
+//  Scheduler thread. Sends one chunk at a time from the best queue.
+//  ---------------------------------------------------------------------------
+static void *bcm2835_spi_bus_thread( void *arg )
+{
+    struct bcm2835_spi_bus  *bus = arg;
+    struct bcm2835_spi_xfer *xfer;
+    void   (*complete)( struct bcm2835_spi_xfer *xfer );
+    uint32_t chunk;
+    uint8_t  cs, priority;
+
+    pthread_mutex_lock( &bus->lock );
+    while ( true )
     {
-        // I2C communication is via device file (/dev/i2c-1).
-        if (( id = open( spiDevice, O_RDWR )) < 0 )
+        xfer = bcm2835_spi_bus_next( bus );
+        if ( xfer == NULL )
         {
-            printf( "Couldn't open SPI device %s.\n", spiDevice );
-            printf( "Error code = %d.\n", errno );
-            return -1;
+            if ( !bus->run ) break;
+            pthread_cond_wait( &bus->work, &bus->lock );
+            continue;
         }
+        pthread_mutex_unlock( &bus->lock );
+
+        // Bus is only touched by this thread, so no lock is needed here.
+        bcm2835_spi_bus_select( bus, xfer->device );
+        if ( xfer->prepare ) xfer->prepare( xfer );
+
+        chunk = xfer->len - xfer->sent;
+        if ( chunk > BCM2835_SPI_BUS_CHUNK ) chunk = BCM2835_SPI_BUS_CHUNK;
+        bcm2835_spi_transfern( xfer->tx ? xfer->tx + xfer->sent : NULL,
+                               xfer->rx ? xfer->rx + xfer->sent : NULL,
+                               chunk );
+        xfer->sent += chunk;
+
+        pthread_mutex_lock( &bus->lock );
+        if ( xfer->sent < xfer->len ) continue;
+
+        // Transaction complete - remove from head of its queue.
+        cs       = xfer->device->cs;
+        priority = xfer->priority;
+        bus->head[cs][priority] = xfer->next;
+        if ( xfer->next == NULL ) bus->tail[cs][priority] = NULL;
+
+        // Mark done before the callback, which may free or reuse xfer.
+        complete   = xfer->complete;
+        xfer->done = true;
+        pthread_cond_broadcast( &bus->done );
+        if ( complete == NULL ) continue;
+
+        pthread_mutex_unlock( &bus->lock );
+        complete( xfer );
+        pthread_mutex_lock( &bus->lock );
+    }
+    pthread_mutex_unlock( &bus->lock );
+
+    return NULL;
+}
 
-        init = true;
+//  ---------------------------------------------------------------------------
+//  Starts the bus scheduler.
+//  ---------------------------------------------------------------------------
+int8_t bcm2835_spi_bus_init( struct bcm2835_spi_bus *bus )
+{
+    memset( bus, 0, sizeof( struct bcm2835_spi_bus ));
+    pthread_mutex_init( &bus->lock, NULL );
+    pthread_cond_init( &bus->work, NULL );
+    pthread_cond_init( &bus->done, NULL );
+    bus->run = true;
+    if ( pthread_create( &bus->thread, NULL, bcm2835_spi_bus_thread, bus ) != 0 )
+    {
+        printf( "Couldn't start SPI bus scheduler thread.\n" );
+        bus->run = false;
+        pthread_mutex_destroy( &bus->lock );
+        pthread_cond_destroy( &bus->work );
+        pthread_cond_destroy( &bus->done );
+        return -1;
     }
 
-    // Create an instance of this device.
-    mcp42x1this->id = id; // SPI handle.
-    mcp42x1this->device = device; // Chip Select of MCP42x1.
-    mcp42x1[index] = mcp42x1this; // Copy into instance.
-    index++;                        // Increment index for next MCP23017.
+    return 0;
+}
 
-    uint8_t mode
+//  ---------------------------------------------------------------------------
+//  Queues a transaction on the bus.
+//  ---------------------------------------------------------------------------
+int8_t bcm2835_spi_bus_submit( struct bcm2835_spi_bus *bus,
+                               struct bcm2835_spi_xfer *xfer )
+/*
+    xfer and its buffers must remain valid until it is complete. Once
+    complete() is called the scheduler no longer touches xfer, so complete()
+    may free or resubmit it, but then xfer must not also be waited on.
+*/
+{
+    uint8_t cs       = xfer->device->cs;
+    uint8_t priority = xfer->priority;
+
+    if ( cs >= BCM2835_SPI_BUS_CS || priority >= BCM2835_SPI_BUS_PRIORITIES )
+        return -1;
+
+    xfer->sent = 0;
+    xfer->done = ( xfer->len == 0 );
+    xfer->next = NULL;
+    if ( xfer->done ) return 0;
 
-    // Set slave address for this device.
-    if ( ioctl( mcp42x1this->id, I2C_SLAVE, mcp42x1this->addr ) < 0 )
+    pthread_mutex_lock( &bus->lock );
+    if ( !bus->run )
     {
-        printf( "Couldn't set slave address 0x%02x.\n", mcp42x1this->addr );
-        printf( "Error code = %d.\n", errno );
+        pthread_mutex_unlock( &bus->lock );
         return -1;
     }
+    if ( bus->tail[cs][priority] ) bus->tail[cs][priority]->next = xfer;
+    else bus->head[cs][priority] = xfer;
+    bus->tail[cs][priority] = xfer;
+    pthread_cond_signal( &bus->work );
+    pthread_mutex_unlock( &bus->lock );
+
+    return 0;
+}
 
-    return id;
-};
+//  ---------------------------------------------------------------------------
+//  Waits for a queued transaction to complete.
+//  ---------------------------------------------------------------------------
+void bcm2835_spi_bus_wait( struct bcm2835_spi_bus *bus,
+                           struct bcm2835_spi_xfer *xfer )
+{
+    pthread_mutex_lock( &bus->lock );
+    while ( !xfer->done )
+        pthread_cond_wait( &bus->done, &bus->lock );
+    pthread_mutex_unlock( &bus->lock );
+}
 
+//  ---------------------------------------------------------------------------
+//  Queues a transaction and waits for it to complete.
+//  ---------------------------------------------------------------------------
+int8_t bcm2835_spi_bus_transfer( struct bcm2835_spi_bus *bus,
+                                 struct bcm2835_spi_device *device,
+                                 const uint8_t *tx, uint8_t *rx,
+                                 uint32_t len, uint8_t priority )
+{
+    struct bcm2835_spi_xfer xfer =
+    {
+        .device   = device,
+        .tx       = tx,
+        .rx       = rx,
+        .len      = len,
+        .priority = priority
+    };
+
+    if ( bcm2835_spi_bus_submit( bus, &xfer ) < 0 ) return -1;
+    bcm2835_spi_bus_wait( bus, &xfer );
+
+    return 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Stops the bus scheduler once all queued transactions are complete.
+//  ---------------------------------------------------------------------------
+void bcm2835_spi_bus_close( struct bcm2835_spi_bus *bus )
+{
+    pthread_mutex_lock( &bus->lock );
+    bus->run = false;
+    pthread_cond_signal( &bus->work );
+    pthread_mutex_unlock( &bus->lock );
+
+    pthread_join( bus->thread, NULL );
+    pthread_mutex_destroy( &bus->lock );
+    pthread_cond_destroy( &bus->work );
+    pthread_cond_destroy( &bus->done );
+}
@@ -21,7 +21,7 @@
 */
 //  ===========================================================================
 
-#define BCM2835SPI_VERSION 0100
+#define BCM2835SPI_VERSION 0108
 
 //  ===========================================================================
 /*
@@ -32,11 +32,24 @@
     Changelog:
 
         v1.00   Original version.
+        v1.01   Added bulk FIFO transfers and asynchronous DMA transfers.
+        v1.02   Added shared bus scheduler.
+        v1.03   Peripheral base from boardPi.
+        v1.04   Registers accessed through mapped pointers.
+        v1.05   DMA completion timeout and error unwinding.
+        v1.06   Board set up is internal, so gpioPi can be linked with it.
+        v1.07   Bus scheduler start failure is returned.
+        v1.08   DMA transfers limited to 16-bit lengths, and marked done
+                before completion is signalled.
 */
 //  ===========================================================================
 
-#ifndef MCP42X1_H
-#define MCP42X1_H
+#ifndef BCM2835SPI_H
+#define BCM2835SPI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
 
 /*
     This is an attempt to provide a small self contained library specifically
@@ -81,94 +94,114 @@
 
 
 //  Peripheral base address (for non-deice tree versions). --------------------
-static volatile uint32_t bcm2835_peri_base = 0x20000000; // Model 1.
+#define BCM2835_PERI_BASE_PI1 0x20000000 // Model 1.
 //  Model 2 has a base address of 0x3f000000 but this can be set later.
 
 //  Offsets for specific peripheral registers. ---------------------------------
-static volatile uint32_t bcm2835_gpio_base = bcm2835_peri_base + 0x200000;
-static volatile uint32_t bcm2835_spi_base  = bcm2835_peri_base + 0x204000;
-static volatile uint32_t bcm2835_aux_base  = bcm2835_peri_base + 0x215000;
+#define BCM2835_GPIO_OFFSET 0x200000
+#define BCM2835_SPI_OFFSET  0x204000
+#define BCM2835_AUX_OFFSET  0x215000
+#define BCM2835_DMA_OFFSET  0x007000
+
+//  Physical addresses of the peripherals, see bcm2835_spi_open().
+extern uint32_t bcm2835_peri_base;
+extern uint32_t bcm2835_gpio_base;
+extern uint32_t bcm2835_spi_base;
+extern uint32_t bcm2835_aux_base;
+extern uint32_t bcm2835_dma_base;
+
+//  Mapped GPIO and SPI0 registers, see bcm2835_spi_open().
+extern volatile uint32_t *bcm2835_gpio;
+extern volatile uint32_t *bcm2835_spi0;
+
+//  Peripherals as seen by the DMA controller (VC bus addresses).
+#define BCM2835_BUS_PERI_BASE 0x7e000000
+#define BCM2835_BUS_SPI_FIFO  ( BCM2835_BUS_PERI_BASE + 0x204004 )
 
 
 //  RPi memory specifics - see Raspberry Pi Hardware Reference. ---------------
-static const uint8_t bcm2835_page_size  = 4 * 1024;
-static const uint8_t bcm2835_block_size = 4 * 1024;
+static const uint32_t bcm2835_page_size  = 4 * 1024;
+static const uint32_t bcm2835_block_size = 4 * 1024;
 
 
 //  Register address offsets. -------------------------------------------------
-enum bcm2835_registers
+enum bcm2835_gpio_reg // Offsets from bcm2835_gpio_base.
 {
 
     //  GPIO registers - "BCM2835 ARM Peripherals", section 6.1.
 
-    GPFSEL0     = bcm2835_gpio_base + 0x00, // GPIO Function Select 0.
-    GPFSEL1     = bcm2835_gpio_base + 0x04, // GPIO Function Select 1.
-    GPFSEL2     = bcm2835_gpio_base + 0x08, // GPIO Function Select 2.
-    GPFSEL3     = bcm2835_gpio_base + 0x0c, // GPIO Function Select 3.
-    GPFSEL4     = bcm2835_gpio_base + 0x10, // GPIO Function Select 4.
-    GPFSEL5     = bcm2835_gpio_base + 0x14, // GPIO Function Select 5.
-    //          = bcm2835_gpio_base + 0x18, // Reserved
-    GPSET0      = bcm2835_gpio_base + 0x1c, // GPIO pin output set 0.
-    GPSET1      = bcm2835_gpio_base + 0x20, // GPIO pin output set 1.
-    //          = bcm2835_gpio_base + 0x24, // Reserved.
-    GPCLR0      = bcm2835_gpio_base + 0x28, // GPIO pin output clear 0.
-    GPCLR1      = bcm2835_gpio_base + 0x2c, // GPIO pin output clear 1.
-    //          = bcm2835_gpio_base + 0x30, // Reserved.
-    GPLEV0      = bcm2835_gpio_base + 0x34, // GPIO pin level 0.
-    GPLEV1      = bcm2835_gpio_base + 0x38, // GPIO pin level 1.
-    //          = bcm2835_gpio_base + 0x3c, // Reserved.
-    GPEDS0      = bcm2835_gpio_base + 0x40, // GPIO pin event detect status 0.
-    GPEDS1      = bcm2835_gpio_base + 0x44, // GPIO pin event detect status 1.
-    //          = bcm2835_gpio_base + 0x48, // Reserved.
-    GPREN0      = bcm2835_gpio_base + 0x4c, // GPIO pin rising edge detect enable 0.
-    GPREN1      = bcm2835_gpio_base + 0x50, // GPIO pin rising edge detect enable 1.
-    //          = bcm2835_gpio_base + 0x54, // Reserved.
-    GPFEN0      = bcm2835_gpio_base + 0x58, // GPIO pin falling edge detect enable 0.
-    GPFEN1      = bcm2835_gpio_base + 0x5c, // GPIO pin falling edge detect enable 1.
-    //          = bcm2835_gpio_base + 0x60, // Reserved.
-    GPHEN0      = bcm2835_gpio_base + 0x64, // GPIO pin high detect enable 0.
-    GPHEN1      = bcm2835_gpio_base + 0x68, // GPIO pin high detect enable 1.
-    //          = bcm2835_gpio_base + 0x6c, // Reserved.
-    GPLEN0      = bcm2835_gpio_base + 0x70, // GPIO pin low detect enable 0.
-    GPLEN0      = bcm2835_gpio_base + 0x74, // GPIO pin low detect enable 1.
-    //          = bcm2835_gpio_base + 0x78, // Reserved.
-    GPAREN0     = bcm2835_gpio_base + 0x7c, // GPIO pin async rising edge detect 0.
-    GPAREN0     = bcm2835_gpio_base + 0x80, // GPIO pin async rising edge detect 1.
-    //          = bcm2835_gpio_base + 0x84, // Reserved.
-    GPAFEN0     = bcm2835_gpio_base + 0x88, // GPIO pin async falling edge detect 0.
-    GPAFEN1     = bcm2835_gpio_base + 0x8c, // GPIO pin async falling edge detect 1.
-    //          = bcm2835_gpio_base + 0x90, // Reserved.
-    GPPUD       = bcm2835_gpio_base + 0x94, // GPIO pin pull-up/down enable.
-    GPPUDCLK0   = bcm2835_gpio_base + 0x98, // GPIO pin pull-up/down enable clock 0.
-    GPPUDCLK0   = bcm2835_gpio_base + 0x9c  // GPIO pin pull-up/down enable clock 1.
-    //          = bcm2835_gpio_base + 0xa0, // Reserved.
-    //          = bcm2835_gpio_base + 0xb0  // Test.
+    GPFSEL0     = 0x00, // GPIO Function Select 0.
+    GPFSEL1     = 0x04, // GPIO Function Select 1.
+    GPFSEL2     = 0x08, // GPIO Function Select 2.
+    GPFSEL3     = 0x0c, // GPIO Function Select 3.
+    GPFSEL4     = 0x10, // GPIO Function Select 4.
+    GPFSEL5     = 0x14, // GPIO Function Select 5.
+    //          = 0x18, // Reserved
+    GPSET0      = 0x1c, // GPIO pin output set 0.
+    GPSET1      = 0x20, // GPIO pin output set 1.
+    //          = 0x24, // Reserved.
+    GPCLR0      = 0x28, // GPIO pin output clear 0.
+    GPCLR1      = 0x2c, // GPIO pin output clear 1.
+    //          = 0x30, // Reserved.
+    GPLEV0      = 0x34, // GPIO pin level 0.
+    GPLEV1      = 0x38, // GPIO pin level 1.
+    //          = 0x3c, // Reserved.
+    GPEDS0      = 0x40, // GPIO pin event detect status 0.
+    GPEDS1      = 0x44, // GPIO pin event detect status 1.
+    //          = 0x48, // Reserved.
+    GPREN0      = 0x4c, // GPIO pin rising edge detect enable 0.
+    GPREN1      = 0x50, // GPIO pin rising edge detect enable 1.
+    //          = 0x54, // Reserved.
+    GPFEN0      = 0x58, // GPIO pin falling edge detect enable 0.
+    GPFEN1      = 0x5c, // GPIO pin falling edge detect enable 1.
+    //          = 0x60, // Reserved.
+    GPHEN0      = 0x64, // GPIO pin high detect enable 0.
+    GPHEN1      = 0x68, // GPIO pin high detect enable 1.
+    //          = 0x6c, // Reserved.
+    GPLEN0      = 0x70, // GPIO pin low detect enable 0.
+    GPLEN1      = 0x74, // GPIO pin low detect enable 1.
+    //          = 0x78, // Reserved.
+    GPAREN0     = 0x7c, // GPIO pin async rising edge detect 0.
+    GPAREN1     = 0x80, // GPIO pin async rising edge detect 1.
+    //          = 0x84, // Reserved.
+    GPAFEN0     = 0x88, // GPIO pin async falling edge detect 0.
+    GPAFEN1     = 0x8c, // GPIO pin async falling edge detect 1.
+    //          = 0x90, // Reserved.
+    GPPUD       = 0x94, // GPIO pin pull-up/down enable.
+    GPPUDCLK0   = 0x98, // GPIO pin pull-up/down enable clock 0.
+    GPPUDCLK1   = 0x9c  // GPIO pin pull-up/down enable clock 1.
+    //          = 0xa0, // Reserved.
+    //          = 0xb0  // Test.
+};
+
+enum bcm2835_aux_reg // Offsets from bcm2835_aux_base.
+{
 
     //  AUX registers.
 
-    AUXIRQ       = bcm2835_aux_base + 0x00, // Auxiliary interrupt status.
-    AUXENABLES   = bcm2835_aux_base + 0x04, // Auxiliary enables.
-    AUXMUIO      = bcm2835_aux_base + 0x40, // Mini UART I/O data.
-    AUXMUIER     = bcm2835_aux_base + 0x44, // Mini UART interrupt enable.
-    AUXMUIIR     = bcm2835_aux_base + 0x48, // Mini UART interrupt identify.
-    AUXMULCR     = bcm2835_aux_base + 0x4c, // Mini UART line control.
-    AUXMUMCR     = bcm2835_aux_base + 0x50, // Mini UART MODEM control.
-    AUXMULSR     = bcm2835_aux_base + 0x54, // Mini UART line status.
-    AUXMUMSR     = bcm2835_aux_base + 0x58, // Mini UART MODEM status.
-    AUXMUSCRATCH = bcm2835_aux_base + 0x5c, // Mini UART scratch.
-    AUXMUCNTL    = bcm2835_aux_base + 0x60, // Mini UART extra control.
-    AUXMUSTAT    = bcm2835_aux_base + 0x64, // Mini UART extra status.
-    AUXMUBAUD    = bcm2835_aux_base + 0x68, // Mini UART BAUD rate.
-    AUXSPI0CNTL0 = bcm2835_aux_base + 0x80, // SPI1 control register 0.
-    AUXSPI0CNTL1 = bcm2835_aux_base + 0x84, // SPI1 control register 1.
-    AUXSPI0STAT  = bcm2835_aux_base + 0x88, // SPI1 status.
-    AUXSPI0IO    = bcm2835_aux_base + 0x90, // SPI1 data.
-    AUXSPI0PEEK  = bcm2835_aux_base + 0x94, // SPI1 peek.
-    AUXSPI0CNTL0 = bcm2835_aux_base + 0xc0, // SPI2 control register 0.
-    AUXSPI0CNTL1 = bcm2835_aux_base + 0xc4, // SPI2 control register 1.
-    AUXSPI0STAT  = bcm2835_aux_base + 0xc8, // SPI2 status.
-    AUXSPI0IO    = bcm2835_aux_base + 0xd0, // SPI2 data.
-    AUXSPI0PEEK  = bcm2835_aux_base + 0xd4  // SPI2 peek.
+    AUXIRQ       = 0x00, // Auxiliary interrupt status.
+    AUXENABLES   = 0x04, // Auxiliary enables.
+    AUXMUIO      = 0x40, // Mini UART I/O data.
+    AUXMUIER     = 0x44, // Mini UART interrupt enable.
+    AUXMUIIR     = 0x48, // Mini UART interrupt identify.
+    AUXMULCR     = 0x4c, // Mini UART line control.
+    AUXMUMCR     = 0x50, // Mini UART MODEM control.
+    AUXMULSR     = 0x54, // Mini UART line status.
+    AUXMUMSR     = 0x58, // Mini UART MODEM status.
+    AUXMUSCRATCH = 0x5c, // Mini UART scratch.
+    AUXMUCNTL    = 0x60, // Mini UART extra control.
+    AUXMUSTAT    = 0x64, // Mini UART extra status.
+    AUXMUBAUD    = 0x68, // Mini UART BAUD rate.
+    AUXSPI1CNTL0 = 0x80, // SPI1 control register 0.
+    AUXSPI1CNTL1 = 0x84, // SPI1 control register 1.
+    AUXSPI1STAT  = 0x88, // SPI1 status.
+    AUXSPI1IO    = 0x90, // SPI1 data.
+    AUXSPI1PEEK  = 0x94, // SPI1 peek.
+    AUXSPI2CNTL0 = 0xc0, // SPI2 control register 0.
+    AUXSPI2CNTL1 = 0xc4, // SPI2 control register 1.
+    AUXSPI2STAT  = 0xc8, // SPI2 status.
+    AUXSPI2IO    = 0xd0, // SPI2 data.
+    AUXSPI2PEEK  = 0xd4  // SPI2 peek.
 };
 
 
@@ -189,7 +222,7 @@ enum bcm2835_gpfsel
     BCM2835_GPFSEL_ALTFN4 = 0x03, // GPIO pin takes alt function 4, ALT4.
     BCM2835_GPFSEL_ALTFN5 = 0x02, // GPIO pin takes alt function 5, ALT5.
     BCM2835_GPFSEL_MASK   = 0x07  // Mask for GPFSEL bits.
-}
+};
 
 //  GPPUD register states, see BCM2835 ARM Peripherals Table 6-28. ------------
 enum bcm2835_gppud
@@ -235,12 +268,12 @@ enum bcm2835_gppud
 //  SPI register offset address map. ------------------------------------------
 enum bcm2835_spi_reg // See BCM2835 ARM Peripherals, Section 10.5.
 {
-    BCM2835_SPI_CS   // SPI master control and status.
-    BCM2835_SPI_FIFO // SPI master Tx and Rx FIFOs.
-    BCM2835_SPI_CLK  // SPI master clock divider.
-    BCM2835_SPI_DLEN // SPI master data length.
-    BCM2835_SPI_LTOH // SPI LOSSI mode TOH.
-    BCM2835_SPI_DC   // SPI DMA DREQ controls.
+    BCM2835_SPI0_CS   = 0x00, // SPI master control and status.
+    BCM2835_SPI0_FIFO = 0x04, // SPI master Tx and Rx FIFOs.
+    BCM2835_SPI0_CLK  = 0x08, // SPI master clock divider.
+    BCM2835_SPI0_DLEN = 0x0c, // SPI master data length.
+    BCM2835_SPI0_LTOH = 0x10, // SPI LOSSI mode TOH.
+    BCM2835_SPI0_DC   = 0x14  // SPI DMA DREQ controls.
 };
 
 
@@ -305,7 +338,7 @@ enum bcm2835_spi_gpio_alt4       // Aux SPI controller (ALT4).
 */
 #define BCM2835_SPI_CS_LEN_LONG     (1 << 25) // FIFO LOSSI mode.
 #define BCM2835_SPI_CS_DMA_LEN      (1 << 24) // Enable DMA LOSSI mode.
-#define BCM2835_SPI_CS_CSPOL(x)   ((x) << 21) // Chip select polarity.
+#define BCM2835_SPI_CS_CSPOLN(x)  ((x) << 21) // Chip select n polarity.
 #define BCM2835_SPI_CS_RXF          (1 << 20) // Rx FIFO full.
 #define BCM2835_SPI_CS_RXR          (1 << 19) // Rx FIFO needs reading.
 #define BCM2835_SPI_CS_TXD          (1 << 18) // Tx FIFO contains data.
@@ -325,6 +358,11 @@ enum bcm2835_spi_gpio_alt4       // Aux SPI controller (ALT4).
 #define BCM2835_SPI_CS_MODE(x)    ((x) <<  2) // Chip select mode.
 #define BCM2835_SPI_CS_CS(x)      ((x) <<  0) // Chip select.
 
+#define BCM2835_SPI_CS_CPOL         (1 <<  3) // Clock polarity.
+#define BCM2835_SPI_CS_CPHA         (1 <<  2) // Clock phase.
+#define BCM2835_SPI_CS_CLEAR_ALL  BCM2835_SPI_CS_CLEAR( 3 ) // Clear Tx and Rx.
+#define BCM2835_SPI_CS_CS_MASK    BCM2835_SPI_CS_CS( 3 )    // Chip select bits.
+
 enum bcm2835_spi_cs_mode    // Chip select modes.
 {                           //  (CPOL, CPHA)
     BCM2835_SPI_CS_MODE0,   //     (0, 0)
@@ -355,7 +393,7 @@ enum bcm2835_spi_cs_cs      // Chip select values.
 #define BCM2835_AUX_SPI_CNTL0_POSTINP       (1 << 16) // Post-input mode.
 #define BCM2835_AUX_SPI_CNTL0_VARCS         (1 << 15) // Variable CS.
 #define BCM2835_AUX_SPI_CNTL0_VARWIDTH      (1 << 14) // Variable width.
-#define BCM2835_AUX_SPI_CNTL0_DOUTHOLD    ((x) << 12) // DOUT hold time.
+#define BCM2835_AUX_SPI_CNTL0_DOUTHOLD(x) ((x) << 12) // DOUT hold time.
 #define BCM2835_AUX_SPI_CNTL0_ENABLE        (1 << 11) // Enable.
 #define BCM2835_AUX_SPI_CNTL0_IRISING(x)  ((x) << 10) // In rising.
 #define BCM2835_AUX_SPI_CNTL0_CLRFIFOS      (1 <<  9) // Clear FIFOs.
@@ -496,10 +534,290 @@ enum bcm2835_spi_cs_cs      // Chip select values.
             complete.
 */
 
+//  SPI FIFO. -----------------------------------------------------------------
+/*
+    The Tx and Rx FIFOs are each 16 words deep. In polled mode each write to
+    SPI_FIFO queues one byte, so no more than BCM2835_SPI_FIFO_SIZE bytes are
+    kept in flight at once to guarantee that the Rx FIFO cannot overflow while
+    it is being drained.
+*/
+#define BCM2835_SPI_FIFO_SIZE 16
+
+//  SPI DC register thresholds used for DMA (same as the Linux driver).
+#define BCM2835_SPI_DC_DMA ( BCM2835_SPI_DC_RPANIC( 0x30 ) | \
+                             BCM2835_SPI_DC_RDREQ ( 0x20 ) | \
+                             BCM2835_SPI_DC_TPANIC( 0x10 ) | \
+                             BCM2835_SPI_DC_TDREQ ( 0x20 ))
+
+
+//  DMA controller. -----------------------------------------------------------
+/*
+    See BCM2835 ARM Peripherals, Section 4.
+
+    Channels 0-14 each have a block of registers at dma_base + 0x100 * n. A
+    channel is started by writing the bus address of a 256-bit aligned control
+    block to CONBLK_AD and setting ACTIVE in CS. Control blocks and the data
+    they point at must be in memory that the VideoCore can see without going
+    through the ARM caches, which is obtained from the firmware via the
+    mailbox property interface (/dev/vcio).
+
+            +---------------------------------------------------+
+            | Offset | Register  | Description                  |
+            |--------+-----------+------------------------------|
+            |  0x00  | CS        | Control and status.          |
+            |  0x04  | CONBLK_AD | Control block address.       |
+            |  0x08  | TI        | Transfer information.        |
+            |  0x0c  | SOURCE_AD | Source address.              |
+            |  0x10  | DEST_AD   | Destination address.         |
+            |  0x14  | TXFR_LEN  | Transfer length.             |
+            |  0x18  | STRIDE    | 2D stride.                   |
+            |  0x1c  | NEXTCONBK | Next control block address.  |
+            |  0x20  | DEBUG     | Debug.                       |
+            +---------------------------------------------------+
+*/
+#define BCM2835_DMA_CHANNEL(x)  (( x ) * 0x100 ) // Channel register block.
+#define BCM2835_DMA_CS          0x00 // Control and status.
+#define BCM2835_DMA_CONBLK_AD   0x04 // Control block address.
+#define BCM2835_DMA_DEBUG       0x20 // Debug.
+#define BCM2835_DMA_ENABLE      0xff0 // Global channel enable.
+
+#define BCM2835_DMA_CS_RESET        (1 << 31) // Reset channel.
+#define BCM2835_DMA_CS_ABORT        (1 << 30) // Abort current CB.
+#define BCM2835_DMA_CS_WAIT_WRITES  (1 << 28) // Wait for outstanding writes.
+#define BCM2835_DMA_CS_PANIC(x)   ((x) << 20) // AXI panic priority.
+#define BCM2835_DMA_CS_PRIORITY(x) ((x) << 16) // AXI priority.
+#define BCM2835_DMA_CS_ERROR        (1 <<  8) // Error.
+#define BCM2835_DMA_CS_INT          (1 <<  2) // Interrupt status.
+#define BCM2835_DMA_CS_END          (1 <<  1) // Transfer complete.
+#define BCM2835_DMA_CS_ACTIVE       (1 <<  0) // Active.
+
+#define BCM2835_DMA_TI_NO_WIDE      (1 << 26) // No wide bursts.
+#define BCM2835_DMA_TI_PERMAP(x)  ((x) << 16) // Peripheral DREQ.
+#define BCM2835_DMA_TI_SRC_DREQ     (1 << 10) // Source paced by DREQ.
+#define BCM2835_DMA_TI_SRC_INC      (1 <<  8) // Increment source.
+#define BCM2835_DMA_TI_DEST_DREQ    (1 <<  6) // Destination paced by DREQ.
+#define BCM2835_DMA_TI_DEST_INC     (1 <<  4) // Increment destination.
+#define BCM2835_DMA_TI_WAIT_RESP    (1 <<  3) // Wait for write response.
+#define BCM2835_DMA_TI_INTEN        (1 <<  0) // Interrupt enable.
+
+#define BCM2835_DMA_DREQ_SPI_TX 6 // DREQ for SPI Tx.
+#define BCM2835_DMA_DREQ_SPI_RX 7 // DREQ for SPI Rx.
+
+//  DMA control block - must be 32 byte aligned.
+struct bcm2835_dma_cb
+{
+    uint32_t ti;        // Transfer information.
+    uint32_t source;    // Source bus address.
+    uint32_t dest;      // Destination bus address.
+    uint32_t length;    // Transfer length in bytes.
+    uint32_t stride;    // 2D stride (unused).
+    uint32_t next;      // Next control block bus address (0 = stop).
+    uint32_t pad[2];    // Reserved.
+};
+
+//  Completion timeout, in ns, on top of the expected transfer time.
+#define BCM2835_DMA_TIMEOUT 100000000 // 100ms.
+
+//  Mailbox memory allocation. ------------------------------------------------
+#define BCM2835_MBOX_DEVICE     "/dev/vcio"
+#define BCM2835_MBOX_MEM_ALLOC  0x3000c // Allocate memory.
+#define BCM2835_MBOX_MEM_LOCK   0x3000d // Lock memory, returns bus address.
+#define BCM2835_MBOX_MEM_UNLOCK 0x3000e // Unlock memory.
+#define BCM2835_MBOX_MEM_FREE   0x3000f // Release memory.
+#define BCM2835_MBOX_MEM_FLAGS_PI1 0x0c // Coherent, L1 non-allocating.
+#define BCM2835_MBOX_MEM_FLAGS_PI2 0x04 // Direct, uncached.
+#define BCM2835_SPI_DMA_MAX    0xffff // Longest DMA transfer (DLEN bits).
+
+
+//  Asynchronous DMA transfers. -----------------------------------------------
+/*
+    A DMA transfer uses two channels. The Tx channel writes a header word
+    (transfer length and CS bits) followed by the data into SPI_FIFO, paced by
+    the SPI Tx DREQ. The Rx channel reads the same number of bytes out of
+    SPI_FIFO, paced by the Rx DREQ, so the transfer is complete when the Rx
+    channel signals END.
+
+    The DMA interrupt is not available to user space, so completion is picked
+    up by a helper thread that sleeps for the expected transfer time and then
+    polls END. On completion, the transfer is marked done and then the
+    eventfd is signalled and the callback, if any, is called from the helper
+    thread, so either can start the next transfer straight away.
+
+    The coherent buffer is laid out as:
+
+        [ Tx CB | Rx CB | Tx header | Tx data ... | Rx data ... ]
+
+    and dma->tx may be filled in place to avoid copying the Tx data.
+*/
+struct bcm2835_spi_dma
+{
+    volatile uint32_t *base;    // Mapped DMA controller registers.
+    volatile uint32_t *tx_reg;  // Tx channel registers.
+    volatile uint32_t *rx_reg;  // Rx channel registers.
+    uint8_t  tx_chan;           // Tx DMA channel.
+    uint8_t  rx_chan;           // Rx DMA channel.
+    int      mbox;              // Mailbox handle.
+    uint32_t handle;            // Firmware memory handle.
+    uint32_t bus;               // Bus address of coherent buffer.
+    uint32_t size;              // Size of coherent buffer.
+    uint8_t *virt;              // Mapped coherent buffer.
+    uint8_t *tx;                // Tx data in coherent buffer.
+    uint8_t *rx_dma;            // Rx data in coherent buffer.
+    uint32_t max;               // Maximum transfer length.
+    uint32_t len;               // Length of current transfer.
+    uint8_t *rx;                // Caller's Rx buffer (may be NULL).
+    int      event;             // eventfd, signalled on completion.
+    void   (*callback)( struct bcm2835_spi_dma *dma, void *arg );
+    void    *arg;               // Callback argument.
+    pthread_t       thread;     // Completion thread.
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    int8_t   status;            // Result of last transfer, 0 or -1.
+    bool     busy;              // Transfer in progress.
+    bool     run;               // Completion thread running.
+};
+
+
 //  BCM2835 functions. --------------------------------------------------------
 
+//  Maps the GPIO and SPI0 registers and enables SPI on the default GPIOs.
+int8_t bcm2835_spi_open( void );
+
+//  Returns default SPI GPIOs back to inputs and unmaps the registers.
+void bcm2835_spi_close( void );
+
+//  Sets clock divider to determine SPI bus speed.
+void bcm2835_spi_setDivider( uint16_t divider );
+
+//  Sets SPI data mode (0-3).
+void bcm2835_spi_setDataMode( uint8_t mode );
+
+//  Sets chip select (0-2).
+void bcm2835_spi_cs( uint8_t cs );
+
+//  Sets chip select polarity.
+void bcm2835_spi_setPolarity( uint8_t cs, uint8_t polarity );
+
+//  Transfers 1 byte in polled mode.
+uint8_t bcm2835_spi_transferBytePolled( uint8_t data );
+
+//  Polled transfer of len bytes with a single TA assertion.
+void bcm2835_spi_transfern( const uint8_t *tx, uint8_t *rx, uint32_t len );
+
+//  Sets up DMA channels and a coherent buffer for transfers up to max bytes.
+//  Returns -1 if max is 0 or more than BCM2835_SPI_DMA_MAX.
+int8_t bcm2835_spi_dma_open( struct bcm2835_spi_dma *dma,
+                             uint8_t tx_chan, uint8_t rx_chan, uint32_t max );
+
+//  Starts an asynchronous transfer. Returns -1 if busy or too long.
+int8_t bcm2835_spi_transfer_async( struct bcm2835_spi_dma *dma,
+                                   const uint8_t *tx, uint8_t *rx,
+                                   uint32_t len,
+                                   void (*callback)( struct bcm2835_spi_dma *,
+                                                     void * ),
+                                   void *arg );
+
+//  Blocks until the current asynchronous transfer has completed, returns
+//  -1 if it timed out.
+int8_t bcm2835_spi_dma_wait( struct bcm2835_spi_dma *dma );
+
+//  Releases DMA channels and coherent buffer.
+void bcm2835_spi_dma_close( struct bcm2835_spi_dma *dma );
+
+
+//  Shared bus scheduler. -----------------------------------------------------
+/*
+    Several devices (e.g. SSD1322 displays and an MCP42x1 digipot) share SPI0
+    on different chip selects. Rather than each driver assuming it owns the
+    bus, transactions are queued with the bus scheduler, which owns the
+    controller and runs them from its own thread.
+
+    Each chip select has a queue per priority. The scheduler always picks the
+    head of the highest priority non-empty queue, taking chip selects in turn
+    at the same priority, and sends at most BCM2835_SPI_BUS_CHUNK bytes of it
+    before choosing again. A long frame push therefore delays a volume change
+    by no more than one chunk.
+
+    Clock divider, data mode and chip select polarity are only reprogrammed
+    when the next chunk is for a different device to the last one.
+
+    Note that CS is de-asserted between chunks, so a transfer that must be
+    framed by a single CS assertion should not be longer than a chunk.
+*/
+#define BCM2835_SPI_BUS_CHUNK 512 // Largest uninterrupted transfer (bytes).
+#define BCM2835_SPI_BUS_CS      3 // Chip selects on SPI0.
+
+enum bcm2835_spi_bus_priority
+{
+    BCM2835_SPI_BUS_HIGH,       // Control, e.g. volume changes.
+    BCM2835_SPI_BUS_LOW,        // Bulk, e.g. frame buffer pushes.
+    BCM2835_SPI_BUS_PRIORITIES
+};
+
+//  Bus settings for a device.
+struct bcm2835_spi_device
+{
+    uint8_t  cs;        // Chip select (0-2).
+    uint16_t divider;   // Clock divider.
+    uint8_t  mode;      // Data mode (0-3).
+    uint8_t  polarity;  // Chip select polarity.
+};
+
+//  A queued transaction.
+struct bcm2835_spi_xfer
+{
+    struct bcm2835_spi_device *device;
+    const uint8_t *tx;          // Data to send (NULL sends zeros).
+    uint8_t       *rx;          // Received data (may be NULL).
+    uint32_t       len;         // Length in bytes.
+    uint8_t        priority;    // enum bcm2835_spi_bus_priority.
+    void         (*prepare)( struct bcm2835_spi_xfer *xfer );
+                                // Called before each chunk, e.g. to set DC.
+    void         (*complete)( struct bcm2835_spi_xfer *xfer );
+                                // Called from scheduler thread after done
+                                // is set. May free xfer if not waited on.
+    void          *arg;         // Caller data.
+    uint32_t       sent;        // Bytes sent so far (scheduler).
+    bool           done;        // Set when complete (scheduler).
+    struct bcm2835_spi_xfer *next;
+};
+
+struct bcm2835_spi_bus
+{
+    struct bcm2835_spi_xfer *head[BCM2835_SPI_BUS_CS][BCM2835_SPI_BUS_PRIORITIES];
+    struct bcm2835_spi_xfer *tail[BCM2835_SPI_BUS_CS][BCM2835_SPI_BUS_PRIORITIES];
+    struct bcm2835_spi_device current; // Settings last programmed.
+    bool            programmed;        // current is valid.
+    uint8_t         turn;              // Next chip select to consider.
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  work;              // Signalled on submit.
+    pthread_cond_t  done;              // Signalled on completion.
+    bool            run;
+};
+
+//  Starts the bus scheduler thread. Returns -1 if it couldn't be started.
+int8_t bcm2835_spi_bus_init( struct bcm2835_spi_bus *bus );
+
+//  Queues a transaction and returns immediately.
+int8_t bcm2835_spi_bus_submit( struct bcm2835_spi_bus *bus,
+                               struct bcm2835_spi_xfer *xfer );
+
+//  Blocks until a submitted transaction has completed.
+void bcm2835_spi_bus_wait( struct bcm2835_spi_bus *bus,
+                           struct bcm2835_spi_xfer *xfer );
+
+//  Queues a transaction and waits for it to complete.
+int8_t bcm2835_spi_bus_transfer( struct bcm2835_spi_bus *bus,
+                                 struct bcm2835_spi_device *device,
+                                 const uint8_t *tx, uint8_t *rx,
+                                 uint32_t len, uint8_t priority );
+
+//  Finishes queued transactions and stops the scheduler thread.
+void bcm2835_spi_bus_close( struct bcm2835_spi_bus *bus );
+
 
 
 
 
-#endif // #ifndef MCP42X1_H
+#endif // #ifndef BCM2835SPI_H
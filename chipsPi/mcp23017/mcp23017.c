@@ -45,6 +45,10 @@
     Changelog:
 
         v0.1    Original version.
+        v0.2    Added batched writes using I2C_RDWR.
+        v0.3    Added shadow registers to avoid read-modify-write.
+        v0.4    Added interrupt on change and single transfer captures.
+        v0.5    Each MCP23017 has its own I2C handle and slave address.
 
 //  ---------------------------------------------------------------------------
 */
@@ -54,8 +58,10 @@
 #include <stdint.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <unistd.h>
 #include <stdbool.h>
 #include <sys/ioctl.h>
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 
 #include "mcp23017.h"
@@ -92,6 +98,48 @@ uint8_t mcp23017Register[MCP23017_REGISTERS][MCP23017_BANKS] =
 
 //  MCP23017 functions. -------------------------------------------------------
 
+//  ---------------------------------------------------------------------------
+//  Returns true if register is held in the shadow.
+//  ---------------------------------------------------------------------------
+static bool mcp23017Cached( uint8_t reg )
+{
+    switch ( reg )
+    {
+        case IODIRA: case IODIRB:
+        case IOCONA: case IOCONB:
+        case GPPUA:  case GPPUB:
+        case OLATA:  case OLATB:
+            return true;
+        default:
+            return false;
+    }
+}
+
+//  ---------------------------------------------------------------------------
+//  Updates the shadow after a register write.
+//  ---------------------------------------------------------------------------
+/*
+    Writes to GPIO registers are written to the output latches. IOCONA and
+    IOCONB are the same register and set the BANK and SEQOP modes.
+*/
+static void mcp23017Cache( struct mcp23017 *mcp23017,
+                           uint8_t reg, uint8_t data )
+{
+    if ( reg == GPIOA ) reg = OLATA;
+    if ( reg == GPIOB ) reg = OLATB;
+    if ( !mcp23017Cached( reg )) return;
+
+    mcp23017->shadow[reg] = data;
+
+    if (( reg == IOCONA ) || ( reg == IOCONB ))
+    {
+        mcp23017->shadow[IOCONA] = data;
+        mcp23017->shadow[IOCONB] = data;
+        mcp23017->bank  = ( data & IOCON_BANK ) ? BANK_1 : BANK_0;
+        mcp23017->seqop = ( data & IOCON_SEQOP ) ? true : false;
+    }
+}
+
 //  ---------------------------------------------------------------------------
 //  Writes byte to register of MCP23017.
 //  ---------------------------------------------------------------------------
@@ -104,7 +152,10 @@ int8_t mcp23017WriteByte( struct mcp23017 *mcp23017,
     // Get register address for BANK mode.
     uint8_t addr = mcp23017Register[reg][bank];
     // Write byte into register.
-    return i2c_smbus_write_byte_data( handle, addr, data );
+    int8_t result = i2c_smbus_write_byte_data( handle, addr, data );
+    // Keep shadow in step.
+    if ( result >= 0 ) mcp23017Cache( mcp23017, reg, data );
+    return result;
 }
 
 //  ---------------------------------------------------------------------------
@@ -122,7 +173,15 @@ int8_t mcp23017WriteWord( struct mcp23017 *mcp23017,
     // Get register address for BANK mode.
     uint8_t addr = mcp23017Register[reg][bank];
     // Write word into register.
-    return i2c_smbus_write_word_data( handle, addr, data );
+    int8_t result = i2c_smbus_write_word_data( handle, addr, data );
+    // Low byte is written to reg and high byte to the next register.
+    if ( result >= 0 )
+    {
+        mcp23017Cache( mcp23017, reg, data & 0xff );
+        if ( reg + 1 < MCP23017_REGISTERS )
+            mcp23017Cache( mcp23017, reg + 1, data >> 8 );
+    }
+    return result;
 }
 
 //  ---------------------------------------------------------------------------
@@ -135,6 +194,8 @@ int8_t mcp23017ReadByte( struct mcp23017 *mcp23017, uint8_t reg )
     uint8_t bank = mcp23017->bank;
     // Get register address for BANK mode.
     uint8_t addr = mcp23017Register[reg][bank];
+    // Return shadow value if there is one.
+    if ( mcp23017Cached( reg )) return mcp23017->shadow[reg];
     // Return register value.
     return i2c_smbus_read_byte_data( handle, addr );
 }
@@ -152,6 +213,10 @@ int16_t mcp23017ReadWord( struct mcp23017 *mcp23017, uint8_t reg )
     uint8_t bank = mcp23017->bank;
     // Get register address for BANK mode.
     uint8_t addr = mcp23017Register[reg][bank];
+    // Return shadow values if there are some.
+    if (( reg + 1 < MCP23017_REGISTERS ) &&
+        ( mcp23017Cached( reg )) && ( mcp23017Cached( reg + 1 )))
+        return mcp23017->shadow[reg] | ( mcp23017->shadow[reg + 1] << 8 );
     // Return register value. Undefined if read PORT B and IOCON.BANK = 1.
     return i2c_smbus_read_word_data( handle, addr );
 }
@@ -162,13 +227,8 @@ int16_t mcp23017ReadWord( struct mcp23017 *mcp23017, uint8_t reg )
 bool mcp23017CheckBitsByte( struct mcp23017 *mcp23017,
                             uint8_t reg, uint8_t data )
 {
-    // Should work with IOCON.BANK = 0 or IOCON.BANK = 1 for PORT A and B.
-    uint8_t handle = mcp23017->id;
-    uint8_t bank = mcp23017->bank;
-    // Get register address for BANK mode.
-    uint8_t addr = mcp23017Register[reg][bank];
-    // Read register.
-    uint8_t read = i2c_smbus_read_byte_data( handle, addr );
+    // Read register or shadow.
+    uint8_t read = mcp23017ReadByte( mcp23017, reg );
     // Compare and return result.
     return (( data == read )? true : false );
 };
@@ -183,12 +243,8 @@ bool mcp23017CheckBitsWord( struct mcp23017 *mcp23017,
     Need to be able to check PORT - lookup table?
 */
 {
-    uint8_t  handle = mcp23017->id;
-    uint8_t  bank = mcp23017->bank;
-    // Get register address for BANK mode.
-    uint8_t  addr = mcp23017Register[reg][bank];
-    // Read register.
-    uint16_t read = i2c_smbus_read_byte_data( handle, addr );
+    // Read register or shadow.
+    uint16_t read = mcp23017ReadWord( mcp23017, reg );
     // Compare and return result. Undefined for PORT B and IOCON.BANK = 1.
     return ( data && read );
 };
@@ -196,18 +252,17 @@ bool mcp23017CheckBitsWord( struct mcp23017 *mcp23017,
 //  ---------------------------------------------------------------------------
 //  Toggles byte bits of MCP23017 register.
 //  ---------------------------------------------------------------------------
+/*
+    The bit functions only read the register if it isn't held in the
+    shadow, so changing output latch bits is a single write.
+*/
 int8_t mcp23017ToggleBitsByte( struct mcp23017 *mcp23017,
                                uint8_t reg, uint8_t data )
 {
-    // Should work with IOCON.BANK = 0 or IOCON.BANK = 1 for PORT A and B
-    uint8_t handle = mcp23017->id;
-    uint8_t bank = mcp23017->bank;
-    // Get register address for BANK mode.
-    uint8_t addr = mcp23017Register[reg][bank];
-    // Read register.
-    uint8_t read = i2c_smbus_read_byte_data( handle, addr );
+    // Read register or shadow.
+    uint8_t read = mcp23017ReadByte( mcp23017, reg );
     // Write toggled bits back to register.
-    return i2c_smbus_write_byte_data( handle, addr, data ^ read );
+    return mcp23017WriteByte( mcp23017, reg, data ^ read );
 };
 
 //  ---------------------------------------------------------------------------
@@ -220,14 +275,10 @@ int8_t mcp23017ToggleBitsWord( struct mcp23017 *mcp23017,
     Need to be able to check PORT - lookup table?
 */
 {
-    uint8_t  handle = mcp23017->id;
-    uint8_t  bank = mcp23017->bank;
-    // Get register address for BANK mode.
-    uint8_t  addr = mcp23017Register[reg][bank];
-    // Read register.
-    uint16_t read = i2c_smbus_read_byte_data( handle, addr );
+    // Read register or shadow.
+    uint16_t read = mcp23017ReadWord( mcp23017, reg );
     // Write toggled bits back to register.
-    return i2c_smbus_write_word_data( handle, addr, data ^ read );
+    return mcp23017WriteWord( mcp23017, reg, data ^ read );
 };
 
 //  ---------------------------------------------------------------------------
@@ -236,15 +287,10 @@ int8_t mcp23017ToggleBitsWord( struct mcp23017 *mcp23017,
 int8_t mcp23017SetBitsByte( struct mcp23017 *mcp23017,
                             uint8_t reg, uint8_t data )
 {
-    // Should work with IOCON.BANK = 0 or IOCON.BANK = 1 for PORT A and B
-    uint8_t handle = mcp23017->id;
-    uint8_t bank = mcp23017->bank;
-    // Get register address for BANK mode.
-    uint8_t addr = mcp23017Register[reg][bank];
-    // Read register.
-    uint8_t read = i2c_smbus_read_byte_data( handle, addr );
-    // Write toggled bits back to register.
-    return i2c_smbus_write_byte_data( handle, addr, data | read );
+    // Read register or shadow.
+    uint8_t read = mcp23017ReadByte( mcp23017, reg );
+    // Write set bits back to register.
+    return mcp23017WriteByte( mcp23017, reg, data | read );
 };
 
 //  ---------------------------------------------------------------------------
@@ -257,14 +303,10 @@ int8_t mcp23017SetBitsWord( struct mcp23017 *mcp23017,
     Need to be able to check PORT - lookup table?
 */
 {
-    uint8_t  handle = mcp23017->id;
-    uint8_t  bank = mcp23017->bank;
-    // Get register address for BANK mode.
-    uint8_t  addr = mcp23017Register[reg][bank];
-    // Read register.
-    uint16_t read = i2c_smbus_read_byte_data( handle, addr );
-    // Write toggled bits back to register.
-    return i2c_smbus_write_word_data( handle, addr, data | read );
+    // Read register or shadow.
+    uint16_t read = mcp23017ReadWord( mcp23017, reg );
+    // Write set bits back to register.
+    return mcp23017WriteWord( mcp23017, reg, data | read );
 };
 
 //  ---------------------------------------------------------------------------
@@ -273,15 +315,10 @@ int8_t mcp23017SetBitsWord( struct mcp23017 *mcp23017,
 int8_t mcp23017ClearBitsByte( struct mcp23017 *mcp23017,
                               uint8_t reg, uint8_t data )
 {
-    // Should work with IOCON.BANK = 0 or IOCON.BANK = 1 for PORT A and B.
-    uint8_t handle = mcp23017->id;
-    uint8_t bank = mcp23017->bank;
-    // Get register address for BANK mode.
-    uint8_t addr = mcp23017Register[reg][bank];
-    // Read register.
-    uint8_t read = i2c_smbus_read_byte_data( handle, addr );
+    // Read register or shadow.
+    uint8_t read = mcp23017ReadByte( mcp23017, reg );
     // Write data with cleared bits back to register.
-    return i2c_smbus_write_byte_data( handle, addr, ( data & read ) ^ read );
+    return mcp23017WriteByte( mcp23017, reg, read & ~data );
 };
 
 //  ---------------------------------------------------------------------------
@@ -294,14 +331,244 @@ int8_t mcp23017ClearBitsWord( struct mcp23017 *mcp23017,
     Need to be able to check PORT - lookup table?
 */
 {
-    uint8_t handle = mcp23017->id;
-    uint8_t bank = mcp23017->bank;
-    // Get register address for BANK mode.
-    uint8_t addr = mcp23017Register[reg][bank];
-    // Read register.
-    uint16_t read = i2c_smbus_read_byte_data( handle, addr );
+    // Read register or shadow.
+    uint16_t read = mcp23017ReadWord( mcp23017, reg );
     // Write data with cleared bits back to register.
-    return i2c_smbus_write_byte_data( handle, addr, ( data & read ) ^ read );
+    return mcp23017WriteWord( mcp23017, reg, read & ~data );
+};
+
+//  ---------------------------------------------------------------------------
+//  Writes IOCON register and updates BANK and SEQOP modes.
+//  ---------------------------------------------------------------------------
+int8_t mcp23017WriteIOCON( struct mcp23017 *mcp23017, uint8_t data )
+{
+    return mcp23017WriteByte( mcp23017, IOCONA, data );
+};
+
+//  ---------------------------------------------------------------------------
+//  Reloads the shadow registers from the MCP23017.
+//  ---------------------------------------------------------------------------
+/*
+    IOCON is read first, at its address for the current BANK mode, so that
+    the other registers are read from the right addresses.
+*/
+int8_t mcp23017Resync( struct mcp23017 *mcp23017 )
+{
+    static const uint8_t regs[] = { IOCONA, IODIRA, IODIRB,
+                                    GPPUA,  GPPUB,  OLATA,  OLATB };
+    int16_t result;
+    uint8_t i;
+
+    for ( i = 0; i < sizeof( regs ); i++ )
+    {
+        result = i2c_smbus_read_byte_data( mcp23017->id,
+                     mcp23017Register[regs[i]][mcp23017->bank] );
+        if ( result < 0 ) return -1;
+        mcp23017Cache( mcp23017, regs[i], result );
+    }
+    return 0;
+};
+
+//  Batched writes. -----------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Returns the register address the address pointer moves to after a write.
+//  ---------------------------------------------------------------------------
+/*
+    Returns 0xff if the next address isn't certain, so that a new message
+    is started.
+*/
+static uint8_t mcp23017NextAddress( struct mcp23017Batch *batch, uint8_t addr )
+{
+    // Byte mode.
+    if ( batch->seqop )
+        return ( batch->bank == BANK_0 ) ? addr ^ 0x01 : addr;
+
+    // Sequential mode.
+    if ( batch->bank == BANK_0 )
+        return ( addr == BANK0_OLATB ) ? BANK0_IODIRA : addr + 1;
+    return (( addr & 0x0f ) == BANK1_OLATA ) ? 0xff : addr + 1;
+}
+
+//  ---------------------------------------------------------------------------
+//  Starts a batch of register writes.
+//  ---------------------------------------------------------------------------
+void mcp23017BatchStart( struct mcp23017Batch *batch,
+                         struct mcp23017 *mcp23017 )
+{
+    batch->mcp23017 = mcp23017;
+    batch->bytes    = 0;
+    batch->msgs     = 0;
+    batch->next     = 0xff;
+    batch->bank     = mcp23017->bank;
+    batch->seqop    = mcp23017->seqop;
+};
+
+//  ---------------------------------------------------------------------------
+//  Queues a byte write to register of MCP23017.
+//  ---------------------------------------------------------------------------
+/*
+    Writes to IOCON change the addressing of the writes queued after them,
+    so the batch follows BANK and SEQOP itself until the shadow is updated.
+*/
+int8_t mcp23017BatchWrite( struct mcp23017Batch *batch,
+                           uint8_t reg, uint8_t data )
+{
+    // Get register address for BANK mode.
+    uint8_t addr = mcp23017Register[reg][batch->bank];
+
+    // Send batch if there isn't room for this write.
+    if ((( batch->msgs > 0 ) && ( addr == batch->next )) ?
+         ( batch->bytes + 1 > MCP23017_BATCH_BYTES ) :
+        (( batch->msgs == MCP23017_BATCH_MSGS ) ||
+         ( batch->bytes + 2 > MCP23017_BATCH_BYTES )))
+    {
+        if ( mcp23017BatchFlush( batch ) < 0 ) return -1;
+    }
+
+    // Start a new message if the address pointer won't be at register.
+    if (( batch->msgs == 0 ) || ( addr != batch->next ))
+    {
+        batch->start[batch->msgs++] = batch->bytes;
+        batch->reg[batch->bytes]    = 0xff; // Address, not a write.
+        batch->data[batch->bytes++] = addr;
+    }
+
+    batch->reg[batch->bytes]    = reg;
+    batch->data[batch->bytes++] = data;
+    batch->next = mcp23017NextAddress( batch, addr );
+
+    if (( reg == IOCONA ) || ( reg == IOCONB ))
+    {
+        batch->bank  = ( data & IOCON_BANK ) ? BANK_1 : BANK_0;
+        batch->seqop = ( data & IOCON_SEQOP ) ? true : false;
+    }
+
+    return 0;
+};
+
+//  ---------------------------------------------------------------------------
+//  Sends queued writes as a single I2C transfer.
+//  ---------------------------------------------------------------------------
+int8_t mcp23017BatchFlush( struct mcp23017Batch *batch )
+{
+    struct i2c_msg msg[MCP23017_BATCH_MSGS];
+    struct i2c_rdwr_ioctl_data transfer = { msg, batch->msgs };
+    int    result = 0;
+    uint8_t i;
+
+    if ( batch->msgs == 0 ) return 0;
+
+    for ( i = 0; i < batch->msgs; i++ )
+    {
+        msg[i].addr  = batch->mcp23017->addr;
+        msg[i].flags = 0;
+        msg[i].len   = (( i + 1 < batch->msgs ) ? batch->start[i + 1] :
+                                                  batch->bytes ) -
+                       batch->start[i];
+        msg[i].buf   = &batch->data[batch->start[i]];
+    }
+
+    result = ioctl( batch->mcp23017->id, I2C_RDWR, &transfer );
+
+    // Writes are only in the shadow once they have been sent.
+    if ( result >= 0 )
+        for ( i = 0; i < batch->bytes; i++ )
+            if ( batch->reg[i] != 0xff )
+                mcp23017Cache( batch->mcp23017, batch->reg[i],
+                               batch->data[i] );
+
+    batch->bytes = 0;
+    batch->msgs  = 0;
+    batch->next  = 0xff;
+    batch->bank  = batch->mcp23017->bank;
+    batch->seqop = batch->mcp23017->seqop;
+
+    return ( result < 0 ) ? -1 : 0;
+};
+
+//  Interrupts. ---------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Sets pins as inputs with pull-ups and interrupts on change.
+//  ---------------------------------------------------------------------------
+int8_t mcp23017InterruptInit( struct mcp23017 *mcp23017, uint16_t pins )
+{
+    static const uint8_t regs[] = { GPINTENA, GPINTENB, INTCONA, INTCONB };
+    struct mcp23017Batch batch;
+    int16_t  result;
+    uint8_t  data[sizeof( regs )];
+    uint16_t gpinten, intcon;
+    uint8_t  iocon, i;
+
+    // GPINTEN and INTCON aren't shadowed so read them first.
+    for ( i = 0; i < sizeof( regs ); i++ )
+    {
+        result = i2c_smbus_read_byte_data( mcp23017->id,
+                     mcp23017Register[regs[i]][mcp23017->bank] );
+        if ( result < 0 ) return -1;
+        data[i] = result;
+    }
+    gpinten = ( data[0] | ( data[1] << 8 )) | pins;
+    intcon  = ( data[2] | ( data[3] << 8 )) & ~pins;
+
+    iocon = mcp23017->shadow[IOCONA] | IOCON_MIRROR | IOCON_ODR;
+
+    mcp23017BatchStart( &batch, mcp23017 );
+    mcp23017BatchWrite( &batch, IOCONA, iocon );
+    mcp23017BatchWrite( &batch, IODIRA, mcp23017->shadow[IODIRA] | pins );
+    mcp23017BatchWrite( &batch, IODIRB,
+                        mcp23017->shadow[IODIRB] | ( pins >> 8 ));
+    mcp23017BatchWrite( &batch, GPPUA, mcp23017->shadow[GPPUA] | pins );
+    mcp23017BatchWrite( &batch, GPPUB, mcp23017->shadow[GPPUB] | ( pins >> 8 ));
+    // Compare with last value rather than DEFVAL.
+    mcp23017BatchWrite( &batch, INTCONA, intcon );
+    mcp23017BatchWrite( &batch, INTCONB, intcon >> 8 );
+    mcp23017BatchWrite( &batch, GPINTENA, gpinten );
+    mcp23017BatchWrite( &batch, GPINTENB, gpinten >> 8 );
+
+    return mcp23017BatchFlush( &batch );
+};
+
+//  ---------------------------------------------------------------------------
+//  Reads interrupt flags, captures and current levels, clearing interrupt.
+//  ---------------------------------------------------------------------------
+int8_t mcp23017ReadCapture( struct mcp23017 *mcp23017,
+                            struct mcp23017Capture *capture )
+{
+    static const uint8_t regs[] = { INTFA, INTFB, INTCAPA, INTCAPB,
+                                    GPIOA, GPIOB };
+    uint8_t addr = mcp23017Register[INTFA][mcp23017->bank];
+    uint8_t data[MCP23017_CAPTURE_BYTES];
+    struct i2c_msg msg[2] =
+        {{ mcp23017->addr, 0, 1, &addr },
+         { mcp23017->addr, I2C_M_RD, MCP23017_CAPTURE_BYTES, data }};
+    struct i2c_rdwr_ioctl_data transfer = { msg, 2 };
+    int16_t result;
+    uint8_t i;
+
+    if (( mcp23017->bank == BANK_0 ) && ( !mcp23017->seqop ))
+    {
+        // Address is written then registers read in one transfer.
+        if ( ioctl( mcp23017->id, I2C_RDWR, &transfer ) < 0 ) return -1;
+    }
+    else
+    {
+        // Registers aren't consecutive so read each one.
+        for ( i = 0; i < MCP23017_CAPTURE_BYTES; i++ )
+        {
+            result = i2c_smbus_read_byte_data( mcp23017->id,
+                         mcp23017Register[regs[i]][mcp23017->bank] );
+            if ( result < 0 ) return -1;
+            data[i] = result;
+        }
+    }
+
+    capture->flags    = data[0] | ( data[1] << 8 );
+    capture->captured = data[2] | ( data[3] << 8 );
+    capture->levels   = data[4] | ( data[5] << 8 );
+
+    return 0;
 };
 
 //  ---------------------------------------------------------------------------
@@ -311,30 +578,31 @@ int8_t mcp23017Init( uint8_t addr )
 {
     struct mcp23017 *mcp23017this;  // MCP23017 instance.
     static bool init = false;       // 1st call.
-    static uint8_t index = 0;
 
-    int8_t  id = -1;
+    int8_t  index = -1;
+    int     fd;
     uint8_t i;
 
     // Set all intances of mcp23017 to NULL on first call.
     if ( !init )
+    {
         for ( i = 0; i < MCP23017_MAX; i++ )
             mcp23017[i] = NULL;
+        init = true;
+    }
 
     // Address must be 0x20 to 0x27.
     if (( addr < 0x20 ) || ( addr > 0x27 )) return -1;
 
-    // Get next available ID.
+    // Get next available index.
     for ( i = 0; i < MCP23017_MAX; i++ )
-	{
-        if ( mcp23017[i] == NULL )  // If not already init.
+        if ( mcp23017[i] == NULL )
         {
-            id = i;                 // Next available id.
-            i = MCP23017_MAX;       // Break.
+            index = i;
+            break;
         }
-    }
 
-    if ( id < 0 ) return -1;        // Return if not init.
+    if ( index < 0 ) return -1;     // Return if all in use.
 
     // Allocate memory for MCP23017 data structure.
     mcp23017this = malloc( sizeof ( struct mcp23017 ));
@@ -346,38 +614,45 @@ int8_t mcp23017Init( uint8_t addr )
 */
     static const char *i2cDevice = "/dev/i2c-1"; // Path to I2C file system.
 
-    if (!init)
+    /*
+        Each MCP23017 has its own handle, since the slave address set below
+        is a property of the handle and is used by every SMBus call on it.
+    */
+    if (( fd = open( i2cDevice, O_RDWR )) < 0 )
     {
-        // I2C communication is via device file (/dev/i2c-1).
-        if (( id = open( i2cDevice, O_RDWR )) < 0 )
-        {
-            printf( "Couldn't open I2C device %s.\n", i2cDevice );
-            printf( "Error code = %d.\n", errno );
-            return -1;
-        }
-
-        init = true;
+        printf( "Couldn't open I2C device %s.\n", i2cDevice );
+        printf( "Error code = %d.\n", errno );
+        free( mcp23017this );
+        return -1;
     }
 
-    // Create an instance of this device.
-    mcp23017this->id = id;          // I2C handle.
-    mcp23017this->addr = addr;      // Address of MCP23017.
-    mcp23017this->bank = 0;         // BANK mode 0 (default).
-    mcp23017[index] = mcp23017this; // Copy into instance.
-    index++;                        // Increment index for next MCP23017.
-
     // Set slave address for this device.
-    if ( ioctl( mcp23017this->id, I2C_SLAVE, mcp23017this->addr ) < 0 )
+    if ( ioctl( fd, I2C_SLAVE, addr ) < 0 )
     {
-        printf( "Couldn't set slave address 0x%02x.\n", mcp23017this->addr );
+        printf( "Couldn't set slave address 0x%02x.\n", addr );
         printf( "Error code = %d.\n", errno );
+        close( fd );
+        free( mcp23017this );
         return -1;
     }
 
+    // Create an instance of this device.
+    mcp23017this->id = fd;          // I2C handle.
+    mcp23017this->addr = addr;      // Address of MCP23017.
+    mcp23017this->bank = 0;         // BANK mode 0 (default).
+    mcp23017this->seqop = false;    // Sequential operation (default).
+
+    // Power on register values.
+    for ( i = 0; i < MCP23017_REGISTERS; i++ )
+        mcp23017this->shadow[i] = 0x00;
+    mcp23017this->shadow[IODIRA] = 0xff;
+    mcp23017this->shadow[IODIRB] = 0xff;
+    mcp23017[index] = mcp23017this; // Copy into instance.
+
     /*
         Should probably set all registers to zero in case reset pin is
         kept high.
     */
-    return id;
+    return index;
 };
 
@@ -132,6 +132,41 @@
                 Default is 0 for all bits.
 
             The internal pull-up resistors are 100kOhm.
+
+    Batched writes:
+
+        Each SMBus call is a separate bus transaction so a sequence of
+        register writes is slow. Writes can instead be queued in a batch and
+        sent by a single I2C_RDWR ioctl as one message per run of registers.
+        A write is added to the current message if it is to the register
+        that the MCP23017 address pointer moves to next:
+
+            SEQOP = 0: Pointer increments (BANK = 0, or within a port
+                       for BANK = 1).
+            SEQOP = 1: Pointer toggles between A and B registers of a pair
+                       for BANK = 0, or stays on the same register for
+                       BANK = 1.
+
+        With BANK = 0 and SEQOP = 1, alternate writes to OLATA and OLATB
+        therefore go out as a single message.
+
+    Interrupts:
+
+        Inputs with a bit set in GPINTEN raise an interrupt when they change
+        from their last value, or from DEFVAL if set in INTCON. INTF then
+        flags the pins that caused the interrupt and INTCAP holds the port
+        as it was when it happened. The interrupt is held until INTCAP or
+        GPIO is read, and further changes aren't captured until then.
+
+        With MIRROR = 1, INTA and INTB both signal changes on either port so
+        only one Pi GPIO is needed. With ODR = 1 the INT pins are open-drain
+        and active low, so they can be pulled up by the Pi and shared with
+        other MCP23017s.
+
+        With BANK = 0 and SEQOP = 0, INTFA to GPIOB are consecutive so the
+        flags, captures and current levels of all 16 pins are read in one
+        I2C transfer. GPIO is read as well as INTCAP since it shows changes
+        made after the interrupt that INTCAP missed.
 */
 
 #ifndef MCP23017_H
@@ -199,17 +234,63 @@ typedef enum reg { IODIRA,   IODIRB,   IPOLA,    IPOLB,    GPINTENA, GPINTENB,
 #define BANK1_OLATA    0x0a
 #define BANK1_OLATB    0x1a
 
+// IOCON register bits.
+#define IOCON_BANK     0x80
+#define IOCON_MIRROR   0x40
+#define IOCON_SEQOP    0x20
+#define IOCON_DISSLW   0x10
+#define IOCON_HAEN     0x08
+#define IOCON_ODR      0x04
+#define IOCON_INTPOL   0x02
+
+#define MCP23017_BATCH_BYTES 256 // Max bytes queued in a batch.
+#define MCP23017_BATCH_MSGS   32 // Max I2C messages in a batch.
+
+#define MCP23017_CAPTURE_BYTES 6 // INTFA, INTFB, INTCAPA/B, GPIOA/B.
+
 //  Data structures. ----------------------------------------------------------
 
 typedef enum mcp23017Bank { BANK_0, BANK_1 } mcp23017Bank; // BANK mode.
 
 struct mcp23017
 {
-    uint8_t      id;   // I2C handle.
-    uint8_t      addr; // Address of MCP23017.
-    mcp23017Bank bank; // 8-bit or 16-bit mode.
+    uint8_t      id;    // I2C handle.
+    uint8_t      addr;  // Address of MCP23017.
+    mcp23017Bank bank;  // 8-bit or 16-bit mode.
+    bool         seqop; // Sequential operation disabled.
+    uint8_t      shadow[MCP23017_REGISTERS]; // IODIR, IOCON, GPPU & OLAT.
+};
+/*
+    The shadow holds the last values written to the IODIR, IOCON, GPPU and
+    OLAT registers, which are read back from the shadow rather than the
+    MCP23017. Setting, clearing or toggling output latch bits is then a
+    single write. Use mcp23017Resync if another process may have written to
+    the MCP23017.
+*/
+
+struct mcp23017Batch
+{
+    struct   mcp23017 *mcp23017;         // MCP23017 instance.
+    uint8_t  data[MCP23017_BATCH_BYTES]; // Register addresses and data.
+    uint8_t  reg[MCP23017_BATCH_BYTES];  // Register of each data byte.
+    uint16_t start[MCP23017_BATCH_MSGS]; // Start of each message in data.
+    uint16_t bytes;                      // Number of bytes queued.
+    uint8_t  msgs;                       // Number of messages queued.
+    uint8_t  next;                       // Register for next byte of message.
+    mcp23017Bank bank;                   // BANK once queued writes are sent.
+    bool     seqop;                      // SEQOP once queued writes are sent.
 };
 
+struct mcp23017Capture
+{
+    uint16_t flags;     // Pins that caused the interrupt, INTF.
+    uint16_t captured;  // Pins at the interrupt, INTCAP.
+    uint16_t levels;    // Pins when read, GPIO.
+};
+/*
+    Port A is in the low byte and port B in the high byte of each.
+*/
+
 struct mcp23017 *mcp23017[MCP23017_MAX];
 
 
@@ -285,9 +366,77 @@ int8_t mcp23017ClearBitsByte( struct mcp23017 *mcp23017,
 int8_t mcp23017ClearBitsWord( struct mcp23017 *mcp23017,
                               uint8_t reg, uint16_t data );
 
+//  ---------------------------------------------------------------------------
+//  Writes IOCON register and updates BANK and SEQOP modes.
+//  ---------------------------------------------------------------------------
+int8_t mcp23017WriteIOCON( struct mcp23017 *mcp23017, uint8_t data );
+
+//  ---------------------------------------------------------------------------
+//  Reloads the shadow registers from the MCP23017.
+//  ---------------------------------------------------------------------------
+/*
+    Returns 0 on success or -1 on failure. Assumes that BANK mode hasn't
+    been changed by another process.
+*/
+int8_t mcp23017Resync( struct mcp23017 *mcp23017 );
+
+//  Batched writes. -----------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Starts a batch of register writes.
+//  ---------------------------------------------------------------------------
+void mcp23017BatchStart( struct mcp23017Batch *batch,
+                         struct mcp23017 *mcp23017 );
+
+//  ---------------------------------------------------------------------------
+//  Queues a byte write to register of MCP23017.
+//  ---------------------------------------------------------------------------
+/*
+    The batch is sent early if it is full.
+*/
+int8_t mcp23017BatchWrite( struct mcp23017Batch *batch,
+                           uint8_t reg, uint8_t data );
+
+//  ---------------------------------------------------------------------------
+//  Sends queued writes as a single I2C transfer.
+//  ---------------------------------------------------------------------------
+/*
+    Returns 0 on success or -1 on failure. The batch is empty afterwards
+    and can be reused. The shadow is only updated with the queued writes
+    once they have been sent, so it still matches the MCP23017 after a
+    failure.
+*/
+int8_t mcp23017BatchFlush( struct mcp23017Batch *batch );
+
+//  Interrupts. ---------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Sets pins as inputs with pull-ups and interrupts on change.
+//  ---------------------------------------------------------------------------
+/*
+    pins has port A in the low byte and port B in the high byte. Also sets
+    IOCON.MIRROR and IOCON.ODR so that either INT pin signals changes on any
+    pin, active low. Other pins are left alone. Written as one batch.
+    Returns 0 on success or -1 on failure.
+*/
+int8_t mcp23017InterruptInit( struct mcp23017 *mcp23017, uint16_t pins );
+
+//  ---------------------------------------------------------------------------
+//  Reads interrupt flags, captures and current levels, clearing interrupt.
+//  ---------------------------------------------------------------------------
+/*
+    One I2C transfer for BANK = 0 and SEQOP = 0, otherwise a read for each
+    register. Returns 0 on success or -1 on failure.
+*/
+int8_t mcp23017ReadCapture( struct mcp23017 *mcp23017,
+                            struct mcp23017Capture *capture );
+
 //  ---------------------------------------------------------------------------
 //  Initialises MCP23017 registers. Call for each MCP23017.
 //  ---------------------------------------------------------------------------
+/*
+    Returns the index of the new instance in mcp23017[] or -1 on failure.
+*/
 int8_t mcp23017Init( uint8_t addr );
 
 #endif
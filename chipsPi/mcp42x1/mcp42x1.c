@@ -31,6 +31,10 @@
     For a shared library, compile with:
 
         gcc -c -Wall -fpic mcp42x1.c -lpigpio
+
+    mcp42x1ChipInitBus also needs the bcm2835spi bus scheduler:
+
+        ../bcm2835/spi/bcm2835spi.c ../../boardPi/boardPi.c -lpthread
         gcc -shared -o libmcp42x1.so mcp42x1.o
 
     For Raspberry Pi v1 optimisation use the following flags:
@@ -67,6 +71,7 @@
 
 //  Companion header.
 #include "mcp42x1.h"
+#include "../bcm2835/spi/bcm2835spi.h"
 
 
 //  MCP42x1 functions. --------------------------------------------------------
@@ -107,7 +112,7 @@ int16_t mcp42x1ReadReg( uint8_t spi, uint8_t reg )
     spiXfer( spi, bytes, data, 2 );
 
     // Convert chars back into a 16-bit word.
-    ret = ( data[0] << 8 ) | data[1];
+    ret = (( uint8_t )data[0] << 8 ) | ( uint8_t )data[1];
     return ret;
 }
 
@@ -306,3 +311,237 @@ int8_t mcp42x1Init( uint8_t spi, uint8_t wiper )
 
     return handle;
 };
+
+
+//  Shadowed chip functions. --------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Adds a 16-bit write command to a transfer. Returns next free byte.
+//  ---------------------------------------------------------------------------
+static char *putWrite( char *bytes, uint8_t reg, uint16_t value )
+{
+    *bytes++ = (( reg << 4 ) & 0xf0 ) |               // Register address.
+               (( MCP42X1_CMD_WRITE << 2 ) & 0x0c ) | // Command.
+               (( value >> 8 ) & 0x03 );              // Data bits 8 - 9.
+    *bytes++ = value & 0xff;                          // Data bits 0 - 7.
+
+    return bytes;
+}
+
+//  ---------------------------------------------------------------------------
+//  Sends a transfer to a chip, via the bus scheduler if it has one.
+//  Returns MCP42X1_ERR_NOWRITE if not.
+//  ---------------------------------------------------------------------------
+static int8_t chipXfer( struct mcp42x1Chip *chip, char *tx, char *rx,
+                        uint8_t len )
+/*
+    Wiper writes are short and audible if late, so they go ahead of
+    low priority traffic such as display frames on the shared bus.
+*/
+{
+    if ( chip->bus != NULL )
+    {
+        if ( bcm2835_spi_bus_transfer( chip->bus, chip->device,
+                                       ( const uint8_t * )tx,
+                                       ( uint8_t * )rx, len,
+                                       BCM2835_SPI_BUS_HIGH ) < 0 )
+            return MCP42X1_ERR_NOWRITE;
+        return 0;
+    }
+
+    if ( rx != NULL )
+    {
+        if ( spiXfer( chip->spi, tx, rx, len ) != len )
+            return MCP42X1_ERR_NOWRITE;
+    }
+    else if ( spiWrite( chip->spi, tx, len ) != len )
+        return MCP42X1_ERR_NOWRITE;
+
+    return 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Reads registers into shadow copies. Returns MCP42X1_ERR_NOINIT if not.
+//  ---------------------------------------------------------------------------
+static int8_t chipInit( struct mcp42x1Chip *chip, uint16_t max )
+/*
+    Read data is 9 bits. The chip returns 1s for the top 6 bits of the
+    1st byte, then the command error bit, which is 1 if the command was
+    valid, so a bad read or MISO held low is caught here.
+*/
+{
+    static const uint8_t regs[] = { MCP42X1_REG_WIPER0, MCP42X1_REG_WIPER1,
+                                    MCP42X1_REG_TCON, MCP42X1_REG_STATUS };
+    uint16_t data[4];
+    char     bytes[2];
+    char     rx[2];
+    uint8_t  i;
+
+    if (( max == 0 ) || ( max > 0x100 )) return MCP42X1_ERR_NOINIT;
+
+    for ( i = 0; i < 4; i++ )
+    {
+        bytes[0] = (( regs[i] << 4 ) & 0xf0 ) |
+                   (( MCP42X1_CMD_READ << 2 ) & 0x0c );
+        bytes[1] = 0x00;
+        if ( chipXfer( chip, bytes, rx, 2 ) < 0 ) return MCP42X1_ERR_NOINIT;
+
+        data[i] = (( uint8_t )rx[0] << 8 ) | ( uint8_t )rx[1];
+        if (( data[i] & 0xfe00 ) != 0xfe00 ) return MCP42X1_ERR_NOINIT;
+        data[i] &= 0x01ff;
+    }
+
+    chip->max      = max;
+    chip->wiper[0] = data[0];
+    chip->wiper[1] = data[1];
+    chip->tcon     = data[2];
+    chip->status   = data[3];
+
+    return 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Reads registers into shadow copies. Returns MCP42X1_ERR_NOINIT if not.
+//  ---------------------------------------------------------------------------
+int8_t mcp42x1ChipInit( struct mcp42x1Chip *chip, uint8_t spi, uint16_t max )
+{
+    chip->spi    = spi;
+    chip->bus    = NULL;
+    chip->device = NULL;
+
+    return chipInit( chip, max );
+}
+
+//  ---------------------------------------------------------------------------
+//  As mcp42x1ChipInit, for a chip on a bcm2835spi bus scheduler.
+//  ---------------------------------------------------------------------------
+int8_t mcp42x1ChipInitBus( struct mcp42x1Chip *chip,
+                           struct bcm2835_spi_bus *bus,
+                           struct bcm2835_spi_device *device, uint16_t max )
+{
+    if (( bus == NULL ) || ( device == NULL )) return MCP42X1_ERR_NOINIT;
+
+    chip->spi    = 0;
+    chip->bus    = bus;
+    chip->device = device;
+
+    return chipInit( chip, max );
+}
+
+//  ---------------------------------------------------------------------------
+//  Sets one wiper if changed. Returns MCP42X1_ERR_NOWRITE if not.
+//  ---------------------------------------------------------------------------
+int8_t mcp42x1SetWiper( struct mcp42x1Chip *chip, uint8_t wiper,
+                        uint16_t value )
+{
+    char bytes[2];
+
+    if ( wiper >= MCP42X1_WIPERS ) return MCP42X1_ERR_NOWIPER;
+    if ( value > chip->max ) value = chip->max;
+    if ( chip->wiper[wiper] == value ) return 0;
+
+    putWrite( bytes, wiper == 0 ? MCP42X1_REG_WIPER0 : MCP42X1_REG_WIPER1,
+              value );
+    if ( chipXfer( chip, bytes, NULL, 2 ) < 0 ) return MCP42X1_ERR_NOWRITE;
+    chip->wiper[wiper] = value;
+
+    return 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Sets both wipers in one transfer, skipping any that haven't changed.
+//  Returns MCP42X1_ERR_NOWRITE if not.
+//  ---------------------------------------------------------------------------
+int8_t mcp42x1SetWipers( struct mcp42x1Chip *chip, uint16_t value0,
+                         uint16_t value1 )
+{
+    char  bytes[4];
+    char *next = bytes;
+
+    if ( value0 > chip->max ) value0 = chip->max;
+    if ( value1 > chip->max ) value1 = chip->max;
+
+    if ( chip->wiper[0] != value0 )
+        next = putWrite( next, MCP42X1_REG_WIPER0, value0 );
+    if ( chip->wiper[1] != value1 )
+        next = putWrite( next, MCP42X1_REG_WIPER1, value1 );
+    if ( next == bytes ) return 0;
+
+    // Both commands go out while CS is held low.
+    if ( chipXfer( chip, bytes, NULL, next - bytes ) < 0 )
+        return MCP42X1_ERR_NOWRITE;
+    chip->wiper[0] = value0;
+    chip->wiper[1] = value1;
+
+    return 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Increments or decrements wipers in one transfer. Returns
+//  MCP42X1_ERR_NOWRITE if not.
+//  ---------------------------------------------------------------------------
+int8_t mcp42x1StepWipers( struct mcp42x1Chip *chip, uint8_t wipers, bool up )
+{
+    static const uint8_t regs[] = { MCP42X1_REG_WIPER0, MCP42X1_REG_WIPER1 };
+    char    bytes[MCP42X1_WIPERS];
+    uint8_t count = 0;
+    uint8_t moved = 0;
+    uint8_t i;
+
+    for ( i = 0; i < MCP42X1_WIPERS; i++ )
+    {
+        if ( !( wipers & ( 1 << i ))) continue;
+
+        // The chip ignores steps past the ends, so don't send them.
+        if ( up ? ( chip->wiper[i] >= chip->max ) : ( chip->wiper[i] == 0 ))
+            continue;
+
+        bytes[count++] = (( regs[i] << 4 ) & 0xf0 ) |
+                         ((( up ? MCP42X1_CMD_INC : MCP42X1_CMD_DEC ) << 2 )
+                          & 0x0c );
+        moved |= 1 << i;
+    }
+    if ( count == 0 ) return 0;
+
+    if ( chipXfer( chip, bytes, NULL, count ) < 0 )
+        return MCP42X1_ERR_NOWRITE;
+    for ( i = 0; i < MCP42X1_WIPERS; i++ )
+        if ( moved & ( 1 << i )) chip->wiper[i] += up ? 1 : -1;
+
+    return 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Sets TCON register if changed. Returns MCP42X1_ERR_NOWRITE if not.
+//  ---------------------------------------------------------------------------
+int8_t mcp42x1SetTcon( struct mcp42x1Chip *chip, uint16_t tcon )
+{
+    char bytes[2];
+
+    tcon &= 0x01ff;
+    if ( chip->tcon == tcon ) return 0;
+
+    putWrite( bytes, MCP42X1_REG_TCON, tcon );
+    if ( chipXfer( chip, bytes, NULL, 2 ) < 0 ) return MCP42X1_ERR_NOWRITE;
+    chip->tcon = tcon;
+
+    return 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Sets the wipers of a gang of chips, one transfer per chip. Returns
+//  MCP42X1_ERR_NOWRITE if any failed.
+//  ---------------------------------------------------------------------------
+int8_t mcp42x1SetGang( struct mcp42x1Chip *chips, uint8_t count,
+                       const uint16_t *values )
+{
+    int8_t  result = 0;
+    uint8_t i;
+
+    for ( i = 0; i < count; i++ )
+        if ( mcp42x1SetWipers( &chips[i], values[ i * 2 ],
+                               values[ i * 2 + 1 ] ) < 0 )
+            result = MCP42X1_ERR_NOWRITE;
+
+    return result;
+}
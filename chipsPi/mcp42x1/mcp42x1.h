@@ -21,7 +21,7 @@
 */
 //  ===========================================================================
 
-#define MCP42X1_VERSION 01.01
+#define MCP42X1_VERSION 01.03
 
 //  ===========================================================================
 /*
@@ -33,6 +33,8 @@
 
         v01.00      Original version.
         v01.01      Rewrote init routine.
+        v01.02      Added shadowed registers, stereo and ganged writes.
+        v01.03      Added mcp42x1ChipInitBus for a shared bcm2835spi bus.
 */
 //  ===========================================================================
 
@@ -186,6 +188,7 @@ enum mcp42x1_error
     MCP42X1_ERR_NOWIPER = -2, // Wiper is invalid.
     MCP42X1_ERR_NOMEM   = -3, // Not enough memory.
     MCP42X1_ERR_DUPLIC  = -4, // Duplicate properties.
+    MCP42X1_ERR_NOWRITE = -5, // SPI write failed.
 };
 
 struct mcp42x1
@@ -196,6 +199,39 @@ struct mcp42x1
 
 struct mcp42x1 *mcp42x1[MCP42X1_DEVICES * MCP42X1_WIPERS];
 
+struct bcm2835_spi_bus;
+struct bcm2835_spi_device;
+
+//  Shadowed chip.
+struct mcp42x1Chip
+{
+    uint8_t  spi;                   // SPI handle.
+    struct bcm2835_spi_bus    *bus; // Bus scheduler, or NULL for pigpio.
+    struct bcm2835_spi_device *device; // Chip select and clock on bus.
+    uint16_t max;                   // Full scale wiper value, 0x80 or 0x100.
+    uint16_t wiper[MCP42X1_WIPERS]; // Wiper values.
+    uint16_t tcon;                  // TCON register.
+    uint16_t status;                // Status register, read at init.
+};
+/*
+    The registers are read once by mcp42x1ChipInit and after that are
+    only changed by the functions below, so the shadow copies always
+    match the chip and are used instead of reading it back. Writes that
+    wouldn't change a register aren't sent.
+
+    The MCP42x1 takes any number of commands while CS is held low, so
+    both wipers are written in one SPI transfer. They then change within
+    a byte time of each other rather than a whole transfer apart.
+
+    SDO only returns read data, so MCP42x1s can't be daisy chained on one
+    CS. Ganged attenuators use one CS each and are written one after the
+    other with mcp42x1SetGang, one transfer per chip.
+
+    A chip set up with mcp42x1ChipInitBus sends everything through a
+    bcm2835spi bus scheduler at high priority, so wiper changes go out
+    between chunks of a display frame on the same bus rather than after it.
+*/
+
 
 //  MCP42x1 functions. --------------------------------------------------------
 
@@ -229,4 +265,66 @@ void mcp42x1DecResistance( uint8_t spi, uint8_t wiper );
 //  ---------------------------------------------------------------------------
 int8_t mcp42x1Init( uint8_t spi, uint8_t wiper );
 
+//  Shadowed chip functions. --------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Reads registers into shadow copies. Returns MCP42X1_ERR_NOINIT if not.
+//  ---------------------------------------------------------------------------
+/*
+    max is the full scale wiper value, 0x80 for 7-bit or 0x100 for 8-bit
+    parts.
+*/
+int8_t mcp42x1ChipInit( struct mcp42x1Chip *chip, uint8_t spi, uint16_t max );
+
+//  ---------------------------------------------------------------------------
+//  As mcp42x1ChipInit, for a chip on a bcm2835spi bus scheduler.
+//  ---------------------------------------------------------------------------
+/*
+    bus must already be started with bcm2835_spi_bus_init, and bus and
+    device must outlive the chip.
+*/
+int8_t mcp42x1ChipInitBus( struct mcp42x1Chip *chip,
+                           struct bcm2835_spi_bus *bus,
+                           struct bcm2835_spi_device *device, uint16_t max );
+
+//  ---------------------------------------------------------------------------
+//  Sets one wiper if changed. Returns MCP42X1_ERR_NOWRITE if not.
+//  ---------------------------------------------------------------------------
+int8_t mcp42x1SetWiper( struct mcp42x1Chip *chip, uint8_t wiper,
+                       uint16_t value );
+
+//  ---------------------------------------------------------------------------
+//  Sets both wipers in one transfer, skipping any that haven't changed.
+//  Returns MCP42X1_ERR_NOWRITE if not.
+//  ---------------------------------------------------------------------------
+int8_t mcp42x1SetWipers( struct mcp42x1Chip *chip, uint16_t value0,
+                         uint16_t value1 );
+
+//  ---------------------------------------------------------------------------
+//  Increments or decrements wipers in one transfer. Returns
+//  MCP42X1_ERR_NOWRITE if not.
+//  ---------------------------------------------------------------------------
+/*
+    wipers is a mask, bit 0 for wiper 0 and bit 1 for wiper 1. Sends one
+    8-bit command for each wiper that isn't already at its limit. The
+    shadow wipers are only moved if the write succeeds.
+*/
+int8_t mcp42x1StepWipers( struct mcp42x1Chip *chip, uint8_t wipers, bool up );
+
+//  ---------------------------------------------------------------------------
+//  Sets TCON register if changed. Returns MCP42X1_ERR_NOWRITE if not.
+//  ---------------------------------------------------------------------------
+int8_t mcp42x1SetTcon( struct mcp42x1Chip *chip, uint16_t tcon );
+
+//  ---------------------------------------------------------------------------
+//  Sets the wipers of a gang of chips, one transfer per chip. Returns
+//  MCP42X1_ERR_NOWRITE if any failed.
+//  ---------------------------------------------------------------------------
+/*
+    values holds wiper 0 then wiper 1 for each chip in turn. Every chip is
+    tried even if an earlier one fails.
+*/
+int8_t mcp42x1SetGang( struct mcp42x1Chip *chips, uint8_t count,
+                       const uint16_t *values );
+
 #endif // #ifndef MCP42X1_H
@@ -30,7 +30,8 @@
 
     Compile with:
 
-    gcc testmcp42x1.c mcp42x1.c -Wall -o testmcp42x1 -lpigpio lpthread
+    gcc testmcp42x1.c mcp42x1.c ../bcm2835/spi/bcm2835spi.c
+        ../../boardPi/boardPi.c -Wall -o testmcp42x1 -lpigpio -lpthread
 
     Also use the following flags for Raspberry Pi optimisation:
         -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
@@ -28,11 +28,11 @@
 */
 // ****************************************************************************
 
-#define piLCDVersion "Version 0.6"
+#define piLCDVersion "Version 0.7"
 
 //  Compilation:
 //
-//  Compile with gcc piLCD.c -o piLCD -lwiringPi lpthread
+//  Compile with gcc piLCD.c ../gpioPi/gpioPi.c -o piLCD -lwiringPi lpthread
 //  Also use the following flags for Raspberry Pi optimisation:
 //         -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
 //         -ffast-math -pipe -O3
@@ -49,6 +49,7 @@
 //  v0.4 Rewrote init and set mode functions.
 //  v0.5 Finally sorted out initialisation!
 //  v0.6 Aded ticker tape text function.
+//  v0.7 Write nibbles through the gpioPi bus library.
 //
 
 //  To Do:
@@ -59,7 +60,7 @@
 //      Add read function to check ready (replace delays?).
 //          - most hobbyists may ground the ready pin.
 //      Improve error trapping and return codes for all functions.
-//      Write GPIO and interrupt routines to replace wiringPi.
+//      Write interrupt routines to replace wiringPi.
 //
 
 #include <stdio.h>
@@ -71,6 +72,9 @@
 #include <stdlib.h>
 #include <time.h>
 #include <pthread.h>
+#include <stdint.h>
+
+#include "../gpioPi/gpioPi.h"
 
 //  Information. --------------------------------------------------------------
 /*
@@ -181,6 +185,10 @@
 #define GPIO_UNSET         0 // Set GPIO to low.
 #define GPIO_SET           1 // Set GPIO to high.
 
+// Bus timing (nS). Hold covers the 37uS execution time of most commands.
+#define DELAY_ENABLE     500 // Data set up and E pulse width.
+#define DELAY_EXECUTE  41000 // Wait after E falls.
+
 
 //  Types. --------------------------------------------------------------------
 
@@ -218,6 +226,15 @@ struct gpioStruct
     .db[3] = 18   // Pin 22 (DB7).
 };
 
+// Data pins and E, set up by initialiseGPIOs.
+struct gpioBus bus =
+{
+    .width = PINS_DATA,
+    .setup = DELAY_ENABLE,
+    .pulse = DELAY_ENABLE,
+    .hold  = DELAY_EXECUTE
+};
+
 //  Data structures for displaying text.
 /*
     .align  = TEXT_ALIGN_NULL   : No set alignment (just print at cursor ).
@@ -288,23 +305,8 @@ static const char *getBinaryString(unsigned char nibble)
 // ----------------------------------------------------------------------------
 static char writeNibble( unsigned char data )
 {
-    unsigned char i;
-    unsigned char nibble;
-
-    // Write nibble to GPIOs
-    nibble = data;
-    for ( i = 0; i < BITS_NIBBLE; i++ )
-    {
-        digitalWrite( gpio.db[i], ( nibble & 1 ));
-        delayMicroseconds( 41 );
-        nibble >>= 1;
-    }
-
-    // Toggle enable bit to send nibble.
-    digitalWrite( gpio.en, GPIO_SET );
-    delayMicroseconds( 41 );
-    digitalWrite( gpio.en, GPIO_UNSET );
-    delayMicroseconds( 41 ); // Commands should take 5mS!
+    // Write nibble to GPIOs and toggle enable bit to send it.
+    gpioBusWrite( &bus, data, 0, 0 );
 
     return 0;
 };
@@ -316,13 +318,9 @@ static char writeCommand( unsigned char data )
 {
     unsigned char nibble;
 
-    // Set to command mode.
-    digitalWrite( gpio.rs, GPIO_UNSET );
-    delayMicroseconds( 41 );
-
-    // High nibble.
+    // High nibble, in command mode.
     nibble = ( data >> BITS_NIBBLE ) & 0x0f;
-    writeNibble( nibble );
+    gpioBusWrite( &bus, nibble, 0, 1 << gpio.rs );
 
     // Low nibble.
     nibble = data & 0x0f;
@@ -338,13 +336,9 @@ static char writeData( unsigned char data )
 {
     unsigned char nibble;
 
-    // Set to character mode.
-    digitalWrite( gpio.rs, GPIO_SET );
-    delayMicroseconds( 41 );
-
-    // High nibble.
+    // High nibble, in character mode.
     nibble = ( data >> BITS_NIBBLE ) & 0xf;
-    writeNibble( nibble );
+    gpioBusWrite( &bus, nibble, 1 << gpio.rs, 0 );
 
     // Low nibble.
     nibble = data & 0xf;
@@ -863,21 +857,16 @@ void *displayTime( void *threadTime )
 static char initialiseGPIOs( void )
 {
     unsigned char i;
-    wiringPiSetupGpio();
 
-    // Set all GPIO pins to 0.
-    digitalWrite( gpio.rs, GPIO_UNSET );
-    digitalWrite( gpio.en, GPIO_UNSET );
-    // Data pins.
+    // Map GPIOs and set the data pins and E low as outputs.
+    if ( gpioMap() < 0 ) return -1;
     for ( i = 0; i < PINS_DATA; i++ )
-        digitalWrite( gpio.db[i], GPIO_UNSET );
+        bus.db[i] = gpio.db[i];
+    bus.strobe = gpio.en;
+    if ( gpioBusInit( &bus ) < 0 ) return -1;
 
-    // Set LCD pin modes.
-    pinMode( gpio.rs, OUTPUT ); // Enumerated type defined in wiringPi.
-    pinMode( gpio.en, OUTPUT ); // Enumerated type defined in wiringPi.
-    // Data pins.
-    for ( i = 0; i < PINS_DATA; i++ )
-        pinMode( gpio.db[i], OUTPUT );
+    gpioPinsWrite( 0, 1 << gpio.rs );
+    gpioFsel( gpio.rs, GPIO_OUTPUT );
 
     delay( 35 );
     return 0;
@@ -956,8 +945,12 @@ int main( int argc, char *argv[] )
     //  Get command line arguments and check within bounds.
     argp_parse( &argp, argc, argv, 0, 0, &gpio );
 
-    //  Initialise wiringPi and LCD.
-    initialiseGPIOs();  // Must be called before initialiseDisplay.
+    //  Initialise GPIOs and LCD.
+    if ( initialiseGPIOs() < 0 ) // Must be called before initialiseDisplay.
+    {
+        printf( "Couldn't map GPIOs.\n" );
+        return -1;
+    }
 
     unsigned char data      = 0; // 4-bit mode.
     unsigned char lines     = 1; // 2 display lines.
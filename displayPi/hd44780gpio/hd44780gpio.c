@@ -29,7 +29,8 @@
 
     Compile with:
 
-        gcc -c -fpic -Wall hd44780gpio.c -lwiringPi -lpthread
+        gcc -c -fpic -Wall hd44780gpio.c ../../gpioPi/gpioPi.c \
+            ../../boardPi/boardPi.c -lwiringPi -lpthread
 
     Also use the following flags for Raspberry Pi optimisation:
 
@@ -47,16 +48,17 @@
         v0.1    Original version.
         v0.2    Rewrote code into libraries.
         v0.3    Updated some functions in line with I2C library.
+        v0.4    Added CGRAM glyph cache for animated custom characters.
+        v0.5    Write pins with single GPSET0/GPCLR0 writes, poll busy flag.
+        v0.6    Moved GPIO register access to the gpioPi bus library.
 
 //  ---------------------------------------------------------------------------
 
     To Do:
         Add routine to check validity of GPIOs.
         Add support for multiple displays.
-        Add read function to check ready (replace delays?).
-            - most hobbyists may ground the ready pin.
         Improve error trapping and return codes for all functions.
-        Write GPIO and interrupt routines to replace wiringPi.
+        Write interrupt routines to replace wiringPi.
 
 //  ---------------------------------------------------------------------------
 */
@@ -71,6 +73,7 @@
 #include <pthread.h>
 #include <unistd.h>
 
+#include "../../gpioPi/gpioPi.h"
 #include "hd44780gpioPi.h"
 
 
@@ -87,91 +90,130 @@
         .db[0] = 25,   // GPIO 12 (DB4).
         .db[1] = 24,   // GPIO 16 (DB5).
         .db[2] = 23,   // GPIO 18 (DB6).
-        .db[3] = 18    // GPIO 22 (DB7).
+        .db[3] = 18,   // GPIO 22 (DB7).
+        .busyFlag = false // R/W grounded.
     };
 
+    // Data pins and E, set up by hd44780Init.
+    static struct gpioBus bus =
+    {
+        .width  = PINS_DATA,
+        .setup  = DELAY_ENABLE,
+        .pulse  = DELAY_ENABLE,
+        .hold   = DELAY_ENABLE
+    };
 
 
 //  ---------------------------------------------------------------------------
 //  Writes data nibble to display.
 //  ---------------------------------------------------------------------------
+/*
+    The data pins are written together and E is raised once they have
+    settled. The HD44780 latches the data as E falls.
+*/
 int8_t writeNibble( uint8_t data )
 {
-    uint8_t i;
-    uint8_t nibble;
-
-    // Write nibble to GPIOs
-    nibble = data;
-    for ( i = 0; i < BITS_NIBBLE; i++ )
-    {
-        digitalWrite( hd44780gpio.db[i], ( nibble & 1 ));
-        delayMicroseconds( 41 );
-        nibble >>= 1;
-    }
-
-    // Toggle enable bit to send nibble.
-    digitalWrite( hd44780gpio.en, GPIO_SET );
-    delayMicroseconds( 41 );
-    digitalWrite( hd44780gpio.en, GPIO_UNSET );
-    delayMicroseconds( 41 ); // Commands should take 5mS!
-
-    /*
-        Need to add routine to read ready bit.
-    */
+    gpioBusWrite( &bus, data, 0, 0 );
 
     return 0;
 };
 
 //  ---------------------------------------------------------------------------
-//  Writes command byte to display.
+//  Returns the execution time of a command or data byte in uS.
 //  ---------------------------------------------------------------------------
-int8_t writeCommand( uint8_t data )
+static uint16_t commandDelay( uint8_t data, bool mode )
 {
-    uint8_t nibble;
+    if (( mode == MODE_COMMAND ) &&
+        (( data == DISPLAY_CLEAR ) || (( data & ~0x01 ) == DISPLAY_HOME )))
+        return DELAY_HOME;
+    return DELAY_COMMAND;
+};
 
-    // Set to command mode.
-    digitalWrite( hd44780gpio.rs, GPIO_UNSET );
-    delayMicroseconds( 41 );
+//  ---------------------------------------------------------------------------
+//  Polls the busy flag until clear. Returns false if it didn't clear.
+//  ---------------------------------------------------------------------------
+/*
+    The data pins are made inputs before R/W is set so that the Pi and the
+    HD44780 never drive them at the same time. The busy flag is DB7 and is
+    read while E is high. In 4-bit mode E must be toggled again for the low
+    nibble, which is ignored. The execution time from the data sheet is used
+    as a time out.
+*/
+static bool readBusy( uint16_t delay )
+{
+    struct timespec start, now;
+    uint32_t busy = 1 << hd44780gpio.db[PINS_DATA - 1];
+    uint32_t level;
+    uint8_t  i;
 
-    // High nibble.
-    nibble = ( data >> BITS_NIBBLE ) & 0x0f;
-    writeNibble( nibble );
+    for ( i = 0; i < PINS_DATA; i++ )
+        gpioFsel( hd44780gpio.db[i], GPIO_INPUT );
+    gpioPinsWrite( 1 << hd44780gpio.rw, 1 << hd44780gpio.rs );
 
-    // Low nibble.
-    nibble = data & 0x0f;
-    writeNibble( nibble );
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    do
+    {
+        gpioPinsWrite( 1 << hd44780gpio.en, 0 );
+        gpioDelayNs( DELAY_ENABLE );
+        level = gpioPinsRead();
+        gpioPinsWrite( 0, 1 << hd44780gpio.en );
+        gpioDelayNs( DELAY_ENABLE );
+        if ( PINS_DATA == BITS_NIBBLE ) gpioBusStrobe( &bus );
+        clock_gettime( CLOCK_MONOTONIC, &now );
+    }
+    while (( level & busy ) &&
+           (( now.tv_sec - start.tv_sec ) * 1000000L +
+            ( now.tv_nsec - start.tv_nsec ) / 1000 < delay ));
 
-    /*
-        Need to add routine to read ready bit.
-    */
+    gpioPinsWrite( 0, 1 << hd44780gpio.rw );
+    for ( i = 0; i < PINS_DATA; i++ )
+        gpioFsel( hd44780gpio.db[i], GPIO_OUTPUT );
 
-    return 0;
+    return !( level & busy );
 };
 
 //  ---------------------------------------------------------------------------
-//  Writes data byte to display.
+//  Writes a command or data byte (according to mode).
 //  ---------------------------------------------------------------------------
-int8_t writeData( uint8_t data )
+/*
+    The HD44780 is either polled until it is ready or given the execution
+    time from the data sheet. RS is set in the same writes as the first
+    nibble.
+*/
+static int8_t writeByte( uint8_t data, bool mode )
 {
-    uint8_t nibble;
+    uint16_t delay = commandDelay( data, mode );
+    uint32_t rs    = 1 << hd44780gpio.rs;
 
-    // Set to character mode.
-    digitalWrite( hd44780gpio.rs, GPIO_SET );
-    delayMicroseconds( 41 );
+    // High nibble first in 4-bit mode.
+    if ( PINS_DATA == BITS_NIBBLE )
+    {
+        gpioBusWrite( &bus, data >> BITS_NIBBLE, mode ? rs : 0, mode ? 0 : rs );
+        gpioBusWrite( &bus, data, 0, 0 );
+    }
+    else
+        gpioBusWrite( &bus, data, mode ? rs : 0, mode ? 0 : rs );
 
-    // High nibble.
-    nibble = ( data >> BITS_NIBBLE ) & 0xf;
-    writeNibble( nibble );
+    if (( hd44780gpio.busyFlag ) && ( readBusy( delay ))) return 0;
+    delayMicroseconds( delay );
 
-    // Low nibble.
-    nibble = data & 0xf;
-    writeNibble( nibble );
+    return 0;
+};
 
-    /*
-        Need to add routine to read ready bit.
-    */
+//  ---------------------------------------------------------------------------
+//  Writes command byte to display.
+//  ---------------------------------------------------------------------------
+int8_t writeCommand( uint8_t data )
+{
+    return writeByte( data, MODE_COMMAND );
+};
 
-    return 0;
+//  ---------------------------------------------------------------------------
+//  Writes data byte to display.
+//  ---------------------------------------------------------------------------
+int8_t writeData( uint8_t data )
+{
+    return writeByte( data, MODE_DATA );
 };
 
 //  ---------------------------------------------------------------------------
@@ -215,7 +257,6 @@ int8_t gotoRowPos( uint8_t row, uint8_t pos )
 int8_t displayClear( void )
 {
     writeCommand( DISPLAY_CLEAR );
-    delayMicroseconds( 1600 ); // Data sheet doesn't give execution time!
 
     return 0;
 };
@@ -226,7 +267,6 @@ int8_t displayClear( void )
 int8_t displayHome( void )
 {
     writeCommand( DISPLAY_HOME );
-    delayMicroseconds( 1600 ); // Needs 1.52ms to execute.
 
     return 0;
 };
@@ -240,41 +280,44 @@ int8_t hd44780Init( bool data,   bool lines, bool font,    bool display,
 {
     uint8_t i;
 
-    // Set up GPIOs with wiringPi.
-    wiringPiSetupGpio();
-
-    // Set all GPIO pins to 0.
-    digitalWrite( hd44780gpio.rs, GPIO_UNSET );
-    digitalWrite( hd44780gpio.en, GPIO_UNSET );
-
-    // Data pins.
+    // Map GPIO registers and set up the data bus. The bus sets the data
+    // pins and E low and makes them outputs.
+    if ( gpioMap() < 0 ) return -1;
     for ( i = 0; i < PINS_DATA; i++ )
-        digitalWrite( hd44780gpio.db[i], GPIO_UNSET );
+        bus.db[i] = hd44780gpio.db[i];
+    bus.strobe = hd44780gpio.en;
+    if ( gpioBusInit( &bus ) < 0 ) return -1;
 
-    // Set LCD pin modes.
-    pinMode( hd44780gpio.rs, OUTPUT );
-    pinMode( hd44780gpio.en, OUTPUT );
-    // Data pins.
-    for ( i = 0; i < PINS_DATA; i++ )
-        pinMode( hd44780gpio.db[i], OUTPUT );
+    gpioPinsWrite( 0, 1 << hd44780gpio.rs );
+    gpioFsel( hd44780gpio.rs, GPIO_OUTPUT );
+    if ( hd44780gpio.busyFlag )
+    {
+        gpioPinsWrite( 0, 1 << hd44780gpio.rw );
+        gpioFsel( hd44780gpio.rw, GPIO_OUTPUT );
+    }
 
     // Allow a start-up delay for display initialisation.
     delay( 50 ); // >40mS@3V.
 
-    // Need to write low nibbles only as display starts off in 8-bit mode.
-    // Sending high nibble first (0x0) causes init to fail and the display
-    // subsequently shows garbage.
-    writeNibble( 0x3 );
+    // Display starts off in 8-bit mode. In 4-bit mode, need to write low
+    // nibbles only. Sending high nibble first (0x0) causes init to fail and
+    // the display subsequently shows garbage.
+    uint8_t wake = ( PINS_DATA == BITS_BYTE ) ? 0x30 : 0x3;
+    writeNibble( wake );
     delay( 5 );                 // >4.1mS.
-    writeNibble( 0x3 );
+    writeNibble( wake );
     delayMicroseconds( 150 );   // >100uS.
-    writeNibble( 0x3 );
+    writeNibble( wake );
     delayMicroseconds( 150 );   // >100uS.
-    writeNibble( 0x2);
-    delayMicroseconds( 150 );
+    if ( PINS_DATA == BITS_NIBBLE )
+    {
+        writeNibble( 0x2 );
+        delayMicroseconds( 150 );
+    }
 
     // Set actual function mode - cannot be changed after this point
-    // without reinitialising.
+    // without reinitialising. Interface mode follows the data pins.
+    data = ( PINS_DATA == BITS_BYTE );
     writeCommand( FUNCTION_BASE | ( data * FUNCTION_DATA )
                                 | ( lines * FUNCTION_LINES )
                                 | ( font * FUNCTION_FONT ));
@@ -408,6 +451,76 @@ int8_t loadCustomChar( const uint8_t newChar[CUSTOM_MAX][CUSTOM_SIZE] )
     return 0;
 };
 
+//  ---------------------------------------------------------------------------
+//  Initialises a glyph cache with CGRAM contents unknown.
+//  ---------------------------------------------------------------------------
+void glyphInit( struct glyphCache *glyphs )
+{
+    memset( glyphs, 0, sizeof( struct glyphCache ));
+
+    // Slots never used have frame 0 so are replaced first.
+    glyphs->frame = 1;
+};
+
+//  ---------------------------------------------------------------------------
+//  Starts a new frame for a glyph cache.
+//  ---------------------------------------------------------------------------
+void glyphFrame( struct glyphCache *glyphs )
+{
+    glyphs->frame++;
+};
+
+//  ---------------------------------------------------------------------------
+//  Returns the CGRAM slot for a glyph, uploading it if necessary.
+//  ---------------------------------------------------------------------------
+int8_t loadGlyph( struct glyphCache *glyphs,
+                  const uint8_t glyph[CUSTOM_SIZE] )
+{
+    int8_t  slot = -1;
+    uint8_t i, row;
+    bool    known, moved;
+
+    for ( i = 0; i < CUSTOM_MAX; i++ )
+    {
+        // Glyph is already in CGRAM.
+        if (( glyphs->known & ( 1 << i )) &&
+            ( memcmp( glyphs->data[i], glyph, CUSTOM_SIZE ) == 0 ))
+        {
+            glyphs->used[i] = glyphs->frame;
+            return i;
+        }
+
+        // Least recently used slot that isn't in this frame.
+        if (( glyphs->used[i] != glyphs->frame ) &&
+            (( slot < 0 ) || ( glyphs->used[i] < glyphs->used[slot] )))
+            slot = i;
+    }
+    if ( slot < 0 ) return -1;
+
+    // Send rows that differ, or all rows if the slot isn't known. The
+    // address only needs setting at the start of each run of rows.
+    known = glyphs->known & ( 1 << slot );
+    moved = true;
+    for ( row = 0; row < CUSTOM_SIZE; row++ )
+    {
+        if ( known && ( glyphs->data[slot][row] == glyph[row] ))
+        {
+            moved = true;
+            continue;
+        }
+        if ( moved )
+            writeCommand( ADDRESS_CGRAM | ( slot * CUSTOM_SIZE + row ));
+        writeData( glyph[row] );
+        moved = false;
+    }
+
+    memcpy( glyphs->data[slot], glyph, CUSTOM_SIZE );
+    glyphs->known |= 1 << slot;
+    glyphs->used[slot] = glyphs->frame;
+
+    return slot;
+};
+
 
 //  Display functions. --------------------------------------------------------
 
@@ -81,7 +81,7 @@
 // Constants. Change these according to needs.
 #define BITS_BYTE          8 // Number of bits in a byte.
 #define BITS_NIBBLE        4 // Number of bits in a nibble.
-#define PINS_DATA          4 // Number of data pins used.
+#define PINS_DATA          4 // Number of data pins used (4 or 8).
 #define MAX_DISPLAYS       1 // Number of displays.
 #define TEXT_MAX_LENGTH  512 // Arbitrary length limit for text string.
 
@@ -137,6 +137,11 @@
 #define GPIO_UNSET         0 // Set GPIO to low.
 #define GPIO_SET           1 // Set GPIO to high.
 
+// Execution times. Data sheet values are for 270kHz so allow for slower.
+#define DELAY_ENABLE       500 // E pulse width and cycle half (nS).
+#define DELAY_COMMAND       50 // Most commands and data writes, 37uS (uS).
+#define DELAY_HOME        1600 // Clear and home, 1.52mS (uS).
+
 //  Mutex. --------------------------------------------------------------------
 
 pthread_mutex_t displayBusy; // Locks further writes to display until finished.
@@ -149,9 +154,19 @@ struct HD44780gpio
     uint8_t rows;          // Number of display rows (y).
     uint8_t rs;            // GPIO number for LCD RS pin.
     uint8_t en;            // GPIO number for LCD E pin.
-    uint8_t rw;            // GPIO number for R/W mode. Not used.
+    uint8_t rw;            // GPIO number for R/W mode.
     uint8_t db[PINS_DATA]; // GPIO numbers for LCD data pins.
+    bool    busyFlag;      // Busy flag can be read.
 };
+/*
+    db holds DB4-DB7 in 4-bit mode or DB0-DB7 in 8-bit mode, according to
+    PINS_DATA. All pins must be GPIOs 0-31 so that the data lines, RS and E
+    can be written with single GPSET0 and GPCLR0 writes.
+
+    busyFlag must only be set if R/W is wired to a GPIO and the display is
+    run at 3.3V, or DB7 is level shifted, since the HD44780 drives DB7 when
+    it is read. If R/W is grounded, delays from the data sheet are used.
+*/
 
 struct textStruct
 {
@@ -206,8 +221,11 @@ struct tickerStruct
 //  Hardware functions. -------------------------------------------------------
 
 //  ---------------------------------------------------------------------------
-//  Writes byte value of a char to display in nibbles.
+//  Writes data to the data pins and toggles E to latch it.
 //  ---------------------------------------------------------------------------
+/*
+    Writes the low 4 bits in 4-bit mode or all 8 bits in 8-bit mode.
+*/
 int8_t writeNibble( uint8_t data );
 
 //  ---------------------------------------------------------------------------
@@ -252,7 +270,7 @@ int8_t displayHome( void );
 //  Initialises display. Must be called before any other display functions.
 //  ---------------------------------------------------------------------------
 /*
-    Currently only supports 4-bit mode initialisation.
+    The interface mode is set by PINS_DATA, data is ignored.
     Software initialisation is achieved by setting 8-bit mode and writing a
     sequence of EN toggles with fixed delays between each command.
         Initial delay after Vcc rises to 2.7V
@@ -273,8 +291,8 @@ int8_t hd44780Init( bool data,   bool lines, bool font,    bool display,
                     bool cursor, bool blink, bool counter, bool shift,
                     bool mode,   bool direction );
 /*
-    data      = 0: 4-bit mode.
-    data      = 1: 8-bit mode.
+    data      = 0: 4-bit mode. Ignored, set by PINS_DATA.
+    data      = 1: 8-bit mode. Ignored, set by PINS_DATA.
     lines     = 0: 1 display line.
     lines     = 1: 2 display lines.
     font      = 0: 5x10 font (uses 2 lines).
@@ -360,6 +378,53 @@ struct customCharsStruct
 */
 int8_t loadCustom( const uint8_t newChar[CUSTOM_MAX][CUSTOM_SIZE] );
 
+//  ---------------------------------------------------------------------------
+//  CGRAM glyph cache.
+//  ---------------------------------------------------------------------------
+/*
+    Treats the 8 CGRAM slots as a cache keyed by glyph bitmap, so that
+    animations can use more than 8 glyphs without reloading the whole
+    character set. Each frame, request each glyph to be drawn with loadGlyph
+    and use the returned slot index as the display character. A glyph
+    already in CGRAM costs nothing. Otherwise the least recently used slot
+    is replaced and only the rows that differ from its old glyph are sent.
+
+    Slots requested since the last glyphFrame are not replaced, since they
+    may already be on the display, so up to 8 different glyphs can be used
+    per frame. Characters still on the display from older frames change
+    when their slot is replaced, so redraw the whole frame each time.
+*/
+struct glyphCache
+{
+    uint8_t  data[CUSTOM_MAX][CUSTOM_SIZE]; // Copy of CGRAM.
+    uint32_t used[CUSTOM_MAX];              // Frame each slot was last used.
+    uint32_t frame;                         // Current frame.
+    uint8_t  known;                         // Slots in data that are valid.
+};
+
+//  ---------------------------------------------------------------------------
+//  Initialises a glyph cache with CGRAM contents unknown.
+//  ---------------------------------------------------------------------------
+/*
+    Also call this after loadCustom or hd44780Init.
+*/
+void glyphInit( struct glyphCache *glyphs );
+
+//  ---------------------------------------------------------------------------
+//  Starts a new frame for a glyph cache.
+//  ---------------------------------------------------------------------------
+void glyphFrame( struct glyphCache *glyphs );
+
+//  ---------------------------------------------------------------------------
+//  Returns the CGRAM slot for a glyph, uploading it if necessary.
+//  ---------------------------------------------------------------------------
+/*
+    Returns -1 if all slots are in use for this frame. The address counter
+    is left in CGRAM so use gotoRowPos before writing to the display.
+*/
+int8_t loadGlyph( struct glyphCache *glyphs,
+                  const uint8_t glyph[CUSTOM_SIZE] );
+
 
 //  Display functions. --------------------------------------------------------
 
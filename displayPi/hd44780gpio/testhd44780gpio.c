@@ -30,8 +30,8 @@
 
     Compile with:
 
-    gcc testHD44780gpio.c hd44780.c -Wall -o testhd44780gpio
-                     -lwiringPi -lpthread
+    gcc testHD44780gpio.c hd44780.c ../../gpioPi/gpioPi.c
+                     ../../boardPi/boardPi.c -Wall -o testhd44780gpio -lwiringPi -lpthread
 
     Also use the following flags for Raspberry Pi optimisation:
         -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
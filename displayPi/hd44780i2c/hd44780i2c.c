@@ -49,14 +49,18 @@
 
         v0.1    Original version.
         v0.2    Rewrote to use 8-bit interface.
+        v0.3    Added shadow DDRAM so that only changed characters are sent.
+        v0.4    Replaced fixed delays with busy flag or command timings.
+        v0.5    Send bytes as batched MCP23017 writes.
+        v0.6    Added compositor thread to own the display.
+        v0.7    Ticker uses display shift or a moving window onto the text.
+        v0.8    Added CGRAM glyph cache for animated custom characters.
+        v0.9    Deferred execution waits and a wall of interleaved displays.
 
 //  ---------------------------------------------------------------------------
 
     To Do:
         Add routine to check validity of GPIOs.
-        Add support for multiple displays.
-        Add read function to check ready (replace delays?).
-            - most hobbyists may ground the ready pin.
         Improve error trapping and return codes for all functions.
         Write GPIO and interrupt routines to replace wiringPi.
 
@@ -84,16 +88,243 @@
 
 //  HD44780 display functions. ------------------------------------------------
 
+// DDRAM start address for each row.
+static const uint8_t rowAddress[DISPLAY_ROWS_MAX] = { ADDRESS_ROW_0,
+                                                      ADDRESS_ROW_1,
+                                                      ADDRESS_ROW_2,
+                                                      ADDRESS_ROW_3 };
+
+//  ---------------------------------------------------------------------------
+//  Finds the display cell for a DDRAM address. Returns false if not visible.
+//  ---------------------------------------------------------------------------
+static bool hd44780Cell( uint8_t address, uint8_t *row, uint8_t *pos )
+{
+    uint8_t i;
+
+    for ( i = 0; i < DISPLAY_ROWS; i++ )
+    {
+        if (( address >= rowAddress[i] ) &&
+            ( address <  rowAddress[i] + DISPLAY_COLUMNS ))
+        {
+            *row = i;
+            *pos = address - rowAddress[i];
+            return true;
+        }
+    }
+    return false;
+};
+
+//  ---------------------------------------------------------------------------
+//  Tracks the effect of a command or data byte on the shadow DDRAM.
+//  ---------------------------------------------------------------------------
+/*
+    Assumes that the address counter is incremented after each write, which
+    is the entry mode used by all of the display functions. In 2 line mode
+    the DDRAM address jumps from the end of the first line to the start of
+    the second and then wraps back to the start.
+
+    sent is false if the write failed, in which case data only goes into
+    the next frame and the shadow is left as it was.
+*/
+static void hd44780Track( struct hd44780 *hd44780, uint8_t data, bool mode,
+                          bool sent )
+{
+    uint8_t row, pos;
+
+    if ( mode == MODE_DATA )
+    {
+        if ( hd44780->address == ADDRESS_UNKNOWN ) return;
+        if ( hd44780Cell( hd44780->address, &row, &pos ))
+        {
+            if ( sent ) hd44780->ddram[row][pos] = data;
+            hd44780->frame[row][pos] = data;
+        }
+        hd44780->address++;
+        if ( hd44780->address == 0x28 ) hd44780->address = 0x40;
+        else if ( hd44780->address >= 0x68 ) hd44780->address = 0x00;
+        return;
+    }
+
+    // Commands are identified by their highest set bit.
+    if ( data >= ADDRESS_DDRAM )
+        hd44780->address = data & ~ADDRESS_DDRAM;
+    else if ( data >= ADDRESS_CGRAM )
+        hd44780->address = ADDRESS_UNKNOWN;
+    else if ( data >= FUNCTION_BASE )
+        return;
+    else if ( data >= MOVE_BASE )
+    {
+        if ( data & MOVE_DISPLAY ) hd44780->shifted = true;
+        hd44780->address = ADDRESS_UNKNOWN;
+    }
+    else if ( data >= ENTRY_BASE )
+        return;
+    else if ( data >= DISPLAY_HOME )
+    {
+        if ( sent ) hd44780->shifted = false;
+        hd44780->address = 0x00;
+    }
+    else if ( data == DISPLAY_CLEAR )
+    {
+        if ( sent ) memset( hd44780->ddram, ' ', sizeof( hd44780->ddram ));
+        memset( hd44780->frame, ' ', sizeof( hd44780->frame ));
+        if ( sent ) hd44780->shifted = false;
+        hd44780->address = 0x00;
+    }
+};
+
 //  ---------------------------------------------------------------------------
 //  Toggles EN (enable) bit in byte mode without changing other bits.
 //  ---------------------------------------------------------------------------
+/*
+    E must be high for at least 230nS. Each I2C write takes far longer than
+    this so no delay is needed.
+*/
 void hd44780ToggleEnable( struct mcp23017 *mcp23017, struct hd44780 *hd44780 )
 {
     mcp23017SetBitsByte( mcp23017, OLATA, hd44780->en );
-    usleep( 5000 ); // 5mS.
-
     mcp23017ClearBitsByte( mcp23017, OLATA, hd44780->en );
-    usleep( 5000 ); // 5mS.
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns the execution time of a command or data byte in uS.
+//  ---------------------------------------------------------------------------
+static uint16_t hd44780Delay( uint8_t data, bool mode )
+{
+    if (( mode == MODE_COMMAND ) &&
+        (( data == DISPLAY_CLEAR ) || (( data & ~0x01 ) == DISPLAY_HOME )))
+        return DELAY_HOME;
+    return DELAY_COMMAND;
+}
+
+//  ---------------------------------------------------------------------------
+//  Polls the busy flag until clear. Returns false if it didn't clear.
+//  ---------------------------------------------------------------------------
+/*
+    GPIOB is made an input before R/W is set so that the MCP23017 and the
+    HD44780 never drive the data lines at the same time. The busy flag is
+    DB7 and is read while E is high.
+*/
+static bool hd44780ReadBusy( struct mcp23017 *mcp23017,
+                             struct hd44780 *hd44780 )
+{
+    uint8_t data = 0x80;
+    uint8_t i;
+
+    mcp23017WriteByte( mcp23017, IODIRB, 0xff );
+    mcp23017ClearBitsByte( mcp23017, OLATA, hd44780->rs );
+    mcp23017SetBitsByte( mcp23017, OLATA, hd44780->rw );
+
+    for ( i = 0; ( i < BUSY_POLL_MAX ) && ( data & 0x80 ); i++ )
+    {
+        mcp23017SetBitsByte( mcp23017, OLATA, hd44780->en );
+        data = mcp23017ReadByte( mcp23017, GPIOB );
+        mcp23017ClearBitsByte( mcp23017, OLATA, hd44780->en );
+    }
+
+    mcp23017ClearBitsByte( mcp23017, OLATA, hd44780->rw );
+    mcp23017WriteByte( mcp23017, IODIRB, 0x00 );
+
+    return !( data & 0x80 );
+}
+
+//  ---------------------------------------------------------------------------
+//  Waits for the HD44780 to finish executing the last command or data write.
+//  ---------------------------------------------------------------------------
+/*
+    Writes don't wait for the display to execute them. Instead the time it
+    will be ready is kept and the next write to the same display waits for
+    whatever is left, so the bus can be used for other displays meanwhile.
+    Reading the busy flag takes several I2C transactions, which is longer
+    than most commands take to execute, so it is only used if a slow
+    command has a long time left. The data sheet timings are used otherwise
+    or if the busy flag can't be read.
+*/
+static void hd44780Settle( struct mcp23017 *mcp23017,
+                           struct hd44780 *hd44780 )
+{
+    struct timespec now;
+    long   wait;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    wait = ( hd44780->ready.tv_sec - now.tv_sec ) * 1000000L +
+           ( hd44780->ready.tv_nsec - now.tv_nsec ) / 1000;
+    if ( wait <= 0 ) return;
+
+    if (( hd44780->busyFlag ) && ( wait >= BUSY_POLL_MIN ) &&
+        ( hd44780ReadBusy( mcp23017, hd44780 ))) return;
+    usleep( wait );
+}
+
+//  ---------------------------------------------------------------------------
+//  Sets the time the HD44780 will have executed the last write.
+//  ---------------------------------------------------------------------------
+static void hd44780Defer( struct hd44780 *hd44780, uint16_t delay )
+{
+    clock_gettime( CLOCK_MONOTONIC, &hd44780->ready );
+    hd44780->ready.tv_nsec += delay * 1000L;
+    if ( hd44780->ready.tv_nsec >= 1000000000L )
+    {
+        hd44780->ready.tv_sec++;
+        hd44780->ready.tv_nsec -= 1000000000L;
+    }
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns true if display a will be ready before display b.
+//  ---------------------------------------------------------------------------
+static bool hd44780Sooner( const struct hd44780 *a, const struct hd44780 *b )
+{
+    return ( a->ready.tv_sec < b->ready.tv_sec ) ||
+           (( a->ready.tv_sec == b->ready.tv_sec ) &&
+            ( a->ready.tv_nsec < b->ready.tv_nsec ));
+}
+
+//  ---------------------------------------------------------------------------
+//  Queues a sequence of command or data bytes in a batch.
+//  ---------------------------------------------------------------------------
+/*
+    latch is OLATA with the RS, R/W and E bits clear. Returns -1 if part of
+    the batch had to be sent early and failed. The shadow DDRAM isn't
+    updated until the batch is known to be sent, see hd44780Commit.
+*/
+static int8_t hd44780Queue( struct mcp23017Batch *batch,
+                            struct hd44780 *hd44780, uint8_t latch,
+                            const uint8_t *data, uint16_t len, bool mode )
+{
+    int8_t   result = 0;
+    uint16_t i;
+
+    if ( mode == MODE_DATA ) latch |= hd44780->rs;
+
+    result |= mcp23017BatchWrite( batch, OLATA, latch );
+    for ( i = 0; i < len; i++ )
+    {
+        result |= mcp23017BatchWrite( batch, OLATB, data[i] );
+        result |= mcp23017BatchWrite( batch, OLATA, latch | hd44780->en );
+        result |= mcp23017BatchWrite( batch, OLATB, data[i] );
+        result |= mcp23017BatchWrite( batch, OLATA, latch );
+    }
+
+    return ( result < 0 ) ? -1 : 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Keeps the shadow DDRAM in step with a sequence of bytes written.
+//  ---------------------------------------------------------------------------
+/*
+    If the write failed any part of the sequence may have reached the
+    display. The bytes then only go into the next frame, so the cells they
+    were for stay different to the shadow and are sent again by the next
+    hd44780Flush, and the address counter is no longer known.
+*/
+static void hd44780Commit( struct hd44780 *hd44780, const uint8_t *data,
+                           uint16_t len, bool mode, bool sent )
+{
+    uint16_t i;
+
+    for ( i = 0; i < len; i++ ) hd44780Track( hd44780, data[i], mode, sent );
+    if ( !sent ) hd44780->address = ADDRESS_UNKNOWN;
 }
 
 //  ---------------------------------------------------------------------------
@@ -102,6 +333,12 @@ void hd44780ToggleEnable( struct mcp23017 *mcp23017, struct hd44780 *hd44780 )
 int8_t hd44780WriteByte( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
                          uint8_t data, bool mode )
 {
+    return hd44780WriteBytes( mcp23017, hd44780, &data, 1, mode );
+};
+
+//  ---------------------------------------------------------------------------
+//  Writes a sequence of command or data bytes (according to mode).
+//  ---------------------------------------------------------------------------
 /*
     +---------------------------------------------------------------+
     |             GPIOB             |             GPIOA             |
@@ -110,22 +347,40 @@ int8_t hd44780WriteByte( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
     |---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---|
     |DB7|DB6|DB5|DB4|DB3|DB2|DB1|DB0|RS |R/W| E |---|---|---|---|---|
     +---------------------------------------------------------------+
+
+    Each byte is written to OLATB, E is raised and lowered via OLATA and
+    the HD44780 latches the byte as E falls. OLATB is written again while
+    E is high so that writes alternate between OLATA and OLATB, which the
+    MCP23017 sends as a single message in byte mode. The bus time for each
+    byte is longer than the HD44780 needs to execute it at up to 400kHz so
+    only the last byte needs time to execute, which is waited for by the
+    next write. Commands that take longer, i.e. clear and home, should be
+    written on their own.
 */
+int8_t hd44780WriteBytes( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
+                          const uint8_t *data, uint16_t len, bool mode )
+{
+    struct   mcp23017Batch batch;
+    uint8_t  latch;
+    bool     sent;
 
-    // Set RS bit according to mode.
-    if ( mode == 0 )
-        mcp23017ClearBitsByte( mcp23017, OLATA, hd44780->rs );
-    else
-        mcp23017SetBitsByte( mcp23017, OLATA, hd44780->rs );
+    if ( len == 0 ) return 0;
 
-    // Make sure R/W pin is cleared.
-    mcp23017ClearBitsByte( mcp23017, OLATA, hd44780->rw );
+    // Wait for previous write to be executed.
+    hd44780Settle( mcp23017, hd44780 );
+
+    // Other GPIOA pins are left unchanged.
+    latch = (uint8_t) mcp23017ReadByte( mcp23017, OLATA );
+    latch &= ~( hd44780->rs | hd44780->rw | hd44780->en );
 
-    // Write byte to HD44780 via MCP23017.
-    mcp23017WriteByte( mcp23017, OLATB, data );
+    mcp23017BatchStart( &batch, mcp23017 );
+    sent = ( hd44780Queue( &batch, hd44780, latch, data, len, mode ) == 0 );
+    sent = ( mcp23017BatchFlush( &batch ) == 0 ) && sent;
+    hd44780Commit( hd44780, data, len, mode, sent );
+    if ( !sent ) return -1;
 
-    // Toggle enable bit to send nibble via output latch.
-    hd44780ToggleEnable( mcp23017, hd44780 );
+    // Last byte is executed while the bus is free for other writes.
+    hd44780Defer( hd44780, hd44780Delay( data[len - 1], mode ));
 
     return 0;
 };
@@ -136,12 +391,8 @@ int8_t hd44780WriteByte( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
 int8_t hd44780WriteString( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
                            char *string )
 {
-    uint8_t i;
-
-    // Sends string to LCD byte by byte.
-    for ( i = 0; i < strlen( string ); i++ )
-        hd44780WriteByte( mcp23017, hd44780, string[i], MODE_DATA );
-    return 0;
+    return hd44780WriteBytes( mcp23017, hd44780, (uint8_t *) string,
+                              strlen( string ), MODE_DATA );
 };
 
 //  ---------------------------------------------------------------------------
@@ -160,15 +411,150 @@ int8_t hd44780Goto( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
     // This doesn't properly check whether the number of display
     // lines has been set to 1.
 
-    // Array of row start addresses
-    uint8_t rows[DISPLAY_ROWS_MAX] = { ADDRESS_ROW_0, ADDRESS_ROW_1,
-                                       ADDRESS_ROW_2, ADDRESS_ROW_3 };
+    hd44780WriteByte( mcp23017, hd44780,
+                      ( ADDRESS_DDRAM | rowAddress[row] ) + pos,
+                      MODE_COMMAND );
+    return 0;
+};
+
+//  ---------------------------------------------------------------------------
+//  Writes characters into the next display frame.
+//  ---------------------------------------------------------------------------
+int8_t hd44780Print( struct hd44780 *hd44780, uint8_t row, uint8_t pos,
+                     const char *string, uint8_t len )
+{
+    if (( pos > DISPLAY_COLUMNS - 1 ) || ( row > DISPLAY_ROWS - 1 ))
+        return -1;
+
+    // Truncate at end of row.
+    if ( len > DISPLAY_COLUMNS - pos ) len = DISPLAY_COLUMNS - pos;
+    memcpy( &hd44780->frame[row][pos], string, len );
 
-    hd44780WriteByte( mcp23017, hd44780, ( ADDRESS_DDRAM | rows[row] ) + pos,
-    				                       MODE_COMMAND );
     return 0;
 };
 
+//  ---------------------------------------------------------------------------
+//  Sends the next run of changed characters. Returns 0 if there are none.
+//  ---------------------------------------------------------------------------
+/*
+    Changed characters in each row are grouped into runs, each sent as a
+    single cursor move followed by its characters. Short gaps of unchanged
+    characters are rewritten rather than starting a new run since moving
+    the cursor costs as much as a character. The cursor move is skipped if
+    the address counter is already at the start of the run. The move and
+    the characters go in one batch since the bus time for each byte covers
+    the time to execute the move.
+
+    row and pos are where to look from and are left after the run.
+    Returns 1 if a run was sent or -1 if the write failed or the display
+    has been shifted.
+*/
+static int8_t hd44780FlushRun( struct mcp23017 *mcp23017,
+                               struct hd44780 *hd44780,
+                               uint8_t *row, uint8_t *pos )
+{
+    struct  mcp23017Batch batch;
+    uint8_t start, end, address, command, latch;
+    bool    move, sent;
+
+    // Shadow cells don't match display positions while shifted.
+    if ( hd44780->shifted ) return -1;
+
+    for ( ; *row < DISPLAY_ROWS; ( *row )++, *pos = 0 )
+    {
+        while (( *pos < DISPLAY_COLUMNS ) &&
+               ( hd44780->frame[*row][*pos] == hd44780->ddram[*row][*pos] ))
+            ( *pos )++;
+        if ( *pos == DISPLAY_COLUMNS ) continue;
+
+        // Find end of run.
+        start = *pos;
+        end   = start + 1;
+        for ( *pos = end; ( *pos < DISPLAY_COLUMNS ) &&
+                          ( *pos - end <= FLUSH_GAP ); ( *pos )++ )
+            if ( hd44780->frame[*row][*pos] != hd44780->ddram[*row][*pos] )
+                end = *pos + 1;
+        *pos = end;
+
+        hd44780Settle( mcp23017, hd44780 );
+
+        latch = (uint8_t) mcp23017ReadByte( mcp23017, OLATA );
+        latch &= ~( hd44780->rs | hd44780->rw | hd44780->en );
+
+        mcp23017BatchStart( &batch, mcp23017 );
+        address = rowAddress[*row] + start;
+        command = ADDRESS_DDRAM | address;
+        move    = ( hd44780->address != address );
+        sent    = true;
+        if ( move )
+            sent = ( hd44780Queue( &batch, hd44780, latch, &command, 1,
+                                   MODE_COMMAND ) == 0 );
+        sent = ( hd44780Queue( &batch, hd44780, latch,
+                               &hd44780->frame[*row][start],
+                               end - start, MODE_DATA ) == 0 ) && sent;
+        sent = ( mcp23017BatchFlush( &batch ) == 0 ) && sent;
+        if ( move ) hd44780Commit( hd44780, &command, 1, MODE_COMMAND, sent );
+        hd44780Commit( hd44780, &hd44780->frame[*row][start], end - start,
+                       MODE_DATA, sent );
+        if ( !sent ) return -1;
+
+        hd44780Defer( hd44780, DELAY_COMMAND );
+        return 1;
+    }
+
+    return 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Sends changed characters in the display frame to the display.
+//  ---------------------------------------------------------------------------
+int8_t hd44780Flush( struct mcp23017 *mcp23017, struct hd44780 *hd44780 )
+{
+    uint8_t row = 0, pos = 0;
+    int8_t  sent;
+
+    while (( sent = hd44780FlushRun( mcp23017, hd44780, &row, &pos )) > 0 );
+
+    return sent;
+};
+
+//  ---------------------------------------------------------------------------
+//  Sends changed characters to several displays, interleaving their runs.
+//  ---------------------------------------------------------------------------
+/*
+    The next run always goes to the display that is ready soonest, so while
+    one display executes its last run the bus is writing to another. Only
+    when every display with changes left is still busy is there a wait.
+*/
+int8_t hd44780FlushMany( struct mcp23017 *mcp23017[],
+                         struct hd44780 *hd44780[], uint8_t count )
+{
+    uint8_t  row[HD44780_WALL_MAX] = { 0 };
+    uint8_t  pos[HD44780_WALL_MAX] = { 0 };
+    uint16_t pending;
+    uint8_t  i, next;
+    int8_t   sent, result = 0;
+
+    if ( count > HD44780_WALL_MAX ) count = HD44780_WALL_MAX;
+    pending = ( 1 << count ) - 1;
+
+    while ( pending )
+    {
+        for ( next = 0; !( pending & ( 1 << next )); next++ );
+        for ( i = next + 1; i < count; i++ )
+            if (( pending & ( 1 << i )) &&
+                ( hd44780Sooner( hd44780[i], hd44780[next] )))
+                next = i;
+
+        sent = hd44780FlushRun( mcp23017[next], hd44780[next],
+                                &row[next], &pos[next] );
+        if ( sent <= 0 ) pending &= ~( 1 << next );
+        if ( sent < 0 ) result = -1;
+    }
+
+    return result;
+};
+
 //  Display init and mode functions. ------------------------------------------
 
 //  ---------------------------------------------------------------------------
@@ -177,7 +563,6 @@ int8_t hd44780Goto( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
 int8_t hd44780Clear( struct mcp23017 *mcp23017, struct hd44780 *hd44780 )
 {
     hd44780WriteByte( mcp23017, hd44780, DISPLAY_CLEAR, MODE_COMMAND );
-    usleep( 1600 ); // Data sheet doesn't give execution time!
     return 0;
 };
 
@@ -187,7 +572,6 @@ int8_t hd44780Clear( struct mcp23017 *mcp23017, struct hd44780 *hd44780 )
 int8_t hd44780Home( struct mcp23017 *mcp23017, struct hd44780 *hd44780 )
 {
     hd44780WriteByte( mcp23017, hd44780, DISPLAY_HOME, MODE_COMMAND );
-    usleep( 1600 ); // Needs 1.52ms to execute.
     return 0;
 };
 
@@ -200,6 +584,11 @@ int8_t hd44780Init( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
                     bool counter, bool shift,
                     bool mode,    bool direction )
 {
+    // Shadow DDRAM is valid after the display is cleared.
+    hd44780->address = ADDRESS_UNKNOWN;
+    hd44780->shifted = false;
+    clock_gettime( CLOCK_MONOTONIC, &hd44780->ready );
+
     // Allow a start-up delay.
     usleep( 40000 );    // >40mS@3V.
 
@@ -345,34 +734,340 @@ int8_t hd44780LoadCustom( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
                           const uint8_t newChar[CUSTOM_MAX][CUSTOM_SIZE] )
 {
     hd44780WriteByte( mcp23017, hd44780, ADDRESS_CGRAM, MODE_COMMAND );
-    uint8_t i, j;
-    for ( i = 0; i < CUSTOM_MAX; i++ )
-        for ( j = 0; j < CUSTOM_SIZE; j++ )
-            hd44780WriteByte( mcp23017, hd44780, newChar[i][j], MODE_DATA );
+    hd44780WriteBytes( mcp23017, hd44780, &newChar[0][0],
+                       CUSTOM_MAX * CUSTOM_SIZE, MODE_DATA );
     hd44780WriteByte( mcp23017, hd44780, ADDRESS_DDRAM, MODE_COMMAND );
     return 0;
 };
 
-//  Display functions. --------------------------------------------------------
+//  ---------------------------------------------------------------------------
+//  Initialises a glyph cache with CGRAM contents unknown.
+//  ---------------------------------------------------------------------------
+void hd44780GlyphInit( struct hd44780Glyphs *glyphs )
+{
+    memset( glyphs, 0, sizeof( struct hd44780Glyphs ));
+
+    // Slots never used have frame 0 so are replaced first.
+    glyphs->frame = 1;
+};
+
+//  ---------------------------------------------------------------------------
+//  Starts a new frame for a glyph cache.
+//  ---------------------------------------------------------------------------
+void hd44780GlyphFrame( struct hd44780Glyphs *glyphs )
+{
+    glyphs->frame++;
+};
+
+//  ---------------------------------------------------------------------------
+//  Returns the CGRAM slot for a glyph, uploading it if necessary.
+//  ---------------------------------------------------------------------------
+int8_t hd44780Glyph( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
+                     struct hd44780Glyphs *glyphs,
+                     const uint8_t glyph[CUSTOM_SIZE] )
+{
+    int8_t  slot = -1;
+    uint8_t i, row, start;
+    bool    known;
+
+    for ( i = 0; i < CUSTOM_MAX; i++ )
+    {
+        // Glyph is already in CGRAM.
+        if (( glyphs->known & ( 1 << i )) &&
+            ( memcmp( glyphs->data[i], glyph, CUSTOM_SIZE ) == 0 ))
+        {
+            glyphs->used[i] = glyphs->frame;
+            return i;
+        }
+
+        // Least recently used slot that isn't in this frame.
+        if (( glyphs->used[i] != glyphs->frame ) &&
+            (( slot < 0 ) || ( glyphs->used[i] < glyphs->used[slot] )))
+            slot = i;
+    }
+    if ( slot < 0 ) return -1;
+
+    // Send runs of rows that differ, or all rows if the slot isn't known.
+    known = glyphs->known & ( 1 << slot );
+    glyphs->known &= ~( 1 << slot );
+    row = 0;
+    while ( row < CUSTOM_SIZE )
+    {
+        if ( known && ( glyphs->data[slot][row] == glyph[row] ))
+        {
+            row++;
+            continue;
+        }
+
+        start = row;
+        while (( row < CUSTOM_SIZE ) &&
+               !( known && ( glyphs->data[slot][row] == glyph[row] )))
+            row++;
+
+        if ( hd44780WriteByte( mcp23017, hd44780,
+                               ADDRESS_CGRAM | ( slot * CUSTOM_SIZE + start ),
+                               MODE_COMMAND ) < 0 ) return -1;
+        if ( hd44780WriteBytes( mcp23017, hd44780, &glyph[start],
+                                row - start, MODE_DATA ) < 0 ) return -1;
+    }
+
+    memcpy( glyphs->data[slot], glyph, CUSTOM_SIZE );
+    glyphs->known |= 1 << slot;
+    glyphs->used[slot] = glyphs->frame;
+
+    return slot;
+};
+
+//  Compositor. ---------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Initialises a compositor for a display.
+//  ---------------------------------------------------------------------------
+int8_t hd44780CompositorInit( struct hd44780Compositor *compositor,
+                              struct mcp23017 *mcp23017,
+                              struct hd44780 *hd44780,
+                              struct timeval tick )
+{
+    uint8_t i;
+
+    memset( compositor, 0, sizeof( struct hd44780Compositor ));
+    compositor->mcp23017 = mcp23017;
+    compositor->hd44780  = hd44780;
+    compositor->tick     = tick;
+    compositor->running  = true;
+
+    // Each slot is free for the post with the same sequence number.
+    for ( i = 0; i < DISPLAY_QUEUE_SIZE; i++ )
+        compositor->queue[i].sequence = i;
+
+    return 0;
+};
+
+//  ---------------------------------------------------------------------------
+//  Adds a display region. Returns the region index.
+//  ---------------------------------------------------------------------------
+int8_t hd44780AddRegion( struct hd44780Compositor *compositor,
+                         uint8_t row, uint8_t col, uint8_t width )
+{
+    struct hd44780Region *region;
+
+    if ( compositor->regions >= DISPLAY_REGIONS_MAX ) return -1;
+    if (( row > DISPLAY_ROWS - 1 ) || ( col > DISPLAY_COLUMNS - 1 ))
+        return -1;
+    if ( width > DISPLAY_COLUMNS - col ) width = DISPLAY_COLUMNS - col;
+
+    region = &compositor->region[compositor->regions];
+    region->row   = row;
+    region->col   = col;
+    region->width = width;
+
+    return compositor->regions++;
+};
+
+//  ---------------------------------------------------------------------------
+//  Posts new contents for a region without waiting.
+//  ---------------------------------------------------------------------------
+/*
+    This is a bounded multiple producer queue. Each slot has a sequence
+    number that tells a producer whether the slot is free for its position
+    and tells the consumer whether the slot has been filled. Producers
+    claim a position with a compare and swap on the head so they never
+    wait for each other or for the display.
+*/
+int8_t hd44780Post( struct hd44780Compositor *compositor, uint8_t region,
+                    const char *data, uint8_t len )
+{
+    struct   hd44780Post *post;
+    uint32_t head, sequence;
+    int32_t  diff;
+
+    if ( region >= compositor->regions ) return -1;
+    if ( len > DISPLAY_COLUMNS ) len = DISPLAY_COLUMNS;
+
+    head = __atomic_load_n( &compositor->head, __ATOMIC_RELAXED );
+    while ( 1 )
+    {
+        post = &compositor->queue[head % DISPLAY_QUEUE_SIZE];
+        sequence = __atomic_load_n( &post->sequence, __ATOMIC_ACQUIRE );
+        diff = (int32_t)( sequence - head );
+
+        if ( diff == 0 )
+        {
+            // Slot is free so try to claim it.
+            if ( __atomic_compare_exchange_n( &compositor->head, &head,
+                                              head + 1, true,
+                                              __ATOMIC_RELAXED,
+                                              __ATOMIC_RELAXED ))
+                break;
+        }
+        else if ( diff < 0 ) return -1; // Queue is full.
+        else head = __atomic_load_n( &compositor->head, __ATOMIC_RELAXED );
+    }
+
+    post->region = region;
+    post->len    = len;
+    memcpy( post->data, data, len );
+
+    // Hand slot to consumer.
+    __atomic_store_n( &post->sequence, head + 1, __ATOMIC_RELEASE );
+
+    return 0;
+};
 
 //  ---------------------------------------------------------------------------
-//  Reverses a string passed as *buffer between start and end.
+//  Applies all queued posts to the display frame.
 //  ---------------------------------------------------------------------------
-static void reverseString( char *buffer, size_t start, size_t end )
+static void hd44780Compose( struct hd44780Compositor *compositor )
 {
-    char temp;
-    while ( start < end )
+    struct   hd44780 *hd44780 = compositor->hd44780;
+    struct   hd44780Post *post;
+    struct   hd44780Region *region;
+    uint32_t tail = compositor->tail;
+
+    while ( 1 )
     {
-        end--;
-        temp = buffer[start];
-        buffer[start] = buffer[end];
-        buffer[end] = temp;
-        start++;
+        post = &compositor->queue[tail % DISPLAY_QUEUE_SIZE];
+        if ( __atomic_load_n( &post->sequence, __ATOMIC_ACQUIRE ) !=
+             tail + 1 ) break;
+
+        // Blank region and write new contents.
+        region = &compositor->region[post->region];
+        memset( &hd44780->frame[region->row][region->col], ' ',
+                region->width );
+        hd44780Print( hd44780, region->row, region->col, (char *) post->data,
+                      ( post->len < region->width ) ? post->len :
+                                                      region->width );
+
+        // Free slot for the producer one lap later.
+        __atomic_store_n( &post->sequence, tail + DISPLAY_QUEUE_SIZE,
+                          __ATOMIC_RELEASE );
+        tail++;
     }
 
-    return;
+    compositor->tail = tail;
+}
+
+//  ---------------------------------------------------------------------------
+//  Sleeps until the next tick, or starts again if too far behind.
+//  ---------------------------------------------------------------------------
+static void hd44780Tick( struct timespec *next, long tick )
+{
+    struct timespec now;
+
+    next->tv_nsec += tick % 1000000000L;
+    next->tv_sec  += tick / 1000000000L + next->tv_nsec / 1000000000L;
+    next->tv_nsec %= 1000000000L;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    if (( now.tv_sec > next->tv_sec ) ||
+        (( now.tv_sec == next->tv_sec ) && ( now.tv_nsec > next->tv_nsec )))
+        *next = now;
+    else
+        clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, next, NULL );
+}
+
+//  ---------------------------------------------------------------------------
+//  Owns the display and flushes posted regions once per tick.
+//  ---------------------------------------------------------------------------
+void *displayCompositor( void *threadCompositor )
+{
+    struct hd44780Compositor *compositor = threadCompositor;
+    struct timespec next;
+    long   tick = compositor->tick.tv_sec * 1000000000L +
+                  compositor->tick.tv_usec * 1000L;
+
+    clock_gettime( CLOCK_MONOTONIC, &next );
+
+    while ( __atomic_load_n( &compositor->running, __ATOMIC_ACQUIRE ))
+    {
+        hd44780Compose( compositor );
+
+        // Keeps any direct writers out while flushing.
+        pthread_mutex_lock( &displayBusy );
+        hd44780Flush( compositor->mcp23017, compositor->hd44780 );
+        pthread_mutex_unlock( &displayBusy );
+
+        hd44780Tick( &next, tick );
+    }
+
+    pthread_exit( NULL );
 };
 
+//  ---------------------------------------------------------------------------
+//  Stops the compositor thread after its current tick.
+//  ---------------------------------------------------------------------------
+void hd44780CompositorStop( struct hd44780Compositor *compositor )
+{
+    __atomic_store_n( &compositor->running, false, __ATOMIC_RELEASE );
+};
+
+//  Display wall. -------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Initialises a wall of displays.
+//  ---------------------------------------------------------------------------
+int8_t hd44780WallInit( struct hd44780Wall *wall, struct timeval tick )
+{
+    memset( wall, 0, sizeof( struct hd44780Wall ));
+    wall->tick    = tick;
+    wall->running = true;
+
+    return 0;
+};
+
+//  ---------------------------------------------------------------------------
+//  Adds a display's compositor to a wall. Returns the display index.
+//  ---------------------------------------------------------------------------
+int8_t hd44780WallAdd( struct hd44780Wall *wall,
+                       struct hd44780Compositor *compositor )
+{
+    if ( wall->displays >= HD44780_WALL_MAX ) return -1;
+
+    wall->compositor[wall->displays] = compositor;
+    wall->mcp23017[wall->displays]   = compositor->mcp23017;
+    wall->hd44780[wall->displays]    = compositor->hd44780;
+
+    return wall->displays++;
+};
+
+//  ---------------------------------------------------------------------------
+//  Owns the displays of a wall and flushes them together once per tick.
+//  ---------------------------------------------------------------------------
+void *displayWall( void *threadWall )
+{
+    struct hd44780Wall *wall = threadWall;
+    struct timespec next;
+    long   tick = wall->tick.tv_sec * 1000000000L +
+                  wall->tick.tv_usec * 1000L;
+    uint8_t i;
+
+    clock_gettime( CLOCK_MONOTONIC, &next );
+
+    while ( __atomic_load_n( &wall->running, __ATOMIC_ACQUIRE ))
+    {
+        for ( i = 0; i < wall->displays; i++ )
+            hd44780Compose( wall->compositor[i] );
+
+        // Keeps any direct writers out while flushing.
+        pthread_mutex_lock( &displayBusy );
+        hd44780FlushMany( wall->mcp23017, wall->hd44780, wall->displays );
+        pthread_mutex_unlock( &displayBusy );
+
+        hd44780Tick( &next, tick );
+    }
+
+    pthread_exit( NULL );
+};
+
+//  ---------------------------------------------------------------------------
+//  Stops the wall thread after its current tick.
+//  ---------------------------------------------------------------------------
+void hd44780WallStop( struct hd44780Wall *wall )
+{
+    __atomic_store_n( &wall->running, false, __ATOMIC_RELEASE );
+};
+
+//  Display functions. --------------------------------------------------------
+
 //  ---------------------------------------------------------------------------
 //  Calculates time difference in milliseconds in diff. Returns 0 on success.
 //  ---------------------------------------------------------------------------
@@ -389,29 +1084,94 @@ static int8_t timeDiff( struct timeval *diff, struct timeval *t2,
 }
 
 //  ---------------------------------------------------------------------------
-//  Rotates a string passed as buffer by increments.
+//  Returns true if nothing but the ticker row is on the display.
 //  ---------------------------------------------------------------------------
-static void rotateString( char *buffer, size_t length, size_t increments )
+/*
+    The display shift moves every row, so it is only safe when the other
+    rows are blank both on the display and in the next frame. Displays of
+    more than 2 rows split each DDRAM row across two display rows.
+*/
+static bool hd44780TickerAlone( struct ticker *ticker )
 {
-    // if (!text || !*text ) return;
-    increments %= length;
-    reverseString( buffer, 0, increments );
-    reverseString( buffer, increments, length );
-    reverseString( buffer, 0, length );
+    struct  hd44780 *hd44780 = ticker->hd44780;
+    uint8_t row, pos;
+
+    if (( DISPLAY_ROWS > 2 ) || ( ticker->row >= DISPLAY_ROWS )) return false;
+
+    for ( row = 0; row < DISPLAY_ROWS; row++ )
+    {
+        if ( row == ticker->row ) continue;
+        for ( pos = 0; pos < DISPLAY_COLUMNS; pos++ )
+            if (( hd44780->ddram[row][pos] != ' ' ) ||
+                ( hd44780->frame[row][pos] != ' ' )) return false;
+    }
+
+    return true;
+}
+
+//  ---------------------------------------------------------------------------
+//  Scrolls ticker text using the HD44780 display shift.
+//  ---------------------------------------------------------------------------
+/*
+    The text is written once into the whole DDRAM row and the display is
+    shifted by one command per step. The display wraps around the row so
+    the text is padded to the full row length. Only the ticker row is
+    written, the other rows are left as they are (blank, see
+    hd44780TickerAlone) and the shadow is left for hd44780Track to mark as
+    shifted.
+*/
+static void displayTickerShift( struct ticker *ticker, const char *text,
+                                struct timespec *sleepTime )
+{
+    uint8_t  buffer[DDRAM_ROW_LENGTH];
+    uint8_t  command = MOVE_BASE | MOVE_DISPLAY;
+    uint16_t steps = abs( ticker->increment );
+    uint16_t i;
+
+    memset( buffer, ' ', DDRAM_ROW_LENGTH );
+    memcpy( buffer, text, ticker->length );
+
+    // Positive increments move text left.
+    if ( ticker->increment < 0 ) command |= MOVE_DIRECTION;
+
+    pthread_mutex_lock( &displayBusy );
+    hd44780Goto( ticker->mcp23017, ticker->hd44780, ticker->row, 0 );
+    hd44780WriteBytes( ticker->mcp23017, ticker->hd44780,
+                       buffer, DDRAM_ROW_LENGTH, MODE_DATA );
+    pthread_mutex_unlock( &displayBusy );
+
+    while ( 1 )
+    {
+        nanosleep( sleepTime, NULL );
 
-    return;
+        pthread_mutex_lock( &displayBusy );
+        for ( i = 0; i < steps; i++ )
+            hd44780WriteByte( ticker->mcp23017, ticker->hd44780,
+                              command, MODE_COMMAND );
+        pthread_mutex_unlock( &displayBusy );
+    }
 }
 
 //  ---------------------------------------------------------------------------
 //  Displays text on display row as a tickertape.
 //  ---------------------------------------------------------------------------
+/*
+    The text isn't moved. Instead the window onto it starts at an offset
+    that advances each step, wrapping round the text and the padding.
+    Writing the window through the shadow DDRAM means only characters that
+    change are sent.
+*/
 void *displayTicker( void *threadTicker )
 {
     // Get parameters.
     struct ticker *ticker = threadTicker;
 
-    // Close thread if text string is too big.
-    if ( ticker->length + ticker->padding > TEXT_MAX_LENGTH )
+    // Text is either the caller's buffer or the internal copy.
+    const char *text = ( ticker->source ) ? ticker->source : ticker->text;
+
+    // Close thread if internal text string is too big.
+    if (( ticker->source == NULL ) &&
+        ( ticker->length + ticker->padding > TEXT_MAX_LENGTH ))
          pthread_exit( NULL );
 
     // Variables for nanosleep function.
@@ -419,34 +1179,62 @@ void *displayTicker( void *threadTicker )
     sleepTime.tv_sec  = ticker->delay.tv_sec;
     sleepTime.tv_nsec = ticker->delay.tv_usec * 1000;
 
-    // Add some padding so rotated text looks better.
-    size_t i;
-    for ( i = ticker->length; i < ticker->length + ticker->padding; i++ )
-        ticker->text[i] = ' ';
-    ticker->text[i] = '\0';
-    ticker->length = strlen( ticker->text );
+    // Let the display scroll text that fits in a DDRAM row.
+    if (( ticker->shift ) && ( ticker->compositor == NULL ) &&
+        ( ticker->length <= DDRAM_ROW_LENGTH ))
+    {
+        pthread_mutex_lock( &displayBusy );
+        bool alone = hd44780TickerAlone( ticker );
+        pthread_mutex_unlock( &displayBusy );
+        if ( alone ) displayTickerShift( ticker, text, &sleepTime );
+    }
+
+    // Padding is added as the window is filled so that rotated text looks
+    // better.
+    uint32_t total = ticker->length + ticker->padding;
+    uint32_t start = 0;
+    uint32_t step;
+    uint32_t pos;
+    uint8_t  i;
+
+    if ( total == 0 ) pthread_exit( NULL );
+    step = ( ticker->increment < 0 ) ?
+             total - (uint32_t)( -ticker->increment ) % total :
+                     (uint32_t)( ticker->increment ) % total;
 
     // Set up a text window equal to the number of display columns.
     char buffer[DISPLAY_COLUMNS];
 
-    hd44780Clear( ticker->mcp23017, ticker->hd44780 );
+    if ( ticker->compositor == NULL )
+        hd44780Clear( ticker->mcp23017, ticker->hd44780 );
 
     while ( 1 )
     {
-        // Copy the display text.
-        strncpy( buffer, ticker->text, DISPLAY_COLUMNS );
-
-        // Lock thread and display ticker text.
-        pthread_mutex_lock( &displayBusy );
-        hd44780Goto( ticker->mcp23017, ticker->hd44780, ticker->row, 0 );
-        hd44780WriteString( ticker->mcp23017, ticker->hd44780, buffer );
-        pthread_mutex_unlock( &displayBusy );
+        // Fill window from text and padding.
+        for ( i = 0, pos = start; i < DISPLAY_COLUMNS; i++ )
+        {
+            buffer[i] = ( pos < ticker->length ) ? text[pos] : ' ';
+            if ( ++pos == total ) pos = 0;
+        }
+
+        // Post text to compositor or lock thread and display ticker text.
+        if ( ticker->compositor )
+            hd44780Post( ticker->compositor, ticker->region,
+                         buffer, DISPLAY_COLUMNS );
+        else
+        {
+            pthread_mutex_lock( &displayBusy );
+            hd44780Print( ticker->hd44780, ticker->row, 0,
+                          buffer, DISPLAY_COLUMNS );
+            hd44780Flush( ticker->mcp23017, ticker->hd44780 );
+            pthread_mutex_unlock( &displayBusy );
+        }
 
         // Delay for readability.
         nanosleep( &sleepTime, NULL );
 
-        // Rotate the ticker text.
-        rotateString( ticker->text, ticker->length, ticker->increment );
+        // Advance the window.
+        start = ( start + step ) % total;
     }
 
     pthread_exit( NULL );
@@ -477,7 +1265,8 @@ void *displayCalendar( void *threadCalendar )
     char buffer[20] = "";   // Display string.
     uint8_t frame = 0;      // Animation frame.
 
-    hd44780Clear( calendar->mcp23017, calendar->hd44780 );
+    if ( calendar->compositor == NULL )
+        hd44780Clear( calendar->mcp23017, calendar->hd44780 );
 
     while ( 1 )
     {
@@ -497,13 +1286,17 @@ void *displayCalendar( void *threadCalendar )
         frame++;
 
         // Display time string.
-        pthread_mutex_lock( &displayBusy );
-        hd44780Goto( calendar->mcp23017,
-                     calendar->hd44780,
-                     calendar->row,
-                     calendar->col );
-        hd44780WriteString( calendar->mcp23017, calendar->hd44780, buffer );
-        pthread_mutex_unlock( &displayBusy );
+        if ( calendar->compositor )
+            hd44780Post( calendar->compositor, calendar->region,
+                         buffer, strlen( buffer ));
+        else
+        {
+            pthread_mutex_lock( &displayBusy );
+            hd44780Print( calendar->hd44780, calendar->row, calendar->col,
+                          buffer, strlen( buffer ));
+            hd44780Flush( calendar->mcp23017, calendar->hd44780 );
+            pthread_mutex_unlock( &displayBusy );
+        }
 
         // Get time stamp and calculate time elapsed.
         gettimeofday( &tpEnd, NULL );
@@ -143,8 +143,8 @@ int main()
     mcp23017WriteByte( mcp23017[0], OLATA, 0x00 ); // Clear pins.
     mcp23017WriteByte( mcp23017[0], OLATB, 0x00 ); // Clear pins.
 
-    // Set BANK bit for 8-bit mode.
-    mcp23017WriteByte( mcp23017[0], IOCONA, 0x80 );
+    // Byte mode so that HD44780 writes are sent as single I2C messages.
+    mcp23017WriteIOCON( mcp23017[0], IOCON_SEQOP );
 
     struct hd44780 *hd44780this;
 
@@ -164,6 +164,7 @@ int main()
     hd44780this->rs    = 0x80; // HD44780 RS pin.
     hd44780this->rw    = 0x40; // HD44780 R/W pin.
     hd44780this->en    = 0x20; // HD44780 E pin.
+    hd44780this->busyFlag = false; // R/W grounded.
 
     hd44780[0] = hd44780this;
 
@@ -174,6 +175,14 @@ int main()
 
     hd44780WriteString( mcp23017[0], hd44780[0], "Initialised" );
 
+    // Set up compositor to own the display, with a region for each widget.
+    struct hd44780Compositor compositor;
+    struct timeval tick = { .tv_sec = 0, .tv_usec = 50000 };
+
+    hd44780CompositorInit( &compositor, mcp23017[0], hd44780[0], tick );
+    uint8_t dateRegion = hd44780AddRegion( &compositor, 0, 0, 16 );
+    uint8_t timeRegion = hd44780AddRegion( &compositor, 1, 4, 8 );
+
     // Set up structure to display current time.
     struct calendar time =
     {
@@ -186,7 +195,9 @@ int main()
         .length = 16,
         .frames = FRAMES_MAX,
         .format[0] = "%H:%M:%S",
-        .format[1] = "%H %M %S"
+        .format[1] = "%H %M %S",
+        .compositor = &compositor,
+        .region = timeRegion
     };
 
     // Set up structure to display current date.
@@ -200,7 +211,9 @@ int main()
         .col = 0,
         .length = 16,
         .frames = 1,
-        .format[0] = "%a %d %b %Y"
+        .format[0] = "%a %d %b %Y",
+        .compositor = &compositor,
+        .region = dateRegion
     };
 
     // Set ticker tape properties.
@@ -219,13 +232,15 @@ int main()
 
     // Create threads and mutex for animated display functions.
     pthread_mutex_init( &displayBusy, NULL );
-    pthread_t threads[2];
+    pthread_t threads[3];
 
     /*
         The HD44780 has a slow response so animation times should be as
         large as possible and not mixed with other routines that have high
         animation duty, e.g. ticker and time display with animation.
     */
+    pthread_create( &threads[2], NULL, displayCompositor,
+                    (void *) &compositor );
     pthread_create( &threads[0], NULL, displayCalendar, (void *) &date );
     pthread_create( &threads[1], NULL, displayCalendar, (void *) &time );
 //    pthread_create( &threads[1], NULL, displayPacMan, (void *) pacManRow );
@@ -0,0 +1,164 @@
+/*
+//  ===========================================================================
+
+    testhd44780wall:
+
+    Tests a wall of HD44780 LCD displays on several MCP23017s sharing one
+    I2C bus.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+*/
+
+#define Version "Version 0.1"
+
+/*
+//  ---------------------------------------------------------------------------
+
+    Compile with:
+
+    gcc testhd44780wall.c hd44780i2c.c mcp23017.c -Wall -o testhd44780wall
+                     -lpthread
+
+    Also use the following flags for Raspberry Pi optimisation:
+        -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
+        -ffast-math -pipe -O3
+
+    Run with the number of displays, 1 to 8, e.g.
+
+        testhd44780wall 4
+
+//  ---------------------------------------------------------------------------
+
+    Authors:        D.Faulke    28/02/2016
+
+    Contributors:
+
+    Changelog:
+
+        v0.1    Original version.
+
+//  Information. --------------------------------------------------------------
+
+    Each display is on its own MCP23017, with the address pins set for
+    0x20, 0x21 and so on, and wired as for testhd44780i2c. The first row
+    of each display shows its address and the second a counter that
+    changes every frame, so every display has changes on every tick. The
+    counters run together on all displays until the bus is full, when the
+    wall starts to miss ticks and the counters skip.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "hd44780i2c.h"
+#include "mcp23017.h"
+
+#define WALL_TICK     20000 // Time between wall flushes (uS).
+#define WALL_SECONDS     10 // Time to run for (S).
+
+int main( int argc, char *argv[] )
+{
+    struct hd44780Compositor compositor[HD44780_WALL_MAX];
+    struct hd44780 display[HD44780_WALL_MAX];
+    struct hd44780Wall wall;
+    struct timeval tick = { .tv_sec = 0, .tv_usec = WALL_TICK };
+    uint8_t  region[HD44780_WALL_MAX];
+    uint8_t  displays = 4;
+    uint8_t  i;
+    uint32_t frame;
+    char     buffer[DISPLAY_COLUMNS + 1];
+    pthread_t thread;
+
+    if ( argc > 1 ) displays = atoi( argv[1] );
+    if (( displays < 1 ) || ( displays > HD44780_WALL_MAX ))
+    {
+        printf( "Use 1 to %d displays.\n", HD44780_WALL_MAX );
+        return -1;
+    }
+
+    hd44780WallInit( &wall, tick );
+
+    for ( i = 0; i < displays; i++ )
+    {
+        // Initialise MCP23017.
+        if ( mcp23017Init( 0x20 + i ) < 0 )
+        {
+            printf( "Couldn't init 0x%02x. Try loading i2c-dev module.\n",
+                    0x20 + i );
+            return -1;
+        }
+
+        // All outputs, cleared, in byte mode for single I2C messages.
+        mcp23017WriteByte( mcp23017[i], IODIRA, 0x00 );
+        mcp23017WriteByte( mcp23017[i], IODIRB, 0x00 );
+        mcp23017WriteByte( mcp23017[i], OLATA, 0x00 );
+        mcp23017WriteByte( mcp23017[i], OLATB, 0x00 );
+        mcp23017WriteIOCON( mcp23017[i], IOCON_SEQOP );
+
+        // Set up hd44780 data.
+        display[i].rs       = 0x80; // HD44780 RS pin.
+        display[i].rw       = 0x40; // HD44780 R/W pin.
+        display[i].en       = 0x20; // HD44780 E pin.
+        display[i].busyFlag = false; // R/W grounded.
+
+        // 8-bit, 2 lines, 5x8 font, display on, cursor off, increment.
+        hd44780Init( mcp23017[i], &display[i],
+                     1, 1, 1, 1, 0, 0, 1, 0, 0, 0 );
+
+        hd44780CompositorInit( &compositor[i], mcp23017[i], &display[i],
+                               tick );
+        hd44780AddRegion( &compositor[i], 0, 0, DISPLAY_COLUMNS );
+        region[i] = hd44780AddRegion( &compositor[i], 1, 0,
+                                      DISPLAY_COLUMNS );
+        hd44780WallAdd( &wall, &compositor[i] );
+
+        snprintf( buffer, sizeof( buffer ), "LCD %d at 0x%02x", i, 0x20 + i );
+        hd44780Post( &compositor[i], 0, buffer, strlen( buffer ));
+    }
+
+    pthread_mutex_init( &displayBusy, NULL );
+    pthread_create( &thread, NULL, displayWall, (void *) &wall );
+
+    // Post a new counter to every display every tick.
+    for ( frame = 0; frame < WALL_SECONDS * 1000000 / WALL_TICK; frame++ )
+    {
+        for ( i = 0; i < displays; i++ )
+        {
+            snprintf( buffer, sizeof( buffer ), "Frame %10u", frame );
+            hd44780Post( &compositor[i], region[i], buffer, strlen( buffer ));
+        }
+        usleep( WALL_TICK );
+    }
+
+    hd44780WallStop( &wall );
+    pthread_join( thread, NULL );
+
+    for ( i = 0; i < displays; i++ )
+        hd44780Clear( mcp23017[i], &display[i] );
+
+    pthread_mutex_destroy( &displayBusy );
+
+    return 0;
+}
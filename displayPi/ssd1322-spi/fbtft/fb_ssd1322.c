@@ -103,39 +103,109 @@ static int blank(struct fbtft_par *par, bool on)
 #define CYG     601    /* 2.348 */
 #define CYB     233    /* 0.912 */
 
-static unsigned int rgb565_to_y(unsigned int rgb)
+/*
+	RGB565 to luminance lookup tables.
+
+	Y = CYR * R + CYG * G + CYB * B fits in 16 bits and the top nibble is
+	the 4-bit grey level. The sum is split by byte of the RGB565 value:
+
+		high byte = RRRRRGGG, low byte = GGGBBBBB
+
+	so Y = lut_hi[rgb >> 8] + lut_lo[rgb & 0xFF], i.e. two loads and an add
+	per pixel instead of three multiplies. Both tables together are 1K and
+	stay in the L1 cache.
+*/
+#define Y_HI(h) (CYR * ((h) >> 3) + CYG * (((h) & 0x07) << 3))
+#define Y_LO(l) (CYG * ((l) >> 5) + CYB * ((l) & 0x1F))
+
+#define LUT8(f, i)  f(i), f((i) + 1), f((i) + 2), f((i) + 3), \
+		    f((i) + 4), f((i) + 5), f((i) + 6), f((i) + 7)
+#define LUT64(f, i) LUT8(f, i), LUT8(f, (i) + 8), LUT8(f, (i) + 16), \
+		    LUT8(f, (i) + 24), LUT8(f, (i) + 32), LUT8(f, (i) + 40), \
+		    LUT8(f, (i) + 48), LUT8(f, (i) + 56)
+#define LUT256(f)   LUT64(f, 0), LUT64(f, 64), LUT64(f, 128), LUT64(f, 192)
+
+static const u16 lut_hi[256] = { LUT256(Y_HI) };
+static const u16 lut_lo[256] = { LUT256(Y_LO) };
+
+static inline unsigned int rgb565_to_y(u16 rgb)
 {
-	rgb = cpu_to_le16(rgb);
-	return CYR * (rgb >> 11) + CYG * (rgb >> 5 & 0x3F) + CYB * (rgb & 0x1F);
+	return lut_hi[rgb >> 8] + lut_lo[rgb & 0xFF];
+}
+
+/*
+	Optional native 8-bit grey framebuffer (bpp = <8> in the overlay).
+	Each byte is one pixel and only the top nibble is used, so no colour
+	conversion is needed at all.
+*/
+static int verify_gpios(struct fbtft_par *par)
+{
+	struct fb_var_screeninfo *var = &par->info->var;
+
+	fbtft_par_dbg(DEBUG_VERIFY_GPIOS, par, "%s()\n", __func__);
+
+	if (par->gpio.dc < 0) {
+		dev_err(par->info->device,
+			"Missing info about 'dc' gpio. Aborting.\n");
+		return -EINVAL;
+	}
+
+	if (var->bits_per_pixel == 8) {
+		var->grayscale = 1;
+		var->red.offset = var->green.offset = var->blue.offset = 0;
+		var->red.length = var->green.length = var->blue.length = 8;
+		par->info->fix.visual = FB_VISUAL_STATIC_PSEUDOCOLOR;
+	}
+
+	return 0;
 }
 
+/*
+	offset and len are the dirty rows from deferred IO (fbtft_update_display
+	has already set the address window to the same rows). Only those rows
+	are converted and sent.
+*/
 static int write_vmem(struct fbtft_par *par, size_t offset, size_t len)
 {
-	u16 *vmem16 = (u16 *)(par->info->screen_base);
 	u8 *buf = par->txbuf.buf;
-	int y, x, bl_height, bl_width;
+	unsigned int line_length = par->info->fix.line_length;
+	unsigned int bl_width = par->info->var.xres;
+	unsigned int bl_height, y, x;
 	int ret = 0;
 
-	/* Set data line beforehand */
-	gpio_set_value(par->gpio.dc, 1);
-
-	/* convert offset to word index from byte index */
-	offset /= 2;
-	bl_width = par->info->var.xres;
-	bl_height = len / par->info->fix.line_length;
+	/* Only whole rows are sent, clamped to the visible area */
+	bl_height = DIV_ROUND_UP(offset % line_length + len, line_length);
+	offset -= offset % line_length;
+	if (offset / line_length + bl_height > par->info->var.yres)
+		bl_height = par->info->var.yres - offset / line_length;
 
 	fbtft_par_dbg(DEBUG_WRITE_VMEM, par,
-		"%s(offset=0x%x bl_width=%d bl_height=%d)\n", __func__, offset, bl_width, bl_height);
+		"%s(offset=0x%zx bl_width=%d bl_height=%d)\n", __func__, offset, bl_width, bl_height);
 
-	for (y = 0; y < bl_height; y++) {
-		for (x = 0; x < bl_width / 2; x++) {
-			*buf = cpu_to_le16(rgb565_to_y(vmem16[offset++])) >> 8 & 0xF0;
-			*buf++ |= cpu_to_le16(rgb565_to_y(vmem16[offset++])) >> 12;
+	if (par->info->var.bits_per_pixel == 8) {
+		u8 *vmem8 = (u8 *)(par->info->screen_base + offset);
+
+		for (y = 0; y < bl_height; y++) {
+			for (x = 0; x < bl_width; x += 2)
+				*buf++ = (vmem8[x] & 0xF0) | (vmem8[x + 1] >> 4);
+			vmem8 += line_length;
+		}
+	} else {
+		u16 *vmem16 = (u16 *)(par->info->screen_base + offset);
+
+		for (y = 0; y < bl_height; y++) {
+			for (x = 0; x < bl_width; x += 2)
+				*buf++ = (rgb565_to_y(vmem16[x]) >> 8 & 0xF0) |
+					 rgb565_to_y(vmem16[x + 1]) >> 12;
+			vmem16 += line_length / 2;
 		}
 	}
 
+	/* Set data line beforehand */
+	gpio_set_value(par->gpio.dc, 1);
+
 	/* Write data */
-	ret = par->fbtftops.write(par, par->txbuf.buf, bl_width/2*bl_height);
+	ret = par->fbtftops.write(par, par->txbuf.buf, bl_width / 2 * bl_height);
 	if (ret < 0)
 		dev_err(par->info->device, "%s: write failed and returned: %d\n", __func__, ret);
 
@@ -156,6 +226,7 @@ static struct fbtft_display display = {
 		.set_addr_win  = set_addr_win,
 		.blank = blank,
 		.set_gamma = set_gamma,
+		.verify_gpios = verify_gpios,
 	},
 };
 
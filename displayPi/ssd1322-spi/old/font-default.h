@@ -0,0 +1,1026 @@
+/*
+    Font default, generated by fontconvert from unpacked.txt.
+*/
+
+#ifndef FONT_DEFAULT_H
+#define FONT_DEFAULT_H
+
+#include "ssd1322-font.h"
+
+static const uint8_t font_default_bitmap[] =
+{
+    // ' '
+    // '!'
+    0xff,0xff,0xff,0xff,0xff,0x00,0xff,
+    // '"'
+    0xff,0x00,0xff,0xff,0x00,0xff,0xff,0x00,0xff,
+    // '#'
+    0x0f,0xf0,0x0f,0xf0,0x0f,0xf0,0x0f,0xf0,0xff,0xff,0xff,0xff,0x0f,0xf0,0x0f,0xf0,
+    0xff,0xff,0xff,0xff,0x0f,0xf0,0x0f,0xf0,0x0f,0xf0,0x0f,0xf0,
+    // '$'
+    0x00,0x0f,0xf0,0x00,0x0f,0xff,0xff,0xf0,0xff,0x0f,0xf0,0x00,0x00,0xff,0xff,0x00,
+    0x00,0x0f,0xf0,0xff,0x0f,0xff,0xff,0xf0,0x00,0x0f,0xf0,0x00,
+    // '%'
+    0x0f,0xf0,0x00,0xff,0xff,0xff,0x0f,0xf0,0x0f,0xf0,0xff,0x00,0x00,0x0f,0xf0,0x00,
+    0x00,0xff,0x0f,0xf0,0x0f,0xf0,0xff,0xff,0xff,0x00,0x0f,0xf0,
+    // '&'
+    0x0f,0xff,0xff,0x00,0xff,0x00,0x0f,0xf0,0xff,0x00,0x0f,0xf0,0x0f,0xff,0xf0,0x00,
+    0xff,0x00,0xff,0xff,0xff,0x00,0x0f,0xf0,0x0f,0xff,0xff,0xff,
+    // '''
+    0x0f,0xff,0x0f,0xf0,0xff,0x00,
+    // '('
+    0x00,0xff,0x0f,0xf0,0xff,0x00,0xff,0x00,0xff,0x00,0x0f,0xf0,0x00,0xff,
+    // ')'
+    0xff,0x00,0x0f,0xf0,0x00,0xff,0x00,0xff,0x00,0xff,0x0f,0xf0,0xff,0x00,
+    // '*'
+    0x0f,0xf0,0x0f,0xf0,0x00,0xff,0xff,0x00,0xff,0xff,0xff,0xff,0x00,0xff,0xff,0x00,
+    0x0f,0xf0,0x0f,0xf0,
+    // '+'
+    0x00,0x0f,0xf0,0x00,0x00,0x0f,0xf0,0x00,0xff,0xff,0xff,0xff,0x00,0x0f,0xf0,0x00,
+    0x00,0x0f,0xf0,0x00,
+    // ','
+    0x0f,0xff,0x0f,0xf0,0xff,0x00,
+    // '-'
+    0xff,0xff,0xff,0xff,
+    // '.'
+    0xff,0xff,
+    // '/'
+    0x00,0x00,0x00,0xff,0x00,0x00,0x0f,0xf0,0x00,0x00,0xff,0x00,0x00,0x0f,0xf0,0x00,
+    0x00,0xff,0x00,0x00,0x0f,0xf0,0x00,0x00,0xff,0x00,0x00,0x00,
+    // '0'
+    0x00,0xff,0xff,0x00,0xff,0x00,0x00,0xff,0xff,0x00,0x0f,0xff,0xff,0x0f,0xf0,0xff,
+    0xff,0xf0,0x00,0xff,0xff,0x00,0x00,0xff,0x00,0xff,0xff,0x00,
+    // '1'
+    0x00,0xff,0x00,0x0f,0xff,0x00,0xff,0xff,0x00,0x00,0xff,0x00,0x00,0xff,0x00,0x00,
+    0xff,0x00,0xff,0xff,0xff,
+    // '2'
+    0x0f,0xff,0xff,0x00,0xff,0x00,0x0f,0xf0,0x00,0x00,0x0f,0xf0,0x00,0xff,0xf0,0x00,
+    0x0f,0xf0,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0xff,0xff,0xf0,
+    // '3'
+    0xff,0xff,0xff,0xff,0x00,0x00,0x0f,0xf0,0x00,0x00,0xff,0x00,0x00,0x0f,0xff,0xf0,
+    0x00,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0xf0,
+    // '4'
+    0x00,0x00,0xff,0xf0,0x00,0x0f,0xff,0xf0,0x00,0xff,0x0f,0xf0,0x0f,0xf0,0x0f,0xf0,
+    0xff,0xff,0xff,0xff,0x00,0x00,0x0f,0xf0,0x00,0x00,0x0f,0xf0,
+    // '5'
+    0xff,0xff,0xff,0xff,0x0f,0xf0,0x00,0x00,0xff,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,
+    0x00,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0xf0,
+    // '6'
+    0x0f,0xff,0xff,0xf0,0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0x0f,0xff,0xf0,
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0xf0,
+    // '7'
+    0xff,0xff,0xff,0xff,0x00,0x00,0x00,0xff,0x0f,0xf0,0x0f,0xf0,0x00,0x0f,0xff,0x00,
+    0x00,0x0f,0xf0,0xff,0x00,0xff,0x00,0x00,0x00,0xff,0x00,0x00,
+    // '8'
+    0x00,0xff,0xff,0x00,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0xff,
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x00,0xff,0xff,0x00,
+    // '9'
+    0x0f,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xf0,0xff,
+    0x00,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0x0f,0xff,0xff,0xf0,
+    // ':'
+    0xff,0xff,0x00,0x00,0xff,0xff,
+    // ';'
+    0x0f,0xf0,0x0f,0xf0,0x00,0x00,0x0f,0xff,0x0f,0xf0,0xff,0x00,
+    // '<'
+    0x00,0x00,0x00,0xff,0x00,0x00,0xff,0x00,0x00,0xff,0x00,0x00,0xff,0x00,0x00,0x00,
+    0x00,0xff,0x00,0x00,0x00,0x00,0xff,0x00,0x00,0x00,0x00,0xff,
+    // '='
+    0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,
+    // '>'
+    0xff,0x00,0x00,0x00,0x00,0xff,0x00,0x00,0x00,0x00,0xff,0x00,0x00,0x00,0x00,0xff,
+    0x00,0x00,0xff,0x00,0x00,0xff,0x00,0x00,0xff,0x00,0x00,0x00,
+    // '?'
+    0x0f,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,0x00,0x0f,0xff,0xf0,0x00,0x0f,0xf0,0x00,
+    0x00,0x0f,0xf0,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0xf0,0x00,
+    // '@'
+    0x0f,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,0xff,0x0f,0xff,0xff,0xff,0xff,0x0f,0xff,
+    0xff,0x0f,0xff,0xff,0xff,0x00,0x00,0x00,0x0f,0xff,0xff,0xf0,
+    // 'A'
+    0x00,0x0f,0xf0,0x00,0x00,0xff,0xff,0x00,0x0f,0xf0,0x0f,0xf0,0xff,0x00,0x00,0xff,
+    0xff,0xff,0xff,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,
+    // 'B'
+    0xff,0xff,0xff,0xf0,0x0f,0xf0,0x00,0xff,0x0f,0xf0,0x00,0xff,0x0f,0xff,0xff,0xf0,
+    0x0f,0xf0,0x00,0xff,0x0f,0xf0,0x00,0xff,0xff,0xff,0xff,0xf0,
+    // 'C'
+    0x00,0xff,0xff,0xf0,0x0f,0xf0,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,
+    0xff,0x00,0x00,0x00,0x0f,0xf0,0x00,0x00,0x00,0xff,0xff,0xf0,
+    // 'D'
+    0xff,0xff,0xff,0x00,0x0f,0xf0,0x0f,0xf0,0x0f,0xf0,0x00,0xff,0x0f,0xf0,0x00,0xff,
+    0x0f,0xf0,0x00,0xff,0x0f,0xf0,0x0f,0xf0,0xff,0xff,0xff,0x00,
+    // 'E'
+    0xff,0xff,0xff,0xff,0x00,0x00,0xff,0x00,0x00,0xff,0xff,0x00,0xff,0x00,0x00,0xff,
+    0x00,0x00,0xff,0xff,0xff,
+    // 'F'
+    0xff,0xff,0xff,0xff,0x00,0x00,0xff,0x00,0x00,0xff,0xff,0x00,0xff,0x00,0x00,0xff,
+    0x00,0x00,0xff,0x00,0x00,
+    // 'G'
+    0x00,0xff,0xff,0xf0,0x0f,0xf0,0x00,0xff,0xff,0x00,0x00,0x00,0xff,0x00,0x0f,0xff,
+    0xff,0x00,0x00,0xff,0x0f,0xf0,0x00,0xff,0x00,0xff,0xff,0xf0,
+    // 'H'
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0xff,0xff,0xff,
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,
+    // 'I'
+    0xff,0xff,0x0f,0xf0,0x0f,0xf0,0x0f,0xf0,0x0f,0xf0,0x0f,0xf0,0xff,0xff,
+    // 'J'
+    0x00,0x0f,0xff,0xf0,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0x00,
+    0x00,0x00,0xff,0x00,0xff,0x00,0xff,0x00,0x0f,0xff,0xf0,0x00,
+    // 'K'
+    0xff,0x00,0x00,0xff,0xff,0x00,0x0f,0xf0,0xff,0x00,0xff,0x00,0xff,0xff,0xf0,0x00,
+    0xff,0x00,0xff,0x00,0xff,0x00,0x0f,0xf0,0xff,0x00,0x00,0xff,
+    // 'L'
+    0xff,0x00,0x00,0xff,0x00,0x00,0xff,0x00,0x00,0xff,0x00,0x00,0xff,0x00,0x00,0xff,
+    0x00,0x00,0xff,0xff,0xff,
+    // 'M'
+    0xff,0x00,0x00,0xff,0xff,0xf0,0x0f,0xff,0xff,0xff,0xff,0xff,0xff,0x0f,0xf0,0xff,
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,
+    // 'N'
+    0xff,0x00,0x00,0xff,0xff,0xf0,0x00,0xff,0xff,0xff,0x00,0xff,0xff,0x0f,0xf0,0xff,
+    0xff,0x00,0xff,0xff,0xff,0x00,0x0f,0xff,0xff,0x00,0x00,0xff,
+    // 'O'
+    0x0f,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0xf0,
+    // 'P'
+    0xff,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0xff,0xff,0xf0,
+    0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,
+    // 'Q'
+    0x0f,0xff,0xff,0x00,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,
+    0xff,0x00,0xff,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0xff,
+    // 'R'
+    0xff,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0xff,0xff,0xf0,
+    0xff,0x00,0xff,0x00,0xff,0x00,0x0f,0xf0,0xff,0x00,0x00,0xff,
+    // 'S'
+    0x0f,0xff,0xff,0x00,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0x00,0x0f,0xff,0xff,0xf0,
+    0x00,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0x00,
+    // 'T'
+    0xff,0xff,0xff,0xff,0x00,0x0f,0xf0,0x00,0x00,0x0f,0xf0,0x00,0x00,0x0f,0xf0,0x00,
+    0x00,0x0f,0xf0,0x00,0x00,0x0f,0xf0,0x00,0x00,0x0f,0xf0,0x00,
+    // 'U'
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0xf0,
+    // 'V'
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,
+    0xff,0x00,0x00,0xff,0x0f,0xf0,0x0f,0xf0,0x00,0x0f,0xf0,0x00,
+    // 'W'
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x0f,0xf0,0xff,
+    0xff,0x0f,0xf0,0xff,0x0f,0xff,0xff,0xf0,0x0f,0xf0,0x0f,0xf0,
+    // 'X'
+    0xff,0x00,0x00,0xff,0x0f,0xf0,0x0f,0xf0,0x00,0xff,0xff,0x00,0x00,0x0f,0xf0,0x00,
+    0x00,0xff,0xff,0x00,0x0f,0xf0,0x0f,0xf0,0xff,0x00,0x00,0xff,
+    // 'Y'
+    0xff,0x00,0x00,0xff,0x0f,0xf0,0x0f,0xf0,0x00,0xff,0xff,0x00,0x00,0x0f,0xf0,0x00,
+    0x00,0x0f,0xf0,0x00,0x00,0x0f,0xf0,0x00,0x00,0x0f,0xf0,0x00,
+    // 'Z'
+    0xff,0xff,0xff,0xff,0x00,0x00,0x0f,0xf0,0x00,0x00,0xff,0x00,0x00,0x0f,0xf0,0x00,
+    0x00,0xff,0x00,0x00,0x0f,0xf0,0x00,0x00,0xff,0xff,0xff,0xff,
+    // '['
+    0xff,0xff,0xf0,0xff,0x00,0x00,0xff,0x00,0x00,0xff,0x00,0x00,0xff,0x00,0x00,0xff,
+    0x00,0x00,0xff,0xff,0xf0,
+    // '\'
+    0xff,0x00,0x00,0x00,0x0f,0xf0,0x00,0x00,0x00,0xff,0x00,0x00,0x00,0x0f,0xf0,0x00,
+    0x00,0x00,0xff,0x00,0x00,0x00,0x0f,0xf0,0x00,0x00,0x00,0xff,
+    // ']'
+    0xff,0xff,0xf0,0x00,0x0f,0xf0,0x00,0x0f,0xf0,0x00,0x0f,0xf0,0x00,0x0f,0xf0,0x00,
+    0x0f,0xf0,0xff,0xff,0xf0,
+    // '^'
+    0x00,0x0f,0xf0,0x00,0x00,0xff,0xff,0x00,0x0f,0xf0,0x0f,0xf0,0xff,0x00,0x00,0xff,
+    // '_'
+    0xff,0xff,0xff,0xff,
+    // '`'
+    0xff,0xf0,0x0f,0xf0,0x00,0xff,
+    // 'a'
+    0x0f,0xff,0xff,0xf0,0x00,0x00,0x00,0xff,0x0f,0xff,0xff,0xff,0xff,0x00,0x00,0xff,
+    0x0f,0xff,0xff,0xff,
+    // 'b'
+    0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0xff,0xff,0xf0,
+    // 'c'
+    0x0f,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0x00,0xff,0x00,0x00,0xff,
+    0x0f,0xff,0xff,0xf0,
+    // 'd'
+    0x00,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0x0f,0xff,0xff,0xff,0xff,0x00,0x00,0xff,
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0xff,
+    // 'e'
+    0x0f,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x00,0x00,
+    0x0f,0xff,0xff,0xf0,
+    // 'f'
+    0x00,0xff,0xff,0x00,0x0f,0xf0,0x0f,0xf0,0x0f,0xf0,0x00,0x00,0xff,0xff,0xf0,0x00,
+    0x0f,0xf0,0x00,0x00,0x0f,0xf0,0x00,0x00,0x0f,0xf0,0x00,0x00,
+    // 'g'
+    0x0f,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0xff,
+    0x00,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0xf0,
+    // 'h'
+    0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0xff,0xff,0xf0,0xff,0xf0,0x0f,0xff,
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,
+    // 'i'
+    0x00,0xff,0x00,0x00,0x00,0x00,0x0f,0xff,0x00,0x00,0xff,0x00,0x00,0xff,0x00,0x00,
+    0xff,0x00,0xff,0xff,0xff,
+    // 'j'
+    0x00,0x00,0x00,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0xff,0x00,0x00,0x00,0xff,
+    0x00,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,
+    0x0f,0xff,0xff,0xf0,
+    // 'k'
+    0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0x00,0x00,0xff,0xff,0x00,0xff,0x00,
+    0xff,0xff,0x00,0x00,0xff,0x00,0xff,0x00,0xff,0x00,0x00,0xff,
+    // 'l'
+    0xff,0xf0,0x0f,0xf0,0x0f,0xf0,0x0f,0xf0,0x0f,0xf0,0x0f,0xf0,0xff,0xff,
+    // 'm'
+    0x0f,0xf0,0x0f,0xf0,0xff,0xff,0xff,0xff,0xff,0x0f,0xf0,0xff,0xff,0x0f,0xf0,0xff,
+    0xff,0x00,0x00,0xff,
+    // 'n'
+    0x0f,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,
+    0xff,0x00,0x00,0xff,
+    // 'o'
+    0x0f,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,
+    0x0f,0xff,0xff,0xf0,
+    // 'p'
+    0xff,0xff,0xff,0xf0,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0xff,0xff,0xf0,
+    0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,
+    // 'q'
+    0x0f,0xff,0xff,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0xff,
+    0x00,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,0xff,
+    // 'r'
+    0x0f,0xff,0xff,0x00,0xff,0x00,0x0f,0xf0,0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,
+    0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,0xff,0x00,0x00,0x00,
+    // 's'
+    0x0f,0xff,0xff,0xf0,0xff,0x00,0x00,0x00,0x0f,0xff,0xff,0xf0,0x00,0x00,0x00,0xff,
+    0x0f,0xff,0xff,0xf0,
+    // 't'
+    0x00,0xff,0x00,0x00,0x00,0xff,0x00,0x00,0xff,0xff,0xff,0x00,0x00,0xff,0x00,0x00,
+    0x00,0xff,0x00,0x00,0x00,0xff,0x00,0xff,0x00,0x0f,0xff,0xf0,
+    // 'u'
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,
+    0x0f,0xff,0xff,0xf0,
+    // 'v'
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xf0,0x0f,0xf0,
+    0x00,0xff,0xff,0x00,
+    // 'w'
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x0f,0xf0,0xff,0xff,0xff,0xff,0xff,
+    0x0f,0xf0,0x0f,0xf0,
+    // 'x'
+    0xff,0x00,0x00,0xff,0x0f,0xf0,0x0f,0xf0,0x00,0xff,0xff,0x00,0x0f,0xf0,0x0f,0xf0,
+    0xff,0x00,0x00,0xff,
+    // 'y'
+    0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0xff,0x00,0x00,0xff,
+    0x0f,0xff,0xff,0xff,0x00,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0xf0,
+    // 'z'
+    0xff,0xff,0xff,0xff,0x00,0x00,0xff,0xf0,0x00,0xff,0x00,0x00,0xff,0x00,0x00,0x00,
+    0x00,0x0f,0xff,0x00,0x00,0x00,0x00,0xff,0xff,0x00,0x00,0xff,0x0f,0xff,0xff,0xf0,
+    // '{'
+    0x00,0x0f,0xff,0x0f,0xf0,0x00,0x00,0xff,0x00,0xff,0x00,0x00,0x00,0xff,0x00,0x0f,
+    0xf0,0x00,0x00,0x0f,0xff,
+    // '|'
+    0xff,0xf0,0x00,0x00,0x0f,0xf0,0x00,0xff,0x00,0x00,0x00,0xff,0x00,0xff,0x00,0x00,
+    0x0f,0xf0,0xff,0xf0,0x00,
+    // '}'
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    // '~'
+    0x0f,0xff,0x00,0xff,0xff,0x0f,0xf0,0xff,0xff,0x00,0xff,0xf0,
+    0x00
+};
+
+static const struct ssd1322_kern font_default_kern[] =
+{
+    { 108, -1 }, // '!' 'l'
+    {  47, -1 }, // '"' '/'
+    {  74, -1 }, // '"' 'J'
+    { 105, -1 }, // '"' 'i'
+    { 106, -1 }, // '"' 'j'
+    { 108, -1 }, // '"' 'l'
+    { 105, -1 }, // '#' 'i'
+    { 108, -1 }, // '#' 'l'
+    { 105, -1 }, // '$' 'i'
+    { 108, -1 }, // '$' 'l'
+    { 102, -1 }, // '%' 'f'
+    { 108, -1 }, // '%' 'l'
+    { 108, -1 }, // '&' 'l'
+    {  43, -1 }, // ''' '+'
+    {  45, -1 }, // ''' '-'
+    {  47, -1 }, // ''' '/'
+    {  52, -1 }, // ''' '4'
+    {  59, -1 }, // ''' ';'
+    {  60, -1 }, // ''' '<'
+    {  65, -1 }, // ''' 'A'
+    {  74, -1 }, // ''' 'J'
+    {  94, -1 }, // ''' '^'
+    {  97, -1 }, // ''' 'a'
+    {  99, -1 }, // ''' 'c'
+    { 100, -1 }, // ''' 'd'
+    { 101, -1 }, // ''' 'e'
+    { 102, -1 }, // ''' 'f'
+    { 103, -1 }, // ''' 'g'
+    { 105, -1 }, // ''' 'i'
+    { 106, -1 }, // ''' 'j'
+    { 108, -1 }, // ''' 'l'
+    { 109, -1 }, // ''' 'm'
+    { 110, -1 }, // ''' 'n'
+    { 111, -1 }, // ''' 'o'
+    { 113, -1 }, // ''' 'q'
+    { 114, -1 }, // ''' 'r'
+    { 115, -1 }, // ''' 's'
+    {  43, -1 }, // '(' '+'
+    {  45, -1 }, // '(' '-'
+    {  60, -1 }, // '(' '<'
+    {  94, -1 }, // '(' '^'
+    { 102, -1 }, // '(' 'f'
+    { 108, -1 }, // '(' 'l'
+    { 105, -1 }, // ')' 'i'
+    { 108, -1 }, // ')' 'l'
+    {  44, -1 }, // '*' ','
+    { 105, -1 }, // '*' 'i'
+    { 108, -1 }, // '*' 'l'
+    {  41, -1 }, // '+' ')'
+    {  44, -1 }, // '+' ','
+    {  47, -1 }, // '+' '/'
+    {  51, -1 }, // '+' '3'
+    {  62, -1 }, // '+' '>'
+    {  63, -1 }, // '+' '?'
+    {  74, -1 }, // '+' 'J'
+    {  84, -1 }, // '+' 'T'
+    {  88, -1 }, // '+' 'X'
+    {  89, -1 }, // '+' 'Y'
+    {  90, -1 }, // '+' 'Z'
+    {  92, -1 }, // '+' '\'
+    {  93, -1 }, // '+' ']'
+    {  95, -1 }, // '+' '_'
+    {  96, -1 }, // '+' '`'
+    { 105, -1 }, // '+' 'i'
+    { 106, -1 }, // '+' 'j'
+    { 108, -1 }, // '+' 'l'
+    { 124, -1 }, // '+' '|'
+    {  43, -1 }, // ',' '+'
+    {  55, -1 }, // ',' '7'
+    {  60, -1 }, // ',' '<'
+    {  63, -1 }, // ',' '?'
+    {  84, -1 }, // ',' 'T'
+    {  89, -1 }, // ',' 'Y'
+    {  92, -1 }, // ',' '\'
+    { 102, -1 }, // ',' 'f'
+    { 108, -1 }, // ',' 'l'
+    { 116, -1 }, // ',' 't'
+    {  41, -1 }, // '-' ')'
+    {  47, -1 }, // '-' '/'
+    {  51, -1 }, // '-' '3'
+    {  62, -1 }, // '-' '>'
+    {  63, -1 }, // '-' '?'
+    {  74, -1 }, // '-' 'J'
+    {  84, -1 }, // '-' 'T'
+    {  88, -1 }, // '-' 'X'
+    {  89, -1 }, // '-' 'Y'
+    {  90, -1 }, // '-' 'Z'
+    {  92, -1 }, // '-' '\'
+    {  93, -1 }, // '-' ']'
+    {  96, -1 }, // '-' '`'
+    { 105, -1 }, // '-' 'i'
+    { 106, -1 }, // '-' 'j'
+    { 108, -1 }, // '-' 'l'
+    { 124, -1 }, // '-' '|'
+    {  55, -1 }, // '.' '7'
+    {  63, -1 }, // '.' '?'
+    {  84, -1 }, // '.' 'T'
+    {  89, -1 }, // '.' 'Y'
+    {  92, -1 }, // '.' '\'
+    { 108, -1 }, // '.' 'l'
+    { 116, -1 }, // '.' 't'
+    {  43, -1 }, // '/' '+'
+    {  44, -1 }, // '/' ','
+    {  45, -1 }, // '/' '-'
+    {  46, -1 }, // '/' '.'
+    {  47, -1 }, // '/' '/'
+    {  52, -1 }, // '/' '4'
+    {  59, -1 }, // '/' ';'
+    {  60, -1 }, // '/' '<'
+    {  65, -1 }, // '/' 'A'
+    {  74, -1 }, // '/' 'J'
+    {  94, -1 }, // '/' '^'
+    {  95, -1 }, // '/' '_'
+    {  97, -1 }, // '/' 'a'
+    {  99, -1 }, // '/' 'c'
+    { 100, -1 }, // '/' 'd'
+    { 101, -1 }, // '/' 'e'
+    { 102, -1 }, // '/' 'f'
+    { 103, -1 }, // '/' 'g'
+    { 105, -1 }, // '/' 'i'
+    { 106, -1 }, // '/' 'j'
+    { 108, -1 }, // '/' 'l'
+    { 109, -1 }, // '/' 'm'
+    { 110, -1 }, // '/' 'n'
+    { 111, -1 }, // '/' 'o'
+    { 113, -1 }, // '/' 'q'
+    { 114, -1 }, // '/' 'r'
+    { 115, -1 }, // '/' 's'
+    { 108, -1 }, // '0' 'l'
+    {  34, -1 }, // '1' '"'
+    {  39, -1 }, // '1' '''
+    {  43, -1 }, // '1' '+'
+    {  45, -1 }, // '1' '-'
+    {  52, -1 }, // '1' '4'
+    {  55, -1 }, // '1' '7'
+    {  60, -1 }, // '1' '<'
+    {  61, -1 }, // '1' '='
+    {  63, -1 }, // '1' '?'
+    {  84, -1 }, // '1' 'T'
+    {  89, -1 }, // '1' 'Y'
+    {  92, -1 }, // '1' '\'
+    {  94, -1 }, // '1' '^'
+    {  96, -1 }, // '1' '`'
+    { 102, -1 }, // '1' 'f'
+    { 108, -1 }, // '1' 'l'
+    { 116, -1 }, // '1' 't'
+    { 126, -1 }, // '1' '~'
+    { 108, -1 }, // '2' 'l'
+    { 108, -1 }, // '3' 'l'
+    { 105, -1 }, // '4' 'i'
+    { 108, -1 }, // '4' 'l'
+    { 108, -1 }, // '5' 'l'
+    { 108, -1 }, // '6' 'l'
+    {  95, -1 }, // '7' '_'
+    { 105, -1 }, // '7' 'i'
+    { 106, -1 }, // '7' 'j'
+    { 108, -1 }, // '7' 'l'
+    { 108, -1 }, // '8' 'l'
+    { 108, -1 }, // '9' 'l'
+    { 108, -1 }, // ':' 'l'
+    {  55, -1 }, // ';' '7'
+    {  84, -1 }, // ';' 'T'
+    {  89, -1 }, // ';' 'Y'
+    {  92, -1 }, // ';' '\'
+    {  96, -1 }, // ';' '`'
+    { 102, -1 }, // ';' 'f'
+    { 108, -1 }, // ';' 'l'
+    {  43, -1 }, // '<' '+'
+    {  45, -1 }, // '<' '-'
+    {  52, -1 }, // '<' '4'
+    {  60, -1 }, // '<' '<'
+    {  61, -1 }, // '<' '='
+    {  94, -1 }, // '<' '^'
+    { 102, -1 }, // '<' 'f'
+    { 108, -1 }, // '<' 'l'
+    { 116, -1 }, // '<' 't'
+    {  62, -1 }, // '=' '>'
+    {  84, -1 }, // '=' 'T'
+    {  93, -1 }, // '=' ']'
+    { 105, -1 }, // '=' 'i'
+    { 106, -1 }, // '=' 'j'
+    { 108, -1 }, // '=' 'l'
+    { 124, -1 }, // '=' '|'
+    {  41, -1 }, // '>' ')'
+    {  44, -1 }, // '>' ','
+    {  47, -1 }, // '>' '/'
+    {  51, -1 }, // '>' '3'
+    {  62, -1 }, // '>' '>'
+    {  63, -1 }, // '>' '?'
+    {  74, -1 }, // '>' 'J'
+    {  84, -1 }, // '>' 'T'
+    {  88, -1 }, // '>' 'X'
+    {  89, -1 }, // '>' 'Y'
+    {  90, -1 }, // '>' 'Z'
+    {  92, -1 }, // '>' '\'
+    {  93, -1 }, // '>' ']'
+    {  95, -1 }, // '>' '_'
+    {  96, -1 }, // '>' '`'
+    { 105, -1 }, // '>' 'i'
+    { 106, -1 }, // '>' 'j'
+    { 108, -1 }, // '>' 'l'
+    { 124, -1 }, // '>' '|'
+    {  44, -1 }, // '?' ','
+    {  46, -1 }, // '?' '.'
+    {  47, -1 }, // '?' '/'
+    {  52, -1 }, // '?' '4'
+    {  74, -1 }, // '?' 'J'
+    {  95, -1 }, // '?' '_'
+    { 102, -1 }, // '?' 'f'
+    { 105, -1 }, // '?' 'i'
+    { 106, -1 }, // '?' 'j'
+    { 108, -1 }, // '?' 'l'
+    { 114, -1 }, // '?' 'r'
+    { 105, -1 }, // '@' 'i'
+    { 108, -1 }, // '@' 'l'
+    {  84, -1 }, // 'A' 'T'
+    {  89, -1 }, // 'A' 'Y'
+    {  92, -1 }, // 'A' '\'
+    {  96, -1 }, // 'A' '`'
+    { 108, -1 }, // 'A' 'l'
+    { 108, -1 }, // 'B' 'l'
+    {  43, -1 }, // 'C' '+'
+    {  45, -1 }, // 'C' '-'
+    {  52, -1 }, // 'C' '4'
+    {  60, -1 }, // 'C' '<'
+    {  61, -1 }, // 'C' '='
+    {  94, -1 }, // 'C' '^'
+    { 102, -1 }, // 'C' 'f'
+    { 108, -1 }, // 'C' 'l'
+    { 116, -1 }, // 'C' 't'
+    { 105, -1 }, // 'D' 'i'
+    { 108, -1 }, // 'D' 'l'
+    {  43, -1 }, // 'E' '+'
+    {  45, -1 }, // 'E' '-'
+    {  52, -1 }, // 'E' '4'
+    {  60, -1 }, // 'E' '<'
+    {  61, -1 }, // 'E' '='
+    {  94, -1 }, // 'E' '^'
+    { 102, -1 }, // 'E' 'f'
+    { 108, -1 }, // 'E' 'l'
+    { 116, -1 }, // 'E' 't'
+    {  43, -1 }, // 'F' '+'
+    {  44, -1 }, // 'F' ','
+    {  45, -1 }, // 'F' '-'
+    {  46, -1 }, // 'F' '.'
+    {  47, -1 }, // 'F' '/'
+    {  52, -1 }, // 'F' '4'
+    {  59, -1 }, // 'F' ';'
+    {  60, -1 }, // 'F' '<'
+    {  61, -1 }, // 'F' '='
+    {  65, -1 }, // 'F' 'A'
+    {  74, -1 }, // 'F' 'J'
+    {  94, -1 }, // 'F' '^'
+    {  95, -1 }, // 'F' '_'
+    {  97, -1 }, // 'F' 'a'
+    {  99, -1 }, // 'F' 'c'
+    { 100, -1 }, // 'F' 'd'
+    { 101, -1 }, // 'F' 'e'
+    { 102, -1 }, // 'F' 'f'
+    { 103, -1 }, // 'F' 'g'
+    { 105, -1 }, // 'F' 'i'
+    { 106, -1 }, // 'F' 'j'
+    { 108, -1 }, // 'F' 'l'
+    { 109, -1 }, // 'F' 'm'
+    { 110, -1 }, // 'F' 'n'
+    { 111, -1 }, // 'F' 'o'
+    { 112, -1 }, // 'F' 'p'
+    { 113, -1 }, // 'F' 'q'
+    { 114, -1 }, // 'F' 'r'
+    { 115, -1 }, // 'F' 's'
+    { 116, -1 }, // 'F' 't'
+    { 117, -1 }, // 'F' 'u'
+    { 118, -1 }, // 'F' 'v'
+    { 119, -1 }, // 'F' 'w'
+    { 120, -1 }, // 'F' 'x'
+    { 121, -1 }, // 'F' 'y'
+    { 122, -1 }, // 'F' 'z'
+    { 108, -1 }, // 'G' 'l'
+    { 108, -1 }, // 'H' 'l'
+    { 102, -1 }, // 'I' 'f'
+    { 108, -1 }, // 'I' 'l'
+    {  44, -1 }, // 'J' ','
+    {  59, -1 }, // 'J' ';'
+    { 102, -1 }, // 'J' 'f'
+    { 105, -1 }, // 'J' 'i'
+    { 108, -1 }, // 'J' 'l'
+    { 114, -1 }, // 'J' 'r'
+    {  43, -1 }, // 'K' '+'
+    {  45, -1 }, // 'K' '-'
+    {  60, -1 }, // 'K' '<'
+    {  94, -1 }, // 'K' '^'
+    { 102, -1 }, // 'K' 'f'
+    { 108, -1 }, // 'K' 'l'
+    {  34, -1 }, // 'L' '"'
+    {  39, -1 }, // 'L' '''
+    {  43, -1 }, // 'L' '+'
+    {  45, -1 }, // 'L' '-'
+    {  52, -1 }, // 'L' '4'
+    {  55, -1 }, // 'L' '7'
+    {  60, -1 }, // 'L' '<'
+    {  61, -1 }, // 'L' '='
+    {  63, -1 }, // 'L' '?'
+    {  84, -1 }, // 'L' 'T'
+    {  89, -1 }, // 'L' 'Y'
+    {  92, -1 }, // 'L' '\'
+    {  94, -1 }, // 'L' '^'
+    {  96, -1 }, // 'L' '`'
+    { 102, -1 }, // 'L' 'f'
+    { 108, -1 }, // 'L' 'l'
+    { 116, -1 }, // 'L' 't'
+    { 126, -1 }, // 'L' '~'
+    { 108, -1 }, // 'M' 'l'
+    { 108, -1 }, // 'N' 'l'
+    { 108, -1 }, // 'O' 'l'
+    {  44, -1 }, // 'P' ','
+    {  47, -1 }, // 'P' '/'
+    {  74, -1 }, // 'P' 'J'
+    {  95, -1 }, // 'P' '_'
+    { 105, -1 }, // 'P' 'i'
+    { 106, -1 }, // 'P' 'j'
+    { 108, -1 }, // 'P' 'l'
+    { 108, -1 }, // 'Q' 'l'
+    { 108, -1 }, // 'R' 'l'
+    { 108, -1 }, // 'S' 'l'
+    {  43, -1 }, // 'T' '+'
+    {  44, -1 }, // 'T' ','
+    {  45, -1 }, // 'T' '-'
+    {  46, -1 }, // 'T' '.'
+    {  47, -1 }, // 'T' '/'
+    {  52, -1 }, // 'T' '4'
+    {  59, -1 }, // 'T' ';'
+    {  60, -1 }, // 'T' '<'
+    {  61, -1 }, // 'T' '='
+    {  65, -1 }, // 'T' 'A'
+    {  74, -1 }, // 'T' 'J'
+    {  94, -1 }, // 'T' '^'
+    {  95, -1 }, // 'T' '_'
+    {  97, -1 }, // 'T' 'a'
+    {  99, -1 }, // 'T' 'c'
+    { 100, -1 }, // 'T' 'd'
+    { 101, -1 }, // 'T' 'e'
+    { 102, -1 }, // 'T' 'f'
+    { 103, -1 }, // 'T' 'g'
+    { 105, -1 }, // 'T' 'i'
+    { 106, -1 }, // 'T' 'j'
+    { 108, -1 }, // 'T' 'l'
+    { 109, -1 }, // 'T' 'm'
+    { 110, -1 }, // 'T' 'n'
+    { 111, -1 }, // 'T' 'o'
+    { 112, -1 }, // 'T' 'p'
+    { 113, -1 }, // 'T' 'q'
+    { 114, -1 }, // 'T' 'r'
+    { 115, -1 }, // 'T' 's'
+    { 116, -1 }, // 'T' 't'
+    { 117, -1 }, // 'T' 'u'
+    { 118, -1 }, // 'T' 'v'
+    { 119, -1 }, // 'T' 'w'
+    { 120, -1 }, // 'T' 'x'
+    { 121, -1 }, // 'T' 'y'
+    { 122, -1 }, // 'T' 'z'
+    { 108, -1 }, // 'U' 'l'
+    { 105, -1 }, // 'V' 'i'
+    { 108, -1 }, // 'V' 'l'
+    { 105, -1 }, // 'W' 'i'
+    { 108, -1 }, // 'W' 'l'
+    {  43, -1 }, // 'X' '+'
+    {  45, -1 }, // 'X' '-'
+    {  60, -1 }, // 'X' '<'
+    {  94, -1 }, // 'X' '^'
+    { 102, -1 }, // 'X' 'f'
+    { 108, -1 }, // 'X' 'l'
+    {  43, -1 }, // 'Y' '+'
+    {  44, -1 }, // 'Y' ','
+    {  45, -1 }, // 'Y' '-'
+    {  46, -1 }, // 'Y' '.'
+    {  47, -1 }, // 'Y' '/'
+    {  52, -1 }, // 'Y' '4'
+    {  59, -1 }, // 'Y' ';'
+    {  60, -1 }, // 'Y' '<'
+    {  65, -1 }, // 'Y' 'A'
+    {  74, -1 }, // 'Y' 'J'
+    {  94, -1 }, // 'Y' '^'
+    {  95, -1 }, // 'Y' '_'
+    {  97, -1 }, // 'Y' 'a'
+    {  99, -1 }, // 'Y' 'c'
+    { 100, -1 }, // 'Y' 'd'
+    { 101, -1 }, // 'Y' 'e'
+    { 102, -1 }, // 'Y' 'f'
+    { 103, -1 }, // 'Y' 'g'
+    { 105, -1 }, // 'Y' 'i'
+    { 106, -1 }, // 'Y' 'j'
+    { 108, -1 }, // 'Y' 'l'
+    { 109, -1 }, // 'Y' 'm'
+    { 110, -1 }, // 'Y' 'n'
+    { 111, -1 }, // 'Y' 'o'
+    { 113, -1 }, // 'Y' 'q'
+    { 114, -1 }, // 'Y' 'r'
+    { 115, -1 }, // 'Y' 's'
+    {  43, -1 }, // 'Z' '+'
+    {  45, -1 }, // 'Z' '-'
+    {  52, -1 }, // 'Z' '4'
+    {  60, -1 }, // 'Z' '<'
+    {  94, -1 }, // 'Z' '^'
+    { 102, -1 }, // 'Z' 'f'
+    { 108, -1 }, // 'Z' 'l'
+    {  43, -1 }, // '[' '+'
+    {  45, -1 }, // '[' '-'
+    {  52, -1 }, // '[' '4'
+    {  60, -1 }, // '[' '<'
+    {  61, -1 }, // '[' '='
+    {  94, -1 }, // '[' '^'
+    { 102, -1 }, // '[' 'f'
+    { 108, -1 }, // '[' 'l'
+    { 116, -1 }, // '[' 't'
+    {  34, -1 }, // '\' '"'
+    {  39, -1 }, // '\' '''
+    {  43, -1 }, // '\' '+'
+    {  45, -1 }, // '\' '-'
+    {  55, -1 }, // '\' '7'
+    {  60, -1 }, // '\' '<'
+    {  63, -1 }, // '\' '?'
+    {  84, -1 }, // '\' 'T'
+    {  89, -1 }, // '\' 'Y'
+    {  92, -1 }, // '\' '\'
+    {  94, -1 }, // '\' '^'
+    {  96, -1 }, // '\' '`'
+    { 102, -1 }, // '\' 'f'
+    { 108, -1 }, // '\' 'l'
+    { 116, -1 }, // '\' 't'
+    { 126, -1 }, // '\' '~'
+    { 108, -1 }, // ']' 'l'
+    {  41, -1 }, // '^' ')'
+    {  47, -1 }, // '^' '/'
+    {  51, -1 }, // '^' '3'
+    {  62, -1 }, // '^' '>'
+    {  74, -1 }, // '^' 'J'
+    {  84, -1 }, // '^' 'T'
+    {  88, -1 }, // '^' 'X'
+    {  89, -1 }, // '^' 'Y'
+    {  90, -1 }, // '^' 'Z'
+    {  92, -1 }, // '^' '\'
+    {  93, -1 }, // '^' ']'
+    {  96, -1 }, // '^' '`'
+    { 105, -1 }, // '^' 'i'
+    { 106, -1 }, // '^' 'j'
+    { 108, -1 }, // '^' 'l'
+    { 124, -1 }, // '^' '|'
+    {  43, -1 }, // '_' '+'
+    {  52, -1 }, // '_' '4'
+    {  55, -1 }, // '_' '7'
+    {  60, -1 }, // '_' '<'
+    {  63, -1 }, // '_' '?'
+    {  84, -1 }, // '_' 'T'
+    {  89, -1 }, // '_' 'Y'
+    {  92, -1 }, // '_' '\'
+    { 102, -1 }, // '_' 'f'
+    { 108, -1 }, // '_' 'l'
+    { 116, -1 }, // '_' 't'
+    {  47, -1 }, // '`' '/'
+    {  74, -1 }, // '`' 'J'
+    { 105, -1 }, // '`' 'i'
+    { 106, -1 }, // '`' 'j'
+    { 108, -1 }, // '`' 'l'
+    {  84, -1 }, // 'a' 'T'
+    {  89, -1 }, // 'a' 'Y'
+    {  92, -1 }, // 'a' '\'
+    {  96, -1 }, // 'a' '`'
+    { 108, -1 }, // 'a' 'l'
+    {  84, -1 }, // 'b' 'T'
+    {  89, -1 }, // 'b' 'Y'
+    {  92, -1 }, // 'b' '\'
+    {  96, -1 }, // 'b' '`'
+    { 108, -1 }, // 'b' 'l'
+    {  84, -1 }, // 'c' 'T'
+    {  89, -1 }, // 'c' 'Y'
+    {  92, -1 }, // 'c' '\'
+    {  96, -1 }, // 'c' '`'
+    { 108, -1 }, // 'c' 'l'
+    { 108, -1 }, // 'd' 'l'
+    {  84, -1 }, // 'e' 'T'
+    {  89, -1 }, // 'e' 'Y'
+    {  92, -1 }, // 'e' '\'
+    {  96, -1 }, // 'e' '`'
+    { 105, -1 }, // 'e' 'i'
+    { 108, -1 }, // 'e' 'l'
+    {  43, -1 }, // 'f' '+'
+    {  44, -1 }, // 'f' ','
+    {  45, -1 }, // 'f' '-'
+    {  46, -1 }, // 'f' '.'
+    {  47, -1 }, // 'f' '/'
+    {  52, -1 }, // 'f' '4'
+    {  60, -1 }, // 'f' '<'
+    {  74, -1 }, // 'f' 'J'
+    {  95, -1 }, // 'f' '_'
+    { 102, -1 }, // 'f' 'f'
+    { 105, -1 }, // 'f' 'i'
+    { 106, -1 }, // 'f' 'j'
+    { 108, -1 }, // 'f' 'l'
+    { 114, -1 }, // 'f' 'r'
+    {  84, -1 }, // 'g' 'T'
+    {  89, -1 }, // 'g' 'Y'
+    {  92, -1 }, // 'g' '\'
+    {  96, -1 }, // 'g' '`'
+    { 108, -1 }, // 'g' 'l'
+    {  84, -1 }, // 'h' 'T'
+    {  89, -1 }, // 'h' 'Y'
+    {  92, -1 }, // 'h' '\'
+    {  96, -1 }, // 'h' '`'
+    { 108, -1 }, // 'h' 'l'
+    {  34, -1 }, // 'i' '"'
+    {  39, -1 }, // 'i' '''
+    {  43, -1 }, // 'i' '+'
+    {  45, -1 }, // 'i' '-'
+    {  52, -1 }, // 'i' '4'
+    {  55, -1 }, // 'i' '7'
+    {  60, -1 }, // 'i' '<'
+    {  61, -1 }, // 'i' '='
+    {  63, -1 }, // 'i' '?'
+    {  84, -1 }, // 'i' 'T'
+    {  89, -1 }, // 'i' 'Y'
+    {  92, -1 }, // 'i' '\'
+    {  94, -1 }, // 'i' '^'
+    {  96, -1 }, // 'i' '`'
+    { 102, -1 }, // 'i' 'f'
+    { 108, -1 }, // 'i' 'l'
+    { 116, -1 }, // 'i' 't'
+    { 126, -1 }, // 'i' '~'
+    { 108, -1 }, // 'j' 'l'
+    {  84, -1 }, // 'k' 'T'
+    { 108, -1 }, // 'k' 'l'
+    { 102, -1 }, // 'l' 'f'
+    { 108, -1 }, // 'l' 'l'
+    {  84, -1 }, // 'm' 'T'
+    {  89, -1 }, // 'm' 'Y'
+    {  92, -1 }, // 'm' '\'
+    {  96, -1 }, // 'm' '`'
+    { 108, -1 }, // 'm' 'l'
+    {  84, -1 }, // 'n' 'T'
+    {  89, -1 }, // 'n' 'Y'
+    {  92, -1 }, // 'n' '\'
+    {  96, -1 }, // 'n' '`'
+    { 108, -1 }, // 'n' 'l'
+    {  84, -1 }, // 'o' 'T'
+    {  89, -1 }, // 'o' 'Y'
+    {  92, -1 }, // 'o' '\'
+    {  96, -1 }, // 'o' '`'
+    { 108, -1 }, // 'o' 'l'
+    {  84, -1 }, // 'p' 'T'
+    {  89, -1 }, // 'p' 'Y'
+    {  92, -1 }, // 'p' '\'
+    {  96, -1 }, // 'p' '`'
+    { 105, -1 }, // 'p' 'i'
+    { 108, -1 }, // 'p' 'l'
+    {  84, -1 }, // 'q' 'T'
+    { 108, -1 }, // 'q' 'l'
+    {  41, -1 }, // 'r' ')'
+    {  44, -1 }, // 'r' ','
+    {  47, -1 }, // 'r' '/'
+    {  51, -1 }, // 'r' '3'
+    {  62, -1 }, // 'r' '>'
+    {  74, -1 }, // 'r' 'J'
+    {  84, -1 }, // 'r' 'T'
+    {  88, -1 }, // 'r' 'X'
+    {  89, -1 }, // 'r' 'Y'
+    {  90, -1 }, // 'r' 'Z'
+    {  92, -1 }, // 'r' '\'
+    {  93, -1 }, // 'r' ']'
+    {  95, -1 }, // 'r' '_'
+    {  96, -1 }, // 'r' '`'
+    { 105, -1 }, // 'r' 'i'
+    { 106, -1 }, // 'r' 'j'
+    { 108, -1 }, // 'r' 'l'
+    { 124, -1 }, // 'r' '|'
+    {  55, -1 }, // 's' '7'
+    {  84, -1 }, // 's' 'T'
+    {  89, -1 }, // 's' 'Y'
+    {  92, -1 }, // 's' '\'
+    {  96, -1 }, // 's' '`'
+    { 102, -1 }, // 's' 'f'
+    { 108, -1 }, // 's' 'l'
+    {  34, -1 }, // 't' '"'
+    {  39, -1 }, // 't' '''
+    {  43, -1 }, // 't' '+'
+    {  45, -1 }, // 't' '-'
+    {  55, -1 }, // 't' '7'
+    {  60, -1 }, // 't' '<'
+    {  63, -1 }, // 't' '?'
+    {  84, -1 }, // 't' 'T'
+    {  89, -1 }, // 't' 'Y'
+    {  92, -1 }, // 't' '\'
+    {  94, -1 }, // 't' '^'
+    {  96, -1 }, // 't' '`'
+    { 102, -1 }, // 't' 'f'
+    { 108, -1 }, // 't' 'l'
+    { 116, -1 }, // 't' 't'
+    { 126, -1 }, // 't' '~'
+    {  84, -1 }, // 'u' 'T'
+    { 108, -1 }, // 'u' 'l'
+    {  84, -1 }, // 'v' 'T'
+    { 105, -1 }, // 'v' 'i'
+    { 108, -1 }, // 'v' 'l'
+    {  84, -1 }, // 'w' 'T'
+    { 108, -1 }, // 'w' 'l'
+    {  84, -1 }, // 'x' 'T'
+    { 108, -1 }, // 'x' 'l'
+    {  84, -1 }, // 'y' 'T'
+    { 108, -1 }, // 'y' 'l'
+    {  84, -1 }, // 'z' 'T'
+    { 108, -1 }, // 'z' 'l'
+    {  43, -1 }, // '{' '+'
+    {  45, -1 }, // '{' '-'
+    {  52, -1 }, // '{' '4'
+    {  60, -1 }, // '{' '<'
+    {  61, -1 }, // '{' '='
+    {  94, -1 }, // '{' '^'
+    { 102, -1 }, // '{' 'f'
+    { 108, -1 }, // '{' 'l'
+    { 116, -1 }, // '{' 't'
+    {  44, -1 }, // '|' ','
+    { 105, -1 }, // '|' 'i'
+    { 108, -1 }, // '|' 'l'
+    { 108, -1 }, // '}' 'l'
+    {  47, -1 }, // '~' '/'
+    {  52, -1 }, // '~' '4'
+    {  74, -1 }, // '~' 'J'
+    { 102, -1 }, // '~' 'f'
+    { 105, -1 }, // '~' 'i'
+    { 106, -1 }, // '~' 'j'
+    { 108, -1 }, // '~' 'l'
+    { 114, -1 }, // '~' 'r'
+    {   0,  0 }
+};
+
+static const struct ssd1322_glyph font_default_glyphs[] =
+{
+    {     0,  0,  0,  4,  0,   0,    0,  0 }, // ' '
+    {     0,  2,  7,  3,  0,  -7,    0,  1 }, // '!'
+    {     7,  6,  3,  7,  0,  -7,    1,  5 }, // '"'
+    {    16,  8,  7,  9,  0,  -7,    6,  2 }, // '#'
+    {    44,  8,  7,  9,  0,  -7,    8,  2 }, // '$'
+    {    72,  8,  7,  9,  0,  -7,   10,  2 }, // '%'
+    {   100,  8,  7,  9,  0,  -7,   12,  1 }, // '&'
+    {   128,  4,  3,  5,  0,  -7,   13, 24 }, // '''
+    {   134,  4,  7,  5,  0,  -7,   37,  6 }, // '('
+    {   148,  4,  7,  5,  0,  -7,   43,  2 }, // ')'
+    {   162,  8,  5,  9,  0,  -6,   45,  3 }, // '*'
+    {   182,  8,  5,  9,  0,  -6,   48, 19 }, // '+'
+    {   202,  4,  3,  5,  0,  -2,   67, 10 }, // ','
+    {   208,  8,  1,  9,  0,  -4,   77, 17 }, // '-'
+    {   212,  2,  2,  3,  0,  -3,   94,  7 }, // '.'
+    {   214,  8,  7,  9,  0,  -7,  101, 27 }, // '/'
+    {   242,  8,  7,  9,  0,  -7,  128,  1 }, // '0'
+    {   270,  6,  7,  7,  0,  -7,  129, 18 }, // '1'
+    {   291,  7,  7,  8,  0,  -7,  147,  1 }, // '2'
+    {   319,  8,  7,  9,  0,  -7,  148,  1 }, // '3'
+    {   347,  8,  7,  9,  0,  -7,  149,  2 }, // '4'
+    {   375,  8,  7,  9,  0,  -7,  151,  1 }, // '5'
+    {   403,  8,  7,  9,  0,  -7,  152,  1 }, // '6'
+    {   431,  8,  7,  9,  0,  -7,  153,  4 }, // '7'
+    {   459,  8,  7,  9,  0,  -7,  157,  1 }, // '8'
+    {   487,  8,  7,  9,  0,  -7,  158,  1 }, // '9'
+    {   515,  2,  6,  3,  0,  -6,  159,  1 }, // ':'
+    {   521,  4,  6,  5,  0,  -5,  160,  7 }, // ';'
+    {   533,  8,  7,  9,  0,  -7,  167,  9 }, // '<'
+    {   561,  8,  3,  9,  0,  -5,  176,  7 }, // '='
+    {   573,  8,  7,  9,  0,  -7,  183, 19 }, // '>'
+    {   601,  8,  7,  9,  0,  -7,  202, 11 }, // '?'
+    {   629,  8,  7,  9,  0,  -7,  213,  2 }, // '@'
+    {   657,  8,  7,  9,  0,  -7,  215,  5 }, // 'A'
+    {   685,  8,  7,  9,  0,  -7,  220,  1 }, // 'B'
+    {   713,  7,  7,  8,  0,  -7,  221,  9 }, // 'C'
+    {   741,  8,  7,  9,  0,  -7,  230,  2 }, // 'D'
+    {   769,  6,  7,  7,  0,  -7,  232,  9 }, // 'E'
+    {   790,  6,  7,  7,  0,  -7,  241, 36 }, // 'F'
+    {   811,  8,  7,  9,  0,  -7,  277,  1 }, // 'G'
+    {   839,  8,  7,  9,  0,  -7,  278,  1 }, // 'H'
+    {   867,  4,  7,  5,  0,  -7,  279,  2 }, // 'I'
+    {   881,  7,  7,  8,  0,  -7,  281,  6 }, // 'J'
+    {   909,  8,  7,  9,  0,  -7,  287,  6 }, // 'K'
+    {   937,  6,  7,  7,  0,  -7,  293, 18 }, // 'L'
+    {   958,  8,  7,  9,  0,  -7,  311,  1 }, // 'M'
+    {   986,  8,  7,  9,  0,  -7,  312,  1 }, // 'N'
+    {  1014,  8,  7,  9,  0,  -7,  313,  1 }, // 'O'
+    {  1042,  8,  7,  9,  0,  -7,  314,  7 }, // 'P'
+    {  1070,  8,  7,  9,  0,  -7,  321,  1 }, // 'Q'
+    {  1098,  8,  7,  9,  0,  -7,  322,  1 }, // 'R'
+    {  1126,  8,  7,  9,  0,  -7,  323,  1 }, // 'S'
+    {  1154,  8,  7,  9,  0,  -7,  324, 36 }, // 'T'
+    {  1182,  8,  7,  9,  0,  -7,  360,  1 }, // 'U'
+    {  1210,  8,  7,  9,  0,  -7,  361,  2 }, // 'V'
+    {  1238,  8,  7,  9,  0,  -7,  363,  2 }, // 'W'
+    {  1266,  8,  7,  9,  0,  -7,  365,  6 }, // 'X'
+    {  1294,  8,  7,  9,  0,  -7,  371, 27 }, // 'Y'
+    {  1322,  8,  7,  9,  0,  -7,  398,  7 }, // 'Z'
+    {  1350,  5,  7,  6,  0,  -7,  405,  9 }, // '['
+    {  1371,  8,  7,  9,  0,  -7,  414, 16 }, // '\'
+    {  1399,  5,  7,  6,  0,  -7,  430,  1 }, // ']'
+    {  1420,  8,  4,  9,  0,  -7,  431, 16 }, // '^'
+    {  1436,  8,  1,  9,  0,  -1,  447, 11 }, // '_'
+    {  1440,  4,  3,  5,  0,  -7,  458,  5 }, // '`'
+    {  1446,  8,  5,  9,  0,  -5,  463,  5 }, // 'a'
+    {  1466,  8,  7,  9,  0,  -7,  468,  5 }, // 'b'
+    {  1494,  8,  5,  9,  0,  -5,  473,  5 }, // 'c'
+    {  1514,  8,  7,  9,  0,  -7,  478,  1 }, // 'd'
+    {  1542,  8,  5,  9,  0,  -5,  479,  6 }, // 'e'
+    {  1562,  7,  7,  9,  1,  -7,  485, 14 }, // 'f'
+    {  1590,  8,  7,  9,  0,  -5,  499,  5 }, // 'g'
+    {  1618,  8,  7,  9,  0,  -7,  504,  5 }, // 'h'
+    {  1646,  6,  7,  8,  1,  -7,  509, 18 }, // 'i'
+    {  1667,  8,  9,  9,  0,  -7,  527,  1 }, // 'j'
+    {  1703,  8,  7,  9,  0,  -7,  528,  2 }, // 'k'
+    {  1731,  4,  7,  7,  2,  -7,  530,  2 }, // 'l'
+    {  1745,  8,  5,  9,  0,  -5,  532,  5 }, // 'm'
+    {  1765,  8,  5,  9,  0,  -5,  537,  5 }, // 'n'
+    {  1785,  8,  5,  9,  0,  -5,  542,  5 }, // 'o'
+    {  1805,  8,  7,  9,  0,  -5,  547,  6 }, // 'p'
+    {  1833,  8,  7,  9,  0,  -5,  553,  2 }, // 'q'
+    {  1861,  7,  7,  9,  1,  -5,  555, 18 }, // 'r'
+    {  1889,  8,  5,  9,  0,  -5,  573,  7 }, // 's'
+    {  1909,  8,  7,  9,  0,  -7,  580, 16 }, // 't'
+    {  1937,  8,  5,  9,  0,  -5,  596,  2 }, // 'u'
+    {  1957,  8,  5,  9,  0,  -5,  598,  3 }, // 'v'
+    {  1977,  8,  5,  9,  0,  -5,  601,  2 }, // 'w'
+    {  1997,  8,  5,  9,  0,  -5,  603,  2 }, // 'x'
+    {  2017,  8,  8,  9,  0,  -5,  605,  2 }, // 'y'
+    {  2049,  8,  8,  9,  0,  -5,  607,  2 }, // 'z'
+    {  2081,  6,  7,  7,  0,  -7,  609,  9 }, // '{'
+    {  2102,  6,  7,  7,  0,  -7,  618,  3 }, // '|'
+    {  2123,  2,  7,  3,  0,  -7,  621,  1 }, // '}'
+    {  2130,  8,  3,  9,  0,  -7,  622,  8 }, // '~'
+};
+
+static const struct ssd1322_font font_default =
+{
+    .bitmap = font_default_bitmap,
+    .glyph  = font_default_glyphs,
+    .kern   = font_default_kern,
+    .first  = 32,
+    .last   = 126,
+    .height = 10,
+    .ascent = 7
+};
+
+#endif
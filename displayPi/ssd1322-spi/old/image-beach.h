@@ -0,0 +1,520 @@
+/*
+    Image beach, generated by imageconvert.
+*/
+
+#ifndef IMAGE_BEACH_H
+#define IMAGE_BEACH_H
+
+#include "ssd1322-image.h"
+
+static const uint8_t image_beach_data[] =
+{
+    0x09,0x88,0x89,0xaa,0xaa,0x99,0x9a,0x99,0x89,0xaa,0xab,0x81,0xbb,0x01,0xba,0xba,
+    0x81,0xaa,0x84,0xbb,0x16,0xbc,0xcc,0x99,0x99,0x9a,0xab,0xbb,0xab,0xaa,0x9a,0xaa,
+    0xbb,0xbc,0xbb,0xcc,0xcc,0xcb,0xab,0xab,0xcb,0xbb,0xba,0xba,0x80,0xbb,0x08,0xa9,
+    0x99,0x99,0xaa,0xa9,0xaa,0xa9,0x9a,0xab,0x80,0xbb,0x0d,0xcb,0xbb,0xb9,0xaa,0xa7,
+    0x78,0x87,0x67,0x78,0x78,0x87,0x85,0x44,0x32,0x81,0x22,0x00,0x32,0x82,0x33,0x26,
+    0x24,0x33,0x4b,0xbc,0xdc,0xb8,0xab,0xcc,0xbb,0xba,0xaa,0xaa,0x99,0xbb,0xcb,0xbb,
+    0xab,0xbb,0xbb,0xba,0xaa,0xbb,0xbc,0xcb,0xcc,0xca,0xbb,0xaa,0xbb,0xbb,0xba,0xa9,
+    0x9a,0xaa,0xbb,0xbb,0xbc,0xbb,0xbb,0x0c,0x98,0x88,0x89,0xaa,0xa9,0xa9,0x99,0x99,
+    0xa9,0xba,0xab,0xcc,0xbb,0x80,0xba,0x82,0xaa,0x00,0xab,0x80,0xbb,0x26,0xcb,0xbb,
+    0xcc,0xba,0xba,0xab,0xba,0xba,0xa9,0xaa,0xaa,0xba,0xbc,0xcc,0xcc,0xcb,0xcc,0xbb,
+    0xba,0x99,0x9a,0xbc,0xba,0xaa,0xa9,0x9a,0xab,0xbb,0xba,0xbb,0xba,0xaa,0xbb,0xba,
+    0xbb,0xba,0xbb,0xaa,0xbb,0x80,0xbc,0x0a,0xaa,0xaa,0x97,0x75,0x77,0x76,0x55,0x66,
+    0x67,0x53,0x32,0x84,0x22,0x20,0x23,0x23,0x33,0x32,0x32,0x34,0x39,0xa6,0xaa,0x99,
+    0x9a,0xab,0xbc,0xcc,0xcc,0xba,0xb8,0x89,0xbb,0xba,0xa8,0x8a,0xaa,0xab,0xbb,0xbc,
+    0xcb,0xbc,0xcb,0xbc,0xbb,0xb8,0x7a,0x80,0xbb,0x06,0xcb,0xbb,0xbb,0xbc,0xbc,0xbb,
+    0xcc,0x1d,0x9a,0xaa,0xbb,0xa9,0x89,0xaa,0x9a,0x99,0x9a,0xab,0xcc,0xbb,0xbb,0xba,
+    0x99,0xaa,0xaa,0xa9,0x9a,0xaa,0xaa,0xbb,0xba,0xba,0xbb,0xca,0xbb,0xbb,0xba,0xbb,
+    0x80,0xba,0x05,0xa9,0x9a,0xab,0xaa,0xaa,0xba,0x81,0xbb,0x06,0xbc,0xbb,0xaa,0xcc,
+    0xbb,0xbb,0xbc,0x81,0xcc,0x06,0xdc,0xdb,0xab,0xbc,0xbc,0xcb,0xbb,0x80,0xaa,0x0c,
+    0xab,0xab,0xbb,0x9a,0xa9,0x98,0x78,0x77,0x66,0x45,0x55,0x55,0x43,0x80,0x22,0x00,
+    0x21,0x84,0x22,0x23,0x32,0x32,0x23,0x37,0xa9,0xab,0x9a,0x99,0x9a,0xbc,0xcc,0xcb,
+    0xba,0xaa,0xa9,0x99,0x9a,0x8b,0xbb,0xbb,0xa9,0xab,0xba,0xab,0xbc,0xcb,0xa9,0x98,
+    0x68,0x9a,0xbb,0xbc,0xcb,0xbc,0xbb,0xba,0x80,0xbb,0x00,0xba,0x18,0xaa,0xb9,0xaa,
+    0xaa,0x98,0x89,0x99,0x9a,0xaa,0xbb,0xcc,0xbc,0xba,0xa9,0xa9,0x9a,0xbb,0xab,0xbb,
+    0xba,0xaa,0xbb,0xba,0x9b,0xbb,0x80,0xaa,0x0c,0xa9,0xaa,0xaa,0x9a,0x9a,0xaa,0xaa,
+    0xbb,0xcd,0xee,0xee,0xdc,0xcb,0x80,0xaa,0x05,0xab,0xbc,0xbb,0xcc,0xac,0xcc,0x80,
+    0xcb,0x18,0xbb,0xcc,0xcc,0xbb,0xcc,0xcc,0xb9,0x88,0x89,0x99,0xaa,0xaa,0xbb,0xba,
+    0x9a,0xa9,0x88,0x97,0x86,0x57,0x44,0x54,0x45,0x44,0x32,0x85,0x22,0x16,0x32,0x22,
+    0x23,0x23,0x33,0x34,0xba,0xab,0xcb,0x9a,0x9a,0xab,0xab,0xaa,0xab,0xba,0xa9,0x88,
+    0x89,0xa7,0x89,0xaa,0xaa,0x82,0xbb,0x04,0xa9,0x99,0xba,0xaa,0xab,0x85,0xaa,0x00,
+    0xbb,0x24,0xba,0xba,0xab,0xaa,0xa9,0x99,0x9a,0xaa,0xbb,0xcb,0xbb,0xcc,0xbb,0xaa,
+    0xaa,0xbb,0xab,0xbb,0xa9,0xbb,0xba,0xbb,0xba,0xbc,0xcc,0xba,0xaa,0xaa,0xab,0xab,
+    0xaa,0xaa,0x99,0xaa,0xab,0xbd,0xdc,0x83,0xee,0x0b,0xdb,0xbb,0xa9,0xa9,0xab,0xbb,
+    0xba,0xaa,0xbb,0xbc,0xcb,0xbc,0x80,0xcc,0x16,0xbb,0x98,0x87,0x88,0x99,0xaa,0xaa,
+    0xbb,0xba,0xaa,0x89,0x97,0x99,0x87,0x76,0x54,0x54,0x44,0x45,0x75,0x32,0x22,0x21,
+    0x84,0x22,0x27,0x32,0x32,0x23,0x33,0x9b,0xab,0xbb,0xab,0xbb,0xbb,0xab,0xa9,0x9a,
+    0xbb,0xba,0xbb,0xa8,0x87,0x8b,0xca,0xbb,0xba,0xaa,0xab,0xbb,0xab,0xbb,0xcc,0xcb,
+    0xa9,0x8a,0xaa,0xaa,0xbb,0xbb,0xaa,0xab,0xa9,0xaa,0xa9,0x13,0xac,0xbb,0xb9,0xab,
+    0xaa,0xaa,0xbb,0xba,0xaa,0xab,0xcc,0xba,0xa9,0xa8,0x99,0x9a,0xbb,0xaa,0x9a,0xcb,
+    0x80,0xab,0x04,0xba,0xcb,0xbb,0xaa,0xba,0x80,0xbb,0x00,0xba,0x80,0xbb,0x02,0xdb,
+    0xb9,0xcd,0x81,0xee,0x03,0xdd,0xed,0xda,0xaa,0x80,0xba,0x1d,0xaa,0xb9,0xbc,0xcb,
+    0xaa,0x99,0x9b,0xbc,0xcc,0xbb,0xba,0xa9,0x98,0x9a,0x99,0xaa,0xbb,0xa9,0xa9,0x87,
+    0x87,0x76,0x77,0x56,0x45,0x55,0x34,0x33,0x35,0x65,0x86,0x22,0x17,0x33,0x23,0x32,
+    0x33,0x6a,0x99,0xaa,0xbc,0xbb,0xbb,0xaa,0x98,0x8a,0xbc,0xcb,0xcc,0xa9,0xab,0xba,
+    0xbb,0xbb,0xba,0xbb,0xbc,0x80,0xbb,0x05,0xbc,0xcb,0xab,0x97,0x9a,0xcc,0x80,0xbb,
+    0x03,0xa9,0x9a,0xaa,0xaa,0x06,0xbb,0xba,0xba,0xa9,0x88,0x88,0x9a,0x81,0xaa,0x22,
+    0xa9,0xaa,0xa9,0x9a,0xa9,0x9a,0xab,0xab,0xbb,0xb9,0x88,0x99,0x89,0xa9,0xab,0xbb,
+    0xba,0xbc,0xbb,0xbb,0xcc,0xba,0xaa,0xbc,0x98,0xb8,0xbb,0xce,0xee,0xde,0xde,0xed,
+    0xdd,0xee,0xdb,0x80,0xaa,0x03,0xbb,0xab,0xba,0x98,0x80,0x88,0x00,0x9b,0x80,0xbb,
+    0x0c,0xaa,0xab,0xb9,0x99,0xbb,0xcc,0xb9,0xa7,0x76,0x66,0x78,0x76,0x44,0x80,0x33,
+    0x04,0x23,0x23,0x45,0x66,0x32,0x83,0x22,0x28,0x32,0x23,0x32,0x32,0x33,0x4b,0xbb,
+    0xbb,0xcb,0xaa,0xab,0xba,0xa8,0x99,0xab,0xcc,0xcc,0xca,0x89,0xa9,0x9a,0xbb,0xba,
+    0xab,0xbb,0xcb,0xbb,0xab,0xcb,0xbb,0xb9,0x7a,0xbc,0xcc,0xbb,0xaa,0xaa,0xbb,0xaa,
+    0x99,0xaa,0x04,0xbb,0xbb,0xaa,0x99,0x89,0x80,0x99,0x0e,0x9a,0x9a,0xaa,0xab,0xba,
+    0xaa,0xab,0x99,0xab,0xba,0xab,0xaa,0x88,0x99,0xa9,0x81,0xaa,0x0c,0xbb,0xbc,0xcc,
+    0xcb,0xa9,0x98,0x98,0xd8,0x9c,0xec,0xee,0xed,0xed,0x82,0xdd,0x04,0xde,0xdc,0xba,
+    0xab,0xaa,0x80,0x99,0x13,0xab,0xbb,0xbb,0xba,0xcc,0xca,0xba,0xbb,0xcb,0xaa,0xab,
+    0xbb,0xaa,0xab,0x88,0x86,0x45,0x43,0x44,0x33,0x81,0x22,0x04,0x32,0x23,0x45,0x55,
+    0x53,0x82,0x22,0x28,0x23,0x23,0x33,0x23,0x34,0x49,0xbb,0xba,0xbc,0xcc,0xcc,0xbb,
+    0xbb,0xba,0xaa,0xbc,0xcc,0xcb,0xba,0xbb,0xb9,0x9b,0xba,0x8b,0xcc,0xcb,0xaa,0xaa,
+    0xac,0xcc,0xbb,0xbb,0xcc,0xcb,0xbb,0xaa,0xbc,0xbb,0xcc,0xcb,0xba,0x10,0xbb,0xbb,
+    0xaa,0x99,0xaa,0xba,0xaa,0xba,0xaa,0xa9,0x9a,0xaa,0xbb,0xbb,0xcc,0xa9,0x9a,0x80,
+    0xbb,0x1b,0xaa,0xba,0xab,0xbb,0xba,0xba,0x9b,0xac,0xcc,0xcb,0xbb,0xbb,0xa9,0xac,
+    0x9c,0xee,0xdf,0xff,0xff,0xee,0xdc,0xcd,0xdb,0xcd,0x9b,0xdc,0xdd,0xdc,0x80,0xbb,
+    0x17,0xbc,0xca,0xcc,0xcb,0xbb,0xba,0xba,0xab,0xcc,0xca,0x9a,0xba,0xbb,0xbc,0xaa,
+    0x9a,0x98,0x99,0x76,0x54,0x44,0x22,0x32,0x23,0x80,0x22,0x80,0x23,0x83,0x22,0x28,
+    0x23,0x33,0x44,0x43,0x44,0x48,0xba,0xbb,0xbb,0xab,0xbb,0xcc,0xcb,0xaa,0xaa,0xbb,
+    0xcc,0xcb,0x99,0x89,0xaa,0xa9,0xaa,0xaa,0xcc,0xbb,0xcc,0xbb,0xbb,0xcc,0xba,0xba,
+    0xaa,0xba,0xbb,0xba,0x99,0xab,0xbc,0xbb,0xaa,0x47,0xcb,0xa9,0x99,0x9b,0xaa,0xb9,
+    0x99,0xaa,0xab,0xbb,0xaa,0xa9,0xa9,0xab,0xbb,0x99,0x9a,0x9b,0xbb,0xbb,0xba,0xaa,
+    0xba,0xaa,0xbb,0xcb,0xba,0xab,0xbc,0xbc,0xbb,0xbc,0xca,0xda,0xdf,0xdf,0xff,0xef,
+    0xff,0xfe,0xcb,0xbb,0xca,0x99,0x99,0x9a,0xcc,0xab,0xb9,0xab,0xbc,0xcc,0xbb,0xbc,
+    0xb9,0xab,0xba,0xa9,0x99,0xaa,0xbc,0xbc,0xcc,0xb9,0x78,0x89,0xa8,0x77,0x88,0x87,
+    0x53,0x42,0x83,0x22,0x02,0x32,0x22,0x32,0x82,0x22,0x09,0x42,0x32,0x33,0x43,0x43,
+    0x34,0x47,0xaa,0xaa,0xab,0x80,0xbb,0x10,0x99,0xa9,0xbb,0xbc,0xbb,0xbb,0x9a,0x99,
+    0x9a,0xbb,0xcc,0xbb,0xcc,0xdd,0xcc,0xcb,0xba,0x82,0xcc,0x06,0xbb,0xbb,0xba,0xaa,
+    0xaa,0xbb,0xbc,0x50,0xab,0xaa,0xaa,0x88,0xa9,0x99,0x99,0x9a,0xa9,0x98,0x89,0x99,
+    0x99,0xa9,0xaa,0xb9,0x9a,0x9c,0xcc,0xbb,0xbb,0xaa,0xbb,0xbb,0xb9,0x99,0x99,0xab,
+    0xbb,0xbc,0xcb,0x9a,0xbb,0xcb,0xfe,0xff,0xee,0xee,0xed,0xda,0xbb,0xbc,0xcb,0x88,
+    0x8a,0x97,0xaa,0x98,0x8a,0xaa,0xab,0xbc,0xba,0xaa,0xbb,0xba,0xa9,0xaa,0xaa,0xbb,
+    0xab,0xbd,0xdc,0xba,0xaa,0x9b,0xb8,0x87,0x68,0x98,0x76,0x42,0x32,0x22,0x22,0x32,
+    0x22,0x23,0x22,0x22,0x32,0x82,0x22,0x06,0x44,0x32,0x33,0x34,0x43,0x34,0x46,0x80,
+    0xaa,0x06,0xbb,0xba,0xba,0x99,0xaa,0xab,0xbc,0x80,0xbb,0x12,0xaa,0x9a,0xaa,0x99,
+    0x99,0xaa,0xab,0xcc,0xbb,0xbb,0xbc,0xcc,0xbb,0xbb,0xac,0xcc,0xbb,0xbb,0xab,0x80,
+    0xbb,0x38,0x88,0x97,0x8a,0xba,0x9a,0xaa,0xba,0x89,0x99,0x99,0x9a,0xaa,0xa8,0x9a,
+    0xab,0xcb,0xcb,0xbb,0xbb,0xcb,0xab,0xaa,0xab,0xca,0x99,0x99,0x9a,0xab,0xbb,0xba,
+    0xcc,0xbb,0xae,0xcf,0xee,0xee,0xed,0xed,0xdc,0xcc,0xbc,0xbb,0xbb,0x88,0x89,0x9a,
+    0xb9,0xa8,0x67,0xba,0xbb,0xca,0xa9,0x99,0x99,0xab,0xaa,0x82,0xbb,0x0e,0xcb,0xab,
+    0xcb,0xcc,0xba,0x88,0x86,0x8a,0x86,0x53,0x22,0x32,0x23,0x22,0x33,0x85,0x22,0x2a,
+    0x23,0x44,0x32,0x23,0x43,0x33,0x33,0x35,0xaa,0xaa,0xba,0xaa,0xbb,0xcb,0xbb,0xbb,
+    0xba,0xaa,0x9a,0x99,0xa9,0x9a,0xaa,0xa9,0xa9,0x99,0x87,0x99,0x9a,0xaa,0x9a,0xaa,
+    0xbb,0xbb,0xab,0xcb,0xcc,0xcc,0xbc,0xcb,0xbb,0xbb,0xcb,0x06,0x77,0x88,0x99,0xbb,
+    0xbb,0xba,0xba,0x83,0xaa,0x0e,0xab,0xaa,0xaa,0xac,0xbb,0xba,0xbb,0xaa,0x9a,0xb8,
+    0x77,0x9a,0xaa,0x9b,0xab,0x81,0xbb,0x03,0xcd,0xef,0xee,0xec,0x80,0xdd,0x0d,0xcc,
+    0xcc,0xcb,0xaa,0xa8,0x88,0x88,0xad,0xac,0xca,0xcc,0xbb,0xbb,0xba,0x80,0xbb,0x13,
+    0x9a,0xbb,0x89,0xbb,0xcc,0xcb,0xcc,0xbb,0xbb,0xba,0xb8,0x98,0x77,0x77,0x78,0x74,
+    0x43,0x33,0x22,0x32,0x87,0x22,0x0b,0x33,0x33,0x23,0x23,0x43,0x33,0x34,0x9b,0xba,
+    0xaa,0xbb,0xbb,0x80,0xcc,0x14,0xcb,0xbb,0xa9,0xaa,0xaa,0xbc,0xba,0xaa,0xaa,0xab,
+    0xbb,0xbb,0xba,0xab,0xbc,0xbb,0xcb,0xaa,0xaa,0xbb,0xcc,0x81,0xbb,0x01,0xaa,0xab,
+    0x16,0x99,0x9a,0xbc,0xbb,0x99,0x99,0x9a,0xab,0xbb,0xaa,0xaa,0x9a,0xa9,0x99,0xaa,
+    0xbb,0x9a,0xb9,0xab,0xbb,0xcc,0xbb,0xba,0x80,0xaa,0x01,0xa9,0x9a,0x81,0xaa,0x08,
+    0xed,0xfd,0xec,0xcc,0xdd,0xdd,0xcd,0xdc,0xbc,0x80,0xbb,0x0b,0x99,0x67,0x87,0x99,
+    0xba,0xbc,0xb7,0x99,0x99,0xac,0xbb,0xbc,0x80,0xcc,0x00,0xbd,0x80,0xcc,0x0e,0xca,
+    0xaa,0xaa,0xa9,0x88,0x88,0x86,0x66,0x75,0x76,0x53,0x32,0x22,0x21,0x21,0x80,0x22,
+    0x12,0x12,0x12,0x21,0x22,0x22,0x32,0x22,0x23,0x32,0x23,0x33,0x34,0x7b,0xcc,0xbb,
+    0xba,0xbb,0xcb,0xcc,0x80,0xbb,0x18,0xab,0xab,0xbc,0xba,0xaa,0x99,0x99,0xaa,0xbb,
+    0xbc,0xcc,0xcc,0xbb,0xba,0x9a,0xaa,0xbb,0xbb,0xaa,0xa8,0x99,0x9a,0xab,0xbb,0xba,
+    0x09,0xbb,0xab,0xbb,0xba,0xa9,0xaa,0xab,0xbb,0xaa,0x99,0x80,0xaa,0x29,0xa9,0xab,
+    0xbb,0xbb,0xba,0xaa,0xba,0xbb,0xbb,0xaa,0xa9,0x98,0x9a,0xaa,0xa9,0x99,0xaa,0xaa,
+    0x9b,0xee,0xfd,0xdc,0xdd,0xed,0xdd,0xdd,0xcb,0xab,0xbb,0xba,0xab,0xb9,0x89,0x97,
+    0x89,0x87,0x77,0x89,0x88,0x9a,0xac,0xbc,0x80,0xcb,0x08,0xbb,0xbc,0xcc,0xcc,0xbb,
+    0xba,0xaa,0xaa,0xa9,0x80,0x77,0x03,0x65,0x54,0x44,0x32,0x81,0x22,0x00,0x12,0x82,
+    0x22,0x00,0x12,0x83,0x22,0x19,0x23,0x33,0x5c,0xab,0x98,0x98,0x8a,0xab,0xbc,0xcb,
+    0xcc,0xbc,0xbc,0xcc,0xcb,0xbb,0xbb,0xba,0x99,0xaa,0xcc,0xcc,0xcb,0xaa,0xaa,0xa9,
+    0x80,0xaa,0x07,0xa9,0x99,0x99,0x9a,0xaa,0xaa,0xbb,0xba,0x05,0xa9,0xa9,0x99,0xac,
+    0xbb,0xcb,0x80,0xbb,0x06,0xba,0x99,0x9a,0xaa,0xbb,0xcb,0xcb,0x80,0xbb,0x1c,0xaa,
+    0xab,0xbb,0xbb,0x9a,0xaa,0xbb,0xbb,0xaa,0xaa,0x99,0x9a,0xad,0xef,0xed,0xde,0xef,
+    0xff,0xee,0xdc,0xcb,0xbb,0xab,0xa9,0x99,0x98,0x88,0x76,0x67,0x80,0x77,0x04,0xba,
+    0xab,0xcb,0xbb,0xbb,0x82,0xaa,0x0d,0xbb,0xbb,0xba,0x9a,0xab,0xba,0x97,0x66,0x56,
+    0x54,0x33,0x32,0x22,0x22,0x80,0x23,0x81,0x22,0x00,0x21,0x86,0x22,0x15,0x23,0x5a,
+    0x99,0x99,0x87,0x88,0xbb,0xbb,0xab,0xbb,0xcc,0xcb,0xcb,0xbc,0xcc,0xcb,0xba,0xaa,
+    0xbb,0xaa,0xaa,0xa9,0x84,0xaa,0x81,0x99,0x02,0x9b,0xac,0xba,0x07,0xba,0xaa,0x99,
+    0x98,0x9a,0xaa,0xbb,0xab,0x80,0xbb,0x24,0xbc,0xcb,0xcb,0xbb,0xab,0xbb,0xbb,0xab,
+    0xbb,0xab,0xbc,0xbb,0xcc,0xbc,0xbb,0xaa,0xcc,0xcc,0xbc,0xba,0xce,0xdf,0xef,0xff,
+    0xff,0xef,0xfe,0xee,0xee,0xde,0xdc,0xca,0x99,0xb9,0x98,0x65,0x56,0x80,0x77,0x00,
+    0xbc,0x80,0xbb,0x17,0xab,0xaa,0xab,0xbb,0xba,0xbc,0xca,0xaa,0xab,0xba,0xaa,0xba,
+    0xba,0xaa,0x98,0x75,0x34,0x33,0x23,0x33,0x23,0x23,0x22,0x32,0x84,0x22,0x11,0x12,
+    0x22,0x12,0x22,0x22,0x23,0x23,0x47,0x99,0xa9,0x99,0x89,0xbc,0xcc,0xbb,0xab,0x9a,
+    0x9b,0x80,0xcc,0x05,0xcb,0xbb,0xbb,0xbc,0xcc,0xba,0x85,0xaa,0x82,0x99,0x01,0x9b,
+    0xaa,0x08,0xbb,0xcb,0x88,0x98,0x88,0x88,0x9a,0xaa,0xba,0x80,0xbb,0x23,0xbc,0xab,
+    0xa9,0x77,0x99,0xab,0xca,0xab,0xbc,0xcb,0xdb,0xaa,0xba,0xbb,0xbc,0xcc,0xcb,0xba,
+    0xaa,0xce,0xff,0xee,0xdd,0xcb,0xcb,0xcc,0xcb,0xcc,0xdd,0xdd,0xdb,0xa9,0x88,0x77,
+    0x66,0x66,0x80,0x77,0x1e,0xbc,0xcc,0xcb,0xcb,0xbc,0xa9,0xba,0xaa,0xab,0xbb,0xcb,
+    0xaa,0xac,0xcd,0xcc,0xcc,0x88,0x77,0x76,0x65,0x33,0x32,0x22,0x22,0x21,0x22,0x33,
+    0x32,0x32,0x22,0x12,0x81,0x11,0x01,0x21,0x12,0x80,0x22,0x0e,0x32,0x33,0x34,0x89,
+    0x9a,0xa9,0xab,0xcc,0xcc,0xca,0xa9,0xa9,0xbc,0xbc,0xcc,0x81,0xbb,0x0a,0xcc,0xba,
+    0xbb,0xbb,0xcb,0xbb,0xaa,0xbc,0xcb,0xba,0xba,0x83,0xbb,0x00,0xaa,0x23,0xba,0xa9,
+    0xa9,0x98,0x88,0x88,0x89,0x9a,0xab,0xbb,0xbc,0xbb,0xab,0xaa,0x78,0x98,0x79,0x89,
+    0xab,0xaa,0xbb,0xcb,0xaa,0xab,0xbb,0xcb,0xbb,0xcc,0xcc,0xbb,0xcc,0xee,0xeb,0x9c,
+    0xdd,0xee,0x80,0xff,0x20,0xed,0xca,0x99,0xa9,0x98,0x88,0x77,0x65,0x56,0x67,0x77,
+    0x77,0xac,0xcb,0xbb,0xbc,0xb9,0x46,0x9a,0x9a,0xab,0xaa,0xab,0xcc,0xbc,0xbb,0xbc,
+    0xcc,0x95,0x67,0x76,0x75,0x42,0x80,0x22,0x07,0x21,0x12,0x22,0x21,0x21,0x11,0x11,
+    0x21,0x83,0x22,0x81,0x23,0x12,0x34,0x59,0xaa,0xab,0xbc,0xcc,0xcc,0xba,0x98,0x79,
+    0xbb,0xcb,0xab,0xbb,0xcc,0xcc,0xcb,0xbb,0xab,0x80,0xbb,0x0c,0xba,0xaa,0x9a,0xaa,
+    0xba,0xbb,0xcb,0xbc,0xcc,0xcc,0xcb,0xaa,0xbb,0x00,0xab,0x80,0xbb,0x0e,0xba,0xa9,
+    0xaa,0xbc,0xbc,0xcc,0xcb,0xa9,0x99,0xa9,0xa9,0x99,0x99,0x89,0xab,0x82,0xbb,0x09,
+    0xbc,0xba,0xac,0xcc,0xbc,0xcc,0xcb,0xef,0xc7,0xae,0x81,0xff,0x0d,0xee,0xfe,0xef,
+    0xed,0xb8,0x88,0x87,0x77,0x56,0x66,0x67,0x77,0x77,0xac,0x80,0xbb,0x07,0xaa,0x74,
+    0x5a,0xbb,0xbc,0xbc,0xca,0xab,0x80,0xbb,0x0b,0xab,0x98,0x88,0xab,0x97,0x42,0x11,
+    0x11,0x10,0x01,0x21,0x33,0x85,0x22,0x13,0x33,0x23,0x23,0x22,0x33,0x23,0x33,0x33,
+    0x46,0xcc,0xcb,0xcc,0xcd,0xcb,0xba,0xaa,0x98,0x88,0xab,0xbc,0x80,0xcc,0x02,0xba,
+    0x8b,0xab,0x80,0xaa,0x01,0xab,0xba,0x80,0xbb,0x07,0xbc,0xbb,0xab,0xcc,0xbc,0xbb,
+    0xcc,0xbc,0x10,0xab,0xbb,0xba,0xbb,0xbb,0xcb,0xbb,0xbc,0xbc,0xcb,0xbb,0x87,0x88,
+    0x9a,0xaa,0x99,0x8a,0x80,0xbb,0x13,0xbc,0xbb,0xcc,0xcb,0xbc,0xc9,0x9c,0xcc,0xcb,
+    0xcb,0xbc,0xee,0x75,0x25,0xbe,0xff,0xfe,0xff,0xfe,0xfe,0x80,0xee,0x2b,0xc9,0x77,
+    0x76,0x65,0x66,0x67,0x76,0x77,0xab,0xbb,0xab,0xcc,0xba,0x94,0x4a,0xaa,0xaa,0xbb,
+    0xba,0xab,0xcb,0xac,0xcc,0xcb,0x9a,0x9a,0x75,0x55,0x43,0x22,0x32,0x11,0x22,0x11,
+    0x24,0x33,0x33,0x22,0x22,0x32,0x22,0x33,0x32,0x22,0x82,0x23,0x13,0x33,0x33,0x44,
+    0x8c,0xcb,0xcc,0xcc,0xbb,0xba,0xbb,0xab,0xa9,0xbc,0xbb,0xbc,0xcc,0xcc,0xcb,0xa9,
+    0xab,0x81,0xbb,0x0b,0xcb,0xcc,0xcc,0xca,0xbb,0xbb,0x95,0x79,0xa9,0x9a,0xbb,0xcc,
+    0x0d,0xaa,0xbb,0xbc,0xbc,0xcb,0xbb,0xbb,0xbc,0xcb,0xbb,0xbc,0xcb,0x99,0xba,0x81,
+    0xaa,0x3c,0xbb,0xcc,0xcc,0xcd,0xcb,0xaa,0x9a,0xab,0xab,0xbb,0xbb,0xba,0x9c,0xe9,
+    0x41,0x12,0x35,0x8a,0xcd,0xef,0xef,0xee,0xee,0xed,0xee,0xde,0xc9,0x67,0x76,0x66,
+    0x76,0x77,0x77,0x9a,0xaa,0xaa,0xab,0xba,0xaa,0xa9,0x99,0xaa,0xbc,0xcb,0xbc,0xa9,
+    0xbb,0xbb,0xbc,0xba,0x88,0x44,0x44,0x45,0x66,0x43,0x32,0x22,0x22,0x14,0x64,0x80,
+    0x33,0x04,0x23,0x32,0x22,0x23,0x23,0x80,0x32,0x05,0x33,0x33,0x23,0x33,0x33,0x59,
+    0x80,0xcc,0x0a,0xcb,0xb9,0x68,0xcc,0xbc,0xab,0xbb,0xcc,0xdc,0xdc,0xbb,0x81,0xaa,
+    0x08,0xbb,0xbb,0xaa,0xab,0xba,0xa8,0x68,0xbc,0xb8,0x80,0xbb,0x01,0xba,0xbb,0x10,
+    0xaa,0xab,0xcc,0xbc,0xaa,0x9a,0xbb,0xbc,0xcb,0xbc,0xcb,0xbb,0xcb,0xba,0x88,0x8a,
+    0xbc,0x81,0xcc,0x01,0xba,0xa9,0x84,0x99,0x11,0x9d,0xc5,0x10,0x12,0x34,0x45,0x67,
+    0x78,0x9a,0xcd,0xde,0xee,0xde,0xde,0xdd,0xc7,0x67,0x66,0x80,0x77,0x23,0xaa,0xaa,
+    0x9a,0xab,0xbb,0xbb,0xcb,0xba,0xcc,0xcc,0xcb,0xbb,0xaa,0xaa,0xba,0xbc,0xa8,0x48,
+    0x34,0x55,0x54,0x65,0x43,0x33,0x32,0x22,0x21,0x55,0x66,0x64,0x33,0x23,0x23,0x32,
+    0x23,0x32,0x80,0x33,0x15,0x23,0x23,0x33,0x33,0x34,0x45,0xac,0xcc,0xbc,0xcc,0xcb,
+    0x77,0x8b,0xbb,0xcb,0xba,0xab,0xdc,0xba,0xaa,0xab,0xbb,0x80,0xcc,0x0c,0xcb,0xbb,
+    0xbb,0xcb,0xaa,0xa8,0x9b,0xbb,0xcc,0xbb,0xab,0xcb,0xcb,0x04,0xaa,0xaa,0xab,0xba,
+    0xba,0x80,0xbb,0x19,0xaa,0xaa,0xab,0xbb,0xba,0xab,0xbc,0xcc,0xbb,0xbb,0xcb,0xb9,
+    0x99,0x98,0x98,0x88,0x98,0x88,0x98,0x89,0x99,0x99,0x9e,0x92,0x00,0x13,0x80,0x44,
+    0x2d,0x55,0x56,0x67,0x78,0xab,0xde,0xed,0xde,0xdd,0x96,0x77,0x67,0x67,0x77,0xab,
+    0xbb,0xab,0xaa,0xbb,0xbc,0xcc,0xbb,0xcc,0xbb,0xcc,0xcb,0xaa,0xab,0xbb,0xcb,0x96,
+    0x26,0x45,0x67,0x65,0x46,0x53,0x43,0x22,0x22,0x30,0x25,0x67,0x67,0x65,0x54,0x89,
+    0x33,0x20,0x34,0x5a,0xcc,0xcb,0xbc,0xcc,0xcb,0xba,0xbb,0xbb,0xab,0xcc,0xcb,0xba,
+    0xaa,0xab,0xcb,0xba,0xbc,0xbb,0xbb,0xb8,0xab,0xaa,0xaa,0xbc,0xcc,0xcc,0xcb,0xbb,
+    0xcb,0xcb,0xbb,0x7f,0x89,0xab,0xab,0xcc,0xcb,0x99,0x89,0x88,0x99,0xaa,0xab,0xbc,
+    0xca,0xaa,0xa9,0xab,0xa9,0xa8,0xac,0xba,0xaa,0xa9,0x89,0x98,0x88,0x88,0x99,0x9a,
+    0x99,0x9a,0xbd,0x61,0x10,0x13,0x45,0x44,0x34,0x44,0x54,0x45,0x56,0x67,0x78,0xac,
+    0xee,0xde,0xeb,0x77,0x77,0x76,0x77,0xbc,0xcc,0xba,0xab,0xbc,0xcc,0xdc,0xcb,0xcb,
+    0xcc,0xcb,0xa9,0xaa,0xab,0xcd,0xc9,0x75,0x25,0x36,0x78,0x76,0x35,0x53,0x43,0x22,
+    0x22,0x21,0x32,0x56,0x76,0x66,0x67,0x66,0x66,0x67,0x77,0x78,0x67,0x66,0x67,0x67,
+    0x77,0x65,0x44,0x34,0x46,0xab,0xbc,0xcc,0xcc,0xbb,0xba,0xaa,0xba,0xa9,0xaa,0xab,
+    0xb5,0x9b,0xcb,0xab,0x99,0xbb,0xbc,0xcb,0xa9,0x9a,0xab,0xba,0xbc,0xbb,0xcb,0xcb,
+    0xcc,0xba,0xbb,0xbb,0x51,0x98,0x8b,0xba,0x98,0x88,0x9b,0xbb,0xaa,0x9a,0xaa,0x89,
+    0x99,0x9a,0xaa,0xa9,0xa9,0xaa,0x99,0xbb,0xcb,0xbb,0xba,0x99,0x88,0x69,0x99,0xaa,
+    0xbb,0xbb,0xba,0xd9,0x20,0x11,0x23,0x43,0x21,0x22,0x33,0x44,0x54,0x55,0x55,0x66,
+    0x77,0x79,0xce,0xdd,0xd7,0x76,0x77,0x77,0xaa,0x9a,0xaa,0xbb,0xcd,0xcb,0xcc,0xbb,
+    0xbc,0xba,0xbb,0xba,0xaa,0xbc,0xdc,0xa7,0x52,0x23,0x55,0x89,0x64,0x35,0x44,0x32,
+    0x22,0x22,0x23,0x33,0x35,0x66,0x67,0x80,0x77,0x02,0x87,0x78,0x78,0x82,0x88,0x08,
+    0x98,0x87,0x64,0x44,0x7b,0x9a,0xaa,0x9a,0x99,0x80,0xaa,0x03,0x9b,0xaa,0xbb,0xa4,
+    0x80,0xbb,0x00,0xaa,0x80,0xbb,0x0b,0xaa,0xa9,0xaa,0xa9,0xaa,0xbb,0xbc,0xcc,0xcb,
+    0xcb,0xaa,0xbc,0x54,0xa9,0xa9,0x99,0x9a,0xbc,0xcb,0xa8,0x87,0x78,0x88,0x88,0x99,
+    0x85,0xaa,0xaa,0x98,0x98,0xad,0xbb,0xbb,0xab,0xcc,0xba,0xa9,0x89,0x98,0x9a,0xbc,
+    0xbb,0xcb,0xb3,0x12,0x21,0x34,0x33,0x33,0x22,0x23,0x34,0x44,0x45,0x55,0x45,0x56,
+    0x67,0x78,0xbd,0xed,0xa7,0x77,0x78,0xcc,0xcb,0xbb,0xbb,0xbc,0xcc,0xbc,0xcc,0xbc,
+    0xbb,0xab,0xba,0xab,0xdd,0xbb,0x95,0x42,0x22,0x55,0x68,0x73,0x24,0x44,0x32,0x22,
+    0x21,0x33,0x33,0x32,0x56,0x66,0x67,0x76,0x77,0x80,0x78,0x19,0x87,0x88,0x88,0x87,
+    0x88,0x88,0x78,0x78,0x64,0x56,0x99,0x99,0x9b,0xbb,0xaa,0x9a,0xab,0xbb,0xcc,0xbb,
+    0xa9,0xaa,0xbb,0xab,0xaa,0x9a,0x81,0xaa,0x09,0x9a,0xaa,0xab,0xcc,0xcd,0xcb,0xba,
+    0xaa,0x99,0x69,0x06,0xab,0xbb,0xbb,0xcc,0xbb,0xa9,0x87,0x82,0x88,0x03,0x99,0x99,
+    0xab,0xa9,0x80,0x99,0x0e,0x9a,0xab,0xbb,0xba,0xab,0xba,0x9a,0x9b,0xcc,0xcb,0xbb,
+    0xa2,0x21,0x22,0x35,0x81,0x44,0x01,0x43,0x44,0x80,0x54,0x27,0x45,0x44,0x66,0x78,
+    0x9c,0xdb,0x67,0x79,0xbb,0xbc,0xaa,0x9a,0xbc,0xcc,0xbc,0xbc,0xcb,0xbc,0xcb,0xbb,
+    0xbd,0xdd,0xca,0x95,0x43,0x22,0x34,0x77,0x64,0x23,0x44,0x32,0x22,0x22,0x33,0x32,
+    0x33,0x24,0x66,0x76,0x82,0x77,0x05,0x78,0x77,0x78,0x88,0x87,0x78,0x80,0x88,0x13,
+    0x55,0x79,0x9b,0xcc,0xcb,0xbb,0xba,0xab,0xcc,0xbb,0xab,0xaa,0xaa,0xbb,0xcb,0xaa,
+    0xb9,0x99,0x9a,0xab,0x81,0xbb,0x06,0xba,0xba,0xab,0xbb,0xbb,0x97,0x31,0x25,0x89,
+    0x89,0x99,0x99,0xa9,0xa9,0x98,0x89,0x99,0x88,0x88,0x99,0x9b,0xab,0xbb,0xaa,0x99,
+    0x99,0xa9,0xaa,0xab,0xbb,0xbc,0xbb,0xcc,0xbc,0xcc,0xcc,0xca,0xcb,0xa5,0x62,0x33,
+    0x45,0x54,0x43,0x43,0x44,0x80,0x45,0x2d,0x54,0x33,0x33,0x34,0x44,0x56,0x78,0x9c,
+    0xc7,0x7a,0xba,0x5a,0xa9,0x99,0xab,0xbc,0xbb,0xcb,0xba,0xac,0x9b,0xbb,0xcc,0xde,
+    0xd9,0x96,0x44,0x23,0x24,0x56,0x54,0x33,0x34,0x33,0x22,0x23,0x43,0x33,0x33,0x22,
+    0x35,0x77,0x77,0x67,0x77,0x77,0x80,0x78,0x0e,0x77,0x78,0x88,0x88,0x66,0x55,0x45,
+    0x54,0x57,0xab,0x9c,0xbb,0xbb,0xab,0xbb,0x80,0xcc,0x13,0xba,0xbb,0xbc,0xbb,0xcc,
+    0xab,0xaa,0xab,0xab,0xca,0xcb,0xba,0xab,0xa7,0xbb,0xbb,0xbc,0xca,0x72,0x43,0x02,
+    0x98,0x89,0x9a,0x81,0xaa,0x00,0xa9,0x81,0xaa,0x2b,0xa9,0x89,0xbb,0xa9,0x99,0x99,
+    0xaa,0xa9,0xa9,0x8a,0xbb,0xcb,0xbc,0xcc,0xbc,0xcb,0x9a,0xaa,0xa8,0x64,0x34,0x66,
+    0x55,0x32,0x11,0x23,0x44,0x44,0x55,0x55,0x44,0x31,0x22,0x34,0x44,0x45,0x78,0x8c,
+    0x9a,0xba,0xb9,0xaa,0x99,0x99,0x81,0xaa,0x1a,0xba,0xbc,0xcc,0xcc,0xef,0xed,0x87,
+    0x44,0x23,0x33,0x45,0x54,0x43,0x34,0x43,0x33,0x33,0x44,0x34,0x34,0x33,0x23,0x45,
+    0x76,0x67,0x67,0x66,0x81,0x77,0x0c,0x87,0x76,0x66,0x68,0x98,0x54,0x48,0x8a,0xbb,
+    0xcc,0xcb,0xbc,0xcb,0x80,0xbb,0x14,0xaa,0xa9,0xab,0xbb,0xaa,0xcc,0xca,0xcc,0xbc,
+    0xcc,0xcb,0xbb,0xbb,0xaa,0xbb,0xab,0xcc,0xcc,0xca,0xa4,0x54,0x27,0xaa,0xba,0xaa,
+    0xa9,0xaa,0x99,0x89,0x98,0x99,0xaa,0xba,0xba,0xa9,0x27,0xaa,0xbb,0xbb,0xbc,0xcc,
+    0xbc,0xcc,0xcb,0xba,0xac,0xcc,0xab,0xb9,0xa9,0x9a,0xaa,0x87,0x76,0x38,0xaa,0x63,
+    0x11,0x00,0x01,0x33,0x44,0x80,0x55,0x08,0x45,0x43,0x32,0x44,0x43,0x35,0x78,0xab,
+    0xa8,0x80,0x99,0x31,0x9a,0x9b,0xbb,0xbb,0xcb,0xbc,0xdc,0xbc,0xce,0xee,0xdd,0xa7,
+    0x54,0x33,0x33,0x36,0x54,0x43,0x44,0x43,0x34,0x34,0x43,0x33,0x44,0x23,0x33,0x34,
+    0x46,0x67,0x66,0x76,0x76,0x77,0x77,0x75,0x67,0x9b,0xbb,0xaa,0xa9,0x88,0x79,0xaa,
+    0xaa,0xbc,0xcc,0xcb,0xba,0xab,0x81,0xaa,0x12,0xab,0xbb,0xbb,0xdc,0xcb,0xbb,0xba,
+    0xba,0xaa,0xa8,0x9a,0xab,0xab,0xba,0xba,0x77,0xab,0xaa,0x95,0x80,0xaa,0x2f,0x99,
+    0x88,0x89,0x99,0x9a,0xab,0xbb,0xaa,0x99,0x99,0xaa,0xab,0xbc,0xcc,0xca,0xaa,0xbb,
+    0xaa,0xaa,0x88,0x89,0xab,0xbc,0xba,0xaa,0xaa,0x98,0x77,0x96,0x38,0xbc,0xdb,0x53,
+    0x21,0x22,0x23,0x44,0x55,0x54,0x32,0x13,0x45,0x54,0x35,0x54,0x21,0x47,0x78,0x80,
+    0xaa,0x19,0xbb,0xba,0xbc,0xcb,0xcc,0xbc,0xcc,0xcb,0xbb,0xee,0xef,0xcd,0xba,0x64,
+    0x35,0x43,0x36,0x44,0x33,0x55,0x44,0x43,0x44,0x43,0x43,0x44,0x80,0x33,0x01,0x32,
+    0x34,0x80,0x55,0x02,0x44,0x44,0x6b,0x82,0xbb,0x1f,0x97,0xab,0xaa,0xbb,0xab,0xbb,
+    0x9a,0x9a,0xaa,0xaa,0x9a,0xaa,0xbb,0xcc,0xbc,0xcb,0xbb,0xaa,0xbb,0xcc,0xcb,0xaa,
+    0xcc,0x9a,0xbb,0xba,0xaa,0xab,0xbb,0xbc,0xba,0xaa,0x02,0x99,0x99,0xaa,0x82,0xbb,
+    0x1e,0xab,0x9a,0x89,0x98,0x87,0x9a,0xab,0xbb,0xba,0xa9,0xaa,0xab,0xba,0xbb,0xab,
+    0xaa,0xcc,0xba,0x88,0xa9,0x88,0x78,0x77,0x74,0x39,0xcb,0xb9,0x64,0x44,0x22,0x32,
+    0x80,0x44,0x30,0x10,0x00,0x14,0x56,0x55,0x55,0x31,0x04,0x79,0x9a,0x99,0x99,0xab,
+    0xbc,0xcb,0xcb,0xab,0xba,0xba,0xbb,0xcc,0xef,0xee,0xdd,0xbc,0x84,0x43,0x44,0x35,
+    0x44,0x44,0x65,0x43,0x43,0x44,0x43,0x33,0x54,0x33,0x34,0x33,0x32,0x23,0x33,0x33,
+    0x22,0x22,0x35,0x8b,0x81,0xbb,0x20,0xba,0xba,0x89,0xaa,0xa9,0xaa,0x87,0xaa,0xa9,
+    0xa9,0xaa,0xa8,0x8b,0xbc,0xcc,0xcb,0xaa,0xbb,0xbb,0xbc,0xbc,0xcb,0xdc,0xcc,0xcb,
+    0xba,0xaa,0xba,0xaa,0xbb,0xba,0xaa,0x9a,0x05,0xbb,0xbb,0xaa,0xbb,0xaa,0x98,0x80,
+    0x99,0x2a,0xaa,0xaa,0xbb,0xaa,0x98,0x99,0xaa,0xaa,0xba,0xaa,0xcb,0xcc,0xcc,0xbb,
+    0xcb,0xba,0x98,0x88,0x77,0x77,0x87,0x55,0x55,0x2a,0xba,0xaa,0x65,0x33,0x23,0x34,
+    0x33,0x44,0x44,0x33,0x33,0x20,0x35,0x66,0x65,0x31,0x02,0x79,0x9a,0x80,0x99,0x30,
+    0xbc,0xcb,0xaa,0xaa,0xbb,0xaa,0xbe,0xfd,0xfe,0xed,0xdd,0xcd,0x86,0x34,0x36,0x34,
+    0x54,0x44,0x45,0x44,0x44,0x34,0x34,0x44,0x54,0x44,0x33,0x33,0x34,0x33,0x33,0x21,
+    0x21,0x22,0x35,0x8a,0xab,0xaa,0xaa,0xa9,0xaa,0xaa,0xbb,0xbc,0xbc,0xbb,0xcb,0xcc,
+    0xca,0x80,0xaa,0x14,0x8a,0xcd,0xcc,0xba,0x99,0x9a,0xbb,0xcb,0xbc,0xbd,0xcb,0xaa,
+    0xba,0x99,0x99,0xa9,0xaa,0x99,0x99,0x9a,0xaa,0x34,0xba,0xaa,0xba,0xa9,0xa9,0x88,
+    0x88,0x89,0xbb,0xbb,0xba,0x9a,0x99,0xaa,0xbb,0xa8,0x9a,0xba,0xaa,0xbb,0xbc,0xb9,
+    0x9a,0xab,0xba,0xba,0x99,0x88,0x89,0x86,0x57,0x86,0x4a,0xbb,0xa9,0xa8,0x64,0x44,
+    0x34,0x44,0x34,0x44,0x34,0x55,0x55,0x45,0x66,0x65,0x32,0x33,0x5a,0x97,0xac,0x80,
+    0xcc,0x1c,0xca,0xab,0xbc,0xca,0xaa,0xef,0xff,0xed,0xee,0xde,0xbb,0xb7,0x53,0x36,
+    0x33,0x55,0x44,0x44,0x54,0x34,0x34,0x33,0x44,0x44,0x34,0x43,0x43,0x44,0x44,0x80,
+    0x33,0x04,0x34,0x46,0x9a,0xaa,0xab,0x81,0xaa,0x10,0xbb,0xbb,0xbc,0xcc,0xcb,0xbb,
+    0xcb,0xaa,0xbb,0xbb,0xa9,0xbb,0xbb,0xab,0xbc,0xcb,0xcc,0x80,0xcd,0x0a,0xdb,0x9b,
+    0x84,0x99,0x89,0xaa,0xac,0xcc,0xbc,0xbb,0xcc,0x15,0xaa,0xab,0xbb,0xbb,0xaa,0xaa,
+    0xbb,0xb9,0x9b,0xa9,0x99,0x99,0x9a,0xaa,0xaa,0xbb,0xaa,0xbb,0xcb,0xcb,0xbb,0xab,
+    0x82,0xaa,0x09,0x99,0x8b,0x89,0x77,0x65,0x68,0xab,0xaa,0x98,0x74,0x81,0x44,0x0a,
+    0x45,0x33,0x34,0x44,0x55,0x66,0x65,0x45,0x33,0x4b,0xc9,0x80,0xab,0x10,0xba,0xaa,
+    0xcb,0xcb,0xbc,0xcf,0xff,0xff,0xee,0xeb,0xcb,0x89,0x88,0x64,0x55,0x32,0x54,0x80,
+    0x44,0x00,0x43,0x80,0x44,0x00,0x43,0x81,0x44,0x01,0x54,0x33,0x80,0x44,0x07,0x6b,
+    0xca,0xb9,0x9a,0xba,0xbb,0xbb,0xcb,0x81,0xaa,0x1a,0xbb,0xcb,0xcb,0xca,0xbb,0xba,
+    0x98,0x8a,0xab,0xbc,0xbb,0xab,0xbc,0xbb,0xcb,0xba,0xaa,0x9a,0x95,0x9b,0x99,0xaa,
+    0xbc,0xbb,0xaa,0xbc,0xcc,0x0b,0xbc,0xbb,0xba,0xba,0xaa,0xba,0xba,0x9a,0xb9,0xa9,
+    0x9a,0xb9,0x81,0xaa,0x2b,0xa9,0xab,0xbc,0xbc,0xab,0xbb,0xa8,0x68,0x97,0x8a,0xaa,
+    0xaa,0x89,0x99,0x87,0x64,0x69,0x9b,0x98,0x75,0x54,0x45,0x55,0x44,0x55,0x35,0x44,
+    0x34,0x45,0x66,0x66,0x76,0x56,0x34,0x7b,0xba,0xaa,0xba,0xaa,0x6c,0xca,0x7b,0xbb,
+    0xbe,0x80,0xff,0x40,0xfd,0xcb,0x88,0x89,0x88,0x76,0x53,0x33,0x34,0x54,0x44,0x45,
+    0x44,0x43,0x34,0x54,0x44,0x43,0x43,0x44,0x45,0x44,0x34,0x34,0x44,0x56,0xb9,0xbb,
+    0xa9,0xaa,0xbb,0xbc,0xbb,0xbb,0xba,0xaa,0xaa,0xbb,0xbc,0xbb,0xaa,0xaa,0xbb,0xba,
+    0xaa,0xa5,0x8a,0xaa,0xbc,0xbc,0xbb,0xbc,0xba,0xaa,0xaa,0xab,0xbc,0xcc,0xcb,0xbb,
+    0xbc,0xbc,0xbb,0xcb,0xbb,0x0f,0xaa,0xab,0xbb,0xaa,0xaa,0xab,0xab,0x87,0x8a,0xab,
+    0x8a,0xaa,0x9a,0xac,0xaa,0xbc,0x80,0xcc,0x14,0xa9,0x88,0x99,0xab,0xcc,0xa8,0x8a,
+    0xab,0xb7,0x78,0x98,0x97,0x89,0x99,0x89,0x86,0x55,0x65,0x35,0x23,0x45,0x80,0x55,
+    0x54,0x44,0x45,0x66,0x67,0x65,0x55,0x36,0xbb,0xbb,0xba,0xbc,0xcd,0xcd,0xcc,0xb7,
+    0x6e,0xff,0xee,0xed,0xed,0xdb,0xbb,0x87,0x67,0x77,0x66,0x33,0x33,0x34,0x54,0x43,
+    0x54,0x43,0x44,0x34,0x44,0x34,0x44,0x44,0x54,0x54,0x44,0x33,0x44,0x55,0x7b,0x96,
+    0x8a,0xcc,0xbb,0xba,0xa9,0xab,0xb9,0xcb,0xa9,0xcc,0xbb,0xcc,0xba,0xbb,0xab,0xcc,
+    0xcc,0xcb,0xbc,0xbc,0xcc,0xcc,0xdc,0xcb,0xba,0x9b,0xbb,0xab,0xab,0xbc,0xcd,0xcc,
+    0xb9,0x8c,0xcc,0xbc,0xbb,0xbb,0x12,0xab,0x9b,0xcc,0xba,0xbb,0xbc,0xaa,0xbc,0xbc,
+    0xbb,0x99,0x9a,0xbb,0xab,0xbc,0xcc,0xcc,0xbc,0xba,0x81,0x99,0x2f,0xab,0xbc,0xbc,
+    0x9a,0xa6,0x77,0x78,0x87,0x8b,0x77,0x87,0x65,0x55,0x54,0x43,0x43,0x45,0x53,0x35,
+    0x45,0x55,0x55,0x66,0x67,0x53,0x56,0x49,0xcc,0xdc,0xc8,0x7c,0xcd,0x99,0xac,0xcd,
+    0xff,0xff,0xee,0xee,0xed,0xcb,0xa9,0xc8,0x55,0x67,0x65,0x44,0x33,0x80,0x44,0x03,
+    0x45,0x44,0x43,0x43,0x81,0x44,0x00,0x45,0x81,0x44,0x07,0x46,0xbb,0xbb,0xbc,0xcc,
+    0xcc,0xdc,0xcc,0x80,0xbb,0x05,0xcc,0x7b,0x9a,0xcc,0xcc,0xcb,0x80,0xbb,0x14,0xaa,
+    0xac,0xcb,0xba,0xbc,0xcb,0xbb,0xaa,0xbb,0xbb,0xb8,0xaa,0xab,0xab,0xcc,0xbc,0xa9,
+    0xbb,0xcb,0xbb,0xbb,0x80,0xbc,0x4b,0xba,0xaa,0xbb,0xb9,0xcc,0xbb,0xbb,0xb9,0xab,
+    0xba,0xbc,0xcc,0xbd,0xc9,0x9b,0xba,0x99,0x89,0x99,0x9a,0xbb,0xbb,0xcb,0xaa,0x95,
+    0x56,0x46,0x78,0x76,0x57,0x87,0x55,0x56,0x43,0x34,0x34,0x44,0x45,0x55,0x45,0x56,
+    0x66,0x66,0x76,0x63,0x45,0x6c,0xcc,0xcb,0xab,0xbc,0xcb,0xaa,0xab,0xce,0xfe,0xed,
+    0xef,0xfe,0xed,0xdc,0xcb,0x8a,0x96,0x57,0x65,0x42,0x33,0x34,0x45,0x44,0x45,0x44,
+    0x44,0x34,0x34,0x80,0x44,0x0a,0x33,0x33,0x43,0x33,0x34,0x59,0xbb,0xbc,0xcc,0xbc,
+    0xcc,0x82,0xbb,0x1d,0xba,0xbb,0xcc,0xba,0xab,0xaa,0x9a,0xaa,0xaa,0xa9,0x9a,0xba,
+    0x9b,0xcb,0xbc,0xcc,0xca,0x97,0x79,0x98,0x9a,0xb9,0xaa,0xaa,0xbc,0xba,0xcb,0xba,
+    0xab,0xbb,0x48,0x8b,0xbb,0xbb,0xba,0x9a,0xbb,0xbb,0xab,0xcc,0xcc,0xa9,0x89,0xaa,
+    0xab,0xbb,0xbb,0xba,0x87,0x89,0xaa,0x9a,0xa9,0x9b,0xbb,0xcb,0xcc,0xb8,0x85,0x55,
+    0x56,0x78,0x75,0x47,0x86,0x55,0x54,0x33,0x44,0x33,0x33,0x34,0x44,0x44,0x56,0x66,
+    0x66,0x76,0x53,0x55,0x8b,0xcb,0xcc,0xbc,0xcc,0xbb,0xa9,0xaa,0xfe,0xdc,0xef,0xfe,
+    0xfe,0xed,0xdd,0xcb,0xa8,0x89,0x55,0x66,0x64,0x43,0x34,0x45,0x81,0x44,0x05,0x33,
+    0x43,0x44,0x44,0x51,0x12,0x80,0x34,0x29,0x56,0x86,0xac,0xcd,0xcc,0xcc,0xdc,0xbc,
+    0xcc,0xba,0xbb,0xaa,0x93,0xab,0xb9,0xb4,0x8c,0xbb,0xba,0xa9,0x9a,0xaa,0xaa,0xcc,
+    0xbb,0xbc,0xcc,0xba,0xbc,0xcb,0x9a,0x99,0xaa,0x98,0x99,0x9a,0xaa,0xbb,0xbb,0xa9,
+    0x98,0xab,0x03,0x89,0xa9,0xaa,0xaa,0x80,0xbb,0x1d,0xcc,0xcc,0xba,0xa9,0x88,0x9a,
+    0x99,0x88,0xaa,0x99,0x77,0x65,0x88,0xaa,0xab,0xab,0xbb,0xcc,0xcc,0xba,0x75,0x45,
+    0x56,0x97,0x86,0x56,0x66,0x55,0x54,0x44,0x80,0x33,0x32,0x34,0x44,0x44,0x55,0x66,
+    0x77,0x65,0x44,0x55,0x79,0x9a,0xab,0xbb,0xba,0xaa,0xbb,0x5e,0xda,0xbe,0xff,0xee,
+    0xed,0xdc,0xcb,0xb9,0x88,0x66,0x85,0x66,0x54,0x34,0x33,0x34,0x44,0x44,0x54,0x44,
+    0x34,0x44,0x44,0x45,0x42,0x02,0x13,0x24,0x54,0x5b,0xb8,0x9a,0x97,0xab,0x80,0xbc,
+    0x21,0xbb,0xaa,0x88,0x89,0x99,0x9c,0xab,0xb7,0x7a,0xcb,0xbc,0xcb,0xbb,0xaa,0xac,
+    0xcc,0xbb,0xba,0xba,0xaa,0xcc,0xc8,0x88,0x57,0x79,0xa8,0xaa,0xa9,0x9a,0xaa,0xad,
+    0xaa,0xaa,0xbb,0x45,0xaa,0xaa,0x9a,0xaa,0xaa,0xba,0xab,0xbc,0xbc,0xcc,0xcb,0xa9,
+    0x99,0xaa,0x9a,0xa9,0x98,0x88,0x87,0x77,0x88,0x8a,0x9b,0x7a,0xcb,0xcd,0xcb,0xc6,
+    0x65,0x56,0x67,0x76,0x77,0x65,0x55,0x54,0x32,0x23,0x45,0x34,0x33,0x45,0x53,0x56,
+    0x56,0x66,0x65,0x54,0x56,0x8a,0xaa,0xaa,0xa9,0xaa,0xac,0xdc,0xec,0xab,0xef,0xff,
+    0xed,0xdc,0xbb,0xa9,0x87,0x77,0x65,0x66,0x66,0x65,0x81,0x44,0x00,0x33,0x80,0x44,
+    0x11,0x34,0x44,0x44,0x43,0x22,0x23,0x23,0x22,0xbc,0xba,0x7a,0xbb,0xcb,0xbc,0xbc,
+    0xcc,0xbb,0xa9,0x80,0x9a,0x03,0xab,0x89,0xba,0x9b,0x81,0xcc,0x0c,0xcb,0xcc,0xaa,
+    0x99,0xa8,0xab,0xcc,0xbb,0xb8,0x67,0x68,0x99,0xbc,0x80,0xcc,0x04,0xbb,0xaa,0x9a,
+    0xcc,0xbc,0x0c,0x98,0x87,0x78,0x88,0x88,0x99,0xaa,0xab,0xbc,0xbc,0xcb,0xaa,0xaa,
+    0x80,0xbb,0x23,0xc6,0x89,0x98,0x88,0x88,0x99,0x7c,0xcc,0xcc,0xbc,0xbc,0xb5,0x66,
+    0x43,0x59,0x88,0xb8,0x65,0x55,0x54,0x20,0x00,0x01,0x03,0x33,0x33,0x54,0x45,0x66,
+    0x67,0x55,0x56,0x56,0x89,0xab,0xcb,0x80,0xcc,0x13,0xcd,0xd9,0x9d,0xff,0xed,0xdd,
+    0xcb,0xb9,0x87,0x66,0x66,0x65,0x56,0x55,0x56,0x43,0x44,0x43,0x44,0x43,0x80,0x34,
+    0x31,0x43,0x44,0x44,0x33,0x22,0x33,0x32,0x24,0xcb,0xbb,0x8a,0xbb,0xbc,0xcc,0xdc,
+    0xcc,0xb9,0x99,0x9a,0x99,0xaa,0xa9,0xaa,0x9a,0xaa,0xac,0xbb,0xcb,0xbb,0xa9,0xaa,
+    0xaa,0xbb,0xba,0xab,0xbc,0xcc,0xcb,0xb9,0x88,0x6b,0xbb,0xcb,0xab,0xaa,0xbc,0x7a,
+    0x9a,0xaa,0xcb,0x02,0x87,0x78,0x88,0x80,0x99,0x1e,0x9a,0xab,0xbb,0xcc,0xbb,0xa9,
+    0xaa,0x9a,0xba,0x98,0x99,0xb9,0xaa,0xaa,0x98,0xbb,0xcc,0xdc,0xbc,0xac,0xba,0x76,
+    0x65,0x57,0xad,0xb8,0x6a,0x85,0x55,0x54,0x21,0x82,0x00,0x1d,0x44,0x56,0x66,0x66,
+    0x21,0x33,0x66,0x99,0xaa,0xcc,0xcb,0xcc,0xcc,0xde,0xa7,0xbf,0xfe,0xed,0xdc,0xca,
+    0xa8,0x77,0x65,0x65,0x66,0x56,0x55,0x56,0x53,0x33,0x80,0x44,0x01,0x34,0x34,0x80,
+    0x44,0x09,0x54,0x43,0x32,0x11,0x22,0x27,0xaa,0xab,0x99,0xcb,0x80,0xcc,0x07,0xba,
+    0x88,0xa9,0x99,0xaa,0x9a,0xaa,0xba,0x80,0xbb,0x17,0xcb,0xbb,0xbb,0xb9,0xa9,0xa9,
+    0xba,0xaa,0xbb,0xcc,0xbb,0xcc,0xba,0xa9,0x8a,0xbc,0xcc,0xcb,0x99,0x98,0x89,0x99,
+    0xaa,0xcb,0x02,0xa9,0xaa,0xab,0x81,0xbb,0x01,0x99,0x9a,0x80,0xaa,0x3b,0xbb,0x9a,
+    0x88,0x68,0x8a,0xab,0xbc,0xcb,0xcc,0xbc,0xcc,0xa9,0x87,0x68,0x76,0x58,0xbc,0xee,
+    0xda,0x77,0xcd,0x96,0x55,0x54,0x31,0x00,0x11,0x00,0x00,0x01,0x24,0x56,0x66,0x65,
+    0x11,0x25,0x79,0x99,0xbc,0xc9,0x99,0xbb,0xbb,0xec,0x89,0xff,0xee,0xdd,0xcc,0xa9,
+    0x87,0x66,0x56,0x56,0x55,0x56,0x65,0x55,0x44,0x45,0x80,0x44,0x19,0x43,0x33,0x44,
+    0x44,0x45,0x54,0x44,0x44,0x22,0x24,0x6b,0xbb,0xba,0x98,0xbb,0xab,0xba,0xbc,0xcb,
+    0x98,0xa9,0xab,0xbb,0xcb,0xb9,0xab,0x80,0xbb,0x17,0xbc,0xcc,0xcc,0x37,0x98,0x9a,
+    0xaa,0xba,0xab,0xbb,0xbc,0xbc,0xcc,0xcb,0x9b,0xba,0xaa,0xaa,0xab,0xba,0xaa,0xbc,
+    0xbb,0x9a,0x4d,0xaa,0xa8,0xaa,0xba,0xaa,0xaa,0xab,0xbc,0xaa,0x9a,0xa9,0x9a,0xaa,
+    0xab,0x87,0x99,0xab,0xcc,0xcb,0xbb,0xbc,0xcc,0xb9,0xbc,0x84,0x55,0xae,0xcd,0xff,
+    0xdc,0xa7,0x8c,0xda,0xa6,0x55,0x54,0x32,0x11,0x01,0x00,0x00,0x02,0x45,0x56,0x66,
+    0x62,0x12,0x57,0x8b,0xa8,0xaa,0x93,0x36,0x59,0x9d,0xd8,0x7d,0xfe,0xde,0xdc,0xba,
+    0x9a,0x76,0x66,0x56,0x56,0x65,0x55,0x65,0x55,0x55,0x44,0x34,0x34,0x44,0x44,0x33,
+    0x34,0x80,0x44,0x12,0x43,0x34,0x43,0x47,0xcb,0xba,0xac,0xc8,0xac,0xac,0xbb,0xb9,
+    0x9a,0xcb,0xcb,0xbc,0xbb,0xbb,0xba,0x80,0xbb,0x0e,0xcd,0xcd,0xdc,0xcc,0xbb,0xab,
+    0x99,0x99,0x9a,0x9a,0xaa,0x9a,0xaa,0xbb,0xcb,0x81,0xbb,0x05,0xcb,0xbc,0xbb,0xab,
+    0xaa,0x99,0x04,0xa9,0x9a,0xbb,0xab,0xab,0x80,0xbb,0x08,0xba,0xaa,0xa9,0x9a,0xa9,
+    0xaa,0xbb,0xc8,0xac,0x80,0xbb,0x33,0xbc,0xca,0xcc,0xd7,0x44,0x4c,0xff,0xee,0xdd,
+    0xdc,0xba,0xba,0x96,0x67,0x55,0x54,0x43,0x21,0x11,0x00,0x00,0x35,0x55,0x66,0x66,
+    0x32,0x13,0x68,0xab,0xaa,0xaa,0xba,0x95,0x15,0xcd,0x98,0x9f,0xed,0xed,0xcc,0xaa,
+    0x98,0x66,0x56,0x65,0x65,0x56,0x55,0x66,0x55,0x55,0x34,0x82,0x44,0x2c,0x33,0x43,
+    0x44,0x54,0x54,0x44,0x55,0x69,0xba,0x9a,0xb8,0x78,0x79,0x99,0x9b,0xbb,0x97,0xcb,
+    0xba,0x9a,0xa9,0xab,0xbb,0xbc,0xcc,0xcd,0xcd,0xdc,0xcc,0xcb,0xbb,0xcb,0xcb,0xaa,
+    0xa9,0x8a,0xaa,0xaa,0xac,0xcc,0xa9,0x99,0xaa,0x89,0xbc,0x80,0xbb,0x02,0xba,0xa9,
+    0xa9,0x02,0xa9,0xaa,0xb9,0x80,0xab,0x4a,0xbb,0xca,0xaa,0x98,0x89,0x9a,0xa9,0xab,
+    0xb8,0x7a,0x69,0x7a,0xcc,0xbb,0x79,0xcc,0xbc,0x76,0x45,0xdf,0xdc,0xaa,0x88,0x77,
+    0x66,0x69,0x76,0x57,0x55,0x55,0x44,0x21,0x23,0x21,0x23,0x55,0x55,0x56,0x64,0x11,
+    0x33,0x59,0x99,0x9a,0xaa,0xab,0xba,0x8a,0xdc,0x86,0xff,0xee,0xdc,0xdb,0x99,0x87,
+    0x66,0x56,0x65,0x65,0x56,0x55,0x56,0x65,0x55,0x43,0x44,0x45,0x45,0x55,0x52,0x22,
+    0x34,0x44,0x44,0x80,0x54,0x00,0x69,0x80,0xbb,0x10,0x97,0x87,0x88,0x9a,0xcc,0xcb,
+    0xba,0xaa,0x99,0x9a,0xab,0xbb,0xbb,0xcc,0xcc,0xcb,0xbc,0x80,0xbb,0x02,0xcc,0xcb,
+    0xcb,0x80,0xbb,0x0d,0xaa,0xad,0xcc,0xaa,0xa8,0xba,0xab,0xbb,0xbb,0xa9,0x8a,0xab,
+    0xaa,0xa9,0x3d,0x8a,0xa7,0x8b,0xbc,0xac,0xbb,0xba,0xbb,0x9a,0x98,0x88,0x78,0x89,
+    0xa9,0xaa,0x9b,0xb7,0x79,0xcb,0xcc,0xcc,0xcb,0xb7,0x8a,0x8d,0xdb,0xaa,0x98,0x87,
+    0x66,0x57,0x67,0x55,0x77,0x55,0x55,0x54,0x43,0x22,0x22,0x35,0x56,0x56,0x66,0x31,
+    0x12,0x43,0x35,0xaa,0xbb,0xbc,0xbc,0xbb,0xbc,0xd9,0x7b,0xfd,0xed,0xdd,0xba,0x98,
+    0x86,0x81,0x65,0x23,0x55,0x65,0x66,0x65,0x55,0x54,0x34,0x45,0x45,0x55,0x40,0x22,
+    0x23,0x34,0x44,0x54,0x44,0x56,0x8a,0xbb,0xbb,0xcc,0xc9,0xa8,0x89,0x79,0x9b,0xba,
+    0x99,0x99,0x88,0x99,0xaa,0x8a,0xaa,0xab,0x80,0xbb,0x16,0xbc,0xcc,0xcc,0xbb,0xbb,
+    0xbc,0xcc,0xcb,0xbb,0xa9,0x99,0x99,0x9b,0x89,0x88,0x89,0xab,0x88,0xa9,0x99,0xaa,
+    0xa9,0xaa,0x62,0x99,0xa9,0x78,0xa9,0x88,0x9a,0xaa,0xaa,0xa9,0x99,0x88,0x78,0x8a,
+    0x7b,0xba,0xab,0xbc,0xcc,0x9c,0xcc,0xbc,0xbb,0xbc,0xc9,0xce,0xbb,0x98,0x79,0x87,
+    0x56,0x65,0x56,0x55,0x97,0x55,0x55,0x54,0x44,0x43,0x44,0x55,0x56,0x66,0x54,0x12,
+    0x23,0x55,0x34,0x59,0x9a,0x9a,0xaa,0xbb,0xbd,0xc8,0x7f,0xee,0xed,0xda,0xa9,0x97,
+    0x86,0x65,0x65,0x56,0x55,0x56,0x55,0x66,0x66,0x65,0x55,0x44,0x44,0x45,0x54,0x20,
+    0x11,0x22,0x34,0x44,0x45,0x55,0x68,0xcc,0xcc,0xac,0xcc,0xa9,0xaa,0xac,0xbc,0xa8,
+    0x96,0x78,0x99,0xbb,0xaa,0xaa,0x80,0xab,0x19,0xba,0xab,0xb9,0xa9,0xab,0xaa,0xbc,
+    0xcc,0xab,0xbc,0xb8,0xbb,0xbb,0xaa,0x9a,0x9a,0xb9,0xab,0x8a,0xaa,0x94,0x7a,0xba,
+    0xa9,0x98,0x6a,0x06,0x89,0x99,0x89,0xa9,0x98,0x88,0x9a,0x80,0x99,0x04,0x8a,0x6c,
+    0xcb,0x98,0x9a,0x80,0xaa,0x41,0xab,0xaa,0xa9,0xb9,0xab,0xbc,0xeb,0xa9,0x86,0x78,
+    0x76,0x65,0x56,0x55,0x64,0xb8,0x64,0x55,0x54,0x45,0x45,0x55,0x55,0x66,0x66,0x52,
+    0x12,0x23,0x35,0x44,0x46,0x88,0xab,0xbb,0xcc,0xce,0xa7,0xae,0xee,0xdc,0xab,0x99,
+    0x87,0x66,0x56,0x56,0x66,0x65,0x55,0x65,0x66,0x65,0x65,0x55,0x44,0x45,0x45,0x43,
+    0x02,0x11,0x11,0x13,0x34,0x45,0x67,0x9c,0x80,0xcc,0x0b,0xca,0xa9,0xbb,0xcc,0xcc,
+    0xba,0x52,0x67,0x78,0x88,0xba,0xba,0x80,0xaa,0x19,0xab,0xaa,0xba,0x67,0x88,0x98,
+    0x9a,0xab,0xbb,0xac,0x97,0xba,0xaa,0xa9,0x8a,0xbb,0xbc,0xbb,0x89,0x99,0x99,0x9b,
+    0x97,0x9a,0x98,0x9b,0x80,0x99,0x50,0xa9,0x89,0x99,0x9a,0x99,0xaa,0xab,0xcc,0xab,
+    0xba,0xba,0xaa,0x9a,0xa9,0xaa,0xa6,0x55,0x67,0x5a,0xab,0xbe,0xd9,0xa8,0x75,0x68,
+    0x75,0x55,0x55,0x65,0x64,0x99,0x55,0x45,0x55,0x44,0x54,0x55,0x55,0x66,0x55,0x32,
+    0x11,0x33,0x45,0x55,0x45,0x67,0x88,0xb9,0xb8,0x9e,0x97,0xee,0xee,0xdb,0xba,0x97,
+    0x77,0x66,0x56,0x55,0x56,0x55,0x55,0x65,0x66,0x66,0x65,0x55,0x44,0x44,0x45,0x43,
+    0x03,0x11,0x01,0x13,0x34,0x56,0x9c,0xbb,0x80,0xcc,0x09,0xa8,0x9a,0xbc,0xcb,0xcb,
+    0xba,0x94,0x66,0x87,0x68,0x81,0xaa,0x1a,0xba,0xaa,0xaa,0xbb,0x98,0x89,0x99,0x9a,
+    0x9a,0xa8,0x9a,0x76,0x9a,0x89,0x98,0x99,0x8c,0xbb,0xa9,0x99,0x8b,0xa9,0x76,0x64,
+    0x6a,0xbb,0xab,0x09,0x99,0x99,0x9a,0xba,0x99,0x89,0x89,0xaa,0xab,0xca,0x80,0x99,
+    0x72,0xa8,0x89,0x99,0xab,0xbb,0xb8,0x22,0x11,0x29,0x8a,0xdd,0xc8,0xa8,0x66,0x68,
+    0x66,0x56,0x55,0x55,0x54,0x88,0x65,0x45,0x55,0x55,0x45,0x55,0x66,0x65,0x54,0x22,
+    0x12,0x33,0x44,0x55,0x55,0x57,0x7a,0xbb,0xbb,0xdd,0x89,0xee,0xec,0xba,0xaa,0x87,
+    0x76,0x65,0x65,0x66,0x56,0x54,0x45,0x66,0x66,0x56,0x56,0x65,0x55,0x45,0x54,0x43,
+    0x12,0x20,0x11,0x22,0x23,0x56,0x7a,0xab,0xbb,0xcb,0xa8,0x9b,0xbb,0xbb,0xaa,0x99,
+    0xab,0xb8,0x99,0x78,0x8a,0xab,0xbc,0xcb,0xbb,0xab,0xab,0xbc,0xb9,0x99,0x96,0x79,
+    0xaa,0xa9,0x9a,0xaa,0x76,0xa9,0x99,0xbb,0x97,0x6a,0xaa,0x79,0x89,0x89,0x99,0x64,
+    0x88,0x78,0x99,0xa9,0x1c,0xaa,0x9a,0x9b,0xba,0x89,0xaa,0x9a,0x9a,0xbb,0xb8,0x89,
+    0x98,0x57,0x73,0x58,0x99,0x8a,0xaa,0x87,0x42,0x22,0x35,0xba,0xbb,0xa8,0xb7,0x55,
+    0x68,0x65,0x80,0x55,0x22,0x44,0x67,0x55,0x45,0x45,0x54,0x45,0x56,0x65,0x55,0x53,
+    0x32,0x12,0x33,0x44,0x55,0x65,0x55,0x9a,0x9b,0xaa,0xdc,0x8c,0xef,0xca,0xbb,0xa9,
+    0x77,0x76,0x66,0x55,0x66,0x56,0x55,0x45,0x80,0x66,0x1e,0x65,0x56,0x55,0x44,0x44,
+    0x42,0x22,0x41,0x02,0x11,0x13,0x55,0x68,0xab,0xab,0xba,0x88,0x78,0x99,0xaa,0x9b,
+    0xaa,0xbb,0xba,0xbc,0xcc,0xab,0xba,0xb9,0xbc,0xac,0x80,0xbb,0x17,0x98,0x9a,0x89,
+    0x99,0xab,0xa9,0x88,0xaa,0x88,0xba,0x88,0x8a,0xa8,0x99,0xaa,0x98,0xa9,0x9a,0xaa,
+    0xa8,0x68,0x88,0x96,0x8a,0x1b,0x88,0x9a,0xbb,0xab,0xca,0xa9,0xa9,0xaa,0xaa,0x89,
+    0x88,0x74,0x17,0x87,0x57,0x88,0x89,0x9a,0x97,0x63,0x23,0x37,0xdc,0xbd,0x97,0x96,
+    0x66,0x56,0x80,0x65,0x03,0x55,0x44,0x56,0x54,0x80,0x45,0x81,0x55,0x3c,0x43,0x43,
+    0x13,0x34,0x44,0x55,0x56,0x56,0x6a,0xb9,0xab,0xcb,0x8d,0xfc,0xab,0xba,0x98,0x77,
+    0x66,0x65,0x66,0x55,0x65,0x54,0x45,0x56,0x66,0x56,0x65,0x65,0x55,0x34,0x33,0x22,
+    0x32,0x42,0x01,0x11,0x34,0x66,0x57,0xaa,0xcc,0xba,0x98,0x88,0x9a,0xaa,0x98,0x9a,
+    0x9a,0xbc,0xcc,0xba,0xbb,0xc7,0xac,0x7a,0xcc,0xcc,0xba,0x80,0xbb,0x15,0x9b,0xba,
+    0x9b,0xa6,0x59,0x99,0xa9,0x98,0x88,0x98,0x99,0x9a,0xbb,0x97,0x9a,0x99,0x68,0x86,
+    0x79,0x88,0xaa,0xaa,0x19,0x99,0x9a,0xbb,0xb9,0x99,0x98,0xaa,0xa8,0x48,0x88,0x89,
+    0x85,0x34,0x98,0x97,0x98,0x89,0x89,0x66,0x96,0x44,0x6a,0xdc,0xdb,0x76,0x96,0x81,
+    0x65,0x3d,0x55,0x55,0x45,0x45,0x55,0x45,0x45,0x54,0x55,0x55,0x54,0x54,0x34,0x42,
+    0x13,0x44,0x44,0x55,0x56,0x56,0x68,0xab,0xcc,0xdb,0x9e,0xb9,0xbc,0xba,0x87,0x76,
+    0x65,0x65,0x56,0x65,0x66,0x54,0x35,0x66,0x66,0x55,0x66,0x56,0x55,0x44,0x34,0x34,
+    0x41,0x43,0x10,0x22,0x24,0xab,0x76,0xbb,0xaa,0x89,0xab,0x9a,0xaa,0xb9,0xaa,0xab,
+    0x80,0xcc,0x02,0xaa,0xbc,0xcb,0x80,0xbc,0x1a,0xbb,0xcc,0xaa,0xaa,0x87,0x8b,0xa9,
+    0x99,0x99,0xba,0x99,0x87,0x77,0x79,0x89,0x89,0xac,0xbb,0xaa,0xba,0xa9,0x99,0x89,
+    0x9a,0xbb,0x9a,0xbc,0x22,0xaa,0xaa,0xa9,0x99,0x89,0xaa,0xaa,0xa8,0x23,0x59,0x9a,
+    0x96,0x68,0x69,0xa9,0x99,0x9a,0xb9,0x9a,0xb9,0xa8,0xad,0xbc,0xd8,0x76,0x86,0x55,
+    0x66,0x65,0x56,0x56,0x55,0x35,0x55,0x54,0x80,0x45,0x17,0x55,0x45,0x55,0x43,0x24,
+    0x32,0x12,0x33,0x34,0x55,0x65,0x66,0x66,0x9b,0xbb,0xec,0xbc,0x9b,0xcb,0xa9,0x87,
+    0x67,0x66,0x56,0x80,0x65,0x20,0x54,0x35,0x56,0x66,0x56,0x66,0x55,0x65,0x53,0x44,
+    0x44,0x41,0x33,0x21,0x01,0x13,0x9a,0x88,0x98,0x68,0x59,0x99,0xba,0xbb,0x98,0x98,
+    0x9a,0xbb,0xba,0xba,0xa8,0xaa,0xab,0x80,0xbb,0x0d,0xbc,0xbb,0xbb,0xba,0xa6,0xa9,
+    0x98,0xa9,0x98,0x9a,0xa7,0x88,0xa9,0xba,0x82,0xaa,0x01,0x85,0x9a,0x81,0xbb,0x01,
+    0xac,0xcb,0x5b,0x98,0x99,0x99,0x89,0x89,0xaa,0x99,0xa9,0x98,0x79,0x9a,0x83,0x76,
+    0x97,0x99,0xac,0xb9,0x9a,0xa9,0x9a,0xaa,0xcc,0x9c,0xc7,0x65,0x76,0x55,0x65,0x65,
+    0x55,0x56,0x55,0x44,0x54,0x55,0x45,0x45,0x44,0x55,0x45,0x44,0x33,0x45,0x42,0x22,
+    0x23,0x34,0x55,0x56,0x66,0x66,0x7a,0xab,0xec,0xd9,0xbc,0xcb,0xa9,0x77,0x67,0x65,
+    0x65,0x66,0x65,0x56,0x54,0x35,0x66,0x66,0x55,0x66,0x65,0x66,0x55,0x54,0x44,0x30,
+    0x14,0x21,0x01,0x22,0x9b,0xb9,0xab,0xca,0x9a,0xbc,0xbb,0x9a,0xb9,0x99,0x68,0x80,
+    0x99,0x16,0x89,0xab,0xcb,0xbc,0xaa,0xbb,0xbb,0xba,0xaa,0xaa,0xba,0xba,0x9a,0x98,
+    0x88,0x77,0x77,0x78,0xab,0xba,0xaa,0xaa,0x99,0x80,0xa9,0x06,0x9a,0xaa,0xba,0xaa,
+    0xbb,0xaa,0xaa,0x01,0x99,0x89,0x80,0x99,0x18,0xaa,0xba,0xa9,0xaa,0x9a,0xa7,0x36,
+    0x87,0x6a,0xba,0x89,0x8a,0x5a,0x99,0x99,0x88,0xd8,0x9d,0x96,0x66,0x76,0x56,0x56,
+    0x55,0x65,0x80,0x55,0x01,0x45,0x44,0x83,0x54,0x01,0x33,0x54,0x80,0x33,0x0d,0x45,
+    0x56,0x66,0x66,0x67,0x67,0xcc,0xdc,0x9b,0xdc,0xcc,0xa8,0x77,0x76,0x80,0x56,0x07,
+    0x65,0x65,0x53,0x35,0x56,0x65,0x56,0x56,0x80,0x55,0x17,0x44,0x44,0x42,0x14,0x31,
+    0x00,0x11,0x5a,0x74,0x38,0xab,0xab,0xaa,0xcc,0xcc,0xb9,0x9b,0xaa,0xab,0xaa,0xac,
+    0xba,0xbb,0xaa,0x80,0xbb,0x00,0xba,0x80,0xab,0x16,0xbb,0xbb,0xaa,0x99,0x98,0x87,
+    0x8a,0xbc,0xbb,0xaa,0xa9,0xaa,0xa9,0x98,0x99,0x98,0x99,0x9a,0xaa,0xaa,0x9a,0xbb,
+    0xaa,0x2f,0xaa,0xa8,0x9a,0x99,0x99,0xa8,0x8b,0xb8,0x9b,0x7a,0x75,0x8a,0xb9,0xaa,
+    0xa9,0x9a,0x99,0x88,0x88,0x99,0x9a,0xa7,0x9c,0x86,0x56,0x66,0x45,0x66,0x65,0x56,
+    0x56,0x54,0x55,0x55,0x54,0x54,0x55,0x54,0x44,0x43,0x43,0x35,0x55,0x34,0x43,0x34,
+    0x66,0x65,0x80,0x66,0x29,0x78,0xad,0xcc,0xad,0xdc,0xcb,0xa8,0x76,0x66,0x65,0x56,
+    0x65,0x65,0x66,0x53,0x35,0x66,0x65,0x56,0x56,0x65,0x66,0x55,0x66,0x76,0x52,0x03,
+    0x41,0x10,0x21,0x34,0x33,0x26,0xaa,0x98,0xaa,0xcc,0xdc,0xd8,0x5a,0xab,0x9a,0x80,
+    0xab,0x1f,0x9c,0xba,0x8a,0xbb,0xb9,0xbb,0xba,0xbb,0xbb,0xcb,0xbb,0xbb,0xa9,0x9a,
+    0xab,0xaa,0xbb,0xaa,0x98,0x88,0x99,0x9a,0x98,0x98,0x99,0x8a,0xab,0xbb,0xab,0xaa,
+    0xaa,0xbb,0x7f,0x79,0xbb,0xaa,0xaa,0xac,0xbb,0xba,0xaa,0x9a,0xaa,0xab,0xaa,0xaa,
+    0xab,0xab,0xaa,0x9a,0xa9,0x99,0x99,0x9d,0xa7,0x9b,0x76,0x55,0x56,0x45,0x56,0x55,
+    0x65,0x55,0x55,0x45,0x45,0x55,0x45,0x54,0x55,0x55,0x44,0x43,0x45,0x54,0x44,0x43,
+    0x45,0x66,0x55,0x55,0x56,0x66,0x78,0xad,0xda,0xed,0xdc,0xcb,0xa8,0x77,0x76,0x56,
+    0x65,0x66,0x56,0x56,0x53,0x45,0x56,0x65,0x55,0x66,0x65,0x56,0x55,0x67,0x77,0x52,
+    0x02,0x41,0x01,0x21,0x25,0x56,0x87,0xaa,0x99,0xab,0xba,0x9a,0xcc,0x8a,0x99,0xab,
+    0xba,0xbd,0xbb,0xaa,0xac,0xbb,0xaa,0x97,0x9b,0xbc,0xba,0xcc,0xac,0xbb,0xba,0xab,
+    0xbb,0xcb,0xa9,0xaa,0x99,0x95,0x68,0x89,0x89,0x99,0x9a,0x9a,0xab,0xbc,0xbc,0xcb,
+    0xba,0xac,0xb9,0x67,0xaa,0xbb,0xab,0xbc,0xcc,0xbc,0xba,0x99,0x87,0x87,0x9a,0xaa,
+    0xab,0xbb,0xba,0x58,0xba,0xaa,0xab,0xba,0xcc,0x97,0x8a,0x66,0x66,0x46,0x45,0x66,
+    0x55,0x65,0x56,0x54,0x45,0x54,0x55,0x45,0x55,0x45,0x54,0x55,0x54,0x55,0x54,0x45,
+    0x44,0x56,0x54,0x45,0x56,0x66,0x67,0x78,0xbc,0xdd,0xed,0xcc,0xca,0x97,0x66,0x76,
+    0x55,0x65,0x66,0x65,0x56,0x52,0x45,0x66,0x65,0x65,0x66,0x66,0x56,0x55,0x55,0x54,
+    0x31,0x01,0x51,0x00,0x21,0x14,0x88,0x77,0xa9,0x99,0x99,0x9a,0xa8,0xaa,0xaa,0xba,
+    0xbc,0xbb,0xcb,0xaa,0xa9,0xaa,0xaa,0xba,0xbb,0xab,0xcb,0xb9,0x81,0xbb,0x0e,0xab,
+    0xbc,0xc9,0x99,0xaa,0x87,0x99,0x88,0x99,0x7a,0xb9,0xab,0xcc,0xba,0xaa,0x80,0xbb,
+    0x01,0xaa,0xaa,0x00,0x9a,0x80,0xbb,0x1b,0xaa,0xbb,0xaa,0x98,0x67,0x77,0x8a,0xbb,
+    0xbc,0xbc,0xc9,0xab,0xcb,0xba,0x99,0xad,0xcb,0x86,0x7a,0x66,0x55,0x55,0x46,0x66,
+    0x55,0x56,0x55,0x64,0x80,0x45,0x53,0x55,0x45,0x54,0x55,0x44,0x45,0x55,0x54,0x44,
+    0x34,0x66,0x44,0x45,0x55,0x66,0x66,0x79,0xac,0xbe,0xee,0xcd,0xca,0x87,0x76,0x66,
+    0x65,0x66,0x56,0x56,0x66,0x42,0x45,0x66,0x55,0x56,0x55,0x66,0x55,0x65,0x55,0x55,
+    0x51,0x01,0x41,0x11,0x12,0x13,0x67,0x68,0xba,0xab,0x98,0x89,0x9b,0xbc,0xc8,0xbb,
+    0xcd,0x7c,0xcb,0xa9,0x9a,0x99,0xaa,0xab,0xab,0xaa,0xab,0xab,0xbc,0xbc,0xcb,0xa8,
+    0xa9,0xbb,0xcb,0xaa,0x9a,0x9a,0xab,0xac,0xbc,0xcb,0xba,0x81,0xbb,0x00,0xba,0x80,
+    0xbb,0x00,0xbc,
+};
+
+static const struct ssd1322_image image_beach =
+    { image_beach_data, 8035, 256, 64 };
+
+#endif
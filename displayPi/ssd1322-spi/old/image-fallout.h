@@ -0,0 +1,493 @@
+/*
+    Image fallout, generated by imageconvert.
+*/
+
+#ifndef IMAGE_FALLOUT_H
+#define IMAGE_FALLOUT_H
+
+#include "ssd1322-image.h"
+
+static const uint8_t image_fallout_data0[] =
+{
+    0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x92,0x00,
+    0x01,0x1a,0x60,0x86,0x00,0x8d,0x00,0x06,0x60,0x00,0x09,0xfc,0x57,0xed,0xe4,0x86,
+    0x00,0x8c,0x00,0x03,0x05,0x90,0x00,0xcd,0x81,0xdd,0x00,0x54,0x85,0x00,0x8c,0x00,
+    0x02,0x0a,0xe9,0x7e,0x83,0xdd,0x00,0xa0,0x84,0x00,0x8c,0x00,0x09,0x0a,0xdd,0xde,
+    0xbc,0xdd,0xde,0xed,0xdd,0xdd,0xe1,0x84,0x00,0x8c,0x00,0x09,0x02,0xee,0xd2,0xa4,
+    0x8b,0x83,0x19,0xed,0xdd,0xdc,0x84,0x00,0x8c,0x00,0x0a,0x01,0x12,0x49,0xde,0xa9,
+    0xef,0xf4,0x8d,0xdc,0xed,0xb0,0x83,0x00,0x8c,0x00,0x0a,0x01,0x5f,0x16,0xce,0xee,
+    0xea,0xbf,0x62,0x69,0x49,0xd6,0x83,0x00,0x8d,0x00,0x09,0xae,0xed,0xee,0xee,0xe8,
+    0x0d,0xde,0xee,0xe6,0xfa,0x83,0x00,0x8c,0x00,0x01,0x01,0xfd,0x80,0xee,0x05,0xed,
+    0xc7,0xee,0xee,0xf7,0xeb,0x83,0x00,0x8c,0x00,0x03,0x0a,0xe0,0x5e,0xed,0x81,0xee,
+    0x02,0xed,0x89,0xdb,0x83,0x00,0x8c,0x00,0x0a,0x1f,0xb0,0xae,0xd8,0xee,0xcb,0xee,
+    0xee,0xed,0x2e,0xd8,0x83,0x00,0x8c,0x00,0x0a,0x9e,0xef,0xeb,0x3f,0xee,0x01,0xfe,
+    0xee,0xe6,0xa5,0xe1,0x83,0x00,0x8c,0x00,0x0a,0xfe,0xee,0x66,0xfe,0xed,0x09,0xee,
+    0xee,0xb9,0x47,0x90,0x83,0x00,0x8b,0x00,0x03,0x01,0xfe,0xee,0x7c,0x81,0xee,0x02,
+    0xef,0x68,0xc5,0x84,0x00,0x8b,0x00,0x04,0x04,0xfe,0xee,0xea,0xfe,0x80,0xee,0x02,
+    0xed,0xd4,0x47,0x84,0x00,0x8b,0x00,0x02,0x03,0xf7,0xae,0x83,0xee,0x01,0x8c,0x70,
+    0x84,0x00,0x8b,0x00,0x06,0x02,0xf3,0xc8,0xde,0xee,0xec,0xbe,0x80,0xee,0x00,0x30,
+    0x84,0x00,0x8c,0x00,0x05,0xfe,0x5f,0xc3,0x34,0x49,0x5d,0x80,0xee,0x00,0xf0,0x84,
+    0x00,0x8c,0x00,0x05,0xbe,0xf5,0x8d,0xee,0xd7,0x0c,0x80,0xee,0x00,0xe4,0x84,0x00,
+    0x8c,0x00,0x04,0x4f,0xee,0xef,0xde,0xff,0x80,0xee,0x01,0xde,0xd0,0x84,0x00,0x8c,
+    0x00,0x02,0x0a,0xee,0x50,0x81,0xee,0x00,0xe6,0x86,0x00,0x8d,0x00,0x00,0xce,0x82,
+    0xee,0x00,0x50,0x86,0x00,0x8d,0x00,0x00,0x09,0x81,0xee,0x02,0x90,0xec,0x40,0x85,
+    0x00,0x8c,0x00,0x09,0x52,0xc8,0x38,0xde,0xee,0xed,0x4d,0xdd,0x75,0x20,0x84,0x00,
+    0x8b,0x00,0x0b,0x26,0x62,0xe9,0xbe,0xee,0xee,0xe1,0xdd,0xdf,0x07,0x66,0x10,0x83,
+    0x00,0x8a,0x00,0x0c,0x06,0x66,0x61,0xfe,0x3c,0xee,0xb3,0x6e,0xdd,0xd7,0x56,0x66,
+    0x65,0x83,0x00,0x8a,0x00,0x09,0x66,0x66,0x64,0xbd,0xdd,0x89,0xcd,0xdd,0xdd,0x64,
+    0x80,0x66,0x00,0x60,0x82,0x00,0x89,0x00,0x04,0x26,0x66,0x66,0x67,0x1e,0x81,0xdd,
+    0x00,0xc0,0x82,0x66,0x00,0x10,0x81,0x00,0x88,0x00,0x00,0x04,0x81,0x66,0x05,0x70,
+    0xfd,0xdd,0xdc,0x80,0x56,0x82,0x66,0x00,0x62,0x81,0x00,0x88,0x00,0x00,0x46,0x81,
+    0x66,0x03,0x73,0xed,0xdd,0x56,0x85,0x66,0x00,0x20,0x80,0x00,0x87,0x00,0x00,0x03,
+    0x82,0x66,0x03,0x76,0xdd,0xde,0x37,0x85,0x66,0x00,0x62,0x80,0x00,0x87,0x00,0x09,
+    0x16,0x66,0x66,0x65,0x66,0x66,0x69,0xdd,0xdf,0x16,0x86,0x66,0x02,0x10,0x00,0x00,
+    0x87,0x00,0x09,0x76,0x66,0x66,0x45,0x66,0x66,0x4a,0xdd,0xdf,0x16,0x86,0x66,0x02,
+    0x70,0x00,0x00,0x86,0x00,0x00,0x05,0x80,0x66,0x06,0x45,0x66,0x66,0x3c,0xdd,0xdd,
+    0x26,0x86,0x66,0x02,0x65,0x00,0x00,0x86,0x00,0x00,0x16,0x80,0x66,0x06,0x55,0x66,
+    0x66,0x1e,0xdd,0xdc,0x36,0x87,0x66,0x01,0x20,0x00,0x86,0x00,0x00,0x56,0x80,0x66,
+    0x06,0x55,0x66,0x66,0x1f,0xdd,0xdb,0x46,0x81,0x66,0x01,0x20,0x02,0x81,0x66,0x01,
+    0x60,0x00,0x86,0x00,0x0a,0x56,0x66,0x66,0x65,0x05,0x66,0x66,0x1f,0xdd,0xda,0x46,
+    0x81,0x66,0x02,0x65,0x00,0x26,0x80,0x66,0x01,0x60,0x00,0x86,0x00,0x0a,0x46,0x66,
+    0x66,0x60,0x05,0x66,0x66,0x1f,0xdd,0xda,0x56,0x81,0x66,0x02,0x62,0x00,0x56,0x80,
+    0x66,0x01,0x40,0x00,0x86,0x00,0x0a,0x26,0x66,0x66,0x61,0x04,0x66,0x67,0x1f,0xdd,
+    0xd9,0x56,0x81,0x66,0x07,0x70,0x00,0x76,0x66,0x66,0x67,0x10,0x00,0x86,0x00,0x0a,
+    0x07,0x66,0x66,0x64,0x04,0x66,0x67,0x2e,0xdd,0xd9,0x56,0x81,0x66,0x01,0x60,0x02,
+    0x81,0x66,0x01,0x00,0x00,0x86,0x00,0x0a,0x06,0x66,0x66,0x67,0x04,0x66,0x67,0x2e,
+    0xdd,0xd9,0x56,0x81,0x66,0x01,0x50,0x05,0x80,0x66,0x02,0x61,0x00,0x00,0x86,0x00,
+    0x00,0x02,0x80,0x66,0x06,0x62,0x66,0x67,0x2e,0xdd,0xd9,0x56,0x81,0x66,0x01,0x40,
+    0x07,0x80,0x66,0x02,0x60,0x00,0x00,0x87,0x00,0x80,0x66,0x0f,0x70,0x06,0x77,0x2e,
+    0xdd,0xd9,0x56,0x66,0x66,0x76,0x40,0x00,0x07,0x66,0x66,0x67,0x80,0x00,0x87,0x00,
+    0x12,0x07,0x66,0x66,0x33,0xeb,0x50,0x0e,0xdd,0xda,0x24,0x42,0x00,0x28,0xcd,0x62,
+    0xb0,0x66,0x66,0x64,0x80,0x00,0x87,0x00,0x05,0x02,0x66,0x62,0xa1,0xfd,0xee,0x80,
+    0xdd,0x09,0xcb,0xcc,0xde,0xed,0xdd,0x61,0xec,0x20,0x57,0x70,0x80,0x00,0x88,0x00,
+    0x03,0x14,0x0b,0xe3,0xed,0x86,0xdd,0x03,0x88,0x0c,0xec,0xa6,0x81,0x00,0x88,0x00,
+    0x03,0x04,0xee,0x62,0xcd,0x86,0xdd,0x03,0x6d,0xe7,0x06,0xa6,0x81,0x00,0x89,0x00,
+    0x02,0x21,0xd8,0xad,0x86,0xdd,0x03,0x5f,0xee,0xec,0x80,0x81,0x00,0x89,0x00,0x03,
+    0x01,0xfa,0x04,0xde,0x83,0xdd,0x05,0xee,0x81,0x0e,0xee,0xe9,0x39,0x81,0x00,0x89,
+    0x00,0x0f,0x0a,0x5d,0x16,0x31,0x59,0xdf,0xff,0xff,0xeb,0x84,0x12,0x56,0x4c,0xee,
+    0xf2,0xac,0x81,0x00,0x89,0x00,0x0f,0x06,0x7d,0x07,0x67,0x65,0x43,0x21,0x22,0x35,
+    0x56,0x76,0x66,0x68,0xde,0xeb,0xb9,0x81,0x00,0x8a,0x00,0x01,0xef,0x16,0x86,0x66,
+    0x03,0x62,0x49,0xcf,0xf1,0x81,0x00,0x8b,0x00,0x00,0x05,0x86,0x66,0x00,0x67,0x84,
+    0x00,0x8b,0x00,0x00,0x03,0x87,0x66,0x00,0x20,0x83,0x00,0x8b,0x00,0x00,0x01,0x87,
+    0x66,0x00,0x50,0x83,0x00,0x8c,0x00,0x87,0x66,0x00,0x70,0x83,0x00,
+};
+
+static const uint8_t image_fallout_data1[] =
+{
+    0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,
+    0x90,0x00,0x03,0x10,0x00,0xbf,0xa0,0x86,0x00,0x8d,0x00,0x06,0x50,0x00,0x2e,0xee,
+    0xae,0xdd,0xe4,0x86,0x00,0x8c,0x00,0x03,0x0a,0x60,0x03,0xfd,0x80,0xdd,0x01,0xde,
+    0xdc,0x85,0x00,0x8c,0x00,0x02,0x0c,0xea,0xae,0x83,0xdd,0x00,0xc0,0x84,0x00,0x8c,
+    0x00,0x09,0x0c,0xdd,0xdd,0xab,0xed,0xed,0xde,0xdd,0xdd,0xe3,0x84,0x00,0x8c,0x00,
+    0x0a,0x03,0xee,0xc2,0xe5,0x6a,0x34,0x25,0xed,0xdd,0xde,0x20,0x83,0x00,0x8c,0x00,
+    0x0a,0x01,0x01,0x76,0xde,0xee,0xfe,0xe9,0x1b,0xa9,0xbd,0xe0,0x83,0x00,0x8c,0x00,
+    0x0a,0x02,0x3e,0x3a,0xde,0xee,0xe5,0x8e,0xdc,0xff,0xe4,0xd9,0x83,0x00,0x8d,0x00,
+    0x00,0xbe,0x80,0xee,0x05,0xec,0x0b,0xee,0xee,0xe8,0xfb,0x83,0x00,0x8c,0x00,0x01,
+    0x01,0xfe,0x81,0xee,0x04,0xf9,0xee,0xee,0xf5,0xdc,0x83,0x00,0x8c,0x00,0x02,0x0a,
+    0xe0,0x5e,0x82,0xee,0x02,0xed,0x0c,0xdb,0x83,0x00,0x8c,0x00,0x0a,0x0f,0xc0,0x9e,
+    0xf8,0xee,0xdb,0xee,0xee,0xeb,0x7c,0xd8,0x83,0x00,0x8c,0x00,0x0a,0x9e,0xec,0xee,
+    0x1f,0xef,0x00,0xfe,0xee,0xde,0x33,0xf0,0x83,0x00,0x8c,0x00,0x09,0xce,0xee,0xb0,
+    0xee,0xef,0x09,0xee,0xee,0xf1,0xe6,0x84,0x00,0x8c,0x00,0x02,0xfe,0xee,0x9b,0x82,
+    0xee,0x01,0xab,0x1a,0x84,0x00,0x8c,0x00,0x03,0xfe,0xee,0xe9,0xfe,0x80,0xee,0x02,
+    0xef,0x69,0xb0,0x84,0x00,0x8c,0x00,0x01,0xfd,0xae,0x83,0xee,0x01,0xed,0x50,0x84,
+    0x00,0x8c,0x00,0x05,0xf3,0xca,0xde,0xee,0xee,0xae,0x80,0xee,0x00,0xe0,0x84,0x00,
+    0x8c,0x00,0x05,0xcf,0x4f,0xb2,0x56,0x45,0xaa,0x80,0xee,0x00,0xea,0x84,0x00,0x8c,
+    0x00,0x05,0x8e,0xf4,0xbf,0xff,0xfb,0x19,0x80,0xee,0x00,0xe9,0x84,0x00,0x8c,0x00,
+    0x09,0x0f,0xee,0xec,0xbb,0xde,0xde,0xee,0xee,0x9c,0xa0,0x84,0x00,0x8c,0x00,0x03,
+    0x04,0xee,0x95,0xbe,0x80,0xee,0x00,0xe7,0x86,0x00,0x8d,0x00,0x00,0x6e,0x82,0xee,
+    0x01,0x4b,0x30,0x85,0x00,0x8c,0x00,0x02,0x06,0x22,0xde,0x80,0xee,0x03,0x81,0xed,
+    0xf0,0x30,0x84,0x00,0x8b,0x00,0x0b,0x37,0x77,0x8e,0x22,0x9e,0xee,0xee,0x0e,0xdd,
+    0xb3,0x77,0x10,0x83,0x00,0x8a,0x00,0x0c,0x47,0x77,0x76,0x9d,0x4d,0xee,0xee,0x74,
+    0xed,0xde,0x08,0x77,0x76,0x83,0x00,0x89,0x00,0x0e,0x47,0x77,0x77,0x78,0x5d,0xe6,
+    0x00,0x07,0xdd,0xdd,0xe2,0x67,0x77,0x77,0x76,0x82,0x00,0x88,0x00,0x00,0x27,0x81,
+    0x77,0x00,0x1c,0x81,0xdd,0x01,0xdc,0x06,0x81,0x77,0x00,0x73,0x81,0x00,0x87,0x00,
+    0x00,0x06,0x82,0x77,0x05,0x71,0xbd,0xdd,0xdd,0xdb,0x15,0x83,0x77,0x00,0x50,0x80,
+    0x00,0x87,0x00,0x83,0x77,0x04,0x76,0x9d,0xdd,0xf0,0x36,0x85,0x77,0x80,0x00,0x86,
+    0x00,0x00,0x08,0x83,0x77,0x03,0x74,0xbd,0xdd,0xd1,0x86,0x77,0x02,0x70,0x00,0x00,
+    0x86,0x00,0x00,0x67,0x83,0x77,0x03,0x72,0xdd,0xdd,0xc3,0x87,0x77,0x01,0x00,0x00,
+    0x85,0x00,0x00,0x02,0x81,0x77,0x06,0x75,0x87,0x77,0x71,0xfd,0xdd,0xb4,0x87,0x77,
+    0x01,0x70,0x00,0x85,0x00,0x00,0x06,0x81,0x77,0x06,0x72,0x87,0x77,0x72,0xfd,0xdd,
+    0xa5,0x87,0x77,0x01,0x75,0x00,0x85,0x00,0x00,0x08,0x80,0x77,0x07,0x27,0x72,0x87,
+    0x77,0x83,0xed,0xdd,0x96,0x87,0x77,0x01,0x78,0x10,0x85,0x00,0x00,0x27,0x80,0x77,
+    0x07,0x71,0x72,0x87,0x77,0x84,0xed,0xdd,0x88,0x81,0x77,0x02,0x74,0x22,0x47,0x81,
+    0x77,0x00,0x20,0x85,0x00,0x00,0x27,0x80,0x77,0x07,0x78,0x10,0x87,0x77,0x83,0xed,
+    0xdd,0x78,0x82,0x77,0x01,0x10,0x05,0x80,0x77,0x01,0x78,0x00,0x85,0x00,0x0b,0x17,
+    0x77,0x78,0x40,0x03,0x20,0x87,0x77,0x84,0xed,0xdd,0x78,0x81,0x77,0x02,0x78,0x00,
+    0x08,0x80,0x77,0x01,0x76,0x00,0x85,0x00,0x0b,0x08,0x77,0x72,0xcd,0xdd,0x10,0x77,
+    0x77,0x84,0xed,0xdd,0x58,0x81,0x77,0x02,0x75,0x00,0x27,0x80,0x77,0x01,0x72,0x00,
+    0x85,0x00,0x0b,0x06,0x78,0x2e,0xde,0xaa,0xf0,0x67,0x77,0x84,0xed,0xdd,0x58,0x81,
+    0x77,0x02,0x73,0x00,0x57,0x80,0x77,0x01,0x70,0x00,0x85,0x00,0x0b,0x01,0x75,0xad,
+    0xb2,0xcd,0x80,0x57,0x77,0x84,0xdd,0xdd,0x68,0x81,0x77,0x02,0x71,0x01,0x87,0x80,
+    0x77,0x01,0x10,0x00,0x86,0x00,0x0a,0x53,0xce,0x3f,0xee,0xea,0x47,0x77,0x84,0xed,
+    0xdd,0x87,0x81,0x77,0x01,0x80,0x05,0x80,0x77,0x02,0x75,0x00,0x00,0x86,0x00,0x0a,
+    0x03,0xcc,0xae,0xee,0xec,0x18,0x77,0x84,0xed,0xdd,0x86,0x80,0x77,0x02,0x85,0x00,
+    0x06,0x80,0x77,0x02,0x80,0x00,0x00,0x87,0x00,0x0f,0xcc,0xae,0xee,0xee,0x38,0x03,
+    0x84,0xed,0xdd,0x96,0x87,0x53,0x00,0x5b,0xd0,0x32,0x80,0x77,0x02,0x20,0x00,0x00,
+    0x87,0x00,0x12,0x0c,0x6e,0xee,0xef,0x2e,0xec,0xbb,0xdd,0xdd,0xb5,0x57,0xac,0xde,
+    0xed,0xc0,0xbd,0x90,0x68,0x73,0x80,0x00,0x88,0x00,0x03,0x0f,0xee,0xef,0x1f,0x81,
+    0xdd,0x01,0xde,0xed,0x80,0xdd,0x04,0xc0,0x6a,0xed,0xb8,0x20,0x80,0x00,0x88,0x00,
+    0x03,0x09,0xde,0xfe,0x2e,0x86,0xdd,0x03,0xba,0xeb,0x18,0xcd,0x81,0x00,0x89,0x00,
+    0x02,0xcf,0x6f,0x5c,0x86,0xdd,0x03,0x7e,0xee,0xfc,0x80,0x81,0x00,0x89,0x00,0x03,
+    0xdf,0x3f,0x04,0xed,0x84,0xdd,0x04,0xec,0x0f,0xee,0xee,0x19,0x81,0x00,0x89,0x00,
+    0x0f,0x21,0x00,0x02,0x22,0xae,0xee,0xdd,0xdd,0xde,0xfd,0xa3,0x12,0x1d,0xee,0xf4,
+    0xdc,0x81,0x00,0x8b,0x00,0x02,0x01,0x87,0x52,0x81,0x22,0x06,0x23,0x57,0x87,0x59,
+    0xee,0xe9,0x5c,0x81,0x00,0x8c,0x00,0x05,0x87,0x77,0x78,0x87,0x78,0x88,0x80,0x77,
+    0x03,0x73,0x5c,0xff,0xf5,0x81,0x00,0x8c,0x00,0x00,0x57,0x86,0x77,0x00,0x10,0x83,
+    0x00,0x8c,0x00,0x00,0x37,0x86,0x77,0x00,0x50,0x83,0x00,0x8c,0x00,0x00,0x17,0x86,
+    0x77,0x00,0x80,0x83,0x00,0x8c,0x00,0x00,0x07,0x86,0x77,0x00,0x73,0x83,0x00,
+};
+
+static const uint8_t image_fallout_data2[] =
+{
+    0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,
+    0x92,0x00,0x00,0x52,0x87,0x00,0x8f,0x00,0x04,0x03,0x20,0x1d,0xdf,0x10,0x86,0x00,
+    0x8c,0x00,0x08,0x08,0x00,0x01,0xfd,0xdf,0xed,0xdd,0xd4,0x40,0x85,0x00,0x8c,0x00,
+    0x02,0x4c,0x00,0x0e,0x82,0xdd,0x00,0xdc,0x85,0x00,0x8c,0x00,0x03,0x8d,0xcb,0xed,
+    0xed,0x82,0xdd,0x00,0x60,0x84,0x00,0x8c,0x00,0x09,0x7d,0xdd,0xe9,0x5d,0xee,0xb9,
+    0xbe,0xdd,0xdd,0xe2,0x84,0x00,0x8c,0x00,0x0a,0x0c,0xed,0x2e,0xe0,0x41,0xbe,0x57,
+    0xdd,0xcc,0xee,0x20,0x83,0x00,0x8c,0x00,0x0a,0x03,0x05,0x67,0xee,0xfe,0xec,0xf7,
+    0x02,0xa9,0x1e,0xc0,0x83,0x00,0x8c,0x00,0x0a,0x08,0xb5,0xbe,0xee,0xee,0xb0,0xad,
+    0xee,0xee,0xda,0xe2,0x83,0x00,0x8c,0x00,0x01,0x01,0xfe,0x80,0xee,0x05,0xec,0x0f,
+    0xee,0xee,0xcb,0xe5,0x83,0x00,0x8c,0x00,0x00,0x0b,0x82,0xee,0x04,0xdd,0xee,0xed,
+    0x1f,0xe4,0x83,0x00,0x8c,0x00,0x01,0x0f,0xef,0x83,0xee,0x02,0xea,0x9d,0xf0,0x83,
+    0x00,0x8c,0x00,0x03,0x9e,0x31,0xee,0xbc,0x81,0xee,0x02,0xf0,0xaa,0xc0,0x83,0x00,
+    0x8c,0x00,0x0a,0xde,0xee,0xcb,0x8e,0xeb,0x14,0xfe,0xee,0x8d,0x26,0x60,0x83,0x00,
+    0x8b,0x00,0x03,0x01,0xfe,0xee,0xa5,0x81,0xee,0x02,0xef,0x84,0xd4,0x84,0x00,0x8b,
+    0x00,0x03,0x04,0xee,0xef,0x0f,0x81,0xee,0x02,0xec,0xc6,0x44,0x84,0x00,0x8b,0x00,
+    0x03,0x05,0xee,0xee,0xe9,0x81,0xee,0x02,0xef,0x7c,0x60,0x84,0x00,0x8b,0x00,0x02,
+    0x04,0xed,0xce,0x84,0xee,0x00,0x50,0x84,0x00,0x8b,0x00,0x06,0x02,0xf2,0x7d,0xee,
+    0xee,0xec,0xae,0x80,0xee,0x00,0xf3,0x84,0x00,0x8c,0x00,0x05,0xfa,0xcd,0x44,0x76,
+    0x3a,0x9c,0x80,0xee,0x00,0xe6,0x84,0x00,0x8c,0x00,0x09,0xad,0xc3,0xef,0xff,0xf9,
+    0x0b,0xee,0xee,0xde,0xe0,0x84,0x00,0x8c,0x00,0x03,0x0f,0xee,0xdb,0xab,0x80,0xee,
+    0x00,0xec,0x86,0x00,0x8c,0x00,0x03,0x06,0xee,0x99,0xce,0x80,0xee,0x00,0xc0,0x86,
+    0x00,0x8d,0x00,0x00,0x7e,0x81,0xee,0x02,0xe5,0x99,0x40,0x85,0x00,0x8a,0x00,0x0b,
+    0x01,0x57,0x77,0x81,0xce,0xee,0xee,0xeb,0x37,0xdd,0xb3,0x73,0x84,0x00,0x89,0x00,
+    0x0e,0x26,0x77,0x77,0x74,0xbe,0x27,0x5c,0xee,0xe3,0x7d,0xde,0x27,0x77,0x77,0x20,
+    0x82,0x00,0x88,0x00,0x00,0x57,0x80,0x77,0x08,0x75,0xbd,0xa5,0xde,0xb3,0x0c,0xdd,
+    0xd9,0x47,0x80,0x77,0x00,0x30,0x81,0x00,0x87,0x00,0x00,0x67,0x81,0x77,0x07,0x78,
+    0x6d,0xdd,0xa9,0xbd,0xdd,0xdd,0x94,0x82,0x77,0x81,0x00,0x86,0x00,0x00,0x57,0x83,
+    0x77,0x00,0x3b,0x81,0xdd,0x01,0xc0,0x67,0x82,0x77,0x00,0x75,0x80,0x00,0x85,0x00,
+    0x00,0x07,0x84,0x77,0x05,0x74,0xad,0xdd,0xdc,0x70,0x57,0x84,0x77,0x02,0x70,0x00,
+    0x00,0x85,0x00,0x03,0x87,0x77,0x77,0x57,0x81,0x77,0x03,0x74,0xbd,0xdd,0xd1,0x87,
+    0x77,0x01,0x00,0x00,0x84,0x00,0x00,0x08,0x80,0x77,0x01,0x73,0x57,0x80,0x77,0x03,
+    0x71,0xed,0xdd,0xb4,0x87,0x77,0x01,0x70,0x00,0x84,0x00,0x0c,0x37,0x76,0x10,0x00,
+    0x57,0x08,0x74,0x87,0x77,0x71,0xfd,0xdd,0xa5,0x87,0x77,0x01,0x76,0x00,0x84,0x00,
+    0x0c,0x57,0x46,0xdd,0xdd,0xc0,0x54,0x71,0x87,0x77,0x72,0xfd,0xdd,0x96,0x88,0x77,
+    0x00,0x20,0x84,0x00,0x0c,0x75,0x8d,0xe8,0x00,0x4c,0x03,0x81,0x87,0x77,0x83,0xed,
+    0xdc,0x87,0x88,0x77,0x00,0x50,0x84,0x00,0x0c,0x81,0xee,0x1e,0xee,0xe8,0x13,0x81,
+    0x87,0x77,0x84,0xed,0xdd,0x78,0x82,0x77,0x01,0x42,0x36,0x81,0x77,0x00,0x60,0x84,
+    0x00,0x0c,0x85,0xda,0xbe,0xee,0xee,0xa0,0x01,0x87,0x77,0x84,0xed,0xdd,0x78,0x82,
+    0x77,0x01,0x20,0x05,0x81,0x77,0x00,0x40,0x84,0x00,0x0c,0x45,0xd5,0xfe,0xee,0xee,
+    0xec,0x21,0x87,0x77,0x84,0xed,0xdd,0x68,0x81,0x77,0x02,0x78,0x00,0x08,0x80,0x77,
+    0x01,0x78,0x00,0x84,0x00,0x0c,0x03,0xe7,0xfe,0xee,0xee,0xed,0xb0,0x87,0x77,0x85,
+    0xdd,0xdd,0x68,0x82,0x77,0x01,0x00,0x17,0x80,0x77,0x01,0x75,0x00,0x85,0x00,0x0b,
+    0xad,0x9e,0xee,0xef,0x8e,0x75,0x87,0x77,0x85,0xdd,0xdd,0x58,0x81,0x77,0x02,0x74,
+    0x00,0x57,0x80,0x77,0x01,0x80,0x00,0x85,0x00,0x0b,0x02,0x0d,0xec,0xbf,0x3e,0xc0,
+    0x87,0x77,0x85,0xdd,0xdd,0x68,0x81,0x77,0x02,0x72,0x00,0x87,0x80,0x77,0x01,0x40,
+    0x00,0x86,0x00,0x09,0x05,0xee,0x8f,0x1c,0xf0,0x87,0x77,0x85,0xdd,0xdd,0x82,0x77,
+    0x01,0x80,0x05,0x81,0x77,0x01,0x00,0x00,0x87,0x00,0x09,0xcf,0x3f,0x47,0xf3,0x87,
+    0x77,0x84,0xed,0xdd,0x87,0x81,0x77,0x01,0x70,0x13,0x80,0x77,0x02,0x81,0x00,0x00,
+    0x87,0x00,0x15,0x5e,0x8f,0x02,0xf2,0x05,0x87,0x84,0xed,0xdd,0x96,0x77,0x78,0x85,
+    0x10,0x92,0xf3,0x57,0x77,0x77,0x30,0x00,0x00,0x87,0x00,0x12,0x0f,0xa9,0x00,0xc0,
+    0xaa,0x50,0x02,0xed,0xdd,0xa1,0x20,0x01,0x7b,0xce,0xd0,0xbd,0x51,0x87,0x74,0x80,
+    0x00,0x87,0x00,0x12,0x06,0xb0,0x00,0x00,0x9d,0xde,0xdc,0xdd,0xdd,0xdc,0xcc,0xde,
+    0xed,0xdd,0xab,0x6b,0xec,0x60,0x20,0x80,0x00,0x8b,0x00,0x00,0x6d,0x86,0xdd,0x03,
+    0x5f,0xea,0x1b,0xfa,0x81,0x00,0x8b,0x00,0x00,0x4e,0x85,0xdd,0x04,0xde,0x5f,0xee,
+    0xeb,0x30,0x81,0x00,0x8b,0x00,0x00,0x0f,0x85,0xdd,0x04,0xdf,0x5f,0xee,0xf8,0x83,
+    0x81,0x00,0x8b,0x00,0x01,0x01,0xbe,0x83,0xdd,0x05,0xed,0x92,0x4e,0xee,0x9c,0xd4,
+    0x81,0x00,0x8b,0x00,0x0d,0x06,0x51,0x27,0xbc,0xee,0xee,0xcb,0x83,0x12,0x57,0x1e,
+    0xde,0xe7,0xf0,0x81,0x00,0x8b,0x00,0x0d,0x04,0x77,0x86,0x54,0x32,0x23,0x45,0x67,
+    0x87,0x77,0x73,0x4b,0xff,0xa0,0x81,0x00,0x8b,0x00,0x00,0x02,0x86,0x77,0x02,0x78,
+    0x00,0x01,0x82,0x00,0x8c,0x00,0x00,0x87,0x86,0x77,0x00,0x40,0x83,0x00,0x8c,0x00,
+    0x00,0x87,0x86,0x77,0x00,0x70,0x83,0x00,0x8c,0x00,0x00,0x57,0x86,0x77,0x00,0x71,
+    0x83,0x00,
+};
+
+static const uint8_t image_fallout_data3[] =
+{
+    0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x92,0x00,
+    0x01,0x7c,0x30,0x86,0x00,0x8d,0x00,0x06,0x50,0x00,0x1c,0xfb,0x5c,0xdd,0xe0,0x86,
+    0x00,0x8c,0x00,0x03,0x0b,0x40,0x03,0xfd,0x81,0xdd,0x00,0x75,0x85,0x00,0x8c,0x00,
+    0x02,0x0e,0xd6,0xae,0x83,0xdd,0x00,0x70,0x84,0x00,0x8c,0x00,0x09,0x0e,0xdd,0xdd,
+    0xbd,0xdd,0xee,0xed,0xdd,0xdd,0xd0,0x84,0x00,0x8c,0x00,0x09,0x08,0xee,0xb2,0xb0,
+    0xbb,0x61,0x0b,0xdd,0xdd,0xda,0x84,0x00,0x8c,0x00,0x0a,0x01,0x03,0x8a,0xef,0xab,
+    0xfe,0xf0,0xbc,0xcc,0xdd,0xa0,0x83,0x00,0x8c,0x00,0x0a,0x07,0x3b,0x37,0xee,0xee,
+    0xe8,0xce,0x66,0xbb,0x3b,0xe2,0x83,0x00,0x8d,0x00,0x00,0xde,0x80,0xee,0x05,0xf6,
+    0x0f,0xde,0xee,0xf6,0xd8,0x83,0x00,0x8c,0x00,0x00,0x06,0x82,0xee,0x04,0xab,0xee,
+    0xee,0xf8,0xd9,0x83,0x00,0x8c,0x00,0x03,0x0e,0xdc,0xee,0xed,0x81,0xee,0x02,0xed,
+    0x2d,0xd8,0x83,0x00,0x8c,0x00,0x03,0x6e,0x90,0xde,0xbb,0x81,0xee,0x02,0xec,0x6d,
+    0xe4,0x83,0x00,0x8c,0x00,0x0a,0xce,0xee,0xe9,0xae,0xeb,0x6d,0xee,0xee,0xe3,0xaa,
+    0xd0,0x83,0x00,0x8b,0x00,0x0b,0x01,0xfe,0xef,0x2a,0xee,0xeb,0x0d,0xee,0xee,0xac,
+    0x26,0x80,0x83,0x00,0x8b,0x00,0x03,0x05,0xee,0xef,0x3e,0x81,0xee,0x02,0xef,0x56,
+    0xd4,0x84,0x00,0x8b,0x00,0x03,0x07,0xee,0xee,0xfb,0x81,0xee,0x02,0xec,0xc6,0x43,
+    0x84,0x00,0x8b,0x00,0x02,0x07,0xe4,0xde,0x82,0xee,0x02,0xef,0xac,0x50,0x84,0x00,
+    0x8b,0x00,0x06,0x06,0xd7,0xab,0xde,0xee,0xeb,0xce,0x80,0xee,0x00,0x20,0x84,0x00,
+    0x8b,0x00,0x06,0x02,0xfc,0x9f,0xb3,0x44,0x6c,0x2f,0x80,0xee,0x00,0xf0,0x84,0x00,
+    0x8c,0x00,0x05,0xfd,0xe3,0xae,0xee,0xc4,0x0f,0x80,0xee,0x00,0xf0,0x84,0x00,0x8c,
+    0x00,0x04,0x8e,0xde,0xfe,0xde,0xfe,0x80,0xee,0x01,0xdd,0xa0,0x84,0x00,0x8c,0x00,
+    0x03,0x0d,0xef,0x21,0xfe,0x80,0xee,0x00,0xf2,0x86,0x00,0x8d,0x00,0x82,0xee,0x01,
+    0xed,0x10,0x86,0x00,0x8b,0x00,0x02,0x24,0x66,0x2b,0x81,0xee,0x02,0x55,0xed,0x60,
+    0x85,0x00,0x87,0x00,0x0e,0x25,0x67,0x74,0x47,0x77,0x71,0xe8,0x4a,0xee,0xee,0xef,
+    0x2e,0xdd,0x57,0x72,0x84,0x00,0x85,0x00,0x08,0x02,0x08,0x80,0x22,0x8e,0xf4,0x77,
+    0x83,0xe8,0x80,0xee,0x05,0xd1,0xed,0xdd,0x07,0x77,0x76,0x83,0x00,0x84,0x00,0x10,
+    0x04,0x0c,0xe2,0xee,0xee,0xed,0xef,0x48,0x71,0xfe,0x2c,0xee,0xb1,0xad,0xdd,0xe0,
+    0x67,0x80,0x77,0x82,0x00,0x84,0x00,0x0b,0x14,0xbd,0x5f,0xee,0x9a,0xf4,0xae,0xd2,
+    0x64,0xbd,0xdc,0xaa,0x80,0xdd,0x00,0x06,0x81,0x77,0x00,0x76,0x81,0x00,0x84,0x00,
+    0x09,0x51,0xfe,0x8e,0xee,0xee,0x7b,0x52,0xb2,0x77,0x1c,0x81,0xdd,0x00,0x72,0x83,
+    0x77,0x00,0x74,0x80,0x00,0x84,0x00,0x0d,0x64,0xeb,0x6d,0xec,0xee,0x6f,0xb1,0x37,
+    0x77,0x83,0xed,0xdd,0xb7,0x03,0x85,0x77,0x02,0x70,0x00,0x00,0x84,0x00,0x0c,0x62,
+    0xf6,0xee,0x9f,0x6e,0xda,0xee,0xe4,0x87,0x86,0xdd,0xde,0x28,0x87,0x77,0x01,0x10,
+    0x00,0x84,0x00,0x0c,0x44,0xb9,0xce,0xe5,0x7d,0xf0,0xae,0xda,0x67,0x5b,0xdd,0xdf,
+    0x17,0x87,0x77,0x01,0x71,0x00,0x84,0x00,0x0c,0x18,0x1b,0x1f,0xe5,0xf0,0xf3,0x85,
+    0x31,0x87,0x3c,0xdd,0xdd,0x17,0x87,0x77,0x01,0x78,0x00,0x84,0x00,0x0c,0x04,0x75,
+    0x24,0xfb,0x37,0x35,0x57,0x77,0x77,0x2e,0xdd,0xdc,0x37,0x88,0x77,0x00,0x40,0x85,
+    0x00,0x0b,0x16,0x76,0x10,0x77,0x77,0x28,0x77,0x77,0x0f,0xdd,0xdb,0x57,0x88,0x77,
+    0x00,0x50,0x8a,0x00,0x06,0x07,0x77,0x78,0x1f,0xdd,0xda,0x67,0x82,0x77,0x01,0x43,
+    0x47,0x81,0x77,0x00,0x50,0x8a,0x00,0x05,0x08,0x77,0x78,0x2e,0xdd,0xd9,0x82,0x77,
+    0x02,0x78,0x00,0x02,0x81,0x77,0x00,0x30,0x8a,0x00,0x06,0x08,0x77,0x78,0x4e,0xdd,
+    0xd8,0x87,0x81,0x77,0x02,0x75,0x00,0x05,0x80,0x77,0x01,0x78,0x10,0x8a,0x00,0x06,
+    0x07,0x77,0x78,0x4e,0xdd,0xd6,0x87,0x81,0x77,0x02,0x72,0x00,0x08,0x80,0x77,0x01,
+    0x76,0x00,0x8a,0x00,0x06,0x06,0x77,0x78,0x5d,0xdd,0xd5,0x87,0x81,0x77,0x02,0x80,
+    0x00,0x27,0x80,0x77,0x01,0x72,0x00,0x8a,0x00,0x06,0x06,0x77,0x78,0x6d,0xdd,0xd5,
+    0x87,0x81,0x77,0x02,0x50,0x00,0x67,0x80,0x77,0x01,0x70,0x00,0x8a,0x00,0x06,0x05,
+    0x77,0x78,0x6d,0xdd,0xd5,0x87,0x81,0x77,0x01,0x40,0x01,0x81,0x77,0x01,0x10,0x00,
+    0x8a,0x00,0x06,0x05,0x77,0x78,0x7d,0xdd,0xd5,0x87,0x80,0x77,0x02,0x78,0x10,0x01,
+    0x80,0x77,0x02,0x75,0x00,0x00,0x8a,0x00,0x12,0x06,0x12,0x78,0x7d,0xdd,0xd5,0x87,
+    0x77,0x78,0x64,0x04,0x00,0x01,0x08,0x77,0x77,0x80,0x00,0x00,0x8a,0x00,0x0f,0x08,
+    0xec,0xb7,0xad,0xdd,0xd5,0x00,0x00,0x15,0xac,0xdf,0x00,0x0e,0xc3,0x27,0x88,0x80,
+    0x00,0x8a,0x00,0x02,0x05,0xdd,0xde,0x80,0xdd,0x09,0xdc,0xdd,0xee,0xdd,0xdf,0x00,
+    0x24,0xed,0xca,0x50,0x80,0x00,0x8a,0x00,0x01,0x02,0xed,0x85,0xdd,0x05,0xdf,0x00,
+    0xec,0x26,0xdf,0x50,0x80,0x00,0x8b,0x00,0x00,0xfd,0x85,0xdd,0x04,0xde,0x25,0xfe,
+    0xfc,0x91,0x81,0x00,0x8b,0x00,0x00,0xbd,0x85,0xdd,0x04,0xdf,0x2b,0xee,0xed,0xb0,
+    0x81,0x00,0x8b,0x00,0x01,0x41,0xaf,0x82,0xdd,0x06,0xde,0xea,0x21,0x0c,0xee,0xea,
+    0xab,0x81,0x00,0x8b,0x00,0x0d,0x57,0x52,0x24,0x8a,0xbb,0xbb,0x95,0x21,0x25,0x67,
+    0x64,0xfe,0xea,0x3b,0x81,0x00,0x8b,0x00,0x0d,0x27,0x77,0x87,0x65,0x55,0x55,0x66,
+    0x78,0x77,0x77,0x80,0x08,0xef,0xf4,0x81,0x00,0x8b,0x00,0x00,0x18,0x86,0x77,0x03,
+    0x71,0x00,0x01,0x10,0x81,0x00,0x8b,0x00,0x00,0x08,0x86,0x77,0x00,0x75,0x84,0x00,
+    0x8b,0x00,0x00,0x06,0x86,0x77,0x00,0x78,0x84,0x00,0x8b,0x00,0x00,0x04,0x87,0x77,
+    0x00,0x20,0x83,0x00,0x8b,0x00,0x01,0x01,0x87,0x86,0x77,0x00,0x60,0x83,0x00,
+};
+
+static const uint8_t image_fallout_data4[] =
+{
+    0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x92,0x00,0x01,0x0b,
+    0xc0,0x86,0x00,0x8d,0x00,0x06,0xa0,0x00,0x0a,0xef,0xb9,0xed,0xdb,0x86,0x00,0x8c,
+    0x00,0x03,0x01,0xf0,0x00,0xcd,0x81,0xdd,0x01,0xb6,0x10,0x84,0x00,0x8c,0x00,0x02,
+    0x06,0xde,0xcf,0x83,0xdd,0x00,0xe0,0x84,0x00,0x8c,0x00,0x09,0x03,0xed,0xde,0xa9,
+    0xdd,0xde,0xee,0xdd,0xdd,0xd7,0x84,0x00,0x8d,0x00,0x09,0xad,0xc2,0xdc,0x0a,0x81,
+    0x13,0xed,0xdd,0xde,0x10,0x83,0x00,0x8d,0x00,0x09,0xa0,0x94,0x9e,0xfd,0xfe,0xeb,
+    0x0c,0xcc,0xce,0xf0,0x83,0x00,0x8d,0x00,0x09,0x1f,0x6c,0xde,0xee,0xeb,0x6e,0xb5,
+    0x8b,0x86,0xda,0x83,0x00,0x8d,0x00,0x00,0xae,0x80,0xee,0x05,0xed,0x09,0xdd,0xee,
+    0xda,0xce,0x83,0x00,0x8d,0x00,0x01,0xfc,0xbe,0x80,0xee,0x04,0xf4,0xfe,0xee,0xe9,
+    0xef,0x83,0x00,0x8c,0x00,0x03,0x0b,0xf0,0x1f,0xec,0x82,0xee,0x01,0xb6,0xde,0x83,
+    0x00,0x8c,0x00,0x05,0x1f,0xf0,0xbe,0xd9,0xee,0xc8,0x80,0xee,0x01,0x3e,0xdb,0x83,
+    0x00,0x86,0x00,0x10,0x09,0xe6,0x00,0x01,0x00,0x00,0x9e,0xee,0xeb,0x4f,0xef,0x00,
+    0xfe,0xee,0xdb,0x93,0xe5,0x83,0x00,0x85,0x00,0x11,0x03,0xfe,0xf1,0x04,0xfe,0x00,
+    0x00,0xde,0xee,0x69,0xee,0xef,0x2a,0xee,0xee,0xe4,0xa9,0x90,0x83,0x00,0x85,0x00,
+    0x09,0x0f,0xee,0x00,0x0f,0xe5,0x00,0x00,0xfe,0xee,0xc8,0x82,0xee,0x02,0x7b,0x97,
+    0x20,0x83,0x00,0x85,0x00,0x08,0x0d,0xa0,0x00,0x3f,0xf0,0x00,0x01,0xfe,0xde,0x83,
+    0xee,0x01,0xc2,0x98,0x84,0x00,0x85,0x00,0x08,0x0a,0xff,0xd6,0x1f,0xc0,0x00,0x01,
+    0xf4,0x9e,0x83,0xee,0x01,0xbd,0x80,0x84,0x00,0x85,0x00,0x0c,0x4f,0xee,0xed,0x6e,
+    0xc0,0x00,0x00,0xf6,0xf5,0xbd,0xde,0xdc,0x7e,0x80,0xee,0x00,0x60,0x84,0x00,0x86,
+    0x00,0x0b,0x42,0x04,0xfe,0xf4,0x00,0x00,0xde,0x7c,0xfc,0x98,0xae,0xab,0x80,0xee,
+    0x00,0xf2,0x84,0x00,0x85,0x00,0x0c,0x0f,0xee,0xe9,0xdc,0xea,0x00,0x00,0xae,0xed,
+    0x29,0xbb,0xa2,0x0c,0x80,0xee,0x00,0xe5,0x84,0x00,0x85,0x00,0x0a,0x0f,0xdb,0x73,
+    0xfc,0x98,0x00,0x00,0x0f,0xee,0xde,0xff,0x81,0xee,0x01,0xdd,0xd0,0x84,0x00,0x85,
+    0x00,0x09,0x0b,0xef,0xee,0xee,0x60,0x00,0x00,0x06,0xee,0xb0,0x81,0xee,0x00,0xe5,
+    0x86,0x00,0x85,0x00,0x04,0x03,0xfe,0xee,0xee,0x90,0x80,0x00,0x00,0x9e,0x82,0xee,
+    0x00,0x20,0x86,0x00,0x84,0x00,0x0a,0x01,0x0f,0x3e,0xee,0xef,0x41,0x44,0x54,0x54,
+    0x71,0xde,0x80,0xee,0x02,0x54,0xec,0x40,0x85,0x00,0x84,0x00,0x11,0x05,0x0f,0xd3,
+    0x49,0x70,0xd0,0x27,0x77,0x71,0xe9,0xb3,0xbe,0xee,0xef,0x1e,0xdd,0x76,0x61,0x84,
+    0x00,0x84,0x00,0x01,0x08,0x58,0x80,0xdd,0x0d,0x94,0x27,0x77,0x72,0xeb,0xae,0xee,
+    0xee,0xc1,0xed,0xde,0x08,0x77,0x74,0x83,0x00,0x84,0x00,0x13,0x08,0x74,0x3d,0xdd,
+    0xd8,0x44,0x47,0x77,0x71,0xfd,0xa4,0xba,0x51,0xcd,0xdd,0xe4,0x67,0x77,0x77,0x75,
+    0x82,0x00,0x84,0x00,0x09,0x08,0x77,0x73,0x00,0x17,0x71,0x77,0x77,0x75,0xad,0x81,
+    0xdd,0x01,0xde,0x26,0x81,0x77,0x00,0x73,0x81,0x00,0x84,0x00,0x00,0x06,0x81,0x77,
+    0x00,0x53,0x80,0x77,0x00,0x2b,0x81,0xdd,0x00,0x91,0x83,0x77,0x00,0x71,0x80,0x00,
+    0x84,0x00,0x00,0x02,0x80,0x77,0x09,0x74,0x37,0x64,0x77,0x77,0x82,0xed,0xdd,0xc8,
+    0x12,0x85,0x77,0x02,0x50,0x00,0x00,0x85,0x00,0x00,0x67,0x81,0x77,0x06,0x45,0x77,
+    0x77,0x85,0xdd,0xde,0x48,0x87,0x77,0x01,0x00,0x00,0x85,0x00,0x00,0x05,0x81,0x77,
+    0x06,0x36,0x77,0x77,0x5a,0xdd,0xdf,0x17,0x87,0x77,0x01,0x71,0x00,0x86,0x00,0x00,
+    0x02,0x80,0x77,0x06,0x27,0x77,0x77,0x4b,0xdd,0xde,0x17,0x87,0x77,0x01,0x78,0x00,
+    0x8a,0x00,0x06,0x07,0x77,0x77,0x2d,0xdd,0xdc,0x37,0x88,0x77,0x00,0x40,0x8a,0x00,
+    0x06,0x08,0x77,0x77,0x1f,0xdd,0xdb,0x47,0x88,0x77,0x00,0x50,0x8a,0x00,0x06,0x07,
+    0x77,0x77,0x2f,0xdd,0xda,0x67,0x82,0x77,0x01,0x44,0x57,0x81,0x77,0x00,0x40,0x8a,
+    0x00,0x05,0x07,0x77,0x78,0x2e,0xdd,0xd9,0x82,0x77,0x02,0x76,0x00,0x00,0x81,0x77,
+    0x00,0x20,0x8a,0x00,0x06,0x07,0x77,0x78,0x4e,0xdd,0xd8,0x87,0x81,0x77,0x07,0x72,
+    0x00,0x00,0x87,0x77,0x77,0x78,0x00,0x8a,0x00,0x06,0x07,0x77,0x78,0x4e,0xdd,0xd6,
+    0x87,0x81,0x77,0x02,0x80,0x00,0x02,0x81,0x77,0x00,0x00,0x8a,0x00,0x06,0x07,0x77,
+    0x78,0x5d,0xdd,0xd5,0x87,0x81,0x77,0x02,0x70,0x00,0x05,0x80,0x77,0x01,0x74,0x00,
+    0x8a,0x00,0x06,0x06,0x77,0x78,0x6d,0xdd,0xd5,0x87,0x81,0x77,0x02,0x40,0x00,0x08,
+    0x80,0x77,0x01,0x80,0x00,0x8a,0x00,0x06,0x05,0x77,0x78,0x7d,0xdd,0xd5,0x87,0x81,
+    0x77,0x02,0x20,0x00,0x47,0x80,0x77,0x01,0x50,0x00,0x8a,0x00,0x06,0x04,0x77,0x77,
+    0x8d,0xdd,0xd4,0x87,0x80,0x77,0x08,0x78,0x10,0x00,0x67,0x77,0x77,0x78,0x00,0x00,
+    0x8a,0x00,0x12,0x07,0x21,0x68,0x8d,0xdd,0xd4,0x87,0x77,0x78,0x74,0x02,0x00,0x00,
+    0xb0,0x87,0x77,0x73,0x00,0x00,0x8a,0x00,0x12,0x08,0xed,0xb8,0xad,0xdd,0xd5,0x00,
+    0x00,0x05,0x9c,0xdf,0x00,0x05,0xdd,0xb1,0x48,0x50,0x00,0x00,0x8a,0x00,0x00,0x05,
+    0x82,0xdd,0x09,0xdc,0xdd,0xee,0xdd,0xdf,0x00,0x01,0x3e,0xde,0xcb,0x80,0x00,0x8a,
+    0x00,0x01,0x02,0xed,0x85,0xdd,0x05,0xdf,0x00,0x0c,0xd9,0x19,0xd3,0x80,0x00,0x8b,
+    0x00,0x00,0xed,0x85,0xdd,0x04,0xdf,0x00,0x2f,0xee,0xfe,0x81,0x00,0x8b,0x00,0x00,
+    0xbe,0x85,0xdd,0x04,0xdf,0x00,0x8e,0xee,0xea,0x81,0x00,0x8b,0x00,0x01,0x41,0xaf,
+    0x82,0xdd,0x07,0xde,0xea,0x30,0x10,0xbe,0xef,0x3b,0x50,0x80,0x00,0x8b,0x00,0x0e,
+    0x57,0x52,0x24,0x8a,0xbb,0xbb,0x95,0x21,0x25,0x67,0x40,0x8e,0xeb,0xbd,0x80,0x80,
+    0x00,0x8b,0x00,0x0e,0x37,0x77,0x87,0x65,0x55,0x55,0x66,0x78,0x77,0x77,0x60,0x04,
+    0xdf,0xbe,0x20,0x80,0x00,0x8b,0x00,0x00,0x17,0x86,0x77,0x03,0x80,0x00,0x00,0x31,
+    0x81,0x00,0x8b,0x00,0x00,0x08,0x86,0x77,0x00,0x74,0x84,0x00,0x8b,0x00,0x00,0x07,
+    0x87,0x77,0x84,0x00,0x8b,0x00,0x00,0x04,0x87,0x77,0x00,0x10,0x83,0x00,0x8b,0x00,
+    0x00,0x01,0x87,0x77,0x00,0x50,0x83,0x00,0x8c,0x00,0x87,0x77,0x00,0x80,0x83,0x00,
+};
+
+static const uint8_t image_fallout_data5[] =
+{
+    0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x8e,0x00,0x06,0x01,
+    0x00,0x00,0x11,0x00,0x09,0xa0,0x85,0x00,0x8e,0x00,0x06,0xe0,0x00,0x0c,0xef,0xb8,
+    0xed,0xda,0x85,0x00,0x8d,0x00,0x03,0x05,0xe4,0x03,0xed,0x80,0xdd,0x01,0xde,0x53,
+    0x84,0x00,0x8d,0x00,0x02,0x08,0xdd,0xfe,0x82,0xdd,0x01,0xde,0xb0,0x83,0x00,0x8d,
+    0x00,0x09,0x03,0xed,0xdc,0x88,0xed,0xde,0xed,0xdd,0xdd,0xe4,0x83,0x00,0x8e,0x00,
+    0x08,0x5b,0xa6,0xfc,0x1a,0x83,0x1a,0xed,0xdd,0xdb,0x83,0x00,0x8d,0x00,0x0a,0x02,
+    0xb9,0x90,0xad,0xfe,0xfe,0xf7,0x9e,0xee,0xed,0x90,0x82,0x00,0x8d,0x00,0x0a,0x01,
+    0x4d,0xdf,0xfe,0xee,0xea,0xbf,0x61,0x34,0x7d,0xe3,0x82,0x00,0x8a,0x00,0x04,0xce,
+    0x30,0x00,0x00,0xfe,0x80,0xee,0x05,0xea,0x0d,0xee,0xee,0xf6,0xea,0x82,0x00,0x86,
+    0x00,0x11,0x0d,0xff,0xb0,0x0b,0xdf,0x50,0x00,0x0a,0xe6,0xbe,0xee,0xee,0xed,0xba,
+    0xee,0xee,0xe9,0xea,0x82,0x00,0x86,0x00,0x0a,0x0b,0xbc,0xef,0x0f,0xf5,0x00,0x00,
+    0x2f,0xa0,0xae,0xfc,0x82,0xee,0x01,0xc9,0xdb,0x82,0x00,0x86,0x00,0x11,0xbf,0xea,
+    0x1a,0x4e,0x90,0x00,0x00,0xbe,0xd7,0xfe,0x6e,0xee,0xac,0xee,0xee,0xea,0x4e,0xd8,
+    0x82,0x00,0x86,0x00,0x11,0xfe,0xfe,0xe9,0xbf,0x50,0x00,0x01,0xfe,0xee,0xc0,0xde,
+    0xea,0x18,0xee,0xee,0xf3,0x6e,0xe1,0x82,0x00,0x86,0x00,0x11,0x14,0x16,0x84,0xff,
+    0x50,0x00,0x07,0xee,0xee,0x0f,0xee,0xeb,0x1e,0xee,0xee,0x9d,0x84,0xb0,0x82,0x00,
+    0x86,0x00,0x09,0xfd,0xef,0x5c,0xee,0xa0,0x00,0x0a,0xee,0xee,0x9d,0x81,0xee,0x02,
+    0xed,0xb3,0xa8,0x83,0x00,0x86,0x00,0x08,0xfc,0xdd,0x7c,0xae,0xc0,0x00,0x0b,0xea,
+    0xfe,0x82,0xee,0x02,0xed,0x6b,0xa0,0x83,0x00,0x86,0x00,0x08,0xfd,0xaa,0xde,0xd9,
+    0xa0,0x00,0x0b,0x9a,0xae,0x82,0xee,0x02,0xed,0xa7,0x50,0x83,0x00,0x86,0x00,0x0b,
+    0xce,0xee,0xee,0xf5,0x00,0x00,0x0a,0xf5,0xf5,0xbd,0xdd,0xd5,0x80,0xee,0x00,0xf4,
+    0x84,0x00,0x85,0x00,0x0d,0x01,0x8e,0xee,0xee,0xf3,0x00,0x00,0x07,0xef,0x3e,0xfd,
+    0xbb,0xdf,0x6e,0x80,0xee,0x00,0x70,0x83,0x00,0x85,0x00,0x04,0x01,0x9b,0xee,0xee,
+    0xc1,0x80,0x00,0x05,0xfe,0xec,0x38,0xaa,0x52,0x9e,0x80,0xee,0x00,0xb0,0x83,0x00,
+    0x85,0x00,0x0a,0x11,0xf9,0x18,0x71,0x99,0x50,0x00,0x00,0xae,0xeb,0xde,0x83,0xee,
+    0x00,0x70,0x83,0x00,0x85,0x00,0x0a,0x36,0xad,0xde,0xed,0xe2,0x80,0x00,0x00,0x0d,
+    0xef,0x9d,0x81,0xee,0x01,0xd1,0x70,0x84,0x00,0x85,0x00,0x05,0x48,0x1b,0xdd,0xdd,
+    0x67,0x60,0x80,0x00,0x00,0xde,0x81,0xee,0x00,0xea,0x86,0x00,0x85,0x00,0x09,0x48,
+    0x85,0x00,0x02,0x88,0x46,0x88,0x88,0x1d,0x4a,0x80,0xee,0x03,0xea,0x0c,0xd3,0x10,
+    0x84,0x00,0x85,0x00,0x00,0x38,0x81,0x88,0x0c,0x19,0x88,0x88,0x7d,0x8e,0xa9,0xfe,
+    0xee,0xf2,0xed,0xe0,0x98,0x40,0x83,0x00,0x85,0x00,0x00,0x09,0x80,0x88,0x0e,0x84,
+    0x68,0x88,0x88,0x9d,0xba,0xee,0xee,0xec,0x2e,0xdd,0x96,0x88,0x88,0x71,0x82,0x00,
+    0x85,0x00,0x00,0x06,0x80,0x88,0x0b,0x75,0x88,0x88,0x89,0x6e,0xd9,0x6c,0xb7,0x1c,
+    0xdd,0xdb,0x28,0x80,0x88,0x00,0x71,0x81,0x00,0x85,0x00,0x00,0x01,0x84,0x88,0x00,
+    0x3d,0x82,0xdd,0x00,0x93,0x82,0x88,0x00,0x60,0x80,0x00,0x86,0x00,0x00,0x68,0x80,
+    0x88,0x04,0x86,0x88,0x88,0x81,0xcd,0x80,0xdd,0x01,0xa1,0x78,0x83,0x88,0x02,0x20,
+    0x00,0x00,0x86,0x00,0x00,0x07,0x80,0x88,0x07,0x82,0x98,0x88,0x86,0xad,0xdd,0xe4,
+    0x14,0x85,0x88,0x02,0x87,0x00,0x00,0x87,0x00,0x09,0x78,0x88,0x88,0x82,0x98,0x88,
+    0x83,0xdd,0xdd,0xc4,0x87,0x88,0x01,0x81,0x00,0x87,0x00,0x09,0x02,0x88,0x88,0x82,
+    0x88,0x88,0x83,0xfd,0xdd,0xa6,0x88,0x88,0x00,0x30,0x89,0x00,0x07,0x58,0x92,0x88,
+    0x88,0x94,0xed,0xdd,0x98,0x88,0x88,0x00,0x81,0x8a,0x00,0x06,0x03,0x88,0x88,0x96,
+    0xdd,0xdd,0x69,0x88,0x88,0x00,0x84,0x8a,0x00,0x06,0x03,0x88,0x88,0x98,0xdd,0xde,
+    0x59,0x88,0x88,0x00,0x85,0x8a,0x00,0x06,0x03,0x88,0x88,0x7a,0xdd,0xde,0x48,0x82,
+    0x88,0x02,0x85,0x33,0x78,0x80,0x88,0x00,0x84,0x8a,0x00,0x06,0x03,0x88,0x88,0x6a,
+    0xdd,0xdf,0x38,0x82,0x88,0x02,0x81,0x00,0x07,0x80,0x88,0x00,0x82,0x8a,0x00,0x06,
+    0x03,0x88,0x88,0x5b,0xdd,0xdf,0x28,0x82,0x88,0x02,0x60,0x00,0x28,0x80,0x88,0x00,
+    0x90,0x8a,0x00,0x06,0x03,0x88,0x88,0x4c,0xdd,0xde,0x28,0x82,0x88,0x02,0x10,0x00,
+    0x48,0x80,0x88,0x00,0x60,0x8a,0x00,0x06,0x02,0x88,0x88,0x3c,0xdd,0xde,0x28,0x81,
+    0x88,0x02,0x87,0x00,0x00,0x81,0x88,0x00,0x30,0x8a,0x00,0x06,0x02,0x88,0x88,0x3d,
+    0xdd,0xde,0x28,0x81,0x88,0x02,0x84,0x00,0x03,0x80,0x88,0x01,0x89,0x00,0x8a,0x00,
+    0x06,0x01,0x88,0x88,0x2d,0xdd,0xdd,0x28,0x81,0x88,0x02,0x81,0x00,0x06,0x80,0x88,
+    0x01,0x84,0x00,0x8b,0x00,0x05,0x58,0x88,0x2e,0xdd,0xdd,0x28,0x81,0x88,0x02,0x70,
+    0x00,0x07,0x80,0x88,0x01,0x80,0x00,0x8b,0x00,0x11,0xd6,0x05,0x2e,0xdd,0xdd,0x28,
+    0x88,0x98,0x63,0x00,0x70,0x00,0x7b,0x06,0x88,0x88,0x20,0x00,0x8b,0x00,0x11,0xed,
+    0xdc,0xbd,0xdd,0xde,0x00,0x00,0x59,0xbc,0xde,0xc0,0x00,0xad,0xdc,0x41,0x63,0x00,
+    0x00,0x8b,0x00,0x00,0xcd,0x81,0xdd,0x0c,0xee,0xee,0xed,0xdd,0xdd,0xb0,0x00,0x52,
+    0xdd,0xdd,0x60,0x00,0x00,0x8b,0x00,0x00,0xbd,0x86,0xdd,0x04,0xb0,0x00,0xfe,0xb3,
+    0x59,0x80,0x00,0x8b,0x00,0x00,0xad,0x86,0xdd,0x04,0xa0,0x07,0xee,0xef,0xd0,0x80,
+    0x00,0x8b,0x00,0x01,0x0b,0xed,0x84,0xdd,0x05,0xde,0x90,0x0a,0xee,0xee,0x40,0x80,
+    0x00,0x8b,0x00,0x02,0x16,0x28,0xde,0x81,0xdd,0x07,0xde,0xd9,0x30,0x30,0x0d,0xee,
+    0xd6,0xd4,0x80,0x00,0x8b,0x00,0x0e,0x09,0x87,0x43,0x33,0x67,0x77,0x53,0x23,0x46,
+    0x78,0x80,0x09,0xed,0xac,0xc4,0x80,0x00,0x8b,0x00,0x00,0x08,0x80,0x88,0x02,0x77,
+    0x77,0x78,0x80,0x88,0x04,0x90,0x00,0x4b,0xfc,0xf0,0x80,0x00,0x8b,0x00,0x00,0x06,
+    0x86,0x88,0x03,0x82,0x00,0x00,0x03,0x81,0x00,0x8b,0x00,0x00,0x05,0x86,0x88,0x00,
+    0x85,0x84,0x00,0x8b,0x00,0x00,0x03,0x86,0x88,0x00,0x87,0x84,0x00,0x8b,0x00,0x00,
+    0x01,0x86,0x88,0x00,0x89,0x84,0x00,0x8c,0x00,0x87,0x88,0x00,0x40,0x83,0x00,0x8c,
+    0x00,0x00,0x68,0x86,0x88,0x00,0x80,0x83,0x00,
+};
+
+static const uint8_t image_fallout_data6[] =
+{
+    0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x9d,0x00,0x92,0x00,
+    0x01,0x04,0x40,0x86,0x00,0x8d,0x00,0x06,0x10,0x00,0x01,0xa8,0x32,0xbd,0xd5,0x86,
+    0x00,0x8d,0x00,0x07,0xe0,0x00,0x6e,0xdd,0xde,0xdd,0xdd,0x21,0x85,0x00,0x8c,0x00,
+    0x03,0x05,0xe6,0x48,0xed,0x81,0xdd,0x01,0xde,0xc0,0x84,0x00,0x8c,0x00,0x03,0x06,
+    0xdd,0xed,0xed,0x82,0xdd,0x00,0xe4,0x84,0x00,0x8d,0x00,0x08,0xed,0xea,0x11,0xad,
+    0xc9,0x6b,0xdd,0xdd,0xdc,0x84,0x00,0x8d,0x00,0x09,0x19,0x49,0xdf,0x71,0x6e,0xf4,
+    0x8e,0xee,0xed,0xc0,0x83,0x00,0x8d,0x00,0x09,0xc9,0x61,0x7e,0xee,0xde,0xcf,0x41,
+    0x32,0x4b,0xd8,0x83,0x00,0x8d,0x00,0x09,0x1f,0xfe,0xee,0xee,0xe9,0x0c,0xef,0xed,
+    0xe8,0xdd,0x83,0x00,0x8d,0x00,0x00,0xce,0x81,0xee,0x04,0xb4,0xfe,0xee,0xea,0xcf,
+    0x83,0x00,0x8c,0x00,0x02,0x04,0xf6,0x0f,0x80,0xee,0x04,0xec,0xfe,0xee,0xf4,0xef,
+    0x83,0x00,0x8c,0x00,0x04,0x0c,0xf0,0x4f,0xf7,0xfe,0x80,0xee,0x02,0xef,0x0d,0xdc,
+    0x83,0x00,0x8c,0x00,0x0a,0x3f,0xeb,0xfe,0x4c,0xee,0xb7,0xde,0xee,0xe9,0xa4,0xd8,
+    0x83,0x00,0x81,0x00,0x01,0x02,0xbb,0x86,0x00,0x0a,0xae,0xee,0xd0,0xce,0xed,0xdb,
+    0x9e,0xee,0xda,0x49,0xb0,0x83,0x00,0x81,0x00,0x02,0x4e,0xee,0x50,0x85,0x00,0x03,
+    0xde,0xee,0x9a,0xde,0x81,0xee,0x02,0xb8,0xb4,0x30,0x83,0x00,0x81,0x00,0x01,0xbe,
+    0xef,0x86,0x00,0x03,0xfe,0xee,0xe7,0xfe,0x81,0xee,0x01,0xe3,0x5b,0x84,0x00,0x81,
+    0x00,0x01,0xde,0xed,0x86,0x00,0x01,0xfd,0x9e,0x83,0xee,0x01,0x6c,0x90,0x84,0x00,
+    0x81,0x00,0x01,0xce,0xe9,0x86,0x00,0x01,0xf3,0xbb,0x80,0xee,0x03,0xde,0xee,0xee,
+    0xed,0x85,0x00,0x81,0x00,0x01,0x9e,0xea,0x86,0x00,0x05,0xdf,0x5f,0x74,0x8a,0x93,
+    0x4b,0x80,0xee,0x00,0xf3,0x84,0x00,0x81,0x00,0x01,0x4f,0xef,0x86,0x00,0x05,0x9e,
+    0xf2,0xcf,0xff,0xfe,0x68,0x80,0xee,0x00,0xe9,0x84,0x00,0x81,0x00,0x02,0x06,0xce,
+    0xe1,0x85,0x00,0x05,0x2f,0xee,0xfa,0x77,0xad,0xbe,0x80,0xee,0x00,0xf4,0x84,0x00,
+    0x07,0x00,0x00,0x05,0xde,0xef,0xb0,0xdf,0x30,0x84,0x00,0x03,0x0a,0xee,0x79,0xce,
+    0x80,0xee,0x01,0xed,0x03,0x85,0x00,0x02,0x00,0x00,0x4f,0x80,0xee,0x01,0x5d,0xf0,
+    0x85,0x00,0x00,0xce,0x82,0xee,0x00,0xc0,0x86,0x00,0x02,0x00,0x00,0x4f,0x80,0xee,
+    0x01,0xf4,0xe9,0x85,0x00,0x00,0x0b,0x81,0xee,0x01,0xe4,0x97,0x86,0x00,0x17,0x00,
+    0x00,0x0c,0x51,0x05,0xbe,0xf3,0xea,0x36,0x65,0x43,0x21,0x23,0x44,0x56,0x66,0x7a,
+    0x0c,0xee,0xee,0xea,0xb6,0xdd,0xb1,0x85,0x00,0x08,0x00,0x00,0x06,0xee,0xee,0xe4,
+    0x0b,0xd8,0xe2,0x83,0x66,0x09,0x63,0xcc,0x9e,0xce,0xee,0xeb,0x5d,0xdd,0x75,0x66,
+    0x84,0x00,0x02,0x00,0x00,0x0f,0x80,0xee,0x03,0xc9,0xf5,0xe5,0x76,0x82,0x66,0x0a,
+    0x63,0xce,0x4e,0xee,0xec,0x1b,0xdd,0xdd,0x07,0x66,0x65,0x83,0x00,0x02,0x00,0x00,
+    0x0c,0x80,0xee,0x03,0xe8,0x95,0xf5,0x76,0x82,0x66,0x07,0x65,0x9d,0xda,0x21,0x5c,
+    0xdd,0xdd,0xd0,0x80,0x66,0x00,0x60,0x82,0x00,0x80,0x00,0x06,0x1a,0xb9,0x46,0xc7,
+    0xe5,0xf5,0x76,0x82,0x66,0x01,0x67,0x1e,0x81,0xdd,0x01,0xda,0x16,0x81,0x66,0x00,
+    0x10,0x81,0x00,0x80,0x00,0x05,0xfe,0xee,0xee,0x5f,0xf4,0xf3,0x81,0x66,0x03,0x65,
+    0x66,0x66,0x60,0x80,0xdd,0x01,0xd8,0x06,0x82,0x66,0x00,0x62,0x81,0x00,0x80,0x00,
+    0x05,0xfe,0xee,0xed,0x8f,0xc7,0xa5,0x81,0x66,0x07,0x73,0x66,0x66,0x61,0xed,0xdd,
+    0xb1,0x46,0x84,0x66,0x00,0x30,0x80,0x00,0x80,0x00,0x05,0x05,0x78,0x53,0xbd,0x3e,
+    0x26,0x81,0x66,0x06,0x42,0x66,0x66,0x72,0xed,0xdd,0x86,0x85,0x66,0x00,0x62,0x80,
+    0x00,0x81,0x00,0x03,0x5a,0xba,0x1b,0xb1,0x80,0x66,0x08,0x41,0x00,0x03,0x66,0x66,
+    0x75,0xed,0xdd,0x57,0x86,0x66,0x02,0x10,0x00,0x00,0x8a,0x00,0x06,0x03,0x66,0x66,
+    0x76,0xdd,0xde,0x47,0x86,0x66,0x02,0x70,0x00,0x00,0x8a,0x00,0x06,0x04,0x66,0x66,
+    0x68,0xdd,0xde,0x37,0x87,0x66,0x01,0x00,0x00,0x8a,0x00,0x06,0x03,0x66,0x66,0x5a,
+    0xdd,0xdf,0x26,0x87,0x66,0x01,0x40,0x00,0x8a,0x00,0x06,0x03,0x66,0x66,0x4b,0xdd,
+    0xdf,0x16,0x81,0x66,0x01,0x21,0x35,0x81,0x66,0x01,0x70,0x00,0x8a,0x00,0x06,0x03,
+    0x66,0x66,0x3b,0xdd,0xde,0x16,0x81,0x66,0x02,0x67,0x00,0x07,0x80,0x66,0x01,0x71,
+    0x00,0x8a,0x00,0x06,0x03,0x66,0x66,0x3c,0xdd,0xde,0x16,0x81,0x66,0x02,0x65,0x00,
+    0x36,0x80,0x66,0x01,0x70,0x00,0x8a,0x00,0x06,0x03,0x66,0x66,0x2d,0xdd,0xdd,0x26,
+    0x81,0x66,0x02,0x63,0x00,0x56,0x80,0x66,0x01,0x40,0x00,0x8a,0x00,0x06,0x02,0x66,
+    0x66,0x1d,0xdd,0xdc,0x26,0x81,0x66,0x07,0x70,0x00,0x76,0x66,0x66,0x67,0x00,0x00,
+    0x8a,0x00,0x06,0x01,0x66,0x66,0x1e,0xdd,0xdd,0x26,0x81,0x66,0x01,0x70,0x03,0x80,
+    0x66,0x02,0x65,0x00,0x00,0x8a,0x00,0x06,0x01,0x66,0x66,0x1e,0xdd,0xdd,0x26,0x81,
+    0x66,0x01,0x60,0x06,0x80,0x66,0x02,0x71,0x00,0x00,0x8b,0x00,0x05,0x37,0x66,0x1e,
+    0xdd,0xdd,0x16,0x80,0x66,0x02,0x74,0x00,0x26,0x80,0x66,0x02,0x50,0x00,0x00,0x8b,
+    0x00,0x0e,0xd8,0x02,0x0d,0xdd,0xde,0x17,0x66,0x52,0x00,0x7b,0xa0,0x73,0x76,0x66,
+    0x67,0x80,0x00,0x8b,0x00,0x0e,0xdd,0xec,0xcd,0xdd,0xde,0x66,0x69,0xbc,0xde,0xdd,
+    0xa0,0xfb,0x04,0x76,0x63,0x80,0x00,0x8b,0x00,0x00,0xbd,0x86,0xdd,0x04,0xb5,0x2e,
+    0xdb,0x50,0x10,0x80,0x00,0x8b,0x00,0x00,0x9d,0x86,0xdd,0x04,0xba,0xe5,0x4b,0xff,
+    0x10,0x80,0x00,0x8b,0x00,0x00,0x7d,0x86,0xdd,0x03,0xab,0xee,0xdb,0x80,0x81,0x00,
+    0x8b,0x00,0x01,0x07,0xfd,0x84,0xdd,0x04,0xe9,0x0b,0xee,0xee,0x0b,0x81,0x00,0x8b,
+    0x00,0x0d,0x06,0x23,0xae,0xee,0xdd,0xde,0xee,0xeb,0x51,0x14,0x5a,0xee,0xe4,0xef,
+    0x81,0x00,0x8b,0x00,0x0d,0x06,0x66,0x53,0x22,0x21,0x22,0x22,0x35,0x67,0x66,0x76,
+    0xee,0xeb,0x5f,0x81,0x00,0x8b,0x00,0x06,0x05,0x66,0x66,0x67,0x77,0x77,0x76,0x80,
+    0x66,0x03,0x63,0x8f,0xff,0xfa,0x81,0x00,0x8b,0x00,0x00,0x03,0x86,0x66,0x03,0x67,
+    0x00,0x02,0x20,0x81,0x00,0x8b,0x00,0x00,0x01,0x87,0x66,0x00,0x40,0x83,0x00,0x8c,
+    0x00,0x00,0x76,0x86,0x66,0x00,0x60,0x83,0x00,0x8c,0x00,0x00,0x56,0x86,0x66,0x00,
+    0x61,0x83,0x00,
+};
+
+static const struct ssd1322_image image_fallout[] =
+{
+    { image_fallout_data0, 973, 64, 64 },
+    { image_fallout_data1, 975, 64, 64 },
+    { image_fallout_data2, 978, 64, 64 },
+    { image_fallout_data3, 975, 64, 64 },
+    { image_fallout_data4, 1040, 64, 64 },
+    { image_fallout_data5, 1065, 64, 64 },
+    { image_fallout_data6, 1059, 64, 64 },
+};
+
+#endif
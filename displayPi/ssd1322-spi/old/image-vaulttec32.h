@@ -0,0 +1,49 @@
+/*
+    Image vaulttec32, generated by imageconvert.
+*/
+
+#ifndef IMAGE_VAULTTEC32_H
+#define IMAGE_VAULTTEC32_H
+
+#include "ssd1322-image.h"
+
+static const uint8_t image_vaulttec32_data[] =
+{
+    0x9d,0x00,0x9d,0x00,0x9d,0x00,0x8c,0x00,0x02,0x7a,0xad,0xa0,0x8b,0x00,0x8a,0x00,
+    0x00,0x05,0x81,0x22,0x00,0x1a,0x8a,0x00,0x89,0x00,0x01,0x07,0x23,0x81,0x33,0x01,
+    0x32,0x22,0x89,0x00,0x89,0x00,0x08,0x13,0x33,0x33,0x23,0x52,0x23,0x33,0x32,0x10,
+    0x88,0x00,0x81,0x00,0x85,0x22,0x02,0x33,0x32,0xd0,0x80,0x00,0x02,0xa3,0x33,0x21,
+    0x84,0x22,0x00,0x40,0x80,0x00,0x80,0x00,0x00,0x02,0x84,0x22,0x02,0x33,0x33,0x50,
+    0x82,0x00,0x02,0x23,0x33,0x32,0x83,0x22,0x00,0x21,0x80,0x00,0x80,0x00,0x01,0x02,
+    0x35,0x84,0x55,0x00,0x2a,0x83,0x00,0x01,0x03,0x35,0x84,0x55,0x00,0x31,0x80,0x00,
+    0x80,0x00,0x00,0x02,0x82,0x33,0x03,0x35,0x55,0x53,0x50,0x84,0x00,0x02,0x25,0x55,
+    0x53,0x82,0x33,0x00,0x21,0x80,0x00,0x81,0x00,0x83,0xaa,0x01,0x35,0x32,0x85,0x00,
+    0x02,0x03,0x55,0x7a,0x82,0xaa,0x00,0xd0,0x80,0x00,0x87,0x00,0x01,0x35,0x32,0x80,
+    0x00,0x01,0x0f,0x74,0x80,0x00,0x02,0x07,0x33,0x20,0x86,0x00,0x87,0x00,0x07,0x33,
+    0x20,0x00,0x00,0x07,0x22,0x22,0x10,0x80,0x00,0x01,0x33,0x20,0x86,0x00,0x01,0x00,
+    0xfa,0x84,0xaa,0x08,0xa7,0x33,0x10,0x00,0x00,0x02,0x35,0x53,0x21,0x80,0x00,0x01,
+    0x33,0x3a,0x85,0xaa,0x00,0x40,0x01,0x01,0x23,0x85,0x33,0x0c,0x53,0x50,0x00,0x00,
+    0xd3,0x55,0x55,0x32,0xa0,0x00,0x00,0x25,0x53,0x84,0x33,0x01,0x32,0x27,0x01,0x02,
+    0x35,0x85,0x55,0x0b,0x53,0x70,0x00,0x00,0x23,0x55,0x55,0x52,0xf0,0x00,0x00,0x25,
+    0x86,0x55,0x00,0x21,0x00,0x01,0x85,0x33,0x0d,0x35,0x53,0x50,0x00,0x00,0xd3,0x55,
+    0x55,0x52,0xa0,0x00,0x00,0x25,0x55,0x85,0x33,0x00,0x2a,0x01,0x00,0x4f,0x84,0xff,
+    0x08,0x2a,0x53,0x10,0x00,0x00,0x02,0x55,0x55,0x32,0x80,0x00,0x01,0x25,0x3f,0x85,
+    0xff,0x00,0xa0,0x87,0x00,0x07,0x33,0x20,0x00,0x00,0x0a,0x23,0x33,0x20,0x80,0x00,
+    0x01,0x33,0x20,0x86,0x00,0x87,0x00,0x01,0x33,0x2d,0x80,0x00,0x01,0x04,0xd7,0x80,
+    0x00,0x02,0x05,0x33,0x10,0x86,0x00,0x81,0x00,0x00,0x75,0x81,0x55,0x02,0x57,0x35,
+    0x32,0x85,0x00,0x02,0x03,0x53,0x35,0x82,0x55,0x00,0x70,0x80,0x00,0x80,0x00,0x01,
+    0x02,0x23,0x82,0x33,0x02,0x55,0x52,0x30,0x84,0x00,0x01,0x23,0x55,0x82,0x33,0x01,
+    0x32,0x21,0x80,0x00,0x80,0x00,0x00,0x02,0x84,0x55,0x01,0x53,0x2a,0x83,0x00,0x01,
+    0x02,0x35,0x84,0x55,0x00,0x31,0x80,0x00,0x80,0x00,0x00,0x02,0x84,0x33,0x02,0x35,
+    0x32,0x20,0x82,0x00,0x01,0x23,0x55,0x84,0x33,0x00,0x21,0x80,0x00,0x81,0x00,0x00,
+    0x7f,0x82,0x22,0x04,0x2f,0x23,0x33,0x22,0xa0,0x80,0x00,0x02,0x52,0x33,0x32,0x83,
+    0x22,0x01,0xff,0xa0,0x80,0x00,0x89,0x00,0x01,0x23,0x33,0x81,0x22,0x02,0x33,0x33,
+    0x10,0x88,0x00,0x89,0x00,0x00,0x0a,0x83,0x33,0x00,0x24,0x89,0x00,0x8a,0x00,0x01,
+    0x05,0x23,0x80,0x33,0x00,0x2d,0x8a,0x00,0x8c,0x00,0x02,0xad,0xaf,0xc0,0x8b,0x00,
+    0x9d,0x00,0x9d,0x00,
+};
+
+static const struct ssd1322_image image_vaulttec32 =
+    { image_vaulttec32_data, 500, 64, 32 };
+
+#endif
@@ -0,0 +1,99 @@
+/*
+    Image vaulttec64, generated by imageconvert.
+*/
+
+#ifndef IMAGE_VAULTTEC64_H
+#define IMAGE_VAULTTEC64_H
+
+#include "ssd1322-image.h"
+
+static const uint8_t image_vaulttec64_data[] =
+{
+    0xbd,0x00,0xbd,0x00,0xbd,0x00,0xbd,0x00,0xbd,0x00,0xbd,0x00,0x9a,0x00,0x05,0x0c,
+    0x72,0xaa,0xaa,0xd2,0xa0,0x9a,0x00,0x99,0x00,0x01,0x25,0x11,0x81,0x22,0x02,0x11,
+    0x1a,0x70,0x98,0x00,0x97,0x00,0x01,0x0a,0x51,0x85,0x22,0x01,0x11,0xa0,0x97,0x00,
+    0x96,0x00,0x03,0x0a,0x22,0x22,0x23,0x83,0x33,0x03,0x32,0x22,0x21,0xa0,0x96,0x00,
+    0x96,0x00,0x01,0x71,0x22,0x87,0x33,0x02,0x22,0x21,0x20,0x95,0x00,0x95,0x00,0x01,
+    0x71,0x22,0x89,0x33,0x01,0x22,0x15,0x95,0x00,0x94,0x00,0x01,0x0f,0x12,0x81,0x33,
+    0x05,0x32,0x22,0x35,0x55,0x22,0x23,0x80,0x33,0x02,0x32,0x22,0x1a,0x94,0x00,0x94,
+    0x00,0x01,0xd2,0x23,0x80,0x33,0x02,0x22,0x7f,0xa0,0x80,0x00,0x01,0x4a,0x32,0x80,
+    0x33,0x02,0x32,0x21,0xa0,0x93,0x00,0x84,0x00,0x00,0x0c,0x8b,0x22,0x01,0x2a,0x22,
+    0x80,0x33,0x01,0x22,0xd0,0x83,0x00,0x01,0x07,0xa2,0x80,0x33,0x01,0x22,0x1f,0x8b,
+    0x22,0x00,0x40,0x84,0x00,0x84,0x00,0x00,0xa1,0x8c,0x22,0x80,0x33,0x01,0x22,0xd0,
+    0x85,0x00,0x01,0x0c,0x72,0x80,0x33,0x8c,0x22,0x01,0x11,0x70,0x83,0x00,0x83,0x00,
+    0x00,0x0f,0x8b,0x22,0x00,0x23,0x80,0x33,0x01,0x32,0x5c,0x87,0x00,0x01,0x02,0x23,
+    0x80,0x33,0x00,0x32,0x8a,0x22,0x01,0x21,0x10,0x83,0x00,0x83,0x00,0x01,0x01,0x22,
+    0x8b,0x33,0x03,0x53,0x53,0x32,0x2a,0x89,0x00,0x02,0xc3,0x33,0x55,0x8c,0x33,0x01,
+    0x22,0x1d,0x83,0x00,0x83,0x00,0x02,0x01,0x23,0x35,0x8b,0x55,0x02,0x53,0x22,0xa0,
+    0x8a,0x00,0x01,0x33,0x35,0x8b,0x55,0x02,0x53,0x32,0x17,0x83,0x00,0x83,0x00,0x01,
+    0x01,0x23,0x8c,0x55,0x01,0x33,0x2a,0x8b,0x00,0x01,0x02,0x33,0x8b,0x55,0x02,0x53,
+    0x32,0x1a,0x83,0x00,0x83,0x00,0x01,0x0a,0x22,0x87,0x33,0x00,0x35,0x80,0x55,0x02,
+    0x53,0x32,0x50,0x8b,0x00,0x01,0x0a,0x23,0x81,0x55,0x88,0x33,0x01,0x22,0x10,0x83,
+    0x00,0x84,0x00,0x01,0x52,0x23,0x88,0x33,0x03,0x55,0x55,0x53,0x22,0x8d,0x00,0x03,
+    0xf2,0x35,0x55,0x55,0x88,0x33,0x02,0x22,0x21,0xf0,0x83,0x00,0x84,0x00,0x00,0x04,
+    0x89,0xaa,0x03,0x35,0x55,0x33,0x2f,0x8d,0x00,0x04,0x05,0x33,0x55,0x53,0x7a,0x88,
+    0xaa,0x00,0xda,0x84,0x00,0x91,0x00,0x03,0x25,0x55,0x32,0x20,0x8d,0x00,0x04,0x07,
+    0x23,0x55,0x33,0x50,0x90,0x00,0x90,0x00,0x04,0x0d,0x33,0x53,0x32,0x20,0x83,0x00,
+    0x03,0x0c,0xfa,0x7a,0x40,0x84,0x00,0x03,0x73,0x35,0x33,0x20,0x90,0x00,0x90,0x00,
+    0x03,0x02,0x33,0x33,0x22,0x84,0x00,0x04,0x71,0x22,0x22,0x11,0xd0,0x83,0x00,0x03,
+    0x22,0x33,0x33,0x22,0x90,0x00,0x90,0x00,0x03,0x02,0x33,0x33,0x27,0x83,0x00,0x00,
+    0x71,0x81,0x22,0x00,0x13,0x83,0x00,0x03,0x02,0x33,0x33,0x27,0x90,0x00,0x90,0x00,
+    0x03,0xa2,0x33,0x33,0x22,0x82,0x00,0x07,0x0c,0x12,0x23,0x33,0x33,0x32,0x21,0x70,
+    0x82,0x00,0x03,0x07,0x33,0x33,0x21,0x90,0x00,0x02,0x00,0x00,0xfa,0x8d,0xaa,0x03,
+    0x73,0x33,0x32,0x10,0x82,0x00,0x07,0x03,0x23,0x35,0x55,0x55,0x33,0x22,0x12,0x82,
+    0x00,0x03,0x0d,0x33,0x33,0x32,0x8e,0xaa,0x01,0x40,0x00,0x02,0x00,0xa1,0x12,0x8d,
+    0x22,0x03,0x33,0x53,0x32,0x20,0x82,0x00,0x01,0x72,0x23,0x80,0x55,0x02,0x53,0x32,
+    0x21,0x82,0x00,0x03,0x04,0x23,0x55,0x33,0x8d,0x22,0x02,0x21,0x15,0x00,0x02,0x00,
+    0x12,0x22,0x8d,0x33,0x03,0x35,0x53,0x32,0x50,0x82,0x00,0x01,0xd2,0x35,0x81,0x55,
+    0x02,0x33,0x21,0xa0,0x81,0x00,0x03,0x0a,0x23,0x55,0x53,0x8c,0x33,0x03,0x32,0x22,
+    0x21,0x70,0x01,0x04,0x22,0x8d,0x33,0x04,0x55,0x55,0x53,0x32,0x70,0x82,0x00,0x01,
+    0x52,0x35,0x81,0x55,0x02,0x53,0x21,0x40,0x82,0x00,0x03,0x23,0x55,0x55,0x53,0x8c,
+    0x33,0x02,0x32,0x22,0x10,0x02,0x02,0x23,0x35,0x8e,0x55,0x02,0x53,0x32,0x70,0x82,
+    0x00,0x01,0x22,0x35,0x81,0x55,0x02,0x53,0x22,0xf0,0x82,0x00,0x00,0x23,0x8f,0x55,
+    0x02,0x53,0x22,0x10,0x02,0x04,0x22,0x35,0x8e,0x55,0x02,0x53,0x32,0x70,0x82,0x00,
+    0x01,0x72,0x35,0x81,0x55,0x02,0x53,0x21,0x40,0x82,0x00,0x00,0x23,0x8f,0x55,0x02,
+    0x53,0x22,0x10,0x01,0x00,0x12,0x8d,0x33,0x04,0x35,0x55,0x53,0x32,0x50,0x82,0x00,
+    0x01,0xd2,0x35,0x81,0x55,0x02,0x53,0x21,0xa0,0x81,0x00,0x04,0x0a,0x23,0x55,0x55,
+    0x53,0x8c,0x33,0x02,0x32,0x22,0xa0,0x01,0x00,0xc1,0x8c,0x22,0x05,0x23,0x33,0x35,
+    0x55,0x32,0x20,0x82,0x00,0x01,0xa2,0x35,0x81,0x55,0x01,0x33,0x22,0x82,0x00,0x05,
+    0x04,0x23,0x55,0x53,0x33,0x32,0x8c,0x22,0x01,0x17,0x00,0x02,0x00,0x00,0x4f,0x8c,
+    0xff,0x04,0x22,0xa3,0x53,0x32,0x1c,0x82,0x00,0x01,0x07,0x23,0x80,0x55,0x02,0x53,
+    0x32,0x24,0x82,0x00,0x03,0x0d,0x23,0x55,0x32,0x8e,0xff,0x01,0xa0,0x00,0x90,0x00,
+    0x03,0xa3,0x33,0x32,0x22,0x82,0x00,0x07,0x0c,0x13,0x35,0x55,0x55,0x33,0x22,0x70,
+    0x82,0x00,0x03,0x07,0x33,0x33,0x31,0x90,0x00,0x90,0x00,0x03,0x02,0x33,0x33,0x27,
+    0x83,0x00,0x05,0xa1,0x23,0x33,0x33,0x32,0x25,0x83,0x00,0x03,0x02,0x33,0x33,0x27,
+    0x90,0x00,0x90,0x00,0x03,0x02,0x33,0x33,0x21,0x84,0x00,0x04,0x71,0x22,0x22,0x21,
+    0x20,0x83,0x00,0x03,0x22,0x33,0x33,0x24,0x90,0x00,0x90,0x00,0x04,0x0f,0x33,0x33,
+    0x22,0xd0,0x84,0x00,0x02,0x4d,0xdd,0x70,0x84,0x00,0x03,0x53,0x33,0x33,0x10,0x90,
+    0x00,0x91,0x00,0x03,0x23,0x53,0x32,0x20,0x8d,0x00,0x04,0x04,0x23,0x55,0x33,0x50,
+    0x90,0x00,0x84,0x00,0x01,0x0f,0x75,0x87,0x55,0x04,0x77,0x35,0x55,0x32,0x2d,0x8d,
+    0x00,0x04,0x03,0x33,0x55,0x33,0x37,0x88,0x55,0x00,0x77,0x84,0x00,0x84,0x00,0x00,
+    0x21,0x88,0x22,0x04,0x33,0x35,0x55,0x33,0x21,0x8d,0x00,0x04,0xd2,0x33,0x55,0x53,
+    0x32,0x88,0x22,0x01,0x11,0xd0,0x83,0x00,0x83,0x00,0x02,0x07,0x22,0x22,0x88,0x33,
+    0x04,0x55,0x55,0x53,0x22,0x30,0x8b,0x00,0x04,0x07,0x23,0x35,0x55,0x55,0x88,0x33,
+    0x02,0x22,0x22,0x1c,0x83,0x00,0x83,0x00,0x01,0x01,0x23,0x87,0x33,0x81,0x55,0x02,
+    0x53,0x32,0x27,0x8b,0x00,0x01,0xc2,0x23,0x82,0x55,0x87,0x33,0x01,0x22,0x1a,0x83,
+    0x00,0x83,0x00,0x01,0x01,0x23,0x8c,0x55,0x02,0x33,0x22,0xa0,0x8a,0x00,0x01,0x22,
+    0x33,0x8b,0x55,0x02,0x53,0x32,0x17,0x83,0x00,0x83,0x00,0x02,0x01,0x23,0x35,0x8b,
+    0x55,0x02,0x53,0x32,0x27,0x89,0x00,0x02,0xa2,0x23,0x35,0x8b,0x55,0x02,0x53,0x32,
+    0x1d,0x83,0x00,0x83,0x00,0x01,0x02,0x22,0x8b,0x33,0x04,0x35,0x53,0x33,0x22,0x2c,
+    0x87,0x00,0x04,0x0f,0x22,0x33,0x55,0x53,0x8b,0x33,0x01,0x22,0x10,0x83,0x00,0x84,
+    0x00,0x00,0xd2,0x8a,0x22,0x00,0x23,0x80,0x33,0x02,0x32,0x21,0xa0,0x85,0x00,0x02,
+    0x0a,0x32,0x23,0x80,0x33,0x00,0x32,0x8a,0x22,0x01,0x21,0xc0,0x83,0x00,0x85,0x00,
+    0x01,0x7f,0xff,0x88,0x22,0x01,0xf2,0x2a,0x80,0x33,0x02,0x22,0x21,0xa0,0x83,0x00,
+    0x02,0x07,0x52,0x23,0x80,0x33,0x00,0x2f,0x89,0x22,0x02,0xf2,0xf2,0xa0,0x84,0x00,
+    0x94,0x00,0x00,0xd2,0x80,0x33,0x03,0x22,0x22,0x2a,0xa0,0x80,0x00,0x02,0x47,0x22,
+    0x22,0x80,0x33,0x01,0x21,0xa0,0x93,0x00,0x94,0x00,0x01,0x0f,0x23,0x80,0x33,0x85,
+    0x22,0x80,0x33,0x01,0x32,0x10,0x94,0x00,0x95,0x00,0x00,0xa1,0x81,0x33,0x00,0x32,
+    0x81,0x22,0x00,0x23,0x80,0x33,0x01,0x32,0x27,0x95,0x00,0x96,0x00,0x00,0xa2,0x88,
+    0x33,0x02,0x32,0x21,0x40,0x95,0x00,0x96,0x00,0x01,0x0c,0x32,0x86,0x33,0x02,0x32,
+    0x22,0xd0,0x96,0x00,0x97,0x00,0x02,0x0c,0x52,0x23,0x83,0x33,0x02,0x32,0x21,0xd0,
+    0x97,0x00,0x99,0x00,0x00,0x45,0x83,0x22,0x01,0x2a,0xa0,0x98,0x00,0x9b,0x00,0x04,
+    0xa2,0xd7,0xaa,0xf4,0xc0,0x9a,0x00,0xbd,0x00,0xbd,0x00,0xbd,0x00,0xbd,0x00,0xbd,
+    0x00,
+};
+
+static const struct ssd1322_image image_vaulttec64 =
+    { image_vaulttec64_data, 1297, 128, 64 };
+
+#endif
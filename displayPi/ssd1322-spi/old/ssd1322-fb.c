@@ -23,7 +23,8 @@
 /*
     Compile with:
 
-    gcc ssd1322-fb.c ssd1322-spi.c -Wall -o test-ssd1322 -lpigpio
+    gcc ssd1322-fb.c ssd1322-spi.c ../../../chipsPi/bcm2835/spi/bcm2835spi.c
+        ../../../boardPi/boardPi.c -Wall -o test-ssd1322 -lpigpio -lpthread
 
     Also use the following flags for Raspberry Pi optimisation:
         -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
@@ -67,9 +68,17 @@
 #include <pigpio.h>
 #include <pthread.h>
 #include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
 
 #include "ssd1322-spi.h"
-#include "graphics.h"
+#include "../../../chipsPi/bcm2835/spi/bcm2835spi.h"
+#include "image-fallout.h"
+#include "image-vaulttec32.h"
+#include "image-vaulttec64.h"
+#include "ssd1322-font.h"
+#include "font-default.h"
 
 // SSD1322 supports 480x128 but display is 256x64.
 #define COLS_VIS_MIN 0x00 // Visible cols - start.
@@ -77,11 +86,51 @@
 #define ROWS_VIS_MIN 0x00 // Visible rows - start.
 #define ROWS_VIS_MAX 0x3f // Visible rows - end.
 
-// Display buffer.
-uint8_t *ssd1322_fb[SSD1322_DISPLAYS_MAX];
+#define SSD1322_FB_FPS    60 // Default maximum frame rate.
+#define SSD1322_FB_RECTS   8 // Max dirty rectangles per frame.
+#define SSD1322_FB_WINDOW  8 // Bus cost of setting a window (bytes).
+#define SSD1322_FB_STRIDE  ( SSD1322_COLS / 2 ) // Bytes per row.
 
-// Mutex for locking updates to FB while buffer is being written to display.
+// Second display, on CE1, for ssd1322_fb_refresh.
+#define GPIO_DC_B         25 // Data/Command (DC#) pin.
+#define GPIO_RESET_B      22 // Hardware reset (RES#) pin.
+#define SPI_CHANNEL_B      1 // Channel.
+#define SPI_BUS_DIVIDER   50 // 250MHz core clock / 50 = SPI_BAUD.
+
+/*
+    Display buffers, laid out as display RAM with 2 pixels per byte. The left
+    pixel of each pair is the high nibble.
+
+    Drawing functions draw to the back buffer, ssd1322_fb, which only the
+    drawing thread uses. ssd1322_fb_publish swaps it with the ready buffer,
+    and the writer thread swaps the ready buffer with the front buffer when
+    it is ready to send a frame, so neither thread waits for the other to
+    finish with a buffer and frames never tear.
+*/
+uint8_t *ssd1322_fb[SSD1322_DISPLAYS_MAX];       // Back buffer (drawing).
+uint8_t *ssd1322_fb_ready[SSD1322_DISPLAYS_MAX]; // Published frame.
+uint8_t *ssd1322_fb_front[SSD1322_DISPLAYS_MAX]; // Frame being sent.
+
+// Regions changed, in RAM columns and rows.
+struct ssd1322_rect
+{
+    uint8_t col1, col2; // Start & end RAM columns (4 pixels each).
+    uint8_t row1, row2; // Start & end rows.
+};
+
+struct ssd1322_dirty
+{
+    struct ssd1322_rect rect[SSD1322_FB_RECTS];
+    uint8_t count;
+};
+
+// Changed since the last publish, and published but not yet sent.
+struct ssd1322_dirty ssd1322_fb_dirty[SSD1322_DISPLAYS_MAX];
+struct ssd1322_dirty ssd1322_fb_pending[SSD1322_DISPLAYS_MAX];
+
+// Protects the ready buffers and pending regions, and signals new frames.
 pthread_mutex_t ssd1322_display_busy;
+pthread_cond_t  ssd1322_fb_frame = PTHREAD_COND_INITIALIZER;
 
 uint8_t ssd1322_fb_kill = 0;
 
@@ -89,6 +138,15 @@ uint8_t ssd1322_fb_kill = 0;
 struct ssd1322_display_struct
 {
     uint8_t id;
+    uint8_t fps; // Maximum frame rate.
+};
+
+// As above, for displays sharing the SPI bus.
+struct ssd1322_group_struct
+{
+    uint8_t id[SSD1322_DISPLAYS_MAX]; // Displays.
+    uint8_t count;                    // Number of displays.
+    uint8_t fps;                      // Maximum frame rate.
 };
 
 // ----------------------------------------------------------------------------
@@ -98,14 +156,241 @@ struct ssd1322_display_struct
 // ----------------------------------------------------------------------------
 int8_t ssd1322_fb_init( uint8_t id )
 {
-    ssd1322_fb[id] = malloc ( sizeof( uint8_t) * SSD1322_COLS * SSD1322_ROWS );
-    if ( ssd1322_fb == NULL ) return -1;
-    else return 0;
+    ssd1322_fb[id]       = calloc( SSD1322_FRAME_BYTES, sizeof( uint8_t ));
+    ssd1322_fb_ready[id] = calloc( SSD1322_FRAME_BYTES, sizeof( uint8_t ));
+    ssd1322_fb_front[id] = calloc( SSD1322_FRAME_BYTES, sizeof( uint8_t ));
+    if (( ssd1322_fb[id] == NULL ) || ( ssd1322_fb_ready[id] == NULL ) ||
+        ( ssd1322_fb_front[id] == NULL )) return -1;
+
+    // Whole display is sent with the first frame.
+    ssd1322_fb_dirty[id].rect[0] = (struct ssd1322_rect)
+        { 0, SSD1322_COLS / 4 - 1, 0, SSD1322_ROWS - 1 };
+    ssd1322_fb_dirty[id].count   = 1;
+    ssd1322_fb_pending[id].count = 0;
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Returns the number of bytes sent to display a rectangle.
+*/
+// ----------------------------------------------------------------------------
+static uint16_t ssd1322_fb_rect_bytes( struct ssd1322_rect *rect )
+{
+    return ( rect->col2 - rect->col1 + 1 ) * 2 * ( rect->row2 - rect->row1 + 1 );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Returns the smallest rectangle containing a and b.
+*/
+// ----------------------------------------------------------------------------
+static struct ssd1322_rect ssd1322_fb_rect_union( struct ssd1322_rect *a,
+                                                  struct ssd1322_rect *b )
+{
+    struct ssd1322_rect rect;
+
+    rect.col1 = ( a->col1 < b->col1 ) ? a->col1 : b->col1;
+    rect.col2 = ( a->col2 > b->col2 ) ? a->col2 : b->col2;
+    rect.row1 = ( a->row1 < b->row1 ) ? a->row1 : b->row1;
+    rect.row2 = ( a->row2 > b->row2 ) ? a->row2 : b->row2;
+    return rect;
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Returns the extra bytes sent if a and b are sent as one window, which is
+    negative if merging them is cheaper.
+*/
+// ----------------------------------------------------------------------------
+static int32_t ssd1322_fb_rect_merge_cost( struct ssd1322_rect *a,
+                                           struct ssd1322_rect *b )
+{
+    struct ssd1322_rect rect = ssd1322_fb_rect_union( a, b );
+
+    return (int32_t) ssd1322_fb_rect_bytes( &rect ) - SSD1322_FB_WINDOW -
+           ssd1322_fb_rect_bytes( a ) - ssd1322_fb_rect_bytes( b );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Adds a rectangle to a list of changed regions.
+
+    Rectangles that overlap are always merged, so the rectangles never send
+    the same pixels twice, as are rectangles that are cheaper to send as one
+    window. If there are too many rectangles, the cheapest pair is merged.
+*/
+// ----------------------------------------------------------------------------
+static void ssd1322_fb_dirty_add( struct ssd1322_dirty *dirty,
+                                  struct ssd1322_rect rect )
+{
+    int32_t cost, best;
+    uint8_t i, j, a, b;
+    bool    merged;
+
+    dirty->rect[dirty->count++] = rect;
+    do
+    {
+        merged = false;
+        best = INT32_MAX;
+        a = b = 0;
+        for ( i = 0; i < dirty->count; i++ )
+            for ( j = i + 1; j < dirty->count; j++ )
+            {
+                cost = ssd1322_fb_rect_merge_cost( &dirty->rect[i],
+                                                   &dirty->rect[j] );
+                if (( dirty->rect[i].col1 <= dirty->rect[j].col2 ) &&
+                    ( dirty->rect[j].col1 <= dirty->rect[i].col2 ) &&
+                    ( dirty->rect[i].row1 <= dirty->rect[j].row2 ) &&
+                    ( dirty->rect[j].row1 <= dirty->rect[i].row2 ))
+                    cost = INT32_MIN; // Overlapping.
+                if ( cost < best )
+                {
+                    best = cost;
+                    a = i;
+                    b = j;
+                }
+            }
+
+        // Merge if cheaper or if there will be no room for the next one.
+        if (( best <= 0 ) || ( dirty->count == SSD1322_FB_RECTS ))
+        {
+            dirty->rect[a] = ssd1322_fb_rect_union( &dirty->rect[a],
+                                                    &dirty->rect[b] );
+            dirty->rect[b] = dirty->rect[--dirty->count];
+            merged = true;
+        }
+    }
+    while ( merged && ( dirty->count > 1 ));
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Records a changed area of the back buffer, in pixels.
+
+    Areas are widened to whole RAM columns.
+*/
+// ----------------------------------------------------------------------------
+static void ssd1322_fb_mark( uint8_t id, uint16_t x, uint8_t y,
+                             uint16_t dx, uint8_t dy )
+{
+    struct ssd1322_rect rect;
+
+    if (( dx == 0 ) || ( dy == 0 )) return;
+
+    rect.col1 = x / 4;
+    rect.col2 = ( x + dx - 1 ) / 4;
+    rect.row1 = y;
+    rect.row2 = y + dy - 1;
+    ssd1322_fb_dirty_add( &ssd1322_fb_dirty[id], rect );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Swaps the back and ready buffers. Must hold ssd1322_display_busy.
+
+    The new back buffer is brought up to date with a copy of the frame, which
+    takes far less time than sending it.
+*/
+// ----------------------------------------------------------------------------
+static void ssd1322_fb_swap( uint8_t id )
+{
+    uint8_t *buffer;
+    uint8_t i;
+
+    buffer = ssd1322_fb_ready[id];
+    ssd1322_fb_ready[id] = ssd1322_fb[id];
+    ssd1322_fb[id] = buffer;
+    for ( i = 0; i < ssd1322_fb_dirty[id].count; i++ )
+        ssd1322_fb_dirty_add( &ssd1322_fb_pending[id],
+                              ssd1322_fb_dirty[id].rect[i] );
+    memcpy( ssd1322_fb[id], ssd1322_fb_ready[id], SSD1322_FRAME_BYTES );
+    ssd1322_fb_dirty[id].count = 0;
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Publishes the back buffer as the next frame to send.
+
+    Swaps the back and ready buffers and wakes the writer thread. Frames
+    published faster than the writer sends them are combined.
+*/
+// ----------------------------------------------------------------------------
+void ssd1322_fb_publish( uint8_t id )
+{
+    if ( ssd1322_fb_dirty[id].count == 0 ) return;
+
+    pthread_mutex_lock( &ssd1322_display_busy );
+    ssd1322_fb_swap( id );
+    pthread_cond_broadcast( &ssd1322_fb_frame );
+    pthread_mutex_unlock( &ssd1322_display_busy );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Publishes the back buffers of several displays as one frame.
+
+    ssd1322_fb_refresh takes the frames of all its displays under the same
+    lock, so displays published together are always sent together, e.g. so
+    that left and right meters move at the same time.
+*/
+// ----------------------------------------------------------------------------
+void ssd1322_fb_publish_group( const uint8_t *id, uint8_t count )
+{
+    uint8_t d;
+
+    pthread_mutex_lock( &ssd1322_display_busy );
+    for ( d = 0; d < count; d++ )
+        if ( ssd1322_fb_dirty[ id[d] ].count > 0 ) ssd1322_fb_swap( id[d] );
+    pthread_cond_broadcast( &ssd1322_fb_frame );
+    pthread_mutex_unlock( &ssd1322_display_busy );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Stops framebuffer threads.
+*/
+// ----------------------------------------------------------------------------
+void ssd1322_fb_stop( void )
+{
+    pthread_mutex_lock( &ssd1322_display_busy );
+    ssd1322_fb_kill = 1;
+    pthread_cond_broadcast( &ssd1322_fb_frame );
+    pthread_mutex_unlock( &ssd1322_display_busy );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Sends changed regions of a display's front buffer.
+
+    The front buffer is in display RAM format so each rectangle is sent from
+    it directly as a window.
+*/
+// ----------------------------------------------------------------------------
+static void ssd1322_fb_send( uint8_t id, struct ssd1322_rect *rect,
+                             uint8_t count )
+{
+    uint8_t r;
+
+    for ( r = 0; r < count; r++ )
+    {
+        ssd1322_set_cols( id, rect[r].col1 * 4, rect[r].col2 * 4 );
+        ssd1322_set_rows( id, rect[r].row1, rect[r].row2 );
+        ssd1322_write_stream_rows( id,
+            &ssd1322_fb_front[id][ rect[r].row1 * SSD1322_FB_STRIDE +
+                                   rect[r].col1 * 2 ],
+            ( rect[r].col2 - rect[r].col1 + 1 ) * 2, SSD1322_FB_STRIDE,
+            rect[r].row2 - rect[r].row1 + 1 );
+    }
 }
 
 // ----------------------------------------------------------------------------
 /*
     Writes framebuffer to display via SPI interface.
+
+    Sleeps until a frame is published, then sends the regions that changed.
+    Frames are at least 1/fps apart, so an idle display costs nothing and a
+    busy one is limited to fps.
 */
 // ----------------------------------------------------------------------------
 void *ssd1322_fb_write( void *params )
@@ -113,27 +398,54 @@ void *ssd1322_fb_write( void *params )
     // Get parameters through void.
     struct ssd1322_display_struct *display = params;
 
-    uint16_t i;
-    uint8_t  data;
-    uint8_t id;
+    struct ssd1322_rect rect[SSD1322_FB_RECTS];
+    struct timespec next;
+    uint8_t *buffer;
+    uint8_t id, count;
+    long    period;
 
-    id = display->id;
-    ssd1322_set_cols( id, 0, 255);
-    ssd1322_set_rows( id, 0, 63 );
-    ssd1322_set_write_continuous( id );
+    id     = display->id;
+    period = 1000000000L / (( display->fps > 0 ) ? display->fps : SSD1322_FB_FPS );
+    clock_gettime( CLOCK_MONOTONIC, &next );
 
+    pthread_mutex_lock( &ssd1322_display_busy );
     while ( !ssd1322_fb_kill )
     {
-        pthread_mutex_lock( &ssd1322_display_busy );
-        for ( i = 0; i < SSD1322_COLS * SSD1322_ROWS / 2; i++ )
+        if ( ssd1322_fb_pending[id].count == 0 )
         {
-            data = ssd1322_fb[id][i*2] << 4 | ssd1322_fb[id][i*2+1];
-            ssd1322_write_data( id, data );
-//            gpioDelay( 1000 );
+            pthread_cond_wait( &ssd1322_fb_frame, &ssd1322_display_busy );
+            continue;
         }
+
+        // Not before the next frame is due. Frames published meanwhile are
+        // combined with this one.
         pthread_mutex_unlock( &ssd1322_display_busy );
-//        gpioDelay( 10000 );
+        clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL );
+        pthread_mutex_lock( &ssd1322_display_busy );
+
+        buffer = ssd1322_fb_front[id];
+        ssd1322_fb_front[id] = ssd1322_fb_ready[id];
+        ssd1322_fb_ready[id] = buffer;
+        count = ssd1322_fb_pending[id].count;
+        memcpy( rect, ssd1322_fb_pending[id].rect,
+                count * sizeof( struct ssd1322_rect ));
+        ssd1322_fb_pending[id].count = 0;
+        pthread_mutex_unlock( &ssd1322_display_busy );
+
+        ssd1322_fb_send( id, rect, count );
+
+        // Earliest time for the next frame.
+        clock_gettime( CLOCK_MONOTONIC, &next );
+        next.tv_nsec += period;
+        if ( next.tv_nsec >= 1000000000L )
+        {
+            next.tv_sec++;
+            next.tv_nsec -= 1000000000L;
+        }
+
+        pthread_mutex_lock( &ssd1322_display_busy );
     }
+    pthread_mutex_unlock( &ssd1322_display_busy );
 
     printf( "Thread kill!\n" );
 //    gpioDelay( 1000000 );
@@ -141,6 +453,124 @@ void *ssd1322_fb_write( void *params )
 
 }
 
+// ----------------------------------------------------------------------------
+/*
+    Writes the framebuffers of displays sharing the SPI bus.
+
+    Use instead of one ssd1322_fb_write thread per display, which would
+    write to the bus at the same time. The frames of all the displays are
+    taken together and the changed regions of each are then sent in turn
+    straight from its front buffer. The bus carries one display at a time,
+    so a frame takes as long as the regions of all the displays together.
+    Frames are at least 1/fps apart, as for ssd1322_fb_write.
+*/
+// ----------------------------------------------------------------------------
+void *ssd1322_fb_refresh( void *params )
+{
+    // Get parameters through void.
+    struct ssd1322_group_struct *group = params;
+
+    struct ssd1322_rect rect[SSD1322_DISPLAYS_MAX][SSD1322_FB_RECTS];
+    uint8_t count[SSD1322_DISPLAYS_MAX];
+    struct timespec next;
+    uint8_t *buffer;
+    uint8_t id, d;
+    bool    pending;
+    long    period;
+
+    period = 1000000000L / (( group->fps > 0 ) ? group->fps : SSD1322_FB_FPS );
+    clock_gettime( CLOCK_MONOTONIC, &next );
+
+    pthread_mutex_lock( &ssd1322_display_busy );
+    while ( !ssd1322_fb_kill )
+    {
+        pending = false;
+        for ( d = 0; d < group->count; d++ )
+            if ( ssd1322_fb_pending[ group->id[d] ].count > 0 ) pending = true;
+        if ( !pending )
+        {
+            pthread_cond_wait( &ssd1322_fb_frame, &ssd1322_display_busy );
+            continue;
+        }
+
+        // Not before the next frame is due. Frames published meanwhile are
+        // combined with this one.
+        pthread_mutex_unlock( &ssd1322_display_busy );
+        clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL );
+        pthread_mutex_lock( &ssd1322_display_busy );
+
+        // All displays at once, so a group publish is never split.
+        for ( d = 0; d < group->count; d++ )
+        {
+            id = group->id[d];
+            buffer = ssd1322_fb_front[id];
+            ssd1322_fb_front[id] = ssd1322_fb_ready[id];
+            ssd1322_fb_ready[id] = buffer;
+            count[d] = ssd1322_fb_pending[id].count;
+            memcpy( rect[d], ssd1322_fb_pending[id].rect,
+                    count[d] * sizeof( struct ssd1322_rect ));
+            ssd1322_fb_pending[id].count = 0;
+        }
+        pthread_mutex_unlock( &ssd1322_display_busy );
+
+        for ( d = 0; d < group->count; d++ )
+            ssd1322_fb_send( group->id[d], rect[d], count[d] );
+
+        // Earliest time for the next frame.
+        clock_gettime( CLOCK_MONOTONIC, &next );
+        next.tv_nsec += period;
+        if ( next.tv_nsec >= 1000000000L )
+        {
+            next.tv_sec++;
+            next.tv_nsec -= 1000000000L;
+        }
+
+        pthread_mutex_lock( &ssd1322_display_busy );
+    }
+    pthread_mutex_unlock( &ssd1322_display_busy );
+
+    pthread_exit( NULL );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Sets a pixel in the framebuffer without marking it.
+*/
+// ----------------------------------------------------------------------------
+static inline void ssd1322_fb_put( uint8_t id, uint16_t x, uint8_t y,
+                                   uint8_t grey )
+{
+    uint8_t *byte = &ssd1322_fb[id][ y * SSD1322_FB_STRIDE + x / 2 ];
+
+    if ( x & 1 ) *byte = ( *byte & 0xf0 ) | ( grey & 0x0f );
+    else         *byte = ( *byte & 0x0f ) | ( grey << 4 );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Sets a run of pixels in a row without marking them.
+
+    Whole bytes in the middle of the run are set with memset, which writes
+    a word or more at a time, so only the ends need nibble masking.
+*/
+// ----------------------------------------------------------------------------
+static void ssd1322_fb_put_run( uint8_t id, uint16_t x, uint8_t y,
+                                uint16_t len, uint8_t grey )
+{
+    uint8_t *byte = &ssd1322_fb[id][ y * SSD1322_FB_STRIDE + x / 2 ];
+
+    grey &= 0x0f;
+    if (( x & 1 ) && ( len > 0 ))
+    {
+        *byte = ( *byte & 0xf0 ) | grey;
+        byte++;
+        len--;
+    }
+    memset( byte, grey * 0x11, len / 2 );
+    if ( len & 1 )
+        byte[ len / 2 ] = ( byte[ len / 2 ] & 0x0f ) | ( grey << 4 );
+}
+
 // ----------------------------------------------------------------------------
 /*
     Fill the framebuffer.
@@ -148,11 +578,8 @@ void *ssd1322_fb_write( void *params )
 // ----------------------------------------------------------------------------
 void ssd1322_fb_fill_display( uint8_t id, uint8_t grey )
 {
-    uint16_t i;
-//    pthread_mutex_lock( &ssd1322_display_busy );
-    for ( i = 0; i < SSD1322_COLS * SSD1322_ROWS; i++ )
-        ssd1322_fb[ id ][ i ] = grey;
-//    pthread_mutex_unlock( &ssd1322_display_busy );
+    memset( ssd1322_fb[id], ( grey & 0x0f ) * 0x11, SSD1322_FRAME_BYTES );
+    ssd1322_fb_mark( id, 0, 0, SSD1322_COLS, SSD1322_ROWS );
 }
 
 // ----------------------------------------------------------------------------
@@ -162,125 +589,490 @@ void ssd1322_fb_fill_display( uint8_t id, uint8_t grey )
 // ----------------------------------------------------------------------------
 void ssd1322_fb_draw_pixel( uint8_t id, uint8_t x, uint8_t y, uint8_t grey )
 {
-    printf( "\tx = %u, y = %u, i = %u.\n", x, y, y * SSD1322_COLS + x );
-//    pthread_mutex_lock( &ssd1322_display_busy );
-    ssd1322_fb[id][ y * SSD1322_COLS + x ] = grey;
-//    pthread_mutex_unlock( &ssd1322_display_busy );
+    ssd1322_fb_put( id, x, y, grey );
+    ssd1322_fb_mark( id, x, y, 1, 1 );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Draw a horizontal line in the framebuffer.
+*/
+// ----------------------------------------------------------------------------
+int8_t ssd1322_fb_draw_hline( uint8_t id, uint16_t x, uint8_t y,
+                              uint16_t len, uint8_t grey )
+{
+    if (( x + len > SSD1322_COLS ) || ( y >= SSD1322_ROWS )) return -1;
+
+    ssd1322_fb_put_run( id, x, y, len, grey );
+    ssd1322_fb_mark( id, x, y, len, 1 );
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Draw a vertical line in the framebuffer.
+*/
+// ----------------------------------------------------------------------------
+int8_t ssd1322_fb_draw_vline( uint8_t id, uint16_t x, uint8_t y,
+                              uint8_t len, uint8_t grey )
+{
+    uint8_t j;
+
+    if (( x >= SSD1322_COLS ) || ( y + len > SSD1322_ROWS )) return -1;
+
+    for ( j = y; j < y + len; j++ )
+        ssd1322_fb_put( id, x, j, grey );
+    ssd1322_fb_mark( id, x, y, 1, len );
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Draw a filled rectangle in the framebuffer.
+*/
+// ----------------------------------------------------------------------------
+int8_t ssd1322_fb_draw_rect( uint8_t id, uint16_t x, uint8_t y,
+                             uint16_t dx, uint8_t dy, uint8_t grey )
+{
+    uint8_t j;
+
+    if (( x + dx > SSD1322_COLS ) || ( y + dy > SSD1322_ROWS )) return -1;
+
+    for ( j = y; j < y + dy; j++ )
+        ssd1322_fb_put_run( id, x, j, dx, grey );
+    ssd1322_fb_mark( id, x, y, dx, dy );
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Packs 8 pixels, one per byte, into 4 bytes of 2 pixels.
+
+    The pixels are packed together in a 64-bit word: each pixel is shifted
+    into the high nibble of its byte and combined with the next, then the
+    resulting bytes are squeezed together in two steps.
+*/
+// ----------------------------------------------------------------------------
+static inline void ssd1322_fb_pack8( uint8_t *dst, const uint8_t *src )
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t p;
+    uint32_t packed;
+
+    memcpy( &p, src, sizeof( p ));
+    p &= 0x0f0f0f0f0f0f0f0fULL;
+    p  = (( p << 4 ) | ( p >> 8 )) & 0x00ff00ff00ff00ffULL;
+    p  = ( p | ( p >> 8 ))  & 0x0000ffff0000ffffULL;
+    p  = ( p | ( p >> 16 )) & 0x00000000ffffffffULL;
+    packed = p;
+    memcpy( dst, &packed, sizeof( packed ));
+#else
+    uint8_t i;
+
+    for ( i = 0; i < 4; i++ )
+        dst[i] = src[ i * 2 ] << 4 | ( src[ i * 2 + 1 ] & 0x0f );
+#endif
 }
 
 // ----------------------------------------------------------------------------
 /*
     Draw a graphic in the framebuffer.
+
+    Images are one pixel per byte. At an odd x, the first pixel of each row
+    is merged into the low nibble of a byte so the rest are byte aligned.
 */
 // ----------------------------------------------------------------------------
 int8_t ssd1322_fb_draw_image( uint8_t id, uint8_t x, uint8_t y,
                               uint16_t dx, uint8_t dy, uint8_t image[] )
 {
-    uint16_t i, j, k;
+    const uint8_t *src;
+    uint8_t  *dst;
+    uint16_t i, j;
 
     if ( x + dx > SSD1322_COLS ) return -1;
     if ( y + dy > SSD1322_ROWS ) return -1;
 
-    printf( "Drawing %ux%u graphic at %u,%u.\n", dx, dy, x, y );
+    for ( j = 0; j < dy; j++ )
+    {
+        src = &image[ j * dx ];
+        dst = &ssd1322_fb[id][ ( y + j ) * SSD1322_FB_STRIDE + x / 2 ];
+        i = 0;
+        if ( x & 1 )
+        {
+            *dst = ( *dst & 0xf0 ) | ( src[0] & 0x0f );
+            dst++;
+            i++;
+        }
+        for ( ; i + 8 <= dx; i += 8, dst += 4 )
+            ssd1322_fb_pack8( dst, &src[i] );
+        for ( ; i + 2 <= dx; i += 2, dst++ )
+            *dst = src[i] << 4 | ( src[ i + 1 ] & 0x0f );
+        if ( i < dx )
+            *dst = ( *dst & 0x0f ) | ( src[i] << 4 );
+    }
+    ssd1322_fb_mark( id, x, y, dx, dy );
 
-    k = 0;
-//    pthread_mutex_lock( &ssd1322_display_busy );
-    for ( j = y; j < y + dy; j++ )
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Draw a run length encoded image in the framebuffer.
+
+    Encoded rows are already in framebuffer format and are decoded one at a
+    time. At an even x with an even width they decode straight into the
+    framebuffer, otherwise each row is decoded into a row buffer and merged.
+*/
+// ----------------------------------------------------------------------------
+int8_t ssd1322_fb_draw_rle( uint8_t id, uint16_t x, uint8_t y,
+                            const struct ssd1322_image *image )
+{
+    const uint8_t *src = image->data;
+    uint16_t stride = ( image->width + 1 ) / 2;
+    uint16_t dx = image->width;
+    uint8_t  row[ SSD1322_FB_STRIDE ];
+    uint8_t *dst;
+    uint16_t i, j;
+
+    if ( x + dx > SSD1322_COLS ) return -1;
+    if ( y + image->height > SSD1322_ROWS ) return -1;
+
+    for ( j = 0; j < image->height; j++ )
     {
-        for ( i = x; i < x + dx; i++ )
+        dst = &ssd1322_fb[id][ ( y + j ) * SSD1322_FB_STRIDE + x / 2 ];
+        if ((( x | dx ) & 1 ) == 0 )
+        {
+            src = ssd1322_rle_row( src, dst, stride );
+            continue;
+        }
+
+        src = ssd1322_rle_row( src, row, stride );
+        if ( x & 1 )
+        {
+            // Shifted by a pixel, so each byte takes a nibble from two.
+            *dst = ( *dst & 0xf0 ) | ( row[0] >> 4 );
+            for ( i = 1; i * 2 < dx; i++ )
+                dst[i] = row[ i - 1 ] << 4 | row[i] >> 4;
+            if (( dx & 1 ) == 0 )
+                dst[i] = ( dst[i] & 0x0f ) | ( row[ i - 1 ] << 4 );
+        }
+        else
         {
-            ssd1322_fb[id][ j * SSD1322_COLS + i ] = image[k];
-            k++;
+            // Odd width, so the last pixel only has the high nibble.
+            memcpy( dst, row, dx / 2 );
+            dst[ dx / 2 ] = ( dst[ dx / 2 ] & 0x0f ) | ( row[ dx / 2 ] & 0xf0 );
         }
-//    printf( "\n" );
     }
-//    pthread_mutex_unlock( &ssd1322_display_busy );
+    ssd1322_fb_mark( id, x, y, dx, image->height );
 
-    printf( "i = %u, j = %u, k = %u.\n", i, j, k );
     return 0;
 }
 
 // ----------------------------------------------------------------------------
 /*
-    Main
+    Returns a table that scales both nibbles of a strip byte to a grey.
+
+    Strips are pre-rendered at full brightness, so drawing in another grey
+    is a single lookup per byte. The table is only rebuilt when the grey
+    changes.
 */
 // ----------------------------------------------------------------------------
-int main()
+static const uint8_t *ssd1322_fb_text_scale( uint8_t grey )
 {
-    uint8_t id;
-    int8_t err;
-    uint8_t i, j;
+    static uint8_t scale[256];
+    static int16_t scale_grey = -1;
+    uint16_t i;
 
-    err = ssd1322_init( GPIO_DC, GPIO_RESET, SPI_CHANNEL, SPI_BAUD, SPI_FLAGS );
+    grey &= 0x0f;
+    if ( grey != scale_grey )
+    {
+        for ( i = 0; i < 256; i++ )
+            scale[i] = (( i >> 4 ) * grey / 15 ) << 4 |
+                       (( i & 0x0f ) * grey / 15 );
+        scale_grey = grey;
+    }
+    return scale;
+}
 
-    if ( err < 0 )
+// ----------------------------------------------------------------------------
+/*
+    Copies a 4bpp strip into the framebuffer, clipped to the display.
+
+    Zero pixels are transparent. At an odd x the strip is shifted by a
+    nibble on the fly, so both cases copy whole framebuffer bytes. The
+    display width is even, so clipping is to whole bytes as well.
+*/
+// ----------------------------------------------------------------------------
+static void ssd1322_fb_put_strip( uint8_t id, int16_t x, int16_t y,
+                                  const uint8_t *strip, uint8_t width,
+                                  uint8_t height, const uint8_t *scale )
+{
+    uint8_t  stride = ( width + 1 ) / 2;
+    uint8_t  phase  = x & 1;
+    int16_t  bx     = ( x - phase ) / 2;
+    int16_t  k0, k1, k, j, j1;
+    uint8_t *dst;
+    const uint8_t *src;
+    uint8_t  byte, mask;
+
+    // Clip to display bytes and rows.
+    k0 = ( bx < 0 ) ? -bx : 0;
+    k1 = stride + phase;
+    if ( bx + k1 > SSD1322_FB_STRIDE ) k1 = SSD1322_FB_STRIDE - bx;
+    j  = ( y < 0 ) ? -y : 0;
+    j1 = ( y + height > SSD1322_ROWS ) ? SSD1322_ROWS - y : height;
+
+    for ( ; j < j1; j++ )
     {
-        printf( "Init failed!\n" );
-        return -1;
+        src = &strip[ j * stride ];
+        dst = &ssd1322_fb[id][ ( y + j ) * SSD1322_FB_STRIDE + bx ];
+        for ( k = k0; k < k1; k++ )
+        {
+            if ( phase )
+                byte = (( k > 0 ) ? src[ k - 1 ] << 4 : 0 ) |
+                       (( k < stride ) ? src[k] >> 4 : 0 );
+            else
+                byte = src[k];
+            if ( byte == 0 ) continue;
+
+            mask = (( byte & 0xf0 ) ? 0xf0 : 0 ) | (( byte & 0x0f ) ? 0x0f : 0 );
+            dst[k] = ( dst[k] & ~mask ) | scale[byte];
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Returns the kerning adjustment between two characters.
+*/
+// ----------------------------------------------------------------------------
+static int8_t ssd1322_fb_kern( const struct ssd1322_font *font,
+                               const struct ssd1322_glyph *glyph,
+                               uint8_t right )
+{
+    const struct ssd1322_kern *kern = &font->kern[ glyph->kern ];
+    uint8_t i;
+
+    for ( i = 0; i < glyph->kerns; i++ )
+        if ( kern[i].right == right ) return kern[i].adjust;
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Returns the width in pixels of a string, including kerning.
+*/
+// ----------------------------------------------------------------------------
+uint16_t ssd1322_fb_text_width( const struct ssd1322_font *font,
+                                const char *text )
+{
+    const struct ssd1322_glyph *glyph;
+    uint16_t width = 0;
+    uint8_t  c;
+
+    for ( ; *text; text++ )
+    {
+        c = *text;
+        if (( c < font->first ) || ( c > font->last )) continue;
+        glyph = &font->glyph[ c - font->first ];
+        width += glyph->xadvance + ssd1322_fb_kern( font, glyph, text[1] );
+    }
+    return width;
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Draws a string in the framebuffer with its baseline at y.
+
+    Glyph strips are copied straight into the packed framebuffer and are
+    clipped to the display, so text may start off screen, e.g. to scroll.
+    Characters outside the font are skipped. Returns the pen position after
+    the last character.
+*/
+// ----------------------------------------------------------------------------
+int16_t ssd1322_fb_draw_text( uint8_t id, int16_t x, int16_t y,
+                              const struct ssd1322_font *font,
+                              const char *text, uint8_t grey )
+{
+    const struct ssd1322_glyph *glyph;
+    const uint8_t *scale = ssd1322_fb_text_scale( grey );
+    int16_t x1 = SSD1322_COLS, x2 = 0; // Extent drawn, for marking.
+    int16_t gx;
+    uint8_t c;
+
+    for ( ; *text; text++ )
+    {
+        c = *text;
+        if (( c < font->first ) || ( c > font->last )) continue;
+        glyph = &font->glyph[ c - font->first ];
+
+        gx = x + glyph->xoffset;
+        if (( glyph->width > 0 ) && ( gx < SSD1322_COLS ) &&
+            ( gx + glyph->width > 0 ))
+        {
+            ssd1322_fb_put_strip( id, gx, y + glyph->yoffset,
+                                  &font->bitmap[ glyph->offset ],
+                                  glyph->width, glyph->height, scale );
+            if ( gx < x1 ) x1 = gx;
+            if ( gx + glyph->width > x2 ) x2 = gx + glyph->width;
+        }
+        x += glyph->xadvance + ssd1322_fb_kern( font, glyph, text[1] );
     }
-    else
+
+    // Mark the line, clipped to the display.
+    y -= font->ascent;
+    if ( x1 < 0 ) x1 = 0;
+    if ( x2 > SSD1322_COLS ) x2 = SSD1322_COLS;
+    if (( x1 < x2 ) && ( y < SSD1322_ROWS ) && ( y + font->height > 0 ))
     {
-        id = err;
-        printf( "Init successful.\n" );
-        printf( "\tID   :%d\n", id );
-        printf( "\tSPI  :%d\n", ssd1322[id]->spi_handle );
-        printf( "\tDC   :%d\n", ssd1322[id]->gpio_dc );
-        printf( "\tRESET:%d\n", ssd1322[id]->gpio_reset );
+        int16_t y1 = ( y < 0 ) ? 0 : y;
+        int16_t y2 = ( y + font->height > SSD1322_ROWS ) ?
+                     SSD1322_ROWS : y + font->height;
+        ssd1322_fb_mark( id, x1, y1, x2 - x1, y2 - y1 );
     }
 
-    ssd1322_clear_display( id );
+    return x;
+}
 
-    struct ssd1322_display_struct ssd1322_display =
+// ----------------------------------------------------------------------------
+/*
+    Main
+
+    Run with 2 for a second display on CE1, with DC# on GPIO_DC_B and RES#
+    on GPIO_RESET_B. The same frames are drawn on both. Add bus to send
+    through the bcm2835spi bus scheduler instead of pigpio, e.g. to share
+    SPI0 with an MCP42x1 volume control. This needs root.
+*/
+// ----------------------------------------------------------------------------
+int main( int argc, char *argv[] )
+{
+    struct ssd1322_group_struct ssd1322_group =
     {
-        .id = id
+        .count = 0,
+        .fps   = SSD1322_FB_FPS
     };
+    uint8_t dc[SSD1322_DISPLAYS_MAX]      = { GPIO_DC, GPIO_DC_B };
+    uint8_t reset[SSD1322_DISPLAYS_MAX]   = { GPIO_RESET, GPIO_RESET_B };
+    uint8_t channel[SSD1322_DISPLAYS_MAX] = { SPI_CHANNEL, SPI_CHANNEL_B };
+    static struct bcm2835_spi_bus bus;
+    static struct bcm2835_spi_device device[SSD1322_DISPLAYS_MAX];
+    uint8_t displays = 1;
+    bool    shared = false;
+    uint8_t id, d;
+    int8_t err;
+    uint8_t i, j;
+
+    for ( i = 1; i < argc; i++ )
+    {
+        if ( atoi( argv[i] ) == 2 ) displays = 2;
+        if ( strcmp( argv[i], "bus" ) == 0 ) shared = true;
+    }
 
-    err = ssd1322_fb_init( id );
-    if ( err < 0 )
+    if ( shared && (( bcm2835_spi_open() < 0 ) ||
+                    ( bcm2835_spi_bus_init( &bus ) < 0 )))
     {
-        printf( "Couldn't allocate memory for framebuffer!\n" );
+        printf( "Couldn't start SPI bus scheduler!\n" );
         return -1;
     }
-    else
+
+    for ( d = 0; d < displays; d++ )
     {
-        printf( "Memory successfully allocated for framebuffer.\n" );
+        if ( shared )
+        {
+            device[d].cs       = channel[d];
+            device[d].divider  = SPI_BUS_DIVIDER;
+            device[d].mode     = BCM2835_SPI_CS_MODE3;
+            device[d].polarity = 0;
+            err = ssd1322_init_bus( dc[d], reset[d], &bus, &device[d] );
+        }
+        else
+            err = ssd1322_init( dc[d], reset[d], channel[d], SPI_BAUD,
+                                SPI_FLAGS );
+
+        if ( err < 0 )
+        {
+            printf( "Init failed!\n" );
+            return -1;
+        }
+        else
+        {
+            id = err;
+            printf( "Init successful.\n" );
+            printf( "\tID   :%d\n", id );
+            printf( "\tSPI  :%d\n", ssd1322[id]->spi_handle );
+            printf( "\tDC   :%d\n", ssd1322[id]->gpio_dc );
+            printf( "\tRESET:%d\n", ssd1322[id]->gpio_reset );
+        }
+
+        ssd1322_clear_display( id );
+
+        err = ssd1322_fb_init( id );
+        if ( err < 0 )
+        {
+            printf( "Couldn't allocate memory for framebuffer!\n" );
+            return -1;
+        }
+        else
+        {
+            printf( "Memory successfully allocated for framebuffer.\n" );
+        }
+        ssd1322_group.id[ ssd1322_group.count++ ] = id;
     }
 
-    // Create thread for writing framebuffer to display.
+    // Create thread for writing framebuffers to displays.
     pthread_mutex_init( &ssd1322_display_busy, NULL );
     pthread_t threads[1];
-    pthread_create( &threads[0], NULL, ssd1322_fb_write, (void *) &ssd1322_display );
+    pthread_create( &threads[0], NULL, ssd1322_fb_refresh,
+                    (void *) &ssd1322_group );
 
     printf( "Drawing pixels - individuals.\n" );
-    ssd1322_fb_draw_pixel( id, 0, 0, 0x4 );
-    ssd1322_fb_draw_pixel( id, 255, 0, 0x4 );
-    ssd1322_fb_draw_pixel( id, 0, 63, 0x4 );
-    ssd1322_fb_draw_pixel( id, 255, 63, 0x4 );
+    for ( d = 0; d < displays; d++ )
+    {
+        id = ssd1322_group.id[d];
+        ssd1322_fb_draw_pixel( id, 0, 0, 0x4 );
+        ssd1322_fb_draw_pixel( id, 255, 0, 0x4 );
+        ssd1322_fb_draw_pixel( id, 0, 63, 0x4 );
+        ssd1322_fb_draw_pixel( id, 255, 63, 0x4 );
+    }
+    ssd1322_fb_publish_group( ssd1322_group.id, displays );
+
+    printf( "Drawing text.\n" );
+    for ( d = 0; d < displays; d++ )
+        ssd1322_fb_draw_text( ssd1322_group.id[d], 2, font_default.ascent + 2,
+                              &font_default, "Artist - Track (Album)", 0x0f );
+    ssd1322_fb_publish_group( ssd1322_group.id, displays );
+    gpioDelay( 2000000 );
 
     printf( "Drawing graphic - fallout animation loop.\n" );
     for ( i = 0; i < 5; i++ )
     {
         for ( j = 0; j < 7; j++ )
         {
-            ssd1322_fb_draw_image( id, 20, 0, 64, 64, graphics_falloutOK[j] );
+            for ( d = 0; d < displays; d++ )
+                ssd1322_fb_draw_rle( ssd1322_group.id[d], 20, 0,
+                                     &image_fallout[j] );
+            ssd1322_fb_publish_group( ssd1322_group.id, displays );
             gpioDelay( 200000 );
         }
     }
 
     printf( "Drawing graphic - Vault-Tec symbols.\n" );
-    ssd1322_fb_draw_image( id, 0, 0, 128, 64, graphics_vaultteclogo64 );
-    ssd1322_fb_draw_image( id, 192, 16, 64, 32, graphics_vaultteclogo32 );
+    for ( d = 0; d < displays; d++ )
+    {
+        ssd1322_fb_draw_rle( ssd1322_group.id[d], 0, 0, &image_vaulttec64 );
+        ssd1322_fb_draw_rle( ssd1322_group.id[d], 192, 16, &image_vaulttec32 );
+    }
+    ssd1322_fb_publish_group( ssd1322_group.id, displays );
     gpioDelay( 200000 );
 
 //    printf( "Drawing graphic - beach.\n" );
 //    ssd1322_fb_fill_display( id, 0 );
 //    gpioDelay( 100000 );
-//    ssd1322_fb_draw_image( id, 0, 0, 256, 64, graphics_beach );
+//    ssd1322_fb_draw_rle( id, 0, 0, &image_beach );
 //    gpioDelay( 100000 );
 
     // Tell framebuffer thread to stop.
-    ssd1322_fb_kill = 1;
-    gpioDelay( 5000000 );
+    ssd1322_fb_stop();
 
     // Gracefully stop framebuffer thread.
     pthread_join( threads[0], NULL );
@@ -289,6 +1081,12 @@ int main()
     pthread_mutex_destroy( &ssd1322_display_busy );
 //    pthread_exit( NULL );
 
+    if ( shared )
+    {
+        bcm2835_spi_bus_close( &bus );
+        bcm2835_spi_close();
+    }
+
     gpioTerminate();
 
     return 0;
@@ -0,0 +1,71 @@
+// ============================================================================
+/*
+    ssd1322-font:
+
+    Font definitions for the SSD1322 framebuffer text renderer.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+//  ===========================================================================
+
+#ifndef SSD1322FONT_H
+#define SSD1322FONT_H
+
+#include <stdint.h>
+
+/*
+    Fonts are generated by tools/fontconvert as headers of static const
+    tables so they live in read only memory and need no loading.
+
+    Each glyph is a strip of its bounding box only, pre-rendered at 4 bits
+    per pixel in the same layout as the framebuffer: 2 pixels per byte with
+    the left pixel in the high nibble and each row padded to a whole byte.
+    A grey of 0 is transparent.
+
+    Offsets are relative to the pen position on the baseline, so a glyph is
+    drawn at ( pen + xoffset, baseline + yoffset ) and the pen then moves on
+    by xadvance plus any kerning adjustment for the following character.
+*/
+struct ssd1322_glyph
+{
+    uint16_t offset;    // Offset into bitmap.
+    uint8_t  width;     // Bounding box width (pixels).
+    uint8_t  height;    // Bounding box height (pixels).
+    uint8_t  xadvance;  // Pixels to next glyph.
+    int8_t   xoffset;   // Left of box relative to pen.
+    int8_t   yoffset;   // Top of box relative to baseline.
+    uint16_t kern;      // First kerning pair with this glyph on the left.
+    uint8_t  kerns;     // Number of kerning pairs.
+};
+
+struct ssd1322_kern
+{
+    uint8_t right;      // Following character.
+    int8_t  adjust;     // Change to xadvance.
+};
+
+struct ssd1322_font
+{
+    const uint8_t              *bitmap; // Glyph strips.
+    const struct ssd1322_glyph *glyph;  // Glyph metrics.
+    const struct ssd1322_kern  *kern;   // Kerning pairs, grouped by left.
+    uint8_t first;                      // First character.
+    uint8_t last;                       // Last character.
+    uint8_t height;                     // Line advance (pixels).
+    uint8_t ascent;                     // Baseline below top of line.
+};
+
+#endif
@@ -0,0 +1,57 @@
+// ============================================================================
+/*
+    ssd1322-image:
+
+    Compressed image assets for the SSD1322 display.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+//  ===========================================================================
+
+#ifndef SSD1322IMAGE_H
+#define SSD1322IMAGE_H
+
+#include <stdint.h>
+
+/*
+    Images are generated by tools/imageconvert as headers of static const
+    tables.
+
+    Pixels are packed at 4 bits per pixel as in display RAM, 2 pixels per
+    byte with the left pixel in the high nibble, and each row is padded to
+    a whole byte. Each row is then run length encoded on its own, so rows
+    can be decoded one at a time into the framebuffer or the SPI stream
+    without an uncompressed copy of the image:
+
+        0x00-0x7f n     Literal, the next n + 1 bytes are copied.
+        0x80-0xff n b   Run, byte b is repeated ( n & 0x7f ) + 3 times.
+
+    Runs and literals never cross the end of a row.
+*/
+#define SSD1322_RLE_RUN      0x80 // Run flag.
+#define SSD1322_RLE_RUN_MIN     3 // Shortest run encoded.
+#define SSD1322_RLE_RUN_MAX   130 // Longest run encoded.
+#define SSD1322_RLE_LIT_MAX   128 // Longest literal encoded.
+
+struct ssd1322_image
+{
+    const uint8_t *data;    // Encoded rows.
+    uint16_t       size;    // Encoded size (bytes).
+    uint16_t       width;   // Width (pixels).
+    uint8_t        height;  // Height (pixels).
+};
+
+#endif
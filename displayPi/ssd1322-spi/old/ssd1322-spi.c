@@ -25,13 +25,84 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include <sys/mman.h>
 #include <pigpio.h>
 
 #include "ssd1322-spi.h"
+#include "../../../chipsPi/bcm2835/spi/bcm2835spi.h"
+#include "../../../statsPi/statsPi.h"
+
+// A bus scheduler transaction with the DC# level it needs.
+struct ssd1322_xfer_t
+{
+    struct bcm2835_spi_xfer xfer;
+    uint8_t gpio_dc;  // GPIO for DC#.
+    uint8_t level;    // SSD1322_INPUT_COMMAND or SSD1322_INPUT_DATA.
+};
 
 // Hardware functions. --------------------------------------------------------
 
+// ----------------------------------------------------------------------------
+/*
+    Sets DC# before each chunk the scheduler sends, as another device may
+    have had the bus in between.
+*/
+// ----------------------------------------------------------------------------
+static void ssd1322_bus_prepare( struct bcm2835_spi_xfer *xfer )
+{
+    struct ssd1322_xfer_t *x = xfer->arg;
+
+    gpioWrite( x->gpio_dc, x->level );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Sends bytes with DC# at level, through the bus scheduler if the display
+    has one, otherwise through pigpio in transfers of up to SPI_CHUNK bytes.
+*/
+// ----------------------------------------------------------------------------
+static void ssd1322_spi_write( uint8_t id, uint8_t level, const uint8_t *buf,
+                               unsigned count )
+{
+    struct ssd1322_t *display = ssd1322[id];
+    unsigned chunk;
+
+    if ( display->bus != NULL )
+    {
+        struct ssd1322_xfer_t x =
+        {
+            .xfer =
+            {
+                .device   = display->device,
+                .tx       = buf,
+                .len      = count,
+                .priority = BCM2835_SPI_BUS_LOW,
+                .prepare  = ssd1322_bus_prepare,
+                .arg      = &x
+            },
+            .gpio_dc = display->gpio_dc,
+            .level   = level
+        };
+
+        // Frames go out low priority, so control writes can cut in.
+        if ( bcm2835_spi_bus_submit( display->bus, &x.xfer ) == 0 )
+            bcm2835_spi_bus_wait( display->bus, &x.xfer );
+        statsAdd( STATS_SPI_TRANSFERS, 1 );
+        return;
+    }
+
+    gpioWrite( display->gpio_dc, level );
+    while ( count > 0 )
+    {
+        chunk = ( count < SPI_CHUNK ) ? count : SPI_CHUNK;
+        spiWrite( display->spi_handle, (char*)buf, chunk );
+        statsAdd( STATS_SPI_TRANSFERS, 1 );
+        buf   += chunk;
+        count -= chunk;
+    }
+}
+
 // ----------------------------------------------------------------------------
 /*
     Writes a command.
@@ -39,10 +110,8 @@
 // ----------------------------------------------------------------------------
 void ssd1322_write_command( uint8_t id, uint8_t command )
 {
-    char spi[1];
-    gpioWrite( ssd1322[id]->gpio_dc, SSD1322_INPUT_COMMAND );
-    spi[0] = command;
-    spiWrite( ssd1322[id]->spi_handle, spi, 1 );
+    ssd1322_spi_write( id, SSD1322_INPUT_COMMAND, &command, 1 );
+    statsAdd( STATS_SPI_BYTES, 1 );
 }
 
 // ----------------------------------------------------------------------------
@@ -52,10 +121,8 @@ void ssd1322_write_command( uint8_t id, uint8_t command )
 // ----------------------------------------------------------------------------
 void ssd1322_write_data( uint8_t id, uint8_t data )
 {
-    char spi[1];
-    gpioWrite( ssd1322[id]->gpio_dc, SSD1322_INPUT_DATA );
-    spi[0] = data;
-    spiWrite( ssd1322[id]->spi_handle, spi, 1 );
+    ssd1322_spi_write( id, SSD1322_INPUT_DATA, &data, 1 );
+    statsAdd( STATS_SPI_BYTES, 1 );
 }
 
 // ----------------------------------------------------------------------------
@@ -65,9 +132,141 @@ void ssd1322_write_data( uint8_t id, uint8_t data )
 // ----------------------------------------------------------------------------
 void ssd1322_write_stream( uint8_t id, uint8_t *buf, unsigned count )
 {
+    uint64_t start = statsTime();
+
+    statsAdd( STATS_SPI_BYTES, count );
     ssd1322_write_command( id, SSD1322_CMD_SET_WRITE );
-    gpioWrite( ssd1322[id]->gpio_dc, SSD1322_INPUT_DATA );
-    spiWrite( ssd1322[id]->spi_handle, (char*)buf, count );
+    ssd1322_spi_write( id, SSD1322_INPUT_DATA, buf, count );
+    statsAdd( STATS_SPI_FRAMES, 1 );
+    statsSince( STATS_SPI_TIME, start );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Writes rows of a data stream from a larger buffer.
+*/
+// ----------------------------------------------------------------------------
+void ssd1322_write_stream_rows( uint8_t id, uint8_t *buf, unsigned width,
+                                unsigned stride, unsigned rows )
+{
+    // Rows are contiguous if they are the full width of the buffer.
+    if ( width == stride )
+    {
+        ssd1322_write_stream( id, buf, width * rows );
+        return;
+    }
+
+    uint64_t start = statsTime();
+    ssd1322_write_command( id, SSD1322_CMD_SET_WRITE );
+    while ( rows-- > 0 )
+    {
+        ssd1322_spi_write( id, SSD1322_INPUT_DATA, buf, width );
+        statsAdd( STATS_SPI_BYTES, width );
+        buf += stride;
+    }
+    statsAdd( STATS_SPI_FRAMES, 1 );
+    statsSince( STATS_SPI_TIME, start );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Decodes one row of a run length encoded image.
+*/
+// ----------------------------------------------------------------------------
+const uint8_t *ssd1322_rle_row( const uint8_t *src, uint8_t *dst,
+                                unsigned bytes )
+{
+    unsigned n;
+
+    while ( bytes > 0 )
+    {
+        if ( *src & SSD1322_RLE_RUN )
+        {
+            n = ( *src++ & ~SSD1322_RLE_RUN ) + SSD1322_RLE_RUN_MIN;
+            if ( n > bytes ) n = bytes;
+            memset( dst, *src++, n );
+        }
+        else
+        {
+            n = *src++ + 1;
+            if ( n > bytes ) n = bytes;
+            memcpy( dst, src, n );
+            src += n;
+        }
+        dst   += n;
+        bytes -= n;
+    }
+    return src;
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Writes a run length encoded image straight to display RAM.
+*/
+// ----------------------------------------------------------------------------
+int8_t ssd1322_write_image( uint8_t id, uint16_t x, uint8_t y,
+                            const struct ssd1322_image *image )
+{
+    static uint8_t chunk[SPI_CHUNK];
+    const uint8_t *src = image->data;
+    unsigned stride = image->width / 2;
+    unsigned used = 0;
+    uint8_t  row;
+
+    if (( x % 4 ) || ( image->width % 4 ) || ( image->width == 0 ) ||
+        ( x + image->width > SSD1322_COLS ) ||
+        ( y + image->height > SSD1322_ROWS )) return -1;
+
+    ssd1322_set_cols( id, x, x + image->width - 4 );
+    ssd1322_set_rows( id, y, y + image->height - 1 );
+    ssd1322_write_command( id, SSD1322_CMD_SET_WRITE );
+
+    for ( row = 0; row < image->height; row++ )
+    {
+        if ( used + stride > SPI_CHUNK )
+        {
+            ssd1322_spi_write( id, SSD1322_INPUT_DATA, chunk, used );
+            used = 0;
+        }
+        src = ssd1322_rle_row( src, &chunk[used], stride );
+        used += stride;
+    }
+    if ( used > 0 ) ssd1322_spi_write( id, SSD1322_INPUT_DATA, chunk, used );
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Writes a sequence of commands and their data.
+*/
+// ----------------------------------------------------------------------------
+void ssd1322_write_sequence( uint8_t id, const uint8_t *sequence,
+                             unsigned len )
+{
+    uint8_t  commands[64];
+    unsigned i = 0;
+    unsigned count;
+    unsigned n = 0;
+
+    while ( i + 1 < len )
+    {
+        commands[n++] = sequence[i];
+        count = sequence[i + 1];
+        i += 2;
+
+        // Send commands so far before data or when there are no more.
+        if (( count > 0 ) || ( i + 1 >= len ) || ( n == sizeof( commands )))
+        {
+            ssd1322_spi_write( id, SSD1322_INPUT_COMMAND, commands, n );
+            n = 0;
+        }
+        if ( count > 0 )
+        {
+            ssd1322_spi_write( id, SSD1322_INPUT_DATA, &sequence[i], count );
+            i += count;
+        }
+    }
 }
 
 // ----------------------------------------------------------------------------
@@ -82,9 +281,9 @@ void ssd1322_write_stream( uint8_t id, uint8_t *buf, unsigned count )
 void ssd1322_reset( uint8_t id )
 {
     gpioWrite( ssd1322[id]->gpio_reset, SSD1322_RESET_ON );
-    gpioDelay( 500000 );
+    gpioDelay( SSD1322_RESET_LOW );
     gpioWrite( ssd1322[id]->gpio_reset, SSD1322_RESET_OFF );
-    gpioDelay( 1000000 );
+    gpioDelay( SSD1322_RESET_WAIT );
 }
 
 // ----------------------------------------------------------------------------
@@ -735,19 +934,92 @@ void ssd1322_set_command_unlock( uint8_t id )
 // ----------------------------------------------------------------------------
 void ssd1322_clear_display( uint8_t id )
 {
+    static uint8_t blank[SPI_CHUNK]; // Zeroed, sent repeatedly.
+    unsigned count;
+
     ssd1322_set_cols_default( id );
     ssd1322_set_rows_default( id );
-    ssd1322_set_write_continuous( id );
-    uint8_t col, row;
-    for ( row = SSD1322_ROWS_MIN; row <= SSD1322_ROWS_MAX; row++ )
+
+    // Each write continues from where the last finished.
+    for ( count = 0; count < SSD1322_RAM_BYTES; count += SPI_CHUNK )
+        ssd1322_write_stream( id, blank,
+                              ( SSD1322_RAM_BYTES - count < SPI_CHUNK ) ?
+                              SSD1322_RAM_BYTES - count : SPI_CHUNK );
+}
+
+// Scrolling. -----------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+/*
+    Resets the display start line so that RAM row 0 is displayed at the top.
+*/
+// ----------------------------------------------------------------------------
+void ssd1322_scroll_reset( uint8_t id )
+{
+    ssd1322[id]->start = 0;
+    ssd1322_set_start( id, 0 );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Writes rows to display RAM from a RAM row, wrapping at the end of RAM.
+*/
+// ----------------------------------------------------------------------------
+static void ssd1322_scroll_write( uint8_t id, uint8_t row, uint8_t *rows,
+                                  uint8_t count )
+{
+    uint8_t part;
+
+    ssd1322_set_cols( id, 0, SSD1322_COLS - 1 );
+    while ( count > 0 )
     {
-        for ( col = SSD1322_COLS_MIN; col <= SSD1322_COLS_MAX; col++ )
-        {
-            ssd1322_write_data( id, 0x00 );
-        }
+        part = SSD1322_RAM_ROWS - row;
+        if ( part > count ) part = count;
+
+        ssd1322_set_rows( id, row, row + part - 1 );
+        ssd1322_write_stream( id, rows, part * SSD1322_ROW_BYTES );
+        rows  += part * SSD1322_ROW_BYTES;
+        count -= part;
+        row    = 0;
     }
 }
 
+// ----------------------------------------------------------------------------
+/*
+    Scrolls the display up by count rows, adding rows at the bottom.
+*/
+// ----------------------------------------------------------------------------
+void ssd1322_scroll_up( uint8_t id, uint8_t *rows, uint8_t count )
+{
+    uint8_t start = ssd1322[id]->start;
+
+    if ( count > SSD1322_ROWS ) return;
+
+    // Rows below the display become visible as the start line moves down.
+    ssd1322_scroll_write( id, ( start + SSD1322_ROWS ) % SSD1322_RAM_ROWS,
+                          rows, count );
+    ssd1322[id]->start = ( start + count ) % SSD1322_RAM_ROWS;
+    ssd1322_set_start( id, ssd1322[id]->start );
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Scrolls the display down by count rows, adding rows at the top.
+*/
+// ----------------------------------------------------------------------------
+void ssd1322_scroll_down( uint8_t id, uint8_t *rows, uint8_t count )
+{
+    uint8_t start = ssd1322[id]->start;
+
+    if ( count > SSD1322_ROWS ) return;
+
+    // Rows above the display become visible as the start line moves up.
+    start = ( start + SSD1322_RAM_ROWS - count ) % SSD1322_RAM_ROWS;
+    ssd1322_scroll_write( id, start, rows, count );
+    ssd1322[id]->start = start;
+    ssd1322_set_start( id, start );
+}
+
 // ----------------------------------------------------------------------------
 /*
     Sets default display operation settings.
@@ -784,54 +1056,57 @@ void ssd1322_set_defaults( uint8_t id )
 // ----------------------------------------------------------------------------
 void ssd1322_set_typical( uint8_t id )
 {
-    ssd1322_set_command_unlock( id );
-    ssd1322_set_display_off( id );
-    ssd1322_set_cols( id, 0x1c, 0x5b );
-    ssd1322_set_rows( id, 0x00, 0x3f );
-    ssd1322_set_clock( id, 0x91 );
-    ssd1322_set_mux( id, 0x3f );
-    ssd1322_set_offset( id, 0x00 );
-    ssd1322_set_start( id, 0x00 );
-    ssd1322_set_remap( id, 0x14, 0x11 );
-    ssd1322_set_gpios( id, 0x00 );
-    ssd1322_set_vdd_internal( id );
-    ssd1322_set_enhance_a( id, 0xa0, 0xfd );
-    ssd1322_set_contrast( id, 0x9f );
-    ssd1322_set_brightness( id, 0x04 );
-    ssd1322_set_greys_default( id );
-    ssd1322_set_phase( id, 0xe2 );
-    ssd1322_set_enhance_b( id, 0x00, 0x20 );
-    ssd1322_set_pre_volt( id, 0x1f );
-    ssd1322_set_period( id, 0x08 );
-    ssd1322_set_com_volt( id, 0x07 );
-    ssd1322_set_display_normal( id );
-    ssd1322_set_part_display_off( id );
-    ssd1322_set_display_on( id );
-    gpioDelay( 1000000 );
+    static const uint8_t typical[] =
+    {
+        SSD1322_CMD_SET_LOCK,       1, SSD1322_COMMAND_UNLOCK,
+        SSD1322_CMD_SET_DISP_OFF,   0,
+        SSD1322_CMD_SET_COLS,       2, SSD1322_COL_OFFSET,
+                                       SSD1322_COL_OFFSET + SSD1322_COLS / 4 - 1,
+        SSD1322_CMD_SET_ROWS,       2, 0x00, SSD1322_ROWS - 1,
+        SSD1322_CMD_SET_CLOCK,      1, 0x91,
+        SSD1322_CMD_SET_MUX,        1, 0x3f,
+        SSD1322_CMD_SET_OFFSET,     1, 0x00,
+        SSD1322_CMD_SET_START,      1, 0x00,
+        SSD1322_CMD_SET_REMAP,      2, 0x14, 0x11,
+        SSD1322_CMD_SET_GPIOS,      1, 0x00,
+        SSD1322_CMD_SET_VDD,        1, SSD1322_VDD_INTERNAL,
+        SSD1322_CMD_SET_ENHANCE_A,  2, 0xa0, 0xfd,
+        SSD1322_CMD_SET_CONTRAST,   1, 0x9f,
+        SSD1322_CMD_SET_BRIGHTNESS, 1, 0x04,
+        SSD1322_CMD_SET_GREYS_DEF,  0,
+        SSD1322_CMD_SET_PHASE,      1, 0xe2,
+        SSD1322_CMD_SET_ENHANCE_B,  2, 0x00, 0x20,
+        SSD1322_CMD_SET_PRE_VOLT,   1, 0x1f,
+        SSD1322_CMD_SET_PERIOD,     1, 0x08,
+        SSD1322_CMD_SET_COM_VOLT,   1, 0x07,
+        SSD1322_CMD_SET_PIX_NORM,   0,
+        SSD1322_CMD_SET_PART_OFF,   0,
+        SSD1322_CMD_SET_DISP_ON,    0
+    };
+
+    ssd1322_write_sequence( id, typical, sizeof( typical ));
 }
 
 // ----------------------------------------------------------------------------
 /*
-    Initialises display.
+    Adds a display and brings it up. Returns the display ID, -1 if there
+    are no free IDs or -2 if there is no memory.
 */
 // ----------------------------------------------------------------------------
-int8_t ssd1322_init( uint8_t  dc,   uint8_t  reset, uint8_t channel,
-                     uint32_t baud, uint32_t flags )
+static int8_t ssd1322_add( uint8_t dc, uint8_t reset, uint8_t handle,
+                           struct bcm2835_spi_bus *bus,
+                           struct bcm2835_spi_device *device )
 {
     struct ssd1322_t *ssd1322_this; // Display instance.
     static bool init = false;       // 1st Call to init.
 
     int8_t  id = -1; // Display handle.
-    uint8_t handle;  // SPI handle.
     uint8_t display; // Counter.
 
     // 1st call - clear ssd1322 structs.
     if ( !init )
-    {
         for ( display = 0; display < SSD1322_DISPLAYS_MAX; display++ )
         ssd1322[display] = NULL;
-        gpioInitialise();
-    }
 
     // Get next available display ID.
     for ( display = 0; display < SSD1322_DISPLAYS_MAX; display++ )
@@ -839,7 +1114,6 @@ int8_t ssd1322_init( uint8_t  dc,   uint8_t  reset, uint8_t channel,
         if ( ssd1322[display] == NULL )
         {
             id = display;
-            handle = spiOpen( channel, baud, flags );
             break;
         }
     }
@@ -854,8 +1128,11 @@ int8_t ssd1322_init( uint8_t  dc,   uint8_t  reset, uint8_t channel,
 
     // Create instance for display being initialised.
     ssd1322_this->spi_handle = handle;
+    ssd1322_this->bus        = bus;
+    ssd1322_this->device     = device;
     ssd1322_this->gpio_dc    = dc;
     ssd1322_this->gpio_reset = reset;
+    ssd1322_this->start      = 0;
     ssd1322[id] = ssd1322_this;
 
     init = true;
@@ -871,3 +1148,43 @@ int8_t ssd1322_init( uint8_t  dc,   uint8_t  reset, uint8_t channel,
 
     return id;
 }
+
+// ----------------------------------------------------------------------------
+/*
+    Initialises display.
+*/
+// ----------------------------------------------------------------------------
+int8_t ssd1322_init( uint8_t  dc,   uint8_t  reset, uint8_t channel,
+                     uint32_t baud, uint32_t flags )
+{
+    int     handle; // SPI handle.
+    int8_t  id;
+
+    // pigpio must be running before the SPI channel can be opened.
+    if ( gpioInitialise() < 0 ) return -1;
+
+    handle = spiOpen( channel, baud, flags );
+    if ( handle < 0 ) return -1;
+
+    id = ssd1322_add( dc, reset, handle, NULL, NULL );
+    if ( id < 0 ) spiClose( handle );
+
+    return id;
+}
+
+// ----------------------------------------------------------------------------
+/*
+    Initialises a display on a shared bus.
+*/
+// ----------------------------------------------------------------------------
+int8_t ssd1322_init_bus( uint8_t dc, uint8_t reset,
+                         struct bcm2835_spi_bus *bus,
+                         struct bcm2835_spi_device *device )
+{
+    if (( bus == NULL ) || ( device == NULL )) return -1;
+
+    // pigpio still drives DC# and RES#.
+    if ( gpioInitialise() < 0 ) return -1;
+
+    return ssd1322_add( dc, reset, 0, bus, device );
+}
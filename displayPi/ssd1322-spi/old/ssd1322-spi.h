@@ -21,13 +21,15 @@
 */
 //  ===========================================================================
 
-#define SSD1322_SPI_VERSION 1.01
+#define SSD1322_SPI_VERSION 1.06
 
 //  Macros. -------------------------------------------------------------------
 
 #ifndef SSD1322SPI_H
 #define SSD1322SPI_H
 
+#include "ssd1322-image.h"
+
 // Default GPIO assignments.
 #define GPIO_DC         23 // Data/Command (DC#) pin.
 #define GPIO_RESET      24 // Hardware reset (RES#) pin.
@@ -37,11 +39,13 @@
 #define SSD1322_COLS       256 // No of display columns (pixels).
 #define SSD1322_ROWS        64 // No of display lines (pixels).
 #define SSD1322_GREYSCALES  16 // No of greyscales.
+#define SSD1322_FRAME_BYTES ( SSD1322_COLS * SSD1322_ROWS / 2 ) // 4 bits/pixel.
 
 // SPI default properties for RPi.
 #define SPI_CHANNEL    0 // Channel.
 #define SPI_BAUD 5000000 // Baud rate (5 MHz).
 #define SPI_FLAGS   0x03 // Mode flags for pigpio.
+#define SPI_CHUNK   4096 // Largest single SPI transfer (spidev bufsiz).
 /*
     Setting the SPI flags:
 
@@ -125,12 +129,18 @@
 #define SSD1322_INPUT_DATA    1 // Enable data mode for DC# pin.
 #define SSD1322_RESET_ON      0 // Hardware reset.
 #define SSD1322_RESET_OFF     1 // Normal operation.
+#define SSD1322_RESET_LOW   200 // RES# low time, 100uS minimum (uS).
+#define SSD1322_RESET_WAIT  200 // Wait after reset before commands (uS).
 
 // Ranges.
 #define SSD1322_COLS_MIN       0x00 // Start column.
 #define SSD1322_COLS_MAX       0x77 // End column.
 #define SSD1322_ROWS_MIN       0x00 // Start row.
 #define SSD1322_ROWS_MAX       0x7f // End row.
+#define SSD1322_RAM_ROWS       ( SSD1322_ROWS_MAX + 1 ) // Rows in RAM.
+#define SSD1322_ROW_BYTES      ( SSD1322_COLS / 2 )     // Bytes per row.
+#define SSD1322_RAM_BYTES      ((( SSD1322_COLS_MAX + 1 ) * 2 ) * \
+                                ( SSD1322_ROWS_MAX + 1 )) // 2 bytes/col.
 
 // Settings.
 #define SSD1322_INC_COLS       0x00 // Increment cols.
@@ -164,11 +174,17 @@
 
 // Data structures. -----------------------------------------------------------
 
+struct bcm2835_spi_bus;    // See bcm2835spi.h.
+struct bcm2835_spi_device;
+
 struct ssd1322_t
 {
     uint8_t spi_handle; // SPI handle.
+    struct bcm2835_spi_bus    *bus;    // Shared bus, or NULL for pigpio.
+    struct bcm2835_spi_device *device; // Bus settings if bus is set.
     uint8_t gpio_dc;    // GPIO for DC#.
     uint8_t gpio_reset; // GPIO for hardware reset.
+    uint8_t start;      // Display RAM start line when scrolling.
 };
 
 struct ssd1322_t *ssd1322[SSD1322_DISPLAYS_MAX];
@@ -195,11 +211,67 @@ void ssd1322_write_data( uint8_t id, uint8_t data );
 
 // ----------------------------------------------------------------------------
 /*
-    Writes a data stream.
+    Writes a data stream to display RAM.
+
+    DC# is set once and the data is sent in transfers of up to SPI_CHUNK
+    bytes, so a whole frame costs a few transfers rather than one per byte.
+    On a shared bus the data is queued as one low priority transaction,
+    which the scheduler sends in chunks with DC# set before each.
 */
 // ----------------------------------------------------------------------------
 void ssd1322_write_stream( uint8_t id, uint8_t *buf, unsigned count );
 
+// ----------------------------------------------------------------------------
+/*
+    Writes rows of a data stream from a larger buffer.
+
+    Sends rows of width bytes, stride bytes apart, e.g. a window of a
+    framebuffer. Rows must be shorter than SPI_CHUNK.
+*/
+// ----------------------------------------------------------------------------
+void ssd1322_write_stream_rows( uint8_t id, uint8_t *buf, unsigned width,
+                                unsigned stride, unsigned rows );
+
+// ----------------------------------------------------------------------------
+/*
+    Decodes one row of a run length encoded image.
+
+    Writes bytes bytes of packed pixels to dst and returns the start of the
+    next encoded row.
+*/
+// ----------------------------------------------------------------------------
+const uint8_t *ssd1322_rle_row( const uint8_t *src, uint8_t *dst,
+                                unsigned bytes );
+
+// ----------------------------------------------------------------------------
+/*
+    Writes a run length encoded image straight to display RAM.
+
+    Rows are decoded into a single SPI_CHUNK sized buffer and sent as it
+    fills, so no uncompressed copy of the image is needed. x and the image
+    width must be multiples of 4, the width of a RAM column.
+*/
+// ----------------------------------------------------------------------------
+int8_t ssd1322_write_image( uint8_t id, uint16_t x, uint8_t y,
+                            const struct ssd1322_image *image );
+
+// ----------------------------------------------------------------------------
+/*
+    Writes a sequence of commands and their data.
+
+    Each command in the sequence is followed by the number of data bytes and
+    the data bytes, e.g.
+
+        SSD1322_CMD_SET_REMAP, 2, 0x14, 0x11,
+        SSD1322_CMD_SET_DISP_ON, 0
+
+    Bytes are sent in one SPI transfer per change of DC#, so commands
+    without data are sent together.
+*/
+// ----------------------------------------------------------------------------
+void ssd1322_write_sequence( uint8_t id, const uint8_t *sequence,
+                             unsigned len );
+
 // ----------------------------------------------------------------------------
 /*
     Triggers a hardware reset:
@@ -637,11 +709,49 @@ void ssd1322_command_unlock( uint8_t id );
 
 // ----------------------------------------------------------------------------
 /*
-    Clears display RAM.
+    Clears all of display RAM, including columns and rows not displayed.
 */
 // ----------------------------------------------------------------------------
 void ssd1322_clear_display( uint8_t id );
 
+// Scrolling. -----------------------------------------------------------------
+/*
+    Display RAM has 128 rows but only 64 are displayed, starting from the
+    display start line. Moving the start line scrolls the display without
+    rewriting it, so display RAM can be used as a circular buffer of rows
+    where each step only sends the rows scrolled into view, e.g. a scrolling
+    waveform or vertical ticker sends 128 bytes per row rather than a frame.
+
+    The controller can only scroll vertically. Rows are 256 pixels packed 2
+    per byte (SSD1322_ROW_BYTES). Scrolling moves the display against
+    absolute RAM rows, so don't mix it with framebuffer writes.
+*/
+
+// ----------------------------------------------------------------------------
+/*
+    Resets the display start line so that RAM row 0 is displayed at the top.
+*/
+// ----------------------------------------------------------------------------
+void ssd1322_scroll_reset( uint8_t id );
+
+// ----------------------------------------------------------------------------
+/*
+    Scrolls the display up by count rows, adding rows at the bottom.
+
+    rows holds count rows, top first.
+*/
+// ----------------------------------------------------------------------------
+void ssd1322_scroll_up( uint8_t id, uint8_t *rows, uint8_t count );
+
+// ----------------------------------------------------------------------------
+/*
+    Scrolls the display down by count rows, adding rows at the top.
+
+    rows holds count rows, top first.
+*/
+// ----------------------------------------------------------------------------
+void ssd1322_scroll_down( uint8_t id, uint8_t *rows, uint8_t count );
+
 // ----------------------------------------------------------------------------
 /*
     Sets default display operation settings.
@@ -664,4 +774,19 @@ void ssd1322_set_typical( uint8_t id );
 int8_t ssd1322_init( uint8_t  dc,   uint8_t  reset, uint8_t channel,
                      uint32_t baud, uint32_t flags );
 
+// ----------------------------------------------------------------------------
+/*
+    Initialises a display on a shared bus.
+
+    Writes go through the bcm2835spi bus scheduler instead of a pigpio SPI
+    handle, so a display can share SPI0 with other devices such as an
+    MCP42x1. bus must be running and device holds the display's chip select
+    and settings, e.g. mode 3 and CS active low. Both must outlive the
+    display. pigpio is still used for DC# and RES#.
+*/
+// ----------------------------------------------------------------------------
+int8_t ssd1322_init_bus( uint8_t dc, uint8_t reset,
+                         struct bcm2835_spi_bus *bus,
+                         struct bcm2835_spi_device *device );
+
 #endif
@@ -23,7 +23,8 @@
 /*
     Compile with:
 
-    gcc test-ssd1322.c ssd1322-spi.c -Wall -o test-ssd1322 -lpigpio
+    gcc test-ssd1322.c ssd1322-spi.c ../../../chipsPi/bcm2835/spi/bcm2835spi.c
+        ../../../boardPi/boardPi.c -Wall -o test-ssd1322 -lpigpio -lpthread
 
     Also use the following flags for Raspberry Pi optimisation:
         -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
@@ -1,6 +1,33 @@
 //============================================================================
 /*
-    Bit-packs bitmap font stream to Adafruit-gfx format.
+    Converts bitmap font stream to a C header of pre-rendered 4bpp glyph
+    strips for the SSD1322 framebuffer text renderer (see ssd1322-font.h).
+
+    Compile with:
+
+        gcc fontconvert.c -Wall -o fontconvert
+
+    Usage:
+
+        fontconvert [options] > font-<name>.h
+
+        -i file     Input file (default unpacked.txt).
+        -n name     Font name used for C identifiers (default default).
+        -f first    First character (default 32).
+        -l last     Last character (default 126).
+        -w width    Width of glyph edit box in pixels, multiple of 8 (16).
+        -h height   Height of glyph edit box in pixels (10).
+        -b base     Baseline row of glyph edit box (7).
+        -s scale    Edit box pixels per output pixel (1). Scales above 1 are
+                    box filtered, which antialiases fonts drawn large.
+        -a grey     Grey used to smooth inside corners of 1:1 fonts (0 off).
+        -g gap      Pixels between glyphs (1).
+        -e advance  Advance for empty glyphs, e.g. space (4).
+        -k pixels   Most that a pair of glyphs may be kerned together (1).
+        -v          Print glyphs to stderr.
+
+    The input contains one hex byte per line, each glyph being height rows
+    of width / 8 bytes, most significant bit on the left.
 */
 //=============================================================================
 
@@ -8,12 +35,15 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
 
 #define BITS_BYTE 8
-#define COLS_MAX  8 // Used for formatting binary output.
+#define COLS_MAX 16 // Used for formatting hex output.
 
-#define GLYPH_ROWS_MAX 20 // Maximum number of glyph rows (pixel height)
-#define GLYPH_COLS_MAX  8 // Maximum number of glyph cols (pixel width).
+#define GLYPH_ROWS_MAX 64 // Maximum number of glyph rows (pixel height)
+#define GLYPH_COLS_MAX 64 // Maximum number of glyph cols (pixel width).
 #define GLYPHS_MAX    256 // Maximum number of glyphs (extended ASCII).
 
 struct glyph
@@ -23,37 +53,60 @@ struct glyph
     uint8_t  width;     // Packed width.
     uint8_t  height;    // Packed height.
     uint8_t  xadvance;  // Pixels to next char.
-    int8_t   xoffset;   // Offset relative to base.
-    int8_t   yoffset;   // Offset relative to left.
+    int8_t   xoffset;   // Offset relative to pen.
+    int8_t   yoffset;   // Offset relative to baseline.
+    int16_t  left[GLYPH_ROWS_MAX];  // First lit col of each row (-1 = none).
+    int16_t  right[GLYPH_ROWS_MAX]; // Last lit col of each row.
 };
 
-//=============================================================================
-/*
-    Converts numerical value (dec/hex) of char c.
-*/
-//=============================================================================
-uint8_t char_to_hex( char c )
+struct kern
 {
-    uint8_t hex = ( uint8_t ) c;
-    if( hex <  58 && hex > 47 ) return ( hex - 48 );
-    if( hex <  71 && hex > 64 ) return ( hex - 55 );
-    if( hex < 103 && hex > 96 ) return ( hex - 87 );
-    return hex;
-}
+    uint8_t left;
+    uint8_t right;
+    int8_t  adjust;
+};
 
 //=============================================================================
 /*
-    Returns bit state at position pos of byte hex.
+    Renders a glyph at output resolution, 4 bits per pixel.
 */
 //=============================================================================
-bool get_bit( uint8_t hex, uint8_t pos )
+void render_glyph( bool src[GLYPH_ROWS_MAX][GLYPH_COLS_MAX],
+                   uint8_t grey[GLYPH_ROWS_MAX][GLYPH_COLS_MAX],
+                   uint8_t rows, uint8_t cols, uint8_t scale, uint8_t smooth )
 {
-    if (( pos < 0 ) || ( pos > 7 ))
-    {
-        printf( "Bad position.\n" );
-        return 0;
-    }
-    return ( hex & ( 1 << pos ));
+    uint8_t row, col, i, j;
+    uint16_t count;
+    uint16_t area = scale * scale;
+
+    // Box filter each scale x scale block into a grey level.
+    for ( row = 0; row < rows; row++ )
+        for ( col = 0; col < cols; col++ )
+        {
+            count = 0;
+            for ( j = 0; j < scale; j++ )
+                for ( i = 0; i < scale; i++ )
+                    count += src[ row * scale + j ][ col * scale + i ];
+            grey[row][col] = ( 15 * count + area / 2 ) / area;
+        }
+
+    if (( scale > 1 ) || ( smooth == 0 )) return;
+
+    // Soften stair steps by partly filling unlit inside corners.
+    for ( row = 0; row < rows; row++ )
+        for ( col = 0; col < cols; col++ )
+        {
+            bool n, s, e, w;
+
+            if ( src[row][col] ) continue;
+            n = ( row > 0 )        && src[ row - 1 ][col];
+            s = ( row < rows - 1 ) && src[ row + 1 ][col];
+            w = ( col > 0 )        && src[row][ col - 1 ];
+            e = ( col < cols - 1 ) && src[row][ col + 1 ];
+            if (( n && e && !s && !w ) || ( e && s && !n && !w ) ||
+                ( s && w && !n && !e ) || ( w && n && !s && !e ))
+                grey[row][col] = smooth;
+        }
 }
 
 //=============================================================================
@@ -61,49 +114,88 @@ bool get_bit( uint8_t hex, uint8_t pos )
     Main.
 */
 //=============================================================================
-
-int main()
+int main( int argc, char *argv[] )
 {
-    uint8_t  glyph_width  =  8; // Width of glyph edit box (byte multiples).
-    uint8_t  glyph_height = 20; // Height of glyph edit box.
-    uint8_t  glyph_base   = 12; // Glyph baseline.
-
-    uint8_t  glyph_start =  32; // ASCII table start position.
-    uint8_t  glyph_end   =  45; // ASCII table end position.
-//    uint8_t  glyph_end   = 126; // ASCII table end position.
-    uint8_t  glyph_num;         // Number of glyphs.
-    uint16_t glyph_bits;        // Bits in each unpacked glyph.
-    uint16_t offset = 0;        // Counter for packed glyph offset.
-
-    bool unpacked[65536];       // Enough for 128 chars of 16x32.
-    bool packed[65536];         // Enough for 128 chars of 16x32.
-
-    bool glyph_matrix[GLYPH_ROWS_MAX][GLYPH_COLS_MAX];
-
-    struct glyph glyph[GLYPHS_MAX]; // Inefficient but easy.
-
-    uint8_t hex; // Temp store for glyph hex value.
-
-    char input_file[16] = "unpacked.txt"; // Input filename.
-    char ch1, ch2; // Chars read from file.
-    FILE *fp;      // File pointer.
+    char    *input_file  = "unpacked.txt"; // Input filename.
+    char    *name        = "default"; // Font name.
+    uint16_t glyph_start =  32; // ASCII table start position.
+    uint16_t glyph_end   = 126; // ASCII table end position.
+    uint16_t glyph_width =  16; // Width of glyph edit box (multiple of 8).
+    uint16_t glyph_height = 10; // Height of glyph edit box.
+    uint16_t glyph_base  =   7; // Glyph baseline.
+    uint16_t scale       =   1; // Edit box pixels per output pixel.
+    uint16_t smooth      =   0; // Corner smoothing grey.
+    uint16_t spacing     =   1; // Pixels between glyphs.
+    uint16_t empty       =   4; // Advance for empty glyphs.
+    uint16_t kern_max    =   1; // Maximum kerning.
+    bool     verbose     = false;
+
+    static bool    src[GLYPH_ROWS_MAX][GLYPH_COLS_MAX];
+    static uint8_t grey[GLYPH_ROWS_MAX][GLYPH_COLS_MAX];
+    static struct glyph glyph[GLYPHS_MAX];
+    struct kern *kerns;
+    uint16_t kern_count = 0;
+    uint8_t *packed;
+    uint32_t packed_count = 0;
+    uint32_t unpacked_count;
+
+    uint16_t glyph_num;         // Number of glyphs.
+    uint16_t rows, cols;        // Output glyph size.
+    uint16_t g, l, r;           // Glyph counters.
+    uint16_t row, col, bit;     // Counters.
+    int16_t  row_min, row_max;  // Glyph bounds.
+    int16_t  col_min, col_max;
+    unsigned int hex;           // Byte read from file.
+    uint8_t  byte;
+    int      opt;
+    FILE    *fp;
+    char     guard[32];             // Include guard.
+    size_t   i;
+
+    while (( opt = getopt( argc, argv, "i:n:f:l:w:h:b:s:a:g:e:k:v" )) != -1 )
+    {
+        switch ( opt )
+        {
+            case 'i': input_file   = optarg; break;
+            case 'n': name         = optarg; break;
+            case 'f': glyph_start  = atoi( optarg ); break;
+            case 'l': glyph_end    = atoi( optarg ); break;
+            case 'w': glyph_width  = atoi( optarg ); break;
+            case 'h': glyph_height = atoi( optarg ); break;
+            case 'b': glyph_base   = atoi( optarg ); break;
+            case 's': scale        = atoi( optarg ); break;
+            case 'a': smooth       = atoi( optarg ) & 0x0f; break;
+            case 'g': spacing      = atoi( optarg ); break;
+            case 'e': empty        = atoi( optarg ); break;
+            case 'k': kern_max     = atoi( optarg ); break;
+            case 'v': verbose      = true; break;
+            default:
+                fprintf( stderr, "See fontconvert.c for options.\n" );
+                exit( EXIT_FAILURE );
+        }
+    }
 
-    uint8_t bit;            // Counters.
-    uint8_t glyph_current;  // Counter.
-    bool    cell;           // Glyph bit value.
-    uint8_t row, col, byte; // Counters.
-    uint8_t row_min = 0;    // Row start of glyph.
-    uint8_t row_max = 0;    // Row extent of glyph.
-    uint8_t col_min = 0;    // COl start of glyph.
-    uint8_t col_max = 0;    // Col extent of glyph.
+    if (( glyph_width % BITS_BYTE ) || ( glyph_width > GLYPH_COLS_MAX ) ||
+        ( glyph_height > GLYPH_ROWS_MAX ) || ( scale == 0 ) ||
+        ( glyph_end >= GLYPHS_MAX ) || ( glyph_end < glyph_start ))
+    {
+        fprintf( stderr, "Bad glyph parameters.\n" );
+        exit( EXIT_FAILURE );
+    }
 
-    uint16_t packed_count = 0; // Packed glyph bit count.
-    uint8_t packed_hex[GLYPH_ROWS_MAX * GLYPH_COLS_MAX];
+    glyph_num = glyph_end - glyph_start + 1;
+    rows = glyph_height / scale;
+    cols = glyph_width / scale;
 
-    glyph_num  = glyph_end   - glyph_start;
-    glyph_bits = glyph_width * glyph_height;
+    packed = malloc( glyph_num * rows * (( cols + 1 ) / 2 ));
+    kerns  = malloc( glyph_num * glyph_num * sizeof( struct kern ));
+    if (( packed == NULL ) || ( kerns == NULL ))
+    {
+        fprintf( stderr, "Couldn't allocate memory.\n" );
+        exit( EXIT_FAILURE );
+    }
 
-    printf( "Processing %d glyphs from ASCII %d (%c) to %d (%c).\n",
+    fprintf( stderr, "Processing %d glyphs from ASCII %d (%c) to %d (%c).\n",
              glyph_num, glyph_start, glyph_start, glyph_end, glyph_end );
 
     // Open input file (read only). -------------------------------------------
@@ -111,180 +203,206 @@ int main()
 
     if ( fp == NULL )
     {
-        perror( "Error opening file.\n" );
+        perror( "Error opening file" );
         exit( EXIT_FAILURE );
     }
 
     // For each glyph. --------------------------------------------------------
-    for ( glyph_current = 0; glyph_current < glyph_num + 1; glyph_current++ )
+    for ( g = 0; g < glyph_num; g++ )
     {
-        printf( "Glyph %d (%c):\n\n", glyph_current + glyph_start,
-                                      glyph_current + glyph_start );
-
-        printf( "Unpacked bitmap representation from file:\n\n" );
-
-        // Reset bound counters for next glyph. -------------------------------
-        row_min = glyph_height - 1;
-        row_max = 0;
-        col_min = glyph_width - 1;
-        col_max = 0;
-
-        // Glyph rows. --------------------------------------------------------
-        for( row = 0; row < glyph_height; row++ )
-        {
-            // Glyph cols. ----------------------------------------------------
-            col = 0;
-            while( col < glyph_width )
+        // Read glyph edit box, a byte per line. ------------------------------
+        for ( row = 0; row < glyph_height; row++ )
+            for ( col = 0; col < glyph_width; col += BITS_BYTE )
             {
-                // Read byte pair of chars from file. -------------------------
-                if (( ch1 = fgetc( fp )) == EOF )
-                {
-                    printf( "Unexpected end of file!\n" );
-                    return 0;
-                };
-                if (( ch2 = fgetc( fp )) == EOF )
-                {
-                    printf( "Unexpected end of file!\n" );
-                    return 0;
-                };
-                fgetc( fp ); // Throw away the LF or CRLF.
-
-                // Get hex value of byte pair chars. --------------------------
-                hex = char_to_hex( ch1 ) << 4 | char_to_hex( ch2 );
-                printf( "%c%c\t0x%02x\t", ch1, ch2, hex );
-
-                // Get bits in big-endian order. ------------------------------
-                for ( bit = 0; bit < BITS_BYTE; bit++ )
+                if ( fscanf( fp, "%2x", &hex ) != 1 )
                 {
-                    cell = get_bit( hex, BITS_BYTE - bit - 1 );
-                    glyph_matrix[row][col] = cell;
-                    unpacked[glyph_current * glyph_bits +
-                                       row * glyph_width + col] = cell;
-                    // Get bounds and draw unpacked glyph. --------------------
-                    if ( cell == 1 )
-                    {
-                        printf( "#" );
-
-                        // Get glyph bounds. ----------------------------------
-                        if ( row > row_max ) row_max = row;
-                        if ( col > col_max ) col_max = col;
-                        if ( row < row_min ) row_min = row;
-                        if ( col < col_min ) col_min = col;
-                    }
-                    else printf( "." );
-                    col++;
+                    fprintf( stderr, "Unexpected end of file!\n" );
+                    exit( EXIT_FAILURE );
                 }
+                for ( bit = 0; bit < BITS_BYTE; bit++ )
+                    src[row][ col + bit ] = hex & ( 1 << ( BITS_BYTE - bit - 1 ));
             }
-            printf( "\n" );
-        }
-        printf( "\n" );
-        printf( "\tmin\tmax\n" );
-        printf("row\t%d\t%d\n", row_min, row_max );
-        printf("col\t%d\t%d\n", col_min, col_max );
-
-        // Draw packed glyph. -------------------------------------------------
-        printf( "\nPacked bitmap representation:\n" );
-        for ( row = row_min; row <= row_max; row++ )
+
+        render_glyph( src, grey, rows, cols, scale, smooth );
+
+        // Get glyph bounds and row profiles. ---------------------------------
+        row_min = rows;
+        row_max = -1;
+        col_min = cols;
+        col_max = -1;
+        for ( row = 0; row < rows; row++ )
         {
-            printf( "\n\t" );
-            for ( col = col_min; col <= col_max; col++ )
+            glyph[g].left[row]  = -1;
+            glyph[g].right[row] = -1;
+            for ( col = 0; col < cols; col++ )
             {
-                packed[packed_count] = glyph_matrix[row][col];
-                packed_count++;
-                if ( glyph_matrix[row][col] == 1 ) printf( "#" );
-                else printf( "." );
+                if ( grey[row][col] == 0 ) continue;
+                if ( glyph[g].left[row] < 0 ) glyph[g].left[row] = col;
+                glyph[g].right[row] = col;
+                if ( row < row_min ) row_min = row;
+                if ( row > row_max ) row_max = row;
+                if ( col < col_min ) col_min = col;
+                if ( col > col_max ) col_max = col;
             }
         }
-        printf( "\n" );
 
         // Fill glyph info struct. --------------------------------------------
-        glyph[glyph_current].ascii   = glyph_current + glyph_start;
-        glyph[glyph_current].width   = col_max - col_min;
-        glyph[glyph_current].height  = row_max - row_min;
-        glyph[glyph_current].offset  = offset;
-        glyph[glyph_current].xoffset = col_min;
-        glyph[glyph_current].yoffset = row_min - glyph_base;
-        offset += row_max * col_max;
-
-
-        // Print summary for glyph. -------------------------------------------
-        printf( "\nGlyph %d summary:\n", glyph[glyph_current].ascii );
-        printf( "\tOffset  = %d.\n", glyph[glyph_current].offset );
-        printf( "\tWidth   = %d.\n", glyph[glyph_current].width );
-        printf( "\tHeight  = %d.\n", glyph[glyph_current].height );
-        printf( "\txOffset = %d.\n", glyph[glyph_current].xoffset );
-        printf( "\tyOffset = %d.\n", glyph[glyph_current].yoffset );
-        printf( "\n" );
-    }
+        glyph[g].ascii  = g + glyph_start;
+        glyph[g].offset = packed_count;
+        if ( row_max < 0 )
+        {
+            glyph[g].width    = 0;
+            glyph[g].height   = 0;
+            glyph[g].xoffset  = 0;
+            glyph[g].yoffset  = 0;
+            glyph[g].xadvance = empty;
+        }
+        else
+        {
+            glyph[g].width    = col_max - col_min + 1;
+            glyph[g].height   = row_max - row_min + 1;
+            glyph[g].xoffset  = col_min;
+            glyph[g].yoffset  = row_min - glyph_base / scale;
+            glyph[g].xadvance = col_max + 1 + spacing;
+        }
 
-    // Pad packed bits to next byte boundary. ---------------------------------
-    while (( packed_count % BITS_BYTE ) != 0 )
-    {
-        packed_count++;
-        packed[packed_count] = 0;
-    }
+        // Pack bounding box, 2 pixels per byte, rows padded to bytes. --------
+        for ( row = row_min; ( int16_t )row <= row_max; row++ )
+            for ( col = col_min; ( int16_t )col <= col_max; col += 2 )
+            {
+                byte = grey[row][col] << 4;
+                if (( int16_t )col < col_max ) byte |= grey[row][ col + 1 ];
+                packed[ packed_count++ ] = byte;
+            }
 
-    // Print out unpacked bits matrix. ----------------------------------------
-/*
-    printf( "Unpacked bits matrix:\n" );
-    uint16_t count;
-    uint8_t col_count = 0;
-    for( count = 0; count < glyph_bits * glyph_num; count++ )
-    {
-        printf( "%d", unpacked[count] );
-        col_count++;
-        if ( col_count >= COLS_MAX )
+        // Draw glyph. --------------------------------------------------------
+        if ( verbose )
         {
-            printf( "\n" );
-            col_count = 0;
+            fprintf( stderr, "Glyph %d (%c): %dx%d at %d,%d, advance %d.\n",
+                     glyph[g].ascii, glyph[g].ascii,
+                     glyph[g].width, glyph[g].height,
+                     glyph[g].xoffset, glyph[g].yoffset, glyph[g].xadvance );
+            for ( row = 0; row < rows; row++ )
+            {
+                fprintf( stderr, "\t" );
+                for ( col = 0; col < cols; col++ )
+                    fputc( " .:-=+*#%@@@@@@@"[ grey[row][col] ], stderr );
+                fprintf( stderr, "%s\n", row == glyph_base / scale ?
+                                         " <- base" : "" );
+            }
+            fprintf( stderr, "\n" );
         }
     }
-    printf( "\n" );
-*/
-    // Print out packed bits matrix. ------------------------------------------
-/*
-    printf( "Packed bits matrix:\n" );
-    col_count = 0;
-    for( count = 0; count < packed_count; count++ )
+    fclose( fp );
+
+    /*
+        Kerning.
+
+        For each pair, find the narrowest gap between the right profile of
+        the left glyph and the left profile of the right glyph, looking at
+        neighbouring rows too so that diagonals don't touch. Where the gap
+        is at least 2 pixels wider than the normal spacing, e.g. "LT" or
+        "Te", the pair is tightened by at most kern_max pixels, leaving
+        1 pixel more than normal so that the result still looks even. Pairs with no rows in common, e.g. "T.", are left
+        alone as there is nothing to judge the gap by.
+    */
+    for ( l = 0; l < glyph_num && kern_max > 0; l++ )
     {
-        printf( "%d", packed[count] );
-        col_count++;
-        if ( col_count >= COLS_MAX )
+        if ( glyph[l].width == 0 ) continue;
+        for ( r = 0; r < glyph_num; r++ )
         {
-            printf( "\n" );
-            col_count = 0;
+            int16_t gap, gap_min = 0x7fff;
+            int16_t adjust;
+            int16_t j;
+
+            if ( glyph[r].width == 0 ) continue;
+            for ( row = 0; row < rows; row++ )
+            {
+                if ( glyph[r].left[row] < 0 ) continue;
+                for ( j = ( int16_t )row - 1; j <= row + 1; j++ )
+                {
+                    if (( j < 0 ) || ( j >= rows ) ||
+                        ( glyph[l].right[j] < 0 )) continue;
+                    gap = glyph[l].xadvance + glyph[r].left[row] -
+                          glyph[l].right[j] - 1;
+                    if ( gap < gap_min ) gap_min = gap;
+                }
+            }
+            if ( gap_min == 0x7fff ) continue;
+
+            adjust = ( int16_t )spacing + 1 - gap_min;
+            if ( adjust >= 0 ) continue;
+            if ( adjust < -( int16_t )kern_max ) adjust = -kern_max;
+
+            kerns[ kern_count ].left   = glyph[l].ascii;
+            kerns[ kern_count ].right  = glyph[r].ascii;
+            kerns[ kern_count ].adjust = adjust;
+            kern_count++;
         }
     }
-    printf( "\n\n" );
-*/
-    // Print some summary information. ----------------------------------------
-    printf( "Packed %d bytes into %d.\n",
-             ( glyph_bits * glyph_num ) / BITS_BYTE, packed_count / BITS_BYTE );
-    printf( "Saved %d bytes.\n",
-             ( glyph_bits * glyph_num - packed_count ) / BITS_BYTE );
-    printf( "\n\n" );
-
-    // Now turn packed bits into bytes. ---------------------------------------
-    uint16_t byte_count;
-    uint8_t  byte_value;
-    printf( "Hex Values:\n\n" );
-    for( byte_count = 0; byte_count < packed_count / BITS_BYTE; byte_count++ )
+
+    // Print summary. ---------------------------------------------------------
+    unpacked_count = glyph_num * glyph_height * glyph_width / BITS_BYTE;
+    fprintf( stderr, "Packed %u bytes of 1bpp edit boxes into %u bytes of "
+                     "4bpp strips, %d kerning pairs.\n",
+                     unpacked_count, packed_count, kern_count );
+
+    // Write header. ----------------------------------------------------------
+    printf( "/*\n    Font %s, generated by fontconvert from %s.\n*/\n\n",
+            name, input_file );
+    for ( i = 0; name[i] && i < sizeof( guard ) - 1; i++ )
+        guard[i] = toupper(( unsigned char )name[i] );
+    guard[i] = '\0';
+    printf( "#ifndef FONT_%s_H\n#define FONT_%s_H\n\n", guard, guard );
+    printf( "#include \"ssd1322-font.h\"\n\n" );
+
+    printf( "static const uint8_t font_%s_bitmap[] =\n{", name );
+    for ( g = 0; g < glyph_num; g++ )
     {
-        byte_value = 0;
-        printf( "\t" );
-        for( bit = 0; bit < BITS_BYTE; bit++ )
+        uint32_t end = glyph[g].offset + glyph[g].height *
+                       (( glyph[g].width + 1 ) / 2 );
+        uint32_t j;
+
+        printf( "\n    // '%c'", glyph[g].ascii );
+        for ( j = glyph[g].offset; j < end; j++ )
         {
-            byte_value += ( packed[byte_count * BITS_BYTE + bit] ) *
-                          ( 1 << ( BITS_BYTE - bit - 1 ));
-            packed_hex[byte_count] = byte_value;
-            printf( "%d", packed[byte_count * BITS_BYTE + bit] );
+            if (( j - glyph[g].offset ) % COLS_MAX == 0 ) printf( "\n    " );
+            printf( "0x%02x,", packed[j] );
         }
-        printf( " = 0x%02x\n", byte_value );
-
     }
-    printf( "\n" );
+    printf( "\n    0x00\n};\n\n" );
 
-    fclose( fp );
+    printf( "static const struct ssd1322_kern font_%s_kern[] =\n{\n", name );
+    for ( l = 0; l < kern_count; l++ )
+        printf( "    { %3d, %2d }, // '%c' '%c'\n", kerns[l].right,
+                kerns[l].adjust, kerns[l].left, kerns[l].right );
+    printf( "    {   0,  0 }\n};\n\n" );
+
+    printf( "static const struct ssd1322_glyph font_%s_glyphs[] =\n{\n", name );
+    for ( g = 0, l = 0; g < glyph_num; g++ )
+    {
+        uint16_t first = l;
+
+        while (( l < kern_count ) && ( kerns[l].left == glyph[g].ascii )) l++;
+        printf( "    { %5u, %2u, %2u, %2u, %2d, %3d, %4u, %2u }, // '%c'\n",
+                glyph[g].offset, glyph[g].width, glyph[g].height,
+                glyph[g].xadvance, glyph[g].xoffset, glyph[g].yoffset,
+                first, l - first, glyph[g].ascii );
+    }
+    printf( "};\n\n" );
+
+    printf( "static const struct ssd1322_font font_%s =\n{\n", name );
+    printf( "    .bitmap = font_%s_bitmap,\n", name );
+    printf( "    .glyph  = font_%s_glyphs,\n", name );
+    printf( "    .kern   = font_%s_kern,\n", name );
+    printf( "    .first  = %u,\n", glyph_start );
+    printf( "    .last   = %u,\n", glyph_end );
+    printf( "    .height = %u,\n", rows );
+    printf( "    .ascent = %u\n", glyph_base / scale );
+    printf( "};\n\n#endif\n" );
+
+    free( packed );
+    free( kerns );
 
     return 0;
 }
@@ -0,0 +1,282 @@
+//============================================================================
+/*
+    Converts greyscale images to a C header of run length encoded 4bpp
+    images for the SSD1322 display (see ssd1322-image.h).
+
+    Compile with:
+
+        gcc imageconvert.c -Wall -o imageconvert
+
+    Usage:
+
+        imageconvert [options] file... > image-<name>.h
+
+        -n name     Image name used for C identifiers (default image).
+        -r WxH      Input is raw, one byte per pixel with greys 0-15, as in
+                    graphics.h. Otherwise input is a binary (P5) PGM.
+
+    A single file gives one image, image_<name>. Several files give an
+    array of frames, image_<name>[], e.g. for an animation.
+*/
+//=============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+
+#include "../old/ssd1322-image.h"
+
+#define COLS_MAX 16 // Used for formatting hex output.
+
+struct image
+{
+    uint8_t  *pixels;   // One grey (0-15) per byte.
+    uint16_t  width;
+    uint16_t  height;
+    uint8_t  *encoded;
+    uint32_t  size;
+};
+
+//=============================================================================
+/*
+    Reads a binary PGM, scaling greys to 4 bits.
+*/
+//=============================================================================
+bool read_pgm( FILE *fp, struct image *image )
+{
+    unsigned int width, height, maxval;
+    uint32_t i;
+    int c;
+
+    if ( fscanf( fp, "P5 %u %u %u", &width, &height, &maxval ) != 3 )
+        return false;
+    fgetc( fp ); // Single whitespace before data.
+    if (( maxval == 0 ) || ( maxval > 255 )) return false;
+
+    image->width  = width;
+    image->height = height;
+    image->pixels = malloc( width * height );
+    if ( image->pixels == NULL ) return false;
+
+    for ( i = 0; i < width * height; i++ )
+    {
+        if (( c = fgetc( fp )) == EOF ) return false;
+        image->pixels[i] = ( c * 15 + maxval / 2 ) / maxval;
+    }
+    return true;
+}
+
+//=============================================================================
+/*
+    Reads raw pixels, one grey (0-15) per byte.
+*/
+//=============================================================================
+bool read_raw( FILE *fp, struct image *image, uint16_t width, uint16_t height )
+{
+    uint32_t count = ( uint32_t )width * height;
+
+    image->width  = width;
+    image->height = height;
+    image->pixels = malloc( count );
+    if ( image->pixels == NULL ) return false;
+
+    return fread( image->pixels, 1, count, fp ) == count;
+}
+
+//=============================================================================
+/*
+    Packs and encodes each row of an image.
+*/
+//=============================================================================
+void encode_image( struct image *image )
+{
+    uint16_t stride = ( image->width + 1 ) / 2;
+    uint8_t  row[256];
+    uint16_t x, y, i, n, lit;
+    uint8_t *out;
+
+    // Worst case is one literal byte per 128 bytes.
+    out = image->encoded = malloc( image->height * ( stride + stride / 128 + 1 ));
+    if ( out == NULL ) return;
+
+    for ( y = 0; y < image->height; y++ )
+    {
+        const uint8_t *src = &image->pixels[ y * image->width ];
+
+        for ( x = 0; x < stride; x++ )
+        {
+            row[x] = ( src[ x * 2 ] & 0x0f ) << 4;
+            if ( x * 2 + 1 < image->width ) row[x] |= src[ x * 2 + 1 ] & 0x0f;
+        }
+
+        // Runs of 3 or more bytes are cheaper as runs, the rest as literals.
+        i = 0;
+        lit = 0;
+        while ( i < stride )
+        {
+            n = 1;
+            while (( i + n < stride ) && ( row[ i + n ] == row[i] ) &&
+                   ( n < SSD1322_RLE_RUN_MAX )) n++;
+
+            if ( n >= SSD1322_RLE_RUN_MIN )
+            {
+                if ( lit > 0 )
+                {
+                    *out++ = lit - 1;
+                    memcpy( out, &row[ i - lit ], lit );
+                    out += lit;
+                    lit = 0;
+                }
+                *out++ = SSD1322_RLE_RUN | ( n - SSD1322_RLE_RUN_MIN );
+                *out++ = row[i];
+                i += n;
+                continue;
+            }
+
+            lit++;
+            i++;
+            if (( lit == SSD1322_RLE_LIT_MAX ) || ( i == stride ))
+            {
+                *out++ = lit - 1;
+                memcpy( out, &row[ i - lit ], lit );
+                out += lit;
+                lit = 0;
+            }
+        }
+    }
+    image->size = out - image->encoded;
+}
+
+//=============================================================================
+/*
+    Prints an image's encoded data.
+*/
+//=============================================================================
+void print_data( struct image *image, const char *name, uint16_t frame,
+                 bool frames )
+{
+    uint32_t i;
+
+    if ( frames ) printf( "static const uint8_t image_%s_data%u[] =\n{", name,
+                          frame );
+    else          printf( "static const uint8_t image_%s_data[] =\n{", name );
+    for ( i = 0; i < image->size; i++ )
+    {
+        if ( i % COLS_MAX == 0 ) printf( "\n    " );
+        printf( "0x%02x,", image->encoded[i] );
+    }
+    printf( "\n};\n\n" );
+}
+
+//=============================================================================
+/*
+    Main.
+*/
+//=============================================================================
+int main( int argc, char *argv[] )
+{
+    char    *name = "image";
+    bool     raw  = false;
+    unsigned int raw_width = 0, raw_height = 0;
+    struct image *image;
+    uint16_t count, i;
+    uint32_t unpacked = 0, packed = 0;
+    bool     frames;
+    FILE    *fp;
+    int      opt;
+    char     guard[32]; // Include guard.
+
+    while (( opt = getopt( argc, argv, "n:r:" )) != -1 )
+    {
+        switch ( opt )
+        {
+            case 'n': name = optarg; break;
+            case 'r':
+                raw = true;
+                if ( sscanf( optarg, "%ux%u", &raw_width, &raw_height ) != 2 )
+                {
+                    fprintf( stderr, "Bad raw size %s.\n", optarg );
+                    exit( EXIT_FAILURE );
+                }
+                break;
+            default:
+                fprintf( stderr, "See imageconvert.c for options.\n" );
+                exit( EXIT_FAILURE );
+        }
+    }
+
+    count = argc - optind;
+    if ( count == 0 )
+    {
+        fprintf( stderr, "No input files.\n" );
+        exit( EXIT_FAILURE );
+    }
+    frames = ( count > 1 );
+
+    image = calloc( count, sizeof( struct image ));
+    if ( image == NULL ) exit( EXIT_FAILURE );
+
+    for ( i = 0; i < count; i++ )
+    {
+        bool ok;
+
+        fp = fopen( argv[ optind + i ], "rb" );
+        if ( fp == NULL )
+        {
+            perror( argv[ optind + i ] );
+            exit( EXIT_FAILURE );
+        }
+        ok = raw ? read_raw( fp, &image[i], raw_width, raw_height ) :
+                   read_pgm( fp, &image[i] );
+        fclose( fp );
+        if ( !ok || ( image[i].width > 256 ) || ( image[i].height > 255 ))
+        {
+            fprintf( stderr, "Couldn't read %s.\n", argv[ optind + i ] );
+            exit( EXIT_FAILURE );
+        }
+
+        encode_image( &image[i] );
+        if ( image[i].encoded == NULL ) exit( EXIT_FAILURE );
+        unpacked += image[i].width * image[i].height;
+        packed   += image[i].size;
+    }
+
+    fprintf( stderr, "Encoded %u bytes of 8bpp pixels into %u bytes.\n",
+             unpacked, packed );
+
+    // Write header. ----------------------------------------------------------
+    printf( "/*\n    Image %s, generated by imageconvert.\n*/\n\n", name );
+    for ( i = 0; name[i] && i < sizeof( guard ) - 1; i++ )
+        guard[i] = toupper(( unsigned char )name[i] );
+    guard[i] = '\0';
+    printf( "#ifndef IMAGE_%s_H\n#define IMAGE_%s_H\n\n", guard, guard );
+    printf( "#include \"ssd1322-image.h\"\n\n" );
+
+    for ( i = 0; i < count; i++ ) print_data( &image[i], name, i, frames );
+
+    if ( frames ) printf( "static const struct ssd1322_image image_%s[] =\n{\n",
+                          name );
+    else          printf( "static const struct ssd1322_image image_%s =\n",
+                          name );
+    for ( i = 0; i < count; i++ )
+    {
+        if ( frames )
+            printf( "    { image_%s_data%u, %u, %u, %u },\n", name, i,
+                    image[i].size, image[i].width, image[i].height );
+        else
+            printf( "    { image_%s_data, %u, %u, %u };\n", name,
+                    image[i].size, image[i].width, image[i].height );
+        free( image[i].pixels );
+        free( image[i].encoded );
+    }
+    if ( frames ) printf( "};\n" );
+    printf( "\n#endif\n" );
+
+    free( image );
+
+    return 0;
+}
@@ -0,0 +1,451 @@
+/*
+//  ===========================================================================
+
+    gpioPi:
+
+    Direct register GPIO and parallel bus library for the Raspberry Pi.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    Based on the following guides and codes:
+        Broadcom BCM2835 ARM Peripherals, Reference C6357-M-1398.
+        - see https://www.raspberrypi.org/wp-content/uploads/2012/02/
+              BCM2835-ARM-Peripherals.pdf
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+
+    Compile with:
+
+        gcc -c -fpic -Wall gpioPi.c ../boardPi/boardPi.c
+
+    Also use the following flags for Raspberry Pi optimisation:
+
+        -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
+        -ffast-math -pipe -O3
+
+//  ---------------------------------------------------------------------------
+
+    Authors:        D.Faulke    18/01/2016
+
+    Contributors:
+
+    Changelog:
+
+        v1.00   Original version.
+        v1.01   Added sysfs pins with persistent value files and poll().
+        v1.02   Peripheral base from boardPi.
+        v1.03   Renamed gpioWrite, gpioRead and gpioDelay to gpioPinsWrite,
+                gpioPinsRead and gpioDelayNs to avoid clashing with pigpio.
+        v1.04   gpioSysWait rejects a count of 0 or more than GPIO_SYS_WAIT_MAX.
+
+//  ---------------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <poll.h>
+#include <errno.h>
+
+#include "../boardPi/boardPi.h"
+#include "gpioPi.h"
+
+
+//  Registers. ----------------------------------------------------------------
+
+    // GPIO and system timer registers, or NULL if not mapped.
+    static volatile uint32_t *gpio  = NULL;
+    static volatile uint32_t *timer = NULL;
+
+    // Spin loop iterations per uS, calibrated by gpioMap.
+    static uint32_t loopsUs = 1;
+
+
+//  GPIO functions. -----------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Maps a block of registers. Returns NULL if not mapped.
+//  ---------------------------------------------------------------------------
+static volatile uint32_t *mapRegisters( const char *device, off_t offset,
+                                        size_t length )
+{
+    void *map;
+    int   fd;
+
+    fd = open( device, O_RDWR | O_SYNC );
+    if ( fd < 0 ) return NULL;
+    map = mmap( NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset );
+    close( fd );
+    if ( map == MAP_FAILED ) return NULL;
+
+    return (volatile uint32_t *) map;
+};
+
+//  ---------------------------------------------------------------------------
+//  Spins for a number of loop iterations.
+//  ---------------------------------------------------------------------------
+static void spin( uint32_t loops )
+{
+    volatile uint32_t i;
+
+    for ( i = 0; i < loops; i++ );
+};
+
+//  ---------------------------------------------------------------------------
+//  Calibrates the spin loop against the system timer or clock.
+//  ---------------------------------------------------------------------------
+/*
+    The fastest of several runs is used, since the first may be slowed by
+    the CPU clock ramping up, so that delays are never short.
+*/
+static void calibrate( void )
+{
+    const uint32_t loops = 100000;
+    struct timespec start, end;
+    uint32_t t0, us, rate;
+    uint8_t  i;
+
+    loopsUs = 1;
+    for ( i = 0; i < 4; i++ )
+    {
+        if ( timer != NULL )
+        {
+            t0 = timer[GPIO_TIMER_CLO];
+            spin( loops );
+            us = timer[GPIO_TIMER_CLO] - t0;
+        }
+        else
+        {
+            clock_gettime( CLOCK_MONOTONIC, &start );
+            spin( loops );
+            clock_gettime( CLOCK_MONOTONIC, &end );
+            us = ( end.tv_sec - start.tv_sec ) * 1000000 +
+                 ( end.tv_nsec - start.tv_nsec ) / 1000;
+        }
+        rate = ( us == 0 ) ? loops : ( loops + us - 1 ) / us;
+        if ( rate > loopsUs ) loopsUs = rate;
+    }
+};
+
+//  ---------------------------------------------------------------------------
+//  Maps GPIO and timer registers. Returns -1 if GPIOs couldn't be mapped.
+//  ---------------------------------------------------------------------------
+int8_t gpioMap( void )
+{
+    const struct boardStruct *board;
+
+    if ( gpio != NULL ) return 0;
+
+    board = boardInfo();
+
+    gpio = mapRegisters( GPIO_MEMORY, 0, GPIO_LENGTH );
+    if (( gpio == NULL ) &&
+        ( GPIO_OFFSET + GPIO_LENGTH <= board->periSize ))
+        gpio = mapRegisters( GPIO_MEMORY_ALL, board->periBase + GPIO_OFFSET,
+                             GPIO_LENGTH );
+    if ( gpio == NULL ) return -1;
+
+    // Optional, only used to calibrate and time delays.
+    if ( GPIO_TIMER_OFFSET + GPIO_TIMER_LENGTH <= board->periSize )
+        timer = mapRegisters( GPIO_MEMORY_ALL,
+                              board->periBase + GPIO_TIMER_OFFSET,
+                              GPIO_TIMER_LENGTH );
+    calibrate();
+
+    return 0;
+};
+
+//  ---------------------------------------------------------------------------
+//  Unmaps registers.
+//  ---------------------------------------------------------------------------
+void gpioUnmap( void )
+{
+    if ( gpio != NULL ) munmap( (void *) gpio, GPIO_LENGTH );
+    if ( timer != NULL ) munmap( (void *) timer, GPIO_TIMER_LENGTH );
+    gpio  = NULL;
+    timer = NULL;
+};
+
+//  ---------------------------------------------------------------------------
+//  Sets a pin function (GPIO_INPUT or GPIO_OUTPUT).
+//  ---------------------------------------------------------------------------
+/*
+    Each GPFSEL register holds 3 bits for each of 10 pins.
+*/
+void gpioFsel( uint8_t pin, uint8_t mode )
+{
+    volatile uint32_t *fsel = &gpio[ GPIO_GPFSEL0 + pin / 10 ];
+    uint8_t shift = ( pin % 10 ) * 3;
+
+    *fsel = ( *fsel & ~( 7 << shift )) | (( mode & 7 ) << shift );
+};
+
+//  ---------------------------------------------------------------------------
+//  Clears pins in clear mask and sets pins in set mask.
+//  ---------------------------------------------------------------------------
+void gpioPinsWrite( uint32_t set, uint32_t clear )
+{
+    gpio[GPIO_GPCLR0] = clear;
+    gpio[GPIO_GPSET0] = set;
+};
+
+//  ---------------------------------------------------------------------------
+//  Returns the levels of pins 0-31.
+//  ---------------------------------------------------------------------------
+uint32_t gpioPinsRead( void )
+{
+    return gpio[GPIO_GPLEV0];
+};
+
+//  ---------------------------------------------------------------------------
+//  Waits for at least ns nanoseconds.
+//  ---------------------------------------------------------------------------
+/*
+    The timer may tick just after it is read so waits for an extra tick.
+*/
+void gpioDelayNs( uint32_t ns )
+{
+    uint32_t start, ticks;
+
+    if ( ns == 0 ) return;
+    if (( timer != NULL ) && ( ns >= GPIO_DELAY_TIMER ))
+    {
+        ticks = ( ns + 999 ) / 1000 + 1;
+        start = timer[GPIO_TIMER_CLO];
+        while ( timer[GPIO_TIMER_CLO] - start < ticks );
+        return;
+    }
+    spin(( uint64_t ) ns * loopsUs / 1000 + 1 );
+};
+
+
+//  Bus functions. ------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Sets up bus masks and makes the pins outputs. Returns -1 if invalid.
+//  ---------------------------------------------------------------------------
+int8_t gpioBusInit( struct gpioBus *bus )
+{
+    uint16_t value;
+    uint8_t  i;
+
+    if (( gpio == NULL ) || ( bus->width == 0 ) ||
+        ( bus->width > GPIO_BUS_WIDTH_MAX ) || ( bus->strobe >= GPIO_PINS ))
+        return -1;
+    for ( i = 0; i < bus->width; i++ )
+        if ( bus->db[i] >= GPIO_PINS ) return -1;
+
+    bus->mask = 0;
+    for ( i = 0; i < bus->width; i++ )
+        bus->mask |= 1 << bus->db[i];
+
+    // Bits above the bus width are ignored.
+    for ( value = 0; value < ( 1 << GPIO_BUS_WIDTH_MAX ); value++ )
+    {
+        bus->bits[value] = 0;
+        for ( i = 0; i < bus->width; i++ )
+            if ( value & ( 1 << i ))
+                bus->bits[value] |= 1 << bus->db[i];
+    }
+
+    gpioPinsWrite( 0, bus->mask | ( 1 << bus->strobe ));
+    for ( i = 0; i < bus->width; i++ )
+        gpioFsel( bus->db[i], GPIO_OUTPUT );
+    gpioFsel( bus->strobe, GPIO_OUTPUT );
+
+    return 0;
+};
+
+//  ---------------------------------------------------------------------------
+//  Puts a value on the data pins along with other pins to set and clear.
+//  ---------------------------------------------------------------------------
+void gpioBusPut( struct gpioBus *bus, uint8_t value,
+                 uint32_t set, uint32_t clear )
+{
+    uint32_t bits = bus->bits[value];
+
+    gpioPinsWrite( bits | set, ( bus->mask & ~bits ) | clear );
+};
+
+//  ---------------------------------------------------------------------------
+//  Pulses the strobe pin.
+//  ---------------------------------------------------------------------------
+void gpioBusStrobe( struct gpioBus *bus )
+{
+    gpio[GPIO_GPSET0] = 1 << bus->strobe;
+    gpioDelayNs( bus->pulse );
+    gpio[GPIO_GPCLR0] = 1 << bus->strobe;
+    gpioDelayNs( bus->hold );
+};
+
+//  ---------------------------------------------------------------------------
+//  Puts a value on the bus and strobes it.
+//  ---------------------------------------------------------------------------
+void gpioBusWrite( struct gpioBus *bus, uint8_t value,
+                   uint32_t set, uint32_t clear )
+{
+    gpioBusPut( bus, value, set, clear );
+    gpioDelayNs( bus->setup );
+    gpioBusStrobe( bus );
+};
+
+
+//  Sysfs functions. ----------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Writes a string to a sysfs file. Returns -1 if not written.
+//  ---------------------------------------------------------------------------
+/*
+    udev may still be setting permissions on a newly exported pin, so
+    opening is retried for a short while.
+*/
+static int8_t sysWrite( const char *path, const char *string )
+{
+    uint8_t retries = GPIO_SYS_RETRIES;
+    ssize_t len = strlen( string );
+    int     fd;
+
+    while ((( fd = open( path, O_WRONLY )) < 0 ) && ( errno == EACCES ) &&
+           ( retries-- > 0 ))
+        usleep( GPIO_SYS_RETRY_DELAY );
+    if ( fd < 0 ) return -1;
+
+    if ( write( fd, string, len ) != len )
+    {
+        close( fd );
+        return -1;
+    }
+    close( fd );
+
+    return 0;
+};
+
+//  ---------------------------------------------------------------------------
+//  Exports a pin, sets direction and edge and opens value. Returns -1 if not.
+//  ---------------------------------------------------------------------------
+int8_t gpioSysOpen( struct gpioSys *sys, uint8_t pin, uint8_t mode,
+                    uint8_t edge )
+{
+    static const char *edges[] = { "none", "rising", "falling", "both" };
+    char path[GPIO_SYS_PATH_MAX];
+    char number[4];
+    uint8_t retries = GPIO_SYS_RETRIES;
+
+    sys->pin   = pin;
+    sys->fd    = -1;
+    sys->event = false;
+
+    // Already exported pins fail with EBUSY, which is fine.
+    snprintf( number, sizeof( number ), "%u", pin );
+    if (( sysWrite( GPIO_SYS_PATH "/export", number ) < 0 ) &&
+        ( errno != EBUSY ))
+        return -1;
+
+    snprintf( path, sizeof( path ), GPIO_SYS_PATH "/gpio%u/direction", pin );
+    if ( sysWrite( path, ( mode == GPIO_OUTPUT ) ? "out" : "in" ) < 0 )
+        return -1;
+
+    if ( mode == GPIO_INPUT )
+    {
+        snprintf( path, sizeof( path ), GPIO_SYS_PATH "/gpio%u/edge", pin );
+        if ( sysWrite( path, edges[ edge & 3 ] ) < 0 ) return -1;
+    }
+
+    snprintf( path, sizeof( path ), GPIO_SYS_PATH "/gpio%u/value", pin );
+    while ((( sys->fd = open( path, O_RDWR )) < 0 ) && ( errno == EACCES ) &&
+           ( retries-- > 0 ))
+        usleep( GPIO_SYS_RETRY_DELAY );
+    if ( sys->fd < 0 ) return -1;
+
+    // Initial read clears any edge flagged before now.
+    return ( gpioSysRead( sys ) < 0 ) ? -1 : 0;
+};
+
+//  ---------------------------------------------------------------------------
+//  Closes value and unexports a pin.
+//  ---------------------------------------------------------------------------
+void gpioSysClose( struct gpioSys *sys )
+{
+    char number[4];
+
+    if ( sys->fd >= 0 ) close( sys->fd );
+    sys->fd = -1;
+
+    snprintf( number, sizeof( number ), "%u", sys->pin );
+    sysWrite( GPIO_SYS_PATH "/unexport", number );
+};
+
+//  ---------------------------------------------------------------------------
+//  Returns the level of a pin, or -1 if it couldn't be read.
+//  ---------------------------------------------------------------------------
+int8_t gpioSysRead( struct gpioSys *sys )
+{
+    char c;
+
+    if ( pread( sys->fd, &c, 1, 0 ) != 1 ) return -1;
+    sys->value = ( c == '1' );
+
+    return sys->value;
+};
+
+//  ---------------------------------------------------------------------------
+//  Sets the level of a pin. Returns -1 if it couldn't be written.
+//  ---------------------------------------------------------------------------
+int8_t gpioSysWrite( struct gpioSys *sys, uint8_t value )
+{
+    if ( pwrite( sys->fd, value ? "1" : "0", 1, 0 ) != 1 ) return -1;
+    sys->value = ( value != 0 );
+
+    return 0;
+};
+
+//  ---------------------------------------------------------------------------
+//  Waits for edges on any of a set of pins.
+//  ---------------------------------------------------------------------------
+int gpioSysWait( struct gpioSys *sys, uint8_t count, int timeout )
+{
+    struct pollfd fds[GPIO_SYS_WAIT_MAX];
+    uint8_t i;
+    int     ready;
+
+    if (( count == 0 ) || ( count > GPIO_SYS_WAIT_MAX )) return -1;
+
+    for ( i = 0; i < count; i++ )
+    {
+        fds[i].fd      = sys[i].fd;
+        fds[i].events  = POLLPRI | POLLERR;
+        fds[i].revents = 0;
+        sys[i].event   = false;
+    }
+
+    ready = poll( fds, count, timeout );
+    if ( ready <= 0 ) return ready;
+
+    for ( i = 0; i < count; i++ )
+        if ( fds[i].revents & ( POLLPRI | POLLERR ))
+        {
+            sys[i].event = true;
+            gpioSysRead( &sys[i] );
+        }
+
+    return ready;
+};
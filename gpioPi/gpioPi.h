@@ -0,0 +1,245 @@
+/*
+//  ===========================================================================
+
+    gpioPi:
+
+    Direct register GPIO and parallel bus library for the Raspberry Pi.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+
+    Authors:        D.Faulke    18/01/2016
+
+    Contributors:
+
+//  Information. --------------------------------------------------------------
+
+    The GPIO registers are mapped once and shared by every bus. Pins are
+    written through GPSET0 and GPCLR0, which only act on the bits set in
+    the written word, so any combination of pins 0-31 can be changed with
+    one write to each register and without reading back.
+
+    A bus is a set of data pins and a strobe pin, such as the data lines
+    and E of an LCD controller. gpioBusInit() works out the mask of all of
+    the data pins and the GPSET0 bits for every value the bus can carry,
+    so a value goes out as:
+
+        GPCLR0 = data pins that are 0 | any control pins to clear.
+        GPSET0 = data pins that are 1 | any control pins to set.
+
+    followed by the strobe pulse. Control lines such as RS can be carried
+    in the same two writes.
+
+    Timing is given in nanoseconds. The system timer only counts in uS, so
+    a spin loop is calibrated against it in gpioMap() and used for short
+    delays. Longer delays poll the timer. The system timer needs /dev/mem,
+    so without root the loop is calibrated with clock_gettime() instead.
+
+    The peripheral base and size come from boardPi. They are only needed
+    for /dev/mem since /dev/gpiomem always maps the GPIOs at offset 0.
+
+//  ---------------------------------------------------------------------------
+
+    Where the registers can't be mapped, pins can be used through sysfs:
+
+        /sys/class/gpio/export          Write pin number to create gpioN.
+        /sys/class/gpio/gpioN/direction "in" or "out".
+        /sys/class/gpio/gpioN/edge      "none", "rising", "falling", "both".
+        /sys/class/gpio/gpioN/value     "0" or "1".
+
+    The value file is opened once and kept open. It is read with pread()
+    at offset 0 and written with pwrite(), so each access is one system
+    call. When an edge is set, the kernel flags the value file with POLLPRI
+    as the edge happens, so any number of inputs can be waited on together
+    with one poll() in one thread. Reading the value clears the flag.
+*/
+
+//  Macros. -------------------------------------------------------------------
+
+#ifndef GPIOPI_H
+#define GPIOPI_H
+
+#define GPIOPI_VERSION 0104
+
+// Register blocks, as offsets from the peripheral base.
+#define GPIO_MEMORY   "/dev/gpiomem" // GPIO registers, mappable without root.
+#define GPIO_MEMORY_ALL   "/dev/mem" // All physical memory, needs root.
+#define GPIO_OFFSET      0x200000 // GPIO registers.
+#define GPIO_LENGTH          0xb4 // Size of GPIO register block (bytes).
+#define GPIO_TIMER_OFFSET  0x3000 // System timer.
+#define GPIO_TIMER_LENGTH    0x1c // Size of system timer block (bytes).
+
+// GPIO registers, as 32-bit word offsets from the GPIO base.
+#define GPIO_GPFSEL0         0x00 // GPIO function select 0 (0x00).
+#define GPIO_GPSET0          0x07 // GPIO pin output set 0 (0x1c).
+#define GPIO_GPCLR0          0x0a // GPIO pin output clear 0 (0x28).
+#define GPIO_GPLEV0          0x0d // GPIO pin level 0 (0x34).
+
+// System timer registers, as 32-bit word offsets from the timer base.
+#define GPIO_TIMER_CLO       0x01 // Free running 1MHz counter, low word.
+
+// Pin functions.
+#define GPIO_INPUT              0
+#define GPIO_OUTPUT             1
+
+// Bus limits.
+#define GPIO_PINS              32 // Pins reachable with GPSET0/GPCLR0.
+#define GPIO_BUS_WIDTH_MAX      8 // Max data pins on a bus.
+
+// Delays at least this long poll the system timer (nS).
+#define GPIO_DELAY_TIMER     2000
+
+// Sysfs.
+#define GPIO_SYS_PATH "/sys/class/gpio" // Sysfs GPIO directory.
+#define GPIO_SYS_PATH_MAX          48 // Max length of a sysfs path.
+#define GPIO_SYS_RETRIES           20 // Waits for udev to set permissions.
+#define GPIO_SYS_RETRY_DELAY    10000 // Wait between retries (uS).
+#define GPIO_SYS_WAIT_MAX     GPIO_PINS // Max pins for gpioSysWait.
+
+// Sysfs edges.
+#define GPIO_EDGE_NONE              0
+#define GPIO_EDGE_RISING            1
+#define GPIO_EDGE_FALLING           2
+#define GPIO_EDGE_BOTH              3
+
+//  Data structures. ----------------------------------------------------------
+
+struct gpioBus
+{
+    uint8_t  width;                         // Number of data pins.
+    uint8_t  db[GPIO_BUS_WIDTH_MAX];        // GPIOs for data bits, bit 0 first.
+    uint8_t  strobe;                        // GPIO for strobe, e.g. E.
+    uint16_t setup;                         // Data set up before strobe (nS).
+    uint16_t pulse;                         // Strobe pulse width (nS).
+    uint16_t hold;                          // Data hold after strobe (nS).
+    uint32_t mask;                          // All data pins.
+    uint32_t bits[1 << GPIO_BUS_WIDTH_MAX]; // Data pins set for each value.
+};
+/*
+    width, db, strobe and the timings are set by the caller. mask and bits
+    are filled in by gpioBusInit(). The strobe is active high and data is
+    latched as it falls.
+*/
+
+struct gpioSys
+{
+    uint8_t pin;    // GPIO number.
+    int     fd;     // Value file, kept open.
+    uint8_t value;  // Level at the last read or wait.
+    bool    event;  // Set by gpioSysWait if an edge happened.
+};
+
+//  GPIO functions. -----------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Maps GPIO and timer registers. Returns -1 if GPIOs couldn't be mapped.
+//  ---------------------------------------------------------------------------
+/*
+    Only maps once, so can be called by each driver that uses it.
+*/
+int8_t gpioMap( void );
+
+//  ---------------------------------------------------------------------------
+//  Unmaps registers.
+//  ---------------------------------------------------------------------------
+void gpioUnmap( void );
+
+//  ---------------------------------------------------------------------------
+//  Sets a pin function (GPIO_INPUT or GPIO_OUTPUT).
+//  ---------------------------------------------------------------------------
+void gpioFsel( uint8_t pin, uint8_t mode );
+
+//  ---------------------------------------------------------------------------
+//  Clears pins in clear mask and sets pins in set mask.
+//  ---------------------------------------------------------------------------
+void gpioPinsWrite( uint32_t set, uint32_t clear );
+
+//  ---------------------------------------------------------------------------
+//  Returns the levels of pins 0-31.
+//  ---------------------------------------------------------------------------
+uint32_t gpioPinsRead( void );
+
+//  ---------------------------------------------------------------------------
+//  Waits for at least ns nanoseconds.
+//  ---------------------------------------------------------------------------
+void gpioDelayNs( uint32_t ns );
+
+//  Bus functions. ------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Sets up bus masks and makes the pins outputs. Returns -1 if invalid.
+//  ---------------------------------------------------------------------------
+/*
+    gpioMap() must have been called. All pins must be GPIOs 0-31.
+*/
+int8_t gpioBusInit( struct gpioBus *bus );
+
+//  ---------------------------------------------------------------------------
+//  Puts a value on the data pins along with other pins to set and clear.
+//  ---------------------------------------------------------------------------
+void gpioBusPut( struct gpioBus *bus, uint8_t value,
+                 uint32_t set, uint32_t clear );
+
+//  ---------------------------------------------------------------------------
+//  Pulses the strobe pin.
+//  ---------------------------------------------------------------------------
+void gpioBusStrobe( struct gpioBus *bus );
+
+//  ---------------------------------------------------------------------------
+//  Puts a value on the bus and strobes it.
+//  ---------------------------------------------------------------------------
+void gpioBusWrite( struct gpioBus *bus, uint8_t value,
+                   uint32_t set, uint32_t clear );
+
+//  Sysfs functions. ----------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Exports a pin, sets direction and edge and opens value. Returns -1 if not.
+//  ---------------------------------------------------------------------------
+/*
+    mode is GPIO_INPUT or GPIO_OUTPUT, edge is one of GPIO_EDGE_x and is
+    only set for inputs.
+*/
+int8_t gpioSysOpen( struct gpioSys *sys, uint8_t pin, uint8_t mode,
+                    uint8_t edge );
+
+//  ---------------------------------------------------------------------------
+//  Closes value and unexports a pin.
+//  ---------------------------------------------------------------------------
+void gpioSysClose( struct gpioSys *sys );
+
+//  ---------------------------------------------------------------------------
+//  Returns the level of a pin, or -1 if it couldn't be read.
+//  ---------------------------------------------------------------------------
+int8_t gpioSysRead( struct gpioSys *sys );
+
+//  ---------------------------------------------------------------------------
+//  Sets the level of a pin. Returns -1 if it couldn't be written.
+//  ---------------------------------------------------------------------------
+int8_t gpioSysWrite( struct gpioSys *sys, uint8_t value );
+
+//  ---------------------------------------------------------------------------
+//  Waits for edges on any of a set of pins.
+//  ---------------------------------------------------------------------------
+/*
+    timeout is in mS, or -1 to wait indefinitely. Returns the number of
+    pins with edges, 0 on time out or -1 on error or if count isn't 1 to
+    GPIO_SYS_WAIT_MAX. Pins with edges have event set and value updated.
+*/
+int gpioSysWait( struct gpioSys *sys, uint8_t count, int timeout );
+
+#endif
@@ -1,129 +1,77 @@
-#include <sys/stat.h>
-#include <sys/types.h>
-#include <fcntl.h>
+/*
+    testSysPi:
+
+    Tests sysfs GPIOs through gpioPi. Toggles an output and then reports
+    edges on two inputs from a single poll() loop.
+
+    Compile with:
+
+        gcc testSysPi.c gpioPi.c ../boardPi/boardPi.c -Wall -o testSysPi
+*/
+
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
-#include <string.h>
 #include <unistd.h>
 
-#define IN  0
-#define OUT 1
+#include "gpioPi.h"
 
 #define LOW  0
 #define HIGH 1
 
 #define POUT    4   /* P1-07 */
-#define BUFFER_MAX  3
-#define DIRECTION_MAX   48
-
-static int GPIOExport( int pin )
-{
-    char buffer[ BUFFER_MAX ];
-    int len;
-    int fd;
-
-    fd = open( "/sys/class/gpio/export", O_WRONLY );
-    if ( fd < 0 )
-    {
-        fprintf( stderr, "Failed to open export for writing!\n" );
-        return( -1 );
-    }
+#define PIN1   17   /* P1-11 */
+#define PIN2   27   /* P1-13 */
 
-    len = snprintf( buffer, BUFFER_MAX, "%d", pin );
-    write( fd, buffer, len );
+#define REPEAT 10  // Output toggles.
+#define EVENTS 20  // Input edges to report.
 
-    close( fd );
-    return( 0 );
-}
-
-static int GPIOUnexport( int pin )
+int main( void )
 {
-    char buffer[ BUFFER_MAX ];
-    int len;
-    int fd;
+    struct gpioSys out, in[2];
+    uint8_t i;
+    int     ready;
 
-    fd = open( "/sys/class/gpio/unexport", O_WRONLY );
-    if ( fd < 0 )
+    if ( gpioSysOpen( &out, POUT, GPIO_OUTPUT, GPIO_EDGE_NONE ) < 0 )
     {
-        fprintf( stderr, "Failed to open unexport for writing!\n" );
-        return( -1 );
+        fprintf( stderr, "Failed to open GPIO %u!\n", POUT );
+        return -1;
     }
-
-    len = snprintf( buffer, BUFFER_MAX, "%d", pin );
-    write( fd, buffer, len );
-
-    close( fd );
-    return( 0 );
-}
-
-static int GPIODirection( int pin, int dir )
-{
-    static const char dir_str[]  = "in\0out";
-    char path[ DIRECTION_MAX ];
-    int fd;
-
-    snprintf( path, DIRECTION_MAX, "/sys/class/gpio/gpio%d/direction", pin );
-    fd = open( path, O_WRONLY );
-    if ( fd < 0 )
+    for ( i = 0; i < REPEAT; i++ )
     {
-        fprintf( stderr, "failed to open gpio direction for writing!\n" );
-        return( -1 );
+        gpioSysWrite( &out, ( i % 2 == 0 ) ? HIGH : LOW );
+        printf( "GPIO %u set to %u.\n", POUT, out.value );
+        usleep( 500000 );
     }
+    gpioSysClose( &out );
 
-    if ( write( fd, &dir_str[ dir == IN ? 0 : 3 ], dir == IN ? 2 : 3 ) < 0 )
+    if ( gpioSysOpen( &in[0], PIN1, GPIO_INPUT, GPIO_EDGE_BOTH ) < 0 )
     {
-        fprintf( stderr, "failed to set direction!\n" );
-        return( -1 );
+        fprintf( stderr, "Failed to open GPIO %u!\n", PIN1 );
+        return -1;
     }
-
-    close( fd );
-    return( 0 );
-}
-
-static int GPIORead( int pin )
-{
-    char path[ DIRECTION_MAX ];
-    char value_str[ 3 ];
-    int fd;
-
-    snprintf( path, DIRECTION_MAX, "/sys/class/gpio/gpio%d/value", pin );
-    fd = open( path, O_RDONLY );
-    if ( fd < 0 )
-    {
-        fprintf( stderr, "failed to open gpio value for reading!\n" );
-        return( -1 );
-    }
-
-    if ( read( fd, value_str, 3 ) < 0 )
+    if ( gpioSysOpen( &in[1], PIN2, GPIO_INPUT, GPIO_EDGE_BOTH ) < 0 )
     {
-        fprintf( stderr, "failed to read value!\n" );
-        return( -1 );
+        fprintf( stderr, "Failed to open GPIO %u!\n", PIN2 );
+        gpioSysClose( &in[0] );
+        return -1;
     }
-
-    close( fd );
-    return( atoi( value_str ));
-}
-
-static int GPIOWrite( int pin, int value )
-{
-    static const char s_values_str[] = "01";
-    char path[ DIRECTION_MAX ];
-    int fd;
-
-    snprintf( path, DIRECTION_MAX, "/sys/class/gpio/gpio%d/value", pin );
-    fd = open( path, O_WRONLY );
-    if ( fd < 0 )
-    {
-        fprintf( stderr, "failed to open gpio value for writing!\n" );
-        return( -1 );
-    }
-
-    if ( write( fd, &s_values_str[ value == LOW ? 0 : 1 ], 1 ) < 0 )
+    for ( i = 0; i < EVENTS; )
     {
-        fprintf( stderr, "failed to write value!\n" );
-        return( -1 );
+        ready = gpioSysWait( in, 2, 5000 );
+        if ( ready < 0 ) break;
+        if ( ready == 0 )
+        {
+            printf( "No edges for 5s.\n" );
+            continue;
+        }
+        if ( in[0].event ) printf( "GPIO %u now %u.\n", PIN1, in[0].value );
+        if ( in[1].event ) printf( "GPIO %u now %u.\n", PIN2, in[1].value );
+        i += ready;
     }
+    gpioSysClose( &in[0] );
+    gpioSysClose( &in[1] );
 
-    close( fd );
-    return( 0 );
+    return 0;
 }
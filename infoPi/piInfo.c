@@ -23,11 +23,12 @@
 // ****************************************************************************
 // ****************************************************************************
 
-#define Version "Version 0.2"
+#define Version "Version 0.4"
 
 //  Compilation:
 //
-//  Compile with gcc piInfo.c -o piInfo -lasound
+//  Compile with gcc piInfo.c snapshotPi.c ../boardPi/boardPi.c -o piInfo
+//          -lasound -lpthread
 //  Also use the following flags for Raspberry Pi optimisation:
 //         -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
 //         -ffast-math -pipe -O3
@@ -38,6 +39,8 @@
 //  Changelog:
 //
 //  v0.1 Original version.
+//  v0.3 Board information from boardPi, so new style revisions are known.
+//  v0.4 Added hardware snapshot for other tools to start from.
 //
 
 #include <stdio.h>
@@ -46,36 +49,15 @@
 #include <alsa/asoundlib.h>
 #include <alsa/mixer.h>
 #include <stdbool.h>
+#include <stdint.h>
+
+#include "../boardPi/boardPi.h"
+#include "snapshotPi.h"
 
 // ****************************************************************************
 //  Pi header information. Placed here for easier updating.
 // ****************************************************************************
 
-/* Currently known versions.
-
-        +--------+------+----------+ +---+
-        |  Rev   | Year | Md | Ver | | * |
-        +--------+------+----------+ +---+
-        |   0002 | 2012 | B  | 1.0 | | 1 |
-        |   0003 | 2012 | B  | 1.0 | | 1 |
-        |   0004 | 2012 | B  | 2.0 | | 2 |
-        |   0005 | 2012 | B  | 2.0 | | 2 |
-        |   0006 | 2012 | B  | 2.0 | | 2 |
-        |   0007 | 2013 | A  | 2.0 | | 2 |
-        |   0008 | 2013 | A  | 2.0 | | 2 |
-        |   0009 | 2013 | A  | 2.0 | | 2 |
-        |   000d | 2012 | B  | 2.0 | | 2 |
-        |   000e | 2012 | B  | 2.0 | | 2 |
-        |   000f | 2012 | B  | 2.0 | | 2 |
-        |   0010 | 2014 | B+ | 1.0 | | 3 |
-        |   0011 | 2014 | -- | 1.0 | | - |
-        |   0012 | 2014 | A+ | 1.0 | | 3 |
-        |   0013 | 2015 | B+ | 1.2 | | 3 |
-        | a01041 | 2015 | 2B | 1.1 | | 3 |
-        | a21041 | 2015 | 2B | 1.1 | | 3 |
-        +--------+------+----+-----+ +---+
-*/
-
 /* Pin layouts and GPIO numbers.
 
          Layout          B Rev 1.0       A Rev 2.0
@@ -107,32 +89,7 @@
         +----+----+                     +----+----+
 */
 
-/*
-piRevisions[0] = Known board revisions.
-           [1] = Models.
-           [2] = Versions.
-           [3] = Layouts.
-*/
-#define NUMREVISIONS    16
 #define NUMLAYOUTS       3
-#define INDEXREVISIONS   0
-#define INDEXMODELS      1
-#define INDEXVERSIONS    2
-#define INDEXLAYOUTS     3
-
-/*
-    Needed to define entire array as strings so numeric contents need
-    to be converted from strings to numbers.
-*/
-static char *piRevisions[4][NUMREVISIONS] =
-    {{ "0002", "0003", "0004", "0005", "0006", "0007", "0008", "0009",
-       "0010", "0012", "0013", "000d", "000e", "000f", "a01041", "a21041" },
-     {  "B",  "B",  "B",  "B",  "B",  "A",  "A",  "A",
-        "B+", "A+", "B+",  "B", "B",  "B", "2B", "2B" },
-     { "1.0", "1.0", "2.0", "2.0", "2.0", "2.0", "2.0", "2.0",
-       "1.0", "1.0", "1.2", "2.0", "2.0", "2.0", "1.1", "1.1" },
-     { "1", "1", "2", "2", "2", "2", "2", "2",
-       "3", "3", "3", "2", "2", "2", "3", "3" }};
 
 // Header pin, Broadcom GPIO and wiringPi pin numbers for each board revision.
 /*
@@ -188,6 +145,7 @@ struct optionsStruct
     bool listControls;
     int  gpio;
     int  pin;
+    char *snapshot;
 };
 
 
@@ -200,124 +158,70 @@ static struct optionsStruct cmdOptions  =
     .listMixers = false,
     .listControls = false,
     .gpio = -1,
-    .pin = -1
+    .pin = -1,
+    .snapshot = NULL
 };
 
 
-// ============================================================================
-//  Returns index of piRevisions for matching revision from /proc/cpuinfo.
-// ============================================================================
-static int getRevisionIndex( void )
-{
-
-    FILE *filePtr;                  // File to read in and search.
-    static char line[ 512 ];        // Storage for each line read in.
-    static char token;              // Storage for character token.
-    static unsigned int revision;   // Revision in hex format.
-
-    // Open file for reading.
-    filePtr = fopen( "/proc/cpuinfo", "r" );
-    if ( filePtr == NULL ) return( -1 );
-
-    while ( fgets( line, sizeof( line ), filePtr ) != NULL )
-        if ( strncmp ( line, "Revision", 8 ) == 0 )
-            if ( !strncasecmp( "revision\t", line, 9 ))
-            {
-                // line should be "string" "colon" "hex string" "line break"
-                sscanf( line, "%s%s%x%c", &line, &token, &revision, &token );
-                    if ( token == '\n' ) break;
-            }
-    fclose ( filePtr ) ;
-    // Now compare against arrays to find info.
-    static unsigned int foundPos = -1;
-    static unsigned int i;
-    for ( i = 0; i < NUMREVISIONS; i++ )
-            if ( revision == strtol(
-                 piRevisions[INDEXREVISIONS][i], NULL, 16 )) return i;
-    return -1;
-}
-
 // ============================================================================
 //  Print full header pin layout and GPIO/wiringPi mapping.
 // ============================================================================
 static int listPins()
 {
+    const struct boardStruct *board = boardInfo();
+    int layout = board->layout;
+    static unsigned int i;
 
-    int index = getRevisionIndex();
-    if ( index < 0 ) return -1;
-    int layout = atoi( piRevisions[INDEXLAYOUTS][index]);
-    if ( layout < 1 ) return layout;
-    int revision = strtol( piRevisions[INDEXREVISIONS][index], NULL, 16 );
+    // Print board information.
+    if ( board->revision == 0 )
+    {
+        printf( "Cannot identify your board from its revision.\n\n" );
+        return -1;
+    }
 
-    printf( "\nKnown revisions:\n\n" );
-    printf( "\t+-------+----------+-------+---------+\n" );
-    printf( "\t| Index | Revision | Model | Version |\n" );
-    printf( "\t+-------+----------+-------+---------+\n" );
+    printf( "\nRaspberry Pi information:\n\n" );
+    printf( "\tModel = %s (ver %u.%u), board revision %04x.\n",
+            board->model, board->pcb / 10, board->pcb % 10,
+            board->revision );
+    printf( "\tMemory = %uMB, made by %s.\n",
+            board->memory, board->manufacturer );
+    printf( "\tPeripheral base = 0x%08x.\n\n", board->periBase );
 
-    // Now compare against arrays to find info.
-    static unsigned int foundPos = -1;
-    static unsigned int i;
-    static char *padding;
-    for ( i = 0; i < NUMREVISIONS; i++ )
+    if ( layout < 1 )
     {
-        if ( strtol( piRevisions[INDEXREVISIONS][i], NULL, 16 ) < 0xfff )
-            padding = "  ";
-        else
-            padding = "";
-        printf( "\t|    %2i |   %s%0.4x |   %-2s  |   %3.1f   |",
-                i,
-                padding,
-                strtol( piRevisions[INDEXREVISIONS][i], NULL, 16 ),
-                piRevisions[INDEXMODELS][i],
-                atof( piRevisions[INDEXVERSIONS][i] ));
-        if ( i == index )
-            printf( "<-This Pi\n" );
-        else
-            printf ( "\n" );
+        printf( "\tThis board has no GPIO header.\n\n" );
+        return 0;
     }
-    printf( "\t+-------+----------+-------+---------+\n\n" );
 
     // Print GPIO header layout.
-    if ( foundPos < 0 )
-    {
-        printf( "Cannot find your card version from known versions.\n\n" );
-        return -1;
-    }
-    else
+    printf( "\tHeader pin layout %i:\n", layout );
+
+    printf( "\t+------+-------++-----+-----++-------+------+\n" );
+    printf( "\t| gpio | label || pin | pin || label | gpio |\n" );
+    printf( "\t+------+-------++-----+-----++-------+------+\n" );
+
+    static int gpio1, gpio2;
+    for ( i = 0; i < numPins[layout-1]; i = i + 2 )
     {
-        printf( "Raspberry Pi information:\n\n" );
-        printf( "\tModel = %s (ver %3.1f), board revision %0.4x.\n",
-                piRevisions[INDEXMODELS][index],
-                atof( piRevisions[INDEXVERSIONS][index] ),
-                strtol( piRevisions[INDEXREVISIONS][index], NULL, 16 ));
-        printf( "\tHeader pin layout %i:\n", layout );
-
-        printf( "\t+------+-------++-----+-----++-------+------+\n" );
-        printf( "\t| gpio | label || pin | pin || label | gpio |\n" );
-        printf( "\t+------+-------++-----+-----++-------+------+\n" );
-
-        static int gpio1, gpio2;
-        for ( i = 0; i < numPins[layout-1]; i = i + 2 )
-        {
-            gpio1 = atoi( piInfo[layout-1][INDEXGPIO][i] );
-            gpio2 = atoi( piInfo[layout-1][INDEXGPIO][i+1] );
+        gpio1 = atoi( piInfo[layout-1][INDEXGPIO][i] );
+        gpio2 = atoi( piInfo[layout-1][INDEXGPIO][i+1] );
 
-            if ( gpio1 < 0 )
-                 printf( "\t|   %2s ", "--" );
-            else printf( "\t|   %2i ", gpio1 );
+        if ( gpio1 < 0 )
+             printf( "\t|   %2s ", "--" );
+        else printf( "\t|   %2i ", gpio1 );
 
-            printf( "| %5s || %3i | %-3i || %-5s ",
-                    piInfo[layout-1][INDEXLABELS][i],
-                    i + 1, i + 2,
-                    piInfo[layout-1][INDEXLABELS][i+1] );
+        printf( "| %5s || %3i | %-3i || %-5s ",
+                piInfo[layout-1][INDEXLABELS][i],
+                i + 1, i + 2,
+                piInfo[layout-1][INDEXLABELS][i+1] );
 
-            if ( gpio2 < 0 )
-                 printf( "| %-2s   |\n", "--" );
-            else printf( "| %-2i   |\n", gpio2 );
-        }
-        printf( "\t+------+-------++-----" );
-        printf( "+-----++-------+------+\n\n" );
+        if ( gpio2 < 0 )
+             printf( "| %-2s   |\n", "--" );
+        else printf( "| %-2i   |\n", gpio2 );
     }
+    printf( "\t+------+-------++-----" );
+    printf( "+-----++-------+------+\n\n" );
+
     return 0;
 }
 
@@ -327,7 +231,7 @@ static int listPins()
 // ============================================================================
 static int getGPIO( unsigned int pin )
 {
-    int layout = atoi( piRevisions[INDEXLAYOUTS][getRevisionIndex()] );
+    int layout = boardInfo()->layout;
     if ( layout < 1 ) return -1;
     if (( pin < 1 ) || ( pin > numPins[layout-1] )) return -1;
 
@@ -340,7 +244,7 @@ static int getGPIO( unsigned int pin )
 // ============================================================================
 static int getPin( unsigned int gpio )
 {
-    int layout = atoi( piRevisions[INDEXLAYOUTS][getRevisionIndex()] );
+    int layout = boardInfo()->layout;
     unsigned int i;
 
     if ( layout < 1 ) return -1;
@@ -673,6 +577,40 @@ int listALSAcontrols( void )
 }
 
 
+// ****************************************************************************
+//  Snapshot functions.
+// ****************************************************************************
+
+// ============================================================================
+//  Writes a snapshot of cards, mixers and header pins for other tools.
+// ============================================================================
+static int writeSnapshot( const char *path )
+{
+    static struct snapshotStruct snapshot; // Large, so not on the stack.
+    const struct boardStruct *board = boardInfo();
+    int cards;
+    unsigned int pin;
+
+    cards = snapshotScan( &snapshot );
+    if ( cards < 0 ) return -1;
+
+    snapshot.revision = board->revision;
+    snapshot.layout   = board->layout;
+    if ( board->layout > 0 )
+        for ( pin = 1; pin <= numPins[board->layout - 1]; pin++ )
+            snapshot.gpio[pin - 1] = getGPIO( pin );
+
+    if ( snapshotSave( &snapshot, path ) < 0 )
+    {
+        printf( "\nCouldn't write snapshot to %s.\n\n", path );
+        return -1;
+    }
+    printf( "\nWrote snapshot of %i card(s) to %s.\n\n", cards, path );
+
+    return 0;
+}
+
+
 // ****************************************************************************
 //  Command line option functions.
 // ****************************************************************************
@@ -699,6 +637,9 @@ static struct argp_option options[] =
     { 0, 0, 0, 0, "ALSA:" },
     { "listmixers",   'm', 0, 0, "print ALSA mixer info." },
     { "listcontrols", 'c', 0, 0, "print ALSA control info." },
+    { 0, 0, 0, 0, "Snapshot:" },
+    { "snapshot", 's', "<file>", OPTION_ARG_OPTIONAL,
+      "Write hardware snapshot, default " SNAPSHOT_PATH "." },
     { 0 }
 };
 
@@ -726,6 +667,9 @@ static int parse_opt( int param, char *arg, struct argp_state *state )
         case 'h' :
             cmdOptions->gpio = atoi( arg );
             break;
+        case 's' :
+            cmdOptions->snapshot = ( arg != NULL ) ? arg : SNAPSHOT_PATH;
+            break;
     }
     return 0;
 };
@@ -755,6 +699,7 @@ int main( int argc, char *argv[] )
     if ( cmdOptions.listPins ) listPins();
     if ( cmdOptions.listMixers ) listALSAmixers();
     if ( cmdOptions.listControls ) listALSAcontrols();
+    if ( cmdOptions.snapshot != NULL ) writeSnapshot( cmdOptions.snapshot );
 
     if ( cmdOptions.pin > 0 )
     {
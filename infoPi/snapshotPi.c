@@ -0,0 +1,319 @@
+// ****************************************************************************
+/*
+    snapshotPi:
+
+    Cached snapshot of the sound cards, mixers and GPIO header of a Pi.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+// ****************************************************************************
+
+//  Compilation:
+//
+//  Compile with gcc -c -fpic snapshotPi.c -lasound -lpthread
+//  Also use the following flags for Raspberry Pi optimisation:
+//         -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
+//         -ffast-math -pipe -O3
+
+//  Authors:        D.Faulke    23/01/2016
+//
+//  Contributors:
+//
+//  Changelog:
+//
+//  v0.1 Original version.
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <alsa/asoundlib.h>
+
+#include "snapshotPi.h"
+
+
+//  Local functions. ----------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  Reads boot ID, so stale snapshots can be spotted after a reboot.
+// ----------------------------------------------------------------------------
+static void readBootId( char *bootId )
+{
+    FILE *fp;
+
+    memset( bootId, 0, SNAPSHOT_BOOT );
+    fp = fopen( SNAPSHOT_BOOT_ID, "r" );
+    if ( fp == NULL ) return;
+    if ( fgets( bootId, SNAPSHOT_BOOT, fp ) != NULL )
+        bootId[ strcspn( bootId, "\n" ) ] = '\0';
+    fclose( fp );
+};
+
+// ----------------------------------------------------------------------------
+//  Returns numid of an element's playback volume control, or 0 if none.
+// ----------------------------------------------------------------------------
+/*
+    Simple elements are made from controls named "<name> Playback Volume"
+    or, for volumes shared with capture, "<name> Volume".
+*/
+static uint32_t findVolume( snd_ctl_t *ctl, snd_ctl_elem_id_t *id,
+                            snd_ctl_elem_info_t *info, const char *name,
+                            unsigned int index, uint8_t *channels )
+{
+    static const char *suffix[] = { " Playback Volume", " Volume" };
+    char    control[SNAPSHOT_NAME + 20];
+    uint8_t i;
+
+    for ( i = 0; i < 2; i++ )
+    {
+        snprintf( control, sizeof( control ), "%s%s", name, suffix[i] );
+
+        snd_ctl_elem_id_clear( id );
+        snd_ctl_elem_id_set_interface( id, SND_CTL_ELEM_IFACE_MIXER );
+        snd_ctl_elem_id_set_name( id, control );
+        snd_ctl_elem_id_set_index( id, index );
+        snd_ctl_elem_info_set_id( info, id );
+
+        if ( snd_ctl_elem_info( ctl, info ) < 0 ) continue;
+        if ( snd_ctl_elem_info_get_type( info ) !=
+             SND_CTL_ELEM_TYPE_INTEGER ) continue;
+
+        *channels = snd_ctl_elem_info_get_count( info );
+        return snd_ctl_elem_info_get_numid( info );
+    }
+
+    return 0;
+};
+
+// ----------------------------------------------------------------------------
+//  Scans one card. Run as a thread for each card.
+// ----------------------------------------------------------------------------
+static void *scanCard( void *arg )
+{
+    struct snapshotCard  *card = arg;
+    struct snapshotElem  *e;
+    snd_ctl_t            *ctl;
+    snd_ctl_card_info_t  *cardInfo;
+    snd_ctl_elem_id_t    *ctlId;
+    snd_ctl_elem_info_t  *ctlInfo;
+    snd_mixer_t          *mixer;
+    snd_mixer_elem_t     *elem;
+    snd_mixer_selem_id_t *mixerId;
+    char device[16];
+    long min, max;
+
+    // Allocated once here, since alloca in the loop would keep growing.
+    snd_ctl_card_info_alloca( &cardInfo );
+    snd_ctl_elem_id_alloca( &ctlId );
+    snd_ctl_elem_info_alloca( &ctlInfo );
+    snd_mixer_selem_id_alloca( &mixerId );
+
+    snprintf( device, sizeof( device ), "hw:%i", card->number );
+    if ( snd_ctl_open( &ctl, device, 0 ) < 0 ) return NULL;
+    if ( snd_ctl_card_info( ctl, cardInfo ) == 0 )
+    {
+        strncpy( card->id, snd_ctl_card_info_get_id( cardInfo ),
+                 SNAPSHOT_ID - 1 );
+        strncpy( card->name, snd_ctl_card_info_get_name( cardInfo ),
+                 SNAPSHOT_NAME - 1 );
+    }
+
+    // The slow part, which is why each card has its own thread.
+    if ( snd_mixer_open( &mixer, 0 ) < 0 )
+    {
+        snd_ctl_close( ctl );
+        return NULL;
+    }
+    if (( snd_mixer_attach( mixer, device ) < 0 ) ||
+        ( snd_mixer_selem_register( mixer, NULL, NULL ) < 0 ) ||
+        ( snd_mixer_load( mixer ) < 0 ))
+    {
+        snd_mixer_close( mixer );
+        snd_ctl_close( ctl );
+        return NULL;
+    }
+
+    for ( elem = snd_mixer_first_elem( mixer );
+          elem && ( card->count < SNAPSHOT_ELEMS );
+          elem = snd_mixer_elem_next( elem ))
+    {
+        e = &card->elems[ card->count ];
+        snd_mixer_selem_get_id( elem, mixerId );
+        strncpy( e->name, snd_mixer_selem_id_get_name( mixerId ),
+                 SNAPSHOT_NAME - 1 );
+        e->index     = snd_mixer_selem_id_get_index( mixerId );
+        e->hasVolume = snd_mixer_selem_has_playback_volume( elem );
+        e->hasSwitch = snd_mixer_selem_has_playback_switch( elem );
+
+        if ( e->hasVolume )
+        {
+            if ( snd_mixer_selem_get_playback_volume_range( elem,
+                                                            &min, &max ) == 0 )
+            {
+                e->volMin = min;
+                e->volMax = max;
+            }
+            if ( snd_mixer_selem_get_playback_dB_range( elem,
+                                                        &min, &max ) == 0 )
+            {
+                e->dBMin = min;
+                e->dBMax = max;
+            }
+            e->numid = findVolume( ctl, ctlId, ctlInfo, e->name, e->index,
+                                   &e->channels );
+        }
+        card->count++;
+    }
+
+    snd_mixer_close( mixer );
+    snd_ctl_close( ctl );
+
+    return NULL;
+};
+
+
+//  Functions. ----------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  Scans all sound cards into snapshot, one thread per card.
+// ----------------------------------------------------------------------------
+int snapshotScan( struct snapshotStruct *snapshot )
+{
+    pthread_t threads[SNAPSHOT_CARDS];
+    bool      started[SNAPSHOT_CARDS];
+    int       number = -1;
+    uint8_t   i;
+
+    memset( snapshot, 0, sizeof( *snapshot ));
+    snapshot->magic   = SNAPSHOT_MAGIC;
+    snapshot->version = SNAPSHOT_VERSION;
+    snapshot->size    = sizeof( *snapshot );
+    readBootId( snapshot->bootId );
+    memset( snapshot->gpio, -1, sizeof( snapshot->gpio ));
+
+    while (( snapshot->count < SNAPSHOT_CARDS ) &&
+           ( snd_card_next( &number ) == 0 ) && ( number >= 0 ))
+    {
+        i = snapshot->count++;
+        snapshot->cards[i].number = number;
+        started[i] = ( pthread_create( &threads[i], NULL, scanCard,
+                                       &snapshot->cards[i] ) == 0 );
+        if ( !started[i] ) scanCard( &snapshot->cards[i] );
+    }
+
+    for ( i = 0; i < snapshot->count; i++ )
+        if ( started[i] ) pthread_join( threads[i], NULL );
+
+    return snapshot->count;
+};
+
+// ----------------------------------------------------------------------------
+//  Writes snapshot to a file. Returns -1 if not.
+// ----------------------------------------------------------------------------
+int8_t snapshotSave( const struct snapshotStruct *snapshot, const char *path )
+{
+    char  temp[256];
+    FILE *fp;
+    bool  ok;
+
+    snprintf( temp, sizeof( temp ), "%s.tmp", path );
+    fp = fopen( temp, "wb" );
+    if ( fp == NULL ) return -1;
+    ok = ( fwrite( snapshot, sizeof( *snapshot ), 1, fp ) == 1 );
+    ok = ( fclose( fp ) == 0 ) && ok;
+
+    if ( !ok || ( rename( temp, path ) < 0 ))
+    {
+        remove( temp );
+        return -1;
+    }
+
+    return 0;
+};
+
+// ----------------------------------------------------------------------------
+//  Reads snapshot from a file. Returns -1 if missing or stale.
+// ----------------------------------------------------------------------------
+int8_t snapshotLoad( struct snapshotStruct *snapshot, const char *path )
+{
+    char  bootId[SNAPSHOT_BOOT];
+    FILE *fp;
+    bool  ok;
+
+    fp = fopen( path, "rb" );
+    if ( fp == NULL ) return -1;
+    ok = ( fread( snapshot, sizeof( *snapshot ), 1, fp ) == 1 );
+    fclose( fp );
+    if ( !ok ) return -1;
+
+    if (( snapshot->magic   != SNAPSHOT_MAGIC ) ||
+        ( snapshot->version != SNAPSHOT_VERSION ) ||
+        ( snapshot->size    != sizeof( *snapshot )) ||
+        ( snapshot->count   >  SNAPSHOT_CARDS )) return -1;
+
+    readBootId( bootId );
+    if ( strncmp( bootId, snapshot->bootId, SNAPSHOT_BOOT ) != 0 ) return -1;
+
+    return 0;
+};
+
+// ----------------------------------------------------------------------------
+//  Returns card matching an ALSA device, or NULL if not found.
+// ----------------------------------------------------------------------------
+const struct snapshotCard *snapshotFindCard(
+                      const struct snapshotStruct *snapshot, const char *device )
+{
+    const char *name;
+    char       *end;
+    long        number;
+    uint8_t     i;
+
+    if ( strncmp( device, "hw:", 3 ) != 0 ) return NULL;
+    name = device + 3;
+    number = strtol( name, &end, 10 );
+
+    for ( i = 0; i < snapshot->count; i++ )
+    {
+        if (( end != name ) && ( *end == '\0' ))
+        {
+            if ( snapshot->cards[i].number == number )
+                return &snapshot->cards[i];
+        }
+        else if ( strncmp( snapshot->cards[i].id, name, SNAPSHOT_ID ) == 0 )
+            return &snapshot->cards[i];
+    }
+
+    return NULL;
+};
+
+// ----------------------------------------------------------------------------
+//  Returns mixer element of a card by name, or NULL if not found.
+// ----------------------------------------------------------------------------
+const struct snapshotElem *snapshotFindElem( const struct snapshotCard *card,
+                                             const char *name )
+{
+    uint8_t i;
+
+    for ( i = 0; i < card->count && i < SNAPSHOT_ELEMS; i++ )
+        if (( strncmp( card->elems[i].name, name, SNAPSHOT_NAME ) == 0 ) &&
+            ( card->elems[i].index == 0 ))
+            return &card->elems[i];
+
+    return NULL;
+};
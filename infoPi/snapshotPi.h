@@ -0,0 +1,150 @@
+// ****************************************************************************
+/*
+    snapshotPi:
+
+    Cached snapshot of the sound cards, mixers and GPIO header of a Pi.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+// ****************************************************************************
+
+//  Authors:        D.Faulke    23/01/2016
+//
+//  Contributors:
+//
+//  Changelog:
+//
+//  v0.1 Original version.
+//
+
+//  Information. --------------------------------------------------------------
+/*
+    Opening a card and loading its mixer tree to find an element by name
+    can take seconds on slow USB DACs, and each tool did it again. The
+    snapshot is written once, e.g. at boot with piInfo -s, by scanning
+    all cards at the same time, one thread each. Tools then read one
+    small file and open the control they need directly by its numid.
+
+    The snapshot is a single struct written as it is in memory, so it is
+    only read by programs built for the same Pi. The default path is in
+    /dev/shm so it is in memory and gone at power off. It is stale if:
+
+        - the magic, version or size don't match.
+        - the boot ID is different, since cards may have moved.
+
+    Readers should still check the card ID and element before use, as a
+    card may have been plugged in or removed since it was written.
+*/
+
+#ifndef SNAPSHOTPI_H
+#define SNAPSHOTPI_H
+
+//  Macros. -------------------------------------------------------------------
+
+#define SNAPSHOT_PATH    "/dev/shm/piSnapshot" // Default snapshot file.
+#define SNAPSHOT_BOOT_ID "/proc/sys/kernel/random/boot_id"
+
+#define SNAPSHOT_MAGIC   0x50694e76 // "PiNv".
+#define SNAPSHOT_VERSION 1
+
+#define SNAPSHOT_CARDS   8  // Max cards.
+#define SNAPSHOT_ELEMS   24 // Max mixer elements per card.
+#define SNAPSHOT_NAME    44 // Max element name length, with terminator.
+#define SNAPSHOT_ID      16 // Max card ID length, with terminator.
+#define SNAPSHOT_BOOT    40 // Boot ID length, with terminator.
+#define SNAPSHOT_PINS    40 // Header pins.
+
+//  Data structures. ----------------------------------------------------------
+
+// Mixer simple element.
+struct snapshotElem
+{
+    char     name[SNAPSHOT_NAME]; // Simple element name.
+    uint32_t index;               // Simple element index.
+    uint32_t numid;               // Playback volume control, 0 if none.
+    uint8_t  channels;            // Values in the playback volume control.
+    bool     hasVolume;           // Has playback volume.
+    bool     hasSwitch;           // Has playback switch.
+    int32_t  volMin;              // Minimum raw volume.
+    int32_t  volMax;              // Maximum raw volume.
+    int32_t  dBMin;               // Minimum volume (1/100 dB).
+    int32_t  dBMax;               // Maximum volume (1/100 dB).
+};
+
+// Sound card.
+struct snapshotCard
+{
+    int32_t  number;              // Card number, as in hw:N.
+    char     id[SNAPSHOT_ID];     // Card ID, as in hw:ID.
+    char     name[SNAPSHOT_NAME]; // Card name.
+    uint8_t  count;               // Mixer elements.
+    struct snapshotElem elems[SNAPSHOT_ELEMS];
+};
+
+struct snapshotStruct
+{
+    uint32_t magic;                 // SNAPSHOT_MAGIC.
+    uint16_t version;               // SNAPSHOT_VERSION.
+    uint32_t size;                  // sizeof( struct snapshotStruct ).
+    char     bootId[SNAPSHOT_BOOT]; // Boot when written.
+    uint32_t revision;              // Board revision code.
+    uint8_t  layout;                // Header layout, as in boardPi.
+    int8_t   gpio[SNAPSHOT_PINS];   // GPIO for each header pin, -1 if none.
+    uint8_t  count;                 // Cards.
+    struct snapshotCard cards[SNAPSHOT_CARDS];
+};
+
+//  Functions. ----------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  Scans all sound cards into snapshot, one thread per card.
+// ----------------------------------------------------------------------------
+/*
+    Fills in the header and cards. gpio is left as -1 for the caller
+    to fill in. Returns the number of cards or -1 on error.
+*/
+int snapshotScan( struct snapshotStruct *snapshot );
+
+// ----------------------------------------------------------------------------
+//  Writes snapshot to a file. Returns -1 if not.
+// ----------------------------------------------------------------------------
+/*
+    Written to a temporary file that is then renamed, so readers never
+    see a partly written snapshot.
+*/
+int8_t snapshotSave( const struct snapshotStruct *snapshot, const char *path );
+
+// ----------------------------------------------------------------------------
+//  Reads snapshot from a file. Returns -1 if missing or stale.
+// ----------------------------------------------------------------------------
+int8_t snapshotLoad( struct snapshotStruct *snapshot, const char *path );
+
+// ----------------------------------------------------------------------------
+//  Returns card matching an ALSA device, or NULL if not found.
+// ----------------------------------------------------------------------------
+/*
+    device is hw:N or hw:ID.
+*/
+const struct snapshotCard *snapshotFindCard(
+                      const struct snapshotStruct *snapshot, const char *device );
+
+// ----------------------------------------------------------------------------
+//  Returns mixer element of a card by name, or NULL if not found.
+// ----------------------------------------------------------------------------
+const struct snapshotElem *snapshotFindElem( const struct snapshotCard *card,
+                                             const char *name );
+
+#endif
@@ -0,0 +1,373 @@
+//  ===========================================================================
+/*
+    castPi:
+
+    Multicasts meter levels to display only nodes.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+//  ===========================================================================
+/*
+    Compile with:
+
+        gcc -c -Wall -fpic castPi.c
+
+    Also use the following flags for Raspberry Pi optimisation:
+
+        -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
+        -ffast-math -pipe -O3
+*/
+//  ===========================================================================
+/*
+    Authors:        D.Faulke            28/02/2016
+
+    Contributors:
+
+    Changelog:
+
+        v01.00      Original version.
+        v01.01      Receives packets from senders with more channels.
+*/
+//  ===========================================================================
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "castPi.h"
+#include "meterPi.h"
+
+
+//  Data. ---------------------------------------------------------------------
+
+static int      cast_socket = -1;      // Sender or receiver socket.
+static struct   sockaddr_in cast_addr; // Group and port.
+static uint32_t cast_sequence;         // Next sequence sent, last received.
+static bool     cast_synced = false;   // A packet has been received.
+static bool     cast_playing = false;  // Sender's source is running.
+static uint64_t cast_last;             // Time of last packet (us, monotonic).
+static struct   cast_stats_t cast_stats;
+
+
+//  Functions. ----------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Returns a clock in us.
+//  ---------------------------------------------------------------------------
+static uint64_t cast_time_us( clockid_t clock )
+{
+    struct timespec now;
+
+    clock_gettime( clock, &now );
+
+    return (uint64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+//  ---------------------------------------------------------------------------
+//  Puts big endian values into a packet.
+//  ---------------------------------------------------------------------------
+static void cast_put( uint8_t *packet, uint64_t value, uint8_t bytes )
+{
+    while ( bytes-- > 0 )
+    {
+        packet[bytes] = value & 0xff;
+        value >>= 8;
+    }
+}
+
+//  ---------------------------------------------------------------------------
+//  Gets big endian values from a packet.
+//  ---------------------------------------------------------------------------
+static uint64_t cast_get( const uint8_t *packet, uint8_t bytes )
+{
+    uint64_t value = 0;
+
+    while ( bytes-- > 0 ) value = ( value << 8 ) | *packet++;
+
+    return value;
+}
+
+//  ---------------------------------------------------------------------------
+//  Fills in the group address. Returns false if group isn't an address.
+//  ---------------------------------------------------------------------------
+static bool cast_address( const char *group, uint16_t port )
+{
+    memset( &cast_addr, 0, sizeof( cast_addr ));
+    cast_addr.sin_family = AF_INET;
+    cast_addr.sin_port   = htons(( port > 0 ) ? port : CAST_PORT );
+
+    return inet_pton( AF_INET, ( group != NULL ) ? group : CAST_GROUP,
+                      &cast_addr.sin_addr ) == 1;
+}
+
+//  ---------------------------------------------------------------------------
+//  Opens a socket to send levels to a multicast group. Returns false if not.
+//  ---------------------------------------------------------------------------
+bool cast_open_sender( const char *group, uint16_t port, uint8_t ttl,
+                       const char *interface )
+{
+    struct in_addr local;
+    uint8_t loop = 1;
+
+    cast_close();
+    if ( !cast_address( group, port )) return false;
+
+    cast_socket = socket( AF_INET, SOCK_DGRAM, 0 );
+    if ( cast_socket < 0 ) return false;
+
+    if ( ttl == 0 ) ttl = CAST_TTL;
+    setsockopt( cast_socket, IPPROTO_IP, IP_MULTICAST_TTL,
+                &ttl, sizeof( ttl ));
+
+    // A display on the player itself can receive its own packets.
+    setsockopt( cast_socket, IPPROTO_IP, IP_MULTICAST_LOOP,
+                &loop, sizeof( loop ));
+
+    if ( interface != NULL )
+    {
+        if (( inet_pton( AF_INET, interface, &local ) != 1 ) ||
+            ( setsockopt( cast_socket, IPPROTO_IP, IP_MULTICAST_IF,
+                          &local, sizeof( local )) < 0 ))
+        {
+            cast_close();
+            return false;
+        }
+    }
+
+    cast_sequence = 0;
+    memset( &cast_stats, 0, sizeof( cast_stats ));
+
+    return true;
+}
+
+//  ---------------------------------------------------------------------------
+//  Sends the levels of the last get_dBfs() call.
+//  ---------------------------------------------------------------------------
+void cast_send( const struct peak_meter_t *peak_meter )
+{
+    uint8_t  packet[CAST_PACKET_MAX];
+    uint8_t *level = &packet[CAST_HEADER];
+    uint8_t  channel;
+
+    if ( cast_socket < 0 ) return;
+
+    cast_put( &packet[0], CAST_MAGIC, 2 );
+    packet[2] = CAST_VERSION;
+    packet[3] = meter_get_playing() ? CAST_PLAYING : 0;
+    cast_put( &packet[4], cast_sequence++, 4 );
+    cast_put( &packet[8], cast_time_us( CLOCK_REALTIME ), 8 );
+    packet[16] = METER_CHANNELS;
+
+    for ( channel = 0; channel < METER_CHANNELS; channel++ )
+    {
+        level[0] = (uint8_t) peak_meter->dBfs[channel];
+        level[1] = (uint8_t) peak_meter->dBpk[channel];
+        level[2] = (uint8_t) peak_meter->dBtp[channel];
+        level[3] = peak_meter->integrator.true_peak.over[channel] ?
+                   CAST_OVERLOAD : 0;
+        level += CAST_LEVEL;
+    }
+
+    // A dropped packet is only one frame, so errors aren't retried.
+    if ( sendto( cast_socket, packet, level - packet, 0,
+                 (struct sockaddr *) &cast_addr, sizeof( cast_addr )) ==
+         level - packet )
+        cast_stats.packets++;
+    else
+        cast_stats.lost++;
+}
+
+//  ---------------------------------------------------------------------------
+//  Joins a multicast group to receive levels. Returns false if not.
+//  ---------------------------------------------------------------------------
+bool cast_open_receiver( const char *group, uint16_t port,
+                         const char *interface )
+{
+    struct sockaddr_in local;
+    struct ip_mreq     mreq;
+    int reuse = 1;
+
+    cast_close();
+    if ( !cast_address( group, port )) return false;
+
+    cast_socket = socket( AF_INET, SOCK_DGRAM, 0 );
+    if ( cast_socket < 0 ) return false;
+
+    // Several receivers on one node, e.g. an LCD and an OLED program.
+    setsockopt( cast_socket, SOL_SOCKET, SO_REUSEADDR,
+                &reuse, sizeof( reuse ));
+
+    memset( &local, 0, sizeof( local ));
+    local.sin_family      = AF_INET;
+    local.sin_port        = cast_addr.sin_port;
+    local.sin_addr.s_addr = cast_addr.sin_addr.s_addr;
+
+    mreq.imr_multiaddr = cast_addr.sin_addr;
+    mreq.imr_interface.s_addr = htonl( INADDR_ANY );
+    if (( interface != NULL ) &&
+        ( inet_pton( AF_INET, interface, &mreq.imr_interface ) != 1 ))
+    {
+        cast_close();
+        return false;
+    }
+
+    if (( bind( cast_socket, (struct sockaddr *) &local,
+                sizeof( local )) < 0 ) ||
+        ( setsockopt( cast_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP,
+                      &mreq, sizeof( mreq )) < 0 ))
+    {
+        cast_close();
+        return false;
+    }
+
+    cast_synced  = false;
+    cast_playing = false;
+    memset( &cast_stats, 0, sizeof( cast_stats ));
+
+    return true;
+}
+
+//  ---------------------------------------------------------------------------
+//  Checks a packet's sequence. Returns true if it is the newest.
+//  ---------------------------------------------------------------------------
+static bool cast_accept( uint32_t sequence )
+{
+    int32_t ahead = (int32_t)( sequence - cast_sequence );
+
+    if (( !cast_synced ) || ( ahead < -CAST_RESYNC ))
+    {
+        cast_synced   = true;
+        cast_sequence = sequence;
+        return true;
+    }
+
+    if ( ahead <= 0 )
+    {
+        cast_stats.late++;
+        return false;
+    }
+
+    cast_stats.lost += ahead - 1;
+    cast_sequence = sequence;
+    return true;
+}
+
+//  ---------------------------------------------------------------------------
+//  Waits for levels from the sender. Returns true if new levels were read.
+//  ---------------------------------------------------------------------------
+bool cast_receive( struct peak_meter_t *peak_meter, uint32_t timeout )
+{
+    uint8_t  packet[CAST_PACKET_MAX + 1];
+    uint8_t  newest[CAST_PACKET_MAX];
+    const uint8_t *level;
+    struct   pollfd poll_fd;
+    ssize_t  len;
+    uint8_t  channel, channels = 0;
+    int64_t  latency;
+    bool     fresh = false;
+
+    if ( cast_socket < 0 ) return false;
+
+    poll_fd.fd     = cast_socket;
+    poll_fd.events = POLLIN;
+    if ( poll( &poll_fd, 1, ( timeout + 999 ) / 1000 ) <= 0 ) return false;
+
+    // Only the newest of the packets waiting is drawn.
+    while (( len = recv( cast_socket, packet, sizeof( packet ),
+                         MSG_DONTWAIT )) >= 0 )
+    {
+        if (( len < CAST_HEADER ) ||
+            ( cast_get( &packet[0], 2 ) != CAST_MAGIC ) ||
+            ( packet[2] != CAST_VERSION ) ||
+            ( packet[16] > CAST_CHANNELS_MAX ) ||
+            ( len != CAST_HEADER + CAST_LEVEL * packet[16] ))
+        {
+            cast_stats.bad++;
+            continue;
+        }
+        if ( !cast_accept( cast_get( &packet[4], 4 ))) continue;
+
+        memcpy( newest, packet, len );
+        channels = packet[16];
+        fresh    = true;
+        cast_stats.packets++;
+    }
+
+    if ( !fresh ) return false;
+
+    cast_last    = cast_time_us( CLOCK_MONOTONIC );
+    cast_playing = newest[3] & CAST_PLAYING;
+
+    latency = (int64_t)( cast_time_us( CLOCK_REALTIME ) -
+                         cast_get( &newest[8], 8 ));
+    cast_stats.latency_last = latency;
+    if ( latency > cast_stats.latency_max ) cast_stats.latency_max = latency;
+
+    // Channels the sender doesn't have are left as they are, and channels
+    // this node doesn't have are ignored.
+    if ( channels > METER_CHANNELS ) channels = METER_CHANNELS;
+    level = &newest[CAST_HEADER];
+    for ( channel = 0; channel < channels; channel++ )
+    {
+        peak_meter->dBfs[channel] = (int8_t) level[0];
+        peak_meter->dBpk[channel] = (int8_t) level[1];
+        peak_meter->dBtp[channel] = (int8_t) level[2];
+        if ( level[3] & CAST_OVERLOAD )
+        {
+            peak_meter->overload[channel] = true;
+            peak_meter->ballistics.over[channel] = 0;
+        }
+        level += CAST_LEVEL;
+    }
+
+    return true;
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns true if the sender's source is running.
+//  ---------------------------------------------------------------------------
+bool cast_get_playing( void )
+{
+    return cast_playing &&
+           ( cast_time_us( CLOCK_MONOTONIC ) - cast_last < CAST_STALE );
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns sender or receiver statistics.
+//  ---------------------------------------------------------------------------
+void cast_get_stats( struct cast_stats_t *stats )
+{
+    *stats = cast_stats;
+}
+
+//  ---------------------------------------------------------------------------
+//  Closes the sender or receiver socket.
+//  ---------------------------------------------------------------------------
+void cast_close( void )
+{
+    if ( cast_socket < 0 ) return;
+
+    close( cast_socket );
+    cast_socket = -1;
+}
@@ -0,0 +1,177 @@
+//  ===========================================================================
+/*
+    castPi:
+
+    Multicasts meter levels to display only nodes.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+//  ===========================================================================
+/*
+    Authors:        D.Faulke            28/02/2016
+
+    Contributors:
+
+    Changelog:
+
+        v01.00      Original version.
+        v01.01      Receives packets from senders with more channels.
+*/
+//  ===========================================================================
+
+#ifndef CASTPI_H
+#define CASTPI_H
+
+//  Info. ---------------------------------------------------------------------
+/*
+    The player meters the stream once and sends the levels of each frame to
+    a multicast group. Display nodes join the group and drive their displays
+    from the packets, so they need neither Squeezelite -v nor any metering
+    of their own, and one packet per frame reaches every node however many
+    there are.
+
+    Each packet is 25 bytes for two channels, in network byte order:
+
+        +--------+------+------------------------------------------------+
+        | Offset | Size | Field                                          |
+        |--------+------+------------------------------------------------|
+        |      0 |    2 | Magic, CAST_MAGIC.                             |
+        |      2 |    1 | Version, CAST_VERSION.                         |
+        |      3 |    1 | Flags, CAST_PLAYING.                           |
+        |      4 |    4 | Sequence number.                               |
+        |      8 |    8 | Sender time, CLOCK_REALTIME (us).              |
+        |     16 |    1 | Channels.                                      |
+        |     17 |  4xN | dBfs, dBpk, dBtp (int8) and flags of each      |
+        |        |      | channel, CAST_OVERLOAD for a new overload.     |
+        +--------+------+------------------------------------------------+
+
+    Only the levels are sent. Each node runs get_dB_indices() on them with
+    its own scale, hold and fall times, so nodes with different displays
+    can share a sender. Packets are sent as each frame is metered and
+    drawn as they arrive, so every node updates at the same moment. A node
+    built with fewer channels than the sender shows the first of them.
+
+    Packets older than the last one received are dropped rather than drawn
+    late, and gaps in the sequence are counted as lost. If the sequence
+    jumps back by more than CAST_RESYNC, e.g. the sender was restarted, the
+    receiver starts again from the new sequence. When the clocks of the
+    nodes are kept in step, e.g. by NTP, the sender time gives the network
+    latency.
+
+    The default group is in the administratively scoped range and packets
+    are sent with a TTL of 1 so that they stay on the local network.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "meterPi.h"
+
+//  Macros. -------------------------------------------------------------------
+
+#define CAST_GROUP   "239.255.77.80" // Default multicast group.
+#define CAST_PORT             5080   // Default UDP port.
+#define CAST_TTL                 1   // Default multicast TTL (hops).
+#define CAST_MAGIC          0x4d50   // "MP".
+#define CAST_VERSION             1   // Packet format version.
+#define CAST_HEADER             17   // Bytes before the channel levels.
+#define CAST_LEVEL               4   // Bytes for each channel.
+#define CAST_CHANNELS_MAX        8   // Most channels a sender can have.
+#define CAST_PACKET_MAX ( CAST_HEADER + CAST_LEVEL * CAST_CHANNELS_MAX )
+#define CAST_RESYNC           1000   // Sequence jump back for a new sender.
+#define CAST_STALE         1000000   // Time without packets to stop (us).
+
+#define CAST_PLAYING          0x01   // Packet flag, source is running.
+#define CAST_OVERLOAD         0x01   // Channel flag, overload in this frame.
+
+//  Types. --------------------------------------------------------------------
+
+/*
+    Receiver statistics. latency is only meaningful if the sender and
+    receiver clocks are synchronised.
+*/
+struct cast_stats_t
+{
+    uint64_t packets;      // Packets sent or accepted.
+    uint64_t lost;         // Gaps in the sequence.
+    uint64_t late;         // Packets older than the last accepted.
+    uint64_t bad;          // Packets with the wrong size, magic or version.
+    int64_t  latency_last; // Sender to receiver time of last packet (us).
+    int64_t  latency_max;  // Longest sender to receiver time (us).
+};
+
+//  Functions. ----------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Opens a socket to send levels to a multicast group. Returns false if not.
+//  ---------------------------------------------------------------------------
+/*
+    group is NULL for CAST_GROUP and port 0 for CAST_PORT. interface is the
+    address of the local interface to send from, or NULL for the default
+    route. ttl is 0 for CAST_TTL.
+*/
+bool cast_open_sender( const char *group, uint16_t port, uint8_t ttl,
+                       const char *interface );
+
+//  ---------------------------------------------------------------------------
+//  Sends the levels of the last get_dBfs() call.
+//  ---------------------------------------------------------------------------
+/*
+    Call once per frame, straight after get_dBfs(). The overload flag is
+    the overload found in the frame rather than the displayed indicator, so
+    the indicator is timed by each receiver.
+*/
+void cast_send( const struct peak_meter_t *peak_meter );
+
+//  ---------------------------------------------------------------------------
+//  Joins a multicast group to receive levels. Returns false if not.
+//  ---------------------------------------------------------------------------
+/*
+    group, port and interface are as for cast_open_sender().
+*/
+bool cast_open_receiver( const char *group, uint16_t port,
+                         const char *interface );
+
+//  ---------------------------------------------------------------------------
+//  Waits for levels from the sender. Returns true if new levels were read.
+//  ---------------------------------------------------------------------------
+/*
+    Waits up to timeout us for a packet. All packets waiting are read and
+    the levels of the newest are copied into peak_meter, ready for
+    get_dB_indices(). If none arrive before the timeout the levels are left
+    so that the display can carry on with hold and fall.
+*/
+bool cast_receive( struct peak_meter_t *peak_meter, uint32_t timeout );
+
+//  ---------------------------------------------------------------------------
+//  Returns true if the sender's source is running.
+//  ---------------------------------------------------------------------------
+/*
+    False if no packet has arrived for CAST_STALE. For frame_init().
+*/
+bool cast_get_playing( void );
+
+//  ---------------------------------------------------------------------------
+//  Returns sender or receiver statistics.
+//  ---------------------------------------------------------------------------
+void cast_get_stats( struct cast_stats_t *stats );
+
+//  ---------------------------------------------------------------------------
+//  Closes the sender or receiver socket.
+//  ---------------------------------------------------------------------------
+void cast_close( void );
+
+#endif // #ifndef CASTPI_H
@@ -0,0 +1,138 @@
+//  ===========================================================================
+/*
+    framePi:
+
+    Frame pacing for meter and display loops.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+//  ===========================================================================
+/*
+    Compile with:
+
+        gcc -c -Wall -fpic framePi.c -lrt
+
+    Also use the following flags for Raspberry Pi optimisation:
+
+        -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
+        -ffast-math -pipe -O3
+*/
+//  ===========================================================================
+/*
+    Authors:        D.Faulke            26/02/2016
+
+    Contributors:
+
+    Changelog:
+
+        v01.00      Original version.
+        v01.01      Wake up jitter and skips recorded with statsPi.
+*/
+//  ===========================================================================
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+
+#include "framePi.h"
+#include "../statsPi/statsPi.h"
+
+
+//  Functions. ----------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Returns a - b in nS.
+//  ---------------------------------------------------------------------------
+static int64_t frame_diff( const struct timespec *a, const struct timespec *b )
+{
+    return ( int64_t )( a->tv_sec - b->tv_sec ) * 1000000000 +
+           ( a->tv_nsec - b->tv_nsec );
+}
+
+//  ---------------------------------------------------------------------------
+//  Adds nS to a time.
+//  ---------------------------------------------------------------------------
+static void frame_add( struct timespec *time, uint64_t ns )
+{
+    ns += time->tv_nsec;
+    time->tv_sec  += ns / 1000000000;
+    time->tv_nsec  = ns % 1000000000;
+}
+
+//  ---------------------------------------------------------------------------
+//  Initialises a frame timer. The first deadline is now.
+//  ---------------------------------------------------------------------------
+void frame_init( struct frame_timer_t *timer, uint32_t interval,
+                 uint32_t idle, bool (*active)( void ))
+{
+    timer->interval = ( interval > 0 ) ? interval : 1;
+    timer->idle     = idle;
+    timer->active   = active;
+    timer->idling   = false;
+    timer->frames   = 0;
+    timer->skipped  = 0;
+    timer->late_max = 0;
+    clock_gettime( CLOCK_MONOTONIC, &timer->next );
+}
+
+//  ---------------------------------------------------------------------------
+//  Waits for the next frame deadline. Returns true if active.
+//  ---------------------------------------------------------------------------
+bool frame_wait( struct frame_timer_t *timer )
+{
+    struct timespec now;
+    uint64_t interval;
+    int64_t  late;
+    bool     active;
+
+    active = ( timer->active == NULL ) || timer->active();
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    // Don't sit out the rest of an idle interval once something plays.
+    if ( active && timer->idling ) timer->next = now;
+
+    timer->idling = ( !active && ( timer->idle > 0 ));
+    interval = ( uint64_t )( timer->idling ? timer->idle :
+                                             timer->interval ) * 1000;
+
+    late = frame_diff( &now, &timer->next );
+    if ( late < 0 )
+    {
+        while ( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME,
+                                 &timer->next, NULL ) == EINTR );
+
+        clock_gettime( CLOCK_MONOTONIC, &now );
+        late = frame_diff( &now, &timer->next );
+        if ( late < 0 ) late = 0;
+        statsRecord( STATS_FRAME_JITTER, late );
+
+        late /= 1000;
+        if ( late > timer->late_max ) timer->late_max = late;
+    }
+    else if ( late >= ( int64_t ) interval )
+    {
+        // Deadlines that have already passed are dropped, not queued.
+        timer->skipped += late / interval;
+        statsAdd( STATS_FRAME_SKIPS, late / interval );
+        frame_add( &timer->next, late / interval * interval );
+    }
+
+    frame_add( &timer->next, interval );
+    timer->frames++;
+
+    return active;
+}
@@ -0,0 +1,95 @@
+//  ===========================================================================
+/*
+    framePi:
+
+    Frame pacing for meter and display loops.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+//  ===========================================================================
+/*
+    Authors:        D.Faulke            26/02/2016
+
+    Contributors:
+
+    Changelog:
+
+        v01.00      Original version.
+        v01.01      Wake up jitter and skips recorded with statsPi.
+*/
+//  ===========================================================================
+
+#ifndef FRAMEPI_H
+#define FRAMEPI_H
+
+//  Info. ---------------------------------------------------------------------
+/*
+    Frames are run at absolute deadlines on the monotonic clock, so the
+    time taken to render a frame doesn't add to the interval and the rate
+    doesn't drift with bus load. Each deadline is the last plus the
+    interval. If a frame overruns one or more deadlines they are skipped
+    rather than run back to back to catch up, and the next frame is run at
+    the next deadline still to come.
+
+    If the timer has an active function and it returns false, e.g.
+    meter_get_playing() while nothing is playing, frames are run at the
+    idle interval instead. The first frame after becoming active again is
+    run at once.
+
+    When built with -DSTATSPI, the time from each deadline to the wake up
+    is recorded in the STATS_FRAME_JITTER histogram and skipped deadlines
+    in STATS_FRAME_SKIPS, for the thread calling frame_wait().
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+//  Types. --------------------------------------------------------------------
+
+struct frame_timer_t
+{
+    uint32_t interval;          // Frame interval while active (us).
+    uint32_t idle;              // Frame interval while idle (us).
+    bool     (*active)( void ); // Returns true if active, NULL if always.
+    struct timespec next;       // Next deadline.
+    bool     idling;            // Last frame was run at the idle interval.
+    uint64_t frames;            // Frames run.
+    uint64_t skipped;           // Deadlines skipped after overruns.
+    uint32_t late_max;          // Longest wake up after a deadline (us).
+};
+
+//  Functions. ----------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Initialises a frame timer. The first deadline is now.
+//  ---------------------------------------------------------------------------
+/*
+    idle = 0 runs at interval all the time.
+*/
+void frame_init( struct frame_timer_t *timer, uint32_t interval,
+                 uint32_t idle, bool (*active)( void ));
+
+//  ---------------------------------------------------------------------------
+//  Waits for the next frame deadline. Returns true if active.
+//  ---------------------------------------------------------------------------
+/*
+    Call once per frame before rendering. Signals don't cut the wait short,
+    so loops should be stopped with a flag checked after each frame.
+*/
+bool frame_wait( struct frame_timer_t *timer );
+
+#endif // #ifndef FRAMEPI_H
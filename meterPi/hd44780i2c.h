@@ -177,6 +177,7 @@
 #define BITS_NIBBLE        4 // Number of bits in a nibble.
 #define PINS_DATA          4 // Number of data pins used.
 #define HD44780_MAX        6 // Max number of displays (single MCP23017).
+#define HD44780_WALL_MAX   8 // Max displays flushed together, e.g. 0x20-0x27.
 #define TEXT_MAX_LENGTH  512 // Arbitrary length limit for text string.
 #define FRAMES_MAX         2 // Maximum animation frames.
 
@@ -227,6 +228,16 @@
 #define ADDRESS_ROW_1   0x40 // Row 2 start address.
 #define ADDRESS_ROW_2   0x14 // Row 3 start address.
 #define ADDRESS_ROW_3   0x54 // Row 4 start address.
+#define ADDRESS_UNKNOWN 0xff // Address counter not known.
+
+// Unchanged characters rewritten rather than moving the cursor.
+#define FLUSH_GAP          1
+
+// Execution times. Data sheet values are for 270kHz so allow for slower.
+#define DELAY_COMMAND     50 // Most commands and data writes, 37uS (uS).
+#define DELAY_HOME      1600 // Clear and home, 1.52mS (uS).
+#define BUSY_POLL_MIN    100 // Shortest delay worth polling busy flag (uS).
+#define BUSY_POLL_MAX     50 // Polls before falling back to delay.
 
 
 //  Mutex. --------------------------------------------------------------------
@@ -241,7 +252,24 @@ struct hd44780
     uint8_t rs;    // MCP23017 GPIOA pin address for HD44780 RS pin.
     uint8_t rw;    // MCP23017 GPIOA pin address for HD44780 R/W pin.
     uint8_t en;    // MCP23017 GPIOA pin address for HD44780 E pin.
+    bool    busyFlag;                             // Busy flag can be read.
+    uint8_t address;                              // DDRAM address counter.
+    uint8_t ddram[DISPLAY_ROWS][DISPLAY_COLUMNS]; // Shadow of display DDRAM.
+    uint8_t frame[DISPLAY_ROWS][DISPLAY_COLUMNS]; // Next frame to display.
+    struct  timespec ready;                       // Last write executed.
 };
+/*
+    busyFlag must only be set if R/W is wired to the MCP23017. If R/W is
+    grounded, as on many modules, delays from the data sheet are used.
+
+    ddram is a copy of the characters on the display, updated as bytes are
+    written, and frame holds the characters to be displayed by the next
+    hd44780Flush. Both are valid once hd44780Init has cleared the display.
+
+    ready is the time, on CLOCK_MONOTONIC, that the display will have
+    executed the last write. Writes return without waiting for it and the
+    next write to the same display waits for any time left instead.
+*/
 
 struct hd44780 *hd44780[HD44780_MAX];
 
@@ -314,6 +342,18 @@ void hd44780Enable( struct mcp23017 *mcp23017, struct hd44780 *hd44780 );
 int8_t hd44780WriteByte( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
                          uint8_t data, bool mode );
 
+//  ---------------------------------------------------------------------------
+//  Writes a sequence of command or data bytes (according to mode).
+//  ---------------------------------------------------------------------------
+/*
+    Bytes are sent as a batch of MCP23017 writes. This is a single I2C
+    message for the whole sequence if the MCP23017 is in byte mode with
+    IOCON.BANK = 0 and IOCON.SEQOP = 1. Clear and home should be written on
+    their own since they take longer to execute than the bus time.
+*/
+int8_t hd44780WriteBytes( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
+                          const uint8_t *data, uint16_t len, bool mode );
+
 //  ---------------------------------------------------------------------------
 //  Writes a data string to LCD.
 //  ---------------------------------------------------------------------------
@@ -331,6 +371,40 @@ int8_t hd44780WriteString( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
 int8_t hd44780Goto( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
                     uint8_t row, uint8_t pos );
 
+//  ---------------------------------------------------------------------------
+//  Writes characters into the next display frame.
+//  ---------------------------------------------------------------------------
+/*
+    Only updates the frame in memory so it can be called as often as needed.
+    Characters past the end of the row are dropped. The display is updated
+    by hd44780Flush.
+*/
+int8_t hd44780Print( struct hd44780 *hd44780, uint8_t row, uint8_t pos,
+                     const char *string, uint8_t len );
+
+//  ---------------------------------------------------------------------------
+//  Sends changed characters in the display frame to the display.
+//  ---------------------------------------------------------------------------
+/*
+    Only characters that differ from the shadow DDRAM are written, so a
+    mostly static display costs a few bytes per frame rather than a full
+    rewrite.
+*/
+int8_t hd44780Flush( struct mcp23017 *mcp23017, struct hd44780 *hd44780 );
+
+//  ---------------------------------------------------------------------------
+//  Sends changed characters to several displays, interleaving their runs.
+//  ---------------------------------------------------------------------------
+/*
+    For displays on different MCP23017s, or sharing one with separate E
+    pins. Each run goes to the display that will be ready soonest so the
+    bus writes to one display while the others execute, rather than idling
+    through each display's execution time in turn. Up to HD44780_WALL_MAX
+    displays.
+*/
+int8_t hd44780FlushMany( struct mcp23017 *mcp23017[],
+                         struct hd44780 *hd44780[], uint8_t count );
+
 //  Display init and mode functions. ------------------------------------------
 
 //  ---------------------------------------------------------------------------
@@ -458,5 +532,185 @@ struct customChars
 int8_t hd44780LoadCustom( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
                           const uint8_t newChar[CUSTOM_MAX][CUSTOM_SIZE] );
 
+//  ---------------------------------------------------------------------------
+//  CGRAM glyph cache.
+//  ---------------------------------------------------------------------------
+/*
+    Treats the 8 CGRAM slots as a cache keyed by glyph bitmap, so that
+    animations can use more than 8 glyphs without reloading the whole
+    character set. Each frame, request each glyph to be drawn with
+    hd44780Glyph and use the returned slot index as the display character.
+    A glyph already in CGRAM costs nothing. Otherwise the least recently
+    used slot is replaced and only the rows that differ from its old glyph
+    are sent.
+
+    Slots requested since the last hd44780GlyphFrame are not replaced, since
+    they may already be on the display, so up to 8 different glyphs can be
+    used per frame. Characters still on the display from older frames change
+    when their slot is replaced, so redraw the whole frame each time.
+*/
+struct hd44780Glyphs
+{
+    uint8_t  data[CUSTOM_MAX][CUSTOM_SIZE]; // Copy of CGRAM.
+    uint32_t used[CUSTOM_MAX];              // Frame each slot was last used.
+    uint32_t frame;                         // Current frame.
+    uint8_t  known;                         // Slots in data that are valid.
+};
+
+//  ---------------------------------------------------------------------------
+//  Initialises a glyph cache with CGRAM contents unknown.
+//  ---------------------------------------------------------------------------
+/*
+    Also call this after hd44780LoadCustom or hd44780Init.
+*/
+void hd44780GlyphInit( struct hd44780Glyphs *glyphs );
+
+//  ---------------------------------------------------------------------------
+//  Starts a new frame for a glyph cache.
+//  ---------------------------------------------------------------------------
+void hd44780GlyphFrame( struct hd44780Glyphs *glyphs );
+
+//  ---------------------------------------------------------------------------
+//  Returns the CGRAM slot for a glyph, uploading it if necessary.
+//  ---------------------------------------------------------------------------
+/*
+    Returns -1 if all slots are in use for this frame or the upload failed.
+    The address counter is left in CGRAM. hd44780Flush moves it back but use
+    hd44780Goto before writing to the display directly. Hold displayBusy if
+    a compositor or other thread shares the display.
+*/
+int8_t hd44780Glyph( struct mcp23017 *mcp23017, struct hd44780 *hd44780,
+                     struct hd44780Glyphs *glyphs,
+                     const uint8_t glyph[CUSTOM_SIZE] );
+
+
+//  Compositor. ---------------------------------------------------------------
+/*
+    A compositor owns a display so that widgets don't have to share it.
+    Each widget writes to its own region of the display by posting the new
+    contents to a queue, which never blocks. The compositor thread applies
+    all of the queued posts to the display frame and flushes it once per
+    tick, so only changed characters are sent and the cursor is moved once
+    per run of changes rather than once per widget. A slow widget can't
+    delay the others since the time for each tick is bounded by the number
+    of display characters.
+
+    Regions should all be added before the compositor thread is started.
+*/
+
+#define DISPLAY_REGIONS_MAX  8 // Max number of display regions.
+#define DISPLAY_QUEUE_SIZE  32 // Max number of queued posts.
+
+struct hd44780Region
+{
+    uint8_t row;   // Display row.
+    uint8_t col;   // Display column of start of region.
+    uint8_t width; // Number of characters.
+};
+
+struct hd44780Post
+{
+    uint32_t sequence;              // Queue slot sequence number.
+    uint8_t  region;                // Region index.
+    uint8_t  len;                   // Number of characters.
+    uint8_t  data[DISPLAY_COLUMNS]; // New region contents.
+};
+
+struct hd44780Compositor
+{
+    struct   mcp23017 *mcp23017;                    // MCP23017 instance.
+    struct   hd44780  *hd44780;                     // HD44780 instance.
+    struct   timeval  tick;                         // Time between flushes.
+    struct   hd44780Region region[DISPLAY_REGIONS_MAX]; // Display regions.
+    uint8_t  regions;                               // Number of regions.
+    struct   hd44780Post queue[DISPLAY_QUEUE_SIZE]; // Posted updates.
+    uint32_t head;                                  // Next post position.
+    uint32_t tail;                                  // Next compose position.
+    bool     running;                               // Thread keeps running.
+};
+
+//  ---------------------------------------------------------------------------
+//  Initialises a compositor for a display.
+//  ---------------------------------------------------------------------------
+int8_t hd44780CompositorInit( struct hd44780Compositor *compositor,
+                              struct mcp23017 *mcp23017,
+                              struct hd44780 *hd44780,
+                              struct timeval tick );
+
+//  ---------------------------------------------------------------------------
+//  Adds a display region. Returns the region index.
+//  ---------------------------------------------------------------------------
+/*
+    Regions are truncated at the end of the row. Returns -1 if there are
+    too many regions or the position is off the display.
+*/
+int8_t hd44780AddRegion( struct hd44780Compositor *compositor,
+                         uint8_t row, uint8_t col, uint8_t width );
+
+//  ---------------------------------------------------------------------------
+//  Posts new contents for a region without waiting.
+//  ---------------------------------------------------------------------------
+/*
+    The region is blanked and then filled with up to width characters. Can
+    be called from any thread. Returns -1 if the queue is full, in which
+    case the caller can simply post again next time.
+*/
+int8_t hd44780Post( struct hd44780Compositor *compositor, uint8_t region,
+                    const char *data, uint8_t len );
+
+//  ---------------------------------------------------------------------------
+//  Owns the display and flushes posted regions once per tick.
+//  ---------------------------------------------------------------------------
+void *displayCompositor( void *threadCompositor );
+
+//  ---------------------------------------------------------------------------
+//  Stops the compositor thread after its current tick.
+//  ---------------------------------------------------------------------------
+void hd44780CompositorStop( struct hd44780Compositor *compositor );
+
+//  Display wall. -------------------------------------------------------------
+/*
+    A wall is a single thread that owns several displays, each with its own
+    compositor, and flushes them together with hd44780FlushMany once per
+    tick. One I2C bus can then keep 4-8 displays, e.g. on MCP23017s at
+    0x20-0x27, updating at the rate of one. Compositors are set up with
+    hd44780CompositorInit and hd44780AddRegion as usual, and widgets post
+    to them in the same way, but only the wall thread is started.
+*/
+
+struct hd44780Wall
+{
+    struct  hd44780Compositor *compositor[HD44780_WALL_MAX]; // Displays.
+    struct  mcp23017 *mcp23017[HD44780_WALL_MAX]; // MCP23017 of each display.
+    struct  hd44780  *hd44780[HD44780_WALL_MAX];  // HD44780 of each display.
+    uint8_t displays;                              // Number of displays.
+    struct  timeval tick;                          // Time between flushes.
+    bool    running;                               // Thread keeps running.
+};
+
+//  ---------------------------------------------------------------------------
+//  Initialises a wall of displays.
+//  ---------------------------------------------------------------------------
+int8_t hd44780WallInit( struct hd44780Wall *wall, struct timeval tick );
+
+//  ---------------------------------------------------------------------------
+//  Adds a display's compositor to a wall. Returns the display index.
+//  ---------------------------------------------------------------------------
+/*
+    Returns -1 if the wall is full. Add all displays before the wall
+    thread is started.
+*/
+int8_t hd44780WallAdd( struct hd44780Wall *wall,
+                       struct hd44780Compositor *compositor );
+
+//  ---------------------------------------------------------------------------
+//  Owns the displays of a wall and flushes them together once per tick.
+//  ---------------------------------------------------------------------------
+void *displayWall( void *threadWall );
+
+//  ---------------------------------------------------------------------------
+//  Stops the wall thread after its current tick.
+//  ---------------------------------------------------------------------------
+void hd44780WallStop( struct hd44780Wall *wall );
 
 #endif
@@ -28,8 +28,12 @@
 /*
     For a shared library, compile with:
 
-        gcc -c -Wall -fpic meterPi.c -lm -lpthread -lrt -lasound -lncurses
-        gcc -shared -o libmeterPi.so meterPi.o
+        gcc -c -Wall -fpic -I../streamPi meterPi.c ../streamPi/capturePi.c \
+            -lm -lpthread -lrt -lasound -lncurses
+
+    Add -DSTATSPI and ../statsPi/statsPi.c to count meter frames and time
+    them, and the lock waits.
+        gcc -shared -o libmeterPi.so meterPi.o capturePi.o
 
     For Raspberry Pi v1 optimisation use the following flags:
 
@@ -59,6 +63,7 @@
 #include <stdint.h>
 #include <math.h>
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <stdlib.h>
@@ -66,11 +71,23 @@
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
+#include <poll.h>
 #include <net/if.h>
+#include <alsa/asoundlib.h>
+
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#include <arm_neon.h>
+#endif
 
 //  Local libraries -----------------------------------------------------------
 
 #include "meterPi.h"
+#include "capturePi.h"
+#include "streamPi.h"
+#include "../statsPi/statsPi.h"
+#include "../rtPi/rtPi.h"
 
 //  Types. --------------------------------------------------------------------
 
@@ -92,10 +109,98 @@ static struct vis_t
     int16_t  buffer[VIS_BUF_SIZE];
 }  *vis_mmap = NULL;
 
+/*
+    A contiguous run of interleaved frames within a source ring buffer.
+*/
+struct meter_span_t
+{
+    const void *ptr;   // First sample of span.
+    uint32_t   frames; // Number of interleaved frames in span.
+};
+
+/*
+    Squeezelite only updates buf_index once a block of samples has been
+    written, so samples just ahead of the index may be being written while
+    they are read. This many samples are kept clear of the read region.
+*/
+#define VIS_GUARD_SAMPLES 4096
+#define VIS_READ_RETRIES     2 // Retries before dropping a lapped frame.
+
+/*
+    The thx1138 capture daemon publishes a stream_vis_t, which starts with
+    the same fields as vis_t but has a bigger buffer of native samples. It
+    is recognised from the object size and the magic number after the
+    buffer, and then read through the same vis_t fields with the format,
+    buffer size and guard taken from the stream description. thx1138 sets
+    the magic number last, so the description can be read once it is seen.
+*/
+static size_t   vis_map_size = sizeof( struct vis_t ); // Size mapped.
+static uint32_t vis_buf_max  = VIS_BUF_SIZE;      // Buffer size (samples).
+static uint32_t vis_guard    = VIS_GUARD_SAMPLES; // Write guard (samples).
+static uint8_t  vis_format   = METER_S16;         // Sample format.
+
+static struct vis_stats_t vis_stats;
+static struct timespec    vis_lock_start;
+static bool               vis_lockfree = true;
+
+
+/*
+    The shared memory object is attached and detached by a watcher thread so
+    the meter loop only has to read the attached and playing flags. Readers
+    register themselves in vis_users while they use the mapping and the
+    watcher sets vis_detaching and waits for them to finish before it unmaps.
+*/
+#define VIS_SHM_DIR        "/dev/shm" // Where shm_open objects appear.
+#define VIS_SHM_PREFIX     "/squeezelite-"
+#define VIS_WATCH_INTERVAL  100 // Status check interval (ms).
+#define VIS_STALE_TIME        5 // Time without update before stale (s).
+
+static int       vis_fd = -1;
+static char      *mac_address = NULL;
+static char      vis_shm_name[40];  // Shared memory object name.
+static pthread_t vis_watcher;       // Attach manager thread.
+static bool      vis_watching;      // Attach manager is running.
+static bool      vis_playing;       // Attached and stream running.
+static bool      vis_detaching;     // Mapping is about to be removed.
+static uint32_t  vis_users;         // Readers using the mapping.
+static bool      vis_named;         // Name set by meter_use_stream.
+static bool      vis_unready;       // Stream found before its magic was set.
+
+static struct capture_t alsa_capture; // ALSA capture source.
+
+/*
+    Table of log2( 1 + i / 2^METER_LOG2_BITS ) in Q16 fixed point for the
+    integer dB conversion, with an extra entry for interpolation.
+*/
+#define METER_LOG2_BITS 8
+#define METER_LOG2_SIZE ( 1 << METER_LOG2_BITS )
+
+static uint32_t meter_log2[METER_LOG2_SIZE + 1];
+static bool     meter_log2_ready = false;
+
+#define METER_MAX_DELTA 10000000 // Longest time between updates (us).
+
+/*
+    4 times oversampling polyphase FIR filter from ITU-R BS.1770-4 Annex 2.
+    The coefficients are exact multiples of 2^-13 so they are held exactly
+    in Q14. The largest sum of a phase's coefficients is about 2.02 so the
+    filter output for 16-bit input fits in a 32-bit accumulator.
+*/
+#define METER_TP_PHASES     4
+#define METER_TP_CHUNK     64 // Frames filtered at a time.
+#define METER_TP_FULL_SCALE ( 32767 << 14 ) // Full scale output in Q14.
 
-static bool running = false;
-static int  vis_fd = -1;
-static char *mac_address = NULL;
+static const int16_t meter_tp_coefs[METER_TP_PHASES][METER_TP_TAPS] =
+{
+    {    28,   180,  -322,   544,  -974,  2250,
+      15928, -1676,   780,  -436,   244,  -136 },
+    {  -478,   480,  -848,  1460, -2728,  7620,
+      12776, -3282,  1664,  -954,   542,  -310 },
+    {  -310,   542,  -954,  1664, -3282, 12776,
+       7620, -2728,  1460,  -848,   480,  -478 },
+    {  -136,   244,  -436,   780, -1676, 15928,
+       2250,  -974,   544,  -322,   180,    28 }
+};
 
 //  Functions. ----------------------------------------------------------------
 
@@ -165,108 +270,268 @@ static char *get_mac_address()
 }
 
 //  ---------------------------------------------------------------------------
-//  Reopens squeezelite shared memory and maps memory block.
+//  Determines the name of the squeezelite shared memory object.
 //  ---------------------------------------------------------------------------
-static void reopen( void )
 /*
-    Jivelite code.
+    The shared memory object is defined by Squeezelite and is identified by a
+    name made up from the MAC address. This only needs to be worked out once.
 */
+static void vis_get_name( void )
 {
-	char shm_path[40];
+    if ( !mac_address ) mac_address = get_mac_address();
 
-    // Unmap memory if it is already mapped.
-	if ( vis_mmap )
-	{
-		munmap( vis_mmap, sizeof( struct vis_t ));
-		vis_mmap = NULL;
-	}
+    snprintf( vis_shm_name, sizeof( vis_shm_name ), "%s%s",
+              VIS_SHM_PREFIX, mac_address ? mac_address : "" );
+}
 
-    // Close file access if it exists.
-	if ( vis_fd != -1 )
-	{
-		close( vis_fd );
-		vis_fd = -1;
-	}
+//  ---------------------------------------------------------------------------
+//  Opens squeezelite shared memory and maps memory block.
+//  ---------------------------------------------------------------------------
+/*
+    Based on the Jivelite reopen code. The object is created by Squeezelite
+    before it is sized, so it isn't mapped until it is big enough.
+*/
+static bool vis_map( void )
+{
+    struct vis_t *map;
+    struct stream_vis_t *stream;
+    struct stat  st;
+    size_t       size = sizeof( struct vis_t );
+    int          fd;
 
-    // Get MAC adddress if not already determined.
-	if ( !mac_address )
-	{
-		mac_address = get_mac_address();
-	}
+    if ( vis_mmap ) return true;
+    vis_unready = false;
 
-    /*
-        The shared memory object is defined by Squeezelite and is identified
-        by a name made up from the MAC address.
-    */
-	sprintf( shm_path, "/squeezelite-%s", mac_address ? mac_address : "" );
+    fd = shm_open( vis_shm_name, O_RDWR, 0666 );
+    if ( fd < 0 ) return false;
+
+    if (( fstat( fd, &st ) < 0 ) ||
+        ( st.st_size < (off_t) sizeof( struct vis_t )))
+    {
+        close( fd );
+        return false;
+    }
+
+    if ( st.st_size >= (off_t) sizeof( struct stream_vis_t ))
+        size = sizeof( struct stream_vis_t );
+
+    map = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    if ( map == MAP_FAILED )
+    {
+        close( fd );
+        return false;
+    }
 
-    // Open shared memory.
-	vis_fd = shm_open( shm_path, O_RDWR, 0666 );
-	if ( vis_fd > 0 )
-	{
-        // Map memory.
-        vis_mmap = mmap( NULL, sizeof( struct vis_t ),
-                         PROT_READ | PROT_WRITE,
-                         MAP_SHARED, vis_fd, 0 );
+    // Only thx1138 makes an object this big, so wait for it to be set up.
+    stream = (struct stream_vis_t *) map;
+    vis_unready = (( size == sizeof( struct stream_vis_t )) &&
+                   ( __atomic_load_n( &stream->magic, __ATOMIC_ACQUIRE ) !=
+                     STREAM_MAGIC ));
+    if ( vis_unready )
+    {
+        munmap( map, size );
+        close( fd );
+        return false;
+    }
 
-        if ( vis_mmap == MAP_FAILED )
+    vis_buf_max = VIS_BUF_SIZE;
+    vis_guard   = VIS_GUARD_SAMPLES;
+    vis_format  = METER_S16;
+
+    if ( size == sizeof( struct stream_vis_t ))
+    {
+        // Only interleaved frames of the metered channels can be read.
+        if (( stream->version != STREAM_VERSION ) ||
+            ( stream->channels != METER_CHANNELS ) ||
+            ( stream->format > STREAM_S32 ))
         {
-            close( vis_fd );
-            vis_fd = -1;
-            vis_mmap = NULL;
+            munmap( map, size );
+            close( fd );
+            return false;
         }
+        vis_buf_max = sizeof( stream->buffer ) /
+                      (( stream->format == STREAM_S16 ) ? sizeof( int16_t ) :
+                                                          sizeof( int32_t ));
+        vis_guard   = stream->period * METER_CHANNELS;
+        vis_format  = stream->format;
     }
+    else if ( METER_CHANNELS != 2 )
+    {
+        // Squeezelite's own buffer is always stereo.
+        munmap( map, size );
+        close( fd );
+        return false;
+    }
+
+    vis_map_size = size;
+    vis_fd = fd;
+    __atomic_store_n( &vis_mmap, map, __ATOMIC_SEQ_CST );
+
+    return true;
 }
 
 //  ---------------------------------------------------------------------------
-//  Checks status of mmap and attempt to open/reopen if not updated recently.
+//  Unmaps squeezelite shared memory once no readers are using it.
 //  ---------------------------------------------------------------------------
-void vis_check( void )
-/*
-    Jivelite code.
-    This function maps the shared memory object if it has not already done so
-    within the last 5 seconds.
-    The buffer can contain 16384 samples, which at the highest sample rate of
-    384kHz, is enough for around 42ms. This increases to 371ms for 44.1kHz.
-    Shouldn't the shared memory object be mapped more frequently?
-*/
+static void vis_unmap( void )
+{
+    struct vis_t *map = vis_mmap;
+
+    if ( !map ) return;
+
+    __atomic_store_n( &vis_playing, false, __ATOMIC_SEQ_CST );
+    __atomic_store_n( &vis_detaching, true, __ATOMIC_SEQ_CST );
+
+    // Wait for any reader to finish with the mapping.
+    while ( __atomic_load_n( &vis_users, __ATOMIC_SEQ_CST ) > 0 )
+        usleep( 100 );
+
+    __atomic_store_n( &vis_mmap, NULL, __ATOMIC_SEQ_CST );
+    munmap( map, vis_map_size );
+    close( vis_fd );
+    vis_fd = -1;
+
+    __atomic_store_n( &vis_detaching, false, __ATOMIC_SEQ_CST );
+}
+
+//  ---------------------------------------------------------------------------
+//  Registers a reader of the mapping. Returns false if not mapped.
+//  ---------------------------------------------------------------------------
+static bool vis_acquire( void )
 {
-    static time_t lastopen = 0;
-    time_t now = time( NULL );
+    __atomic_add_fetch( &vis_users, 1, __ATOMIC_SEQ_CST );
 
-    if ( !vis_mmap )
+    if (( __atomic_load_n( &vis_detaching, __ATOMIC_SEQ_CST )) ||
+        ( __atomic_load_n( &vis_mmap, __ATOMIC_SEQ_CST ) == NULL ))
     {
-        if ( now - lastopen > 5 )
-        {
-            reopen();
-            lastopen = now;
-        }
-        if ( !vis_mmap ) return;
+        __atomic_sub_fetch( &vis_users, 1, __ATOMIC_SEQ_CST );
+        return false;
     }
 
-    pthread_rwlock_rdlock( &vis_mmap->rwlock );
+    return true;
+}
+
+//  ---------------------------------------------------------------------------
+//  Releases a reader of the mapping.
+//  ---------------------------------------------------------------------------
+static void vis_release( void )
+{
+    __atomic_sub_fetch( &vis_users, 1, __ATOMIC_SEQ_CST );
+}
+
+//  ---------------------------------------------------------------------------
+//  Updates the playing flag and detaches from a stale mapping.
+//  ---------------------------------------------------------------------------
+/*
+    This runs in the watcher thread at a low rate rather than on every meter
+    frame. The lock is taken directly so it isn't counted in the meter's lock
+    statistics.
+*/
+static void vis_update_status( void )
+{
+    bool   running;
+    time_t updated;
+
+    if ( !vis_mmap ) return;
 
+    pthread_rwlock_rdlock( &vis_mmap->rwlock );
     running = vis_mmap->running;
+    updated = vis_mmap->updated;
+    pthread_rwlock_unlock( &vis_mmap->rwlock );
 
-    if ( running && now - vis_mmap->updated > 5 )
+    if ( running && time( NULL ) - updated > VIS_STALE_TIME )
     {
-        pthread_rwlock_unlock(&vis_mmap->rwlock );
-        reopen();
-        lastopen = now;
-    } else
-    {
-        pthread_rwlock_unlock( &vis_mmap->rwlock );
+        // Player has gone away or restarted with a new object.
+        vis_unmap();
+        vis_map();
+        return;
     }
+
+    __atomic_store_n( &vis_playing, running, __ATOMIC_SEQ_CST );
 }
 
+//  ---------------------------------------------------------------------------
+//  Attach manager. Watches for the shared memory object and its status.
+//  ---------------------------------------------------------------------------
+/*
+    inotify on /dev/shm reports when Squeezelite creates, sizes or removes its
+    shared memory object so it is attached as soon as it appears. If inotify
+    isn't available, the object is looked for at the status check interval.
+*/
+static void *vis_watch( void *arg )
+{
+    char   events[4096]
+           __attribute__(( aligned( __alignof__( struct inotify_event ))));
+    struct inotify_event *event;
+    struct pollfd pfd;
+    ssize_t len;
+    char    *ptr;
+    int     wd = -1;
+
+    (void) arg;
+
+    // Inherits the creator's scheduling, which may be the meter role.
+    rtThread( RT_UI );
+
+    pfd.events = POLLIN;
+    pfd.fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+    if ( pfd.fd >= 0 )
+        wd = inotify_add_watch( pfd.fd, VIS_SHM_DIR,
+                                IN_CREATE | IN_MODIFY | IN_ATTRIB |
+                                IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE );
+
+    // The player may already be running.
+    vis_map();
+    vis_update_status();
+
+    while ( __atomic_load_n( &vis_watching, __ATOMIC_SEQ_CST ))
+    {
+        if ( poll( &pfd, ( wd >= 0 ) ? 1 : 0, VIS_WATCH_INTERVAL ) > 0 )
+        {
+            while (( len = read( pfd.fd, events, sizeof( events ))) > 0 )
+            {
+                for ( ptr = events; ptr < events + len;
+                      ptr += sizeof( struct inotify_event ) + event->len )
+                {
+                    event = (struct inotify_event *) ptr;
+
+                    // Only interested in our object (name without '/').
+                    if (( event->len == 0 ) ||
+                        ( strcmp( event->name, vis_shm_name + 1 ) != 0 ))
+                        continue;
+
+                    if ( event->mask & ( IN_DELETE | IN_MOVED_FROM ))
+                        vis_unmap();
+                    else
+                        vis_map();
+                }
+            }
+        }
+        else if ( wd < 0 ) vis_map();
+
+        // Setting up the stream description doesn't raise an event.
+        if ( vis_unready ) vis_map();
+
+        vis_update_status();
+    }
+
+    if ( pfd.fd >= 0 ) close( pfd.fd );
+    vis_unmap();
+
+    return NULL;
+}
 
 //  ---------------------------------------------------------------------------
 //  Locks the memory mapping thread.
 //  ---------------------------------------------------------------------------
 static void vis_lock( void )
 {
+    uint64_t start = statsTime();
+
     if ( !vis_mmap ) return;
     pthread_rwlock_rdlock( &vis_mmap->rwlock );
+    clock_gettime( CLOCK_MONOTONIC, &vis_lock_start );
+    statsSince( STATS_LOCK_WAIT, start );
 }
 
 //  ---------------------------------------------------------------------------
@@ -274,8 +539,139 @@ static void vis_lock( void )
 //  ---------------------------------------------------------------------------
 static void vis_unlock( void )
 {
+    struct timespec now;
+    uint32_t hold;
+
     if ( !vis_mmap ) return;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
     pthread_rwlock_unlock( &vis_mmap->rwlock );
+
+    // Record lock hold time.
+    hold = ( now.tv_sec  - vis_lock_start.tv_sec ) * 1000000000 +
+           ( now.tv_nsec - vis_lock_start.tv_nsec );
+    vis_stats.locks++;
+    vis_stats.hold_last   = hold;
+    vis_stats.hold_total += hold;
+    if ( hold > vis_stats.hold_max ) vis_stats.hold_max = hold;
+}
+
+//  ---------------------------------------------------------------------------
+//  Copies the shared buffer state. Must be called with the lock held.
+//  ---------------------------------------------------------------------------
+static void vis_copy_state( struct meter_ring_t *ring )
+{
+    ring->buffer  = vis_mmap->buffer;
+    ring->size    = vis_mmap->buf_size;
+    ring->index   = vis_mmap->buf_index;
+    ring->guard   = vis_guard;
+    ring->rate    = vis_mmap->rate;
+    ring->format  = vis_format;
+    ring->running = vis_mmap->running;
+
+    // Size is set by the writer so don't trust it beyond the buffer.
+    if ( ring->size > vis_buf_max ) ring->size = vis_buf_max;
+}
+
+//  ---------------------------------------------------------------------------
+//  Takes a snapshot of the shared buffer state, holding the lock briefly.
+//  ---------------------------------------------------------------------------
+static void vis_snapshot( struct meter_ring_t *ring )
+{
+    vis_lock();
+    vis_copy_state( ring );
+    vis_unlock();
+}
+
+//  ---------------------------------------------------------------------------
+//  Locks the shared buffer for a whole read and copies its state.
+//  ---------------------------------------------------------------------------
+static void vis_lock_state( struct meter_ring_t *ring )
+{
+    vis_lock();
+    vis_copy_state( ring );
+}
+
+//  ---------------------------------------------------------------------------
+//  Checks whether the writer has overwritten samples read without the lock.
+//  ---------------------------------------------------------------------------
+/*
+    extent is the number of frames behind the snapshot index that were read.
+    The writer moves forward from the snapshot index so the read is only
+    valid if it hasn't written far enough to reach the oldest frame read,
+    allowing for a block that may be in the middle of being written. A writer
+    that has gone round exactly one whole buffer can't be detected from the
+    index, but at any sample rate that is tens of milliseconds behind.
+*/
+static bool vis_lapped( const struct meter_ring_t *ring, uint32_t extent )
+{
+    uint32_t idx, written;
+
+    // Make sure the samples have been read before looking at the index.
+    __atomic_thread_fence( __ATOMIC_ACQUIRE );
+    idx = __atomic_load_n( &vis_mmap->buf_index, __ATOMIC_RELAXED );
+
+    if ( idx >= ring->size ) return true;
+
+    written = ( idx + ring->size - ring->index ) % ring->size;
+
+    return ( written + ring->guard +
+             extent * METER_CHANNELS > ring->size );
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns shared buffer lock statistics.
+//  ---------------------------------------------------------------------------
+void vis_get_stats( struct vis_stats_t *stats )
+{
+    *stats = vis_stats;
+}
+
+//  ---------------------------------------------------------------------------
+//  Resets shared buffer lock statistics.
+//  ---------------------------------------------------------------------------
+void vis_reset_stats( void )
+{
+    memset( &vis_stats, 0, sizeof( vis_stats ));
+}
+
+//  ---------------------------------------------------------------------------
+//  Selects lock free (snapshot) or locked reading of the shared buffer.
+//  ---------------------------------------------------------------------------
+void vis_set_lockfree( bool lockfree )
+{
+    vis_lockfree = lockfree;
+}
+
+//  ---------------------------------------------------------------------------
+//  Starts the shared memory attach manager if it isn't already running.
+//  ---------------------------------------------------------------------------
+/*
+    The buffer can contain 16384 samples, which at the highest sample rate of
+    384kHz, is enough for around 42ms. This increases to 371ms for 44.1kHz.
+    After the first call this only costs a flag check so it is safe to call
+    on every meter frame.
+*/
+void vis_check( void )
+{
+    if ( vis_watching ) return;
+
+    if ( !vis_named ) vis_get_name();
+
+    vis_watching = true;
+    if ( pthread_create( &vis_watcher, NULL, vis_watch, NULL ) != 0 )
+        vis_watching = false;
+}
+
+//  ---------------------------------------------------------------------------
+//  Stops the attach manager and unmaps shared memory.
+//  ---------------------------------------------------------------------------
+void vis_close( void )
+{
+    if ( !vis_watching ) return;
+
+    __atomic_store_n( &vis_watching, false, __ATOMIC_SEQ_CST );
+    pthread_join( vis_watcher, NULL );
 }
 
 //  ---------------------------------------------------------------------------
@@ -283,8 +679,15 @@ static void vis_unlock( void )
 //  ---------------------------------------------------------------------------
 static bool vis_get_playing( void )
 {
-    if ( !vis_mmap ) return false;
-    return running;
+    return __atomic_load_n( &vis_playing, __ATOMIC_RELAXED );
+}
+
+//  ---------------------------------------------------------------------------
+//  Registers a reader if the stream is playing.
+//  ---------------------------------------------------------------------------
+static bool vis_acquire_playing( void )
+{
+    return ( vis_get_playing() && vis_acquire() );
 }
 
 //  ---------------------------------------------------------------------------
@@ -292,175 +695,2157 @@ static bool vis_get_playing( void )
 //  ---------------------------------------------------------------------------
 uint32_t vis_get_rate( void )
 {
-    if ( !vis_mmap ) return 0;
-    return vis_mmap->rate;
+    uint32_t rate;
+
+    if ( !vis_acquire() ) return 0;
+    rate = vis_mmap->rate;
+    vis_release();
+
+    return rate;
 }
 
+/*
+    Squeezelite shared memory source.
+*/
+static const struct meter_source_t vis_source =
+{
+    .start    = vis_check,
+    .acquire  = vis_acquire_playing,
+    .release  = vis_release,
+    .snapshot = vis_snapshot,
+    .lapped   = vis_lapped,
+    .lock     = vis_lock_state,
+    .unlock   = vis_unlock,
+    .stop     = vis_close,
+    .get_rate = vis_get_rate
+};
+
 //  ---------------------------------------------------------------------------
-//  Returns the shared audio buffer.
+//  Does nothing. The capture device is started when it is opened.
 //  ---------------------------------------------------------------------------
-static int16_t *vis_get_buffer( void )
+static void alsa_start( void )
 {
-    if ( !vis_mmap ) return NULL;
-    return vis_mmap->buffer;
 }
 
 //  ---------------------------------------------------------------------------
-//  Returns the length of the shared audio buffer.
+//  Registers a reader if the capture device is open.
 //  ---------------------------------------------------------------------------
-static uint32_t vis_get_buffer_len( void )
+/*
+    Capture is driven from the meter thread so there is nothing to register.
+*/
+static bool alsa_acquire( void )
 {
-    if ( !vis_mmap ) return 0;
-    return vis_mmap->buf_size;
+    return ( alsa_capture.pcm != NULL );
 }
 
 //  ---------------------------------------------------------------------------
-//  Returns the index into the shared audio buffer.
+//  Releases a reader.
 //  ---------------------------------------------------------------------------
-static uint32_t vis_get_buffer_idx( void )
+static void alsa_release( void )
 {
-    if ( !vis_mmap ) return 0;
-    return vis_mmap->buf_index;
 }
 
 //  ---------------------------------------------------------------------------
-//  Calculates peak dBfs values (L & R) of a number of stream samples.
+//  Consumes captured frames and copies the capture ring buffer state.
 //  ---------------------------------------------------------------------------
-void get_dBfs( struct peak_meter_t *peak_meter )
+/*
+    The frames are read in place from the mmap area so nothing is copied.
+    The hardware may be part way through writing the period after the index
+    so that is kept clear of the read region.
+*/
+static void alsa_snapshot( struct meter_ring_t *ring )
 {
-	int16_t  *ptr;
-	int16_t  sample;
-	uint64_t sample_squared[METER_CHANNELS];
-	uint16_t sample_rms[METER_CHANNELS];
-    uint8_t  channel;
-	size_t   i, wrap;
-	int      offs;
+    capture_update( &alsa_capture );
 
-	vis_check();
+    ring->buffer  = alsa_capture.base;
+    ring->size    = alsa_capture.buffer * METER_CHANNELS;
+    ring->index   = alsa_capture.index  * METER_CHANNELS;
+    ring->guard   = alsa_capture.period * METER_CHANNELS;
+    ring->rate    = alsa_capture.rate;
+    ring->running = ( alsa_capture.running && alsa_capture.base != NULL );
 
-    for ( channel = 0; channel < METER_CHANNELS; channel++ )
-        sample_squared[channel] = 0;
+    switch ( alsa_capture.format )
+    {
+        case SND_PCM_FORMAT_S32_LE: ring->format = METER_S32; break;
+        case SND_PCM_FORMAT_S24_LE: ring->format = METER_S24; break;
+        default:                    ring->format = METER_S16; break;
+    }
+}
 
-	if ( vis_get_playing() )
-	{
-		vis_lock();
+//  ---------------------------------------------------------------------------
+//  Checks whether the hardware has overwritten the frames read.
+//  ---------------------------------------------------------------------------
+/*
+    Frames available since the snapshot are frames the hardware has written
+    over the oldest part of the ring buffer.
+*/
+static bool alsa_lapped( const struct meter_ring_t *ring, uint32_t extent )
+{
+    int written;
 
-		offs = vis_get_buffer_idx() - ( peak_meter->samples * METER_CHANNELS );
-		while ( offs < 0 ) offs += vis_get_buffer_len();
+    __atomic_thread_fence( __ATOMIC_ACQUIRE );
+    written = capture_avail( &alsa_capture );
+    if ( written < 0 ) return true;
 
-		ptr = vis_get_buffer() + offs;
-		wrap = vis_get_buffer_len() - offs;
+    return ((uint32_t) written * METER_CHANNELS + ring->guard +
+            extent * METER_CHANNELS > ring->size );
+}
 
-		for ( i = 0; i < peak_meter->samples; i++ )
-		{
-            for ( channel = 0; channel < METER_CHANNELS; channel++ )
-            {
-			    sample = *ptr++;
-                sample_squared[channel] += sample * sample;
-            }
-            // Check for buffer wrap and refresh if necessary.
-			wrap -= 2;
-			if ( wrap <= 0 )
-			{
-				ptr = vis_get_buffer();
-				wrap = vis_get_buffer_len();
-			}
-		}
-		vis_unlock();
-	}
+//  ---------------------------------------------------------------------------
+//  Closes the capture device.
+//  ---------------------------------------------------------------------------
+static void alsa_stop( void )
+{
+    capture_close( &alsa_capture );
+}
 
-    for ( channel = 0; channel < METER_CHANNELS; channel++ )
-    {
-        sample_rms[channel] = round( sqrt( sample_squared[channel] ));
-        peak_meter->dBfs[channel] = 20 * log10( (float) sample_rms[channel] /
-                                                (float) peak_meter->reference );
-        if ( peak_meter->dBfs[channel] < peak_meter->floor )
-        {
-             peak_meter->dBfs[channel] = peak_meter->floor;
-        }
-    }
+//  ---------------------------------------------------------------------------
+//  Returns the capture sample rate.
+//  ---------------------------------------------------------------------------
+static uint32_t alsa_get_rate( void )
+{
+    if ( alsa_capture.pcm == NULL ) return 0;
+    return alsa_capture.rate;
 }
 
+/*
+    ALSA mmap capture source. There is no lock shared with the hardware so
+    every read is lock free.
+*/
+static const struct meter_source_t alsa_source =
+{
+    .start    = alsa_start,
+    .acquire  = alsa_acquire,
+    .release  = alsa_release,
+    .snapshot = alsa_snapshot,
+    .lapped   = alsa_lapped,
+    .lock     = NULL,
+    .unlock   = NULL,
+    .stop     = alsa_stop,
+    .get_rate = alsa_get_rate
+};
+
+static const struct meter_source_t *meter_source = &vis_source;
 
 //  ---------------------------------------------------------------------------
-//  Calculates the indices for string representations of the peak levels.
+//  Selects the source to be metered.
 //  ---------------------------------------------------------------------------
-void get_dB_indices( struct peak_meter_t *peak_meter )
+void meter_set_source( const struct meter_source_t *source )
 {
-    uint8_t         channel;
-    uint8_t         i;
-    static bool     falling = false;
-    static uint16_t hold_inc[METER_CHANNELS] = { 0, 0 };
-    static uint16_t fall_inc[METER_CHANNELS] = { 0, 0 };
-    static uint16_t over_inc[METER_CHANNELS] = { 0, 0 };
-    static uint8_t  over_cnt[METER_CHANNELS] = { 0, 0 };
+    if (( source == NULL ) || ( source == meter_source )) return;
 
-    for ( channel = 0; channel < METER_CHANNELS; channel++ )
+    meter_source->stop();
+    meter_source = source;
+}
+
+//  ---------------------------------------------------------------------------
+//  Meters the Squeezelite shared memory buffer.
+//  ---------------------------------------------------------------------------
+void meter_use_vis( void )
+{
+    if ( vis_named )
     {
-        // Overload check;
-        if ( peak_meter->dBfs[channel] == 0 )
-        {
-            over_cnt[channel]++;
-            if ( over_cnt[channel] > peak_meter->over_peaks )
-            {
-                peak_meter->overload[channel] = true;
-                over_inc[channel] = 0;
-            }
-        }
-        else over_cnt[channel] = 0;
+        vis_close();
+        vis_named = false;
+    }
+    meter_set_source( &vis_source );
+}
 
-        // Countdown for overload reset.
-        if ( peak_meter->overload[channel] )
-        {
-            if ( over_inc[channel] > peak_meter->over_incs )
-            {
-                peak_meter->overload[channel] = false;
-                over_inc[channel] = 0;
-            }
-            else over_inc[channel]++;
-        }
-        // Concatenate output meter string.
-        for ( i = 0; i < peak_meter->num_levels; i++ )
-        {
-            if ( peak_meter->dBfs[channel] <= peak_meter->scale[i] )
-            {
-                peak_meter->bar_index[channel] = i;
-                if ( i > peak_meter->dot_index[channel] )
-                {
-                    peak_meter->dot_index[channel] = i;
-                    peak_meter->elapsed[channel] = 0;
-                    falling = false;
-                    hold_inc[channel] = 0;
-                    fall_inc[channel] = 0;
-                }
-                else
-                {
-                    i = peak_meter->num_levels;
-                }
-            }
-        }
+//  ---------------------------------------------------------------------------
+//  Meters a stream published by the thx1138 capture daemon.
+//  ---------------------------------------------------------------------------
+void meter_use_stream( const char *name )
+{
+    if ( name == NULL ) name = STREAM_SHM_NAME;
 
-        // Rudimentary peak hold routine until proper timing is introduced.
-        if ( falling )
-        {
-            fall_inc[channel]++;
-            if ( fall_inc[channel] >= peak_meter->fall_incs )
-            {
-                fall_inc[channel] = 0;
-                if ( peak_meter->dot_index[channel] > 0 )
-                     peak_meter->dot_index[channel]--;
-            }
-        }
-        else
-        {
-            hold_inc[channel]++;
-            if ( hold_inc[channel] >= peak_meter->hold_incs )
-            {
-                hold_inc[channel] = 0;
-                falling = true;
-                if ( peak_meter->dot_index[channel] > 0 )
-                     peak_meter->dot_index[channel]--;
-            }
-        }
+    if (( vis_named ) && ( strcmp( name, vis_shm_name ) == 0 ))
+    {
+        meter_set_source( &vis_source );
+        return;
     }
+
+    vis_close();
+    snprintf( vis_shm_name, sizeof( vis_shm_name ), "%s", name );
+    vis_named = true;
+    meter_set_source( &vis_source );
+}
+
+//  ---------------------------------------------------------------------------
+//  Meters an ALSA capture device.
+//  ---------------------------------------------------------------------------
+bool meter_use_alsa( const char *device, uint32_t rate,
+                     uint32_t period, uint32_t buffer )
+{
+    if ( meter_source == &alsa_source ) alsa_stop();
+
+    if ( capture_open( &alsa_capture, device, rate, METER_CHANNELS,
+                       period, buffer ) < 0 )
+        return false;
+
+    meter_set_source( &alsa_source );
+
+    return true;
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns the sample rate of the current source.
+//  ---------------------------------------------------------------------------
+uint32_t meter_get_rate( void )
+{
+    return meter_source->get_rate();
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns true if the current source is running.
+//  ---------------------------------------------------------------------------
+bool meter_get_playing( void )
+{
+    struct meter_ring_t ring;
+
+    if ( !meter_source->acquire() ) return false;
+    meter_source->snapshot( &ring );
+    meter_source->release();
+
+    return ring.running;
+}
+
+//  ---------------------------------------------------------------------------
+//  Stops the current source.
+//  ---------------------------------------------------------------------------
+void meter_close( void )
+{
+    meter_source->stop();
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns the bytes per sample of a source format.
+//  ---------------------------------------------------------------------------
+static uint8_t meter_format_bytes( uint8_t format )
+{
+    return ( format == METER_S16 ) ? sizeof( int16_t ) : sizeof( int32_t );
+}
+
+//  ---------------------------------------------------------------------------
+//  Splits a run of frames into contiguous spans either side of wrap.
+//  ---------------------------------------------------------------------------
+/*
+    The run ends at buffer index end and extends backwards by the requested
+    number of frames. If it straddles the end of the ring buffer it is
+    returned as two spans, the oldest first. Returns the number of spans.
+*/
+static uint8_t meter_get_spans( const struct meter_ring_t *ring,
+                                uint32_t end, uint32_t frames,
+                                struct meter_span_t *span )
+{
+    const uint8_t *buffer = ring->buffer;
+    uint32_t len   = ring->size;
+    uint32_t size  = frames * METER_CHANNELS;
+    uint8_t  bytes = meter_format_bytes( ring->format );
+    uint32_t offs;
+
+    if (( buffer == NULL ) || ( len < METER_CHANNELS ) || ( size == 0 ))
+        return 0;
+
+    // Run can't be longer than the buffer.
+    if ( size > len ) size = len - ( len % METER_CHANNELS );
+    if ( end >= len ) end %= len;
+
+    offs = ( end >= size ) ? end - size : end + len - size;
+
+    if ( offs + size <= len )
+    {
+        span[0].ptr    = buffer + offs * bytes;
+        span[0].frames = size / METER_CHANNELS;
+        return 1;
+    }
+
+    span[0].ptr    = buffer + offs * bytes;
+    span[0].frames = ( len - offs ) / METER_CHANNELS;
+    span[1].ptr    = buffer;
+    span[1].frames = ( size / METER_CHANNELS ) - span[0].frames;
+
+    return 2;
+}
+
+//  ---------------------------------------------------------------------------
+//  Accumulates sum of squares and absolute peak for a 16-bit span.
+//  ---------------------------------------------------------------------------
+/*
+    The samples are interleaved so a single pass deinterleaves the channels
+    and accumulates both the energy and peak values. There is no per sample
+    check for the ring buffer wrap as this is handled by meter_get_spans.
+
+    With NEON, 8 stereo frames are loaded and deinterleaved at a time. The
+    32-bit squares (< 2^30) are pairwise accumulated into 64-bit lanes so
+    there is no danger of overflow for any window that fits in the buffer.
+    The absolute value of -32768 wraps to 0x8000, which is still correct when
+    treated as unsigned.
+*/
+static void integrate_span_s16( const int16_t *ptr, uint32_t frames,
+                                uint64_t sum[METER_CHANNELS],
+                                uint32_t peak[METER_CHANNELS] )
+{
+    uint64_t acc[METER_CHANNELS];
+    uint32_t max[METER_CHANNELS];
+    int32_t  sample;
+    uint32_t i = 0;
+
+#if ( defined( __ARM_NEON ) || defined( __ARM_NEON__ )) && METER_CHANNELS == 2
+    uint64x2_t sum_l  = vdupq_n_u64( 0 );
+    uint64x2_t sum_r  = vdupq_n_u64( 0 );
+    uint16x8_t peak_l = vdupq_n_u16( 0 );
+    uint16x8_t peak_r = vdupq_n_u16( 0 );
+    uint16x4_t peak_n;
+    int16x8x2_t lr;
+
+    for ( ; i + 8 <= frames; i += 8 )
+    {
+        lr = vld2q_s16( ptr );
+        ptr += 16;
+
+        sum_l = vpadalq_u32( sum_l, vreinterpretq_u32_s32(
+                vmull_s16( vget_low_s16( lr.val[0] ),
+                           vget_low_s16( lr.val[0] ))));
+        sum_l = vpadalq_u32( sum_l, vreinterpretq_u32_s32(
+                vmull_s16( vget_high_s16( lr.val[0] ),
+                           vget_high_s16( lr.val[0] ))));
+        sum_r = vpadalq_u32( sum_r, vreinterpretq_u32_s32(
+                vmull_s16( vget_low_s16( lr.val[1] ),
+                           vget_low_s16( lr.val[1] ))));
+        sum_r = vpadalq_u32( sum_r, vreinterpretq_u32_s32(
+                vmull_s16( vget_high_s16( lr.val[1] ),
+                           vget_high_s16( lr.val[1] ))));
+
+        peak_l = vmaxq_u16( peak_l,
+                            vreinterpretq_u16_s16( vabsq_s16( lr.val[0] )));
+        peak_r = vmaxq_u16( peak_r,
+                            vreinterpretq_u16_s16( vabsq_s16( lr.val[1] )));
+    }
+
+    sum[0] += vgetq_lane_u64( sum_l, 0 ) + vgetq_lane_u64( sum_l, 1 );
+    sum[1] += vgetq_lane_u64( sum_r, 0 ) + vgetq_lane_u64( sum_r, 1 );
+
+    // Horizontal max of each peak vector.
+    peak_n = vpmax_u16( vget_low_u16( peak_l ), vget_high_u16( peak_l ));
+    peak_n = vpmax_u16( peak_n, peak_n );
+    peak_n = vpmax_u16( peak_n, peak_n );
+    if ( vget_lane_u16( peak_n, 0 ) > peak[0] )
+        peak[0] = vget_lane_u16( peak_n, 0 );
+
+    peak_n = vpmax_u16( vget_low_u16( peak_r ), vget_high_u16( peak_r ));
+    peak_n = vpmax_u16( peak_n, peak_n );
+    peak_n = vpmax_u16( peak_n, peak_n );
+    if ( vget_lane_u16( peak_n, 0 ) > peak[1] )
+        peak[1] = vget_lane_u16( peak_n, 0 );
+#endif
+
+    // Scalar fallback and remaining frames, unrolled across the channels.
+#define INTEGRATE_LOAD( c ) acc[c] = sum[c]; max[c] = peak[c];
+#define INTEGRATE_S16( c ) \
+    sample = ptr[c]; \
+    acc[c] += (uint64_t)( sample * sample ); \
+    if ( sample < 0 ) sample = -sample; \
+    if ( (uint32_t) sample > max[c] ) max[c] = sample;
+#define INTEGRATE_STORE( c ) sum[c] = acc[c]; peak[c] = max[c];
+
+    METER_UNROLL( INTEGRATE_LOAD )
+    for ( ; i < frames; i++, ptr += METER_CHANNELS )
+    {
+        METER_UNROLL( INTEGRATE_S16 )
+    }
+    METER_UNROLL( INTEGRATE_STORE )
+
+#undef INTEGRATE_S16
+}
+
+//  ---------------------------------------------------------------------------
+//  Accumulates sum of squares and absolute peak for a 32-bit span.
+//  ---------------------------------------------------------------------------
+/*
+    S24 samples are sign extended from the low 3 bytes and S32 samples are
+    shifted down to 24 bits, so both are metered at 24-bit resolution. The
+    squares are < 2^46 so a window of up to 2^18 frames can't overflow.
+*/
+static void integrate_span_s32( const int32_t *ptr, uint32_t frames,
+                                uint8_t format,
+                                uint64_t sum[METER_CHANNELS],
+                                uint32_t peak[METER_CHANNELS] )
+{
+    uint64_t acc[METER_CHANNELS];
+    uint32_t max[METER_CHANNELS];
+    int64_t  sample;
+    uint32_t i;
+
+    // The format test is hoisted so that each loop is a straight line.
+#define INTEGRATE_S32( c, load ) \
+    sample = load; \
+    acc[c] += (uint64_t)( sample * sample ); \
+    if ( sample < 0 ) sample = -sample; \
+    if ( sample > max[c] ) max[c] = sample;
+#define INTEGRATE_S24_C( c ) \
+    INTEGRATE_S32( c, (int32_t)( (uint32_t) ptr[c] << 8 ) >> 8 )
+#define INTEGRATE_S32_C( c ) INTEGRATE_S32( c, ptr[c] >> 8 )
+
+    METER_UNROLL( INTEGRATE_LOAD )
+    if ( format == METER_S24 )
+        for ( i = 0; i < frames; i++, ptr += METER_CHANNELS )
+        {
+            METER_UNROLL( INTEGRATE_S24_C )
+        }
+    else
+        for ( i = 0; i < frames; i++, ptr += METER_CHANNELS )
+        {
+            METER_UNROLL( INTEGRATE_S32_C )
+        }
+    METER_UNROLL( INTEGRATE_STORE )
+
+#undef INTEGRATE_S32_C
+#undef INTEGRATE_S24_C
+#undef INTEGRATE_S32
+#undef INTEGRATE_STORE
+#undef INTEGRATE_LOAD
+}
+
+//  ---------------------------------------------------------------------------
+//  Accumulates sum of squares and absolute peak for a contiguous span.
+//  ---------------------------------------------------------------------------
+static void integrate_span( const void *ptr, uint32_t frames, uint8_t format,
+                            uint64_t sum[METER_CHANNELS],
+                            uint32_t peak[METER_CHANNELS] )
+{
+    if ( format == METER_S16 )
+         integrate_span_s16( ptr, frames, sum, peak );
+    else integrate_span_s32( ptr, frames, format, sum, peak );
+}
+
+//  ---------------------------------------------------------------------------
+//  Converts a linear level to dBfs, limited to the meter floor.
+//  ---------------------------------------------------------------------------
+static int8_t level_to_dBfs( struct peak_meter_t *peak_meter, float level )
+{
+    float dB;
+
+    if ( level <= 0 ) return peak_meter->floor;
+
+    dB = 20 * log10( level / (float) peak_meter->reference );
+
+    if ( dB < peak_meter->floor ) return peak_meter->floor;
+    if ( dB > 0 ) return 0;
+    return (int8_t) dB;
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns log2 of an integer in Q16 fixed point.
+//  ---------------------------------------------------------------------------
+/*
+    The integer part is the position of the leading 1 and the fraction is
+    interpolated from a table of log2 of the next METER_LOG2_BITS bits of
+    the mantissa. The error is less than 0.0001dB in this use. x must not
+    be 0.
+*/
+static int32_t log2_q16( uint64_t x )
+{
+    uint32_t mantissa, idx, frac;
+    uint8_t  msb = 63 - __builtin_clzll( x );
+
+    // Normalise to 16 fractional bits below the leading 1.
+    if ( msb >= 16 ) mantissa = ( x >> ( msb - 16 )) & 0xffff;
+    else mantissa = ( x << ( 16 - msb )) & 0xffff;
+
+    idx  = mantissa >> ( 16 - METER_LOG2_BITS );
+    frac = mantissa & (( 1 << ( 16 - METER_LOG2_BITS )) - 1 );
+
+    return ((int32_t) msb << 16 ) + meter_log2[idx] +
+           (( meter_log2[idx + 1] - meter_log2[idx] ) * frac >>
+                                    ( 16 - METER_LOG2_BITS ));
+}
+
+//  ---------------------------------------------------------------------------
+//  Converts a log2 power ratio in Q16 to whole dB, limited to floor.
+//  ---------------------------------------------------------------------------
+/*
+    The result is truncated towards 0 to match level_to_dBfs().
+*/
+static int8_t log2_to_dB( int32_t log2_power, int8_t floor )
+{
+    int64_t dB;
+
+    if ( log2_power >= 0 ) return 0;
+
+    // 10 log10(2) in Q16.
+    dB = -(( -(int64_t) log2_power * 197283 ) >> 32 );
+
+    if ( dB < floor ) return floor;
+    return (int8_t) dB;
+}
+
+//  ---------------------------------------------------------------------------
+//  Converts an energy sum to dBfs using integer arithmetic.
+//  ---------------------------------------------------------------------------
+/*
+    The mean energy relative to the reference is found as a difference of
+    logs so there is no divide or square root,
+
+        dB = 10 log10(2) * ( log2( sum ) - log2( frames ) - 2 log2( ref ))
+
+    where ref is the 16-bit reference shifted up by shift bits for higher
+    resolution sources.
+*/
+static int8_t energy_to_dBfs( struct peak_meter_t *peak_meter,
+                              uint64_t sum, uint32_t frames, uint8_t shift )
+{
+    int32_t log2_power;
+
+    if (( sum == 0 ) || ( frames == 0 ) || ( peak_meter->reference == 0 ))
+        return peak_meter->floor;
+
+    log2_power = log2_q16( sum ) - log2_q16( frames ) -
+                 2 * ( log2_q16( peak_meter->reference ) +
+                       ((int32_t) shift << 16 ));
+
+    return log2_to_dB( log2_power, peak_meter->floor );
+}
+
+//  ---------------------------------------------------------------------------
+//  Integrates a run of frames ending at buffer index end.
+//  ---------------------------------------------------------------------------
+static uint32_t integrate_run( const struct meter_ring_t *ring,
+                               uint32_t end, uint32_t frames,
+                               uint64_t sum[METER_CHANNELS],
+                               uint32_t peak[METER_CHANNELS] )
+{
+    struct   meter_span_t span[2];
+    uint32_t total = 0;
+    uint8_t  spans, i;
+
+    spans = meter_get_spans( ring, end, frames, span );
+    for ( i = 0; i < spans; i++ )
+    {
+        integrate_span( span[i].ptr, span[i].frames, ring->format, sum, peak );
+        total += span[i].frames;
+    }
+
+    return total;
+}
+
+//  ---------------------------------------------------------------------------
+//  Counts runs of oversampled values at or over full scale.
+//  ---------------------------------------------------------------------------
+/*
+    Values are taken in time order, i.e. all phases of one input sample
+    before the next.
+*/
+static void true_peak_count( struct meter_true_peak_t *true_peak,
+                             uint8_t channel, int32_t value,
+                             uint8_t over_peaks )
+{
+    if (( value >= METER_TP_FULL_SCALE ) || ( value <= -METER_TP_FULL_SCALE ))
+    {
+        if ( true_peak->run[channel] < UINT16_MAX )
+             true_peak->run[channel]++;
+        if ( true_peak->run[channel] >= over_peaks )
+             true_peak->over[channel] = true;
+    }
+    else true_peak->run[channel] = 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Oversamples a channel and finds the true peak.
+//  ---------------------------------------------------------------------------
+/*
+    x holds METER_TP_TAPS - 1 history samples followed by the new samples.
+
+    With NEON, 4 consecutive outputs of each phase are found at once by
+    multiplying overlapping loads of the input by each coefficient, so
+    there is no horizontal add. Runs of values over full scale are rare so
+    they are only counted sample by sample when a block contains one.
+*/
+static void true_peak_filter( struct meter_true_peak_t *true_peak,
+                              uint8_t channel, const int16_t *x,
+                              uint32_t samples, uint8_t over_peaks )
+{
+    const int16_t *in;
+    int32_t  y[METER_TP_PHASES];
+    int32_t  acc;
+    uint32_t peak = true_peak->peak[channel];
+    uint32_t i = 0;
+    uint8_t  phase, tap;
+
+    x += METER_TP_TAPS - 1;
+
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+    int32x4_t  yv[METER_TP_PHASES];
+    int32_t    ys[METER_TP_PHASES][4];
+    uint32x4_t peak_v = vdupq_n_u32( 0 );
+    uint32x4_t over_v;
+    uint32x2_t peak_n;
+    int32x4_t  full = vdupq_n_s32( METER_TP_FULL_SCALE );
+    uint8_t    j;
+
+    for ( ; i + 4 <= samples; i += 4 )
+    {
+        over_v = vdupq_n_u32( 0 );
+        for ( phase = 0; phase < METER_TP_PHASES; phase++ )
+        {
+            yv[phase] = vdupq_n_s32( 0 );
+            for ( tap = 0; tap < METER_TP_TAPS; tap++ )
+                yv[phase] = vmlal_n_s16( yv[phase], vld1_s16( x + i - tap ),
+                                         meter_tp_coefs[phase][tap] );
+
+            peak_v = vmaxq_u32( peak_v,
+                     vreinterpretq_u32_s32( vabsq_s32( yv[phase] )));
+            over_v = vorrq_u32( over_v,
+                     vcgeq_s32( vabsq_s32( yv[phase] ), full ));
+        }
+
+        if (( vgetq_lane_u32( over_v, 0 ) | vgetq_lane_u32( over_v, 1 ) |
+              vgetq_lane_u32( over_v, 2 ) | vgetq_lane_u32( over_v, 3 )) == 0 )
+        {
+            true_peak->run[channel] = 0;
+            continue;
+        }
+
+        for ( phase = 0; phase < METER_TP_PHASES; phase++ )
+            vst1q_s32( ys[phase], yv[phase] );
+        for ( j = 0; j < 4; j++ )
+            for ( phase = 0; phase < METER_TP_PHASES; phase++ )
+                true_peak_count( true_peak, channel, ys[phase][j],
+                                 over_peaks );
+    }
+
+    peak_n = vpmax_u32( vget_low_u32( peak_v ), vget_high_u32( peak_v ));
+    peak_n = vpmax_u32( peak_n, peak_n );
+    if ( vget_lane_u32( peak_n, 0 ) > peak ) peak = vget_lane_u32( peak_n, 0 );
+#endif
+
+    // Scalar fallback and remaining samples.
+    for ( ; i < samples; i++ )
+    {
+        for ( phase = 0; phase < METER_TP_PHASES; phase++ )
+        {
+            in  = x + i;
+            acc = 0;
+            for ( tap = 0; tap < METER_TP_TAPS; tap++ )
+                acc += (int32_t) meter_tp_coefs[phase][tap] * *in--;
+            y[phase] = acc;
+            if ( acc < 0 ) acc = -acc;
+            if ( (uint32_t) acc > peak ) peak = acc;
+        }
+        for ( phase = 0; phase < METER_TP_PHASES; phase++ )
+            true_peak_count( true_peak, channel, y[phase], over_peaks );
+    }
+
+    true_peak->peak[channel] = peak;
+}
+
+//  ---------------------------------------------------------------------------
+//  Runs the true peak detector over a contiguous span.
+//  ---------------------------------------------------------------------------
+/*
+    The frames are deinterleaved and scaled to 16-bits in small chunks after
+    the history so that each channel can be filtered as a straight line of
+    samples. 16-bits is plenty to resolve an overload.
+*/
+static void true_peak_span( struct meter_true_peak_t *true_peak,
+                            const void *ptr, uint32_t frames,
+                            uint8_t format, uint8_t over_peaks )
+{
+    int16_t  x[METER_CHANNELS][METER_TP_TAPS - 1 + METER_TP_CHUNK];
+    const int16_t *s16 = ptr;
+    const int32_t *s32 = ptr;
+    uint32_t n, i;
+    uint8_t  channel;
+
+    while ( frames > 0 )
+    {
+        n = ( frames > METER_TP_CHUNK ) ? METER_TP_CHUNK : frames;
+
+        for ( channel = 0; channel < METER_CHANNELS; channel++ )
+            memcpy( x[channel], true_peak->history[channel],
+                    sizeof( true_peak->history[channel] ));
+
+        for ( i = 0; i < n; i++ )
+        {
+            for ( channel = 0; channel < METER_CHANNELS; channel++ )
+            {
+                if ( format == METER_S16 )
+                     x[channel][METER_TP_TAPS - 1 + i] = *s16++;
+                else if ( format == METER_S24 )
+                     x[channel][METER_TP_TAPS - 1 + i] =
+                        (int32_t)( (uint32_t) *s32++ << 8 ) >> 16;
+                else x[channel][METER_TP_TAPS - 1 + i] = *s32++ >> 16;
+            }
+        }
+
+        for ( channel = 0; channel < METER_CHANNELS; channel++ )
+        {
+            true_peak_filter( true_peak, channel, x[channel], n, over_peaks );
+            memcpy( true_peak->history[channel], x[channel] + n,
+                    sizeof( true_peak->history[channel] ));
+        }
+
+        frames -= n;
+    }
+}
+
+//  ---------------------------------------------------------------------------
+//  Runs the true peak detector over frames ending at buffer index end.
+//  ---------------------------------------------------------------------------
+static void true_peak_run( struct meter_true_peak_t *true_peak,
+                           const struct meter_ring_t *ring,
+                           uint32_t end, uint32_t frames, uint8_t over_peaks )
+{
+    struct   meter_span_t span[2];
+    uint8_t  spans, i;
+
+    spans = meter_get_spans( ring, end, frames, span );
+    for ( i = 0; i < spans; i++ )
+        true_peak_span( true_peak, span[i].ptr, span[i].frames,
+                        ring->format, over_peaks );
+}
+
+//  ---------------------------------------------------------------------------
+//  Calculates K-weighting filter coefficients for a sample rate.
+//  ---------------------------------------------------------------------------
+/*
+    BS.1770 only gives coefficients for 48kHz, so they are found from the
+    analogue prototypes of the two filters by the bilinear transform. At
+    48kHz these give the coefficients in the specification.
+*/
+static void k_weight_set_rate( struct meter_k_weight_t *k_weight,
+                               uint32_t rate )
+{
+    double f0, gain, q, k, vh, vb, a0;
+
+    // High shelf.
+    f0   = 1681.974450955533;
+    gain = 3.999843853973347;
+    q    = 0.7071752369554196;
+    k    = tan( M_PI * f0 / rate );
+    vh   = pow( 10.0, gain / 20.0 );
+    vb   = pow( vh, 0.4996667741545416 );
+    a0   = 1.0 + k / q + k * k;
+
+    k_weight->b[0][0] = ( vh + vb * k / q + k * k ) / a0;
+    k_weight->b[0][1] = 2.0 * ( k * k - vh ) / a0;
+    k_weight->b[0][2] = ( vh - vb * k / q + k * k ) / a0;
+    k_weight->a[0][0] = 2.0 * ( k * k - 1.0 ) / a0;
+    k_weight->a[0][1] = ( 1.0 - k / q + k * k ) / a0;
+
+    // High pass.
+    f0 = 38.13547087602444;
+    q  = 0.5003270373238773;
+    k  = tan( M_PI * f0 / rate );
+    a0 = 1.0 + k / q + k * k;
+
+    k_weight->b[1][0] =  1.0;
+    k_weight->b[1][1] = -2.0;
+    k_weight->b[1][2] =  1.0;
+    k_weight->a[1][0] = 2.0 * ( k * k - 1.0 ) / a0;
+    k_weight->a[1][1] = ( 1.0 - k / q + k * k ) / a0;
+
+    k_weight->rate = rate;
+}
+
+//  ---------------------------------------------------------------------------
+//  Restarts the K-weighting filters and current sub-block.
+//  ---------------------------------------------------------------------------
+static void k_weight_reset( struct meter_k_weight_t *k_weight )
+{
+    memset( k_weight->z, 0, sizeof( k_weight->z ));
+    k_weight->sum    = 0;
+    k_weight->frames = 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  K-weights a contiguous span and accumulates 100ms sub-blocks.
+//  ---------------------------------------------------------------------------
+/*
+    Samples are scaled so that full scale is 1.0. The biquads are direct
+    form II transposed. The channel weights for left and right are 1 so the
+    channel energies are simply added. All channels share the coefficients,
+    so each stage is run across the channels of a frame together from the
+    filter states held by channel.
+*/
+static void k_weight_span( struct meter_k_weight_t *k_weight,
+                           const void *ptr, uint32_t frames, uint8_t format )
+{
+    const int16_t *s16 = ptr;
+    const int32_t *s32 = ptr;
+    uint32_t block = k_weight->rate / 10;
+    uint32_t i;
+    uint8_t  stage;
+    float    x[METER_CHANNELS], y, *z0, *z1;
+    const float *b, *a;
+    float    scale = ( format == METER_S16 ) ? 1.0f / 32768 :
+                     ( format == METER_S24 ) ? 1.0f / 8388608 :
+                                               1.0f / 2147483648.0f;
+    double   sum = 0;
+
+#define K_WEIGHT_LOAD( c ) \
+    if ( format == METER_S16 ) x[c] = s16[c]; \
+    else if ( format == METER_S24 ) \
+         x[c] = (int32_t)( (uint32_t) s32[c] << 8 ) >> 8; \
+    else x[c] = s32[c]; \
+    x[c] *= scale;
+#define K_WEIGHT_BIQUAD( c ) \
+    y     = b[0] * x[c] + z0[c]; \
+    z0[c] = b[1] * x[c] - a[0] * y + z1[c]; \
+    z1[c] = b[2] * x[c] - a[1] * y; \
+    x[c]  = y;
+#define K_WEIGHT_SUM( c ) sum += x[c] * x[c];
+
+    for ( i = 0; i < frames; i++ )
+    {
+        METER_UNROLL( K_WEIGHT_LOAD )
+        if ( format == METER_S16 ) s16 += METER_CHANNELS;
+        else s32 += METER_CHANNELS;
+
+        for ( stage = 0; stage < 2; stage++ )
+        {
+            b  = k_weight->b[stage];
+            a  = k_weight->a[stage];
+            z0 = k_weight->z[stage][0];
+            z1 = k_weight->z[stage][1];
+            METER_UNROLL( K_WEIGHT_BIQUAD )
+        }
+        METER_UNROLL( K_WEIGHT_SUM )
+
+        if ( ++k_weight->frames >= block )
+        {
+            // Keep the newest sub-blocks if too many are waiting.
+            if ( k_weight->pending == METER_LUFS_PENDING )
+            {
+                memmove( k_weight->energy, k_weight->energy + 1,
+                         sizeof( double ) * ( METER_LUFS_PENDING - 1 ));
+                k_weight->pending--;
+            }
+            k_weight->energy[k_weight->pending++] =
+                ( k_weight->sum + sum ) / block;
+            k_weight->sum    = 0;
+            k_weight->frames = 0;
+            sum = 0;
+        }
+    }
+
+    k_weight->sum += sum;
+
+#undef K_WEIGHT_SUM
+#undef K_WEIGHT_BIQUAD
+#undef K_WEIGHT_LOAD
+}
+
+//  ---------------------------------------------------------------------------
+//  K-weights frames ending at buffer index end.
+//  ---------------------------------------------------------------------------
+static void k_weight_run( struct meter_k_weight_t *k_weight,
+                          const struct meter_ring_t *ring,
+                          uint32_t end, uint32_t frames )
+{
+    struct   meter_span_t span[2];
+    uint8_t  spans, i;
+
+    if (( ring->rate == 0 ) || ( frames == 0 )) return;
+
+    if ( k_weight->rate != ring->rate )
+    {
+        k_weight_set_rate( k_weight, ring->rate );
+        k_weight_reset( k_weight );
+    }
+
+    spans = meter_get_spans( ring, end, frames, span );
+    for ( i = 0; i < spans; i++ )
+        k_weight_span( k_weight, span[i].ptr, span[i].frames, ring->format );
+}
+
+//  ---------------------------------------------------------------------------
+//  Adds a contiguous span to the pyramid leaves.
+//  ---------------------------------------------------------------------------
+/*
+    The span is taken a leaf at a time, with the leaf in locals so that the
+    samples can't alias it. Completed leaves are written straight into
+    level 0 but the pyramid isn't told about them until pyramid_commit().
+*/
+static void pyramid_span( struct meter_integrator_t *integrator,
+                          const void *ptr, uint32_t frames, uint8_t format )
+{
+    struct   meter_pyramid_level_t *level = &integrator->pyramid->level[0];
+    struct   meter_leaf_t *leaf = &integrator->leaf;
+    const int16_t *s16 = ptr;
+    const int32_t *s32 = ptr;
+    int16_t  min[METER_CHANNELS], max[METER_CHANNELS], sample;
+    uint64_t sum[METER_CHANNELS];
+    uint32_t n, i, node;
+
+#define PYRAMID_START( c ) \
+    leaf->min[c] = INT16_MAX; leaf->max[c] = INT16_MIN; leaf->sum[c] = 0;
+#define PYRAMID_LOAD( c ) \
+    min[c] = leaf->min[c]; max[c] = leaf->max[c]; sum[c] = leaf->sum[c];
+#define PYRAMID_ADD( c, load ) \
+    sample = load; \
+    if ( sample < min[c] ) min[c] = sample; \
+    if ( sample > max[c] ) max[c] = sample; \
+    sum[c] += (uint32_t)( sample * sample );
+#define PYRAMID_S16( c ) PYRAMID_ADD( c, s16[c] )
+#define PYRAMID_S24( c ) \
+    PYRAMID_ADD( c, (int32_t)( (uint32_t) s32[c] << 8 ) >> 16 )
+#define PYRAMID_S32( c ) PYRAMID_ADD( c, s32[c] >> 16 )
+#define PYRAMID_STORE( c ) \
+    leaf->min[c] = min[c]; leaf->max[c] = max[c]; leaf->sum[c] = sum[c];
+#define PYRAMID_WRITE( c ) \
+    level->min[c][node] = min[c]; \
+    level->max[c][node] = max[c]; \
+    level->sum[c][node] = sum[c];
+
+    while ( frames > 0 )
+    {
+        if ( leaf->frames == 0 )
+        {
+            METER_UNROLL( PYRAMID_START )
+        }
+        n = METER_PYRAMID_LEAF - leaf->frames;
+        if ( n > frames ) n = frames;
+
+        METER_UNROLL( PYRAMID_LOAD )
+        if ( format == METER_S16 )
+            for ( i = 0; i < n; i++, s16 += METER_CHANNELS )
+            {
+                METER_UNROLL( PYRAMID_S16 )
+            }
+        else if ( format == METER_S24 )
+            for ( i = 0; i < n; i++, s32 += METER_CHANNELS )
+            {
+                METER_UNROLL( PYRAMID_S24 )
+            }
+        else
+            for ( i = 0; i < n; i++, s32 += METER_CHANNELS )
+            {
+                METER_UNROLL( PYRAMID_S32 )
+            }
+
+        frames       -= n;
+        leaf->frames += n;
+        if ( leaf->frames < METER_PYRAMID_LEAF )
+        {
+            METER_UNROLL( PYRAMID_STORE )
+            break;
+        }
+
+        node = leaf->number % METER_PYRAMID_NODES;
+        METER_UNROLL( PYRAMID_WRITE )
+        leaf->number++;
+        leaf->frames = 0;
+    }
+
+#undef PYRAMID_WRITE
+#undef PYRAMID_STORE
+#undef PYRAMID_S32
+#undef PYRAMID_S24
+#undef PYRAMID_S16
+#undef PYRAMID_ADD
+#undef PYRAMID_LOAD
+#undef PYRAMID_START
+}
+
+//  ---------------------------------------------------------------------------
+//  Adds frames ending at buffer index end to the pyramid leaves.
+//  ---------------------------------------------------------------------------
+/*
+    Leaves waiting for pyramid_commit() go in the level 0 nodes past the
+    history, so no more than METER_PYRAMID_NODES - METER_PYRAMID_COLUMNS
+    can be made by a read. Older leaves than that are skipped but still
+    counted, so the history starts again from the newest and keeps time.
+*/
+static void pyramid_run( struct meter_integrator_t *integrator,
+                         const struct meter_ring_t *ring,
+                         uint32_t end, uint32_t frames )
+{
+    struct   meter_leaf_t *leaf = &integrator->leaf;
+    struct   meter_span_t span[2];
+    uint64_t pending, room, leaves, skip;
+    uint8_t  spans, i;
+
+    pending = leaf->number - integrator->pyramid->leaves;
+    room    = METER_PYRAMID_NODES - METER_PYRAMID_COLUMNS;
+    room    = ( pending < room ) ? room - pending : 0;
+    leaves  = ( leaf->frames + frames ) / METER_PYRAMID_LEAF;
+    if ( leaves > room )
+    {
+        skip          = leaves - room;
+        frames       -= skip * METER_PYRAMID_LEAF - leaf->frames;
+        leaf->number += skip;
+        leaf->frames  = 0;
+    }
+
+    spans = meter_get_spans( ring, end, frames, span );
+    for ( i = 0; i < spans; i++ )
+        pyramid_span( integrator, span[i].ptr, span[i].frames, ring->format );
+}
+
+//  ---------------------------------------------------------------------------
+//  Adds the leaves completed by an accepted read to the pyramid.
+//  ---------------------------------------------------------------------------
+/*
+    Each ancestor of the new leaves is built again from its children, so
+    it doesn't matter if it was built before from fewer of them. A node
+    with only its first child so far is a copy of it. If more leaves were
+    completed than level 0 holds, the history starts again from the oldest
+    that are left in the history.
+*/
+static void pyramid_commit( struct meter_integrator_t *integrator )
+{
+    struct   meter_pyramid_t *pyramid = integrator->pyramid;
+    struct   meter_pyramid_level_t *level, *below;
+    uint64_t leaves = integrator->leaf.number;
+    uint64_t start  = pyramid->leaves;
+    uint64_t node, last;
+    uint32_t left, right, parent;
+    uint8_t  k;
+    bool     pair;
+
+#define PYRAMID_COPY( c ) \
+    level->min[c][parent] = below->min[c][left]; \
+    level->max[c][parent] = below->max[c][left]; \
+    level->sum[c][parent] = below->sum[c][left];
+#define PYRAMID_PAIR( c ) \
+    level->min[c][parent] = ( below->min[c][left] < below->min[c][right] ) ? \
+                              below->min[c][left] : below->min[c][right]; \
+    level->max[c][parent] = ( below->max[c][left] > below->max[c][right] ) ? \
+                              below->max[c][left] : below->max[c][right]; \
+    level->sum[c][parent] = below->sum[c][left] + below->sum[c][right];
+
+    if ( leaves <= start ) return;
+    if ( leaves - start > METER_PYRAMID_COLUMNS )
+    {
+        start = leaves - METER_PYRAMID_COLUMNS;
+        pyramid->first = start;
+    }
+
+    for ( k = 1; k < METER_PYRAMID_LEVELS; k++ )
+    {
+        level = &pyramid->level[k];
+        below = &pyramid->level[k - 1];
+        last  = ( leaves - 1 ) >> k;
+
+        for ( node = start >> k; node <= last; node++ )
+        {
+            parent = node % METER_PYRAMID_NODES;
+            left   = ( node * 2 ) % METER_PYRAMID_NODES;
+            right  = ( node * 2 + 1 ) % METER_PYRAMID_NODES;
+            pair   = ((( node * 2 + 1 ) << ( k - 1 )) < leaves );
+
+            if ( pair )
+            {
+                METER_UNROLL( PYRAMID_PAIR )
+            }
+            else
+            {
+                METER_UNROLL( PYRAMID_COPY )
+            }
+        }
+    }
+
+    pyramid->leaves = leaves;
+
+#undef PYRAMID_PAIR
+#undef PYRAMID_COPY
+}
+
+//  ---------------------------------------------------------------------------
+//  Updates the sliding window sums with frames written since the last call.
+//  ---------------------------------------------------------------------------
+/*
+    Only the frames written since the last call are added and the same number
+    of frames that have dropped out of the back of the window are subtracted.
+    The sums are exact integers so there is no drift. A full integration of
+    the window is only needed on the first call, if the window size, buffer
+    or format changes, or if too many frames have been written to still be
+    able to read the ones leaving the window.
+
+    The peaks are those of the newly written frames so every sample is seen
+    exactly once by the peak detectors. If the window has been completely
+    replaced since the last call it is simply integrated again, along with
+    a peak only pass over any new frames older than the window. The true
+    peak detector is only restarted if the buffer or window changes.
+
+    Returns the number of frames behind the snapshot index that were read.
+*/
+static uint32_t integrate_window( struct meter_integrator_t *integrator,
+                                  uint32_t window,
+                                  const struct meter_ring_t *ring,
+                                  uint32_t peak[METER_CHANNELS],
+                                  uint8_t over_peaks )
+{
+    struct   meter_true_peak_t *true_peak = &integrator->true_peak;
+    uint64_t leaving[METER_CHANNELS];
+    uint32_t discard[METER_CHANNELS];
+    uint32_t len = ring->size;
+    uint32_t idx = ring->index;
+    uint32_t fresh;
+    uint8_t  channel;
+    bool     same;
+
+    if (( len < METER_CHANNELS ) || ( window == 0 ))
+    {
+        integrator->valid = false;
+        return 0;
+    }
+
+    // Window can't be longer than the buffer.
+    if ( window > len / METER_CHANNELS ) window = len / METER_CHANNELS;
+    idx %= len;
+
+    fresh = (( idx + len - integrator->index ) % len ) / METER_CHANNELS;
+
+    same = (( integrator->valid ) &&
+            ( integrator->window == window ) &&
+            ( integrator->len    == len ) &&
+            ( integrator->buffer == ring->buffer ) &&
+            ( integrator->format == ring->format ));
+
+    // True peak of new frames, carrying on from the last frames filtered.
+    for ( channel = 0; channel < METER_CHANNELS; channel++ )
+    {
+        true_peak->peak[channel] = 0;
+        true_peak->over[channel] = false;
+    }
+    if ( same ) true_peak_run( true_peak, ring, idx, fresh, over_peaks );
+    else
+    {
+        memset( true_peak->history, 0, sizeof( true_peak->history ));
+        memset( true_peak->run, 0, sizeof( true_peak->run ));
+        true_peak_run( true_peak, ring, idx, window, over_peaks );
+    }
+
+    // K-weighting of new frames for loudness.
+    if ( integrator->k_weight.enabled )
+    {
+        if ( !same ) k_weight_reset( &integrator->k_weight );
+        k_weight_run( &integrator->k_weight, ring, idx,
+                      same ? fresh : window );
+    }
+
+    // Pyramid leaves of new frames for waveform and history views.
+    if ( integrator->pyramid != NULL )
+    {
+        if ( !same ) integrator->leaf.frames = 0;
+        pyramid_run( integrator, ring, idx, same ? fresh : window );
+    }
+
+    if (( !same ) ||
+        ( fresh >= window ) ||
+        (( window + fresh ) * METER_CHANNELS > len ))
+    {
+        // Start again with a full integration of the window.
+        for ( channel = 0; channel < METER_CHANNELS; channel++ )
+        {
+            integrator->sum[channel] = 0;
+            leaving[channel] = 0;
+        }
+
+        // Don't miss peaks in new frames that are older than the window.
+        if (( same ) && ( fresh > window ) &&
+            ( fresh * METER_CHANNELS <= len ))
+            integrate_run( ring, idx + len - window * METER_CHANNELS,
+                           fresh - window, leaving, peak );
+        else fresh = window;
+
+        integrator->frames = integrate_run( ring, idx, window,
+                                            integrator->sum, peak );
+        integrator->window = window;
+        integrator->len    = len;
+        integrator->buffer = ring->buffer;
+        integrator->format = ring->format;
+        integrator->index  = idx;
+        integrator->valid  = true;
+        return fresh;
+    }
+
+    if ( fresh == 0 ) return 0;
+
+    // Add frames that have entered the window.
+    integrate_run( ring, idx, fresh, integrator->sum, peak );
+
+    // Subtract frames that have left the back of the window.
+    for ( channel = 0; channel < METER_CHANNELS; channel++ )
+    {
+        leaving[channel] = 0;
+        discard[channel] = 0;
+    }
+    integrate_run( ring, idx + len - window * METER_CHANNELS,
+                   fresh, leaving, discard );
+    for ( channel = 0; channel < METER_CHANNELS; channel++ )
+        integrator->sum[channel] -= leaving[channel];
+
+    integrator->index = idx;
+
+    return window + fresh;
+}
+
+//  ---------------------------------------------------------------------------
+//  Updates the integrator without holding a lock while reading samples.
+//  ---------------------------------------------------------------------------
+/*
+    The integration is done on a copy of the integrator state, which is only
+    kept if the writer hasn't lapped the samples read. Otherwise it is tried
+    again with a fresh snapshot and the frame is dropped if it still fails.
+    Reads that turn out to be too long to have been made safely without a
+    lock are repeated while holding it, or accepted as they are if the
+    source doesn't have a lock. Returns false if the frame was dropped.
+*/
+static bool integrate_source( const struct meter_source_t *source,
+                              struct meter_integrator_t *integrator,
+                              uint32_t window,
+                              uint32_t peak[METER_CHANNELS],
+                              uint8_t over_peaks )
+{
+    struct   meter_integrator_t state;
+    struct   meter_ring_t ring;
+    uint32_t extent;
+    uint8_t  attempt, channel;
+
+    for ( attempt = 0; attempt <= VIS_READ_RETRIES; attempt++ )
+    {
+        source->snapshot( &ring );
+        if ( !ring.running ) return true;
+
+        state = *integrator;
+        for ( channel = 0; channel < METER_CHANNELS; channel++ )
+            peak[channel] = 0;
+
+        extent = integrate_window( &state, window, &ring, peak, over_peaks );
+
+        // Too long to have been read safely without the lock.
+        if ( extent * METER_CHANNELS + ring.guard > ring.size )
+        {
+            if ( source->lock ) break;
+            *integrator = state;
+            return true;
+        }
+
+        if ( !source->lapped( &ring, extent ))
+        {
+            *integrator = state;
+            return true;
+        }
+        vis_stats.retries++;
+    }
+
+    if ( attempt <= VIS_READ_RETRIES )
+    {
+        for ( channel = 0; channel < METER_CHANNELS; channel++ )
+            peak[channel] = 0;
+
+        source->lock( &ring );
+        integrate_window( integrator, window, &ring, peak, over_peaks );
+        source->unlock();
+        return true;
+    }
+
+    // Still lapped so drop this frame and start again next time.
+    integrator->valid = false;
+    vis_stats.dropped++;
+
+    return false;
+}
+
+//  ---------------------------------------------------------------------------
+//  Builds the lookup tables for a meter from its scale.
+//  ---------------------------------------------------------------------------
+/*
+    The dB values are whole numbers between 0 and -128dB so the scale index
+    for every possible value can be found in advance. The index is that of
+    the first scale interval that the level doesn't exceed, which is the
+    same as the search in get_dB_indices(). Values above the top of the
+    scale are marked with 0xff.
+*/
+void init_peak_meter( struct peak_meter_t *peak_meter )
+{
+    uint16_t i;
+    uint8_t  level;
+    int16_t  dB;
+
+    if ( !meter_log2_ready )
+    {
+        for ( i = 0; i <= METER_LOG2_SIZE; i++ )
+            meter_log2[i] = (uint32_t)( log2( 1.0 + (double) i /
+                                        METER_LOG2_SIZE ) * 65536 + 0.5 );
+        meter_log2_ready = true;
+    }
+
+    if ( peak_meter->num_levels > PEAK_METER_LEVELS_MAX )
+         peak_meter->num_levels = PEAK_METER_LEVELS_MAX;
+
+    for ( i = 0; i < METER_DB_RANGE; i++ )
+    {
+        dB = -(int16_t) i;
+        peak_meter->dB_index[i] = 0xff;
+        for ( level = 0; level < peak_meter->num_levels; level++ )
+        {
+            if ( dB <= peak_meter->scale[level] )
+            {
+                peak_meter->dB_index[i] = level;
+                break;
+            }
+        }
+    }
+
+    reset_loudness( peak_meter );
+    peak_meter->configured = true;
+}
+
+//  ---------------------------------------------------------------------------
+//  Converts a K-weighted mean square to LUFS.
+//  ---------------------------------------------------------------------------
+static float energy_to_lufs( double energy, int8_t floor )
+{
+    if ( energy <= 0 ) return floor;
+    return -0.691 + 10 * log10( energy );
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns the mean square of the centre of a histogram bin.
+//  ---------------------------------------------------------------------------
+/*
+    These are found once so that the integrated loudness only needs a pass
+    over the histogram.
+*/
+static double meter_lufs_energy[METER_LUFS_BINS];
+static bool   meter_lufs_ready = false;
+
+static double lufs_bin_energy( uint16_t bin )
+{
+    uint16_t i;
+
+    if ( !meter_lufs_ready )
+    {
+        for ( i = 0; i < METER_LUFS_BINS; i++ )
+            meter_lufs_energy[i] =
+                pow( 10.0, ( -70.0 + ( i + 0.5 ) / 10 + 0.691 ) / 10 );
+        meter_lufs_ready = true;
+    }
+
+    return meter_lufs_energy[bin];
+}
+
+//  ---------------------------------------------------------------------------
+//  Restarts the integrated loudness measurement.
+//  ---------------------------------------------------------------------------
+void reset_loudness( struct peak_meter_t *peak_meter )
+{
+    struct meter_loudness_t *loudness = &peak_meter->loudness;
+
+    memset( loudness, 0, sizeof( struct meter_loudness_t ));
+    loudness->momentary  = peak_meter->floor;
+    loudness->short_term = peak_meter->floor;
+    loudness->integrated = peak_meter->floor;
+    peak_meter->integrator.k_weight.pending = 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Adds completed sub-blocks to the loudness meter.
+//  ---------------------------------------------------------------------------
+/*
+    Each new sub-block completes a 400ms gating block with the previous 3.
+    The integrated loudness is the mean of the blocks above the relative
+    gate, which is 10LU below the mean of the blocks above the absolute
+    gate. Both means are found from the histogram.
+*/
+static void loudness_update( struct peak_meter_t *peak_meter )
+{
+    struct   meter_loudness_t *loudness = &peak_meter->loudness;
+    struct   meter_k_weight_t *k_weight = &peak_meter->integrator.k_weight;
+    double   momentary = 0, short_term = 0, total;
+    float    level;
+    uint32_t count;
+    uint16_t bin, start;
+    uint8_t  i, j;
+
+    if ( k_weight->pending == 0 ) return;
+
+    for ( i = 0; i < k_weight->pending; i++ )
+    {
+        loudness->block[loudness->next] = k_weight->energy[i];
+        loudness->next = ( loudness->next + 1 ) % METER_LUFS_BLOCKS;
+        if ( loudness->count < METER_LUFS_BLOCKS ) loudness->count++;
+        if ( loudness->count < 4 ) continue;
+
+        // Gating block from the last 4 sub-blocks.
+        for ( momentary = 0, j = 1; j <= 4; j++ )
+            momentary += loudness->block[( loudness->next + METER_LUFS_BLOCKS -
+                                           j ) % METER_LUFS_BLOCKS];
+        momentary /= 4;
+
+        level = energy_to_lufs( momentary, -128 );
+        if ( level < -70 ) continue;
+        bin = ( level >= 5 ) ? METER_LUFS_BINS - 1 : ( level + 70 ) * 10;
+        loudness->histogram[bin]++;
+        loudness->blocks++;
+    }
+    k_weight->pending = 0;
+
+    if ( loudness->count >= 4 )
+        loudness->momentary = energy_to_lufs( momentary, peak_meter->floor );
+
+    for ( j = 0; j < loudness->count; j++ ) short_term += loudness->block[j];
+    loudness->short_term = energy_to_lufs( short_term / loudness->count,
+                                           peak_meter->floor );
+
+    if ( loudness->blocks == 0 ) return;
+
+    // Relative gate.
+    for ( total = 0, bin = 0; bin < METER_LUFS_BINS; bin++ )
+        total += loudness->histogram[bin] * lufs_bin_energy( bin );
+    level = energy_to_lufs( total / loudness->blocks, -128 ) - 10;
+    start = ( level <= -70 ) ? 0 : ceil(( level + 70 ) * 10 );
+    if ( start >= METER_LUFS_BINS ) start = METER_LUFS_BINS - 1;
+
+    for ( total = 0, count = 0, bin = start; bin < METER_LUFS_BINS; bin++ )
+    {
+        total += loudness->histogram[bin] * lufs_bin_energy( bin );
+        count += loudness->histogram[bin];
+    }
+    if ( count > 0 )
+        loudness->integrated = energy_to_lufs( total / count,
+                                               peak_meter->floor );
+}
+
+//  ---------------------------------------------------------------------------
+//  Calculates peak dBfs values (L & R) of a number of stream samples.
+//  ---------------------------------------------------------------------------
+static void update_dBfs( struct peak_meter_t *peak_meter )
+{
+    const struct meter_source_t *source = meter_source;
+    struct   meter_integrator_t *integrator = &peak_meter->integrator;
+    struct   meter_true_peak_t *true_peak = &integrator->true_peak;
+    struct   meter_ring_t ring;
+    uint32_t sample_peak[METER_CHANNELS];
+    uint8_t  channel, shift;
+    float    scale;
+
+    source->start();
+
+    integrator->k_weight.enabled = peak_meter->lufs;
+    integrator->pyramid = peak_meter->pyramid;
+
+    for ( channel = 0; channel < METER_CHANNELS; channel++ )
+    {
+        sample_peak[channel] = 0;
+        true_peak->peak[channel] = 0;
+        true_peak->over[channel] = false;
+    }
+
+    if ( source->acquire() )
+    {
+        if (( vis_lockfree ) || ( source->lock == NULL ))
+        {
+            // Leave the previous levels if the frame was dropped.
+            if ( !integrate_source( source, integrator, peak_meter->samples,
+                                    sample_peak, peak_meter->over_peaks ))
+            {
+                source->release();
+                return;
+            }
+        }
+        else
+        {
+            source->lock( &ring );
+            integrate_window( integrator, peak_meter->samples,
+                              &ring, sample_peak, peak_meter->over_peaks );
+            source->unlock();
+        }
+        source->release();
+
+        if ( integrator->pyramid != NULL ) pyramid_commit( integrator );
+    }
+    else integrator->valid = false;
+
+    // Reference is for 16-bit samples.
+    shift = ( integrator->format == METER_S16 ) ? 0 : 8;
+    scale = 1 << shift;
+
+    if ( peak_meter->lufs ) loudness_update( peak_meter );
+
+    // True peak is always scaled to 16-bits in Q14.
+    for ( channel = 0; channel < METER_CHANNELS; channel++ )
+    {
+        if ( peak_meter->fixed_point )
+            peak_meter->dBtp[channel] =
+                energy_to_dBfs( peak_meter,
+                                (uint64_t) true_peak->peak[channel] *
+                                           true_peak->peak[channel], 1, 14 );
+        else
+            peak_meter->dBtp[channel] =
+                level_to_dBfs( peak_meter, true_peak->peak[channel] /
+                                           16384.0f );
+
+        if ( true_peak->over[channel] )
+        {
+            peak_meter->overload[channel] = true;
+            peak_meter->ballistics.over[channel] = 0;
+        }
+    }
+
+    if ( peak_meter->fixed_point )
+    {
+        if ( !peak_meter->configured ) init_peak_meter( peak_meter );
+
+        for ( channel = 0; channel < METER_CHANNELS; channel++ )
+        {
+            peak_meter->peak[channel] = sample_peak[channel];
+            peak_meter->dBpk[channel] =
+                energy_to_dBfs( peak_meter,
+                                (uint64_t) sample_peak[channel] *
+                                           sample_peak[channel], 1, shift );
+            peak_meter->dBfs[channel] = ( integrator->valid ) ?
+                energy_to_dBfs( peak_meter, integrator->sum[channel],
+                                integrator->frames, shift ) :
+                peak_meter->floor;
+        }
+        return;
+    }
+
+    for ( channel = 0; channel < METER_CHANNELS; channel++ )
+    {
+        peak_meter->peak[channel] = sample_peak[channel];
+        peak_meter->dBpk[channel] = level_to_dBfs( peak_meter,
+                                                   sample_peak[channel] /
+                                                   scale );
+        if (( !integrator->valid ) || ( integrator->frames == 0 ))
+        {
+            peak_meter->dBfs[channel] = peak_meter->floor;
+            continue;
+        }
+        peak_meter->dBfs[channel] =
+            level_to_dBfs( peak_meter,
+                           sqrt( (double) integrator->sum[channel] /
+                                          integrator->frames ) / scale );
+    }
+}
+
+//  ---------------------------------------------------------------------------
+//  Calculates peak dBfs values and counts the meter frame.
+//  ---------------------------------------------------------------------------
+void get_dBfs( struct peak_meter_t *peak_meter )
+{
+    uint64_t start = statsTime();
+
+    update_dBfs( peak_meter );
+
+    statsAdd( STATS_METER_FRAMES, 1 );
+    statsSince( STATS_METER_TIME, start );
+}
+
+
+//  ---------------------------------------------------------------------------
+//  Starts a new history in a min/max/RMS pyramid.
+//  ---------------------------------------------------------------------------
+void reset_pyramid( struct meter_pyramid_t *pyramid )
+{
+    pyramid->first = pyramid->leaves;
+}
+
+//  ---------------------------------------------------------------------------
+//  Gets the newest columns of a pyramid level. Returns the number got.
+//  ---------------------------------------------------------------------------
+/*
+    Nodes that start before the first leaf of the history are left out, as
+    they may have leaves of an earlier stream. The newest node is only
+    part filled unless the leaves so far fill it.
+*/
+uint16_t get_pyramid( const struct meter_pyramid_t *pyramid, uint8_t level,
+                      uint16_t columns, struct meter_column_t *column )
+{
+    const struct meter_pyramid_level_t *nodes;
+    uint64_t leaves = pyramid->leaves;
+    uint64_t oldest, newest, node, frames;
+    uint32_t slot;
+    uint16_t i;
+
+#define PYRAMID_COLUMN( c ) \
+    column[i].min[c] = nodes->min[c][slot]; \
+    column[i].max[c] = nodes->max[c][slot]; \
+    column[i].rms[c] = sqrt( (double) nodes->sum[c][slot] / frames );
+
+    if (( level >= METER_PYRAMID_LEVELS ) || ( leaves <= pyramid->first ))
+        return 0;
+
+    nodes  = &pyramid->level[level];
+    oldest = ( pyramid->first + ( 1u << level ) - 1 ) >> level;
+    newest = ( leaves - 1 ) >> level;
+    if ( newest < oldest ) return 0;
+
+    if ( columns > METER_PYRAMID_COLUMNS ) columns = METER_PYRAMID_COLUMNS;
+    if ( newest - oldest + 1 < columns ) columns = newest - oldest + 1;
+
+    for ( i = 0, node = newest + 1 - columns; i < columns; i++, node++ )
+    {
+        slot   = node % METER_PYRAMID_NODES;
+        frames = ((( node + 1 ) << level ) > leaves ) ?
+                 leaves - ( node << level ) : (uint64_t) 1 << level;
+        frames *= METER_PYRAMID_LEAF;
+
+        METER_UNROLL( PYRAMID_COLUMN )
+    }
+
+#undef PYRAMID_COLUMN
+
+    return columns;
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns the monotonic clock time in microseconds.
+//  ---------------------------------------------------------------------------
+static uint64_t meter_time_us( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return (uint64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+//  ---------------------------------------------------------------------------
+//  Runs the overload, hold and fall ballistics of one channel.
+//  ---------------------------------------------------------------------------
+/*
+    Inlined with a constant channel by get_dB_indices() for each channel.
+*/
+static inline void meter_ballistics( struct peak_meter_t *peak_meter,
+                                     uint8_t channel, uint32_t delta,
+                                     uint32_t hold, uint32_t fall,
+                                     uint32_t over )
+{
+    struct   meter_ballistics_t *ballistics = &peak_meter->ballistics;
+    uint32_t steps;
+    uint8_t  i;
+
+    // Countdown for overload reset. Overloads are set by get_dBfs.
+    if ( peak_meter->overload[channel] )
+    {
+        ballistics->over[channel] += delta;
+        if ( ballistics->over[channel] > over )
+        {
+            peak_meter->overload[channel] = false;
+            ballistics->over[channel] = 0;
+        }
+    }
+
+    // Find scale index for level.
+    if ( peak_meter->fixed_point )
+        i = peak_meter->dB_index[-peak_meter->dBfs[channel]];
+    else
+    {
+        for ( i = 0; i < peak_meter->num_levels; i++ )
+            if ( peak_meter->dBfs[channel] <= peak_meter->scale[i] )
+                break;
+        if ( i == peak_meter->num_levels ) i = 0xff;
+    }
+
+    // Concatenate output meter string.
+    if ( i != 0xff )
+    {
+        peak_meter->bar_index[channel] = i;
+        if ( i > peak_meter->dot_index[channel] )
+        {
+            // New peak so start holding it.
+            peak_meter->dot_index[channel] = i;
+            peak_meter->elapsed[channel]   = 0;
+            ballistics->falling[channel]   = false;
+            ballistics->fall[channel]      = 0;
+            return;
+        }
+    }
+
+    // Peak hold.
+    if ( !ballistics->falling[channel] )
+    {
+        peak_meter->elapsed[channel] += delta;
+        if ( peak_meter->elapsed[channel] < hold ) return;
+
+        ballistics->falling[channel] = true;
+        ballistics->fall[channel] = peak_meter->elapsed[channel] - hold;
+        if ( peak_meter->dot_index[channel] > 0 )
+             peak_meter->dot_index[channel]--;
+    }
+    else ballistics->fall[channel] += delta;
+
+    // Peak fall.
+    if ( fall == 0 )
+    {
+        peak_meter->dot_index[channel] = peak_meter->bar_index[channel];
+        return;
+    }
+    steps = ballistics->fall[channel] / fall;
+    ballistics->fall[channel] -= steps * fall;
+    if ( steps > peak_meter->dot_index[channel] )
+         steps = peak_meter->dot_index[channel];
+    peak_meter->dot_index[channel] -= steps;
+}
+
+//  ---------------------------------------------------------------------------
+//  Calculates the indices for string representations of the peak levels.
+//  ---------------------------------------------------------------------------
+/*
+    Time left over when the hold time expires, or between fall steps, is
+    carried forward so the dot falls at the same rate even if calls are
+    far apart.
+*/
+void get_dB_indices( struct peak_meter_t *peak_meter )
+{
+    struct   meter_ballistics_t *ballistics = &peak_meter->ballistics;
+    uint64_t now = meter_time_us();
+    uint32_t delta = 0;
+    uint32_t hold  = (uint32_t) peak_meter->hold_time * 1000;
+    uint32_t fall  = (uint32_t) peak_meter->fall_time * 1000;
+    uint32_t over  = (uint32_t) peak_meter->over_time * 1000;
+
+    if (( peak_meter->fixed_point ) && ( !peak_meter->configured ))
+        init_peak_meter( peak_meter );
+
+    // Time since last call, limited so that counters can't overflow.
+    if ( ballistics->started )
+    {
+        delta = ( now - ballistics->last > METER_MAX_DELTA ) ?
+                METER_MAX_DELTA : now - ballistics->last;
+    }
+    ballistics->last    = now;
+    ballistics->started = true;
+
+#define BALLISTICS( c ) \
+    meter_ballistics( peak_meter, c, delta, hold, fall, over );
+
+    METER_UNROLL( BALLISTICS )
+
+#undef BALLISTICS
+}
+
+//  ---------------------------------------------------------------------------
+//  Builds the FFT tables for a spectrum analyser.
+//  ---------------------------------------------------------------------------
+/*
+    The twiddles for each stage are stored contiguously, with the stage
+    that combines pairs of half length h starting at index h - 1, so that
+    they can be loaded as vectors. Band edges depend on the sample rate so
+    they are calculated by spectrum_set_bands() when the rate is known.
+*/
+bool init_spectrum( struct spectrum_meter_t *spectrum )
+{
+    uint16_t n, h, k, rev;
+    uint8_t  bits = 0, b;
+
+    spectrum->configured = false;
+
+    while (( 1 << bits ) < spectrum->size ) bits++;
+    if (( spectrum->size != ( 1 << bits )) ||
+        ( spectrum->size < 16 ) || ( spectrum->size > SPECTRUM_SIZE_MAX ) ||
+        ( spectrum->overlap >= spectrum->size ) ||
+        ( spectrum->num_bands == 0 ) ||
+        ( spectrum->num_bands > SPECTRUM_BANDS_MAX ) ||
+        ( spectrum->min_freq == 0 ) ||
+        ( spectrum->min_freq >= spectrum->max_freq ))
+        return false;
+
+    spectrum->bits = bits;
+
+    for ( n = 0; n < spectrum->size; n++ )
+    {
+        for ( rev = 0, b = 0; b < bits; b++ )
+            if ( n & ( 1 << b )) rev |= 1 << ( bits - 1 - b );
+        spectrum->bitrev[n] = rev;
+
+        spectrum->window[n] = (int16_t)( 32767 * 0.5 *
+                              ( 1 - cos( 2 * M_PI * n / spectrum->size )));
+    }
+
+    for ( h = 1; h < spectrum->size; h <<= 1 )
+    {
+        for ( k = 0; k < h; k++ )
+        {
+            spectrum->twiddle_re[h - 1 + k] =
+                (int16_t) lrint( 32767 * cos( M_PI * k / h ));
+            spectrum->twiddle_im[h - 1 + k] =
+                (int16_t) lrint( -32767 * sin( M_PI * k / h ));
+        }
+    }
+
+    if ( meter_log2_ready == false )
+    {
+        for ( n = 0; n <= METER_LOG2_SIZE; n++ )
+            meter_log2[n] = (uint32_t)( log2( 1.0 + (double) n /
+                                        METER_LOG2_SIZE ) * 65536 + 0.5 );
+        meter_log2_ready = true;
+    }
+
+    spectrum->rate   = 0;
+    spectrum->buffer = NULL;
+    spectrum->configured = true;
+
+    return true;
+}
+
+//  ---------------------------------------------------------------------------
+//  Calculates the first FFT bin of each log spaced band.
+//  ---------------------------------------------------------------------------
+/*
+    Each band has at least one bin, so at low frequencies the bands may be
+    wider than logarithmic spacing would give.
+*/
+static void spectrum_set_bands( struct spectrum_meter_t *spectrum,
+                                uint32_t rate )
+{
+    uint16_t half = spectrum->size / 2;
+    double   ratio = (double) spectrum->max_freq / spectrum->min_freq;
+    double   freq;
+    uint32_t bin;
+    uint8_t  b;
+
+    for ( b = 0; b <= spectrum->num_bands; b++ )
+    {
+        freq = spectrum->min_freq * pow( ratio, (double) b /
+                                                spectrum->num_bands );
+        bin = lrint( freq * spectrum->size / rate );
+        if ( bin < 1 ) bin = 1;
+        if (( b > 0 ) && ( bin <= spectrum->band[b - 1] ))
+            bin = spectrum->band[b - 1] + 1;
+        if ( bin > half ) bin = half;
+        spectrum->band[b] = bin;
+    }
+
+    spectrum->rate = rate;
+}
+
+//  ---------------------------------------------------------------------------
+//  Copies the newest window of frames from a source, scaled to 16-bits.
+//  ---------------------------------------------------------------------------
+/*
+    The frames are copied without holding a lock and checked afterwards in
+    the same way as integrate_source(). Returns false if there aren't enough
+    new frames since the last window, or the copy was lapped.
+*/
+static bool spectrum_read( struct spectrum_meter_t *spectrum,
+                           const struct meter_source_t *source )
+{
+    struct   meter_ring_t ring;
+    struct   meter_span_t span[2];
+    const int16_t *s16;
+    const int32_t *s32;
+    uint32_t fresh, n, i, frames;
+    uint16_t hop = spectrum->size - spectrum->overlap;
+    uint8_t  attempt, spans, sp;
+    bool     locked = false;
+
+#define SPECTRUM_S16( c ) spectrum->input[c][n] = s16[c];
+#define SPECTRUM_S24( c ) \
+    spectrum->input[c][n] = (int32_t)( (uint32_t) s32[c] << 8 ) >> 16;
+#define SPECTRUM_S32( c ) spectrum->input[c][n] = s32[c] >> 16;
+
+    for ( attempt = 0; attempt <= VIS_READ_RETRIES + 1; attempt++ )
+    {
+        // Final attempt is locked if the source allows it.
+        if ( attempt > VIS_READ_RETRIES )
+        {
+            if ( source->lock == NULL ) break;
+            source->lock( &ring );
+            locked = true;
+        }
+        else source->snapshot( &ring );
+
+        if (( !ring.running ) || ( ring.size < METER_CHANNELS )) break;
+
+        // Wait for enough new frames.
+        if ( spectrum->buffer == ring.buffer )
+        {
+            fresh = (( ring.index + ring.size - spectrum->index ) %
+                     ring.size ) / METER_CHANNELS;
+            if ( fresh < hop ) break;
+        }
+
+        spans = meter_get_spans( &ring, ring.index, spectrum->size, span );
+        for ( frames = 0, sp = 0; sp < spans; sp++ )
+            frames += span[sp].frames;
+        if ( frames < spectrum->size ) break;
+
+        for ( n = 0, sp = 0; sp < spans; sp++ )
+        {
+            s16 = span[sp].ptr;
+            s32 = span[sp].ptr;
+            if ( ring.format == METER_S16 )
+                for ( i = 0; i < span[sp].frames;
+                      i++, n++, s16 += METER_CHANNELS )
+                {
+                    METER_UNROLL( SPECTRUM_S16 )
+                }
+            else if ( ring.format == METER_S24 )
+                for ( i = 0; i < span[sp].frames;
+                      i++, n++, s32 += METER_CHANNELS )
+                {
+                    METER_UNROLL( SPECTRUM_S24 )
+                }
+            else
+                for ( i = 0; i < span[sp].frames;
+                      i++, n++, s32 += METER_CHANNELS )
+                {
+                    METER_UNROLL( SPECTRUM_S32 )
+                }
+        }
+
+        if (( locked ) ||
+            ( spectrum->size * METER_CHANNELS + ring.guard > ring.size ) ||
+            ( !source->lapped( &ring, spectrum->size )))
+        {
+            if ( locked ) source->unlock();
+            spectrum->buffer = ring.buffer;
+            spectrum->index  = ring.index;
+            if ( spectrum->rate != ring.rate )
+                spectrum_set_bands( spectrum, ring.rate );
+            return true;
+        }
+        vis_stats.retries++;
+    }
+
+#undef SPECTRUM_S32
+#undef SPECTRUM_S24
+#undef SPECTRUM_S16
+
+    if ( locked ) source->unlock();
+
+    return false;
+}
+
+//  ---------------------------------------------------------------------------
+//  In place fixed point radix-2 FFT with block floating point scaling.
+//  ---------------------------------------------------------------------------
+/*
+    The input must already be in bit reversed order. Before each stage the
+    largest value is checked and the stage's outputs are scaled down by 1 or
+    2 bits if a butterfly could overflow. A butterfly can grow a value by up
+    to 1 + sqrt(2). Returns the total number of bits scaled down, so that
+    the result is X(k) / 2^returned.
+
+    With NEON and vector set, the butterflies of stages with 4 or more in
+    each group are done 4 at a time. Products are kept at 32-bits and
+    rounded in the same way as the scalar code so both give identical
+    results.
+*/
+static uint8_t spectrum_fft( struct spectrum_meter_t *spectrum, bool vector )
+{
+    int16_t  *re = spectrum->re;
+    int16_t  *im = spectrum->im;
+    uint16_t size = spectrum->size;
+    uint16_t h, g, k, top;
+    int32_t  tr, ti, ar, ai, max;
+    uint8_t  shift, scaled = 0;
+    const int16_t *wr, *wi;
+
+#if !defined( __ARM_NEON ) && !defined( __ARM_NEON__ )
+    (void) vector;
+#endif
+
+    for ( h = 1; h < size; h <<= 1 )
+    {
+        // Find headroom for this stage.
+        for ( max = 0, k = 0; k < size; k++ )
+        {
+            if ( abs( re[k] ) > max ) max = abs( re[k] );
+            if ( abs( im[k] ) > max ) max = abs( im[k] );
+        }
+        shift = ( max < 13573 ) ? 0 : ( max < 27146 ) ? 1 : 2;
+        scaled += shift;
+
+        wr = spectrum->twiddle_re + h - 1;
+        wi = spectrum->twiddle_im + h - 1;
+
+        for ( g = 0; g < size; g += 2 * h )
+        {
+            k = 0;
+#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+            int32x4_t vshift = vdupq_n_s32( -shift );
+            int32x4_t var, vai, vtr, vti;
+            int16x4_t vwr, vwi, vbr, vbi;
+
+            for ( ; vector && ( k + 4 <= h ); k += 4 )
+            {
+                top = g + k + h;
+                vwr = vld1_s16( wr + k );
+                vwi = vld1_s16( wi + k );
+                vbr = vld1_s16( re + top );
+                vbi = vld1_s16( im + top );
+                var = vmovl_s16( vld1_s16( re + g + k ));
+                vai = vmovl_s16( vld1_s16( im + g + k ));
+
+                // Products stay 32-bit as they can reach sqrt(2) * max.
+                vtr = vrshrq_n_s32( vmlsl_s16( vmull_s16( vbr, vwr ),
+                                               vbi, vwi ), 15 );
+                vti = vrshrq_n_s32( vmlal_s16( vmull_s16( vbr, vwi ),
+                                               vbi, vwr ), 15 );
+
+                vst1_s16( re + g + k, vmovn_s32(
+                          vshlq_s32( vaddq_s32( var, vtr ), vshift )));
+                vst1_s16( im + g + k, vmovn_s32(
+                          vshlq_s32( vaddq_s32( vai, vti ), vshift )));
+                vst1_s16( re + top, vmovn_s32(
+                          vshlq_s32( vsubq_s32( var, vtr ), vshift )));
+                vst1_s16( im + top, vmovn_s32(
+                          vshlq_s32( vsubq_s32( vai, vti ), vshift )));
+            }
+#endif
+            for ( ; k < h; k++ )
+            {
+                top = g + k + h;
+                tr = ( re[top] * wr[k] - im[top] * wi[k] + 0x4000 ) >> 15;
+                ti = ( re[top] * wi[k] + im[top] * wr[k] + 0x4000 ) >> 15;
+                ar = re[g + k];
+                ai = im[g + k];
+
+                re[g + k] = ( ar + tr ) >> shift;
+                im[g + k] = ( ai + ti ) >> shift;
+                re[top]   = ( ar - tr ) >> shift;
+                im[top]   = ( ai - ti ) >> shift;
+            }
+        }
+    }
+
+    return scaled;
+}
+
+//  ---------------------------------------------------------------------------
+//  Calculates the band levels of the spectrum.
+//  ---------------------------------------------------------------------------
+/*
+    Each channel is windowed and loaded in bit reversed order in one pass,
+    transformed, and the power of the bins in each band summed. A full scale
+    sine wave gives a peak bin of 2^15 * size / 4 with a Hann window, and
+    the window spreads its power over 1.5 bins, so the reference power is
+
+        log2( ref ) = 2 ( 15 + bits - 2 ) + log2( 1.5 )
+
+    With 16-bit block floating point, rounding noise limits the range to
+    around 70dB below the loudest band, which is more than a small display
+    can show.
+*/
+bool get_spectrum( struct spectrum_meter_t *spectrum )
+{
+    const struct meter_source_t *source = meter_source;
+    uint64_t power;
+    int32_t  log2_ref, log2_power;
+    uint16_t n, bin, rev;
+    uint8_t  channel, b, scaled;
+    bool     ok;
+
+    if (( !spectrum->configured ) && ( !init_spectrum( spectrum )))
+        return false;
+
+    source->start();
+    if ( !source->acquire() ) return false;
+    ok = spectrum_read( spectrum, source );
+    source->release();
+    if ( !ok ) return false;
+
+    log2_ref = (( 2 * ( 15 + spectrum->bits - 2 )) << 16 ) + 38337;
+
+    for ( channel = 0; channel < METER_CHANNELS; channel++ )
+    {
+        for ( n = 0; n < spectrum->size; n++ )
+        {
+            rev = spectrum->bitrev[n];
+            spectrum->re[n] = ( spectrum->input[channel][rev] *
+                                spectrum->window[rev] + 0x4000 ) >> 15;
+            spectrum->im[n] = 0;
+        }
+
+        scaled = spectrum_fft( spectrum, true );
+
+        for ( b = 0; b < spectrum->num_bands; b++ )
+        {
+            power = 0;
+            for ( bin = spectrum->band[b]; bin < spectrum->band[b + 1]; bin++ )
+                power += (uint32_t)( spectrum->re[bin] * spectrum->re[bin] ) +
+                         (uint32_t)( spectrum->im[bin] * spectrum->im[bin] );
+
+            if ( power == 0 ) spectrum->dB[channel][b] = spectrum->floor;
+            else
+            {
+                log2_power = log2_q16( power ) +
+                             ((int32_t)( 2 * scaled ) << 16 ) - log2_ref;
+                spectrum->dB[channel][b] = log2_to_dB( log2_power,
+                                                       spectrum->floor );
+            }
+
+            spectrum->height[channel][b] = ( spectrum->floor == 0 ) ? 0 :
+                ( spectrum->dB[channel][b] - spectrum->floor ) *
+                spectrum->num_levels / -spectrum->floor;
+        }
+    }
+
+    return true;
+}
+
+//  ---------------------------------------------------------------------------
+//  Loads an input for the FFT check in bit reversed order.
+//  ---------------------------------------------------------------------------
+/*
+    Input 0 repeats 8 values that the first two stages turn into
+    ( 27144, 27144 ) at k = 1 of the third stage, which is shifted by 1 bit
+    and gives a product of sqrt(2) * 27144 with the pi/4 twiddle. The first
+    stage needs no headroom, so nothing is lost before the third stage.
+    Input i is a full scale square wave with a period of 2^i.
+*/
+static void spectrum_check_input( struct spectrum_meter_t *spectrum,
+                                  uint8_t input )
+{
+    static const int16_t re[8] = { 0, 0, 0, 0,  13572, 0, -13572, 0 };
+    static const int16_t im[8] = { 0, 0, 0, 0,  13572, 0,  13572, 0 };
+    uint16_t n;
+
+    for ( n = 0; n < spectrum->size; n++ )
+    {
+        if ( input == 0 )
+        {
+            spectrum->re[n] = re[n & 7];
+            spectrum->im[n] = im[n & 7];
+        }
+        else
+        {
+            spectrum->re[n] = ( spectrum->bitrev[n] & ( 1 << ( input - 1 ))) ?
+                              -32768 : 32767;
+            spectrum->im[n] = 0;
+        }
+    }
+}
+
+//  ---------------------------------------------------------------------------
+//  Checks the vector FFT against the scalar FFT.
+//  ---------------------------------------------------------------------------
+/*
+    The inputs are ones where the butterfly products come close to
+    sqrt(2) * max, and full scale square waves. The FFT is run on each with
+    and without vectors and the bins compared.
+*/
+bool check_spectrum_fft( struct spectrum_meter_t *spectrum )
+{
+    static int16_t re[SPECTRUM_SIZE_MAX];
+    static int16_t im[SPECTRUM_SIZE_MAX];
+    uint8_t  input, scaled;
+
+    if (( !spectrum->configured ) && ( !init_spectrum( spectrum )))
+        return false;
+
+    for ( input = 0; input <= spectrum->bits; input++ )
+    {
+        spectrum_check_input( spectrum, input );
+        scaled = spectrum_fft( spectrum, false );
+        memcpy( re, spectrum->re, spectrum->size * sizeof( int16_t ));
+        memcpy( im, spectrum->im, spectrum->size * sizeof( int16_t ));
+
+        spectrum_check_input( spectrum, input );
+        if (( spectrum_fft( spectrum, true ) != scaled ) ||
+            ( memcmp( re, spectrum->re,
+                      spectrum->size * sizeof( int16_t )) != 0 ) ||
+            ( memcmp( im, spectrum->im,
+                      spectrum->size * sizeof( int16_t )) != 0 ))
+            return false;
+    }
+
+    return true;
 }
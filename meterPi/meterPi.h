@@ -32,6 +32,25 @@
         v01.01      Renamed and converted to library.
         v01.02      Added hold and fall timing.
         v01.03      Added overload detection.
+        v01.04      Added span based integration kernel and sample peaks.
+        v01.05      Added incremental sliding window integrator.
+        v01.06      Added lock free snapshot reader and lock statistics.
+        v01.07      Added event driven shared memory attach manager.
+        v01.08      Added pluggable sources and ALSA mmap capture source.
+        v01.09      Added integer dB conversion and scale lookup table.
+        v01.10      Moved ballistics into meter and timed from monotonic clock.
+        v01.11      Added oversampled true peak detector for overload.
+        v01.12      Added fixed point FFT spectrum analyser.
+        v01.13      Added EBU R128 loudness meter.
+        v01.14      Added thx1138 shared memory stream source.
+        v01.15      Added statsPi counters.
+        v01.16      Added meter_get_playing for frame pacing.
+        v01.17      Buffer watcher thread runs in the rtPi UI role.
+        v01.18      METER_CHANNELS set at compile time with unrolled kernels.
+        v01.19      Added min/max/RMS pyramid for waveform and history views.
+        v01.20      NEON FFT keeps products at 32-bits, added FFT check.
+        v01.21      Caps pyramid leaves per read at the nodes past the history.
+        v01.22      Waits for the thx1138 magic number before reading the stream.
 */
 //  ===========================================================================
 
@@ -52,6 +71,16 @@
     the way of an API so this code represents an effort to figure out the
     shared buffer and use it allow visualisations to be coded for small LCD or
     OLED displays.
+
+    The samples are read through a source interface so that other buffers
+    can be metered. As well as the Squeezelite buffer there is a source that
+    reads native S16, S24 or S32 frames straight from an ALSA capture device
+    (e.g. a loopback or dsnoop device) using mmap access. This doesn't need
+    Squeezelite to be run with -v and isn't limited to the 16-bit samples and
+    fixed buffer size of the shared memory object. The thx1138 daemon in
+    streamPi captures in the same way in its own process and publishes the
+    native frames in a bigger shared memory buffer laid out like
+    Squeezelite's, which can be metered by any number of readers.
 */
 
 /*
@@ -114,6 +143,28 @@
     consecutive 0dBFS readings. There are other variations but this one is
     fairly straightforward to understand...
 
+    The overshoot happens between samples so it can't be seen from the
+    samples themselves, let alone an RMS level. Overloads are detected from
+    a true peak measurement as described in ITU-R BS.1770, where the signal
+    is oversampled 4 times with a polyphase FIR filter and the peak of the
+    oversampled signal is found. An overload is over_peaks consecutive
+    oversampled values at or above full scale.
+
+    Loudness Meter:
+
+    EBU R128 specifies programme loudness in LUFS as measured by ITU-R
+    BS.1770. The signal is K-weighted by a high shelf and a high pass filter
+    and the mean square is found over the following windows:
+
+        Momentary   400ms, sliding.
+        Short term  3s, sliding.
+        Integrated  Since reset, gated blocks of 400ms with 75% overlap.
+
+    Blocks quieter than -70LUFS and then blocks more than 10LU below the
+    level of the remaining blocks are ignored for the integrated loudness.
+    The blocks are counted in a histogram of 0.1LU bins rather than being
+    stored so the memory used is fixed, however long the measurement.
+
     e.g.
 
      DAC overshoot -------> . '      } Overload
@@ -140,54 +191,504 @@
 
 #define VIS_BUF_SIZE 16384 // Predefined in Squeezelite.
 #define PEAK_METER_LEVELS_MAX 48 // Number of peak meter intervals / LEDs.
-#define METER_CHANNELS 2 // Number of metered channels.
+#ifndef METER_CHANNELS
+#define METER_CHANNELS 2 // Number of metered channels, 1, 2, 6 or 8.
+#endif
 #define OVERLOAD_PEAKS 3 // Number of consecutive 0dBFS peaks for overload.
+#define METER_DB_RANGE 129 // Number of whole dB values from 0 to -128dB.
+#define METER_TP_TAPS 12 // Taps in each phase of true peak filter.
+#define SPECTRUM_SIZE_MAX 2048 // Largest FFT size (frames).
+#define SPECTRUM_BANDS_MAX 64 // Largest number of spectrum bands.
+#define METER_LUFS_BLOCKS 30 // 100ms sub-blocks in short term window.
+#define METER_LUFS_PENDING 32 // Sub-blocks that can complete in one read.
+#define METER_LUFS_BINS 750 // 0.1LU histogram bins from -70 to +5LUFS.
+#define METER_PYRAMID_LEAF 16 // Frames in each leaf of the pyramid.
+#define METER_PYRAMID_LEVELS 16 // Pyramid levels, leaves to 2^15 leaves.
+#define METER_PYRAMID_NODES 512 // Nodes held at each level.
+#define METER_PYRAMID_COLUMNS 256 // Newest nodes of each level in history.
+
+/*
+    The channel count is fixed when the library is built, e.g. with
+    -DMETER_CHANNELS=6 for 5.1, and programs using it must be built with the
+    same value. METER_UNROLL( m ) expands m( channel ) once for each channel
+    with a constant channel number, so that the per channel kernels are
+    generated fully unrolled for each supported count rather than looping.
+    Squeezelite's buffer is always stereo, so other counts need the ALSA or
+    thx1138 source.
+*/
+#if METER_CHANNELS == 1
+#define METER_UNROLL( m ) m( 0 )
+#elif METER_CHANNELS == 2
+#define METER_UNROLL( m ) m( 0 ) m( 1 )
+#elif METER_CHANNELS == 6
+#define METER_UNROLL( m ) m( 0 ) m( 1 ) m( 2 ) m( 3 ) m( 4 ) m( 5 )
+#elif METER_CHANNELS == 8
+#define METER_UNROLL( m ) m( 0 ) m( 1 ) m( 2 ) m( 3 ) m( 4 ) m( 5 ) \
+                          m( 6 ) m( 7 )
+#else
+#error "METER_CHANNELS must be 1, 2, 6 or 8."
+#endif
 
 //  Types. --------------------------------------------------------------------
 
+/*
+    State of the true peak detector. The history holds the last input
+    samples, scaled to 16-bits, so that the filter runs on continuously
+    from one read to the next.
+*/
+struct meter_true_peak_t
+{
+    int16_t  history [METER_CHANNELS][METER_TP_TAPS - 1]; // Last samples.
+    uint32_t peak    [METER_CHANNELS]; // Oversampled peak of new frames (Q14).
+    uint16_t run     [METER_CHANNELS]; // Consecutive values over full scale.
+    bool     over    [METER_CHANNELS]; // Overload in new frames.
+};
+
+/*
+    K-weighting filters and the current 100ms sub-block. Completed
+    sub-blocks are queued until they are added to the loudness meter so
+    that a read that is retried doesn't count them twice.
+*/
+struct meter_k_weight_t
+{
+    bool     enabled;    // Loudness is being measured.
+    uint32_t rate;       // Sample rate of coefficients.
+    float    b[2][3];    // Shelf and high pass numerators.
+    float    a[2][2];    // Shelf and high pass denominators (a1, a2).
+    float    z[2][2][METER_CHANNELS]; // Filter states by stage and delay.
+    double   sum;        // Sum of squares of current sub-block.
+    uint32_t frames;     // Frames in current sub-block.
+    uint8_t  pending;    // Completed sub-blocks waiting to be added.
+    double   energy[METER_LUFS_PENDING]; // Mean squares of sub-blocks.
+};
+
+/*
+    The pyramid leaf being filled. Only completed leaves are written to the
+    pyramid, so a read that is retried fills the same leaves again.
+*/
+struct meter_leaf_t
+{
+    uint64_t number;     // Leaf being filled, counted from the first.
+    uint16_t frames;     // Frames in leaf so far.
+    int16_t  min [METER_CHANNELS]; // Lowest sample (16-bit).
+    int16_t  max [METER_CHANNELS]; // Highest sample (16-bit).
+    uint64_t sum [METER_CHANNELS]; // Sum of squares (16-bit).
+};
+
+/*
+    Running state of the sliding window integrator. Each meter has its own
+    so that meters with different integration times can share a stream.
+*/
+struct meter_integrator_t
+{
+    bool     valid;   // Sums are valid for the current window.
+    const void *buffer; // Ring buffer at last update.
+    uint8_t  format;  // Sample format at last update.
+    uint32_t index;   // Buffer index at last update.
+    uint32_t len;     // Buffer length at last update.
+    uint32_t window;  // Window length (frames) of current sums.
+    uint32_t frames;  // Frames actually integrated in the window.
+    uint64_t sum [METER_CHANNELS]; // Sum of squares over the window.
+    struct meter_true_peak_t true_peak; // True peak of new frames.
+    struct meter_k_weight_t  k_weight;  // Loudness filters of new frames.
+    struct meter_pyramid_t  *pyramid;   // Pyramid fed with new frames.
+    struct meter_leaf_t      leaf;      // Pyramid leaf being filled.
+};
+
+/*
+    Statistics for the rwlock shared with Squeezelite. The output thread must
+    take the same lock as a writer, so the hold times here are the delays
+    that metering can add to audio output. The retry and drop counts are for
+    whichever source is in use.
+*/
+struct vis_stats_t
+{
+    uint32_t locks;      // Number of times the lock was held.
+    uint32_t hold_last;  // Last lock hold time (ns).
+    uint32_t hold_max;   // Longest lock hold time (ns).
+    uint64_t hold_total; // Total lock hold time (ns).
+    uint32_t retries;    // Lock free reads retried after being lapped.
+    uint32_t dropped;    // Frames dropped after too many retries.
+};
+
+/*
+    Sample formats of source ring buffers. S24 is 24-bit audio in the low 3
+    bytes of a 32-bit container.
+*/
+enum meter_format_t
+{
+    METER_S16,
+    METER_S24,
+    METER_S32
+};
+
+/*
+    State of a source ring buffer, copied at the start of each read. Sizes
+    and indices are in samples so that a frame is METER_CHANNELS samples.
+*/
+struct meter_ring_t
+{
+    const void *buffer;  // Start of ring buffer.
+    uint32_t   size;     // Size of ring buffer (samples).
+    uint32_t   index;    // Index of next sample to be written.
+    uint32_t   guard;    // Samples ahead of index that may be being written.
+    uint32_t   rate;     // Sample rate (Hz).
+    uint8_t    format;   // Sample format (enum meter_format_t).
+    bool       running;  // Stream is running.
+};
+
+/*
+    Operations provided by a source. Samples are read without stopping the
+    writer and lapped() is used afterwards to check that they were still
+    valid. Sources that have a lock shared with the writer can also provide
+    lock() and unlock(), which are used for reads that are too long to be
+    checked, or for all reads if lock free reading is turned off.
+*/
+struct meter_source_t
+{
+    void     (*start)( void );    // Starts or attaches to the source.
+    bool     (*acquire)( void );  // Registers a reader if samples available.
+    void     (*release)( void );  // Releases a reader.
+    void     (*snapshot)( struct meter_ring_t *ring ); // Copies ring state.
+    bool     (*lapped)( const struct meter_ring_t *ring, uint32_t extent );
+    void     (*lock)( struct meter_ring_t *ring ); // Locks and copies state.
+    void     (*unlock)( void );
+    void     (*stop)( void );     // Detaches from the source.
+    uint32_t (*get_rate)( void ); // Returns the sample rate.
+};
+
+/*
+    Loudness meter results and gating state. Levels are LUFS, or the meter
+    floor if there isn't a measurement yet.
+*/
+struct meter_loudness_t
+{
+    double   block [METER_LUFS_BLOCKS]; // Mean squares of last sub-blocks.
+    uint8_t  next;       // Next sub-block to be replaced.
+    uint8_t  count;      // Number of valid sub-blocks.
+    uint32_t histogram [METER_LUFS_BINS]; // Gating block counts.
+    uint32_t blocks;     // Gating blocks above absolute gate.
+    float    momentary;  // Momentary loudness (LUFS).
+    float    short_term; // Short term loudness (LUFS).
+    float    integrated; // Integrated loudness (LUFS).
+};
+
+/*
+    Ballistics state of each meter. The hold, fall and overload times are
+    measured from the monotonic clock between calls so they don't depend on
+    the frame rate and each meter keeps its own state.
+*/
+struct meter_ballistics_t
+{
+    uint64_t last;     // Time of last update (us).
+    bool     started;  // Time of last update is valid.
+    bool     falling  [METER_CHANNELS]; // Peak hold time has expired.
+    uint32_t fall     [METER_CHANNELS]; // Time since last fall step (us).
+    uint32_t over     [METER_CHANNELS]; // Time overload shown (us).
+};
+
 struct peak_meter_t
 {
     uint16_t int_time;   // Integration time (ms).
     uint16_t samples;    // Samples for integration time.
     uint16_t hold_time;  // Peak hold time (ms).
-    uint16_t hold_incs;  // Hold time counter.
-    uint16_t fall_time;  // Fall time (ms).
-    uint16_t fall_incs;  // Fall time counter.
-    uint8_t  over_peaks; // Number of consecutive 0dBFS samples for overload.
+    uint16_t fall_time;  // Fall time for each level (ms).
+    uint8_t  over_peaks; // Consecutive oversampled 0dBTP values for overload.
     uint16_t over_time;  // Overload indicator time (ms).
-    uint16_t over_incs;  // Overload indicator count.
     uint8_t  num_levels; // Number of display levels
     int8_t   floor;      // Noise floor for meter (dB).
     uint16_t reference;  // Reference level.
     bool     overload  [METER_CHANNELS]; // Overload flags.
-    int8_t   dBfs      [METER_CHANNELS]; // dBfs values.
+    int8_t   dBfs      [METER_CHANNELS]; // dBfs values (RMS).
+    int8_t   dBpk      [METER_CHANNELS]; // dBfs values (sample peak).
+    int8_t   dBtp      [METER_CHANNELS]; // dBfs values (true peak).
+    uint32_t peak      [METER_CHANNELS]; // Absolute sample peaks (native).
     uint8_t  bar_index [METER_CHANNELS]; // Index for bar display.
     uint8_t  dot_index [METER_CHANNELS]; // Index for dot display (peak hold).
-    uint32_t elapsed   [METER_CHANNELS]; // Elapsed time (us).
+    uint32_t elapsed   [METER_CHANNELS]; // Time peak has been held (us).
     int16_t  scale     [PEAK_METER_LEVELS_MAX]; // Scale intervals.
+    bool     fixed_point; // Use integer dB conversion and scale lookup.
+    bool     lufs;        // Measure loudness.
+    struct meter_pyramid_t *pyramid; // Pyramid to feed, or NULL if none.
+    bool     configured;  // Lookup table has been built from scale.
+    uint8_t  dB_index  [METER_DB_RANGE]; // Scale index for each -dB value.
+    struct meter_integrator_t integrator; // Sliding window state.
+    struct meter_ballistics_t ballistics; // Peak hold and overload state.
+    struct meter_loudness_t   loudness;   // Loudness if lufs is set.
+};
+
+
+/*
+    Spectrum analyser. The first block of fields are set by the caller and
+    init_spectrum() is then called to build the tables. The FFT size must
+    be a power of 2. A new spectrum is calculated each time size - overlap
+    new frames are available, e.g. 2048 frames with an overlap of 576 gives
+    30 spectra a second at 44.1kHz. All buffers are held here so nothing is
+    allocated while running.
+*/
+struct spectrum_meter_t
+{
+    uint16_t size;       // FFT size (frames).
+    uint16_t overlap;    // Frames shared by consecutive windows.
+    uint8_t  num_bands;  // Number of log spaced bands.
+    uint16_t min_freq;   // Lower edge of lowest band (Hz).
+    uint16_t max_freq;   // Upper edge of highest band (Hz).
+    int8_t   floor;      // Lowest band level (dB).
+    uint8_t  num_levels; // Display height, e.g. 16 for 2 rows of 8 pixels.
+    int8_t   dB     [METER_CHANNELS][SPECTRUM_BANDS_MAX]; // Band levels.
+    uint8_t  height [METER_CHANNELS][SPECTRUM_BANDS_MAX]; // Band heights.
+    bool     configured; // Tables have been built.
+    uint8_t  bits;       // log2 of FFT size.
+    uint32_t rate;       // Sample rate bands were calculated for.
+    const void *buffer;  // Source buffer of last window.
+    uint32_t index;      // Source buffer index of last window.
+    uint16_t band  [SPECTRUM_BANDS_MAX + 1]; // First FFT bin of each band.
+    uint16_t bitrev[SPECTRUM_SIZE_MAX];      // Bit reversed indices.
+    int16_t  window[SPECTRUM_SIZE_MAX];      // Hann window (Q15).
+    int16_t  twiddle_re[SPECTRUM_SIZE_MAX];  // Twiddles for each stage (Q15).
+    int16_t  twiddle_im[SPECTRUM_SIZE_MAX];
+    int16_t  input [METER_CHANNELS][SPECTRUM_SIZE_MAX]; // Window of frames.
+    int16_t  re    [SPECTRUM_SIZE_MAX]; // FFT work buffers.
+    int16_t  im    [SPECTRUM_SIZE_MAX];
+};
+
+/*
+    Min/max/RMS pyramid for waveform and level history views. Level 0 nodes
+    are leaves of METER_PYRAMID_LEAF frames and each node of the levels
+    above covers two nodes of the level below, so a node at level k covers
+    METER_PYRAMID_LEAF << k frames. Each level has a history of its newest
+    METER_PYRAMID_COLUMNS nodes, so the coarser levels go further back, e.g.
+    at 44.1kHz a column is 0.36ms at level 0 and 12s at level 15.
+
+    The pyramid is fed by get_dBfs() from the same reads as the meter.
+    Only the new leaves and their ancestors are updated, which is about two
+    nodes for each leaf. Samples are scaled to 16-bits as for true peak.
+    The nodes past the history take the leaves of a read before it is
+    accepted, so a dropped frame can't spoil the history. A read makes no
+    more leaves than there are nodes past the history, so a long one only
+    keeps its newest METER_PYRAMID_NODES - METER_PYRAMID_COLUMNS leaves.
+*/
+struct meter_pyramid_level_t
+{
+    int16_t  min [METER_CHANNELS][METER_PYRAMID_NODES]; // Lowest samples.
+    int16_t  max [METER_CHANNELS][METER_PYRAMID_NODES]; // Highest samples.
+    uint64_t sum [METER_CHANNELS][METER_PYRAMID_NODES]; // Sums of squares.
+};
+
+struct meter_pyramid_t
+{
+    uint64_t first;  // First leaf of the current history.
+    uint64_t leaves; // Leaves completed.
+    struct meter_pyramid_level_t level[METER_PYRAMID_LEVELS];
 };
 
+/*
+    A column of a waveform or history view, from one pyramid node.
+*/
+struct meter_column_t
+{
+    int16_t  min [METER_CHANNELS]; // Lowest sample (16-bit).
+    int16_t  max [METER_CHANNELS]; // Highest sample (16-bit).
+    uint16_t rms [METER_CHANNELS]; // RMS level (16-bit).
+};
 
 //  Functions. ----------------------------------------------------------------
 
 //  ---------------------------------------------------------------------------
-//  Checks status of mmap and attempt to open/reopen if not updated recently.
+//  Starts the shared memory attach manager if it isn't already running.
 //  ---------------------------------------------------------------------------
+/*
+    A watcher thread waits for Squeezelite's shared memory object to appear
+    in /dev/shm, attaches to it and checks for a stale update time at a low
+    rate. Once started, calling this only costs a flag check.
+*/
 void vis_check( void );
 
+//  ---------------------------------------------------------------------------
+//  Stops the attach manager and unmaps shared memory.
+//  ---------------------------------------------------------------------------
+void vis_close( void );
+
 //  ---------------------------------------------------------------------------
 //  Returns the stream bit rate.
 //  ---------------------------------------------------------------------------
 uint32_t vis_get_rate( void );
 
+//  ---------------------------------------------------------------------------
+//  Selects lock free (snapshot) or locked reading of the shared buffer.
+//  ---------------------------------------------------------------------------
+/*
+    In lock free mode (default), the lock is only held long enough to copy the
+    buffer index, size, rate and status. The samples are then read without
+    the lock and the frame is retried or dropped if the writer has lapped the
+    samples read. In locked mode the lock is held for the whole read.
+*/
+void vis_set_lockfree( bool lockfree );
+
+//  ---------------------------------------------------------------------------
+//  Returns shared buffer lock statistics.
+//  ---------------------------------------------------------------------------
+void vis_get_stats( struct vis_stats_t *stats );
+
+//  ---------------------------------------------------------------------------
+//  Resets shared buffer lock statistics.
+//  ---------------------------------------------------------------------------
+void vis_reset_stats( void );
+
+//  ---------------------------------------------------------------------------
+//  Selects the source to be metered.
+//  ---------------------------------------------------------------------------
+/*
+    The previous source is stopped. The default is the Squeezelite buffer.
+*/
+void meter_set_source( const struct meter_source_t *source );
+
+//  ---------------------------------------------------------------------------
+//  Meters the Squeezelite shared memory buffer.
+//  ---------------------------------------------------------------------------
+void meter_use_vis( void );
+
+//  ---------------------------------------------------------------------------
+//  Meters a stream published by the thx1138 capture daemon.
+//  ---------------------------------------------------------------------------
+/*
+    name is the shared memory object name, or NULL for STREAM_SHM_NAME. The
+    stream is attached by the same watcher as the Squeezelite buffer, so
+    vis_check() starts it, but samples are read in the published format.
+*/
+void meter_use_stream( const char *name );
+
+//  ---------------------------------------------------------------------------
+//  Meters an ALSA capture device.
+//  ---------------------------------------------------------------------------
+/*
+    rate, period and buffer (frames) are requests and the nearest values
+    supported by the device are used. The buffer should be longer than the
+    integration window plus a period. Returns false if the device couldn't
+    be opened, in which case the current source is kept.
+*/
+bool meter_use_alsa( const char *device, uint32_t rate,
+                     uint32_t period, uint32_t buffer );
+
+//  ---------------------------------------------------------------------------
+//  Returns the sample rate of the current source.
+//  ---------------------------------------------------------------------------
+uint32_t meter_get_rate( void );
+
+//  ---------------------------------------------------------------------------
+//  Returns true if the current source is running.
+//  ---------------------------------------------------------------------------
+/*
+    For pacing, e.g. to drop to a low frame rate while nothing is playing.
+*/
+bool meter_get_playing( void );
+
+//  ---------------------------------------------------------------------------
+//  Stops the current source.
+//  ---------------------------------------------------------------------------
+void meter_close( void );
+
+//  ---------------------------------------------------------------------------
+//  Builds the lookup tables for a meter from its scale.
+//  ---------------------------------------------------------------------------
+/*
+    Must be called again if the scale or number of levels is changed. If it
+    isn't called, the tables are built the first time they are needed.
+*/
+void init_peak_meter( struct peak_meter_t *peak_meter );
+
 //  ---------------------------------------------------------------------------
 //  Calculates peak dBfs values (L & R) of a number of stream samples.
 //  ---------------------------------------------------------------------------
+/*
+    The RMS level of the last peak_meter->samples frames is returned in dBfs
+    and the absolute sample and true peaks of the frames written since the
+    last call in dBpk and dBtp. overload is set if the true peak detector
+    finds an overload. If peak_meter->lufs is set, the new frames are also
+    K-weighted and the loudness levels updated. Only new frames are read on
+    each call so the cost depends on the frame interval rather than the
+    integration time. Levels are relative to reference for 16-bit sources
+    and scaled up to match for 24 and 32-bit sources, which are metered at
+    24-bit resolution.
+
+    If peak_meter->fixed_point is set, the levels are converted from the
+    integrated energy using a log2 lookup table rather than floating point.
+    Both methods agree to within rounding at whole dB boundaries.
+*/
 void get_dBfs( struct peak_meter_t *peak_meter );
 
+//  ---------------------------------------------------------------------------
+//  Restarts the integrated loudness measurement.
+//  ---------------------------------------------------------------------------
+/*
+    Should also be called before the first reading to set the levels to the
+    meter floor. init_peak_meter() does this for fixed point meters.
+*/
+void reset_loudness( struct peak_meter_t *peak_meter );
+
+//  ---------------------------------------------------------------------------
+//  Starts a new history in a min/max/RMS pyramid.
+//  ---------------------------------------------------------------------------
+/*
+    A pyramid that is zeroed, e.g. static, is already empty. Set
+    peak_meter->pyramid to feed it from get_dBfs(), which must be called
+    from the same thread as get_pyramid().
+*/
+void reset_pyramid( struct meter_pyramid_t *pyramid );
+
+//  ---------------------------------------------------------------------------
+//  Gets the newest columns of a pyramid level. Returns the number got.
+//  ---------------------------------------------------------------------------
+/*
+    Up to columns nodes of level are copied into column, oldest first, so
+    the last is the newest and may still be filling. Fewer are returned if
+    the history is shorter, or if columns is more than
+    METER_PYRAMID_COLUMNS.
+    The time taken only depends on the number of columns.
+*/
+uint16_t get_pyramid( const struct meter_pyramid_t *pyramid, uint8_t level,
+                      uint16_t columns, struct meter_column_t *column );
+
+//  ---------------------------------------------------------------------------
+//  Builds the FFT tables for a spectrum analyser.
+//  ---------------------------------------------------------------------------
+/*
+    Returns false if the size isn't a power of 2 between 16 and
+    SPECTRUM_SIZE_MAX or the band settings are invalid.
+*/
+bool init_spectrum( struct spectrum_meter_t *spectrum );
+
+//  ---------------------------------------------------------------------------
+//  Calculates the band levels of the spectrum.
+//  ---------------------------------------------------------------------------
+/*
+    Returns true if there were enough new frames for a new spectrum,
+    otherwise the previous levels are left. Levels are relative to a full
+    scale sine wave, which reads 0dB.
+*/
+bool get_spectrum( struct spectrum_meter_t *spectrum );
+
+//  ---------------------------------------------------------------------------
+//  Checks the vector FFT against the scalar FFT.
+//  ---------------------------------------------------------------------------
+/*
+    Runs both on inputs that need the most headroom and on full scale square
+    waves. Returns false if the results differ or the spectrum can't be
+    initialised. Always true without NEON.
+*/
+bool check_spectrum_fft( struct spectrum_meter_t *spectrum );
+
 //  ---------------------------------------------------------------------------
 //  Calculates the indices for string representations of the peak levels.
 //  ---------------------------------------------------------------------------
+/*
+    The peak hold dot is held for hold_time and then falls one level every
+    fall_time. Times are real milliseconds so the meter behaves the same at
+    any frame rate and no calibration is needed.
+
+    If peak_meter->fixed_point is set, the scale index is looked up from the
+    dBfs value instead of searching the scale.
+*/
 void get_dB_indices( struct peak_meter_t *peak_meter );
 
 #endif // #ifndef METERPI_H
@@ -23,8 +23,13 @@
 /*
     Compile with:
 
-        gcc -c -Wall meterPi.c testmeterPi-lcd.c -o testmeterPi-lcd
-               -lm -lpthread -lrt -lncurses
+        gcc -c -Wall meterPi.c framePi.c castPi.c testmeterPi-lcd.c
+               -o testmeterPi-lcd -lm -lpthread -lrt -lncurses
+
+    Add -DRTPI ../rtPi/rtPi.c and run with -r for the real time profile.
+
+    Run with -s to also send the levels to display only nodes, which are
+    run with -c instead of metering. -g sets the multicast group for both.
 
     For Raspberry Pi v1 optimisation use the following flags:
 
@@ -55,12 +60,17 @@
 #include <unistd.h>
 #include <string.h>
 #include <stdlib.h>
+#include <signal.h>
+#include <getopt.h>
 
 //  Local libraries -------------------------------------------------------
 
 #include "meterPi.h"
+#include "framePi.h"
+#include "castPi.h"
 #include "hd44780i2c.h"
 #include "mcp23017.h"
+#include "../rtPi/rtPi.h"
 
 //  Information. --------------------------------------------------------------
 /*
@@ -112,10 +122,23 @@
 //  Functions. ----------------------------------------------------------------
 
 #define METER_LEVELS 16 // 16x2 LCD.
-#define METER_DELAY 1
+#define METER_DELAY 40000 // Meter and display update interval (uS), 25fps.
+#define METER_IDLE 500000 // Update interval while nothing is playing (uS).
+#define METER_CAST_TICK 10000 // Display tick on display only nodes (uS).
 
 pthread_mutex_t displayBusy;
 
+// Cleared by main when a signal to stop is received.
+static bool running = true;
+
+// Levels are sent to, or received from, display only nodes.
+static bool cast_sender   = false;
+static bool cast_receiver = false;
+
+// Compositor owns the display and each meter channel is a region.
+struct hd44780Compositor compositor;
+uint8_t meter_region[METER_CHANNELS];
+
 // Meter labels.
 //char lcd_meter[METER_CHANNELS][METER_LEVELS + 1] = {{ 0x00 }, { 0x01 }};
 char lcd_meter[METER_CHANNELS][METER_LEVELS + 1] =
@@ -127,7 +150,7 @@ struct peak_meter_t peak_meter =
     .int_time       = 1,
     .samples        = 2,
     .hold_time      = 500,
-    .hold_count     = 3,
+    .fall_time      = 50,
     .num_levels     = 16,
     .floor          = -80,
     .reference      = 32768,
@@ -196,36 +219,76 @@ void get_peak_strings( struct peak_meter_t peak_meter,
 //  ---------------------------------------------------------------------------
 //  Updates Meter display.
 //  ---------------------------------------------------------------------------
+/*
+    Paced by a frame timer, so the interval doesn't include the time taken
+    to read the meter and frames are dropped rather than bunched up if the
+    thread is held off. The meter keeps running at the idle rate so that
+    the bars can fall away after playback stops.
+*/
 void *update_meter()
 {
-    while ( 1 )
+    struct frame_timer_t timer;
+
+    rtThread( RT_METER );
+    frame_init( &timer, METER_DELAY, METER_IDLE, meter_get_playing );
+
+    while ( __atomic_load_n( &running, __ATOMIC_ACQUIRE ))
     {
-        get_dBfs( &peak_meter );
+        // Display only nodes draw each frame as it arrives from the sender.
+        if ( cast_receiver )
+            cast_receive( &peak_meter, METER_IDLE );
+        else
+        {
+            frame_wait( &timer );
+            get_dBfs( &peak_meter );
+            if ( cast_sender ) cast_send( &peak_meter );
+        }
+
         get_dB_indices( &peak_meter );
         get_peak_strings( peak_meter, lcd_meter );
 
-        pthread_mutex_lock( &displayBusy );
-        hd44780Goto( mcp23017[0], hd44780[0], 0, 0 );
-        hd44780WriteString( mcp23017[0], hd44780[0], lcd_meter[0], 16 );
-        hd44780Goto( mcp23017[0], hd44780[0], 1, 0 );
-        hd44780WriteString( mcp23017[0], hd44780[0], lcd_meter[1], 16 );
-        pthread_mutex_unlock( &displayBusy );
+        hd44780Post( &compositor, meter_region[0], lcd_meter[0], 16 );
+        hd44780Post( &compositor, meter_region[1], lcd_meter[1], 16 );
+    }
+
+    printf( "Frames %llu, skipped %llu, latest wake up %u us.\n",
+            ( unsigned long long ) timer.frames,
+            ( unsigned long long ) timer.skipped, timer.late_max );
 
-        usleep( METER_DELAY );
+    if ( cast_sender || cast_receiver )
+    {
+        struct cast_stats_t stats;
+
+        cast_get_stats( &stats );
+        printf( "Packets %llu, lost %llu, late %llu, bad %llu, "
+                "longest latency %lld us.\n",
+                ( unsigned long long ) stats.packets,
+                ( unsigned long long ) stats.lost,
+                ( unsigned long long ) stats.late,
+                ( unsigned long long ) stats.bad,
+                ( long long ) stats.latency_max );
     }
+
+    return NULL;
 }
 
 
 //  ---------------------------------------------------------------------------
-//  Main (functional test).
+//  Runs the display compositor in the display role.
 //  ---------------------------------------------------------------------------
-int main( void )
+static void *update_display( void *compositor )
 {
-    struct timeval start, end;
-    uint32_t elapsed; // Elapsed time in milliseconds.
-    uint8_t i;
+    rtThread( RT_DISPLAY );
+    return displayCompositor( compositor );
+}
 
 
+//  ---------------------------------------------------------------------------
+//  Main (functional test).
+//  ---------------------------------------------------------------------------
+int main( int argc, char *argv[] )
+{
+
     struct display_mode_t
     {
         bool data;      // Data mode (4-bit or 8-bit).
@@ -255,7 +318,45 @@ int main( void )
 
     struct hd44780 *hd44780this;
 
+    const char *group = NULL;
+    bool realtime = false;
     int8_t err;
+    int    option;
+
+    while (( option = getopt( argc, argv, "rscg:" )) != -1 )
+    {
+        switch ( option )
+        {
+            case 'r': realtime = true; break;
+            case 's': cast_sender = true; break;
+            case 'c': cast_receiver = true; break;
+            case 'g': group = optarg; break;
+            default:
+                printf( "Usage: %s [-r] [-s | -c] [-g group]\n", argv[0] );
+                return -1;
+        }
+    }
+    if ( cast_sender && cast_receiver )
+    {
+        printf( "Use -s or -c, not both.\n" );
+        return -1;
+    }
+
+    // Real time profile, before any threads are started.
+    if (( realtime ) && ( rtInit( NULL ) < 0 ))
+        printf( "Real time profile not fully applied.\n" );
+    rtThread( RT_UI );
+
+    if (( cast_sender ) && ( !cast_open_sender( group, 0, 0, NULL )))
+    {
+        printf( "Couldn't open multicast sender.\n" );
+        return -1;
+    }
+    if (( cast_receiver ) && ( !cast_open_receiver( group, 0, NULL )))
+    {
+        printf( "Couldn't join multicast group.\n" );
+        return -1;
+    }
 
     // Initialise MCP23017.
     err = mcp23017Init( 0x20 );
@@ -273,8 +374,8 @@ int main( void )
     mcp23017WriteByte( mcp23017[0], OLATA, 0x00 ); // Clear pins.
     mcp23017WriteByte( mcp23017[0], OLATB, 0x00 ); // Clear pins.
 
-    // Set BANK bit for 8-bit mode.
-    mcp23017WriteByte( mcp23017[0], IOCONA, 0x80 );
+    // Byte mode so that HD44780 writes are sent as single I2C messages.
+    mcp23017WriteIOCON( mcp23017[0], IOCON_SEQOP );
 
     hd44780this = malloc( sizeof( struct hd44780 ));
 
@@ -292,6 +393,7 @@ int main( void )
     hd44780this->rs    = 0x80; // HD44780 RS pin.
     hd44780this->rw    = 0x40; // HD44780 R/W pin.
     hd44780this->en    = 0x20; // HD44780 E pin.
+    hd44780this->busyFlag = false; // R/W grounded.
 
     hd44780[0] = hd44780this;
 
@@ -324,10 +426,21 @@ int main( void )
 
     hd44780LoadCustom( mcp23017[0], hd44780[0], meter_chars );
 
-    vis_check();
+    if ( !cast_receiver ) vis_check();
 
     pthread_mutex_init( &displayBusy, NULL );
-    pthread_t threads[1];
+    pthread_t threads[2];
+
+    /*
+        Display only nodes flush on a short tick so that they show each frame
+        within a tick of its arrival. Ticks without new levels don't touch
+        the bus.
+    */
+    struct timeval tick = { .tv_sec = 0, .tv_usec = METER_DELAY };
+    if ( cast_receiver ) tick.tv_usec = METER_CAST_TICK;
+    hd44780CompositorInit( &compositor, mcp23017[0], hd44780[0], tick );
+    meter_region[0] = hd44780AddRegion( &compositor, 0, 0, 16 );
+    meter_region[1] = hd44780AddRegion( &compositor, 1, 0, 16 );
 
     // Calculate number of samples for integration time.
 	peak_meter.samples = vis_get_rate() * peak_meter.int_time / 1000;
@@ -335,37 +448,32 @@ int main( void )
     peak_meter.samples = 2; // Minimum samples for fastest response but may miss peaks.
     printf( "Samples for %dms = %d.\n", peak_meter.int_time, peak_meter.samples );
 
-    // Do some loops to test response time.
-    gettimeofday( &start, NULL );
-    for ( i = 0; i < TEST_LOOPS; i++ )
-    {
-        get_dBfs( &peak_meter );
-        get_dB_indices( &peak_meter );
-        get_peak_strings( peak_meter, lcd_meter );
-
-        // Write to LCD.
-        hd44780Goto( mcp23017[0], hd44780[0], 0, 0 );
-        hd44780WriteString( mcp23017[0], hd44780[0], lcd_meter[0], 16 );
-        hd44780Goto( mcp23017[0], hd44780[0], 1, 0 );
-        hd44780WriteString( mcp23017[0], hd44780[0], lcd_meter[1], 16 );
-        usleep( METER_DELAY );
-
-    }
-    gettimeofday( &end, NULL );
+    /*
+        The threads inherit the blocked signals, so only sigwait below sees
+        them and the main thread sleeps until asked to stop.
+    */
+    sigset_t signals;
+    int      sig;
 
-    elapsed = (( end.tv_sec  - start.tv_sec  ) * 1000 +
-               ( end.tv_usec - start.tv_usec ) / 1000 ) / 10;
+    sigemptyset( &signals );
+    sigaddset( &signals, SIGINT );
+    sigaddset( &signals, SIGTERM );
+    pthread_sigmask( SIG_BLOCK, &signals, NULL );
 
-    if ( elapsed < peak_meter.hold_time )
-        peak_meter.hold_count = peak_meter.hold_time / elapsed;
+    pthread_create( &threads[1], NULL, update_display,
+                    (void *) &compositor );
     pthread_create( &threads[0], NULL, update_meter, NULL );
 
-    while ( 1 )
-    {
-    };
+    sigwait( &signals, &sig );
+
+    __atomic_store_n( &running, false, __ATOMIC_RELEASE );
+    pthread_join( threads[0], NULL );
+    hd44780CompositorStop( &compositor );
+    pthread_join( threads[1], NULL );
 
+    meter_close();
+    cast_close();
     pthread_mutex_destroy( &displayBusy );
-    pthread_exit( NULL );
 
     return 0;
 }
@@ -23,8 +23,24 @@
 /*
     Compile with:
 
-        gcc -c -Wall meterPi.c testmeterPi-ncurses.c -o testmeterPi-ncurses
-               -lm -lpthread -lrt -lncurses
+        gcc -c -Wall -I../streamPi meterPi.c framePi.c ../streamPi/capturePi.c
+               testmeterPi-ncurses.c -o testmeterPi-ncurses
+               -lm -lpthread -lrt -lasound -lncurses
+
+    Add -DSTATSPI ../statsPi/statsPi.c to show the meterPi counters under
+    the meter. They are also published as /statsPi for other tools.
+
+    Add -DRTPI ../rtPi/rtPi.c and give -r as the first argument for the
+    real time profile.
+
+    Run with an ALSA capture device as an argument to meter it instead of
+    the Squeezelite buffer, e.g.
+
+        testmeterPi-ncurses hw:Loopback,1,0
+
+    or with the name of a stream published by thx1138, e.g.
+
+        testmeterPi-ncurses /streamPi
 
     For Raspberry Pi v1 optimisation use the following flags:
 
@@ -54,18 +70,24 @@
 #include <pthread.h>
 #include <unistd.h>
 #include <string.h>
+#include <time.h>
 
 #include <ncurses.h>
 
 //  Local libraries -------------------------------------------------------
 
 #include "meterPi.h"
+#include "framePi.h"
+#include "../statsPi/statsPi.h"
+#include "../rtPi/rtPi.h"
 
 
 //  Functions. ----------------------------------------------------------------
 
 #define METER_LEVELS 41
-#define METER_DELAY  5000  // Need a proper timer to match sample rate.
+#define METER_DELAY  5000  // Frame interval (us).
+#define METER_IDLE  100000  // Frame interval while nothing is playing (us).
+#define METER_BOUND 150     // IEC 60268-10 delay limit (ms).
 /*
     44100 Hz = 22.7 us.
     48000 Hz = 20.8 us.
@@ -74,7 +96,6 @@
     44100 Hz = 45.4 us.
     48000 Hz = 41.7 us.
 */
-#define CALIBRATION_LOOPS 300
 
 //  ---------------------------------------------------------------------------
 //  Produces string representations of the peak meters.
@@ -121,42 +142,82 @@ static void reverse_string( char *buffer, size_t start, size_t end )
 };
 
 
+#ifdef STATSPI
 //  ---------------------------------------------------------------------------
-//  Retruns elapsed time in microseconds.
+//  Prints the last second of statsPi counters.
 //  ---------------------------------------------------------------------------
-uint32_t time_elapsed( struct timeval start, struct timeval end )
+static void print_stats( WINDOW *stats_win, const struct statsTotals *now,
+                         const struct statsTotals *then, uint16_t int_time )
 {
-    uint32_t start_us, end_us, diff_us = 0;
-
-    start_us = (uint32_t) start.tv_sec * 1000000 + (uint32_t) start.tv_usec;
-    end_us   = (uint32_t) end.tv_sec   * 1000000 + (uint32_t) end.tv_usec;
-
-    diff_us = end_us - start_us;
-
-    return diff_us;
+    struct statsTotals diff;
+    const struct statsHist *hist;
+    uint64_t frames, bound;
+
+    statsDiff( now, then, &diff );
+    frames = diff.counters[STATS_METER_FRAMES];
+    hist   = &diff.hists[STATS_METER_TIME];
+
+    mvwprintw( stats_win, 1, 2, "Threads %2u  frames/s %6llu",
+               diff.threads, ( unsigned long long ) frames );
+    mvwprintw( stats_win, 2, 2, "Meter uS avg %6llu  p99 %6llu  max %6llu",
+               ( unsigned long long )( hist->count ?
+                                       hist->total / hist->count / 1000 : 0 ),
+               ( unsigned long long ) statsPercentile( hist, 99 ) / 1000,
+               ( unsigned long long ) hist->max / 1000 );
+
+    hist = &diff.hists[STATS_LOCK_WAIT];
+    mvwprintw( stats_win, 3, 2, "Lock uS avg %6llu  p99 %6llu  max %6llu",
+               ( unsigned long long )( hist->count ?
+                                       hist->total / hist->count / 1000 : 0 ),
+               ( unsigned long long ) statsPercentile( hist, 99 ) / 1000,
+               ( unsigned long long ) hist->max / 1000 );
+
+    if ( frames == 0 ) frames = 1;
+    mvwprintw( stats_win, 4, 2, "I2C/frame %6llu xfers %8llu bytes",
+               ( unsigned long long ) diff.counters[STATS_I2C_TRANSFERS] / frames,
+               ( unsigned long long ) diff.counters[STATS_I2C_BYTES] / frames );
+    mvwprintw( stats_win, 5, 2, "SPI/frame %6llu xfers %8llu bytes",
+               ( unsigned long long ) diff.counters[STATS_SPI_TRANSFERS] / frames,
+               ( unsigned long long ) diff.counters[STATS_SPI_BYTES] / frames );
+    mvwprintw( stats_win, 6, 2, "Encoder/s %6llu edges %8llu detents",
+               ( unsigned long long ) diff.counters[STATS_ENCODER_EDGES],
+               ( unsigned long long ) diff.counters[STATS_ENCODER_DETENTS] );
+
+    hist = &diff.hists[STATS_FRAME_JITTER];
+    mvwprintw( stats_win, 7, 2, "Wake uS avg %6llu  p99 %6llu  max %6llu",
+               ( unsigned long long )( hist->count ?
+                                       hist->total / hist->count / 1000 : 0 ),
+               ( unsigned long long ) statsPercentile( hist, 99 ) / 1000,
+               ( unsigned long long ) hist->max / 1000 );
+
+    /*
+        A level is shown at the latest one integration time and one frame
+        after it arrives, plus the worst wake up and meter times.
+    */
+    bound = ( uint64_t ) int_time * 1000000 + ( uint64_t ) METER_DELAY * 1000 +
+            hist->max + diff.hists[STATS_METER_TIME].max;
+    mvwprintw( stats_win, 8, 2, "Delay mS %6.1f of %3d  skips %8llu",
+               bound / 1e6, METER_BOUND,
+               ( unsigned long long ) diff.counters[STATS_FRAME_SKIPS] );
+    box( stats_win, 0, 0 );
+    wrefresh( stats_win );
 }
+#endif
+
 
 //  ---------------------------------------------------------------------------
 //  Main (functional test).
 //  ---------------------------------------------------------------------------
-int main( void )
+int main( int argc, char *argv[] )
 {
-    struct timeval start, end;
-    uint32_t diff;
-    uint32_t elapsed; // Elapsed time in milliseconds.
-    uint16_t i;
-
     struct peak_meter_t peak_meter =
     {
         .int_time   = 5,
         .samples    = 2,
         .hold_time  = 1000,
-        .hold_incs  = 50,
         .fall_time  = 50,
-        .fall_incs  = 5,
         .over_peaks = 10,
         .over_time  = 3000,
-        .over_incs  = 150,
         .num_levels = 41,
         .floor      = -96,
         .reference  = 32768,
@@ -175,12 +236,39 @@ int main( void )
     // String representations for LCD display.
     char window_peak_meter[METER_CHANNELS][METER_LEVELS + 1];
 
-    vis_check();
+    // Real time profile, before any threads are started.
+    if (( argc > 1 ) && ( strcmp( argv[1], "-r" ) == 0 ))
+    {
+        if ( rtInit( NULL ) < 0 )
+            printf( "Real time profile not fully applied.\n" );
+        argc--;
+        argv++;
+    }
+    rtThread( RT_METER );
+
+    // Publish counters from the meter threads, if built with STATSPI.
+    statsOpen( NULL );
+
+    // Meter a thx1138 stream or an ALSA capture device if one is given.
+    if (( argc > 1 ) && ( argv[1][0] == '/' ))
+    {
+        meter_use_stream( argv[1] );
+        vis_check();
+    }
+    else if ( argc > 1 )
+    {
+        if ( !meter_use_alsa( argv[1], 44100, 256, 16384 ))
+        {
+            printf( "Unable to open capture device %s.\n", argv[1] );
+            return -1;
+        }
+    }
+    else vis_check();
 
     // Calculate number of samples for integration time.
-	peak_meter.samples = vis_get_rate() * peak_meter.int_time / 1000;
+	peak_meter.samples = meter_get_rate() * peak_meter.int_time / 1000;
     if ( peak_meter.samples < 1 ) peak_meter.samples = 1;
-    if ( peak_meter.samples > VIS_BUF_SIZE / METER_CHANNELS )
+    if (( argc <= 1 ) && ( peak_meter.samples > VIS_BUF_SIZE / METER_CHANNELS ))
          peak_meter.samples = VIS_BUF_SIZE / METER_CHANNELS;
 //    peak_meter.samples = 2; // Minimum samples for fastest response but may miss peaks.
     printf( "Samples for %dms = %d.\n", peak_meter.int_time, peak_meter.samples );
@@ -210,83 +298,38 @@ int main( void )
     init_pair( 2, COLOR_YELLOW, COLOR_BLACK );
     init_pair( 3, COLOR_RED, COLOR_BLACK );
 
-    // Calibration.
-    gettimeofday( &start, NULL );
-
-    for ( i = 0; i < CALIBRATION_LOOPS; i++ )
-    {
-        // Get integrated peak dBFS values and indices for meter.
-        get_dBfs( &peak_meter );
-        get_dB_indices( &peak_meter );
-        get_peak_strings( peak_meter, window_peak_meter );
-
-        mvwprintw( meter_win, 3, 2, " Calibrating. Loop %d ", i + 1 );
-
-        // Draw meters.
-        mvwprintw( meter_win, 1, 3, "%s", window_peak_meter[0] );
-        mvwprintw( meter_win, 5, 3, "%s", window_peak_meter[1] );
-
-        // Overload indicators.
-        if ( peak_meter.overload[0] == true )
-            mvwprintw( meter_win, 1, 45, "OVER" );
-        else
-            mvwprintw( meter_win, 1, 45, "    " );
-        if ( peak_meter.overload[1] == true )
-            mvwprintw( meter_win, 5, 45, "OVER" );
-        else
-            mvwprintw( meter_win, 5, 45, "    " );
-
-        // Meter colours.
-        mvwchgat( meter_win, 1,  3, 31, A_NORMAL, 1, NULL );
-        mvwchgat( meter_win, 1, 34,  5, A_NORMAL, 2, NULL );
-        mvwchgat( meter_win, 1, 39, 10, A_NORMAL, 3, NULL );
-        mvwchgat( meter_win, 5,  3, 31, A_NORMAL, 1, NULL );
-        mvwchgat( meter_win, 5, 34,  5, A_NORMAL, 2, NULL );
-        mvwchgat( meter_win, 5, 39, 10, A_NORMAL, 3, NULL );
-
-        // Refresh ncurses window to display meters.
-        wrefresh( meter_win );
-
-        usleep( METER_DELAY );
-    }
-
-    gettimeofday( &end, NULL );
-    mvwprintw( meter_win, 3, 2, " Finished calibrating." );
-    wrefresh( meter_win );
-
-    sleep( 2 );
-
-    mvwprintw( meter_win, 3, 2, " Calculating counters." );
-    wrefresh( meter_win );
-
-    diff = time_elapsed( start, end ) / CALIBRATION_LOOPS;
-    elapsed = diff / 1000;
-//    elapsed = (( end.tv_sec  - start.tv_sec  ) * 1000 +
-//               ( end.tv_usec - start.tv_usec ) / 1000 ) / CALIBRATION_LOOPS;
-
-    sleep( 2 );
-
-    mvwprintw( meter_win, 3, 2, " Loop time = %ld us.       ",
-               diff - ( (uint32_t) peak_meter.int_time * 1000 ));
-    wrefresh( meter_win );
-
-    sleep( 2 );
-
-    // Calculate counters.
-    if ( elapsed < peak_meter.hold_time )
-        peak_meter.hold_incs = peak_meter.hold_time / elapsed;
+    mvwprintw( meter_win, 3, 2, "-40  -35  -30  -25  -20  -15  -10  -5    0 dBFS" );
 
-    if ( elapsed < peak_meter.fall_time )
-        peak_meter.fall_incs = peak_meter.fall_time / elapsed;
+#ifdef STATSPI
+    WINDOW *stats_win;
+    struct statsTotals stats_now, stats_then;
+    time_t stats_time = time( NULL );
 
-    if ( elapsed < peak_meter.over_time )
-        peak_meter.over_incs = peak_meter.over_time / elapsed;
+    stats_win = newwin( 10, 52, 18, 10 );
+    box( stats_win, 0, 0 );
+    wrefresh( stats_win );
+    statsSum( statsLocal(), &stats_then );
+#endif
 
-    mvwprintw( meter_win, 3, 2, "-40  -35  -30  -25  -20  -15  -10  -5    0 dBFS" );
+    struct frame_timer_t timer;
+    frame_init( &timer, METER_DELAY, METER_IDLE, meter_get_playing );
 
     int ch = ERR;
     while ( ch == ERR )
     {
+        frame_wait( &timer );
+
+#ifdef STATSPI
+        // Counters for the last second.
+        if ( time( NULL ) != stats_time )
+        {
+            stats_time = time( NULL );
+            statsSum( statsLocal(), &stats_now );
+            print_stats( stats_win, &stats_now, &stats_then,
+                         peak_meter.int_time );
+            stats_then = stats_now;
+        }
+#endif
 
         get_dBfs( &peak_meter );
         get_dB_indices( &peak_meter );
@@ -315,12 +358,17 @@ int main( void )
         // Refresh ncurses window to display.
         wrefresh( meter_win );
         ch = wgetch( meter_win );
-        usleep( METER_DELAY );
     }
 
     // Close ncurses.
+#ifdef STATSPI
+    delwin( stats_win );
+#endif
     delwin( meter_win );
     endwin();
 
+    meter_close();
+    statsClose();
+
     return 0;
 }
@@ -25,12 +25,12 @@
 
 //  Compilation:
 //
-//  Compile with gcc -c -fpic alsaPi.c -lasound -lm
+//  Compile with gcc -c -fpic alsaPi.c -lasound -lm -lpthread
 //  Also use the following flags for Raspberry Pi optimisation:
 //         -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
 //         -ffast-math -pipe -O3
 
-#define alsaPiVersion "Version 0.1"
+#define alsaPiVersion "Version 0.9"
 
 //  Authors:        D.Faulke    10/12/2015
 //
@@ -39,6 +39,14 @@
 //  Changelog:
 //
 //  v0.1 Original version.
+//  v0.2 Volumes looked up from a table built when parameters change.
+//  v0.3 Added applier thread to coalesce volume writes.
+//  v0.4 Added dB mapping mode.
+//  v0.5 Follow volume changes by other clients through mixer events.
+//  v0.6 Added pluggable volume backends for hardware other than ALSA.
+//  v0.7 Backends can be read back and have events.
+//  v0.8 Applier thread takes the rtPi control role.
+//  v0.9 Echoes of our own volume writes no longer move the index.
 //
 
 //  To Do:
@@ -53,23 +61,141 @@
 #include <alsa/asoundlib.h>
 #include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
 
 //  Local libraries -----------------------------------------------------------
 
 #include "alsaPi.h"
+#include "../rtPi/rtPi.h"
 
 
 //  Local variables. ----------------------------------------------------------
 
 static bool header = false; // Flag to print header on 1st set volume.
 
+// Hardware volume for each index, and the parameters it was built for.
+static struct
+{
+    long  volume[VOL_TABLE_SIZE];
+    float factor;
+    int   incs;
+    int   min;
+    int   range;
+    bool  dB;
+    bool  valid;
+} volTable = { .valid = false };
+
+// Volume applier. dB volumes can be -ve so none is LONG_MIN.
+#define VOL_NONE LONG_MIN
+static pthread_t applierThread;
+static int       applierFd = -1;   // Signalled when a volume is posted.
+static bool      applierStop;      // Set to stop the applier.
+static uint16_t  applierInterval;  // Minimum time between writes (mS).
+static long      applierTarget;    // Last volume posted.
+static long      applierVolume;    // Last volume written, VOL_NONE if none.
+
+// Volume backend, or NULL for the ALSA mixer.
+static struct volBackendStruct *volBackend = NULL;
+
+// Held for each mixer call, which may come from the applier or events.
+static pthread_mutex_t mixerLock = PTHREAD_MUTEX_INITIALIZER;
+
 
 //  Functions. ----------------------------------------------------------------
 
 // ----------------------------------------------------------------------------
-//  Initialises hardware and returns info in sound struct.
+//  Reads raw hardware volume. Returns 1 if the backend can't be read back.
 // ----------------------------------------------------------------------------
-int soundOpen( void )
+static int readHw( long *volume )
+{
+    if ( volBackend != NULL )
+    {
+        if ( volBackend->read == NULL ) return 1;
+        return volBackend->read( volume );
+    }
+
+    return snd_mixer_selem_get_playback_volume( mixerElem,
+            SND_MIXER_SCHN_FRONT_LEFT, volume );
+};
+
+// ----------------------------------------------------------------------------
+//  Returns raw hardware volume that writing a table volume produces.
+// ----------------------------------------------------------------------------
+static int hwVol( long volume, long *hw )
+{
+    // Same rounding as snd_mixer_selem_set_playback_dB_all in writeVol.
+    if (( volBackend == NULL ) && sound.dB )
+        return snd_mixer_selem_ask_playback_dB_vol( mixerElem, volume, 0, hw );
+
+    *hw = volume;
+
+    return 0;
+};
+
+// ----------------------------------------------------------------------------
+//  Updates index when the volume has been changed by another client.
+// ----------------------------------------------------------------------------
+/*
+    Called with mixerLock held. Changes are ignored while a posted volume
+    is waiting to be written, since the event will be for an older write
+    of ours.
+
+    Our own writes also come back as events. The card rounds dB volumes to
+    its own steps and several indices can share one raw value, so mapping
+    the readback to an index would pull the index away from where it was
+    set. The index is only moved if the hardware holds a different value to
+    the one a write of the current index produces.
+*/
+static void volChanged( void )
+{
+    long hw, mine;
+
+    if (( applierFd >= 0 ) &&
+        ( __atomic_load_n( &applierTarget, __ATOMIC_ACQUIRE ) !=
+          applierVolume )) return;
+
+    if ( readHw( &hw ) != 0 ) return;
+    if (( hwVol( indexVol( sound.index ), &mine ) >= 0 ) && ( hw == mine ))
+        return;
+
+    getVol();
+};
+
+// ----------------------------------------------------------------------------
+//  Updates index when the mixer element changes.
+// ----------------------------------------------------------------------------
+/*
+    Called by snd_mixer_handle_events. The volume is read from alsa-lib's
+    copy, which the event has just updated, so there is no round trip to
+    the card.
+*/
+static int mixerChanged( snd_mixer_elem_t *elem, unsigned int mask )
+{
+    if (( mask == SND_CTL_EVENT_MASK_REMOVE ) ||
+        !( mask & SND_CTL_EVENT_MASK_VALUE )) return 0;
+
+    volChanged();
+
+    return 0;
+};
+
+// ----------------------------------------------------------------------------
+//  Sets the volume backend. NULL for the ALSA mixer.
+// ----------------------------------------------------------------------------
+void soundSetBackend( struct volBackendStruct *backend )
+{
+    volBackend = backend;
+};
+
+// ----------------------------------------------------------------------------
+//  Opens ALSA mixer and returns hardware volume or dB limits.
+// ----------------------------------------------------------------------------
+static int mixerOpen( long *minHard, long *maxHard )
 {
     int err;
 
@@ -110,20 +236,46 @@ int soundOpen( void )
     }
     snd_mixer_selem_get_id( mixerElem, mixerId );
 
-    // Get hardware volume limits.
-    long minHard, maxHard;
-    err = snd_mixer_selem_get_playback_volume_range( mixerElem,
-                                                     &minHard, &maxHard );
+    // Called from soundHandleEvents when another client changes the mixer.
+    snd_mixer_elem_set_callback( mixerElem, mixerChanged );
+
+    // Get hardware volume or dB limits, read once here.
+    if ( sound.dB )
+        err = snd_mixer_selem_get_playback_dB_range( mixerElem,
+                                                     minHard, maxHard );
+    else
+        err = snd_mixer_selem_get_playback_volume_range( mixerElem,
+                                                         minHard, maxHard );
     if ( err < 0 )
     {
         printf( "%s.\n", snd_strerror( err ));
         return err;
     }
 
+    return 0;
+};
+
+// ----------------------------------------------------------------------------
+//  Initialises hardware and returns info in sound struct.
+// ----------------------------------------------------------------------------
+int soundOpen( void )
+{
+    long minHard, maxHard;
+    int err;
+
+    // Backends only have raw volumes.
+    if ( volBackend != NULL )
+    {
+        sound.dB = false;
+        err = volBackend->open( &minHard, &maxHard );
+    }
+    else err = mixerOpen( &minHard, &maxHard );
+    if ( err < 0 ) return err;
+
     // Calculate soft limits.
     long minSoft, maxSoft;
-    minSoft = sound.min / 100 * ( maxHard - minHard ) + minHard;
-    maxSoft = sound.max / 100 * ( maxHard - minHard ) + minHard;
+    minSoft = sound.min * ( maxHard - minHard ) / 100 + minHard;
+    maxSoft = sound.max * ( maxHard - minHard ) / 100 + minHard;
 
     // Set soft limits.
     sound.min = minSoft;
@@ -133,6 +285,9 @@ int soundOpen( void )
     // Set starting index and volume.
     sound.index = lroundf( (float)sound.volume / 100 * sound.incs );
 
+    // Build volume table for these limits.
+    buildVolTable();
+
     return 0;
 }
 
@@ -150,6 +305,109 @@ long calcVol( float index, float incs, float range, float min, float factor )
     return volume;
 };
 
+// ----------------------------------------------------------------------------
+//  Builds table of volumes for each index if parameters have changed.
+// ----------------------------------------------------------------------------
+void buildVolTable( void )
+{
+    int i;
+
+    // Steps are equal in dB, so the dB scale needs no shaping.
+    float factor = sound.dB ? 1 : sound.factor;
+
+    // Only rebuild if mode, factor, increments or soft limits have changed.
+    if (( volTable.valid ) && ( volTable.dB == sound.dB ) &&
+        ( volTable.factor == factor ) && ( volTable.incs == sound.incs ) &&
+        ( volTable.min == sound.min ) && ( volTable.range == sound.range ))
+        return;
+
+    for ( i = 0; i <= sound.incs; i++ )
+        volTable.volume[i] = calcVol( i, sound.incs, sound.range,
+                                      sound.min, factor );
+
+    volTable.factor = factor;
+    volTable.incs   = sound.incs;
+    volTable.min    = sound.min;
+    volTable.range  = sound.range;
+    volTable.dB     = sound.dB;
+    volTable.valid  = true;
+};
+
+// ----------------------------------------------------------------------------
+//  Returns volume for index.
+// ----------------------------------------------------------------------------
+long indexVol( unsigned char index )
+{
+    buildVolTable();
+    if ( index > sound.incs ) index = sound.incs;
+
+    return volTable.volume[index];
+};
+
+// ----------------------------------------------------------------------------
+//  Returns index with volume nearest to a hardware volume.
+// ----------------------------------------------------------------------------
+unsigned char volIndex( long volume )
+{
+    int low = 0, high, mid;
+
+    buildVolTable();
+    high = sound.incs;
+
+    // Table is in ascending order so find first volume >= volume.
+    while ( low < high )
+    {
+        mid = ( low + high ) / 2;
+        if ( volTable.volume[mid] < volume ) low = mid + 1;
+        else high = mid;
+    }
+
+    // Step back if the volume below is nearer.
+    if (( low > 0 ) &&
+        ( volume - volTable.volume[low - 1] <= volTable.volume[low] - volume ))
+        low--;
+
+    return low;
+};
+
+// ----------------------------------------------------------------------------
+//  Writes volume or dB to all channels of the mixer.
+// ----------------------------------------------------------------------------
+static int writeVol( long volume )
+{
+    if ( volBackend != NULL ) return volBackend->write( volume );
+
+    if ( sound.dB )
+        return snd_mixer_selem_set_playback_dB_all( mixerElem, volume, 0 );
+
+    return snd_mixer_selem_set_playback_volume_all( mixerElem, volume );
+};
+
+// ----------------------------------------------------------------------------
+//  Reads volume back from ALSA mixer and sets index to match.
+// ----------------------------------------------------------------------------
+int getVol( void )
+{
+    long volume;
+    int err;
+
+    // Backends that can't be read back leave the index as it is.
+    err = readHw( &volume );
+    if ( err != 0 ) return ( err < 0 ) ? err : 0;
+
+    // Table is in dB so convert.
+    if (( volBackend == NULL ) && sound.dB )
+    {
+        err = snd_mixer_selem_ask_playback_vol_dB( mixerElem, volume, &volume );
+        if ( err < 0 ) return err;
+    }
+
+    sound.index  = volIndex( volume );
+    sound.volume = volume;
+
+    return 0;
+};
+
 // ----------------------------------------------------------------------------
 //  Set volume using ALSA mixers.
 // ----------------------------------------------------------------------------
@@ -158,16 +416,13 @@ int setVol( void )
     long linearVol; // Linear volume. Used for debugging.
     int err;
 
-    // Calculate volume value from index.
-    sound.volume = calcVol( sound.index, sound.incs, sound.range,
-                            sound.min, sound.factor );
+    // Look up volume value for index.
+    sound.volume = indexVol( sound.index );
 
-    // If control is mono then FRONT_LEFT will set volume.
-    err=snd_mixer_selem_set_playback_volume( mixerElem,
-            SND_MIXER_SCHN_FRONT_LEFT, sound.volume );
-    if ( err < 0 ) return err;
-    err=snd_mixer_selem_set_playback_volume( mixerElem,
-            SND_MIXER_SCHN_FRONT_RIGHT, sound.volume );
+    // Sets all channels, mono or stereo, with one write.
+    pthread_mutex_lock( &mixerLock );
+    err = writeVol( sound.volume );
+    pthread_mutex_unlock( &mixerLock );
     if ( err < 0 ) return err;
 
     if ( sound.print ) // Print output if requested. For debugging.
@@ -198,6 +453,104 @@ int setVol( void )
     return 0;
 };
 
+// ----------------------------------------------------------------------------
+//  Writes posted volumes, no more than once per interval.
+// ----------------------------------------------------------------------------
+static void *applyVol( void *arg )
+{
+    struct timespec wait;
+    uint64_t count;
+    long volume;
+
+    (void) arg;
+
+    rtThread( RT_CONTROL );
+
+    wait.tv_sec  = applierInterval / 1000;
+    wait.tv_nsec = ( applierInterval % 1000 ) * 1000000L;
+
+    // Sleeps until there is a volume posted.
+    while ( read( applierFd, &count, sizeof( count )) == sizeof( count ))
+    {
+        // Only the latest volume matters, however many were posted.
+        pthread_mutex_lock( &mixerLock );
+        volume = __atomic_load_n( &applierTarget, __ATOMIC_ACQUIRE );
+        if (( volume != VOL_NONE ) && ( volume != applierVolume ) &&
+            ( writeVol( volume ) >= 0 ))
+            applierVolume = volume;
+        pthread_mutex_unlock( &mixerLock );
+
+        if ( __atomic_load_n( &applierStop, __ATOMIC_ACQUIRE )) break;
+
+        // Posts during the wait are merged into the next write.
+        nanosleep( &wait, NULL );
+    }
+
+    return NULL;
+};
+
+// ----------------------------------------------------------------------------
+//  Starts the volume applier.
+// ----------------------------------------------------------------------------
+int volApplierStart( uint16_t interval )
+{
+    if ( applierFd >= 0 ) return 0;
+
+    applierFd = eventfd( 0, EFD_CLOEXEC );
+    if ( applierFd < 0 ) return -1;
+
+    applierInterval = interval;
+    applierVolume   = VOL_NONE;
+    applierTarget   = VOL_NONE;
+    applierStop     = false;
+
+    if ( pthread_create( &applierThread, NULL, applyVol, NULL ) != 0 )
+    {
+        close( applierFd );
+        applierFd = -1;
+        return -1;
+    }
+
+    return 0;
+};
+
+// ----------------------------------------------------------------------------
+//  Stops the volume applier after any pending write.
+// ----------------------------------------------------------------------------
+void volApplierStop( void )
+{
+    uint64_t one = 1;
+
+    if ( applierFd < 0 ) return;
+
+    __atomic_store_n( &applierStop, true, __ATOMIC_RELEASE );
+    if ( write( applierFd, &one, sizeof( one )) == sizeof( one ))
+        pthread_join( applierThread, NULL );
+    close( applierFd );
+    applierFd = -1;
+};
+
+// ----------------------------------------------------------------------------
+//  Posts volume for the current index to the applier.
+// ----------------------------------------------------------------------------
+void postVol( void )
+{
+    uint64_t one = 1;
+
+    // Write directly if there is no applier.
+    if ( applierFd < 0 )
+    {
+        setVol();
+        return;
+    }
+
+    sound.volume = indexVol( sound.index );
+    __atomic_store_n( &applierTarget, sound.volume, __ATOMIC_RELEASE );
+
+    // Never blocks, the eventfd just counts up.
+    if ( write( applierFd, &one, sizeof( one )) != sizeof( one )) return;
+};
+
 // ----------------------------------------------------------------------------
 //  Increases volume.
 // ----------------------------------------------------------------------------
@@ -209,7 +562,7 @@ void incVol( void )
     else sound.index++;
 
     // Set volume.
-    setVol();
+    postVol();
 
     return;
 };
@@ -225,16 +578,74 @@ void decVol( void )
     else sound.index--;
 
     // Set volume.
-    setVol();
+    postVol();
 
     return;
 };
 
 // ----------------------------------------------------------------------------
-//  Detaches and closes ALSA.
+//  Returns number of mixer poll descriptors.
+// ----------------------------------------------------------------------------
+int soundPollCount( void )
+{
+    if ( volBackend != NULL )
+        return ( volBackend->pollCount != NULL ) ?
+               volBackend->pollCount() : 0;
+
+    return snd_mixer_poll_descriptors_count( mixerHandle );
+};
+
+// ----------------------------------------------------------------------------
+//  Fills in mixer poll descriptors. Returns number filled in.
+// ----------------------------------------------------------------------------
+int soundPollDescriptors( struct pollfd *fds, unsigned int space )
+{
+    if ( volBackend != NULL )
+        return ( volBackend->pollDescriptors != NULL ) ?
+               volBackend->pollDescriptors( fds, space ) : 0;
+
+    return snd_mixer_poll_descriptors( mixerHandle, fds, space );
+};
+
+// ----------------------------------------------------------------------------
+//  Handles mixer events, updating index if volume has changed.
+// ----------------------------------------------------------------------------
+int soundHandleEvents( void )
+{
+    int err;
+
+    if ( volBackend != NULL )
+    {
+        if ( volBackend->handleEvents == NULL ) return 0;
+
+        pthread_mutex_lock( &mixerLock );
+        err = volBackend->handleEvents();
+        if ( err > 0 ) volChanged();
+        pthread_mutex_unlock( &mixerLock );
+
+        return err;
+    }
+
+    pthread_mutex_lock( &mixerLock );
+    err = snd_mixer_handle_events( mixerHandle );
+    pthread_mutex_unlock( &mixerLock );
+
+    return err;
+};
+
+// ----------------------------------------------------------------------------
+//  Detaches and closes ALSA, or closes the backend.
 // ----------------------------------------------------------------------------
 void soundClose( void )
 {
+    volApplierStop();
+
+    if ( volBackend != NULL )
+    {
+        volBackend->close();
+        return;
+    }
+
     snd_mixer_detach( mixerHandle, sound.card );
     snd_mixer_close( mixerHandle );
 
@@ -30,6 +30,14 @@
 //  Changelog:
 //
 //  v0.1 Original version.
+//  v0.2 Volumes looked up from a table built when parameters change.
+//  v0.3 Added applier thread to coalesce volume writes.
+//  v0.4 Added dB mapping mode.
+//  v0.5 Follow volume changes by other clients through mixer events.
+//  v0.6 Added pluggable volume backends for hardware other than ALSA.
+//  v0.7 Backends can be read back and have events.
+//  v0.8 Applier thread takes the rtPi control role.
+//  v0.9 Echoes of our own volume writes no longer move the index.
 //
 
 //  To Do:
@@ -52,6 +60,12 @@
 //#include <stdlib.h>
 
 
+//  Macros. -------------------------------------------------------------------
+
+#define VOL_TABLE_SIZE     256 // Volumes for indices 0 to max incs.
+#define VOL_APPLY_INTERVAL  20 // Default time between applier writes (mS).
+
+
 //  Data structures. ----------------------------------------------------------
 
 struct soundStruct
@@ -65,11 +79,26 @@ struct soundStruct
     int max;             // Maximum volume (hardware dependent).
     int range;           // Volume range (hardware dependent).
     int volume;          // Volume level.
+    bool dB;             // Map indices to dB (1/100 dB) rather than volume.
     char balance;         // Relative balance -100(%) to +100(%).
     bool mute;           // Mute switch.
     bool print;          // Print output switch.
 } sound;
 
+// Volume backend, for volume controls other than the ALSA mixer.
+struct volBackendStruct
+{
+    int  ( *open )( long *min, long *max ); // Returns hardware limits.
+    int  ( *write )( long volume );         // Writes hardware volume.
+    void ( *close )( void );                // Releases hardware.
+
+    // Optional, NULL if the backend can't be read or has no events.
+    int  ( *read )( long *volume );         // Reads hardware volume.
+    int  ( *pollCount )( void );            // Number of poll descriptors.
+    int  ( *pollDescriptors )( struct pollfd *fds, unsigned int space );
+    int  ( *handleEvents )( void );         // Returns 1 if volume changed.
+};
+
 
 //  ALSA control types. -------------------------------------------------------
 
@@ -90,9 +119,28 @@ snd_mixer_elem_t *mixerElem;      // Mixer element handle.
 
 //  Functions. ----------------------------------------------------------------
 
+// ----------------------------------------------------------------------------
+//  Sets the volume backend. NULL for the ALSA mixer.
+// ----------------------------------------------------------------------------
+/*
+    Call before soundOpen. With a backend, indices are mapped onto the
+    limits returned by its open function and each volume is passed to its
+    write function, from setVol or the applier, so incVol, decVol and the
+    applier work unchanged. The ALSA mixer isn't opened and dB mode isn't
+    used. getVol and the poll and event functions use the backend's
+    optional functions, or do nothing if they are NULL.
+*/
+void soundSetBackend( struct volBackendStruct *backend );
+
 // ----------------------------------------------------------------------------
 //  Initialises hardware and returns info in sound struct.
 // ----------------------------------------------------------------------------
+/*
+    min and max are given as % and returned as soft limits in hardware
+    volume units, or in 1/100 dB if dB is set. In dB mode each index is an
+    equal step in dB between the soft limits, factor isn't used, and
+    volume is set in dB so that the card picks its nearest raw value.
+*/
 int soundOpen( void );
 
 // ----------------------------------------------------------------------------
@@ -109,14 +157,72 @@ int soundOpen( void );
 */
 long calcVol( float index, float incs, float range, float min, float factor );
 
+// ----------------------------------------------------------------------------
+//  Builds table of volumes for each index if parameters have changed.
+// ----------------------------------------------------------------------------
+/*
+    Holds calcVol for indices 0 to incs using factor, incs, min and range
+    from sound struct. Called by soundOpen and before each look up, but
+    only rebuilt if one of those has changed, so each volume step is a
+    table look up rather than a call to pow().
+*/
+void buildVolTable( void );
+
+// ----------------------------------------------------------------------------
+//  Returns volume for index.
+// ----------------------------------------------------------------------------
+long indexVol( unsigned char index );
+
+// ----------------------------------------------------------------------------
+//  Returns index with volume nearest to a hardware volume.
+// ----------------------------------------------------------------------------
+/*
+    Inverse of indexVol, e.g. for volumes read back from ALSA that may
+    have been set by another mixer.
+*/
+unsigned char volIndex( long volume );
+
+// ----------------------------------------------------------------------------
+//  Reads volume back from ALSA mixer and sets index to match.
+// ----------------------------------------------------------------------------
+int getVol( void );
+
 // ----------------------------------------------------------------------------
 //  Set volume using ALSA mixers.
 // ----------------------------------------------------------------------------
 int setVol( void );
 
+// ----------------------------------------------------------------------------
+//  Starts the volume applier. Returns -1 if not.
+// ----------------------------------------------------------------------------
+/*
+    The applier is a thread that writes posted volumes to the mixer, so
+    the caller never waits on the sound card. Bursts of posts are merged,
+    writes are at least interval mS apart, and a volume that is the same
+    as the last one written isn't written. Call after soundOpen. setVol
+    and getVol shouldn't be used while it is running.
+*/
+int volApplierStart( uint16_t interval );
+
+// ----------------------------------------------------------------------------
+//  Stops the volume applier after any pending write.
+// ----------------------------------------------------------------------------
+void volApplierStop( void );
+
+// ----------------------------------------------------------------------------
+//  Posts volume for the current index to the applier.
+// ----------------------------------------------------------------------------
+/*
+    Calls setVol if the applier isn't running.
+*/
+void postVol( void );
+
 // ----------------------------------------------------------------------------
 //  Increases volume.
 // ----------------------------------------------------------------------------
+/*
+    incVol and decVol post the new volume.
+*/
 void incVol( void );
 
 // ----------------------------------------------------------------------------
@@ -125,7 +231,33 @@ void incVol( void );
 void decVol( void );
 
 // ----------------------------------------------------------------------------
-//  Detaches and closes ALSA.
+//  Returns number of mixer poll descriptors.
+// ----------------------------------------------------------------------------
+/*
+    The mixer descriptors become readable when another client, such as
+    alsamixer or a player, changes the mixer. They can be added to the
+    same poll or epoll set as the encoder eventfd, and soundHandleEvents
+    called when they are readable. sound.index and sound.volume then
+    follow the change without polling or reopening the mixer.
+*/
+int soundPollCount( void );
+
+// ----------------------------------------------------------------------------
+//  Fills in mixer poll descriptors. Returns number filled in.
+// ----------------------------------------------------------------------------
+int soundPollDescriptors( struct pollfd *fds, unsigned int space );
+
+// ----------------------------------------------------------------------------
+//  Handles mixer events, updating index if volume has changed.
+// ----------------------------------------------------------------------------
+/*
+    Call from the same thread as incVol and decVol, since it sets
+    sound.index.
+*/
+int soundHandleEvents( void );
+
+// ----------------------------------------------------------------------------
+//  Detaches and closes ALSA, or closes the backend.
 // ----------------------------------------------------------------------------
 void soundClose( void );
 
@@ -27,12 +27,14 @@
 */
 // ****************************************************************************
 
-#define piRotEncVersion "Version 0.2"
+#define piRotEncVersion "Version 0.11"
 
 //  Compilation:
 //
-//  Compile with gcc piRotEnc.c alsaPi.c rotencPi.c -o piRotEnc
+//  Compile with gcc piRotEnc.c alsaPi.c alsaCtl.c ../infoPi/snapshotPi.c
+//          rotencPi.c -o piRotEnc
 //          -lwiringPi -lasound -lm -lpthread
+//  Add -DRTPI ../rtPi/rtPi.c for the real time profile option.
 //  Also use the following flags for Raspberry Pi optimisation:
 //          -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
 //          -ffast-math -pipe -O3
@@ -45,6 +47,15 @@
 //
 //  v0.1 Original version.
 //  v0.2 Rewrite main functions into libraries.
+//  v0.3 Sleep on the encoder eventfd instead of polling.
+//  v0.4 Apply all detents counted since the last wake.
+//  v0.5 Added encoder acceleration.
+//  v0.6 Use the gpiochip backend where available.
+//  v0.7 Volume written by the alsaPi applier thread.
+//  v0.8 Added dB volume mapping option.
+//  v0.9 Follow volume changes made by other mixer clients.
+//  v0.10 Go straight to the mixer control from the infoPi snapshot.
+//  v0.11 Added real time profile option.
 //
 
 //  To Do:
@@ -65,13 +76,18 @@
 #include <wiringPi.h>
 //#include <math.h>
 #include <stdbool.h>
+#include <poll.h>
 //#include <ctype.h>
 //#include <stdlib.h>
 
 #include "alsaPi.h"
+#include "alsaCtl.h"
+#include "../infoPi/snapshotPi.h"
 #include "rotencPi.h"
+#include "../rtPi/rtPi.h"
 
 #define NUM_BOUNDS 2
+#define NUM_POLLS  8 // Encoder eventfd and mixer descriptors.
 
 // Data structures. -----------------------------------------------------------
 
@@ -87,9 +103,12 @@ struct commandStruct            // Command line options.
     uint8_t     maximum;        // Maximum soft volume (%).
     uint8_t     increments;     // Increments over volume range.
     float       factor;         // Volume shaping factor.
+    bool        dB;             // Equal steps in dB rather than factor.
     int8_t      balance;        // Volume L/R balance.
     uint16_t    delay;          // Delay between encoder tics.
     uint8_t     decode;         // Decoding method.
+    float       accel;          // Acceleration gain, 0 for none.
+    bool        realTime;       // Use the rtPi real time profile.
     bool        printOutput;    // Flag to print output.
     bool        printOptions;   // Flag to print options.
     bool        printRanges;    // Flag to print ranges.
@@ -106,9 +125,12 @@ struct commandStruct            // Command line options.
     .maximum        = 100,      // 100% of Maximum output level.
     .increments     = 20,       // 20 increments from 0 to 100%.
     .factor         = 1,        // Volume change rate factor.
+    .dB             = false,    // Map with factor.
     .balance        = 0,        // L = R.
     .delay          = 100,      // 100ms between state checks.
     .decode         = 4,        // Full decoding mode.
+    .accel          = 0.2,      // Scale 2x at 15 detents/S, up to 8x.
+    .realTime       = false,    // Normal scheduling.
     .printOutput    = false,    // No output printing.
     .printOptions   = false,    // No command line options printing.
     .printRanges    = false     // No range printing.
@@ -122,6 +144,7 @@ struct boundsStruct                     // Boundary limits for options.
     uint8_t incs    [NUM_BOUNDS];       // Increments.
     uint16_t delay  [NUM_BOUNDS];       // Sensitivity delay.
     uint8_t decode  [NUM_BOUNDS];       // Decoding methods.
+    float   accel   [NUM_BOUNDS];       // Acceleration gain.
 }
     bounds =                            // Set default values.
 {
@@ -130,7 +153,8 @@ struct boundsStruct                     // Boundary limits for options.
     .factor     =   { 0.001, 10     },  // 0.001 to 10.
     .incs       =   { 10,    0xFF   },  // UINT8.
     .delay      =   { 1,     0xFFFF },  // UINT16.
-    .decode     =   { 0,     4      }   // Number of methods in library.
+    .decode     =   { 0,     4      },  // Number of methods in library.
+    .accel      =   { 0,     10     }   // 0 to 10.
 };
 
 
@@ -155,8 +179,11 @@ static void printOptions( void )
     printf( "\t| Minimum         | %3i%% %10s |\n", command.minimum, "" );
     printf( "\t| Maximum         | %3i%% %10s |\n", command.maximum, "" );
     printf( "\t| Factor          | %7.3f %7s |\n", command.factor, "" );
+    printf( "\t| dB steps        | %-15s |\n", command.dB ? "yes" : "no" );
     printf( "\t| Interrupt delay | %3i %11s |\n", command.delay, "" );
     printf( "\t| Decode method   | %3i %11s |\n", command.decode, "" );
+    printf( "\t| Acceleration    | %7.3f %7s |\n", command.accel, "" );
+    printf( "\t| Real time       | %-15s |\n", command.realTime ? "yes" : "no" );
     printf( "\t+-----------------+-----------------+\n\n" );
 };
 
@@ -181,6 +208,8 @@ static void printRanges( void )
             "Response", "-r", bounds.delay[0], bounds.delay[1] );
     printf( "\t| %-10s |   %2s   |  %3d  |  %3d  |\n",
             "Decode", "-d", bounds.decode[0], bounds.decode[1] );
+    printf( "\t| %-10s |   %2s   | %5.3f | %5.2f |\n",
+            "Accel", "-a", bounds.accel[0], bounds.accel[1] );
     printf( "\t+------------+--------+-------+-------+\n\n" );
 };
 
@@ -213,9 +242,12 @@ static struct argp_option options[] =
     { "max",       'k', "<int>",       0, "Maximum volume (%)." },
     { "inc",       'i', "<int>",       0, "Volume increments." },
     { "fac",       'f', "<float>",     0, "Volume profile factor." },
+    { "db",        'D',       0,       0, "Equal volume steps in dB." },
     { 0, 0, 0, 0, "Responsiveness:" },
     { "decode",    'd', "<int>",       0, "Decoding method." },
     { "delay",     'r', "<int>",       0, "Interrupt delay (mS)." },
+    { "accel",     'a', "<float>",     0, "Acceleration gain, 0 for none." },
+    { "realtime",  'T',       0,       0, "Real time scheduling profile." },
     { 0, 0, 0, 0, "Debugging:" },
     { "proutput",  'P',       0,       0, "Print output while running." },
     { "proptions", 'O',       0,       0, "Print all command options." },
@@ -267,12 +299,21 @@ static int parse_opt( int param, char *arg, struct argp_state *state )
         case 'f' :
             command.factor = atof( arg );
             break;
+        case 'D' :
+            command.dB = true;
+            break;
         case 'r' :
             command.delay = atoi( arg );
             break;
         case 'd' :
             command.decode = atoi( arg );
             break;
+        case 'a' :
+            command.accel = atof( arg );
+            break;
+        case 'T' :
+            command.realTime = true;
+            break;
         case 'P' :
             command.printOutput = true;
             break;
@@ -335,7 +376,10 @@ static bool checkParams ( void )
                                   bounds.delay[1] )   ||
                  checkIfInBounds( command.decode,       // Decode method.
                                   bounds.decode[0],
-                                  bounds.decode[1] ));
+                                  bounds.decode[1] )  ||
+                 checkIfInBounds( command.accel,        // Acceleration.
+                                  bounds.accel[0],
+                                  bounds.accel[1] ));
     if ( !inBounds )
     {
         printf( "\nThere is something wrong with the set parameters.\n" );
@@ -364,6 +408,7 @@ int main( int argc, char *argv[] )
     sound.card      =   command.card;
     sound.mixer     =   command.mixer;
     sound.factor    =   command.factor;
+    sound.dB        =   command.dB;
     sound.volume    =   command.volume;
     sound.mute      =   false;
     sound.incs      =   command.increments;
@@ -371,28 +416,65 @@ int main( int argc, char *argv[] )
     sound.min       =   command.minimum;
     sound.max       =   command.maximum;
 
+    //  Real time profile, before any threads are started.
+    if ( command.realTime )
+    {
+        if ( rtInit( NULL ) < 0 )
+            printf( "Real time profile not fully applied.\n" );
+        rtThread( RT_CONTROL );
+    }
+
     //  Initialise encoder and function button.
     encoder.mode = command.decode;
-    encoderInit( command.gpioA, command.gpioB, command.gpioC );
-
-    //  Initialise ALSA.
+    //  Falls back to wiringPi on kernels without the gpiochip interface.
+    if ( encoderInitChip( ENCODER_CHIP, command.gpioA, command.gpioB,
+                          command.gpioC, 5000 ) < 0 )
+        encoderInit( command.gpioA, command.gpioB, command.gpioC );
+    encoderSetAccel( 10, command.accel, 8 );
+
+    //  Initialise ALSA. A current snapshot from infoPi -s saves the mixer
+    //  scan, otherwise the mixer is opened as before.
+    if ( !command.dB ) ctlInit( SNAPSHOT_PATH );
     soundOpen();
 
     //  Set initial volume.
     setVol();
 
-    //  Check for attributes changed by interrupts.
-    while ( 1 )
+    //  Volume changes are posted to the applier from here on.
+    volApplierStart( VOL_APPLY_INTERVAL );
+
+    //  Wait on the encoder eventfd and the mixer together.
+    struct pollfd polls[NUM_POLLS];
+    int numPolls, i;
+
+    polls[0].fd     = encoderEventFd();
+    polls[0].events = POLLIN;
+    numPolls = 1 + soundPollDescriptors( &polls[1], NUM_POLLS - 1 );
+    if ( numPolls < 1 ) numPolls = 1;
+
+    //  Sleep until there are detents, button presses or mixer changes.
+    while ( poll( polls, numPolls, -1 ) >= 0 )
     {
-        //  Volume.
-        if (( encoderDirection != 0 ) && ( !sound.mute ))
+        //  Volume changed by another client.
+        for ( i = 1; i < numPolls; i++ )
+            if ( polls[i].revents )
+            {
+                soundHandleEvents();
+                break;
+            }
+
+        if ( !( polls[0].revents & POLLIN )) continue;
+        if ( encoderWait() == 0 ) break;
+
+        //  Volume. All detents since the last wake are applied at once,
+        //  scaled up when the knob is turned quickly.
+        int32_t steps = encoderGetAccelSteps();
+        if (( steps != 0 ) && ( !sound.mute ))
         {
             // Volume +
-            if ( encoderDirection > 0 ) incVol();
+            for ( ; steps > 0; steps-- ) incVol();
             // Volume -
-            else decVol();
-            encoderDirection = 0;
-            setVol();
+            for ( ; steps < 0; steps++ ) decVol();
         }
         //  Button.
 //        if ( button.state )
@@ -401,10 +483,9 @@ int main( int argc, char *argv[] )
 //            button.state = false;
 //            setVolumeMixer( volume );  // May be better to use playback switch.
 //        }
-
-        // Sensitivity delay.
-        delay( command.delay );
     }
 
+    soundClose();
+
     return 0;
 }
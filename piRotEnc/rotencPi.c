@@ -29,6 +29,9 @@
 
         gcc -c -fpic -Wall rotencPi.c -lwiringPi -lpthread
 
+    Add -DSTATSPI and ../statsPi/statsPi.c to count and time edges.
+    Add -DRTPI and ../rtPi/rtPi.c for the real time profile.
+
     Also use the following flags for Raspberry Pi optimisation:
 
         -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
@@ -47,6 +50,14 @@
         v0.1    Original version.
         v0.2    Converted to libraries.
         v0.3    Combined different methods.
+        v0.4    Added direction and button callbacks and an eventfd.
+        v0.5    Lock free step counting in the interrupt functions.
+        v0.6    Added velocity based acceleration.
+        v0.7    Added gpiochip backend with kernel timestamps.
+        v0.8    Multiple encoders served by one event thread.
+        v0.9    Encoders fed with levels from other sources, e.g. MCP23017.
+        v0.10   Added statsPi counters.
+        v0.11   Encoder threads take the rtPi encoder role.
 
     To Do:
 
@@ -60,21 +71,62 @@
 #include <stdint.h>
 #include <wiringPi.h>
 #include <stdbool.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#include <fcntl.h>
+#include <string.h>
+#include <errno.h>
 #include <pthread.h>
 
 #include "rotencPi.h"
+#include "../statsPi/statsPi.h"
+#include "../rtPi/rtPi.h"
 
 
-// Mutex locks ----------------------------------------------------------------
+//  Steps and callbacks -------------------------------------------------------
 
-pthread_mutex_t encoderBusy; // Mutex lock for encoder interrupt function.
-pthread_mutex_t buttonBusy;  // Mutex lock for button inerrupt function.
+/*
+    Each encoder keeps its own decoder state, detents and callbacks in its
+    encoderStruct. The global encoder is the one used by encoderInit and
+    the other functions that don't take an encoder, and the others come
+    from encoders[] as they are added.
+
+    The interrupt functions may run in more than one thread at once, one
+    per wiringPi pin. Nothing is locked. Detents are added to steps
+    atomically and the decoder states are updated with compare and swap,
+    retrying if the other thread got there first. The consumer swaps
+    steps with 0, so no detents are lost however long it takes to get
+    round to them.
+*/
+static struct encoderStruct encoders[ENCODER_MAX];
+static uint8_t encoderCount = 0; // Encoders added to encoders[].
+
+static int eventFd = -1; // Signalled on each detent or button press.
+
+// gpiochip backend.
+static int       pollFd = -1;   // epoll set of every line request.
+static int       stopFd = -1;   // Wakes the event thread to stop it.
+static pthread_t chipThread;
+
+// Descriptors served by the event thread.
+struct encoderWatchStruct
+{
+    int    fd;
+    void ( *handler )( int fd, void *data );
+    void  *data;
+};
+static struct encoderWatchStruct watches[ENCODER_WATCH_MAX];
+static uint8_t watchCount = 0;
 
 
 //  Data types ----------------------------------------------------------------
 
 // Simple state table.
-static const uint8_t simpleTable[SIMPLE_TABLE_COLS] = SIMPLE_TABLE;
+static const int8_t simpleTable[SIMPLE_TABLE_COLS] = SIMPLE_TABLE;
 
 // State transition table - half mode.
 static const uint8_t halfTable[HALF_TABLE_ROWS][HALF_TABLE_COLS] = HALF_TABLE;
@@ -83,173 +135,248 @@ static const uint8_t halfTable[HALF_TABLE_ROWS][HALF_TABLE_COLS] = HALF_TABLE;
 static const uint8_t fullTable[FULL_TABLE_ROWS][FULL_TABLE_COLS] = FULL_TABLE;
 
 //  ---------------------------------------------------------------------------
-//  Sets direction in encoderDirection according to state of pin B.
+//  Wakes anything waiting on the eventfd.
 //  ---------------------------------------------------------------------------
-void setDirectionSimple( void )
+static void signalEvent( void )
 {
-    // Lock thread.
-    pthread_mutex_lock( &encoderBusy );
+    uint64_t one = 1;
 
-    // Function is triggered by A so we only need to read B.
-    bool b = digitalRead( encoder.gpioB );
-
-    if ( b ) encoderDirection = -1;
-    else encoderDirection = 1;
+    if ( eventFd < 0 ) return;
 
-    /*
-        It may be a good idea to allow a function to be registered here
-        rather than rely on polling the encoderDirection variable, which
-        causes high cpu usage. It will then be completely interrupt driven.
-        Since wiringPi does not allow parameter passing via it's interrupt
-        routine, this may not be feasible without rewriting the wiringPi
-        library.
-    */
+    // Never blocks, the eventfd just counts up.
+    if ( write( eventFd, &one, sizeof( one )) != sizeof( one )) return;
+};
 
-    // Unlock thread.
-    pthread_mutex_unlock( &encoderBusy );
+//  ---------------------------------------------------------------------------
+//  Returns CLOCK_MONOTONIC in nS.
+//  ---------------------------------------------------------------------------
+static uint64_t getTime( void )
+{
+    struct timespec now;
 
-    return;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( uint64_t ) now.tv_sec * 1000000000 + now.tv_nsec;
 };
 
+//  ---------------------------------------------------------------------------
+//  Sets an encoder's states and acceleration to their defaults.
+//  ---------------------------------------------------------------------------
+static void resetEncoder( struct encoderStruct *e )
+{
+    e->direction   = 0;
+    e->state       = 0;
+    e->buttonState = 0;
+    e->detentCount = 0;
+    e->fd          = -1;
+    memset( e->detentTimes, 0, sizeof( e->detentTimes ));
+    if ( e->accel.max < 1 )
+    {
+        e->accel.threshold = 10;
+        e->accel.gain      = 0;
+        e->accel.max       = 1;
+    }
+    __atomic_store_n( &e->steps, 0, __ATOMIC_RELEASE );
+};
 
+//  ---------------------------------------------------------------------------
+//  Adds a detent, calls the direction callback and signals the eventfd.
+//  ---------------------------------------------------------------------------
+static void notifyDirection( struct encoderStruct *e, int8_t direction,
+                             uint64_t time )
+{
+    void ( *callback )( int8_t, void * );
+    uint32_t slot;
+
+    slot = __atomic_fetch_add( &e->detentCount, 1, __ATOMIC_RELAXED );
+    __atomic_store_n( &e->detentTimes[ slot % ENCODER_RING ], time,
+                      __ATOMIC_RELEASE );
+    __atomic_add_fetch( &e->steps, direction, __ATOMIC_RELEASE );
+    statsAdd( STATS_ENCODER_DETENTS, 1 );
+    e->direction = direction;
+    if ( e == &encoder ) encoderDirection = direction;
+
+    callback = __atomic_load_n( &e->directionCallback, __ATOMIC_ACQUIRE );
+    if ( callback != NULL ) callback( direction, e->directionData );
+    signalEvent();
+};
 
 //  ---------------------------------------------------------------------------
-//  Sets direction in encoderDirection using SIMPLE_TABLE.
+//  Toggles buttonState, calls the button callback and signals the eventfd.
 //  ---------------------------------------------------------------------------
-void setDirectionTable( void )
+static void notifyButton( struct encoderStruct *e )
 {
-    static uint8_t code = 0; // Keep readings between calls.
+    void ( *callback )( int8_t, void * );
+    int8_t state;
 
-    // Lock thread.
-    pthread_mutex_lock( &encoderBusy );
+    state = __atomic_xor_fetch( &e->buttonState, 1, __ATOMIC_ACQ_REL );
+    if ( e == &encoder ) buttonState = state;
 
-    // Shift old AB into higher bits and read current AB into lower bits.
-    code <<= 2;
-    bool a = digitalRead( encoder.gpioA );
-    bool b = digitalRead( encoder.gpioB );
-    code += a * 0x2 + b;
-    code &= 0xf;
+    callback = __atomic_load_n( &e->buttonCallback, __ATOMIC_ACQUIRE );
+    if ( callback != NULL ) callback( state, e->buttonData );
+    signalEvent();
+};
 
-    // Get direction from state table.
-    encoderDirection = simpleTable[ code ];
 
-    /*
-        It may be a good idea to allow a function to be registered here
-        rather than rely on polling the encoderDirection variable, which
-        causes high cpu usage. It will then be completely interrupt driven.
-        Since wiringPi does not allow parameter passing via it's interrupt
-        routine, this may not be feasible without rewriting the wiringPi
-        library.
-    */
+//  Decoders ------------------------------------------------------------------
 
-    // Unlock thread.
-    pthread_mutex_unlock( &encoderBusy );
+/*
+    The decoders take the levels of A and B so they can be fed either by
+    the wiringPi interrupt functions, which read the pins, or by the
+    gpiochip event thread, which tracks them from the edge events.
+*/
 
-    return;
+//  ---------------------------------------------------------------------------
+//  Decodes direction from the state of pin B at a rising edge of A.
+//  ---------------------------------------------------------------------------
+static void decodeSimple( struct encoderStruct *e, bool b, uint64_t time )
+{
+    notifyDirection( e, b ? -1 : 1, time );
 };
 
 //  ---------------------------------------------------------------------------
-//  Sets direction in encoderDirection using HALF_TABLE.
+//  Decodes direction using SIMPLE_TABLE.
 //  ---------------------------------------------------------------------------
-void setDirectionHalf( void )
+static void decodeTable( struct encoderStruct *e, bool a, bool b,
+                         uint64_t time )
 {
-    // Lock thread.
-    pthread_mutex_lock( &encoderBusy );
+    uint8_t old, code;
 
-    // Get AB.
-    static uint8_t state = 0;
-    static uint8_t code = 0;
+    // Shift old AB into higher bits and current AB into lower bits.
+    old = __atomic_load_n( &e->state, __ATOMIC_ACQUIRE );
+    do
+        code = (( old << 2 ) | ( a << 1 ) | b ) & 0xf;
+    while ( !__atomic_compare_exchange_n( &e->state, &old, code, false,
+                                          __ATOMIC_ACQ_REL,
+                                          __ATOMIC_ACQUIRE ));
 
-    code = ( digitalRead( encoder.gpioB ) << 1 ) |
-             digitalRead( encoder.gpioA );
+    // Get direction from state table.
+    int8_t direction = simpleTable[ code ];
+    if ( direction != 0 ) notifyDirection( e, direction, time );
+};
 
-    // Look up state in transition table.
-    state = halfTable[ state & 0xf ][ code ];
+//  ---------------------------------------------------------------------------
+//  Steps a transition table and decodes direction when it completes.
+//  ---------------------------------------------------------------------------
+static void decodeTransition( struct encoderStruct *e,
+                              const uint8_t table[][HALF_TABLE_COLS],
+                              bool a, bool b, uint64_t time )
+{
+    uint8_t old, state;
+
+    // Look up state in transition table using BA.
+    old = __atomic_load_n( &e->state, __ATOMIC_ACQUIRE );
+    do
+        state = table[ old & 0xf ][ ( b << 1 ) | a ];
+    while ( !__atomic_compare_exchange_n( &e->state, &old, state, false,
+                                          __ATOMIC_ACQ_REL,
+                                          __ATOMIC_ACQUIRE ));
+
+    // Determine direction.
+    uint8_t step = state & 0x30;
+    if ( step ) notifyDirection( e, step == 0x10 ? -1 : 1, time );
+};
 
-    // Determine direction and set encoderDirection.
-    uint8_t direction = state & 0x30;
-    if ( direction ) encoderDirection = ( direction == 0x10 ? -1 : 1 );
-    else encoderDirection = 0;
+//  ---------------------------------------------------------------------------
+//  Decodes new levels of A and B by the encoder's mode.
+//  ---------------------------------------------------------------------------
+static void decodeLevels( struct encoderStruct *e, bool a, bool b,
+                          uint64_t time )
+{
+    switch ( e->mode )
+    {
+        case SIMPLE_1:
+            decodeSimple( e, b, time );
+            break;
+        case SIMPLE_2:
+        case SIMPLE_4:
+            decodeTable( e, a, b, time );
+            break;
+        case HALF:
+            decodeTransition( e, halfTable, a, b, time );
+            break;
+        default:
+            decodeTransition( e, fullTable, a, b, time );
+            break;
+    }
+};
 
-    /*
-        It may be a good idea to allow a function to be registered here
-        rather than rely on polling the encoderDirection variable, which
-        causes high cpu usage. It will then be completely interrupt driven.
-        Since wiringPi does not allow parameter passing via it's interrupt
-        routine, this may not be feasible without rewriting the wiringPi
-        library.
-    */
 
-    // Unlock thread.
-    pthread_mutex_unlock( &encoderBusy );
+//  wiringPi interrupt functions ----------------------------------------------
 
-    return;
+/*
+    wiringPi interrupt functions take no arguments, so these only serve
+    the global encoder. They run in wiringPi's interrupt threads, which
+    take the encoder role on their first edge.
+*/
 
+//  ---------------------------------------------------------------------------
+//  Counts an edge and the time taken to handle it since time.
+//  ---------------------------------------------------------------------------
+static void countEdge( uint64_t time )
+{
+    rtThread( RT_ENCODER );
+    statsAdd( STATS_ENCODER_EDGES, 1 );
+    statsSince( STATS_ENCODER_TIME, time );
 };
 
 //  ---------------------------------------------------------------------------
-//  Sets direction in encoderDirection using FULL_TABLE.
+//  Sets direction according to state of pin B.
 //  ---------------------------------------------------------------------------
-void setDirectionFull( void )
+void setDirectionSimple( void )
 {
-    // Lock thread.
-    pthread_mutex_lock( &encoderBusy );
+    uint64_t time = getTime();
 
-    // Get AB
-    static uint8_t state = 0;
-    static uint8_t code = 0;
-    code = ( digitalRead( encoder.gpioB ) << 1 ) |
-             digitalRead( encoder.gpioA );
+    // Function is triggered by A so we only need to read B.
+    decodeSimple( &encoder, digitalRead( encoder.gpioB ), time );
+    countEdge( time );
+};
 
-    // Look up state in transition table.
-    state = fullTable[ state & 0xf ][ code ];
+//  ---------------------------------------------------------------------------
+//  Sets direction using SIMPLE_TABLE.
+//  ---------------------------------------------------------------------------
+void setDirectionTable( void )
+{
+    uint64_t time = getTime();
 
-    // Determine direction and set encoderDirection.
-    uint8_t direction = state & 0x30;
-    if ( direction ) encoderDirection = ( direction == 0x10 ? -1 : 1 );
-    else encoderDirection = 0;
+    decodeTable( &encoder, digitalRead( encoder.gpioA ),
+                 digitalRead( encoder.gpioB ), time );
+    countEdge( time );
+};
 
-    /*
-        It may be a good idea to allow a function to be registered here
-        rather than rely on polling the encoderDirection variable, which
-        causes high cpu usage. It will then be completely interrupt driven.
-        Since wiringPi does not allow parameter passing via it's interrupt
-        routine, this may not be feasible without rewriting the wiringPi
-        library.
-    */
+//  ---------------------------------------------------------------------------
+//  Sets direction using HALF_TABLE.
+//  ---------------------------------------------------------------------------
+void setDirectionHalf( void )
+{
+    uint64_t time = getTime();
 
-    // Unlock thread.
-    pthread_mutex_unlock( &encoderBusy );
+    decodeTransition( &encoder, halfTable, digitalRead( encoder.gpioA ),
+                      digitalRead( encoder.gpioB ), time );
+    countEdge( time );
+};
 
-    return;
+//  ---------------------------------------------------------------------------
+//  Sets direction using FULL_TABLE.
+//  ---------------------------------------------------------------------------
+void setDirectionFull( void )
+{
+    uint64_t time = getTime();
 
+    decodeTransition( &encoder, fullTable, digitalRead( encoder.gpioA ),
+                      digitalRead( encoder.gpioB ), time );
+    countEdge( time );
 };
 
 //  ---------------------------------------------------------------------------
-//  Returns button state in button struct. Call by interrupt on GPIO.
+//  Toggles buttonState. Call by interrupt on GPIO.
 //  ---------------------------------------------------------------------------
 void setButtonState( void )
 {
-    // Lock thread.
-    pthread_mutex_lock( &buttonBusy );
+    uint64_t time = getTime();
 
     // Read GPIO state.
-    int buttonRead = digitalRead( button.gpio );
-    if ( buttonRead ) buttonState = !buttonState;
-
-    /*
-        It may be a good idea to allow a function to be registered here
-        rather than rely on polling the buttonState variable, which
-        causes high cpu usage. It will then be completely interrupt driven.
-        Since wiringPi does not allow parameter passing via it's interrupt
-        routine, this may not be feasible without rewriting the wiringPi
-        library.
-    */
-
-    // Unlock thread.
-    pthread_mutex_unlock( &buttonBusy );
-
-    return;
+    if ( digitalRead( button.gpio )) notifyButton( &encoder );
+    countEdge( time );
 };
 
 //  ---------------------------------------------------------------------------
@@ -263,8 +390,16 @@ void encoderInit( uint8_t gpioA, uint8_t gpioB, uint8_t gpioC )
 
     wiringPiSetupGpio();
 
+    // Created before the interrupts so that no events are missed.
+    if ( eventFd < 0 ) eventFd = eventfd( 0, EFD_CLOEXEC );
+
+    // Set states.
+    resetEncoder( &encoder );
+    encoderDirection = 0;
+
     encoder.gpioA = gpioA;
     encoder.gpioB = gpioB;
+    encoder.gpioC = gpioC;
 
     // Set encoder GPIO modes.
     pinMode( encoder.gpioA, INPUT );
@@ -295,9 +430,6 @@ void encoderInit( uint8_t gpioA, uint8_t gpioB, uint8_t gpioC )
             break;
     }
 
-    // Set states.
-    encoderDirection = 0;
-
     // Only set up a button if there is one.
     if ( gpioC != 0xFF )
     {
@@ -320,3 +452,500 @@ void encoderInit( uint8_t gpioA, uint8_t gpioB, uint8_t gpioC )
 
     return;
 }
+
+
+//  gpiochip backend ----------------------------------------------------------
+
+/*
+    Each encoder's A, B and button are requested together as one set of
+    lines from the GPIO character device, giving one file descriptor per
+    encoder. All of them are added to one epoll set and served by one
+    thread, however many encoders there are. The kernel timestamps each
+    edge as it happens and queues it with the new level, so the decoders
+    get the levels at the edge rather than whatever the pins read by the
+    time the thread has woken up, and bursts of edges are read in one go.
+*/
+
+//  ---------------------------------------------------------------------------
+//  Decodes an edge of A (line 0), B (line 1) or the button (line 2).
+//  ---------------------------------------------------------------------------
+static void decodeEdge( struct encoderStruct *e, uint8_t line, bool level,
+                        uint64_t time )
+{
+    statsAdd( STATS_ENCODER_EDGES, 1 );
+
+    switch ( line )
+    {
+        case 0:
+            e->levelA = level;
+            // SIMPLE_1 only decodes rising edges of A.
+            if (( e->mode != SIMPLE_1 ) || level )
+                decodeLevels( e, e->levelA, e->levelB, time );
+            break;
+        case 1:
+            e->levelB = level;
+            // Simple modes 1 and 2 only decode edges of A.
+            if ( e->mode > SIMPLE_2 )
+                decodeLevels( e, e->levelA, e->levelB, time );
+            break;
+        default:
+            e->levelC = level;
+            // Toggle on press.
+            if ( !level ) notifyButton( e );
+            break;
+    }
+};
+
+//  ---------------------------------------------------------------------------
+//  Reads and decodes an encoder's queued edge events.
+//  ---------------------------------------------------------------------------
+static void readLines( int fd, void *data )
+{
+    struct gpio_v2_line_event events[ENCODER_EVENTS];
+    struct encoderStruct *e = data;
+    uint64_t time = getTime();
+    ssize_t bytes;
+    uint8_t line;
+    int i;
+
+    // Read as many events as are queued, up to ENCODER_EVENTS.
+    bytes = read( fd, events, sizeof( events ));
+    if ( bytes < 0 ) return;
+
+    for ( i = 0; i < bytes / ( ssize_t ) sizeof( events[0] ); i++ )
+    {
+        line = ( events[i].offset == e->gpioA ) ? 0 :
+               ( events[i].offset == e->gpioB ) ? 1 : 2;
+        decodeEdge( e, line,
+                    events[i].id == GPIO_V2_LINE_EVENT_RISING_EDGE,
+                    events[i].timestamp_ns );
+
+        // Kernel timestamps are CLOCK_MONOTONIC, as is time.
+        if ( time > events[i].timestamp_ns )
+            statsRecord( STATS_ENCODER_LATENCY,
+                         time - events[i].timestamp_ns );
+    }
+    statsSince( STATS_ENCODER_TIME, time );
+};
+
+//  ---------------------------------------------------------------------------
+//  Waits for descriptors and calls their handlers until stopped.
+//  ---------------------------------------------------------------------------
+static void *chipEvents( void *arg )
+{
+    struct epoll_event ready[ENCODER_WATCH_MAX + 1];
+    struct encoderWatchStruct *w;
+    int count, i;
+
+    (void) arg;
+
+    rtThread( RT_ENCODER );
+
+    for ( ;; )
+    {
+        count = epoll_wait( pollFd, ready, ENCODER_WATCH_MAX + 1, -1 );
+        if ( count < 0 )
+        {
+            if ( errno == EINTR ) continue;
+            break;
+        }
+
+        for ( i = 0; i < count; i++ )
+        {
+            // stopFd is the only one without a watch.
+            w = ready[i].data.ptr;
+            if ( w == NULL ) return NULL;
+            w->handler( w->fd, w->data );
+        }
+    }
+
+    return NULL;
+};
+
+//  ---------------------------------------------------------------------------
+//  Creates the epoll set and starts the event thread. Returns -1 if not.
+//  ---------------------------------------------------------------------------
+static int8_t startEvents( void )
+{
+    struct epoll_event watch;
+
+    if ( pollFd >= 0 ) return 0;
+
+    if ( eventFd < 0 ) eventFd = eventfd( 0, EFD_CLOEXEC );
+    pollFd = epoll_create1( EPOLL_CLOEXEC );
+    stopFd = eventfd( 0, EFD_CLOEXEC );
+    if (( eventFd < 0 ) || ( pollFd < 0 ) || ( stopFd < 0 )) goto fail;
+
+    watch.events   = EPOLLIN;
+    watch.data.ptr = NULL;
+    if ( epoll_ctl( pollFd, EPOLL_CTL_ADD, stopFd, &watch ) < 0 ) goto fail;
+
+    if ( pthread_create( &chipThread, NULL, chipEvents, NULL ) == 0 )
+        return 0;
+
+fail:
+    if ( pollFd >= 0 ) close( pollFd );
+    if ( stopFd >= 0 ) close( stopFd );
+    pollFd = stopFd = -1;
+    return -1;
+};
+
+//  ---------------------------------------------------------------------------
+//  Requests an encoder's lines and adds them to the event thread.
+//  ---------------------------------------------------------------------------
+static int8_t requestLines( struct encoderStruct *e, const char *chip,
+                            uint32_t debounce )
+{
+    struct gpio_v2_line_request request;
+    struct gpio_v2_line_values  values;
+    int fd;
+
+    fd = open( chip, O_RDONLY | O_CLOEXEC );
+    if ( fd < 0 ) return -1;
+
+    memset( &request, 0, sizeof( request ));
+    request.offsets[0] = e->gpioA;
+    request.offsets[1] = e->gpioB;
+    request.num_lines  = 2;
+    if ( e->gpioC != 0xFF ) request.offsets[ request.num_lines++ ] = e->gpioC;
+    strncpy( request.consumer, "rotencPi", GPIO_MAX_NAME_SIZE - 1 );
+    request.event_buffer_size = ENCODER_EVENTS * 4;
+    request.config.flags = GPIO_V2_LINE_FLAG_INPUT |
+                           GPIO_V2_LINE_FLAG_EDGE_RISING |
+                           GPIO_V2_LINE_FLAG_EDGE_FALLING |
+                           GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+
+    // Debounce the button in the kernel, where the driver supports it.
+    if (( e->gpioC != 0xFF ) && ( debounce > 0 ))
+    {
+        request.config.num_attrs = 1;
+        request.config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_DEBOUNCE;
+        request.config.attrs[0].attr.debounce_period_us = debounce;
+        request.config.attrs[0].mask = 1 << 2;
+    }
+
+    if ( ioctl( fd, GPIO_V2_GET_LINE_IOCTL, &request ) < 0 )
+    {
+        // Try again without debounce.
+        request.config.num_attrs = 0;
+        if (( debounce == 0 ) ||
+            ( ioctl( fd, GPIO_V2_GET_LINE_IOCTL, &request ) < 0 ))
+        {
+            close( fd );
+            return -1;
+        }
+    }
+    close( fd );
+    e->fd = request.fd;
+
+    // Start from the current levels of A and B.
+    values.mask = 0x3;
+    values.bits = 0x3;
+    ioctl( e->fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values );
+    e->levelA = values.bits & 0x1;
+    e->levelB = values.bits & 0x2;
+    e->levelC = true;
+    if ( e->mode <= SIMPLE_4 ) e->state = ( e->levelA << 1 ) | e->levelB;
+
+    if ( encoderWatch( e->fd, readLines, e ) < 0 )
+    {
+        close( e->fd );
+        e->fd = -1;
+        return -1;
+    }
+
+    return 0;
+};
+
+//  ---------------------------------------------------------------------------
+//  Initialises encoder and button using a gpiochip. Returns -1 if not.
+//  ---------------------------------------------------------------------------
+int8_t encoderInitChip( const char *chip, uint8_t gpioA, uint8_t gpioB,
+                        uint8_t gpioC, uint32_t debounce )
+{
+    resetEncoder( &encoder );
+    encoderDirection = 0;
+    buttonState = 0;
+
+    encoder.gpioA = gpioA;
+    encoder.gpioB = gpioB;
+    encoder.gpioC = gpioC;
+    button.gpio   = gpioC;
+
+    return requestLines( &encoder, chip, debounce );
+};
+
+//  ---------------------------------------------------------------------------
+//  Adds an encoder on a gpiochip. Returns NULL if not.
+//  ---------------------------------------------------------------------------
+struct encoderStruct *encoderAdd( const char *chip, enum decode_t mode,
+                                  uint8_t gpioA, uint8_t gpioB,
+                                  uint8_t gpioC, uint32_t debounce )
+{
+    struct encoderStruct *e;
+
+    if ( encoderCount >= ENCODER_MAX ) return NULL;
+    e = &encoders[ encoderCount ];
+
+    memset( e, 0, sizeof( *e ));
+    resetEncoder( e );
+    e->mode  = mode;
+    e->gpioA = gpioA;
+    e->gpioB = gpioB;
+    e->gpioC = gpioC;
+
+    if ( requestLines( e, chip, debounce ) < 0 ) return NULL;
+    encoderCount++;
+
+    return e;
+};
+
+//  ---------------------------------------------------------------------------
+//  Adds a descriptor to the event thread. Returns -1 if not.
+//  ---------------------------------------------------------------------------
+int8_t encoderWatch( int fd, void ( *handler )( int fd, void *data ),
+                     void *data )
+{
+    struct encoderWatchStruct *w;
+    struct epoll_event watch;
+
+    if ( watchCount >= ENCODER_WATCH_MAX ) return -1;
+    if ( startEvents() < 0 ) return -1;
+
+    w = &watches[ watchCount ];
+    w->fd      = fd;
+    w->handler = handler;
+    w->data    = data;
+
+    watch.events   = EPOLLIN;
+    watch.data.ptr = w;
+    if ( epoll_ctl( pollFd, EPOLL_CTL_ADD, fd, &watch ) < 0 ) return -1;
+    watchCount++;
+
+    return 0;
+};
+
+//  ---------------------------------------------------------------------------
+//  Adds an encoder with levels fed by encoderFeed. Returns NULL if not.
+//  ---------------------------------------------------------------------------
+struct encoderStruct *encoderAddFed( enum decode_t mode, uint8_t pinA,
+                                     uint8_t pinB, uint8_t pinC,
+                                     bool a, bool b )
+{
+    struct encoderStruct *e;
+
+    if ( encoderCount >= ENCODER_MAX ) return NULL;
+    if (( eventFd < 0 ) && (( eventFd = eventfd( 0, EFD_CLOEXEC )) < 0 ))
+        return NULL;
+    e = &encoders[ encoderCount++ ];
+
+    memset( e, 0, sizeof( *e ));
+    resetEncoder( e );
+    e->mode   = mode;
+    e->gpioA  = pinA;
+    e->gpioB  = pinB;
+    e->gpioC  = pinC;
+    e->levelA = a;
+    e->levelB = b;
+    e->levelC = true;
+    if ( e->mode <= SIMPLE_4 ) e->state = ( a << 1 ) | b;
+
+    return e;
+};
+
+//  ---------------------------------------------------------------------------
+//  Decodes new levels of an encoder's pins.
+//  ---------------------------------------------------------------------------
+void encoderFeed( struct encoderStruct *e, bool a, bool b, bool c,
+                  uint64_t time )
+{
+    if ( a != e->levelA ) decodeEdge( e, 0, a, time );
+    if ( b != e->levelB ) decodeEdge( e, 1, b, time );
+    if (( e->gpioC != 0xFF ) && ( c != e->levelC )) decodeEdge( e, 2, c, time );
+};
+
+//  ---------------------------------------------------------------------------
+//  Stops the gpiochip event thread and releases the lines.
+//  ---------------------------------------------------------------------------
+void encoderClose( void )
+{
+    uint64_t stop = 1;
+    uint8_t i;
+
+    // Lines are only requested once the thread is running.
+    if ( stopFd < 0 ) return;
+
+    if ( write( stopFd, &stop, sizeof( stop )) == sizeof( stop ))
+        pthread_join( chipThread, NULL );
+    close( stopFd );
+    close( pollFd );
+    stopFd = pollFd = -1;
+
+    if ( encoder.fd >= 0 ) close( encoder.fd );
+    encoder.fd = -1;
+    for ( i = 0; i < encoderCount; i++ )
+        if ( encoders[i].fd >= 0 ) close( encoders[i].fd );
+    encoderCount = 0;
+    watchCount   = 0;
+};
+
+
+//  Encoder functions ---------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Returns an encoder's detents since the last call and resets them.
+//  ---------------------------------------------------------------------------
+int32_t encoderGetStepsOf( struct encoderStruct *e )
+{
+    return __atomic_exchange_n( &e->steps, 0, __ATOMIC_ACQ_REL );
+};
+
+//  ---------------------------------------------------------------------------
+//  Sets an encoder's acceleration curve. See encoderAccelStruct.
+//  ---------------------------------------------------------------------------
+void encoderSetAccelOf( struct encoderStruct *e, float threshold, float gain,
+                        float max )
+{
+    e->accel.threshold = threshold;
+    e->accel.gain      = gain;
+    e->accel.max       = ( max < 1 ) ? 1 : max;
+};
+
+//  ---------------------------------------------------------------------------
+//  Returns an encoder's rotation rate over recent detents (detents/S).
+//  ---------------------------------------------------------------------------
+/*
+    Uses the detents in the ring that are within ENCODER_RATE_WINDOW of
+    now. Fewer than 2 gives a rate of 0.
+*/
+float encoderGetRateOf( struct encoderStruct *e )
+{
+    uint64_t now = getTime();
+    uint64_t window = ( uint64_t ) ENCODER_RATE_WINDOW * 1000000;
+    uint64_t oldest = now, newest = 0, t;
+    uint8_t  i, n = 0;
+
+    for ( i = 0; i < ENCODER_RING; i++ )
+    {
+        t = __atomic_load_n( &e->detentTimes[i], __ATOMIC_ACQUIRE );
+        if (( t == 0 ) || ( t > now ) || ( now - t > window )) continue;
+        if ( t < oldest ) oldest = t;
+        if ( t > newest ) newest = t;
+        n++;
+    }
+    if (( n < 2 ) || ( newest == oldest )) return 0;
+
+    return ( n - 1 ) * 1e9f / ( newest - oldest );
+};
+
+//  ---------------------------------------------------------------------------
+//  Returns an encoder's detents since the last call scaled by rotation rate.
+//  ---------------------------------------------------------------------------
+int32_t encoderGetAccelStepsOf( struct encoderStruct *e )
+{
+    int32_t steps = encoderGetStepsOf( e );
+    float   scale = 1, rate;
+
+    if (( steps == 0 ) || ( e->accel.gain <= 0 )) return steps;
+
+    rate = encoderGetRateOf( e );
+    if ( rate > e->accel.threshold )
+        scale = 1 + e->accel.gain * ( rate - e->accel.threshold );
+    if ( scale > e->accel.max ) scale = e->accel.max;
+
+    return ( int32_t )( steps * scale + (( steps > 0 ) ? 0.5f : -0.5f ));
+};
+
+//  ---------------------------------------------------------------------------
+//  Registers a function to call on each of an encoder's detents.
+//  ---------------------------------------------------------------------------
+void encoderSetCallbackOf( struct encoderStruct *e,
+                           void ( *callback )( int8_t direction, void *data ),
+                           void *data )
+{
+    e->directionData = data;
+    __atomic_store_n( &e->directionCallback, callback, __ATOMIC_RELEASE );
+};
+
+//  ---------------------------------------------------------------------------
+//  Registers a function to call on each press of an encoder's button.
+//  ---------------------------------------------------------------------------
+void buttonSetCallbackOf( struct encoderStruct *e,
+                          void ( *callback )( int8_t state, void *data ),
+                          void *data )
+{
+    e->buttonData = data;
+    __atomic_store_n( &e->buttonCallback, callback, __ATOMIC_RELEASE );
+};
+
+//  ---------------------------------------------------------------------------
+//  Returns detents since the last call and resets them.
+//  ---------------------------------------------------------------------------
+int32_t encoderGetSteps( void )
+{
+    return encoderGetStepsOf( &encoder );
+};
+
+//  ---------------------------------------------------------------------------
+//  Sets the acceleration curve. See encoderAccelStruct.
+//  ---------------------------------------------------------------------------
+void encoderSetAccel( float threshold, float gain, float max )
+{
+    encoderSetAccelOf( &encoder, threshold, gain, max );
+};
+
+//  ---------------------------------------------------------------------------
+//  Returns the rotation rate over recent detents (detents/S).
+//  ---------------------------------------------------------------------------
+float encoderGetRate( void )
+{
+    return encoderGetRateOf( &encoder );
+};
+
+//  ---------------------------------------------------------------------------
+//  Returns detents since the last call scaled by rotation rate.
+//  ---------------------------------------------------------------------------
+int32_t encoderGetAccelSteps( void )
+{
+    return encoderGetAccelStepsOf( &encoder );
+};
+
+//  ---------------------------------------------------------------------------
+//  Registers a function to call on each detent.
+//  ---------------------------------------------------------------------------
+void encoderSetCallback( void ( *callback )( int8_t direction, void *data ),
+                         void *data )
+{
+    encoderSetCallbackOf( &encoder, callback, data );
+};
+
+//  ---------------------------------------------------------------------------
+//  Registers a function to call on each button press.
+//  ---------------------------------------------------------------------------
+void buttonSetCallback( void ( *callback )( int8_t state, void *data ),
+                        void *data )
+{
+    buttonSetCallbackOf( &encoder, callback, data );
+};
+
+//  ---------------------------------------------------------------------------
+//  Returns the eventfd signalled on each detent or button press.
+//  ---------------------------------------------------------------------------
+int encoderEventFd( void )
+{
+    return eventFd;
+};
+
+//  ---------------------------------------------------------------------------
+//  Waits for detents or button presses. Returns number since last call.
+//  ---------------------------------------------------------------------------
+uint32_t encoderWait( void )
+{
+    uint64_t count;
+
+    if (( eventFd < 0 ) ||
+        ( read( eventFd, &count, sizeof( count )) != sizeof( count )))
+        return 0;
+
+    return count;
+};
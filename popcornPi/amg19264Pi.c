@@ -25,11 +25,12 @@
 // ****************************************************************************
 // ****************************************************************************
 
-#define Version "Version 0.1"
+#define Version "Version 0.3"
 
 //  Compilation:
 //
-//  Compile with gcc piAMG19264.c -o piAMG19264 -lwiringPi
+//  Compile with gcc amg19264Pi.c ../gpioPi/gpioPi.c ../boardPi/boardPi.c
+//      -o amg19264Pi -lwiringPi
 //  Also use the following flags for Raspberry Pi optimisation:
 //         -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
 //         -ffast-math -pipe -O3
@@ -41,6 +42,8 @@
 //  Changelog:
 //
 //  v0.1 Original version.
+//  v0.2 Added page framebuffer with dirty page flushing.
+//  v0.3 Write bus through the gpioPi library.
 //
 
 //  To Do:
@@ -56,6 +59,9 @@
 #include <stdlib.h>
 #include <time.h>
 #include <pthread.h>
+#include <stdint.h>
+
+#include "../gpioPi/gpioPi.h"
 
 // ============================================================================
 //  Information.
@@ -94,6 +100,9 @@
           Pages may refer to virtual screens.
     Note: Setting pin 6 (R/W) to 1 (read) while connected to a GPIO
           will likely damage the Pi unless V is reduced or grounded.
+    Note: Each controller auto-increments its column (X) address after a
+          data write, so a page of 64 bytes only needs its address setting
+          once.
 
     LCD register bits:
     +---+---+---+---+---+---+---+---+---+---+   +---+---------------+
@@ -120,6 +129,9 @@
 #define DISPLAY_XMAX  64 // Max No of LCD display rows.
 #define DISPLAY_YMAX  64 // Max No of LCD display columns.
 #define DISPLAY_NUM    1 // Number of displays.
+#define DISPLAY_CHIPS  3 // Number of 64x64 controllers.
+#define DISPLAY_WIDTH  ( DISPLAY_CHIPS * DISPLAY_XMAX ) // Pixel columns.
+#define DISPLAY_HEIGHT ( DISPLAY_PMAX * 8 )             // Pixel rows.
 
 // Display commands.
 #define DISPLAY_ON  0x3f // Turn display on.
@@ -134,6 +146,11 @@
 #define GPIO_UNSET     0 // Set GPIO to low.
 #define GPIO_SET       1 // Set GPIO to high.
 
+// Bus timing from the data sheet (nS).
+#define DELAY_SETUP  200 // Data and RS set up before E rises.
+#define DELAY_PULSE  450 // E high.
+#define DELAY_HOLD   450 // E low, completes the 1uS cycle.
+
 // Constants for display alignment and ticker directions.
 enum textAlignment_t { LEFT, CENTRE, RIGHT };
 
@@ -147,6 +164,18 @@ enum dateFormat_t { DAY_DMY, DAY_DM, DAY_D, DMY };
 */
 pthread_mutex_t displayBusy;
 
+// ============================================================================
+//  Framebuffer.
+// ============================================================================
+/*
+    The framebuffer mirrors display RAM, 1 bit per pixel organised as pages
+    of 8 rows with bit 0 at the top of each byte. Drawing only changes the
+    framebuffer and marks the page dirty for its controller. flushDisplay()
+    then sends each dirty page as an address setting and a burst of data.
+*/
+unsigned char frameBuffer[DISPLAY_PMAX][DISPLAY_WIDTH];
+unsigned char dirtyPages[DISPLAY_CHIPS]; // Bit n set if page n is dirty.
+
 // ============================================================================
 //  Data structures.
 // ============================================================================
@@ -186,98 +215,121 @@ struct gpioStruct
     .db[7] = 22
 };
 
+// Data pins and E, set up by initialiseGPIOs.
+struct gpioBus bus =
+{
+    .width = PINS_DATA,
+    .setup = DELAY_SETUP,
+    .pulse = DELAY_PULSE,
+    .hold  = DELAY_HOLD
+};
+
 // ============================================================================
 //  Display functions.
 // ============================================================================
 
 // ----------------------------------------------------------------------------
-//  Sends command to display registers.
+//  Selects a controller.
 // ----------------------------------------------------------------------------
-static void writeCommand( unsigned char cs, unsigned char command )
+static void selectChip( unsigned char cs )
 {
-    unsigned char i;
+    uint32_t cs2 = 1 << gpio.cs2;
+    uint32_t cs3 = 1 << gpio.cs3;
 
-    if ( cs == 0 )      // Left hand screen.
-    {
-        digitalWrite( gpio.cs3, GPIO_SET );
-        digitalWrite( gpio.cs2, GPIO_UNSET );
-//        digitalWrite( gpio.cs1, GPIO_UNSET );
-    }
-    else if ( cs == 1 ) // Centre screen.
-    {
-        digitalWrite( gpio.cs3, GPIO_UNSET );
-        digitalWrite( gpio.cs2, GPIO_SET );
-//        digitalWrite( gpio.cs1, GPIO_UNSET );
-    }
-    else if ( cs == 2 ) // Rigt hand screen.
-    {
-        digitalWrite( gpio.cs3, GPIO_UNSET );
-        digitalWrite( gpio.cs2, GPIO_UNSET );
-//        digitalWrite( gpio.cs1, GPIO_SET );
-    }
+    if ( cs == 0 )      gpioPinsWrite( cs3, cs2 );       // Left hand screen.
+    else if ( cs == 1 ) gpioPinsWrite( cs2, cs3 );       // Centre screen.
+    else if ( cs == 2 ) gpioPinsWrite( 0, cs2 | cs3 );   // Right, cs1 not wired.
+};
 
-    // Set RS and RW registers.
-    digitalWrite( gpio.rs, GPIO_UNSET );
-//    digitalWrite( gpio.rw, GPIO_UNSET );
+// ----------------------------------------------------------------------------
+//  Releases chip selects.
+// ----------------------------------------------------------------------------
+static void releaseChip( void )
+{
+    gpioPinsWrite(( 1 << gpio.cs2 ) | ( 1 << gpio.cs3 ), 0 );
+};
 
-    // Load data into DB0-DB7 registers.
-    for ( i = 0; i < PINS_DATA; i++ )
-        digitalWrite( gpio.db[i], ( command << i ) & 1 );
-    delayMicroseconds( 10 );
+// ----------------------------------------------------------------------------
+//  Clocks a byte into the selected controller.
+// ----------------------------------------------------------------------------
+/*
+    RS and the data pins go out together and the controller latches them
+    on the falling edge of E.
+*/
+static void writeByte( unsigned char rs, unsigned char byte )
+{
+    uint32_t rsBit = 1 << gpio.rs;
 
-    // Toggle EN register to send data.
-    digitalWrite( gpio.en, GPIO_SET );
-    delayMicroseconds( 5 );
-    digitalWrite( gpio.en, GPIO_UNSET );
-    delayMicroseconds( 10 );
+    gpioBusWrite( &bus, byte, rs ? rsBit : 0, rs ? 0 : rsBit );
+};
 
-    digitalWrite( gpio.cs3, GPIO_SET );
-    digitalWrite( gpio.cs2, GPIO_SET );
+// ----------------------------------------------------------------------------
+//  Sends command to display registers.
+// ----------------------------------------------------------------------------
+static void writeCommand( unsigned char cs, unsigned char command )
+{
+    selectChip( cs );
+    writeByte( GPIO_UNSET, command );
+    releaseChip();
 };
 
 // ----------------------------------------------------------------------------
-//  Sends data to display registers.
+//  Sends a page to a controller as one address setting and a data burst.
 // ----------------------------------------------------------------------------
-static void writeData( unsigned char cs, unsigned char data )
+static void writePage( unsigned char cs, unsigned char page )
 {
+    const unsigned char *data = &frameBuffer[page][ cs * DISPLAY_XMAX ];
     unsigned char i;
 
-    if ( cs == 0 )      // Left hand screen.
-    {
-        digitalWrite( gpio.cs3, GPIO_SET );
-        digitalWrite( gpio.cs2, GPIO_UNSET );
-//        digitalWrite( gpio.cs1, GPIO_UNSET );
-    }
-    else if ( cs == 1 ) // Centre screen.
-    {
-        digitalWrite( gpio.cs3, GPIO_UNSET );
-        digitalWrite( gpio.cs2, GPIO_SET );
-//        digitalWrite( gpio.cs1, GPIO_UNSET );
-    }
-    else if ( cs == 2 ) // Rigt hand screen.
+    selectChip( cs );
+    writeByte( GPIO_UNSET, BASE_PADDR | page );
+    writeByte( GPIO_UNSET, BASE_XADDR );
+    for ( i = 0; i < DISPLAY_XMAX; i++ )
+        writeByte( GPIO_SET, data[i] );
+    releaseChip();
+};
+
+// ----------------------------------------------------------------------------
+//  Sends dirty pages to the display.
+// ----------------------------------------------------------------------------
+static void flushDisplay( void )
+{
+    unsigned char cs, page;
+
+    for ( cs = 0; cs < DISPLAY_CHIPS; cs++ )
     {
-        digitalWrite( gpio.cs3, GPIO_UNSET );
-        digitalWrite( gpio.cs2, GPIO_UNSET );
-//        digitalWrite( gpio.cs1, GPIO_SET );
+        if ( dirtyPages[cs] == 0 ) continue;
+        for ( page = 0; page < DISPLAY_PMAX; page++ )
+            if ( dirtyPages[cs] & ( 1 << page )) writePage( cs, page );
+        dirtyPages[cs] = 0;
     }
+};
 
-    // Set RS and RW registers.
-    digitalWrite( gpio.rs, GPIO_SET );
-//    digitalWrite( gpio.rw, GPIO_UNSET );
+// ----------------------------------------------------------------------------
+//  Clears the framebuffer.
+// ----------------------------------------------------------------------------
+static void clearBuffer( void )
+{
+    unsigned char cs;
 
-    // Load data into DB0-DB7 registers.
-    for ( i = 0; i < PINS_DATA; i++ )
-        digitalWrite( gpio.db[i], ( data << i ) & 1 );
-    delayMicroseconds( 10 );
+    memset( frameBuffer, 0, sizeof( frameBuffer ));
+    for ( cs = 0; cs < DISPLAY_CHIPS; cs++ ) dirtyPages[cs] = 0xff;
+};
+
+// ----------------------------------------------------------------------------
+//  Sets or clears a dot in the framebuffer.
+// ----------------------------------------------------------------------------
+static void setDot( unsigned char x, unsigned char y, bool on )
+{
+    unsigned char *byte, bit;
 
-    // Toggle EN register to send data.
-    digitalWrite( gpio.en, GPIO_SET );
-    delayMicroseconds( 5 );
-    digitalWrite( gpio.en, GPIO_UNSET );
-    delayMicroseconds( 10 );
+    if (( x >= DISPLAY_WIDTH ) || ( y >= DISPLAY_HEIGHT )) return;
 
-    digitalWrite( gpio.cs3, GPIO_SET );
-    digitalWrite( gpio.cs2, GPIO_SET );
+    byte = &frameBuffer[ y / 8 ][x];
+    bit  = 1 << ( y % 8 );
+    if ( on ) *byte |= bit;
+    else      *byte &= ~bit;
+    dirtyPages[ x / DISPLAY_XMAX ] |= 1 << ( y / 8 );
 };
 
 // ----------------------------------------------------------------------------
@@ -285,9 +337,7 @@ static void writeData( unsigned char cs, unsigned char data )
 // ----------------------------------------------------------------------------
 static void drawDot( unsigned char x, unsigned char y )
 {
-    writeCommand( x / 64, BASE_XADDR | ( x % 64 ));
-    writeCommand( x / 64, BASE_PADDR | ( y / 8 ));
-    writeData( x / 64, 1 << ( y % 8 ));
+    setDot( x, y, true );
 };
 
 // ----------------------------------------------------------------------------
@@ -302,6 +352,9 @@ static void initDisplay( void )
     writeCommand( 0, DISPLAY_ON );
     writeCommand( 1, DISPLAY_ON );
     writeCommand( 2, DISPLAY_ON );
+
+    clearBuffer();
+    flushDisplay();
 };
 
 // ============================================================================
@@ -314,21 +367,19 @@ static void initDisplay( void )
 static char initialiseGPIOs( void )
 {
     unsigned char i;
-    wiringPiSetupGpio();
 
-    // Set all GPIO pins to 0.
-    digitalWrite( gpio.rs, GPIO_UNSET );
-    digitalWrite( gpio.en, GPIO_UNSET );
-    // Data pins.
+    // Map GPIOs and set the data pins and E low as outputs.
+    if ( gpioMap() < 0 ) return -1;
     for ( i = 0; i < PINS_DATA; i++ )
-        digitalWrite( gpio.db[i], GPIO_UNSET );
+        bus.db[i] = gpio.db[i];
+    bus.strobe = gpio.en;
+    if ( gpioBusInit( &bus ) < 0 ) return -1;
 
-    // Set LCD pin modes.
-    pinMode( gpio.rs, OUTPUT ); // Enumerated type defined in wiringPi.
-    pinMode( gpio.en, OUTPUT ); // Enumerated type defined in wiringPi.
-    // Data pins.
-    for ( i = 0; i < PINS_DATA; i++ )
-        pinMode( gpio.db[i], OUTPUT );
+    // Set RS low and release chip selects.
+    gpioPinsWrite(( 1 << gpio.cs2 ) | ( 1 << gpio.cs3 ), 1 << gpio.rs );
+    gpioFsel( gpio.rs, GPIO_OUTPUT );
+    gpioFsel( gpio.cs2, GPIO_OUTPUT );
+    gpioFsel( gpio.cs3, GPIO_OUTPUT );
 
     delay( 35 );
     return 0;
@@ -434,7 +485,11 @@ char main( int argc, char *argv[] )
     // ------------------------------------------------------------------------
     //  Initialise wiringPi and LCD.
     // ------------------------------------------------------------------------
-    initialiseGPIOs();  // Must be called before initialiseDisplay.
+    if ( initialiseGPIOs() < 0 ) // Must be called before initialiseDisplay.
+    {
+        printf( "Couldn't map GPIOs.\n" );
+        return -1;
+    }
 
     // Create threads and mutex for animated display functions.
 //    pthread_mutex_init( &displayBusy, NULL );
@@ -445,30 +500,30 @@ char main( int argc, char *argv[] )
 
     initDisplay();
 
-    writeCommand( 0, DISPLAY_OFF );
-    writeCommand( 1, DISPLAY_OFF );
+    // Draw a border and diagonals then time a full screen redraw.
+    struct timespec start, end;
+    unsigned char x, y;
 
-    writeCommand( 0, DISPLAY_ON );
-    writeCommand( 1, DISPLAY_ON );
+    for ( x = 0; x < DISPLAY_WIDTH; x++ )
+    {
+        drawDot( x, 0 );
+        drawDot( x, DISPLAY_HEIGHT - 1 );
+    }
+    for ( y = 0; y < DISPLAY_HEIGHT; y++ )
+    {
+        drawDot( 0, y );
+        drawDot( DISPLAY_WIDTH - 1, y );
+        drawDot( y, y );
+        drawDot( DISPLAY_WIDTH - 1 - y, y );
+    }
 
-    // Display on.
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    flushDisplay();
+    clock_gettime( CLOCK_MONOTONIC, &end );
+    printf( "Full screen redraw took %.2fms.\n",
+            ( end.tv_sec - start.tv_sec ) * 1e3 +
+            ( end.tv_nsec - start.tv_nsec ) / 1e6 );
 
-    unsigned char i, j, k;
-    for ( i = 0; i < DISPLAY_PMAX; i++ ) // Pages
-    {
-        writeCommand( 0, BASE_PADDR + i );
-        for ( j = 0; j < DISPLAY_YMAX; j++ ) // Y coordinate
-        {
-            writeCommand( 0, BASE_YADDR + j );
-            for ( k = 0; k < DISPLAY_XMAX; k++ ) // X coordinate
-            {
-                writeCommand( 0, BASE_YADDR + k );
-                printf( "Writing at %02i,%02i,%02i.\n", i, j, k );
-                writeData( 0, 0x01 );
-                writeData( 1, 0x01 );
-            };
-        };
-    };
     // Clean up threads.
 //    pthread_mutex_destroy( &displayBusy );
 //    pthread_exit( NULL );
@@ -0,0 +1,215 @@
+/*
+//  ===========================================================================
+
+    rotencMcp23017:
+
+    Rotary encoders on MCP23017 port expander pins for rotencPi.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+
+    Compile with:
+
+        gcc -c -fpic -Wall rotencMcp23017.c rotencPi.c
+            ../chipsPi/mcp23017/mcp23017.c -lwiringPi -lpthread
+
+    Also use the following flags for Raspberry Pi optimisation:
+
+        -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
+        -ffast-math -pipe -O3
+
+//  ---------------------------------------------------------------------------
+
+    Authors:        D.Faulke    20/01/2016
+
+    Contributors:
+
+    Changelog:
+
+        v0.1    Original version.
+
+//  ---------------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+#include "rotencPi.h"
+#include "../chipsPi/mcp23017/mcp23017.h"
+#include "rotencMcp23017.h"
+
+struct expanderStruct expander;
+
+//  Expander functions. -------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Returns level of an expander pin.
+//  ---------------------------------------------------------------------------
+static bool pinLevel( uint16_t levels, uint8_t pin )
+{
+    return ( pin < 16 ) && ( levels & ( 1 << pin ));
+};
+
+//  ---------------------------------------------------------------------------
+//  Feeds levels to each encoder on the expander.
+//  ---------------------------------------------------------------------------
+static void feedEncoders( uint16_t levels, uint16_t flags, uint64_t time )
+{
+    struct encoderStruct *e;
+    uint8_t i, count;
+
+    count = __atomic_load_n( &expander.count, __ATOMIC_ACQUIRE );
+    for ( i = 0; i < count; i++ )
+    {
+        e = expander.encoders[i];
+        if ((( 1 << e->gpioA ) | ( 1 << e->gpioB ) |
+             (( e->gpioC < 16 ) ? ( 1 << e->gpioC ) : 0 )) & flags )
+            encoderFeed( e, pinLevel( levels, e->gpioA ),
+                            pinLevel( levels, e->gpioB ),
+                            pinLevel( levels, e->gpioC ), time );
+    }
+};
+
+//  ---------------------------------------------------------------------------
+//  Reads captures on each interrupt. Called by the rotencPi event thread.
+//  ---------------------------------------------------------------------------
+static void readExpander( int fd, void *data )
+{
+    struct gpio_v2_line_event events[ENCODER_EVENTS];
+    struct mcp23017Capture capture;
+    ssize_t bytes;
+
+    (void) data;
+
+    // Only the time of the last interrupt is needed.
+    bytes = read( fd, events, sizeof( events ));
+    if ( bytes < ( ssize_t ) sizeof( events[0] )) return;
+
+    if ( mcp23017ReadCapture( expander.mcp23017, &capture ) < 0 ) return;
+
+    // INTCAP only holds new captures for the ports that interrupted.
+    uint16_t ports = (( capture.flags & 0x00ff ) ? 0x00ff : 0 ) |
+                     (( capture.flags & 0xff00 ) ? 0xff00 : 0 );
+    uint64_t time = events[ bytes / sizeof( events[0] ) - 1 ].timestamp_ns;
+
+    // Levels at the interrupt, then any changes since.
+    feedEncoders(( capture.captured & ports ) | ( capture.levels & ~ports ),
+                 capture.flags, time );
+    feedEncoders( capture.levels, expander.pins, time );
+};
+
+//  ---------------------------------------------------------------------------
+//  Requests interrupt GPIO and adds it to the event thread.
+//  ---------------------------------------------------------------------------
+int8_t expanderInit( struct mcp23017 *mcp23017, const char *chip,
+                     uint8_t gpio )
+{
+    struct gpio_v2_line_request request;
+    struct mcp23017Capture capture;
+    int fd;
+
+    // Rejected here since the captures need the BANK 0 addresses.
+    if (( mcp23017 == NULL ) || ( mcp23017->bank != BANK_0 )) return -1;
+
+    fd = open( chip, O_RDONLY | O_CLOEXEC );
+    if ( fd < 0 ) return -1;
+
+    memset( &request, 0, sizeof( request ));
+    request.offsets[0] = gpio;
+    request.num_lines  = 1;
+    strncpy( request.consumer, "rotencMcp23017", GPIO_MAX_NAME_SIZE - 1 );
+    request.event_buffer_size = ENCODER_EVENTS;
+    request.config.flags = GPIO_V2_LINE_FLAG_INPUT |
+                           GPIO_V2_LINE_FLAG_EDGE_FALLING |
+                           GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+
+    if ( ioctl( fd, GPIO_V2_GET_LINE_IOCTL, &request ) < 0 )
+    {
+        close( fd );
+        return -1;
+    }
+    close( fd );
+
+    expander.mcp23017 = mcp23017;
+    expander.fd       = request.fd;
+    expander.pins     = 0;
+    expander.count    = 0;
+
+    // Clear any interrupt held from before, or there won't be an edge.
+    mcp23017ReadCapture( mcp23017, &capture );
+
+    if ( encoderWatch( expander.fd, readExpander, NULL ) < 0 )
+    {
+        close( expander.fd );
+        expander.fd = -1;
+        return -1;
+    }
+
+    return 0;
+};
+
+//  ---------------------------------------------------------------------------
+//  Adds an encoder on expander pins.
+//  ---------------------------------------------------------------------------
+struct encoderStruct *expanderAddEncoder( enum decode_t mode, uint8_t pinA,
+                                          uint8_t pinB, uint8_t pinC )
+{
+    struct mcp23017Capture capture;
+    struct encoderStruct *e;
+    uint16_t pins;
+
+    if (( expander.mcp23017 == NULL ) ||
+        ( expander.count >= EXPANDER_ENCODERS ) ||
+        ( pinA > 15 ) || ( pinB > 15 ) || (( pinC > 15 ) && ( pinC != 0xFF )))
+        return NULL;
+
+    pins = ( 1 << pinA ) | ( 1 << pinB );
+    if ( pinC != 0xFF ) pins |= 1 << pinC;
+
+    if ( mcp23017InterruptInit( expander.mcp23017, pins ) < 0 ) return NULL;
+
+    // Start from the current levels.
+    if ( mcp23017ReadCapture( expander.mcp23017, &capture ) < 0 ) return NULL;
+    e = encoderAddFed( mode, pinA, pinB, pinC,
+                       pinLevel( capture.levels, pinA ),
+                       pinLevel( capture.levels, pinB ));
+    if ( e == NULL ) return NULL;
+
+    // Encoder is complete before the event thread can see it.
+    expander.encoders[ expander.count ] = e;
+    expander.pins |= pins;
+    __atomic_add_fetch( &expander.count, 1, __ATOMIC_RELEASE );
+
+    return e;
+};
+
+//  ---------------------------------------------------------------------------
+//  Releases the interrupt GPIO.
+//  ---------------------------------------------------------------------------
+void expanderClose( void )
+{
+    if ( expander.fd >= 0 ) close( expander.fd );
+    expander.fd       = -1;
+    expander.mcp23017 = NULL;
+    expander.count    = 0;
+};
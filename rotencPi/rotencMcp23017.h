@@ -0,0 +1,104 @@
+/*
+//  ===========================================================================
+
+    rotencMcp23017:
+
+    Rotary encoders on MCP23017 port expander pins for rotencPi.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+
+    Authors:        D.Faulke    20/01/2016
+
+    Contributors:
+
+    Changelog:
+
+        v0.1    Original version.
+
+//  Information. --------------------------------------------------------------
+
+    Encoders and buttons can be wired to spare MCP23017 pins, with INTA or
+    INTB wired to a single Pi GPIO. The MCP23017 raises the interrupt when
+    any of their pins change, and the flags, captures and current levels
+    of all 16 pins are read in one I2C transfer per interrupt. They are
+    fed to the encoders' decoders as if they had come from Pi GPIOs, so
+    any number of encoders and buttons only take one Pi GPIO and one
+    descriptor in the rotencPi event thread.
+
+    Expander pins are numbered 0-15, GPA0-GPA7 then GPB0-GPB7. INT is open
+    drain, active low and pulled up by the Pi.
+
+    The captures are the levels when the interrupt happened, and the
+    current levels show any changes made before it was cleared. Changes
+    between the two are missed, so turning very quickly can drop detents.
+    The half and full modes recover from missed states.
+*/
+
+#ifndef ROTENCMCP23017_H
+#define ROTENCMCP23017_H
+
+//  Macros. -------------------------------------------------------------------
+
+#define EXPANDER_ENCODERS 5 // Encoders that fit on 16 pins with buttons.
+
+//  Data structures. ----------------------------------------------------------
+
+struct expanderStruct
+{
+    struct mcp23017      *mcp23017; // MCP23017 instance.
+    int                   fd;       // Line request for interrupt GPIO.
+    uint16_t              pins;     // Expander pins with interrupts.
+    uint8_t               count;    // Encoders on the expander.
+    struct encoderStruct *encoders[EXPANDER_ENCODERS];
+};
+
+extern struct expanderStruct expander;
+
+//  Expander functions. -------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Requests interrupt GPIO and adds it to the event thread.
+//  ---------------------------------------------------------------------------
+/*
+    chip is usually ENCODER_CHIP and gpio is the Pi GPIO wired to INTA or
+    INTB. mcp23017 is an initialised MCP23017 in BANK 0 mode. Returns -1
+    if not.
+*/
+int8_t expanderInit( struct mcp23017 *mcp23017, const char *chip,
+                     uint8_t gpio );
+
+//  ---------------------------------------------------------------------------
+//  Adds an encoder on expander pins. Returns NULL if not.
+//  ---------------------------------------------------------------------------
+/*
+    Sets the pins as inputs with pull-ups and interrupts on change. Send
+    0xFF for button if no pin present. The encoder is used with the
+    rotencPi functions ending in Of.
+*/
+struct encoderStruct *expanderAddEncoder( enum decode_t mode, uint8_t pinA,
+                                          uint8_t pinB, uint8_t pinC );
+
+//  ---------------------------------------------------------------------------
+//  Releases the interrupt GPIO.
+//  ---------------------------------------------------------------------------
+/*
+    Call after encoderClose so that the event thread has stopped.
+*/
+void expanderClose( void );
+
+#endif
@@ -35,6 +35,13 @@
 
         v0.1    Original version.
         v0.2    Converted to libraries.
+        v0.3    Combined different methods.
+        v0.4    Added direction and button callbacks and an eventfd.
+        v0.5    Lock free step counting in the interrupt functions.
+        v0.6    Added velocity based acceleration.
+        v0.7    Added gpiochip backend with kernel timestamps.
+        v0.8    Multiple encoders served by one event thread.
+        v0.9    Encoders fed with levels from other sources, e.g. MCP23017.
 
     To Do:
 
@@ -171,6 +178,17 @@
                     { 0x06, 0x05, 0x04, 0x00 }}
 
 
+// gpiochip backend.
+#define ENCODER_CHIP "/dev/gpiochip0" // GPIO character device.
+#define ENCODER_EVENTS            16 // Edge events read at a time.
+#define ENCODER_MAX                8 // Encoders that can be added.
+#define ENCODER_WATCH_MAX         12 // Descriptors served by event thread.
+
+// Acceleration.
+#define ENCODER_RING          8 // Detent times kept for rotation rate.
+#define ENCODER_RATE_WINDOW 250 // Detents older than this are ignored (mS).
+
+
 //  Data structures -----------------------------------------------------------
 
 volatile int8_t encoderDirection;   // Encoder direction.
@@ -180,13 +198,49 @@ volatile int8_t buttonState;        // Button state, on or off.
 // Decoder methods. See description of encoder functions below.
 enum decode_t { SIMPLE_1, SIMPLE_2, SIMPLE_4, HALF, FULL };
 
+struct encoderAccelStruct
+{
+    float threshold;     // Rate above which steps are scaled (detents/S).
+    float gain;          // Extra scale per detent/S above threshold.
+    float max;           // Maximum scale.
+};
+/*
+    Steps are scaled by:
+
+        scale = 1 + gain * ( rate - threshold ), up to max.
+
+    so slow turns still move one step per detent while a fast flick of the
+    knob moves many. A gain of 0 turns acceleration off.
+*/
+
 struct encoderStruct
 {
     uint8_t       gpioA; // GPIO for encoder pin A.
     uint8_t       gpioB; // GPIO for encoder pin B.
     uint16_t      delay; // Sensitivity delay (uS).
     enum decode_t mode;  // Simple, half or full quadrature.
+    uint8_t       state; // Decoder state, abAB or transition table row.
+    uint8_t       gpioC; // GPIO for button, 0xFF if none.
+    int8_t        direction;   // Direction of last detent.
+    int8_t        buttonState; // Button state, on or off.
+    int32_t       steps;       // Detents not yet consumed, +ve or -ve.
+    uint64_t      detentTimes[ENCODER_RING]; // Detent times (nS).
+    uint32_t      detentCount;               // Detents written to ring.
+    struct encoderAccelStruct accel;         // Acceleration curve.
+    void        (*directionCallback)( int8_t direction, void *data );
+    void         *directionData;
+    void        (*buttonCallback)( int8_t state, void *data );
+    void         *buttonData;
+    bool          levelA; // Level of A from gpiochip edges.
+    bool          levelB; // Level of B from gpiochip edges.
+    bool          levelC; // Level of button from gpiochip edges.
+    int           fd;     // gpiochip line request, -1 if none.
 }   encoder;
+/*
+    Only mode and delay are set by the caller, and only for the global
+    encoder. The rest are set by encoderInit, encoderInitChip or
+    encoderAdd and should be left alone.
+*/
 
 struct buttonStruct
 {
@@ -194,36 +248,64 @@ struct buttonStruct
 }   button;
 
 /*
-    Functions to set direction in encoderDirection variable:
+    Functions to count detents, read by encoderGetSteps. encoderDirection
+    holds the direction of the last detent:
     encoderDirection = +1: +ve direction.
                      =  0: no change determined.
                      = -1: -ve direction.
+
+    Rather than polling encoderDirection and buttonState, callbacks can be
+    registered for each detent and button press, or the eventfd returned by
+    encoderEventFd can be waited on, e.g. added to an epoll set. Callbacks
+    are called from the wiringPi interrupt threads so should be short, and
+    should be registered before encoderInit.
+
+    encoderInitChip can be used instead of encoderInit. It uses the GPIO
+    character device rather than wiringPi. The callbacks are then called
+    from a single event thread.
+
+    The functions without an encoder argument all act on the global
+    encoder. More encoders can be added with encoderAdd and used with the
+    functions ending in Of. These need the gpiochip backend, since wiringPi
+    interrupt functions can't tell encoders apart. Every encoder, including
+    the global one if set up with encoderInitChip, is served by the same
+    event thread and signals the same eventfd, so one encoderWait loop can
+    check the steps of each in turn. The data passed to a callback can be
+    used to tell which encoder it came from.
 */
 //  ---------------------------------------------------------------------------
-//  Sets direction in encoderDirection according to state of pin B.
+//  Sets direction according to state of pin B.
 //  ---------------------------------------------------------------------------
 void setDirectionSimple( void );
 
 //  ---------------------------------------------------------------------------
-//  Sets direction in encoderDirection using SIMPLE_TABLE.
+//  Sets direction using SIMPLE_TABLE.
 //  ---------------------------------------------------------------------------
 void setDirectionTable( void );
 
 //  ---------------------------------------------------------------------------
-//  Sets direction in encoderDirection using HALF_TABLE.
+//  Sets direction using HALF_TABLE.
 //  ---------------------------------------------------------------------------
 void setDirectionHalf( void );
 
 //  ---------------------------------------------------------------------------
-//  Sets direction in encoderDirection using FULL_TABLE.
+//  Sets direction using FULL_TABLE.
 //  ---------------------------------------------------------------------------
 void setDirectionFull( void );
 
 //  ---------------------------------------------------------------------------
-//  Returns button state in buttonState. Call by interrupt on GPIO.
+//  Toggles buttonState. Call by interrupt on GPIO.
 //  ---------------------------------------------------------------------------
 void setButtonState( void );
 
+//  ---------------------------------------------------------------------------
+//  Returns detents since the last call and resets them.
+//  ---------------------------------------------------------------------------
+/*
+    +ve and -ve detents cancel out. Safe to call from any thread.
+*/
+int32_t encoderGetSteps( void );
+
 //  ---------------------------------------------------------------------------
 //  Initialises encoder and button GPIOs.
 //  ---------------------------------------------------------------------------
@@ -232,4 +314,164 @@ void setButtonState( void );
 */
 void encoderInit( uint8_t encoderA, uint8_t encoderB, uint8_t button );
 
+//  ---------------------------------------------------------------------------
+//  Initialises encoder and button using a gpiochip. Returns -1 if not.
+//  ---------------------------------------------------------------------------
+/*
+    chip is usually ENCODER_CHIP and the GPIOs are line offsets on it,
+    which are the BCM numbers on gpiochip0. Send 0xFF for button if no GPIO
+    present. debounce is the button debounce period (uS), or 0 for none,
+    and is done by the kernel if the GPIO driver supports it. It is left
+    out if not. Edges are timestamped by the kernel, so the rotation rate
+    isn't affected by scheduling delays. Needs kernel 5.10 or later.
+*/
+int8_t encoderInitChip( const char *chip, uint8_t encoderA, uint8_t encoderB,
+                        uint8_t button, uint32_t debounce );
+
+//  ---------------------------------------------------------------------------
+//  Adds an encoder on a gpiochip. Returns NULL if not.
+//  ---------------------------------------------------------------------------
+/*
+    As encoderInitChip but for encoders other than the global one. Up to
+    ENCODER_MAX can be added, each with its own mode.
+*/
+struct encoderStruct *encoderAdd( const char *chip, enum decode_t mode,
+                                  uint8_t encoderA, uint8_t encoderB,
+                                  uint8_t button, uint32_t debounce );
+
+//  ---------------------------------------------------------------------------
+//  Stops the gpiochip event thread and releases the lines.
+//  ---------------------------------------------------------------------------
+/*
+    Releases every encoder, including those added with encoderAdd.
+    Descriptors added with encoderWatch are left open.
+*/
+void encoderClose( void );
+
+//  ---------------------------------------------------------------------------
+//  Adds a descriptor to the event thread. Returns -1 if not.
+//  ---------------------------------------------------------------------------
+/*
+    handler is called from the event thread whenever fd is readable and
+    must read it, e.g. the line request for an expander interrupt pin.
+    Up to ENCODER_WATCH_MAX, including one per gpiochip encoder.
+*/
+int8_t encoderWatch( int fd, void ( *handler )( int fd, void *data ),
+                     void *data );
+
+//  ---------------------------------------------------------------------------
+//  Adds an encoder with levels fed by encoderFeed. Returns NULL if not.
+//  ---------------------------------------------------------------------------
+/*
+    For encoders that aren't on Pi GPIOs, such as on a port expander. The
+    pins are only for the feeder's use. a and b are the current levels of
+    A and B. Send 0xFF for button if no pin present.
+*/
+struct encoderStruct *encoderAddFed( enum decode_t mode, uint8_t pinA,
+                                     uint8_t pinB, uint8_t pinC,
+                                     bool a, bool b );
+
+//  ---------------------------------------------------------------------------
+//  Decodes new levels of an encoder's pins.
+//  ---------------------------------------------------------------------------
+/*
+    a, b and c are the levels of A, B and the button at time (nS, from
+    CLOCK_MONOTONIC). Pins that haven't changed are ignored, so levels can
+    be fed whether or not they have changed. If both A and B have changed,
+    A is taken to have changed first.
+*/
+void encoderFeed( struct encoderStruct *e, bool a, bool b, bool c,
+                  uint64_t time );
+
+//  ---------------------------------------------------------------------------
+//  As encoderGetSteps but for encoder e.
+//  ---------------------------------------------------------------------------
+int32_t encoderGetStepsOf( struct encoderStruct *e );
+
+//  ---------------------------------------------------------------------------
+//  As encoderSetAccel but for encoder e.
+//  ---------------------------------------------------------------------------
+void encoderSetAccelOf( struct encoderStruct *e, float threshold, float gain,
+                        float max );
+
+//  ---------------------------------------------------------------------------
+//  As encoderGetRate but for encoder e.
+//  ---------------------------------------------------------------------------
+float encoderGetRateOf( struct encoderStruct *e );
+
+//  ---------------------------------------------------------------------------
+//  As encoderGetAccelSteps but for encoder e.
+//  ---------------------------------------------------------------------------
+int32_t encoderGetAccelStepsOf( struct encoderStruct *e );
+
+//  ---------------------------------------------------------------------------
+//  As encoderSetCallback but for encoder e.
+//  ---------------------------------------------------------------------------
+void encoderSetCallbackOf( struct encoderStruct *e,
+                           void ( *callback )( int8_t direction, void *data ),
+                           void *data );
+
+//  ---------------------------------------------------------------------------
+//  As buttonSetCallback but for encoder e.
+//  ---------------------------------------------------------------------------
+void buttonSetCallbackOf( struct encoderStruct *e,
+                          void ( *callback )( int8_t state, void *data ),
+                          void *data );
+
+//  ---------------------------------------------------------------------------
+//  Sets the acceleration curve. See encoderAccelStruct.
+//  ---------------------------------------------------------------------------
+void encoderSetAccel( float threshold, float gain, float max );
+
+//  ---------------------------------------------------------------------------
+//  Returns the rotation rate over recent detents (detents/S).
+//  ---------------------------------------------------------------------------
+float encoderGetRate( void );
+
+//  ---------------------------------------------------------------------------
+//  Returns detents since the last call scaled by rotation rate.
+//  ---------------------------------------------------------------------------
+/*
+    As encoderGetSteps but scaled by the acceleration curve. The result is
+    intended to be applied as one change, e.g. one mixer write.
+*/
+int32_t encoderGetAccelSteps( void );
+
+//  ---------------------------------------------------------------------------
+//  Registers a function to call on each detent.
+//  ---------------------------------------------------------------------------
+/*
+    direction is +1 or -1. data is passed back unchanged. Send NULL to
+    remove the callback.
+*/
+void encoderSetCallback( void ( *callback )( int8_t direction, void *data ),
+                         void *data );
+
+//  ---------------------------------------------------------------------------
+//  Registers a function to call on each button press.
+//  ---------------------------------------------------------------------------
+/*
+    state is the toggled buttonState.
+*/
+void buttonSetCallback( void ( *callback )( int8_t state, void *data ),
+                        void *data );
+
+//  ---------------------------------------------------------------------------
+//  Returns the eventfd signalled on each detent or button press.
+//  ---------------------------------------------------------------------------
+/*
+    Becomes readable when there are events. Reading the 8 byte counter
+    returns the number of events since the last read and resets it. Valid
+    after encoderInit.
+*/
+int encoderEventFd( void );
+
+//  ---------------------------------------------------------------------------
+//  Waits for detents or button presses. Returns number since last call.
+//  ---------------------------------------------------------------------------
+/*
+    Blocks on the eventfd without using any CPU.
+*/
+uint32_t encoderWait( void );
+
 #endif
@@ -52,34 +52,33 @@
 
 int main( void )
 {
+    struct encoderStruct *second;
+
     // Initialise encoder and function button.
     encoder.mode = SIMPLE_1;
-    encoderInit( 23, 24, 0xFF );
+    if ( encoderInitChip( ENCODER_CHIP, 23, 24, 0xFF, 0 ) < 0 )
+        encoderInit( 23, 24, 0xFF );
     encoder.delay = 100;
 
-    // Check for attributes changed by interrupts.
-    while ( 1 )
+    // A second encoder, served by the same event thread as the first.
+    second = encoderAdd( ENCODER_CHIP, FULL, 17, 27, 22, 5000 );
+
+    // Sleep until there are detents.
+    while ( encoderWait() > 0 )
     {
+        int32_t steps = encoderGetSteps();
+
         // Volume.
-        if ( encoderDirection != 0 )
-        {
-            // Volume +
-            if ( encoderDirection > 0 ) printf( "++++.\n" );
-            // Volume -
-            else printf( "----\n" );
-            encoderDirection = 0;
-        }
-        // Button.
-//        if ( button.state )
-//        {
-//            volume.mute = true;
-//            button.state = false;
-//            setVolumeMixer( volume );  // May be better to use playback switch.
-//        }
-
-        // Sensitivity delay.
-        delay( encoder.delay );
+        for ( ; steps > 0; steps-- ) printf( "++++.\n" );
+        for ( ; steps < 0; steps++ ) printf( "----\n" );
+
+        if ( second == NULL ) continue;
+        steps = encoderGetStepsOf( second );
+        for ( ; steps > 0; steps-- ) printf( "2 ++++.\n" );
+        for ( ; steps < 0; steps++ ) printf( "2 ----\n" );
     }
 
+    encoderClose();
+
     return 0;
 }
@@ -0,0 +1,216 @@
+/*
+//  ===========================================================================
+
+    rtPi:
+
+    Opt in real time profile for the meter, display and encoder threads.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+
+    Compile with:
+
+        gcc -c -fpic -Wall -DRTPI rtPi.c -lpthread
+
+    and compile the programs using it with -DRTPI.
+
+    Also use the following flags for Raspberry Pi optimisation:
+
+        -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
+        -ffast-math -pipe -O3
+
+//  ---------------------------------------------------------------------------
+
+    Authors:        D.Faulke    27/02/2016
+
+    Contributors:
+
+    Changelog:
+
+        v0.1    Original version.
+
+//  ---------------------------------------------------------------------------
+*/
+
+#define _GNU_SOURCE
+#ifndef RTPI
+#define RTPI
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <alloca.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include "rtPi.h"
+
+
+//  Data. ---------------------------------------------------------------------
+
+const struct rtProfile rtDefault =
+{
+    .audioCpu = RT_AUDIO_LAST,
+    .stack    = RT_STACK,
+    .heap     = RT_HEAP,
+    .roles    =
+    {
+        [RT_ENCODER] = { .priority = 40, .cpu = RT_CPU_ANY },
+        [RT_CONTROL] = { .priority = 38, .cpu = RT_CPU_ANY },
+        [RT_METER]   = { .priority = 35, .cpu = RT_CPU_ANY },
+        [RT_DISPLAY] = { .priority = 30, .cpu = RT_CPU_ANY },
+        [RT_UI]      = { .priority =  0, .cpu = RT_CPU_ANY }
+    }
+};
+
+const char *rtRoleNames[RT_ROLES] =
+{
+    "encoder", "control", "meter", "display", "ui"
+};
+
+static struct rtProfile rtProf;         // Profile given to rtInit().
+static bool    rtReady = false;         // rtInit() has been called.
+static int16_t rtCpus  = 1;             // CPUs online.
+static int16_t rtAudio = -1;            // CPU left to audio, -1 if none.
+static long    rtPage  = 4096;          // Page size (bytes).
+
+
+//  Functions. ----------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Touches each page of size bytes of stack below the caller.
+//  ---------------------------------------------------------------------------
+static void __attribute__(( noinline )) rtFaultStack( uint32_t size )
+{
+    volatile uint8_t *stack = alloca( size );
+    uint32_t i;
+
+    for ( i = 0; i < size; i += rtPage ) stack[i] = 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Touches each page of size bytes of heap and gives it back to malloc.
+//  ---------------------------------------------------------------------------
+/*
+    With trimming and mmap turned off the pages stay in the heap for later
+    allocations.
+*/
+static void rtFaultHeap( uint32_t size )
+{
+    uint8_t *heap = malloc( size );
+
+    if ( heap == NULL ) return;
+    memset( heap, 0, size );
+    free( heap );
+}
+
+//  ---------------------------------------------------------------------------
+//  Locks and faults in memory and enables rtThread(). Returns -1 if not.
+//  ---------------------------------------------------------------------------
+int8_t rtInit( const struct rtProfile *profile )
+{
+    int8_t result = 0;
+    long cpus;
+
+    if ( profile == NULL ) profile = &rtDefault;
+    rtProf = *profile;
+
+    cpus = sysconf( _SC_NPROCESSORS_ONLN );
+    if ( cpus < 1 ) cpus = 1;
+    if ( cpus > CPU_SETSIZE ) cpus = CPU_SETSIZE;
+    rtCpus = cpus;
+
+    rtAudio = ( rtProf.audioCpu == RT_AUDIO_LAST ) ? rtCpus - 1 :
+                                                     rtProf.audioCpu;
+    if (( rtCpus < 2 ) || ( rtAudio < 0 ) || ( rtAudio >= rtCpus ))
+        rtAudio = -1;
+
+    rtPage = sysconf( _SC_PAGESIZE );
+    if ( rtPage <= 0 ) rtPage = 4096;
+
+    // Keep freed memory in the heap and all threads in the one heap.
+    mallopt( M_TRIM_THRESHOLD, -1 );
+    mallopt( M_MMAP_MAX, 0 );
+#ifdef M_ARENA_MAX
+    mallopt( M_ARENA_MAX, 1 );
+#endif
+
+    if ( mlockall( MCL_CURRENT | MCL_FUTURE ) < 0 ) result = -1;
+
+    rtFaultStack( rtProf.stack );
+    rtFaultHeap( rtProf.heap );
+
+    __atomic_store_n( &rtReady, true, __ATOMIC_RELEASE );
+
+    return result;
+}
+
+//  ---------------------------------------------------------------------------
+//  Sets the calling thread's role. Returns -1 if not.
+//  ---------------------------------------------------------------------------
+int8_t rtThread( enum rtRole role )
+{
+    static __thread bool done = false;
+    const struct rtRoleSched *sched;
+    struct sched_param param;
+    cpu_set_t cpus;
+    int8_t result = 0;
+    int16_t cpu;
+    int policy;
+
+    if ( role >= RT_ROLES ) return -1;
+    if ( done || !__atomic_load_n( &rtReady, __ATOMIC_ACQUIRE )) return 0;
+    done  = true;
+    sched = &rtProf.roles[role];
+
+    // Naming the main thread would rename the process.
+    if ( syscall( SYS_gettid ) != getpid())
+        pthread_setname_np( pthread_self(), rtRoleNames[role] );
+
+    memset( &param, 0, sizeof( param ));
+    if ( sched->priority > 0 )
+    {
+        policy = SCHED_FIFO;
+        param.sched_priority = sched->priority;
+        if ( param.sched_priority > sched_get_priority_max( SCHED_FIFO ))
+            param.sched_priority = sched_get_priority_max( SCHED_FIFO );
+    }
+    else policy = SCHED_OTHER;
+
+    if ( pthread_setschedparam( pthread_self(), policy, &param ) != 0 )
+        result = -1;
+
+    if ( rtCpus < 2 ) return result;
+
+    CPU_ZERO( &cpus );
+    if (( sched->cpu >= 0 ) && ( sched->cpu < rtCpus ))
+        CPU_SET( sched->cpu, &cpus );
+    else
+        for ( cpu = 0; cpu < rtCpus; cpu++ )
+            if ( cpu != rtAudio ) CPU_SET( cpu, &cpus );
+
+    if ( pthread_setaffinity_np( pthread_self(), sizeof( cpus ), &cpus ) != 0 )
+        result = -1;
+
+    return result;
+}
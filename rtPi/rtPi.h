@@ -0,0 +1,155 @@
+/*
+//  ===========================================================================
+
+    rtPi:
+
+    Opt in real time profile for the meter, display and encoder threads.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+
+    Authors:        D.Faulke    27/02/2016
+
+    Contributors:
+
+    Changelog:
+
+        v0.1    Original version.
+
+//  Information. --------------------------------------------------------------
+
+    The functions are compiled in when RTPI is defined, e.g. with -DRTPI
+    and rtPi.c added to the build. Otherwise rtInit() returns -1 and
+    rtThread() does nothing, so existing builds are unchanged.
+
+    Nothing changes until a program calls rtInit(), so the profile is only
+    used when asked for, e.g. with a command line option. rtInit() locks
+    the process in memory, stops malloc returning memory to the kernel and
+    touches the stack and heap so that the pages are already faulted in
+    when the threads start running. Each thread then calls rtThread() with
+    its role, which sets its scheduling, CPU affinity and name. Before
+    rtInit(), or if it failed, rtThread() does nothing.
+
+    Roles with a priority run as SCHED_FIFO, those without as SCHED_OTHER.
+    The default priorities are below Squeezelite's output thread, which is
+    45 when run with -p 45, so the meter never gets in the way of audio:
+
+        Encoder     40  Encoder edges and detents.
+        Control     38  Volume changes from the encoder.
+        Meter       35  Frames read from the buffer.
+        Display     30  Frames written to the displays.
+        UI           -  Everything else, e.g. ncurses and the main loop.
+
+    On a Pi with more than one CPU, all roles are kept off the audio CPU,
+    the last one by default, which leaves it to Squeezelite, e.g. started
+    with taskset -c 3. A single CPU Pi only gets the priorities.
+
+    Real time scheduling and memory locking need root or CAP_SYS_NICE and
+    CAP_IPC_LOCK. Thread stacks are locked whole once mapped, so programs
+    with many threads may want to give them smaller stacks.
+
+    The frame wake up jitter is recorded by framePi in statsPi, see the
+    STATS_FRAME_JITTER histogram.
+*/
+
+#ifndef RTPI_H
+#define RTPI_H
+
+#include <stdint.h>
+
+//  Macros. -------------------------------------------------------------------
+
+#define RTPI_VERSION 0001
+
+#define RT_AUDIO_LAST  -1       // Audio CPU is the last one online.
+#define RT_CPU_ANY     -1       // Any CPU but the audio CPU.
+#define RT_STACK    65536       // Main stack to fault in (bytes).
+#define RT_HEAP   1048576       // Heap to fault in (bytes).
+
+// Thread roles.
+enum rtRole
+{
+    RT_ENCODER, // Encoder events and interrupts.
+    RT_CONTROL, // Volume and other controls.
+    RT_METER,   // Meter frames.
+    RT_DISPLAY, // Display writes.
+    RT_UI,      // Anything else.
+    RT_ROLES
+};
+
+//  Data structures. ----------------------------------------------------------
+
+struct rtRoleSched
+{
+    uint8_t priority;           // SCHED_FIFO priority, 0 for SCHED_OTHER.
+    int8_t  cpu;                // CPU to run on or RT_CPU_ANY.
+};
+
+struct rtProfile
+{
+    int8_t   audioCpu;          // CPU left to audio or RT_AUDIO_LAST.
+    uint32_t stack;             // Main stack to fault in (bytes).
+    uint32_t heap;              // Heap to fault in (bytes).
+    struct rtRoleSched roles[RT_ROLES]; // One of rtRole.
+};
+/*
+    An audioCpu at or above the number of CPUs leaves all CPUs to the
+    roles.
+*/
+
+// Default profile.
+extern const struct rtProfile rtDefault;
+
+// Role names, also used as thread names.
+extern const char *rtRoleNames[RT_ROLES];
+
+//  Functions. ----------------------------------------------------------------
+
+#ifdef RTPI
+
+//  ---------------------------------------------------------------------------
+//  Locks and faults in memory and enables rtThread(). Returns -1 if not.
+//  ---------------------------------------------------------------------------
+/*
+    profile is NULL for rtDefault. Call before starting any threads. The
+    profile is enabled even if memory couldn't be locked.
+*/
+int8_t rtInit( const struct rtProfile *profile );
+
+//  ---------------------------------------------------------------------------
+//  Sets the calling thread's role. Returns -1 if not.
+//  ---------------------------------------------------------------------------
+/*
+    Call first thing in the thread, so that statsPi slots get the role
+    name. Only the first call in a thread has any effect.
+*/
+int8_t rtThread( enum rtRole role );
+
+#else
+
+static inline int8_t rtInit( const struct rtProfile *profile )
+{
+    (void) profile; return -1;
+}
+static inline int8_t rtThread( enum rtRole role )
+{
+    (void) role; return 0;
+}
+
+#endif // #ifdef RTPI
+
+#endif
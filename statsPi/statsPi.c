@@ -0,0 +1,312 @@
+/*
+//  ===========================================================================
+
+    statsPi:
+
+    Lock free counters and timing histograms for hot paths, exported
+    through shared memory.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+
+    Compile with:
+
+        gcc -c -fpic -Wall -DSTATSPI statsPi.c -lpthread -lrt
+
+    and compile the drivers to be counted with -DSTATSPI.
+
+    Also use the following flags for Raspberry Pi optimisation:
+
+        -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
+        -ffast-math -pipe -O3
+
+//  ---------------------------------------------------------------------------
+
+    Authors:        D.Faulke    24/02/2016
+
+    Contributors:
+
+    Changelog:
+
+        v0.1    Original version.
+        v0.2    Added frame jitter and skips for the real time profile.
+
+//  ---------------------------------------------------------------------------
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include "statsPi.h"
+
+
+//  Local variables. ----------------------------------------------------------
+
+const char *statsCounterNames[STATS_COUNTERS] =
+{
+    "meter frames", "i2c transfers", "i2c bytes", "lcd frames", "lcd bytes",
+    "spi transfers", "spi bytes", "spi frames", "encoder edges",
+    "encoder detents", "frame skips"
+};
+
+const char *statsHistNames[STATS_HISTOGRAMS] =
+{
+    "meter", "lock wait", "i2c", "lcd frame", "spi stream", "encoder",
+    "encoder latency", "frame jitter"
+};
+
+// Slots until statsOpen() is called.
+static struct statsShared statsLocalSlots = { .magic = STATS_MAGIC };
+
+// Slots that new threads claim from.
+static struct statsShared *statsSlots = &statsLocalSlots;
+static char statsName[32];
+
+// Shared by threads that find no free slot, and not exported.
+static struct statsSlot statsSpare;
+
+__thread struct statsSlot *statsThreadSlot = NULL;
+
+
+//  Functions. ----------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Claims a slot for the calling thread.
+//  ---------------------------------------------------------------------------
+/*
+    Only called the first time a thread counts something, so the system
+    calls here aren't on the hot path.
+*/
+struct statsSlot *statsClaim( void )
+{
+    struct statsShared *shared = __atomic_load_n( &statsSlots,
+                                                  __ATOMIC_ACQUIRE );
+    struct statsSlot *slot;
+    uint32_t index;
+
+    index = __atomic_fetch_add( &shared->claimed, 1, __ATOMIC_ACQ_REL );
+    if ( index >= STATS_SLOTS )
+    {
+        statsThreadSlot = &statsSpare;
+        return statsThreadSlot;
+    }
+
+    slot = &shared->slots[index];
+    pthread_getname_np( pthread_self(), slot->name, STATS_NAME );
+    __atomic_store_n( &slot->tid, ( uint32_t ) syscall( SYS_gettid ),
+                      __ATOMIC_RELEASE );
+
+    statsThreadSlot = slot;
+    return slot;
+}
+
+//  ---------------------------------------------------------------------------
+//  Creates a shared memory object for new slots. Returns -1 if not.
+//  ---------------------------------------------------------------------------
+int8_t statsOpen( const char *name )
+{
+    struct statsShared *shared;
+    int fd;
+
+    if ( statsSlots != &statsLocalSlots ) return 0;
+    if ( name == NULL ) name = STATS_SHM_NAME;
+
+    fd = shm_open( name, O_CREAT | O_RDWR, 0644 );
+    if ( fd < 0 ) return -1;
+
+    if ( ftruncate( fd, sizeof( struct statsShared )) < 0 )
+    {
+        close( fd );
+        return -1;
+    }
+
+    shared = mmap( NULL, sizeof( struct statsShared ),
+                   PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close( fd );
+    if ( shared == MAP_FAILED ) return -1;
+
+    memset( shared, 0, sizeof( struct statsShared ));
+    shared->pid   = getpid();
+    shared->magic = STATS_MAGIC;
+
+    snprintf( statsName, sizeof( statsName ), "%s", name );
+    __atomic_store_n( &statsSlots, shared, __ATOMIC_RELEASE );
+
+    return 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Removes the shared memory object created by statsOpen().
+//  ---------------------------------------------------------------------------
+/*
+    The mapping is kept since threads may still be counting into it.
+*/
+void statsClose( void )
+{
+    if ( statsSlots == &statsLocalSlots ) return;
+    shm_unlink( statsName );
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns the slots of this process.
+//  ---------------------------------------------------------------------------
+const struct statsShared *statsLocal( void )
+{
+    return __atomic_load_n( &statsSlots, __ATOMIC_ACQUIRE );
+}
+
+//  ---------------------------------------------------------------------------
+//  Maps another process's slots read only. Returns NULL if not found.
+//  ---------------------------------------------------------------------------
+const struct statsShared *statsAttach( const char *name )
+{
+    struct statsShared *shared;
+    struct stat st;
+    int fd;
+
+    if ( name == NULL ) name = STATS_SHM_NAME;
+
+    fd = shm_open( name, O_RDONLY, 0 );
+    if ( fd < 0 ) return NULL;
+
+    if (( fstat( fd, &st ) < 0 ) ||
+        ( st.st_size < ( off_t ) sizeof( struct statsShared )))
+    {
+        close( fd );
+        return NULL;
+    }
+
+    shared = mmap( NULL, sizeof( struct statsShared ), PROT_READ,
+                   MAP_SHARED, fd, 0 );
+    close( fd );
+    if ( shared == MAP_FAILED ) return NULL;
+
+    if ( shared->magic != STATS_MAGIC )
+    {
+        munmap( shared, sizeof( struct statsShared ));
+        return NULL;
+    }
+
+    return shared;
+}
+
+//  ---------------------------------------------------------------------------
+//  Unmaps slots mapped by statsAttach().
+//  ---------------------------------------------------------------------------
+void statsDetach( const struct statsShared *shared )
+{
+    if (( shared == NULL ) || ( shared == &statsLocalSlots )) return;
+    munmap(( void * ) shared, sizeof( struct statsShared ));
+}
+
+//  ---------------------------------------------------------------------------
+//  Adds up all of the slots.
+//  ---------------------------------------------------------------------------
+void statsSum( const struct statsShared *shared, struct statsTotals *totals )
+{
+    const struct statsSlot *slot;
+    const struct statsHist *hist;
+    struct statsHist *total;
+    uint32_t claimed;
+    uint8_t i, j, k;
+
+    memset( totals, 0, sizeof( struct statsTotals ));
+
+    claimed = __atomic_load_n( &shared->claimed, __ATOMIC_ACQUIRE );
+    if ( claimed > STATS_SLOTS ) claimed = STATS_SLOTS;
+
+    for ( i = 0; i < claimed; i++ )
+    {
+        slot = &shared->slots[i];
+        if ( __atomic_load_n( &slot->tid, __ATOMIC_ACQUIRE ) == 0 ) continue;
+        totals->threads++;
+
+        for ( j = 0; j < STATS_COUNTERS; j++ )
+            totals->counters[j] += __atomic_load_n( &slot->counters[j],
+                                                    __ATOMIC_RELAXED );
+
+        for ( j = 0; j < STATS_HISTOGRAMS; j++ )
+        {
+            hist  = &slot->hists[j];
+            total = &totals->hists[j];
+
+            total->count += __atomic_load_n( &hist->count, __ATOMIC_ACQUIRE );
+            total->total += __atomic_load_n( &hist->total, __ATOMIC_RELAXED );
+            if ( hist->max > total->max ) total->max = hist->max;
+            for ( k = 0; k < STATS_BINS; k++ )
+                total->bins[k] += __atomic_load_n( &hist->bins[k],
+                                                   __ATOMIC_RELAXED );
+        }
+    }
+}
+
+//  ---------------------------------------------------------------------------
+//  Finds the change in totals between two sums, e.g. for rates.
+//  ---------------------------------------------------------------------------
+void statsDiff( const struct statsTotals *now, const struct statsTotals *then,
+                struct statsTotals *diff )
+{
+    uint8_t i, j;
+
+    diff->threads = now->threads;
+
+    for ( i = 0; i < STATS_COUNTERS; i++ )
+        diff->counters[i] = now->counters[i] - then->counters[i];
+
+    for ( i = 0; i < STATS_HISTOGRAMS; i++ )
+    {
+        diff->hists[i].count = now->hists[i].count - then->hists[i].count;
+        diff->hists[i].total = now->hists[i].total - then->hists[i].total;
+        diff->hists[i].max   = now->hists[i].max;
+        for ( j = 0; j < STATS_BINS; j++ )
+            diff->hists[i].bins[j] = now->hists[i].bins[j] -
+                                     then->hists[i].bins[j];
+    }
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns the time (nS) at or below which pct percent of times fell.
+//  ---------------------------------------------------------------------------
+uint64_t statsPercentile( const struct statsHist *hist, uint8_t pct )
+{
+    uint64_t count = 0, target, all = 0;
+    uint8_t  bin;
+
+    for ( bin = 0; bin < STATS_BINS; bin++ ) all += hist->bins[bin];
+    if ( all == 0 ) return 0;
+
+    target = ( all * pct + 99 ) / 100;
+    for ( bin = 0; bin < STATS_BINS - 1; bin++ )
+    {
+        count += hist->bins[bin];
+        if ( count >= target ) break;
+    }
+
+    // Top of the bin, or the longest time for the last bin.
+    if ( bin == STATS_BINS - 1 ) return hist->max;
+    return ( bin == 0 ) ? 0 : (( uint64_t ) 1 << bin ) - 1;
+}
@@ -0,0 +1,285 @@
+/*
+//  ===========================================================================
+
+    statsPi:
+
+    Lock free counters and timing histograms for hot paths, exported
+    through shared memory.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+//  ===========================================================================
+
+    Authors:        D.Faulke    24/02/2016
+
+    Contributors:
+
+    Changelog:
+
+        v0.1    Original version.
+        v0.2    Added frame jitter and skips for the real time profile.
+
+//  Information. --------------------------------------------------------------
+
+    Drivers count events and time sections with the inline functions below.
+    They are compiled in when STATSPI is defined, e.g. with -DSTATSPI and
+    statsPi.c added to the build. Otherwise they are empty and cost
+    nothing, so existing builds are unchanged.
+
+    Each thread has its own slot, claimed on its first count, so a slot
+    only ever has one writer. Counts are plain loads and relaxed atomic
+    stores with no locks, and times come from clock_gettime(), which is
+    answered in the vDSO without a system call. Readers add up the slots,
+    and may see a count without the matching histogram update, which
+    doesn't matter for a live view.
+
+    Histogram bins are powers of 2 in nS, so bin n counts times from
+    2^(n-1) up to 2^n - 1 nS and the last bin everything longer.
+
+    The slots are kept in a local block until statsOpen() is called, which
+    moves new slots into a shared memory object that another process can
+    map with statsAttach(). Call statsOpen() before the threads start
+    counting, since slots already claimed stay in the local block.
+*/
+
+#ifndef STATSPI_H
+#define STATSPI_H
+
+#include <stdint.h>
+#include <time.h>
+
+//  Macros. -------------------------------------------------------------------
+
+#define STATSPI_VERSION 0002
+
+#define STATS_SHM_NAME "/statsPi" // Default shared memory object name.
+#define STATS_MAGIC  0x53746132   // "Sta2", changes with the slot layout.
+#define STATS_SLOTS        16     // Threads that can be counted.
+#define STATS_BINS         32     // Histogram bins, up to 2^31nS (~2s).
+#define STATS_NAME         16     // Thread name length, as in pthreads.
+
+// Counters.
+enum statsCounter
+{
+    STATS_METER_FRAMES,     // get_dBfs calls.
+    STATS_I2C_TRANSFERS,    // I2C transactions.
+    STATS_I2C_BYTES,        // Bytes on the I2C bus, excluding addresses.
+    STATS_LCD_FRAMES,       // HD44780 frame flushes.
+    STATS_LCD_BYTES,        // Bytes written to HD44780s.
+    STATS_SPI_TRANSFERS,    // SPI transactions.
+    STATS_SPI_BYTES,        // Bytes on the SPI bus.
+    STATS_SPI_FRAMES,       // SSD1322 streams written.
+    STATS_ENCODER_EDGES,    // Encoder edges handled.
+    STATS_ENCODER_DETENTS,  // Encoder detents decoded.
+    STATS_FRAME_SKIPS,      // Frame deadlines skipped after overruns.
+    STATS_COUNTERS
+};
+
+// Histograms.
+enum statsHistogram
+{
+    STATS_METER_TIME,       // get_dBfs time.
+    STATS_LOCK_WAIT,        // Wait for the Squeezelite buffer lock.
+    STATS_I2C_TIME,         // I2C transaction time.
+    STATS_LCD_TIME,         // HD44780 frame flush time.
+    STATS_SPI_TIME,         // SSD1322 stream time.
+    STATS_ENCODER_TIME,     // Encoder interrupt or event handling time.
+    STATS_ENCODER_LATENCY,  // Edge to handling time, where timestamped.
+    STATS_FRAME_JITTER,     // Wake up after a frame deadline.
+    STATS_HISTOGRAMS
+};
+
+//  Data structures. ----------------------------------------------------------
+
+struct statsHist
+{
+    uint64_t count;            // Times recorded.
+    uint64_t total;            // Sum of times (nS).
+    uint64_t max;              // Longest time (nS).
+    uint32_t bins[STATS_BINS]; // Times in each power of 2.
+};
+
+struct statsSlot
+{
+    uint32_t tid;                          // Owning thread, 0 if free.
+    char     name[STATS_NAME];             // Owning thread name.
+    uint64_t counters[STATS_COUNTERS];     // One of statsCounter.
+    struct statsHist hists[STATS_HISTOGRAMS]; // One of statsHistogram.
+} __attribute__(( aligned( 64 )));
+/*
+    Aligned to a cache line so that threads don't share lines.
+*/
+
+struct statsShared
+{
+    uint32_t magic;                        // STATS_MAGIC.
+    uint32_t pid;                          // Process that owns the object.
+    uint32_t claimed;                      // Slots claimed, may be > SLOTS.
+    struct statsSlot slots[STATS_SLOTS];
+};
+
+// Totals of all slots, for readers.
+struct statsTotals
+{
+    uint32_t threads;
+    uint64_t counters[STATS_COUNTERS];
+    struct statsHist hists[STATS_HISTOGRAMS];
+};
+
+// Names of counters and histograms, for printing.
+extern const char *statsCounterNames[STATS_COUNTERS];
+extern const char *statsHistNames[STATS_HISTOGRAMS];
+
+//  Functions. ----------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Creates a shared memory object for new slots. Returns -1 if not.
+//  ---------------------------------------------------------------------------
+/*
+    name is NULL for STATS_SHM_NAME. The object is removed by statsClose().
+*/
+int8_t statsOpen( const char *name );
+
+//  ---------------------------------------------------------------------------
+//  Removes the shared memory object created by statsOpen().
+//  ---------------------------------------------------------------------------
+void statsClose( void );
+
+//  ---------------------------------------------------------------------------
+//  Returns the slots of this process.
+//  ---------------------------------------------------------------------------
+const struct statsShared *statsLocal( void );
+
+//  ---------------------------------------------------------------------------
+//  Maps another process's slots read only. Returns NULL if not found.
+//  ---------------------------------------------------------------------------
+const struct statsShared *statsAttach( const char *name );
+
+//  ---------------------------------------------------------------------------
+//  Unmaps slots mapped by statsAttach().
+//  ---------------------------------------------------------------------------
+void statsDetach( const struct statsShared *shared );
+
+//  ---------------------------------------------------------------------------
+//  Adds up all of the slots.
+//  ---------------------------------------------------------------------------
+void statsSum( const struct statsShared *shared, struct statsTotals *totals );
+
+//  ---------------------------------------------------------------------------
+//  Finds the change in totals between two sums, e.g. for rates.
+//  ---------------------------------------------------------------------------
+/*
+    Maximum times can't be taken apart, so diff has the maximum of now.
+*/
+void statsDiff( const struct statsTotals *now, const struct statsTotals *then,
+                struct statsTotals *diff );
+
+//  ---------------------------------------------------------------------------
+//  Returns the time (nS) at or below which pct percent of times fell.
+//  ---------------------------------------------------------------------------
+/*
+    This is the top of the bin, so it is within a factor of 2.
+*/
+uint64_t statsPercentile( const struct statsHist *hist, uint8_t pct );
+
+//  ---------------------------------------------------------------------------
+//  Claims a slot for the calling thread. Used by the inline functions.
+//  ---------------------------------------------------------------------------
+struct statsSlot *statsClaim( void );
+
+//  Inline functions. ---------------------------------------------------------
+
+#ifdef STATSPI
+
+extern __thread struct statsSlot *statsThreadSlot;
+
+//  ---------------------------------------------------------------------------
+//  Returns the calling thread's slot.
+//  ---------------------------------------------------------------------------
+static inline struct statsSlot *statsGet( void )
+{
+    struct statsSlot *slot = statsThreadSlot;
+
+    if ( __builtin_expect( slot == NULL, 0 )) slot = statsClaim();
+    return slot;
+}
+
+//  ---------------------------------------------------------------------------
+//  Adds n to a counter.
+//  ---------------------------------------------------------------------------
+static inline void statsAdd( enum statsCounter counter, uint64_t n )
+{
+    struct statsSlot *slot = statsGet();
+
+    __atomic_store_n( &slot->counters[counter],
+                      slot->counters[counter] + n, __ATOMIC_RELAXED );
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns CLOCK_MONOTONIC in nS, for timing with statsSince().
+//  ---------------------------------------------------------------------------
+static inline uint64_t statsTime( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( uint64_t ) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+//  ---------------------------------------------------------------------------
+//  Records a time (nS) in a histogram.
+//  ---------------------------------------------------------------------------
+static inline void statsRecord( enum statsHistogram histogram, uint64_t ns )
+{
+    struct statsHist *hist = &statsGet()->hists[histogram];
+    uint8_t bin = ( ns == 0 ) ? 0 : 64 - __builtin_clzll( ns );
+
+    if ( bin >= STATS_BINS ) bin = STATS_BINS - 1;
+
+    __atomic_store_n( &hist->bins[bin], hist->bins[bin] + 1,
+                      __ATOMIC_RELAXED );
+    __atomic_store_n( &hist->total, hist->total + ns, __ATOMIC_RELAXED );
+    if ( ns > hist->max ) __atomic_store_n( &hist->max, ns, __ATOMIC_RELAXED );
+    __atomic_store_n( &hist->count, hist->count + 1, __ATOMIC_RELEASE );
+}
+
+//  ---------------------------------------------------------------------------
+//  Records the time since start, from statsTime().
+//  ---------------------------------------------------------------------------
+static inline void statsSince( enum statsHistogram histogram, uint64_t start )
+{
+    statsRecord( histogram, statsTime() - start );
+}
+
+#else
+
+static inline void statsAdd( enum statsCounter counter, uint64_t n )
+{
+    (void) counter; (void) n;
+}
+static inline uint64_t statsTime( void ) { return 0; }
+static inline void statsRecord( enum statsHistogram histogram, uint64_t ns )
+{
+    (void) histogram; (void) ns;
+}
+static inline void statsSince( enum statsHistogram histogram, uint64_t start )
+{
+    (void) histogram; (void) start;
+}
+
+#endif // #ifdef STATSPI
+
+#endif
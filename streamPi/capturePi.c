@@ -0,0 +1,404 @@
+//  ===========================================================================
+/*
+    capturePi:
+
+    Low latency ALSA capture engine using mmap access. Intended to provide
+    native PCM frames for meterPi and other visualisations without relying
+    on a player's visualisation buffer.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+//  ===========================================================================
+/*
+    For a shared library, compile with:
+
+        gcc -c -Wall -fpic capturePi.c -lasound
+        gcc -shared -o libcapturePi.so capturePi.o
+
+    For Raspberry Pi v1 optimisation use the following flags:
+
+        -march=armv6zk -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
+        -ffast-math -pipe -O3
+
+    For Raspberry Pi v2 optimisation use the following flags:
+
+        -march=armv7-a -mtune=cortex-a7 -mfloat-abi=hard -mfpu=neon-vfpv4
+        -ffast-math -pipe -O3
+*/
+//  ===========================================================================
+/*
+    Authors:        D.Faulke            13/02/2016
+
+    Contributors:
+*/
+//  ===========================================================================
+
+//  Installed libraries -------------------------------------------------------
+
+#include <stdbool.h>
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <alsa/asoundlib.h>
+
+//  Local libraries -----------------------------------------------------------
+
+#include "capturePi.h"
+
+//  Data. ---------------------------------------------------------------------
+
+// Preferred capture formats, best first.
+static const snd_pcm_format_t capture_formats[] =
+    { SND_PCM_FORMAT_S32_LE, SND_PCM_FORMAT_S24_LE, SND_PCM_FORMAT_S16_LE };
+
+#define CAPTURE_FORMATS ( sizeof( capture_formats ) / \
+                          sizeof( capture_formats[0] ))
+
+//  Functions. ----------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Sets hardware parameters for mmap capture.
+//  ---------------------------------------------------------------------------
+static int capture_set_hw_params( struct capture_t *capture,
+                                  snd_pcm_hw_params_t *params,
+                                  uint32_t rate, uint8_t channels,
+                                  uint32_t period, uint32_t buffer )
+{
+    snd_pcm_uframes_t frames;
+    unsigned int      val;
+    uint8_t           i;
+    int               dir = 0;
+    int               err;
+
+    err = snd_pcm_hw_params_any( capture->pcm, params );
+    if ( err < 0 ) return err;
+
+    // Interleaved mmap access to read frames straight from the ring buffer.
+    err = snd_pcm_hw_params_set_access( capture->pcm, params,
+                                        SND_PCM_ACCESS_MMAP_INTERLEAVED );
+    if ( err < 0 ) return err;
+
+    // Use the best native format available.
+    err = -EINVAL;
+    for ( i = 0; i < CAPTURE_FORMATS; i++ )
+    {
+        if ( snd_pcm_hw_params_test_format( capture->pcm, params,
+                                            capture_formats[i] ) == 0 )
+        {
+            err = snd_pcm_hw_params_set_format( capture->pcm, params,
+                                                capture_formats[i] );
+            capture->format = capture_formats[i];
+            break;
+        }
+    }
+    if ( err < 0 ) return err;
+
+    err = snd_pcm_hw_params_set_channels( capture->pcm, params, channels );
+    if ( err < 0 ) return err;
+
+    val = rate;
+    err = snd_pcm_hw_params_set_rate_near( capture->pcm, params, &val, &dir );
+    if ( err < 0 ) return err;
+
+    frames = period;
+    err = snd_pcm_hw_params_set_period_size_near( capture->pcm, params,
+                                                  &frames, &dir );
+    if ( err < 0 ) return err;
+
+    frames = buffer;
+    err = snd_pcm_hw_params_set_buffer_size_near( capture->pcm, params,
+                                                  &frames );
+    if ( err < 0 ) return err;
+
+    err = snd_pcm_hw_params( capture->pcm, params );
+    if ( err < 0 ) return err;
+
+    // Get the values actually used.
+    snd_pcm_hw_params_get_rate( params, &val, &dir );
+    capture->rate = val;
+    snd_pcm_hw_params_get_period_size( params, &capture->period, &dir );
+    snd_pcm_hw_params_get_buffer_size( params, &capture->buffer );
+    capture->channels = channels;
+    capture->bytes    = snd_pcm_format_physical_width( capture->format ) / 8;
+
+    return 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Sets software parameters so that capture never stops on overrun.
+//  ---------------------------------------------------------------------------
+static int capture_set_sw_params( struct capture_t *capture,
+                                  snd_pcm_sw_params_t *params )
+{
+    snd_pcm_uframes_t boundary;
+    int               err;
+
+    err = snd_pcm_sw_params_current( capture->pcm, params );
+    if ( err < 0 ) return err;
+
+    err = snd_pcm_sw_params_get_boundary( params, &boundary );
+    if ( err < 0 ) return err;
+
+    err = snd_pcm_sw_params_set_stop_threshold( capture->pcm, params,
+                                                boundary );
+    if ( err < 0 ) return err;
+
+    err = snd_pcm_sw_params_set_avail_min( capture->pcm, params,
+                                           capture->period );
+    if ( err < 0 ) return err;
+
+    // Timestamp hardware pointer updates from the monotonic clock.
+    err = snd_pcm_sw_params_set_tstamp_mode( capture->pcm, params,
+                                             SND_PCM_TSTAMP_ENABLE );
+    if ( err < 0 ) return err;
+
+    err = snd_pcm_sw_params_set_tstamp_type( capture->pcm, params,
+                                             SND_PCM_TSTAMP_TYPE_MONOTONIC );
+    if ( err < 0 ) return err;
+
+    return snd_pcm_sw_params( capture->pcm, params );
+}
+
+//  ---------------------------------------------------------------------------
+//  Opens a capture device for mmap access and starts capturing.
+//  ---------------------------------------------------------------------------
+int capture_open( struct capture_t *capture, const char *device,
+                  uint32_t rate, uint8_t channels,
+                  uint32_t period, uint32_t buffer )
+{
+    snd_pcm_hw_params_t *hw_params;
+    snd_pcm_sw_params_t *sw_params;
+    int err;
+
+    memset( capture, 0, sizeof( struct capture_t ));
+
+    err = snd_pcm_open( &capture->pcm, device, SND_PCM_STREAM_CAPTURE,
+                        SND_PCM_NONBLOCK );
+    if ( err < 0 )
+    {
+        capture->pcm = NULL;
+        return err;
+    }
+
+    snd_pcm_hw_params_alloca( &hw_params );
+    snd_pcm_sw_params_alloca( &sw_params );
+
+    err = capture_set_hw_params( capture, hw_params,
+                                 rate, channels, period, buffer );
+    if ( err == 0 ) err = capture_set_sw_params( capture, sw_params );
+    if ( err == 0 ) err = snd_pcm_prepare( capture->pcm );
+    if ( err == 0 ) err = snd_pcm_start( capture->pcm );
+
+    if ( err < 0 )
+    {
+        snd_pcm_close( capture->pcm );
+        capture->pcm = NULL;
+        return err;
+    }
+
+    capture->running = true;
+
+    return 0;
+}
+
+//  ---------------------------------------------------------------------------
+//  Recovers from an overrun or suspend. Returns err, or the recovery error.
+//  ---------------------------------------------------------------------------
+static int capture_recover( struct capture_t *capture, int err )
+{
+    int ret;
+
+    if (( err != -EPIPE ) && ( err != -ESTRPIPE )) return err;
+
+    // Recover and restart after an xrun or suspend.
+    capture->running = false;
+    ret = snd_pcm_recover( capture->pcm, err, 1 );
+    if ( ret == 0 ) ret = snd_pcm_start( capture->pcm );
+    if ( ret < 0 ) return ret;
+    capture->running = true;
+
+    return err;
+}
+
+//  ---------------------------------------------------------------------------
+//  Consumes all captured frames and updates the ring buffer index.
+//  ---------------------------------------------------------------------------
+/*
+    The mmap areas are the same ALSA ring buffer on every call so the base
+    address only needs to be taken from the first area. Committing the frames
+    doesn't move or clear them; they stay until the hardware wraps round.
+*/
+int capture_update( struct capture_t *capture )
+{
+    const snd_pcm_channel_area_t *areas;
+    snd_pcm_uframes_t offset, frames, hw_avail;
+    snd_htimestamp_t  tstamp;
+    snd_pcm_sframes_t avail, total;
+    int err;
+
+    if ( !capture->pcm ) return -EBADF;
+
+    avail = snd_pcm_avail_update( capture->pcm );
+    if ( avail < 0 ) return capture_recover( capture, (int) avail );
+
+    if ( snd_pcm_htimestamp( capture->pcm, &hw_avail, &tstamp ) == 0 )
+        capture->tstamp = tstamp;
+
+    total = avail;
+    while ( avail > 0 )
+    {
+        frames = avail;
+        err = snd_pcm_mmap_begin( capture->pcm, &areas, &offset, &frames );
+        if ( err < 0 ) return capture_recover( capture, err );
+
+        capture->base  = (uint8_t *) areas[0].addr + areas[0].first / 8;
+        capture->index = ( offset + frames ) % capture->buffer;
+
+        err = snd_pcm_mmap_commit( capture->pcm, offset, frames );
+        if ( err < 0 ) return capture_recover( capture, err );
+
+        avail -= frames;
+    }
+
+    return (int) total;
+}
+
+//  ---------------------------------------------------------------------------
+//  Returns the number of frames captured since the last update.
+//  ---------------------------------------------------------------------------
+int capture_avail( struct capture_t *capture )
+{
+    if ( !capture->pcm ) return -EBADF;
+    return (int) snd_pcm_avail_update( capture->pcm );
+}
+
+//  ---------------------------------------------------------------------------
+//  Waits for at least a period of frames to be captured.
+//  ---------------------------------------------------------------------------
+int capture_wait( struct capture_t *capture, int timeout )
+{
+    if ( !capture->pcm ) return -EBADF;
+    return snd_pcm_wait( capture->pcm, timeout );
+}
+
+//  ---------------------------------------------------------------------------
+//  Prints capture device hardware parameters.
+//  ---------------------------------------------------------------------------
+void capture_print_params( struct capture_t *capture )
+{
+    snd_pcm_hw_params_t *params;
+    snd_pcm_uframes_t   frames;
+    unsigned int        val, val2;
+    int                 dir;
+
+    if ( !capture->pcm ) return;
+
+    snd_pcm_hw_params_alloca( &params );
+    if ( snd_pcm_hw_params_current( capture->pcm, params ) < 0 ) return;
+
+    printf( "PCM handle name = '%s'\n", snd_pcm_name( capture->pcm ));
+
+    printf( "PCM state = %s\n",
+            snd_pcm_state_name( snd_pcm_state( capture->pcm )));
+
+    snd_pcm_hw_params_get_access( params, ( snd_pcm_access_t * ) &val );
+    printf( "access type = %s\n",
+            snd_pcm_access_name(( snd_pcm_access_t ) val ));
+
+    snd_pcm_hw_params_get_format( params, ( snd_pcm_format_t * ) &val );
+    printf( "format = '%s' (%s)\n",
+            snd_pcm_format_name(( snd_pcm_format_t ) val ),
+            snd_pcm_format_description(( snd_pcm_format_t ) val ));
+
+    snd_pcm_hw_params_get_subformat( params,
+                                     ( snd_pcm_subformat_t * ) &val );
+    printf( "subformat = '%s' (%s)\n",
+            snd_pcm_subformat_name(( snd_pcm_subformat_t ) val ),
+            snd_pcm_subformat_description(( snd_pcm_subformat_t ) val ));
+
+    snd_pcm_hw_params_get_channels( params, &val );
+    printf( "channels = %d\n", val );
+
+    snd_pcm_hw_params_get_rate( params, &val, &dir );
+    printf( "rate = %d bps\n", val );
+
+    snd_pcm_hw_params_get_period_time( params, &val, &dir );
+    printf( "period time = %d us\n", val );
+
+    snd_pcm_hw_params_get_period_size( params, &frames, &dir );
+    printf( "period size = %d frames\n", ( int ) frames );
+
+    snd_pcm_hw_params_get_buffer_time( params, &val, &dir );
+    printf( "buffer time = %d us\n", val );
+
+    snd_pcm_hw_params_get_buffer_size( params, &frames );
+    printf( "buffer size = %d frames\n", ( int ) frames );
+
+    snd_pcm_hw_params_get_periods( params, &val, &dir );
+    printf( "periods per buffer = %d frames\n", val );
+
+    snd_pcm_hw_params_get_rate_numden( params, &val, &val2 );
+    printf( "exact rate = %d/%d bps\n", val, val2 );
+
+    val = snd_pcm_hw_params_get_sbits( params );
+    printf( "significant bits = %d\n", val );
+
+    val = snd_pcm_hw_params_is_batch( params );
+    printf( "is batch = %d\n", val );
+
+    val = snd_pcm_hw_params_is_block_transfer( params );
+    printf( "is block transfer = %d\n", val );
+
+    val = snd_pcm_hw_params_is_double( params );
+    printf( "is double = %d\n", val );
+
+    val = snd_pcm_hw_params_is_half_duplex( params );
+    printf( "is half duplex = %d\n", val );
+
+    val = snd_pcm_hw_params_is_joint_duplex( params );
+    printf( "is joint duplex = %d\n", val );
+
+    val = snd_pcm_hw_params_can_overrange( params );
+    printf( "can overrange = %d\n", val );
+
+    val = snd_pcm_hw_params_can_mmap_sample_resolution( params );
+    printf( "can mmap = %d\n", val );
+
+    val = snd_pcm_hw_params_can_pause( params );
+    printf( "can pause = %d\n", val );
+
+    val = snd_pcm_hw_params_can_resume( params );
+    printf( "can resume = %d\n", val );
+
+    val = snd_pcm_hw_params_can_sync_start( params );
+    printf( "can sync start = %d\n", val );
+}
+
+//  ---------------------------------------------------------------------------
+//  Stops capture and closes the device.
+//  ---------------------------------------------------------------------------
+void capture_close( struct capture_t *capture )
+{
+    if ( !capture->pcm ) return;
+
+    snd_pcm_drop( capture->pcm );
+    snd_pcm_close( capture->pcm );
+
+    capture->pcm     = NULL;
+    capture->base    = NULL;
+    capture->running = false;
+}
@@ -0,0 +1,133 @@
+//  ===========================================================================
+/*
+    capturePi:
+
+    Low latency ALSA capture engine using mmap access. Intended to provide
+    native PCM frames for meterPi and other visualisations without relying
+    on a player's visualisation buffer.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+//  ===========================================================================
+/*
+    Authors:        D.Faulke            13/02/2016
+
+    Contributors:
+
+    Changelog:
+
+        v01.00      Original version, from thx1138 experiments.
+        v01.01      Added hardware timestamps and wait.
+*/
+//  ===========================================================================
+
+#ifndef CAPTUREPI_H
+#define CAPTUREPI_H
+
+//  Info. ---------------------------------------------------------------------
+/*
+    The capture device is opened for interleaved mmap access so that frames
+    can be read directly from the ring buffer that ALSA shares with the
+    driver. Each update simply commits all available frames, which moves the
+    application pointer up to the hardware pointer, but the frames stay in
+    the ring buffer until the hardware wraps round and overwrites them. This
+    allows a reader to integrate over any window up to the buffer size
+    without copying, as long as it checks afterwards that the hardware hasn't
+    lapped the frames that were read.
+
+    The stop threshold is set to the ring buffer boundary so that capture
+    carries on if updates are late rather than stopping with an overrun.
+
+    Formats are tried in order of preference: S32_LE, S24_LE and S16_LE.
+    S24_LE is 24-bit audio in the low 3 bytes of a 32-bit container.
+
+    Timestamps are taken from the monotonic clock when the driver last moved
+    the hardware pointer, so the age of the newest captured frame is the
+    time since tstamp.
+
+    Suitable devices are the capture side of an ALSA loopback, dsnoop on a
+    playback device, an I2S ADC or a USB audio interface, e.g.
+
+        hw:Loopback,1,0
+*/
+
+//  Types. --------------------------------------------------------------------
+
+struct capture_t
+{
+    snd_pcm_t         *pcm;     // PCM handle.
+    snd_pcm_format_t  format;   // Sample format.
+    uint32_t          rate;     // Sample rate (Hz).
+    uint8_t           channels; // Number of interleaved channels.
+    uint8_t           bytes;    // Bytes per sample.
+    snd_pcm_uframes_t period;   // Period size (frames).
+    snd_pcm_uframes_t buffer;   // Ring buffer size (frames).
+    void              *base;    // Start of mmap ring buffer.
+    snd_pcm_uframes_t index;    // Index of next frame to be captured.
+    bool              running;  // Capture has started.
+    struct timespec   tstamp;   // Time of last hardware pointer update.
+};
+
+
+//  Functions. ----------------------------------------------------------------
+
+//  ---------------------------------------------------------------------------
+//  Opens a capture device for mmap access and starts capturing.
+//  ---------------------------------------------------------------------------
+/*
+    rate, period and buffer are requests and the nearest values supported by
+    the device are used. The actual values are returned in capture. Returns
+    0 on success or a negative ALSA error code.
+*/
+int capture_open( struct capture_t *capture, const char *device,
+                  uint32_t rate, uint8_t channels,
+                  uint32_t period, uint32_t buffer );
+
+//  ---------------------------------------------------------------------------
+//  Consumes all captured frames and updates the ring buffer index.
+//  ---------------------------------------------------------------------------
+/*
+    Returns the number of new frames or a negative ALSA error code. After
+    -EPIPE (overrun) or -ESTRPIPE (suspend) the stream is recovered and
+    restarted, and capture->running is only set if that worked.
+*/
+int capture_update( struct capture_t *capture );
+
+//  ---------------------------------------------------------------------------
+//  Returns the number of frames captured since the last update.
+//  ---------------------------------------------------------------------------
+int capture_avail( struct capture_t *capture );
+
+//  ---------------------------------------------------------------------------
+//  Waits for at least a period of frames to be captured.
+//  ---------------------------------------------------------------------------
+/*
+    timeout is in mS, or -1 to wait indefinitely. Returns 1 when frames are
+    ready, 0 on time out or a negative ALSA error code.
+*/
+int capture_wait( struct capture_t *capture, int timeout );
+
+//  ---------------------------------------------------------------------------
+//  Prints capture device hardware parameters.
+//  ---------------------------------------------------------------------------
+void capture_print_params( struct capture_t *capture );
+
+//  ---------------------------------------------------------------------------
+//  Stops capture and closes the device.
+//  ---------------------------------------------------------------------------
+void capture_close( struct capture_t *capture );
+
+#endif // #ifndef CAPTUREPI_H
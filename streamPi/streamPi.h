@@ -0,0 +1,128 @@
+//  ===========================================================================
+/*
+    streamPi:
+
+    Shared memory layout of the PCM stream published by the thx1138 capture
+    daemon for meterPi and other visualisations.
+
+    Copyright 2016 Darren Faulke <darren@alidaf.co.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+//  ===========================================================================
+/*
+    Authors:        D.Faulke            20/02/2016
+
+    Contributors:
+
+    Changelog:
+
+        v01.00      Original version.
+*/
+//  ===========================================================================
+
+#ifndef STREAMPI_H
+#define STREAMPI_H
+
+//  Info. ---------------------------------------------------------------------
+/*
+    The object starts with exactly the same fields as Squeezelite's vis_t
+    (see output_vis.c), so anything that can read the Squeezelite buffer
+    can find the lock, size, index, rate and status in the same places.
+    The writer takes the rwlock for writing while it copies a block and
+    moves buf_index, and readers may take it for reading or read lock free
+    and check the index afterwards.
+
+    The differences are that the buffer is bigger and holds samples in the
+    capture format rather than always 16-bit. The format, channels and
+    capture statistics follow the buffer so that they don't move the vis_t
+    fields. buf_size and buf_index are in samples of the published format,
+    so a frame is channels samples. Published as STREAM_S16, the buffer
+    reads as a Squeezelite buffer that is just longer than usual.
+
+                +------------------+
+                | rwlock           |
+                | buf_size         |
+                | buf_index        |   Same as Squeezelite vis_t.
+                | running          |
+                | rate             |
+                | updated          |
+                +------------------+
+                | buffer           |   STREAM_BUF_SIZE 32-bit words.
+                +------------------+
+                | magic, version   |
+                | format, channels |   Stream description and capture
+                | period           |   statistics.
+                | latency, xruns   |
+                +------------------+
+
+    Latency is from the time the hardware captured the newest frame of a
+    block to the time the block was published, plus the duration of the
+    block, so it is the age of the oldest frame when readers can first see
+    it. It is the figure to watch when tuning the period size for a device.
+*/
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#define STREAM_SHM_NAME  "/streamPi" // Default shared memory object name.
+#define STREAM_BUF_SIZE  65536       // Buffer size (32-bit words).
+#define STREAM_MAGIC     0x53747250  // "StrP".
+#define STREAM_VERSION   1
+
+/*
+    Sample formats of the published buffer. S24 is 24-bit audio in the low
+    3 bytes of a 32-bit container. These match enum meter_format_t.
+*/
+enum stream_format_t
+{
+    STREAM_S16,
+    STREAM_S24,
+    STREAM_S32
+};
+
+//  Types. --------------------------------------------------------------------
+
+struct stream_vis_t
+{
+    // Squeezelite vis_t fields.
+    pthread_rwlock_t rwlock;
+    uint32_t buf_size;               // Size of ring buffer (samples).
+    uint32_t buf_index;              // Index of next sample to be written.
+    bool     running;                // Capture is running.
+    uint32_t rate;                   // Sample rate (Hz).
+    time_t   updated;                // Time of last publish.
+    int32_t  buffer[STREAM_BUF_SIZE];
+
+    // Stream description.
+    uint32_t magic;                  // STREAM_MAGIC, stored last.
+    uint8_t  version;                // STREAM_VERSION.
+    uint8_t  format;                 // enum stream_format_t.
+    uint8_t  channels;               // Interleaved channels.
+    uint8_t  bytes;                  // Bytes per sample.
+    uint32_t period;                 // Capture period (frames).
+
+    // Capture statistics, written without the lock.
+    uint64_t frames;                 // Frames published.
+    uint32_t latency_last;           // Latency of last block (us).
+    uint32_t latency_min;            // Lowest latency (us).
+    uint32_t latency_max;            // Highest latency (us).
+    uint64_t latency_total;          // Sum of block latencies (us).
+    uint32_t blocks;                 // Blocks published.
+    uint32_t xruns;                  // Capture overruns recovered.
+};
+
+#endif // #ifndef STREAMPI_H
@@ -3,8 +3,9 @@
 /*
     thx1138:
 
-    ALSA experiments to test using PCM streams and the feasibility of creating
-    a spectrum analyser and digital VU meters.
+    ALSA capture daemon. Captures from any ALSA device and publishes the
+    frames in a shared memory buffer laid out like Squeezelite's so that
+    meterPi and other visualisations can meter any source.
 
     Copyright  2015 by Darren Faulke <darren@alidaf.co.uk>
 
@@ -24,11 +25,11 @@
 // ****************************************************************************
 // ****************************************************************************
 
-#define Version "Version 0.1"
+#define Version "Version 0.5"
 
 //  Compilation:
 //
-//  Compile with gcc thx1138.c -o thx1138 -lasound
+//  Compile with gcc thx1138.c capturePi.c -o thx1138 -lasound -lpthread -lrt
 //  Also use the following flags for Raspberry Pi optimisation:
 //         -march=armv6 -mtune=arm1176jzf-s -mfloat-abi=hard -mfpu=vfp
 //         -ffast-math -pipe -O3
@@ -39,23 +40,43 @@
 //    Changelog:
 //
 //    v0.1 Initial version.
+//    v0.2 Uses capturePi for mmap capture.
+//    v0.3 Runs as a capture daemon publishing to shared memory.
+//    v0.4 Only counts recovered overruns as xruns, exits on lasting errors.
+//    v0.5 Publishes the stream magic number after the description.
+
+//  Info:
+//
+//  Each time a period has been captured, the new frames are copied from the
+//  mmap ring buffer into the shared memory object (see streamPi.h) with the
+//  write lock held, in the native capture format unless --s16 is given. The
+//  lock is only held for the copy, which is a period of frames, so readers
+//  that take the read lock are held off for as little time as possible.
+//
+//  Smaller periods lower the latency at the cost of more wake ups. The
+//  latency of each published block is kept in the shared memory object and
+//  --verbose prints it every second, so the period can be tuned per device,
+//  e.g.
+//
+//      thx1138 -D hw:Loopback,1,0 -p 256 -b 8192 -v
 
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/mman.h>
 #include <alsa/asoundlib.h>
 #include <argp.h>
 
-// ****************************************************************************
-//  Data definitions.
-// ****************************************************************************
-
-// Data structure for PCM stream.
-struct pcmStruct
-{
-    int channels;
-    float sampleFreq;
-    int sampleRate;
-};
+#include "capturePi.h"
+#include "streamPi.h"
 
 // ****************************************************************************
 //  argp documentation.
@@ -63,21 +84,37 @@ struct pcmStruct
 
 const char *argp_program_version = Version;
 const char *argp_program_bug_address = "darren@alidaf.co.uk";
-static char doc[] = "A short program to test using ALSA PCM streams";
+static char doc[] = "ALSA capture daemon publishing PCM frames to shared "
+                    "memory";
 static char args_doc[] = "thx1138 <options>";
 
 // ****************************************************************************
 //  Data definitions.
 // ****************************************************************************
 
+#define DEVICE_ID_MAX 32 // Longest device name.
+#define WAIT_TIMEOUT 1000 // Longest wait for a period (ms).
+#define ERROR_BACKOFF 10000 // First wait after a capture error (us).
+#define ERROR_LIMIT      8 // Errors in a row before giving up.
+
 // Data structure to hold command line arguments.
 struct structArgs
 {
     int card;
     int control;
-    char deviceID[8];
+    char deviceID[DEVICE_ID_MAX];
+    char *shmName;
+    unsigned int rate;
+    unsigned int channels;
+    unsigned int period;
+    unsigned int buffer;
+    bool s16;
+    bool background;
+    bool verbose;
 };
 
+static volatile sig_atomic_t running = 1;
+
 // ****************************************************************************
 //  Command line argument definitions.
 // ****************************************************************************
@@ -87,6 +124,17 @@ static struct argp_option options[] =
     { 0, 0, 0, 0, "Card information:" },
     { "card", 'c', "<n>", 0, "Card ID number." },
     { "control", 'd', "<n>", 0, "Control ID number." },
+    { "device", 'D', "<name>", 0, "Device name, e.g. hw:Loopback,1,0." },
+    { 0, 0, 0, 0, "Capture:" },
+    { "rate", 'r', "<Hz>", 0, "Sample rate." },
+    { "channels", 'n', "<n>", 0, "Channels." },
+    { "period", 'p', "<frames>", 0, "Period size." },
+    { "buffer", 'b', "<frames>", 0, "Buffer size." },
+    { 0, 0, 0, 0, "Publishing:" },
+    { "shm", 's', "<name>", 0, "Shared memory object name." },
+    { "s16", '1', 0, 0, "Publish 16-bit samples, as Squeezelite does." },
+    { "background", 'B', 0, 0, "Run in the background." },
+    { "verbose", 'v', 0, 0, "Print latency every second." },
     { 0 }
 };
 
@@ -96,9 +144,6 @@ static struct argp_option options[] =
 
 static int parse_opt( int param, char *arg, struct argp_state *state )
 {
-    char *str;
-    char *token;
-    const char delimiter[] = ",";
     struct structArgs *cmdArgs = state->input;
 
     switch( param )
@@ -109,6 +154,35 @@ static int parse_opt( int param, char *arg, struct argp_state *state )
         case 'd' :
             cmdArgs->control = atoi( arg );
             break;
+        case 'D' :
+            snprintf( cmdArgs->deviceID, DEVICE_ID_MAX, "%s", arg );
+            break;
+        case 'r' :
+            cmdArgs->rate = atoi( arg );
+            break;
+        case 'n' :
+            cmdArgs->channels = atoi( arg );
+            if (( cmdArgs->channels < 1 ) || ( cmdArgs->channels > 8 ))
+                argp_error( state, "Channels must be 1 to 8." );
+            break;
+        case 'p' :
+            cmdArgs->period = atoi( arg );
+            break;
+        case 'b' :
+            cmdArgs->buffer = atoi( arg );
+            break;
+        case 's' :
+            cmdArgs->shmName = arg;
+            break;
+        case '1' :
+            cmdArgs->s16 = true;
+            break;
+        case 'B' :
+            cmdArgs->background = true;
+            break;
+        case 'v' :
+            cmdArgs->verbose = true;
+            break;
     }
     return 0;
 };
@@ -119,166 +193,333 @@ static int parse_opt( int param, char *arg, struct argp_state *state )
 
 static struct argp argp = { options, parse_opt, args_doc, doc };
 
-
 // ****************************************************************************
-//  Main section.
+//  Functions.
 // ****************************************************************************
 
-int main( int argc, char *argv[] )
+// ----------------------------------------------------------------------------
+//  Stops the capture loop.
+// ----------------------------------------------------------------------------
+static void stopCapture( int sig )
 {
-    struct structArgs cmdArgs;
-	unsigned int val, val2;
-	int dir;
-    int errNum;
-	cmdArgs.card = 0;		// Default card.
-	cmdArgs.control = 1;	// Default control.
+    (void) sig;
+    running = 0;
+}
 
+// ----------------------------------------------------------------------------
+//  Creates and maps the shared memory object. Returns NULL on failure.
+// ----------------------------------------------------------------------------
+/*
+    The lock is shared between processes as in Squeezelite. The buffer size
+    is a whole number of frames of the published format. The magic number
+    is stored last, with release ordering, so that a reader that sees it
+    also sees the rest of the description.
+*/
+static struct stream_vis_t *streamOpen( const char *name,
+                                        struct capture_t *capture, bool s16 )
+{
+    struct stream_vis_t *stream;
+    pthread_rwlockattr_t attr;
+    int fd;
 
-    // ************************************************************************
-    //  ALSA control elements.
-    // ************************************************************************
-    snd_pcm_t *pcmp;
-    snd_pcm_hw_params_t *params;
-//	snd_pcm_stream_t stream = SND_PCM_STREAM_PLAYBACK;
-	snd_pcm_stream_t stream = SND_PCM_STREAM_CAPTURE;
-    snd_pcm_uframes_t frames;
+    fd = shm_open( name, O_CREAT | O_RDWR, 0666 );
+    if ( fd < 0 ) return NULL;
 
+    if ( ftruncate( fd, sizeof( struct stream_vis_t )) < 0 )
+    {
+        close( fd );
+        return NULL;
+    }
 
-    // ************************************************************************
-    //  Get command line parameters.
-    // ************************************************************************
-    argp_parse( &argp, argc, argv, 0, 0, &cmdArgs );
+    stream = mmap( NULL, sizeof( struct stream_vis_t ),
+                   PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close( fd );
+    if ( stream == MAP_FAILED ) return NULL;
 
-    printf( "Card = %i\n", cmdArgs.card );
-    printf( "Control = %i\n", cmdArgs.control );
-    sprintf( cmdArgs.deviceID, "hw:%i,%i", cmdArgs.card, cmdArgs.control );
-	printf( "Using device %s :", cmdArgs.deviceID );
+    memset( stream, 0, sizeof( struct stream_vis_t ));
 
-    /* Allocate a hardware parameters object. */
-    if ( snd_pcm_hw_params_alloca( &params ) < 0 )
+    pthread_rwlockattr_init( &attr );
+    pthread_rwlockattr_setpshared( &attr, PTHREAD_PROCESS_SHARED );
+    pthread_rwlock_init( &stream->rwlock, &attr );
+    pthread_rwlockattr_destroy( &attr );
+
+    stream->version  = STREAM_VERSION;
+    stream->channels = capture->channels;
+    stream->period   = capture->period;
+    stream->rate     = capture->rate;
+
+    if (( s16 ) || ( capture->format == SND_PCM_FORMAT_S16_LE ))
     {
-    	fprintf( stderr, "Unable to allocate.\n" );
-    	return -1;
-   	}
-    /* Open PCM device for playback. */
-//    if ( snd_pcm_open( &pcmp, cmdArgs.deviceID, stream, 0 ) < 0 )
-//    {
-//        fprintf( stderr, "Unable to open pcm device.\n" );
-//    	return -1;
-//    }
-    /* Fill it in with default values. */
-//    if ( snd_pcm_hw_params_any( pcmp, params ) < 0
-//    {
-//    	fprintf( stderr, "Unable to set default values.\n" );
-//    	return -1;
-//    }
-    /* Interleaved mode */
-//    snd_pcm_hw_params_set_access( pcmp, params,
-//    		SND_PCM_ACCESS_RW_INTERLEAVED );
-
-    /* Signed 16-bit little-endian format */
-    snd_pcm_hw_params_set_format( pcmp, params,
-        	SND_PCM_FORMAT_S16_LE );
-
-    /* Two channels (stereo) */
-    snd_pcm_hw_params_set_channels( pcmp, params, 2 );
-
-    /* 44100 bits/second sampling rate (CD quality) */
-    val = 44100;
-    snd_pcm_hw_params_set_rate_near( pcmp, params, &val, &dir );
-
-    /* Write the parameters to the driver */
-    errNum = snd_pcm_hw_params( pcmp, params );
-    if ( errNum < 0 )
+        stream->format = STREAM_S16;
+        stream->bytes  = sizeof( int16_t );
+    }
+    else
     {
-        fprintf(stderr, "unable to set hw parameters: %s\n",
-            snd_strerror( errNum ));
-        exit( 1 );
+        stream->format = ( capture->format == SND_PCM_FORMAT_S24_LE ) ?
+                         STREAM_S24 : STREAM_S32;
+        stream->bytes  = sizeof( int32_t );
     }
 
-    /* Display information about the PCM interface */
+    stream->buf_size = sizeof( stream->buffer ) / stream->bytes;
+    stream->buf_size -= stream->buf_size % stream->channels;
+    stream->latency_min = UINT32_MAX;
+
+    // Readers take the description as valid once they see the magic.
+    __atomic_store_n( &stream->magic, STREAM_MAGIC, __ATOMIC_RELEASE );
+
+    return stream;
+}
 
-    printf( "PCM handle name = '%s'\n", snd_pcm_name( pcmp ));
+// ----------------------------------------------------------------------------
+//  Unmaps and removes the shared memory object.
+// ----------------------------------------------------------------------------
+static void streamClose( const char *name, struct stream_vis_t *stream )
+{
+    pthread_rwlock_wrlock( &stream->rwlock );
+    stream->running = false;
+    pthread_rwlock_unlock( &stream->rwlock );
 
-    printf("PCM state = %s\n", snd_pcm_state_name( snd_pcm_state( pcmp )));
+    munmap( stream, sizeof( struct stream_vis_t ));
+    shm_unlink( name );
+}
 
-    snd_pcm_hw_params_get_access( params, ( snd_pcm_access_t * ) &val );
-    printf( "access type = %s\n",
-        snd_pcm_access_name(( snd_pcm_access_t ) val ));
+// ----------------------------------------------------------------------------
+//  Copies samples from the capture format to the published format.
+// ----------------------------------------------------------------------------
+/*
+    Only S16 publishing of 24 and 32-bit capture needs converting, which
+    keeps the high 16 bits as Squeezelite does.
+*/
+static void copySamples( void *dst, const void *src, uint32_t samples,
+                         snd_pcm_format_t format, uint8_t bytes )
+{
+    const int32_t *in = src;
+    int16_t *out = dst;
+    uint8_t shift;
+    uint32_t i;
 
-    snd_pcm_hw_params_get_format( params, ( snd_pcm_format_t * ) &val );
-    printf( "format = '%s' (%s)\n",
-        snd_pcm_format_name(( snd_pcm_format_t ) val ),
-        snd_pcm_format_description(( snd_pcm_format_t ) val ));
+    if (( bytes == sizeof( int32_t )) || ( format == SND_PCM_FORMAT_S16_LE ))
+    {
+        memcpy( dst, src, samples * bytes );
+        return;
+    }
 
-    snd_pcm_hw_params_get_subformat( params,
-        ( snd_pcm_subformat_t * ) &val );
-    printf( "subformat = '%s' (%s)\n",
-        snd_pcm_subformat_name(( snd_pcm_subformat_t ) val ),
-        snd_pcm_subformat_description((
-        snd_pcm_subformat_t ) val ));
+    shift = ( format == SND_PCM_FORMAT_S24_LE ) ? 8 : 16;
+    for ( i = 0; i < samples; i++ ) out[i] = in[i] >> shift;
+}
 
-    snd_pcm_hw_params_get_channels( params, &val );
-    printf( "channels = %d\n", val );
+// ----------------------------------------------------------------------------
+//  Publishes the frames captured by the last update.
+// ----------------------------------------------------------------------------
+/*
+    The new frames end at the capture index. Both ring buffers can wrap so
+    the frames are copied in contiguous spans. If more than a buffer less a
+    period has arrived then the oldest frames have already been overwritten
+    and only the newest are published.
+*/
+static void streamPublish( struct stream_vis_t *stream,
+                           struct capture_t *capture, uint32_t frames )
+{
+    uint32_t src, dst, span, limit;
+    uint8_t  in = capture->bytes * capture->channels; // Bytes per frame.
+    uint8_t  out = stream->bytes * capture->channels;
 
-    snd_pcm_hw_params_get_rate( params, &val, &dir );
-    printf( "rate = %d bps\n", val );
+    limit = capture->buffer - capture->period;
+    if ( frames > limit ) frames = limit;
+    if ( frames == 0 ) return;
 
-    snd_pcm_hw_params_get_period_time( params, &val, &dir );
-    printf( "period time = %d us\n", val );
+    src = ( capture->index + capture->buffer - frames ) % capture->buffer;
 
-    snd_pcm_hw_params_get_period_size( params, &frames, &dir );
-    printf( "period size = %d frames\n", ( int ) frames );
+    pthread_rwlock_wrlock( &stream->rwlock );
 
-    snd_pcm_hw_params_get_buffer_time( params, &val, &dir );
-    printf( "buffer time = %d us\n", val );
+    dst = stream->buf_index / capture->channels;
+    while ( frames > 0 )
+    {
+        span = frames;
+        if ( span > capture->buffer - src ) span = capture->buffer - src;
+        if ( span > stream->buf_size / capture->channels - dst )
+             span = stream->buf_size / capture->channels - dst;
+
+        copySamples(( uint8_t * ) stream->buffer + dst * out,
+                    ( const uint8_t * ) capture->base + src * in,
+                    span * capture->channels, capture->format, stream->bytes );
+
+        src = ( src + span ) % capture->buffer;
+        dst = ( dst + span ) % ( stream->buf_size / capture->channels );
+        frames -= span;
+        stream->frames += span;
+    }
 
-    snd_pcm_hw_params_get_buffer_size( params,
-        ( snd_pcm_uframes_t * ) &val );
-    printf( "buffer size = %d frames\n", val );
+    stream->buf_index = dst * capture->channels;
+    stream->running   = true;
+    stream->rate      = capture->rate;
+    stream->updated   = time( NULL );
 
-    snd_pcm_hw_params_get_periods( params, &val, &dir );
-    printf( "periods per buffer = %d frames\n", val );
+    pthread_rwlock_unlock( &stream->rwlock );
+}
 
-    snd_pcm_hw_params_get_rate_numden( params, &val, &val2 );
-    printf( "exact rate = %d/%d bps\n", val, val2 );
+// ----------------------------------------------------------------------------
+//  Updates the latency statistics for a published block.
+// ----------------------------------------------------------------------------
+static void streamLatency( struct stream_vis_t *stream,
+                           struct capture_t *capture, uint32_t frames )
+{
+    struct timespec now;
+    int64_t latency;
+
+    if (( capture->tstamp.tv_sec == 0 ) && ( capture->tstamp.tv_nsec == 0 ))
+        return;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    latency = ( now.tv_sec  - capture->tstamp.tv_sec ) * 1000000 +
+              ( now.tv_nsec - capture->tstamp.tv_nsec ) / 1000;
+    latency += ( int64_t ) frames * 1000000 / capture->rate;
+    if ( latency < 0 ) latency = 0;
+
+    stream->latency_last   = latency;
+    stream->latency_total += latency;
+    stream->blocks++;
+    if ( latency < stream->latency_min ) stream->latency_min = latency;
+    if ( latency > stream->latency_max ) stream->latency_max = latency;
+}
 
-    val = snd_pcm_hw_params_get_sbits( params );
-    printf( "significant bits = %d\n", val );
+// ----------------------------------------------------------------------------
+//  Prints capture statistics.
+// ----------------------------------------------------------------------------
+static void printStats( struct stream_vis_t *stream )
+{
+    printf( "frames %llu, latency last %u, min %u, avg %u, max %u us, "
+            "xruns %u\n",
+            ( unsigned long long ) stream->frames, stream->latency_last,
+            stream->blocks ? stream->latency_min : 0,
+            stream->blocks ? ( uint32_t )( stream->latency_total /
+                                           stream->blocks ) : 0,
+            stream->latency_max, stream->xruns );
+}
 
-//    snd_pcm_hw_params_get_tick_time( params, &val, &dir );
-//    printf( "tick time = %d us\n", val );
+// ****************************************************************************
+//  Main section.
+// ****************************************************************************
 
-    val = snd_pcm_hw_params_is_batch( params );
-    printf( "is batch = %d\n", val );
+int main( int argc, char *argv[] )
+{
+    struct structArgs cmdArgs;
+    struct capture_t  capture;
+    struct stream_vis_t *stream;
+    struct sigaction  action;
+    time_t printed = 0;
+    int errNum;
+    int frames;
+    unsigned int errors = 0;
 
-    val = snd_pcm_hw_params_is_block_transfer( params );
-    printf( "is block transfer = %d\n", val );
+    memset( &cmdArgs, 0, sizeof( cmdArgs ));
+	cmdArgs.card = 0;		// Default card.
+	cmdArgs.control = 1;	// Default control.
+    cmdArgs.shmName = STREAM_SHM_NAME;
+    cmdArgs.rate = 44100;
+    cmdArgs.channels = 2;
+    cmdArgs.period = 1024;
+    cmdArgs.buffer = 8192;
+
+    // ************************************************************************
+    //  Get command line parameters.
+    // ************************************************************************
+    argp_parse( &argp, argc, argv, 0, 0, &cmdArgs );
+
+    if ( cmdArgs.deviceID[0] == '\0' )
+        snprintf( cmdArgs.deviceID, DEVICE_ID_MAX, "hw:%i,%i",
+                  cmdArgs.card, cmdArgs.control );
+    if ( cmdArgs.verbose ) printf( "Using device %s :\n", cmdArgs.deviceID );
 
-    val = snd_pcm_hw_params_is_double( params );
-    printf( "is double = %d\n", val );
+    // ************************************************************************
+    //  Open capture device for mmap access.
+    // ************************************************************************
+    errNum = capture_open( &capture, cmdArgs.deviceID, cmdArgs.rate,
+                           cmdArgs.channels, cmdArgs.period, cmdArgs.buffer );
+    if ( errNum < 0 )
+    {
+        fprintf( stderr, "Unable to open pcm device: %s\n",
+            snd_strerror( errNum ));
+        return -1;
+    }
 
-    val = snd_pcm_hw_params_is_half_duplex( params );
-    printf( "is half duplex = %d\n", val );
+    /* Display information about the PCM interface */
+    if ( cmdArgs.verbose ) capture_print_params( &capture );
 
-    val = snd_pcm_hw_params_is_joint_duplex( params );
-    printf( "is joint duplex = %d\n", val );
+    stream = streamOpen( cmdArgs.shmName, &capture, cmdArgs.s16 );
+    if ( stream == NULL )
+    {
+        fprintf( stderr, "Unable to create shared memory %s\n",
+            cmdArgs.shmName );
+        capture_close( &capture );
+        return -1;
+    }
 
-    val = snd_pcm_hw_params_can_overrange( params );
-    printf( "can overrange = %d\n", val );
+    memset( &action, 0, sizeof( action ));
+    action.sa_handler = stopCapture;
+    sigaction( SIGINT, &action, NULL );
+    sigaction( SIGTERM, &action, NULL );
 
-    val = snd_pcm_hw_params_can_mmap_sample_resolution( params );
-    printf( "can mmap = %d\n", val );
+    if (( cmdArgs.background ) && ( daemon( 0, 0 ) < 0 ))
+    {
+        fprintf( stderr, "Unable to run in the background\n" );
+        running = 0;
+    }
 
-    val = snd_pcm_hw_params_can_pause( params );
-    printf( "can pause = %d\n", val );
+    // ************************************************************************
+    //  Publish each period as it is captured.
+    // ************************************************************************
+    //  An overrun or suspend is recovered by capture_update, which leaves
+    //  capture.running set if it restarted, so only then is it an xrun.
+    //  Anything else backs off, doubling each time, and gives up after
+    //  ERROR_LIMIT in a row rather than spinning on a dead device.
+    while ( running )
+    {
+        errNum = capture_wait( &capture, WAIT_TIMEOUT );
+        if (( errNum < 0 ) && ( errNum != -EPIPE ) && ( errNum != -ESTRPIPE ))
+            frames = errNum;
+        else
+            frames = capture_update( &capture );
+
+        if ( frames < 0 )
+        {
+            if ((( frames == -EPIPE ) || ( frames == -ESTRPIPE )) &&
+                ( capture.running ))
+            {
+                // Recovered, frames since the overrun are lost.
+                if ( frames == -EPIPE ) stream->xruns++;
+                errors = 0;
+                continue;
+            }
+
+            if ( ++errors >= ERROR_LIMIT )
+            {
+                fprintf( stderr, "Capture failed: %s\n",
+                    snd_strerror( frames ));
+                break;
+            }
+            usleep( ERROR_BACKOFF << ( errors - 1 ));
+            continue;
+        }
+        errors = 0;
+
+        if ( frames > 0 )
+        {
+            streamPublish( stream, &capture, frames );
+            streamLatency( stream, &capture, frames );
+        }
+
+        if (( cmdArgs.verbose ) && ( time( NULL ) != printed ))
+        {
+            printed = time( NULL );
+            printStats( stream );
+        }
+    }
 
-    val = snd_pcm_hw_params_can_resume( params );
-    printf( "can resume = %d\n", val );
+    if ( cmdArgs.verbose ) printStats( stream );
 
-    val = snd_pcm_hw_params_can_sync_start( params );
-    printf( "can sync start = %d\n", val );
-    snd_pcm_close( pcmp );
+    streamClose( cmdArgs.shmName, stream );
+    capture_close( &capture );
 
-    return 0;
+    return ( errors >= ERROR_LIMIT ) ? -1 : 0;
 }